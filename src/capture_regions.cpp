@@ -0,0 +1,194 @@
+// ============================================================================
+// CAPTURE_REGIONS.CPP - Rect union / dedup for mirror capture regions
+// ============================================================================
+
+#include "capture_regions.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+CaptureRect ClipToFrame(const CaptureRect& r, int frameW, int frameH) {
+    // Clamp each edge so at least one row/column remains: a rect fully outside the frame
+    // collapses onto the edge texels that clamped sampling reads.
+    int x0 = (std::clamp)(r.x, 0, frameW - 1);
+    int y0 = (std::clamp)(r.y, 0, frameH - 1);
+    int x1 = (std::clamp)(r.Right(), x0 + 1, frameW);
+    int y1 = (std::clamp)(r.Top(), y0 + 1, frameH);
+    return { x0, y0, x1 - x0, y1 - y0 };
+}
+
+bool Contains(const CaptureRect& outer, const CaptureRect& inner) {
+    return inner.x >= outer.x && inner.y >= outer.y && inner.Right() <= outer.Right() && inner.Top() <= outer.Top();
+}
+
+CaptureRect Bounds(const CaptureRect& a, const CaptureRect& b) {
+    int x0 = (std::min)(a.x, b.x);
+    int y0 = (std::min)(a.y, b.y);
+    int x1 = (std::max)(a.Right(), b.Right());
+    int y1 = (std::max)(a.Top(), b.Top());
+    return { x0, y0, x1 - x0, y1 - y0 };
+}
+
+// Area covered by at least one of the rects: sweep the x slabs between rect edges and merge the
+// y intervals of the rects spanning each slab. The rect lists here are short (one region's inputs).
+long long UnionArea(const std::vector<CaptureRect>& rects) {
+    if (rects.size() == 1) return rects[0].Area();
+    std::vector<int> xs;
+    xs.reserve(rects.size() * 2);
+    for (const auto& r : rects) {
+        xs.push_back(r.x);
+        xs.push_back(r.Right());
+    }
+    std::sort(xs.begin(), xs.end());
+    xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+
+    long long area = 0;
+    std::vector<std::pair<int, int>> spans;
+    spans.reserve(rects.size());
+    for (size_t i = 0; i + 1 < xs.size(); i++) {
+        spans.clear();
+        for (const auto& r : rects) {
+            if (r.x <= xs[i] && xs[i + 1] <= r.Right()) spans.emplace_back(r.y, r.Top());
+        }
+        if (spans.empty()) continue;
+        std::sort(spans.begin(), spans.end());
+        long long covered = 0;
+        int start = spans[0].first, end = spans[0].second;
+        for (size_t k = 1; k < spans.size(); k++) {
+            if (spans[k].first > end) {
+                covered += end - start;
+                start = spans[k].first;
+            }
+            end = (std::max)(end, spans[k].second);
+        }
+        covered += end - start;
+        area += covered * (xs[i + 1] - xs[i]);
+    }
+    return area;
+}
+
+// A region being built: its bounding box, the inputs merged into it and the area they cover
+struct PendingRegion {
+    CaptureRect bounds;
+    std::vector<CaptureRect> members;
+    long long covered = 0;
+};
+
+// The waste bound is checked against the true union of all member inputs, not the bounding boxes of the
+// two regions, so a chain of merges cannot accumulate more than CAPTURE_REGION_MAX_WASTE per region.
+// On merge, mergedCovered is the area the members of both cover, or -1 if it still has to be computed.
+bool ShouldMerge(const PendingRegion& a, const PendingRegion& b, long long& mergedCovered) {
+    mergedCovered = -1;
+    if (Contains(a.bounds, b.bounds) || Contains(b.bounds, a.bounds)) return true;
+
+    // Overlapping or touching (shared edge counts)
+    if (a.bounds.x > b.bounds.Right() || b.bounds.x > a.bounds.Right() || a.bounds.y > b.bounds.Top() || b.bounds.y > a.bounds.Top()) {
+        return false;
+    }
+
+    // The union covers at most a.covered + b.covered, so most rejections skip the exact union
+    const double maxBounds = 1.0 + CAPTURE_REGION_MAX_WASTE;
+    long long boundsArea = Bounds(a.bounds, b.bounds).Area();
+    if (static_cast<double>(boundsArea) > static_cast<double>(a.covered + b.covered) * maxBounds) return false;
+
+    static thread_local std::vector<CaptureRect> s_members;
+    s_members.assign(a.members.begin(), a.members.end());
+    s_members.insert(s_members.end(), b.members.begin(), b.members.end());
+    mergedCovered = UnionArea(s_members);
+    return static_cast<double>(boundsArea) <= static_cast<double>(mergedCovered) * maxBounds;
+}
+
+} // namespace
+
+void BuildCaptureRegionPlan(const std::vector<CaptureRect>& inputs, int frameW, int frameH, int maxCacheWidth, CaptureRegionPlan& out) {
+    out.regions.clear();
+    out.packed.clear();
+    out.refs.assign(inputs.size(), CaptureRegionRef{});
+    out.cacheW = out.cacheH = 0;
+    out.inputArea = out.mergedArea = 0;
+    if (frameW <= 0 || frameH <= 0) return;
+
+    // Clip inputs; skip empty ones
+    std::vector<PendingRegion> pending;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        const CaptureRect& r = inputs[i];
+        if (r.w <= 0 || r.h <= 0) continue;
+        CaptureRegionRef& ref = out.refs[i];
+        ref.clipped = ClipToFrame(r, frameW, frameH);
+        ref.insideFrame = (r.x >= 0 && r.y >= 0 && r.Right() <= frameW && r.Top() <= frameH);
+        out.inputArea += ref.clipped.Area();
+        pending.push_back({ ref.clipped, { ref.clipped }, ref.clipped.Area() });
+    }
+
+    // Merge until stable. Only a region that just grew can have new merge partners, so each one is
+    // re-checked against all others until it stops growing; pairs of unchanged regions stay rejected.
+    for (size_t i = 0; i < pending.size(); i++) {
+        bool grew = true;
+        while (grew) {
+            grew = false;
+            for (size_t j = 0; j < pending.size(); j++) {
+                long long mergedCovered = -1;
+                if (j == i || !ShouldMerge(pending[i], pending[j], mergedCovered)) continue;
+                PendingRegion& into = pending[i];
+                into.bounds = Bounds(into.bounds, pending[j].bounds);
+                const size_t before = into.members.size();
+                for (const CaptureRect& m : pending[j].members) {
+                    // Duplicates are common (mirrors sharing an input) and add nothing to the union
+                    bool redundant = false;
+                    for (size_t k = 0; k < before && !redundant; k++) redundant = Contains(into.members[k], m);
+                    if (!redundant) into.members.push_back(m);
+                }
+                if (into.members.size() != before) into.covered = mergedCovered >= 0 ? mergedCovered : UnionArea(into.members);
+                pending.erase(pending.begin() + j);
+                if (j < i) i--;
+                grew = true;
+                break;
+            }
+        }
+    }
+    for (const PendingRegion& region : pending) out.regions.push_back(region.bounds);
+
+    // Map every input to the (first) region containing it
+    for (auto& ref : out.refs) {
+        if (ref.clipped.w <= 0) continue;
+        for (size_t k = 0; k < out.regions.size(); k++) {
+            if (!Contains(out.regions[k], ref.clipped)) continue;
+            ref.region = static_cast<int>(k);
+            ref.offsetX = ref.clipped.x - out.regions[k].x;
+            ref.offsetY = ref.clipped.y - out.regions[k].y;
+            break;
+        }
+    }
+
+    // Shelf-pack the regions (tallest first) into the cache image
+    out.packed.assign(out.regions.size(), CaptureRect{});
+    if (out.regions.empty()) return;
+
+    std::vector<size_t> order(out.regions.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return out.regions[a].h > out.regions[b].h; });
+
+    int cacheW = maxCacheWidth;
+    for (const auto& r : out.regions) {
+        cacheW = (std::max)(cacheW, r.w);
+        out.mergedArea += r.Area();
+    }
+
+    int cursorX = 0, cursorY = 0, shelfH = 0, usedW = 0;
+    for (size_t idx : order) {
+        const CaptureRect& r = out.regions[idx];
+        if (cursorX + r.w > cacheW) {
+            cursorY += shelfH;
+            cursorX = 0;
+            shelfH = 0;
+        }
+        out.packed[idx] = { cursorX, cursorY, r.w, r.h };
+        cursorX += r.w;
+        usedW = (std::max)(usedW, cursorX);
+        shelfH = (std::max)(shelfH, r.h);
+    }
+    out.cacheW = usedW;
+    out.cacheH = cursorY + shelfH;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+// ============================================================================
+// CAPTURE_REGIONS.H - Deduplication of game-frame regions sampled by mirrors
+// ============================================================================
+// Mirrors often read the same or overlapping parts of the game frame (a raw and a filtered mirror of
+// the same pie chart, per-color variants of one counter, ...). BuildCaptureRegionPlan merges all input
+// rects of a frame into a small set of distinct regions, maps every input rect to the region holding it,
+// and shelf-packs the regions into a compact cache image, so each distinct region is copied or read
+// back once per frame no matter how many mirrors use it.
+//
+// All rects are in GL (bottom-up) pixel coordinates of the game frame.
+// ============================================================================
+
+#include <vector>
+
+struct CaptureRect {
+    int x = 0, y = 0, w = 0, h = 0;
+
+    int Right() const { return x + w; }
+    int Top() const { return y + h; }
+    long long Area() const { return static_cast<long long>(w) * h; }
+};
+
+// Where an input rect's pixels can be found
+struct CaptureRegionRef {
+    int region = -1;         // Index into CaptureRegionPlan::regions
+    int offsetX = 0;         // Position of the (clipped) input rect inside the region
+    int offsetY = 0;
+    CaptureRect clipped;     // Input rect clipped to the frame (see BuildCaptureRegionPlan)
+    bool insideFrame = true; // Input rect was fully inside the frame (no edge clamping involved)
+};
+
+struct CaptureRegionPlan {
+    std::vector<CaptureRect> regions;     // Distinct merged regions
+    std::vector<CaptureRect> packed;      // Position of each region in the cache image (same w/h as regions)
+    std::vector<CaptureRegionRef> refs;   // One per input rect, same order as the inputs
+    int cacheW = 0, cacheH = 0;           // Size of the cache image holding all packed regions
+    long long inputArea = 0;              // Sum of clipped input areas
+    long long mergedArea = 0;             // Sum of region areas (pixels actually copied)
+};
+
+// Merge policy: two regions are merged when they overlap or touch and their bounding box wastes at most
+// this fraction of extra pixels compared to the union of all inputs merged into them. The bound holds for
+// every final region, however many merges built it. Containment and exact duplicates always merge.
+#define CAPTURE_REGION_MAX_WASTE 0.25f
+
+// Build the plan for one frame.
+// Inputs are clipped to the frame. A rect that lies (partly) outside keeps at least the edge row/column
+// that GL_CLAMP_TO_EDGE sampling would read, so a window over its region still reproduces clamped sampling.
+// maxCacheWidth limits the width of the packed cache image (at least the widest region is used).
+void BuildCaptureRegionPlan(const std::vector<CaptureRect>& inputs, int frameW, int frameH, int maxCacheWidth, CaptureRegionPlan& out);
@@ -658,6 +658,52 @@ void ColorKeyConfigFromToml(const toml::table& tbl, ColorKeyConfig& cfg) {
     cfg.sensitivity = GetOr(tbl, "sensitivity", ConfigDefaults::COLOR_KEY_SENSITIVITY);
 }
 
+void OverlayTimelineConfigToToml(const OverlayTimelineConfig& cfg, toml::table& out) {
+    out.insert("loop", cfg.loop);
+
+    toml::array keyframesArr;
+    for (const auto& k : cfg.keyframes) {
+        toml::table kTbl;
+        kTbl.is_inline(true);
+        kTbl.insert("timeMs", k.timeMs);
+        kTbl.insert("x", k.x);
+        kTbl.insert("y", k.y);
+        kTbl.insert("scale", k.scale);
+        kTbl.insert("opacity", k.opacity);
+        kTbl.insert("cropTop", k.cropTop);
+        kTbl.insert("cropBottom", k.cropBottom);
+        kTbl.insert("cropLeft", k.cropLeft);
+        kTbl.insert("cropRight", k.cropRight);
+        kTbl.insert("easing", EasingTypeToString(k.easing));
+        keyframesArr.push_back(kTbl);
+    }
+    out.insert("keyframes", keyframesArr);
+}
+
+void OverlayTimelineConfigFromToml(const toml::table& tbl, OverlayTimelineConfig& cfg) {
+    cfg.loop = GetOr(tbl, "loop", true);
+
+    cfg.keyframes.clear();
+    if (auto arr = GetArray(tbl, "keyframes")) {
+        for (const auto& elem : *arr) {
+            if (auto t = elem.as_table()) {
+                OverlayKeyframeConfig k;
+                k.timeMs = GetOr(*t, "timeMs", 0);
+                k.x = GetOr(*t, "x", 0);
+                k.y = GetOr(*t, "y", 0);
+                k.scale = GetOr(*t, "scale", 1.0f);
+                k.opacity = GetOr(*t, "opacity", 1.0f);
+                k.cropTop = GetOr(*t, "cropTop", 0);
+                k.cropBottom = GetOr(*t, "cropBottom", 0);
+                k.cropLeft = GetOr(*t, "cropLeft", 0);
+                k.cropRight = GetOr(*t, "cropRight", 0);
+                k.easing = StringToEasingType(GetStringOr(*t, "easing", "Linear"));
+                cfg.keyframes.push_back(k);
+            }
+        }
+    }
+}
+
 void ImageConfigToToml(const ImageConfig& cfg, toml::table& out) {
     out.insert("name", cfg.name);
     out.insert("path", cfg.path);
@@ -692,6 +738,13 @@ void ImageConfigToToml(const ImageConfig& cfg, toml::table& out) {
     toml::table borderTbl;
     BorderConfigToToml(cfg.border, borderTbl);
     out.insert("border", borderTbl);
+
+    // Keyframe timeline (only save if animated)
+    if (!cfg.animation.keyframes.empty()) {
+        toml::table animTbl;
+        OverlayTimelineConfigToToml(cfg.animation, animTbl);
+        out.insert("animation", animTbl);
+    }
 }
 
 void ImageConfigFromToml(const toml::table& tbl, ImageConfig& cfg) {
@@ -727,6 +780,9 @@ void ImageConfigFromToml(const toml::table& tbl, ImageConfig& cfg) {
     cfg.onlyOnMyScreen = GetOr(tbl, "onlyOnMyScreen", ConfigDefaults::IMAGE_ONLY_ON_MY_SCREEN);
 
     if (auto t = GetTable(tbl, "border")) { BorderConfigFromToml(*t, cfg.border); }
+
+    cfg.animation = OverlayTimelineConfig{};
+    if (auto t = GetTable(tbl, "animation")) { OverlayTimelineConfigFromToml(*t, cfg.animation); }
 }
 
 void WindowOverlayConfigToToml(const WindowOverlayConfig& cfg, toml::table& out) {
@@ -769,6 +825,13 @@ void WindowOverlayConfigToToml(const WindowOverlayConfig& cfg, toml::table& out)
     toml::table borderTbl;
     BorderConfigToToml(cfg.border, borderTbl);
     out.insert("border", borderTbl);
+
+    // Keyframe timeline (only save if animated)
+    if (!cfg.animation.keyframes.empty()) {
+        toml::table animTbl;
+        OverlayTimelineConfigToToml(cfg.animation, animTbl);
+        out.insert("animation", animTbl);
+    }
 }
 
 void WindowOverlayConfigFromToml(const toml::table& tbl, WindowOverlayConfig& cfg) {
@@ -816,6 +879,9 @@ void WindowOverlayConfigFromToml(const toml::table& tbl, WindowOverlayConfig& cf
     }
 
     if (auto t = GetTable(tbl, "border")) { BorderConfigFromToml(*t, cfg.border); }
+
+    cfg.animation = OverlayTimelineConfig{};
+    if (auto t = GetTable(tbl, "animation")) { OverlayTimelineConfigFromToml(*t, cfg.animation); }
 }
 
 void ModeConfigToToml(const ModeConfig& cfg, toml::table& out) {
@@ -1189,6 +1255,7 @@ void DebugGlobalConfigToToml(const DebugGlobalConfig& cfg, toml::table& out) {
     out.insert("showTextureGrid", cfg.showTextureGrid);
     out.insert("delayRenderingUntilFinished", cfg.delayRenderingUntilFinished);
     out.insert("delayRenderingUntilBlitted", cfg.delayRenderingUntilBlitted);
+    out.insert("disableOverlayLayerCache", cfg.disableOverlayLayerCache);
     out.insert("virtualCameraEnabled", cfg.virtualCameraEnabled);
     out.insert("virtualCameraFps", cfg.virtualCameraFps);
 
@@ -1214,6 +1281,7 @@ void DebugGlobalConfigFromToml(const toml::table& tbl, DebugGlobalConfig& cfg) {
     cfg.delayRenderingUntilFinished =
         GetOr(tbl, "delayRenderingUntilFinished", ConfigDefaults::DEBUG_GLOBAL_DELAY_RENDERING_UNTIL_FINISHED);
     cfg.delayRenderingUntilBlitted = GetOr(tbl, "delayRenderingUntilBlitted", ConfigDefaults::DEBUG_GLOBAL_DELAY_RENDERING_UNTIL_BLITTED);
+    cfg.disableOverlayLayerCache = GetOr(tbl, "disableOverlayLayerCache", ConfigDefaults::DEBUG_GLOBAL_DISABLE_OVERLAY_LAYER_CACHE);
     cfg.virtualCameraEnabled = GetOr(tbl, "virtualCameraEnabled", false);
     cfg.virtualCameraFps = GetOr(tbl, "virtualCameraFps", 30);
 
@@ -24,6 +24,7 @@ struct ImageBackgroundConfig;
 struct StretchConfig;
 struct BorderConfig;
 struct ColorKeyConfig;
+struct OverlayTimelineConfig;
 struct ImageConfig;
 struct WindowOverlayConfig;
 struct ModeConfig;
@@ -56,6 +57,7 @@ void ImageBackgroundConfigToToml(const ImageBackgroundConfig& cfg, toml::table&
 void StretchConfigToToml(const StretchConfig& cfg, toml::table& out);
 void BorderConfigToToml(const BorderConfig& cfg, toml::table& out);
 void ColorKeyConfigToToml(const ColorKeyConfig& cfg, toml::table& out);
+void OverlayTimelineConfigToToml(const OverlayTimelineConfig& cfg, toml::table& out);
 void ImageConfigToToml(const ImageConfig& cfg, toml::table& out);
 void WindowOverlayConfigToToml(const WindowOverlayConfig& cfg, toml::table& out);
 void ModeConfigToToml(const ModeConfig& cfg, toml::table& out);
@@ -87,6 +89,7 @@ void ImageBackgroundConfigFromToml(const toml::table& tbl, ImageBackgroundConfig
 void StretchConfigFromToml(const toml::table& tbl, StretchConfig& cfg);
 void BorderConfigFromToml(const toml::table& tbl, BorderConfig& cfg);
 void ColorKeyConfigFromToml(const toml::table& tbl, ColorKeyConfig& cfg);
+void OverlayTimelineConfigFromToml(const toml::table& tbl, OverlayTimelineConfig& cfg);
 void ImageConfigFromToml(const toml::table& tbl, ImageConfig& cfg);
 void WindowOverlayConfigFromToml(const toml::table& tbl, WindowOverlayConfig& cfg);
 void ModeConfigFromToml(const toml::table& tbl, ModeConfig& cfg);
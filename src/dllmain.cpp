@@ -1,4 +1,5 @@
 #include "fake_cursor.h"
+#include "gl_state_tracker.h"
 #include "gui.h"
 #include "imgui_cache.h"
 #include "input_hook.h"
@@ -63,6 +64,13 @@ std::atomic<uint64_t> g_configSnapshotVersion{ 0 };
 static std::shared_ptr<const Config> g_configSnapshot;
 
 void PublishConfigSnapshot() {
+    // Refresh the interned mode handles first so both g_config and the snapshot carry them.
+    // Only changed handles are written; in steady state this is a lookup per mode.
+    for (auto& mode : g_config.modes) {
+        const ModeIdHandle handle = InternModeId(mode.id);
+        if (mode.internId != handle) { mode.internId = handle; }
+    }
+
     auto snapshot = std::make_shared<const Config>(g_config);
     // Lock-free publish: atomic store of shared_ptr.
     std::atomic_store_explicit(&g_configSnapshot, std::move(snapshot), std::memory_order_release);
@@ -191,11 +199,9 @@ std::atomic<int> g_wmMouseMoveCount{ 0 };
 
 static std::atomic<HGLRC> g_lastSeenGameGLContext{ NULL };
 
-ModeTransitionAnimation g_modeTransition;
-std::mutex g_modeTransitionMutex;
-// Lock-free snapshot for viewport hook
-ViewportTransitionSnapshot g_viewportTransitionSnapshots[2];
-std::atomic<int> g_viewportTransitionSnapshotIndex{ 0 };
+// Published transition descriptor and the game frame's present time, read lock-free by the viewport hook
+std::shared_ptr<const ModeTransitionDescriptor> g_activeModeTransition;
+std::atomic<int64_t> g_modeTransitionFrameTicks{ 0 };
 
 PendingModeSwitch g_pendingModeSwitch;
 std::mutex g_pendingModeSwitchMutex;
@@ -698,6 +704,13 @@ static HCURSOR WINAPI hkSetCursor_ThirdParty(HCURSOR hCursor) {
 static int lastViewportW = 0;
 static int lastViewportH = 0;
 
+// Every viewport the game sets passes through here; recording the one that reaches the driver lets
+// GLStateTracker restore the game's viewport without querying it.
+static inline void ForwardGameViewport(GLVIEWPORTPROC next, GLint x, GLint y, GLsizei width, GLsizei height) {
+    GLStateTracker::ForCurrentThread().NoteGameViewport(x, y, width, height);
+    next(x, y, width, height);
+}
+
 static inline void ViewportHook_Impl(GLVIEWPORTPROC next, GLint x, GLint y, GLsizei width, GLsizei height) {
     // If called before hook installation completed, fail-safe to the unmodified call.
     if (!next) return;
@@ -709,13 +722,13 @@ static inline void ViewportHook_Impl(GLVIEWPORTPROC next, GLint x, GLint y, GLsi
 
     if (!IsFullscreen()) {
         // Log("viewport not fullscreen");
-        return next(x, y, width, height);
+        return ForwardGameViewport(next, x, y, width, height);
     }
 
-    // Lock-free read of transition snapshot
-    const ViewportTransitionSnapshot& transitionSnap =
-        g_viewportTransitionSnapshots[g_viewportTransitionSnapshotIndex.load(std::memory_order_acquire)];
-    bool isTransitionActive = transitionSnap.active;
+    // Lock-free read of the active transition (immutable descriptor)
+    const std::shared_ptr<const ModeTransitionDescriptor> transitionDesc = GetActiveModeTransition();
+    const ModeTransitionDescriptor* transition = transitionDesc.get();
+    bool isTransitionActive = transition != nullptr;
 
     // Lock-free read of cached mode viewport data (updated by logic_thread)
     const CachedModeViewport& cachedMode = g_viewportModeCache[g_viewportModeCacheIndex.load(std::memory_order_acquire)];
@@ -729,14 +742,14 @@ static inline void ViewportHook_Impl(GLVIEWPORTPROC next, GLint x, GLint y, GLsi
     if (isTransitionActive) {
         // Use transition snapshot's NATIVE dimensions for matching - game's glViewport uses native size
         // The stretch dimensions are only used for actual viewport positioning
-        modeWidth = transitionSnap.toNativeWidth;
-        modeHeight = transitionSnap.toNativeHeight;
+        modeWidth = transition->toNativeWidth;
+        modeHeight = transition->toNativeHeight;
         // For stretch, use target position/size from snapshot
         stretchEnabled = true; // Transition implies stretching to target position
-        stretchX = transitionSnap.toX;
-        stretchY = transitionSnap.toY;
-        stretchWidth = transitionSnap.toWidth;
-        stretchHeight = transitionSnap.toHeight;
+        stretchX = transition->toX;
+        stretchY = transition->toY;
+        stretchWidth = transition->toWidth;
+        stretchHeight = transition->toHeight;
     } else if (cachedMode.valid) {
         // Not transitioning - use cached mode data
         modeWidth = cachedMode.width;
@@ -748,7 +761,7 @@ static inline void ViewportHook_Impl(GLVIEWPORTPROC next, GLint x, GLint y, GLsi
         stretchHeight = cachedMode.stretchHeight;
     } else {
         // Cache not yet populated and no transition - fall back to original viewport call
-        return next(x, y, width, height);
+        return ForwardGameViewport(next, x, y, width, height);
     }
 
     bool posValid = x == 0 && y == 0;
@@ -760,8 +773,8 @@ static inline void ViewportHook_Impl(GLVIEWPORTPROC next, GLint x, GLint y, GLsi
     // TO: WM_SIZE is sent immediately, so game may already be at target dimensions
     // Use native dimensions since that's what glViewport receives from the game
     if (isTransitionActive && (!widthMatches || !heightMatches)) {
-        widthMatches = widthMatches || (width == transitionSnap.fromNativeWidth) || (width == transitionSnap.toNativeWidth);
-        heightMatches = heightMatches || (height == transitionSnap.fromNativeHeight) || (height == transitionSnap.toNativeHeight);
+        widthMatches = widthMatches || (width == transition->fromNativeWidth) || (width == transition->toNativeWidth);
+        heightMatches = heightMatches || (height == transition->fromNativeHeight) || (height == transition->toNativeHeight);
     }
 
     if (!posValid || !widthMatches || !heightMatches) {
@@ -769,7 +782,7 @@ static inline void ViewportHook_Impl(GLVIEWPORTPROC next, GLint x, GLint y, GLsi
             ", width=" + std::to_string(width) + ", height=" + std::to_string(height) +
             "), lastViewportW=" + std::to_string(lastViewportW) + ", lastViewportH=" + std::to_string(lastViewportH) +
             ", modeWidth=" + std::to_string(modeWidth) + ", modeHeight=" + std::to_string(modeHeight) + ")");*/
-        return next(x, y, width, height);
+        return ForwardGameViewport(next, x, y, width, height);
     }
 
     GLint readFBO = 0;
@@ -781,7 +794,7 @@ static inline void ViewportHook_Impl(GLVIEWPORTPROC next, GLint x, GLint y, GLsi
     if (currentTexture == 0 || readFBO != 0) {
         // Log("Returning because no texture is bound or FBO is bound (fb binding =" + std::to_string(readFBO) +
         //     " and tex binding=" + std::to_string(currentTexture) + ")");
-        return next(x, y, width, height);
+        return ForwardGameViewport(next, x, y, width, height);
     }
 
     lastViewportW = modeWidth;
@@ -790,20 +803,26 @@ static inline void ViewportHook_Impl(GLVIEWPORTPROC next, GLint x, GLint y, GLsi
     const int screenW = GetCachedScreenWidth();
     const int screenH = GetCachedScreenHeight();
 
-    // Check if mode transition animation is active (from snapshot - no lock needed)
+    // Check if mode transition animation is active (evaluated at the game frame's present time - no lock needed)
     // For Move transitions: use TARGET position so game renders at final location,
     // then RenderModeInternal will blit it to the animated position.
     // This prevents stretching the entire framebuffer including GUI/overlays.
-    bool useAnimatedDimensions = transitionSnap.active;
-    bool isMoveTransition = transitionSnap.isBounceTransition;
-    int animatedX = transitionSnap.currentX;
-    int animatedY = transitionSnap.currentY;
-    int animatedWidth = transitionSnap.currentWidth;
-    int animatedHeight = transitionSnap.currentHeight;
-    int targetX = transitionSnap.toX;
-    int targetY = transitionSnap.toY;
-    int targetWidth = transitionSnap.toWidth;
-    int targetHeight = transitionSnap.toHeight;
+    bool useAnimatedDimensions = isTransitionActive;
+    bool isMoveTransition = false;
+    int animatedX = 0, animatedY = 0, animatedWidth = 0, animatedHeight = 0;
+    int targetX = 0, targetY = 0, targetWidth = 0, targetHeight = 0;
+    if (isTransitionActive) {
+        const ModeTransitionFrame frame = EvaluateModeTransition(*transition, GetModeTransitionFrameTime());
+        isMoveTransition = transition->animateGame;
+        animatedX = frame.x;
+        animatedY = frame.y;
+        animatedWidth = frame.width;
+        animatedHeight = frame.height;
+        targetX = transition->toX;
+        targetY = transition->toY;
+        targetWidth = transition->toWidth;
+        targetHeight = transition->toHeight;
+    }
 
     if (useAnimatedDimensions) {
         // Check if we should skip animation (for "Hide Animations in Game" feature)
@@ -845,7 +864,7 @@ static inline void ViewportHook_Impl(GLVIEWPORTPROC next, GLint x, GLint y, GLsi
     // Log("Viewport Hook: setting viewport to " + std::to_string(stretchWidth) + "x" + std::to_string(stretchHeight) + " at (" +
     //     std::to_string(stretchX) + "," + std::to_string(stretchY_gl) + ")");
 
-    return next(stretchX, stretchY_gl, stretchWidth, stretchHeight);
+    return ForwardGameViewport(next, stretchX, stretchY_gl, stretchWidth, stretchHeight);
 }
 
 // Primary glViewport hook (opengl32.dll export / initial hook).
@@ -1018,14 +1037,13 @@ static UINT GetRawInputDataHook_Impl(GETRAWINPUTDATAPROC next, HRAWINPUT hRawInp
 
         // Priority 2: Mode-specific or global sensitivity (if no temp override)
         if (!sensitivityDetermined) {
-            // Lock-free read: check transition snapshot first
-            const ViewportTransitionSnapshot& transitionSnap =
-                g_viewportTransitionSnapshots[g_viewportTransitionSnapshotIndex.load(std::memory_order_acquire)];
+            // Lock-free read: check the active transition first
+            const std::shared_ptr<const ModeTransitionDescriptor> transitionDesc = GetActiveModeTransition();
 
             // Get mode ID: use target mode during transitions, otherwise current mode
             std::string modeId;
-            if (transitionSnap.active) {
-                modeId = transitionSnap.toModeId; // Target mode during transition (lock-free from snapshot)
+            if (transitionDesc) {
+                modeId = transitionDesc->toModeId; // Target mode during transition (lock-free from descriptor)
             } else {
                 // Lock-free read of current mode ID from double-buffer
                 modeId = g_modeIdBuffers[g_currentModeIdIndex.load(std::memory_order_acquire)];
@@ -1254,7 +1272,7 @@ GLuint CalculateGameTextureId(int windowWidth, int windowHeight, int fullWidth,
         glGetIntegerv(GL_TEXTURE_BINDING_2D, &oldTexture);
 
         // Bind the texture to query its properties
-        glBindTexture(GL_TEXTURE_2D, texId);
+        GLTracked::BindTexture(GL_TEXTURE_2D, texId);
 
         // Get texture dimensions
         GLint width = 0, height = 0;
@@ -1272,7 +1290,7 @@ GLuint CalculateGameTextureId(int windowWidth, int windowHeight, int fullWidth,
             glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, &wrapT);
 
             // Restore previous texture binding
-            glBindTexture(GL_TEXTURE_2D, oldTexture);
+            GLTracked::BindTexture(GL_TEXTURE_2D, oldTexture);
 
             if (g_gameVersion <= GameVersion(1, 16, 5)) {
                 if (minFilter != GL_NEAREST || magFilter != GL_NEAREST || wrapS != GL_CLAMP || wrapT != GL_CLAMP) {
@@ -1297,7 +1315,7 @@ GLuint CalculateGameTextureId(int windowWidth, int windowHeight, int fullWidth,
         }
 
         // Restore previous texture binding
-        glBindTexture(GL_TEXTURE_2D, oldTexture);
+        GLTracked::BindTexture(GL_TEXTURE_2D, oldTexture);
     }
 
     Log("CalculateGameTextureId: No matching texture found in range 1-" + std::to_string(maxCheckRange));
@@ -1457,6 +1475,11 @@ static BOOL SwapBuffersHook_Impl(WGLSWAPBUFFERS next, HDC hDc) {
                         // SubmitFrameCapture already inserts its own fences and flushes after them;
                         // avoid an extra glFlush here (it can reduce FPS by forcing more driver work per frame).
                         SubmitFrameCapture(gameTexture, viewport.width, viewport.height);
+
+                        // No shared context for the capture thread - filter mirrors on the CPU instead.
+                        if (needCaptureForMirrors && IsMirrorCpuFallbackActive()) {
+                            RunMirrorCpuFallback(gameTexture, viewport.width, viewport.height);
+                        }
                     }
                 }
             }
@@ -1607,9 +1630,9 @@ void main() {
                                 s_wt_locOpacity = glGetUniformLocation(s_wt_program, "uOpacity");
 
                                 // Set sampler uniform once
-                                glUseProgram(s_wt_program);
+                                GLTracked::UseProgram(s_wt_program);
                                 glUniform1i(s_wt_locTexture, 0);
-                                glUseProgram(0);
+                                GLTracked::UseProgram(0);
                             }
                         }
 
@@ -1617,15 +1640,15 @@ void main() {
                         if (s_wt_vao == 0) { glGenVertexArrays(1, &s_wt_vao); }
                         if (s_wt_vbo == 0) { glGenBuffers(1, &s_wt_vbo); }
                         if (s_wt_vao && s_wt_vbo) {
-                            glBindVertexArray(s_wt_vao);
-                            glBindBuffer(GL_ARRAY_BUFFER, s_wt_vbo);
+                            GLTracked::BindVertexArray(s_wt_vao);
+                            GLTracked::BindBuffer(GL_ARRAY_BUFFER, s_wt_vbo);
                             glBufferData(GL_ARRAY_BUFFER, 6 * 4 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
                             glEnableVertexAttribArray(0);
                             glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
                             glEnableVertexAttribArray(1);
                             glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-                            glBindVertexArray(0);
-                            glBindBuffer(GL_ARRAY_BUFFER, 0);
+                            GLTracked::BindVertexArray(0);
+                            GLTracked::BindBuffer(GL_ARRAY_BUFFER, 0);
                         }
 
                         // Load toast texture (disable flip for consistent V=0 = top of image)
@@ -1646,17 +1669,17 @@ void main() {
                                         unsigned char* pixels = stbi_load_from_memory(rawData, (int)dataSize, &w, &h, &channels, 4);
                                         if (pixels) {
                                             if (s_wt_texture == 0) { glGenTextures(1, &s_wt_texture); }
-                                            glBindTexture(GL_TEXTURE_2D, s_wt_texture);
+                                            GLTracked::BindTexture(GL_TEXTURE_2D, s_wt_texture);
                                             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
                                             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
                                             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
                                             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                                            glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-                                            glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
-                                            glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
-                                            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+                                            GLTracked::PixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+                                            GLTracked::PixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+                                            GLTracked::PixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+                                            GLTracked::PixelStorei(GL_UNPACK_ALIGNMENT, 4);
                                             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
-                                            glBindTexture(GL_TEXTURE_2D, 0);
+                                            GLTracked::BindTexture(GL_TEXTURE_2D, 0);
                                             s_wt_texW = w;
                                             s_wt_texH = h;
                                             stbi_image_free(pixels);
@@ -1672,68 +1695,35 @@ void main() {
                     }
 
                     if (s_wt_program && s_wt_vao && s_wt_texture && s_wt_texW > 0 && s_wt_texH > 0) {
-                        // Save GL state
-                        GLint savedProgram, savedVAO, savedVBO, savedFBO, savedTex, savedActiveTex;
-                        GLboolean savedBlend, savedDepthTest, savedScissor, savedStencil;
-                        GLint savedBlendSrcRGB, savedBlendDstRGB, savedBlendSrcA, savedBlendDstA;
-                        GLint savedViewport[4];
-                        GLboolean savedColorMask[4];
-                        GLint savedUnpackRowLength = 0;
-                        GLint savedUnpackSkipPixels = 0;
-                        GLint savedUnpackSkipRows = 0;
-                        GLint savedUnpackAlignment = 0;
-
-                        glGetIntegerv(GL_CURRENT_PROGRAM, &savedProgram);
-                        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &savedVAO);
-                        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &savedVBO);
-                        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &savedFBO);
-                        glGetIntegerv(GL_ACTIVE_TEXTURE, &savedActiveTex);
-                        glActiveTexture(GL_TEXTURE0);
-                        glGetIntegerv(GL_TEXTURE_BINDING_2D, &savedTex);
-                        savedBlend = glIsEnabled(GL_BLEND);
-                        savedDepthTest = glIsEnabled(GL_DEPTH_TEST);
-                        savedScissor = glIsEnabled(GL_SCISSOR_TEST);
-                        savedStencil = glIsEnabled(GL_STENCIL_TEST);
-                        glGetIntegerv(GL_BLEND_SRC_RGB, &savedBlendSrcRGB);
-                        glGetIntegerv(GL_BLEND_DST_RGB, &savedBlendDstRGB);
-                        glGetIntegerv(GL_BLEND_SRC_ALPHA, &savedBlendSrcA);
-                        glGetIntegerv(GL_BLEND_DST_ALPHA, &savedBlendDstA);
-                        glGetIntegerv(GL_VIEWPORT, savedViewport);
-                        glGetBooleanv(GL_COLOR_WRITEMASK, savedColorMask);
-
-                        glGetIntegerv(GL_UNPACK_ROW_LENGTH, &savedUnpackRowLength);
-                        glGetIntegerv(GL_UNPACK_SKIP_PIXELS, &savedUnpackSkipPixels);
-                        glGetIntegerv(GL_UNPACK_SKIP_ROWS, &savedUnpackSkipRows);
-                        glGetIntegerv(GL_UNPACK_ALIGNMENT, &savedUnpackAlignment);
+                        // Track what the toast changes so only that is put back
+                        GLStateTracker& glState = GLStateTracker::ForCurrentThread();
+                        glState.BeginFrame();
 
                         // Setup state
-                        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-                        if (oglViewport)
-                            oglViewport(0, 0, windowWidth, windowHeight);
-                        else
-                            glViewport(0, 0, windowWidth, windowHeight);
-                        glDisable(GL_DEPTH_TEST);
-                        glDisable(GL_SCISSOR_TEST);
-                        glDisable(GL_STENCIL_TEST);
-                        glEnable(GL_BLEND);
-                        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-                        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+                        GLTracked::BindFramebuffer(GL_FRAMEBUFFER, 0);
+                        GLTracked::Viewport(0, 0, windowWidth, windowHeight);
+                        GLTracked::Disable(GL_DEPTH_TEST);
+                        GLTracked::Disable(GL_SCISSOR_TEST);
+                        GLTracked::Disable(GL_STENCIL_TEST);
+                        GLTracked::Enable(GL_BLEND);
+                        GLTracked::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                        GLTracked::ColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 
                         // Bind shader and resources
-                        glUseProgram(s_wt_program);
-                        glBindVertexArray(s_wt_vao);
-                        glBindBuffer(GL_ARRAY_BUFFER, s_wt_vbo);
-                        glActiveTexture(GL_TEXTURE0);
-                        glBindTexture(GL_TEXTURE_2D, s_wt_texture);
+                        GLTracked::UseProgram(s_wt_program);
+                        GLTracked::BindVertexArray(s_wt_vao);
+                        GLTracked::BindBuffer(GL_ARRAY_BUFFER, s_wt_vbo);
+                        GLTracked::ActiveTexture(GL_TEXTURE0);
+                        GLTracked::BindTexture(GL_TEXTURE_2D, s_wt_texture);
                         glUniform1f(s_wt_locOpacity, 1.0f);
                         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
                         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
                         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
                         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-                        glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
-                        glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
-                        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+                        GLTracked::PixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+                        GLTracked::PixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+                        GLTracked::PixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+                        GLTracked::PixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
                         // Scale toast image based on window size (baseline 1080p)
                         float scaleFactor = (static_cast<float>(windowHeight) / 1080.0f) * 0.45f;
@@ -1833,42 +1823,7 @@ void main() {
                         glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(verts), verts);
                         glDrawArrays(GL_TRIANGLES, 0, 6);
 
-                        // Restore GL state
-                        glUseProgram(savedProgram);
-                        glBindVertexArray(savedVAO);
-                        glBindBuffer(GL_ARRAY_BUFFER, savedVBO);
-                        glBindFramebuffer(GL_FRAMEBUFFER, savedFBO);
-                        glActiveTexture(GL_TEXTURE0);
-                        glBindTexture(GL_TEXTURE_2D, savedTex);
-                        glActiveTexture(savedActiveTex);
-                        if (oglViewport)
-                            oglViewport(savedViewport[0], savedViewport[1], savedViewport[2], savedViewport[3]);
-                        else
-                            glViewport(savedViewport[0], savedViewport[1], savedViewport[2], savedViewport[3]);
-                        glColorMask(savedColorMask[0], savedColorMask[1], savedColorMask[2], savedColorMask[3]);
-
-                        glPixelStorei(GL_UNPACK_ROW_LENGTH, savedUnpackRowLength);
-                        glPixelStorei(GL_UNPACK_SKIP_PIXELS, savedUnpackSkipPixels);
-                        glPixelStorei(GL_UNPACK_SKIP_ROWS, savedUnpackSkipRows);
-                        glPixelStorei(GL_UNPACK_ALIGNMENT, savedUnpackAlignment);
-
-                        if (savedBlend)
-                            glEnable(GL_BLEND);
-                        else
-                            glDisable(GL_BLEND);
-                        if (savedDepthTest)
-                            glEnable(GL_DEPTH_TEST);
-                        else
-                            glDisable(GL_DEPTH_TEST);
-                        if (savedScissor)
-                            glEnable(GL_SCISSOR_TEST);
-                        else
-                            glDisable(GL_SCISSOR_TEST);
-                        if (savedStencil)
-                            glEnable(GL_STENCIL_TEST);
-                        else
-                            glDisable(GL_STENCIL_TEST);
-                        glBlendFuncSeparate(savedBlendSrcRGB, savedBlendDstRGB, savedBlendSrcA, savedBlendDstA);
+                        glState.EndFrame();
                     }
                 }
                 ClearObsOverride();
@@ -2134,19 +2089,14 @@ void main() {
         GLState s;
         {
             PROFILE_SCOPE_CAT("OpenGL State Backup", "SwapBuffers");
-            SaveGLState(&s);
+            BeginGLStateTracking(&s);
         }
 
         {
             PROFILE_SCOPE_CAT("Texture Cleanup", "SwapBuffers");
-            if (g_hasTexturesToDelete.load(std::memory_order_acquire)) {
-                std::lock_guard<std::mutex> lock(g_texturesToDeleteMutex);
-                if (!g_texturesToDelete.empty()) {
-                    glDeleteTextures((GLsizei)g_texturesToDelete.size(), g_texturesToDelete.data());
-                    g_texturesToDelete.clear();
-                }
-                g_hasTexturesToDelete.store(false, std::memory_order_release);
-            }
+            // Deletes objects released for the game context once the frames that could still use them are done
+            GpuResourceManager& resources = GpuResourceManager::Get();
+            if (resources.HasPending(GpuContextQueue::Game)) { resources.Retire(GpuContextQueue::Game); }
         }
 
         // Note: Image processing is now done in render_thread
@@ -2189,7 +2139,7 @@ void main() {
                     submission.context.gameW = current_gameW;
                     submission.context.gameH = current_gameH;
                     submission.context.gameTextureId = g_cachedGameTextureId.load();
-                    submission.context.modeId = modeToRenderCopy.id;
+                    submission.context.modeHandle = GetModeIdHandle(modeToRenderCopy);
                     submission.context.relativeStretching = modeToRenderCopy.relativeStretching;
                     submission.context.bgR = modeToRenderCopy.background.color.r;
                     submission.context.bgG = modeToRenderCopy.background.color.g;
@@ -2243,12 +2193,11 @@ void main() {
         // All ImGui rendering is handled by render thread (via FrameRenderRequest ImGui state fields)
         // Screenshot handling stays on main thread since it needs direct backbuffer access
         if (g_screenshotRequested.exchange(false)) {
-            glBindFramebuffer(GL_READ_FRAMEBUFFER, s.read_fb);
+            GLTracked::BindFramebuffer(GL_READ_FRAMEBUFFER, s.read_fb);
             ScreenshotToClipboard(fullW, fullH);
         }
 
-        // Render fake cursor overlay if enabled (MUST be after RestoreGLState)
-        // ^ the above comment might be lying idk
+        // Render fake cursor overlay if enabled (still inside GL state tracking, so its changes are restored too)
         {
             bool fakeCursorEnabled = frameCfg.debug.fakeCursor;
             if (fakeCursorEnabled) {
@@ -2259,7 +2208,7 @@ void main() {
 
         {
             PROFILE_SCOPE_CAT("OpenGL State Restore", "SwapBuffers");
-            RestoreGLState(s);
+            EndGLStateTracking();
         }
 
         Profiler::GetInstance().EndFrame();
@@ -0,0 +1,90 @@
+// ============================================================================
+// EASING_CURVE.CPP - Baked easing curves for mode transitions
+// ============================================================================
+
+#include "easing_curve.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr float PI = 3.14159265f;
+
+// Easing functions with configurable power/exponent
+float EaseOutPower(float t, float power) {
+    float t1 = t - 1.0f;
+    // For odd powers, we need abs to handle negative values correctly
+    float sign = (t1 < 0) ? -1.0f : 1.0f;
+    return sign * std::pow(std::abs(t1), power) + 1.0f;
+}
+
+float EaseInPower(float t, float power) { return std::pow(t, power); }
+
+// Each successive bounce has reduced intensity; quadratic decay for a more natural feel
+float BounceDecay(int bounceIndex, int totalBounces) {
+    float decayFactor = 1.0f - (static_cast<float>(bounceIndex) / static_cast<float>(totalBounces));
+    return decayFactor * decayFactor;
+}
+
+} // namespace
+
+float ApplyDualEasing(float t, float easeInPower, float easeOutPower) {
+    // Clamp powers to reasonable range
+    easeInPower = std::clamp(easeInPower, 1.0f, 10.0f);
+    easeOutPower = std::clamp(easeOutPower, 1.0f, 10.0f);
+
+    // If both are 1.0, it's linear
+    if (easeInPower <= 1.0f && easeOutPower <= 1.0f) { return t; }
+
+    // Split the animation into two halves
+    // First half: apply ease-in (slow start)
+    // Second half: apply ease-out (slow stop)
+    if (t < 0.5f) {
+        // First half - apply ease-in
+        float halfT = t * 2.0f; // Scale input from [0, 0.5] to [0, 1]
+        float easedHalfT = EaseInPower(halfT, easeInPower);
+        return easedHalfT * 0.5f; // Scale output back to [0, 0.5]
+    } else {
+        // Second half - apply ease-out
+        float halfT = (t - 0.5f) * 2.0f; // Scale input from [0.5, 1] to [0, 1]
+        float easedHalfT = EaseOutPower(halfT, easeOutPower);
+        return 0.5f + easedHalfT * 0.5f; // Scale output to [0.5, 1]
+    }
+}
+
+float CalculateBounceOffset(float bounceProgress, int bounceIndex, int totalBounces, float intensity) {
+    if (totalBounces <= 0 || bounceIndex >= totalBounces) return 0.0f;
+
+    // Sine wave for smooth bounce oscillation (half cycle per bounce)
+    float angle = bounceProgress * PI; // 0 to PI for one half-cycle
+    return std::sin(angle) * intensity * BounceDecay(bounceIndex, totalBounces);
+}
+
+float ApplyEasing(EasingType type, float t) {
+    switch (type) {
+    case EasingType::EaseIn:
+        return t * t * t;
+    case EasingType::EaseOut: {
+        float u = 1.0f - t;
+        return 1.0f - u * u * u;
+    }
+    case EasingType::EaseInOut: {
+        if (t < 0.5f) return 4.0f * t * t * t;
+        float u = 2.0f - 2.0f * t;
+        return 1.0f - u * u * u * 0.5f;
+    }
+    default:
+        return t;
+    }
+}
+
+void BuildDualEasingLut(float easeInPower, float easeOutPower, EasingCurveLut& out) {
+    out.samples.resize(EASING_CURVE_SAMPLES + 1);
+    for (int i = 0; i <= EASING_CURVE_SAMPLES; i++) {
+        out.samples[i] = ApplyDualEasing(static_cast<float>(i) / EASING_CURVE_SAMPLES, easeInPower, easeOutPower);
+    }
+    // Pin the endpoints so a finished move lands exactly on 0 / 1
+    out.samples.front() = 0.0f;
+    out.samples.back() = 1.0f;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+// ============================================================================
+// EASING_CURVE.H - Baked easing curves for mode transitions
+// ============================================================================
+// The transition easing (dual ease-in/ease-out powers) is a closed-form function built from std::pow. A
+// transition is evaluated by the viewport hook on every matching glViewport call plus once per frame by the
+// game thread and the OBS pass, always with the same configured powers, so the curve is sampled once when
+// the transition starts and evaluated per call by linear interpolation between samples. The bounce
+// oscillation is a single std::sin per call and is evaluated in closed form; a table for it measured no
+// faster (easing_curve_bench).
+//
+// Linear interpolation of a monotonic curve is monotonic, so an eased position never steps backwards.
+// With EASING_CURVE_SAMPLES intervals the error against the closed form stays below 1e-4 for every power
+// ModeConfig allows (1 to 10), well under a pixel on a 4K-wide transition. The closed-form functions stay
+// here as the reference the tables are built from.
+//
+// EasingType and ApplyEasing are the named cubic curves used between overlay keyframes (overlay_timeline.h).
+// ============================================================================
+
+#include <vector>
+
+enum class EasingType {
+    Linear,   // No easing, constant speed
+    EaseOut,  // Slow down at end
+    EaseIn,   // Speed up from start
+    EaseInOut // Slow start and end
+};
+
+// Cubic ease of the given type over [0, 1]
+float ApplyEasing(EasingType type, float t);
+
+constexpr int EASING_CURVE_SAMPLES = 1024; // Intervals; tables hold one more sample than this
+
+// Closed form: combined ease-in and ease-out with separate power controls
+// easeInPower: 1.0 = no ease-in (linear start), higher = more pronounced slow start
+// easeOutPower: 1.0 = no ease-out (linear end), higher = more pronounced slow stop
+float ApplyDualEasing(float t, float easeInPower, float easeOutPower);
+
+// Closed form: bounce offset multiplier. The bounce goes BACK towards origin (opposite direction of movement)
+// bounceProgress: 0.0 to 1.0 within the bounce phase
+// bounceIndex: which bounce we're on (0 = first bounce)
+// totalBounces: total number of bounces
+// intensity: base intensity (0.0-0.5)
+float CalculateBounceOffset(float bounceProgress, int bounceIndex, int totalBounces, float intensity);
+
+// A curve over [0, 1] sampled at EASING_CURVE_SAMPLES + 1 evenly spaced points
+struct EasingCurveLut {
+    std::vector<float> samples;
+
+    bool IsBuilt() const { return !samples.empty(); }
+
+    // Linear interpolation between samples; t is clamped to [0, 1]
+    float Sample(float t) const {
+        if (!(t > 0.0f)) return samples.front(); // Also catches NaN
+        if (t >= 1.0f) return samples.back();
+        const float pos = t * static_cast<float>(EASING_CURVE_SAMPLES);
+        const int i = static_cast<int>(pos);
+        const float frac = pos - static_cast<float>(i);
+        return samples[i] + (samples[i + 1] - samples[i]) * frac;
+    }
+};
+
+// ApplyDualEasing(t, easeInPower, easeOutPower) for the configured pair
+void BuildDualEasingLut(float easeInPower, float easeOutPower, EasingCurveLut& out);
@@ -0,0 +1,191 @@
+// ============================================================================
+// EYEZOOM_LAYOUT.CPP - Placement and overlay layout of the EyeZoom strip
+// ============================================================================
+
+#include "eyezoom_layout.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace {
+
+constexpr float CENTER_LINE_WIDTH = 2.0f;
+constexpr float MIN_AUTO_FONT_SIZE = 6.0f;
+
+// Solid edges are snapped to the pixel boundary the rasterizer would use (pixel centers at or right of x are
+// covered), so an edge landing exactly on a pixel center does not depend on rounding in the NDC conversion and
+// the overlay covers the same pixels wherever it is drawn
+float SnapEdge(float x) { return std::ceil(x - 0.5f); }
+
+// Clips a glyph to [0, width] x [0, height], moving its atlas coordinates with the edges. False if nothing is left.
+bool ClipGlyph(EyeZoomFont::Glyph& g, float width, float height) {
+    if (g.x2 <= g.x1 || g.y2 <= g.y1) return false;
+    const float nx1 = (std::max)(g.x1, 0.0f), nx2 = (std::min)(g.x2, width);
+    const float ny1 = (std::max)(g.y1, 0.0f), ny2 = (std::min)(g.y2, height);
+    if (nx2 <= nx1 || ny2 <= ny1) return false;
+
+    const float du = (g.u2 - g.u1) / (g.x2 - g.x1), dv = (g.v2 - g.v1) / (g.y2 - g.y1);
+    g.u2 = g.u1 + (nx2 - g.x1) * du;
+    g.u1 = g.u1 + (nx1 - g.x1) * du;
+    g.v2 = g.v1 + (ny2 - g.y1) * dv;
+    g.v1 = g.v1 + (ny1 - g.y1) * dv;
+    g.x1 = nx1, g.x2 = nx2, g.y1 = ny1, g.y2 = ny2;
+    return true;
+}
+
+} // namespace
+
+EyeZoomPlacement ComputeEyeZoomPlacement(const EyeZoomLayoutParams& params, int fullW, int fullH, int requestViewportX,
+                                         bool isTransitioningFromEyeZoom) {
+    EyeZoomPlacement p;
+
+    // The game viewport rests centered; the strip fills what is left of it
+    const int targetViewportX = (fullW - params.windowWidth) / 2;
+    const int viewportX = (requestViewportX >= 0) ? requestViewportX : targetViewportX;
+    if (viewportX <= 0) return p; // No space for EyeZoom on the left
+
+    const bool isTransitioningToEyeZoom = (viewportX < targetViewportX && !isTransitioningFromEyeZoom);
+    if (params.slideZoomIn) {
+        // Full size at all times, sliding in from (and out to) the left with the viewport's progress
+        p.width = targetViewportX - (2 * params.horizontalMargin);
+        const int finalX = params.horizontalMargin;
+        const int offScreenX = -p.width;
+        if ((isTransitioningToEyeZoom || isTransitioningFromEyeZoom) && targetViewportX > 0) {
+            const float progress = (float)viewportX / (float)targetViewportX;
+            p.x = offScreenX + (int)((finalX - offScreenX) * progress);
+        } else {
+            p.x = finalX;
+        }
+    } else {
+        // Grows with the viewport, keeping the margin on both of its sides
+        p.width = viewportX - (2 * params.horizontalMargin);
+        p.x = params.horizontalMargin;
+    }
+    if (p.width <= 1) return p;
+
+    p.height = fullH - (2 * params.verticalMargin);
+    const int minHeight = (int)(0.2f * fullH);
+    if (p.height < minHeight) p.height = minHeight;
+    p.y = params.verticalMargin;
+
+    p.visible = true;
+    p.labels = p.width > 20;
+    return p;
+}
+
+void LayoutEyeZoomOverlay(const EyeZoomLayoutParams& params, int width, int height, bool labels, const EyeZoomFont* font,
+                          EyeZoomOverlay& out) {
+    out.width = width;
+    out.height = height;
+    out.columnWidth = 0.0f;
+    out.boxes.clear();
+    out.lineX1 = out.lineX2 = 0.0f;
+    out.labels.clear();
+    out.glyphs.clear();
+    if (width <= 0 || height <= 0 || params.cloneWidth <= 0) return;
+
+    const float columnWidth = width / (float)params.cloneWidth;
+    const int labelsPerSide = params.cloneWidth / 2;
+    int overlayLabelsPerSide = params.overlayWidth;
+    if (overlayLabelsPerSide < 0) overlayLabelsPerSide = labelsPerSide;
+    if (overlayLabelsPerSide > labelsPerSide) overlayLabelsPerSide = labelsPerSide;
+    const float centerY = height / 2.0f;
+    out.columnWidth = columnWidth;
+
+    // Boxes: one per column on each side of the center line, skipping the center itself
+    const float boxHeight = params.linkRectToFont ? (params.textFontSize * 1.2f) : (float)params.rectHeight;
+    for (int xOffset = -overlayLabelsPerSide; xOffset <= overlayLabelsPerSide; xOffset++) {
+        if (xOffset == 0) continue;
+        // Map xOffset (relative to center) to the full clone column index [0..cloneWidth-1]
+        const int boxIndex = xOffset + labelsPerSide - (xOffset > 0 ? 1 : 0);
+        EyeZoomBox box;
+        box.x1 = SnapEdge(boxIndex * columnWidth);
+        box.x2 = SnapEdge((boxIndex + 1) * columnWidth);
+        box.y1 = (std::max)(SnapEdge(centerY - boxHeight / 2.0f), 0.0f);
+        box.y2 = (std::min)(SnapEdge(centerY + boxHeight / 2.0f), (float)height);
+        box.number = std::abs(xOffset);
+        box.firstColor = (boxIndex % 2 == 0);
+        if (box.y2 > box.y1) out.boxes.push_back(box);
+    }
+
+    const float centerX = width / 2.0f;
+    out.lineX1 = SnapEdge(centerX - CENTER_LINE_WIDTH / 2.0f);
+    out.lineX2 = SnapEdge(centerX + CENTER_LINE_WIDTH / 2.0f);
+
+    if (!labels || !font) return;
+
+    // autoFontSize fits the numbers into the boxes, with headroom so digits don't touch the borders;
+    // otherwise textFontSize is used as-is
+    const float requestedFontSize = (std::max)((float)params.textFontSize, 1.0f);
+    float fontSize = requestedFontSize;
+    if (params.autoFontSize) {
+        const float fitBoxHeight = params.linkRectToFont ? (requestedFontSize * 1.2f) : (float)params.rectHeight;
+        const float maxFontByWidth = columnWidth * 0.90f;
+        const float maxFontByHeight = fitBoxHeight * 0.85f;
+        if (maxFontByWidth > 0.0f) fontSize = (std::min)(fontSize, maxFontByWidth);
+        if (maxFontByHeight > 0.0f) fontSize = (std::min)(fontSize, maxFontByHeight);
+        if (fontSize < MIN_AUTO_FONT_SIZE) fontSize = MIN_AUTO_FONT_SIZE;
+    }
+
+    std::vector<EyeZoomFont::Glyph> glyphs;
+    for (int xOffset = -overlayLabelsPerSide; xOffset <= overlayLabelsPerSide; xOffset++) {
+        if (xOffset == 0) continue;
+        const int boxIndex = xOffset + labelsPerSide - (xOffset > 0 ? 1 : 0);
+        const std::string text = std::to_string(std::abs(xOffset));
+
+        // Multi-digit numbers shrink further to fit a single box (auto size only)
+        float labelFontSize = fontSize;
+        float textW = 0.0f, textH = 0.0f;
+        font->MeasureText(labelFontSize, text.c_str(), textW, textH);
+        if (params.autoFontSize) {
+            const float maxTextWidth = columnWidth * 0.94f;
+            if (maxTextWidth > 0.0f && textW > maxTextWidth && textW > 0.0f) {
+                labelFontSize = (std::max)(MIN_AUTO_FONT_SIZE, labelFontSize * (maxTextWidth / textW));
+                font->MeasureText(labelFontSize, text.c_str(), textW, textH);
+            }
+        }
+
+        EyeZoomLabel label;
+        label.number = std::abs(xOffset);
+        label.x = std::floor(boxIndex * columnWidth + columnWidth / 2.0f - textW / 2.0f);
+        label.y = std::floor(centerY - textH / 2.0f);
+        label.fontSize = labelFontSize;
+        label.firstGlyph = static_cast<int>(out.glyphs.size());
+
+        glyphs.clear();
+        font->AppendGlyphs(labelFontSize, text.c_str(), glyphs);
+        for (EyeZoomFont::Glyph g : glyphs) {
+            g.x1 += label.x, g.x2 += label.x;
+            g.y1 += label.y, g.y2 += label.y;
+            if (ClipGlyph(g, (float)width, (float)height)) out.glyphs.push_back(g);
+        }
+        label.glyphCount = static_cast<int>(out.glyphs.size()) - label.firstGlyph;
+        out.labels.push_back(label);
+    }
+}
+
+void RecordEyeZoomOverlay(const EyeZoomOverlay& overlay, const EyeZoomColors& colors, int originX, int originY, int targetW, int targetH,
+                          uint32_t atlasTexture, RenderBlendMode blend, RenderCommandList& out) {
+    if (targetW <= 0 || targetH <= 0) return;
+    // Strip pixels (y down) to target NDC (y up)
+    auto ndcX = [&](float x) { return ((originX + x) / (float)targetW) * 2.0f - 1.0f; };
+    auto ndcY = [&](float y) { return 1.0f - ((originY + y) / (float)targetH) * 2.0f; };
+
+    for (const EyeZoomBox& box : overlay.boxes) {
+        const float* c = box.firstColor ? colors.gridColor1 : colors.gridColor2;
+        out.SolidQuad({ ndcX(box.x1), ndcY(box.y2), ndcX(box.x2), ndcY(box.y1) }, c[0], c[1], c[2], c[3], blend);
+    }
+
+    if (overlay.lineX2 > overlay.lineX1) {
+        const float* c = colors.centerLine;
+        out.SolidQuad({ ndcX(overlay.lineX1), ndcY((float)overlay.height), ndcX(overlay.lineX2), ndcY(0.0f) }, c[0], c[1], c[2], c[3], blend);
+    }
+
+    if (atlasTexture == 0) return;
+    const float* c = colors.text;
+    for (const EyeZoomFont::Glyph& g : overlay.glyphs) {
+        out.Text({ ndcX(g.x1), ndcY(g.y2), ndcX(g.x2), ndcY(g.y1) }, { g.u1, g.v2, g.u2, g.v1 }, atlasTexture, c[0], c[1], c[2], c[3],
+                 RenderFilter::Linear, blend);
+    }
+}
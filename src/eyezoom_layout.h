@@ -0,0 +1,103 @@
+#pragma once
+
+// ============================================================================
+// EYEZOOM_LAYOUT.H - Placement and overlay layout of the EyeZoom strip
+// ============================================================================
+// EyeZoom magnifies a narrow column at the center of the game into a strip left of the game viewport, with
+// numbered grid boxes across its middle and a vertical center line on top. Only the magnified column changes
+// from frame to frame. The boxes, line and numbers depend on the EyeZoom settings, the strip's size and the
+// font alone, so LayoutEyeZoomOverlay computes them once per such combination (text measurement and glyph
+// placement included) and the render thread keeps the result pre-rendered in a texture that it composites
+// over the magnified column (RT_RenderEyeZoom in render_thread.cpp).
+//
+// The overlay is laid out relative to the strip, so a strip sliding in or out keeps using it;
+// ComputeEyeZoomPlacement gives the strip's position for a frame. Coordinates are pixels with the origin at
+// the top left and y pointing down.
+//
+// This file uses no GL or ImGui (text goes through EyeZoomFont), so layouts can be computed and rendered
+// with SoftwareRenderBackend without a context.
+// ============================================================================
+
+#include <cstdint>
+#include <vector>
+
+#include "render_commands.h"
+
+// The EyeZoomConfig (gui.h) fields the layout depends on
+struct EyeZoomLayoutParams {
+    int cloneWidth = 24;   // Magnified source columns
+    int overlayWidth = 12; // Boxes per side of the center line (clamped to cloneWidth / 2, negative = all)
+    int windowWidth = 384; // Game viewport width in EyeZoom mode
+    int horizontalMargin = 0;
+    int verticalMargin = 0;
+    bool slideZoomIn = false;
+    bool autoFontSize = true;
+    int textFontSize = 24;
+    int rectHeight = 24;
+    bool linkRectToFont = true;
+};
+
+// Where the strip goes in a frame
+struct EyeZoomPlacement {
+    bool visible = false;
+    int x = 0, y = 0;
+    int width = 0, height = 0;
+    bool labels = false; // Strips 20 pixels wide or less are drawn without numbers
+};
+
+// requestViewportX is the game viewport's (possibly animated) X, or -1 for EyeZoom's resting position
+EyeZoomPlacement ComputeEyeZoomPlacement(const EyeZoomLayoutParams& params, int fullW, int fullH, int requestViewportX,
+                                         bool isTransitioningFromEyeZoom);
+
+// Text metrics and glyphs, implemented over the EyeZoom ImGui font on the render thread
+class EyeZoomFont {
+  public:
+    struct Glyph {
+        float x1, y1, x2, y2; // Pixels, relative to the text's top left
+        float u1, v1, u2, v2; // Atlas coordinates at (x1, y1) and (x2, y2)
+    };
+
+    virtual ~EyeZoomFont() = default;
+    virtual void MeasureText(float size, const char* text, float& width, float& height) const = 0;
+    virtual void AppendGlyphs(float size, const char* text, std::vector<Glyph>& out) const = 0;
+};
+
+struct EyeZoomBox {
+    float x1, y1, x2, y2;
+    int number;      // Columns from the center line
+    bool firstColor; // gridColor1, otherwise gridColor2
+};
+
+struct EyeZoomLabel {
+    int number;
+    float x, y;     // Top left of the text, snapped to whole pixels like ImGui text
+    float fontSize;
+    int firstGlyph; // Into EyeZoomOverlay::glyphs
+    int glyphCount;
+};
+
+struct EyeZoomOverlay {
+    int width = 0, height = 0;      // Strip size the overlay was laid out for
+    float columnWidth = 0.0f;       // Strip pixels per magnified source column
+    std::vector<EyeZoomBox> boxes;  // Left to right, clipped to the strip
+    float lineX1 = 0.0f, lineX2 = 0.0f; // Center line, full strip height
+    std::vector<EyeZoomLabel> labels;
+    std::vector<EyeZoomFont::Glyph> glyphs; // Positioned in the strip and clipped to it
+};
+
+// `font` may be null (fonts not loaded yet): the overlay then has no labels
+void LayoutEyeZoomOverlay(const EyeZoomLayoutParams& params, int width, int height, bool labels, const EyeZoomFont* font,
+                          EyeZoomOverlay& out);
+
+// RGBA, opacity included
+struct EyeZoomColors {
+    float gridColor1[4];
+    float gridColor2[4];
+    float centerLine[4];
+    float text[4];
+};
+
+// Records boxes, center line and labels (glyphs from atlasTexture), in that order, with the strip's top left at
+// (originX, originY) of a targetW x targetH target
+void RecordEyeZoomOverlay(const EyeZoomOverlay& overlay, const EyeZoomColors& colors, int originX, int originY, int targetW, int targetH,
+                          uint32_t atlasTexture, RenderBlendMode blend, RenderCommandList& out);
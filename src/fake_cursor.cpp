@@ -1,4 +1,5 @@
 #include "fake_cursor.h"
+#include "gl_state_tracker.h"
 #include "gui.h"
 #include "utils.h"
 #include <filesystem>
@@ -139,6 +140,14 @@ static const std::vector<int> STANDARD_SIZES = {
 };
 
 // Helper function to load a single cursor and create all its data (texture, hotspot, etc.)
+// Hands a successfully created cursor's textures to the resource manager (both are RGBA-sized, no mips)
+static void RegisterCursorTextures(CursorData& data, int width, int height) {
+    GpuResourceManager& resources = GpuResourceManager::Get();
+    const uint64_t bytes = GpuTextureBytes(width, height);
+    data.textureHandle = resources.Register(GpuResourceKind::Texture, data.texture, GpuSubsystem::Cursors, bytes);
+    data.invertMaskHandle = resources.Register(GpuResourceKind::Texture, data.invertMaskTexture, GpuSubsystem::Cursors, bytes);
+}
+
 static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size, CursorData& outData) {
     // Validate parameters
     if (path.empty()) {
@@ -333,11 +342,11 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
     bmi.bmiHeader.biBitCount = 32;
     bmi.bmiHeader.biCompression = BI_RGB;
 
-    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
-    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    GLTracked::PixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    GLTracked::PixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    GLTracked::PixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+    GLTracked::PixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    GLTracked::PixelStorei(GL_PACK_ALIGNMENT, 1);
 
     if (isMonochrome) {
         // For monochrome cursors, extract both AND and XOR masks from hbmMask
@@ -424,7 +433,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
                 LogCategory("cursor_textures", "[CursorTextures] WARNING: Failed to create invert mask texture - glGenTextures returned 0");
                 outData.hasInvertedPixels = false; // Disable inversion since we can't render it
             } else {
-                glBindTexture(GL_TEXTURE_2D, outData.invertMaskTexture);
+                GLTracked::BindTexture(GL_TEXTURE_2D, outData.invertMaskTexture);
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -442,7 +451,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
                     LogCategory("cursor_textures",
                                 "[CursorTextures] Created invert mask texture ID " + std::to_string(outData.invertMaskTexture));
                 }
-                glBindTexture(GL_TEXTURE_2D, 0);
+                GLTracked::BindTexture(GL_TEXTURE_2D, 0);
             }
         }
 
@@ -511,7 +520,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
         return false;
     }
 
-    glBindTexture(GL_TEXTURE_2D, outData.texture);
+    GLTracked::BindTexture(GL_TEXTURE_2D, outData.texture);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -551,8 +560,9 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
         return false;
     }
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLTracked::BindTexture(GL_TEXTURE_2D, 0);
 
+    RegisterCursorTextures(outData, width, height);
     LogCategory("cursor_textures", "[CursorTextures] Successfully created texture ID " + std::to_string(outData.texture) + " (" +
                                        std::to_string(width) + "x" + std::to_string(height) + ") for " + WideToUtf8(path));
     return true;
@@ -739,11 +749,11 @@ static bool CreateTextureFromHandle(HCURSOR hCursor, CursorData& outData) {
     bmi.bmiHeader.biBitCount = 32;
     bmi.bmiHeader.biCompression = BI_RGB;
 
-    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
-    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    GLTracked::PixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    GLTracked::PixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    GLTracked::PixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+    GLTracked::PixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    GLTracked::PixelStorei(GL_PACK_ALIGNMENT, 1);
 
     if (isMonochrome) {
         HBITMAP hbmOld = (HBITMAP)SelectObject(hdcMem, iconInfoEx.hbmMask);
@@ -785,13 +795,13 @@ static bool CreateTextureFromHandle(HCURSOR hCursor, CursorData& outData) {
             while (glGetError() != GL_NO_ERROR) {}
             glGenTextures(1, &outData.invertMaskTexture);
             if (outData.invertMaskTexture != 0) {
-                glBindTexture(GL_TEXTURE_2D, outData.invertMaskTexture);
+                GLTracked::BindTexture(GL_TEXTURE_2D, outData.invertMaskTexture);
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
                 glTexImage2D(GL_TEXTURE_2D, 0, GL_SRGB8_ALPHA8, width, height, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE, invertPixels.data());
-                glBindTexture(GL_TEXTURE_2D, 0);
+                GLTracked::BindTexture(GL_TEXTURE_2D, 0);
             }
         }
         SelectObject(hdcMem, hbmOld);
@@ -837,7 +847,7 @@ static bool CreateTextureFromHandle(HCURSOR hCursor, CursorData& outData) {
     glGenTextures(1, &outData.texture);
     if (outData.texture == 0) { return false; }
 
-    glBindTexture(GL_TEXTURE_2D, outData.texture);
+    GLTracked::BindTexture(GL_TEXTURE_2D, outData.texture);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -854,7 +864,8 @@ static bool CreateTextureFromHandle(HCURSOR hCursor, CursorData& outData) {
         return false;
     }
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLTracked::BindTexture(GL_TEXTURE_2D, 0);
+    RegisterCursorTextures(outData, width, height);
     return true;
 }
 
@@ -1034,12 +1045,12 @@ void Cleanup() {
 
     for (auto& cursor : g_cursorList) {
         if (cursor.texture) {
-            glDeleteTextures(1, &cursor.texture);
+            GpuResourceManager::Get().ReleaseNow(cursor.textureHandle);
             cursor.texture = 0;
             texturesDeleted++;
         }
         if (cursor.invertMaskTexture) {
-            glDeleteTextures(1, &cursor.invertMaskTexture);
+            GpuResourceManager::Get().ReleaseNow(cursor.invertMaskHandle);
             cursor.invertMaskTexture = 0;
             invertMasksDeleted++;
         }
@@ -1188,17 +1199,17 @@ void RenderFakeCursor(HWND hwnd, int windowWidth, int windowHeight) {
         glGetIntegerv(GL_CURRENT_PROGRAM, &oldProgram);
 
         // Ensure we're drawing to the back buffer (framebuffer 0)
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLTracked::BindFramebuffer(GL_FRAMEBUFFER, 0);
 
         // Disable scissor test in case it's cutting off our rendering
-        glDisable(GL_SCISSOR_TEST);
+        GLTracked::Disable(GL_SCISSOR_TEST);
 
         // Set up for 2D overlay rendering
-        glDisable(GL_DEPTH_TEST);
-        glDisable(GL_CULL_FACE);
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glUseProgram(0); // Fixed function pipeline
+        GLTracked::Disable(GL_DEPTH_TEST);
+        GLTracked::Disable(GL_CULL_FACE);
+        GLTracked::Enable(GL_BLEND);
+        GLTracked::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLTracked::UseProgram(0); // Fixed function pipeline
 
         // Set up orthographic projection (pixel coordinates)
         glMatrixMode(GL_PROJECTION);
@@ -1211,22 +1222,22 @@ void RenderFakeCursor(HWND hwnd, int windowWidth, int windowHeight) {
         glLoadIdentity();
 
         // Render normal cursor pixels first (with alpha blending)
-        glEnable(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, cursorData->texture);
+        glEnable(GL_TEXTURE_2D); // Fixed function only, saved and restored here
+        GLTracked::BindTexture(GL_TEXTURE_2D, cursorData->texture);
         glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLTracked::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
         // Render at normal position
         RenderCursorQuad(cursorX, cursorY);
 
         // Render inverted pixels if this cursor has them (with XOR blending)
         if (cursorData->hasInvertedPixels && cursorData->invertMaskTexture != 0) {
-            glBindTexture(GL_TEXTURE_2D, cursorData->invertMaskTexture);
+            GLTracked::BindTexture(GL_TEXTURE_2D, cursorData->invertMaskTexture);
 
             // Use XOR blend function to invert background colors
             // GL_ONE_MINUS_DST_COLOR inverts the destination color
             // GL_ONE_MINUS_SRC_ALPHA respects the mask's alpha channel (transparent where alpha=0, invert where alpha=255)
-            glBlendFunc(GL_ONE_MINUS_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA);
+            GLTracked::BlendFunc(GL_ONE_MINUS_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA);
 
             // Render inverted regions at same position
             RenderCursorQuad(cursorX, cursorY);
@@ -1240,12 +1251,12 @@ void RenderFakeCursor(HWND hwnd, int windowWidth, int windowHeight) {
 
         // Restore all saved state
         if (!oldTexture2D) glDisable(GL_TEXTURE_2D);
-        if (!oldBlend) glDisable(GL_BLEND);
-        if (oldDepth) glEnable(GL_DEPTH_TEST);
-        if (oldScissor) glEnable(GL_SCISSOR_TEST);
-        if (oldCullFace) glEnable(GL_CULL_FACE);
-        glBlendFunc(oldBlendSrc, oldBlendDst);
-        glUseProgram(oldProgram);
+        if (!oldBlend) GLTracked::Disable(GL_BLEND);
+        if (oldDepth) GLTracked::Enable(GL_DEPTH_TEST);
+        if (oldScissor) GLTracked::Enable(GL_SCISSOR_TEST);
+        if (oldCullFace) GLTracked::Enable(GL_CULL_FACE);
+        GLTracked::BlendFunc(oldBlendSrc, oldBlendDst);
+        GLTracked::UseProgram(oldProgram);
 
         // Force flush to ensure rendering happens
         glFlush();
@@ -9,6 +9,8 @@
 #include <vector>
 #include <windows.h>
 
+#include "gpu_resources.h"
+
 // Unified Cursor Texture System
 namespace CursorTextures {
 struct CursorData {
@@ -17,6 +19,7 @@ struct CursorData {
     std::wstring filePath;        // Source file path
     GLuint texture = 0;           // Main cursor texture
     GLuint invertMaskTexture = 0; // Mask for inverted pixels (XOR blending)
+    GpuResourceHandle textureHandle, invertMaskHandle; // Own the two textures above
     int hotspotX = 0;             // Hotspot offset in pixels
     int hotspotY = 0;
     int bitmapWidth = 32;           // Actual bitmap width after loading
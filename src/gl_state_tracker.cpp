@@ -0,0 +1,549 @@
+// ============================================================================
+// GL_STATE_TRACKER.CPP - Shadowed GL state for rendering on the game's context
+// ============================================================================
+
+#include "gl_state_tracker.h"
+
+#include <string>
+#include <windows.h>
+
+#include "profiler.h"
+#include "utils.h"
+
+// The unhooked glViewport, set up by the hook installer in dllmain.cpp (also declared in render.h)
+typedef void(WINAPI* GLVIEWPORTPROC)(GLint x, GLint y, GLsizei width, GLsizei height);
+extern GLVIEWPORTPROC oglViewport;
+
+namespace {
+
+// What the old SaveGLState/RestoreGLState pair cost every frame: 25 queries and 23 restoring calls
+constexpr uint32_t FULL_SAVE_RESTORE_GL_CALLS = 48;
+
+class GLCallStateBackend final : public GLStateBackend {
+  public:
+    void GetIntegerv(GLenum pname, GLint* out) override { glGetIntegerv(pname, out); }
+    void GetFloatv(GLenum pname, GLfloat* out) override { glGetFloatv(pname, out); }
+    void GetBooleanv(GLenum pname, GLboolean* out) override { glGetBooleanv(pname, out); }
+    bool IsEnabled(GLenum cap) override { return glIsEnabled(cap) != GL_FALSE; }
+    void SetEnabled(GLenum cap, bool enabled) override { enabled ? glEnable(cap) : glDisable(cap); }
+    void UseProgram(GLuint program) override { glUseProgram(program); }
+    void BindVertexArray(GLuint vao) override { glBindVertexArray(vao); }
+    void BindBuffer(GLenum target, GLuint buffer) override { glBindBuffer(target, buffer); }
+    void BindFramebuffer(GLenum target, GLuint framebuffer) override { glBindFramebuffer(target, framebuffer); }
+    void ActiveTexture(GLenum unit) override { glActiveTexture(unit); }
+    void BindTexture(GLenum target, GLuint texture) override { glBindTexture(target, texture); }
+    void BlendFuncSeparate(GLenum srcRgb, GLenum dstRgb, GLenum srcAlpha, GLenum dstAlpha) override {
+        glBlendFuncSeparate(srcRgb, dstRgb, srcAlpha, dstAlpha);
+    }
+    void Viewport(GLint x, GLint y, GLsizei width, GLsizei height) override {
+        // Unhooked, so our own viewport changes never reach the viewport hook's game-viewport logic
+        if (oglViewport)
+            oglViewport(x, y, width, height);
+        else
+            glViewport(x, y, width, height);
+    }
+    void Scissor(GLint x, GLint y, GLsizei width, GLsizei height) override { glScissor(x, y, width, height); }
+    void ClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a) override { glClearColor(r, g, b, a); }
+    void LineWidth(GLfloat width) override { glLineWidth(width); }
+    void ColorMask(GLboolean r, GLboolean g, GLboolean b, GLboolean a) override { glColorMask(r, g, b, a); }
+    void PixelStorei(GLenum pname, GLint value) override { glPixelStorei(pname, value); }
+    void* CurrentContext() override { return wglGetCurrentContext(); }
+};
+
+} // namespace
+
+GLStateTracker& GLStateTracker::ForCurrentThread() {
+    static GLCallStateBackend backend; // Stateless; every call goes to the calling thread's context
+    thread_local GLStateTracker tracker(backend);
+    return tracker;
+}
+
+bool GLStateTracker::Value::operator==(const Value& o) const {
+    for (int k = 0; k < 4; k++) {
+        if (i[k] != o.i[k] || f[k] != o.f[k]) return false;
+    }
+    return true;
+}
+
+int GLStateTracker::CapabilityField(GLenum cap) {
+    switch (cap) {
+    case GL_BLEND:
+        return CapBlend;
+    case GL_DEPTH_TEST:
+        return CapDepthTest;
+    case GL_SCISSOR_TEST:
+        return CapScissorTest;
+    case GL_FRAMEBUFFER_SRGB:
+        return CapFramebufferSrgb;
+    case GL_CULL_FACE:
+        return CapCullFace;
+    case GL_STENCIL_TEST:
+        return CapStencilTest;
+    default:
+        return -1;
+    }
+}
+
+int GLStateTracker::PixelStoreField(GLenum pname) {
+    switch (pname) {
+    case GL_UNPACK_ROW_LENGTH:
+        return UnpackRowLength;
+    case GL_UNPACK_SKIP_PIXELS:
+        return UnpackSkipPixels;
+    case GL_UNPACK_SKIP_ROWS:
+        return UnpackSkipRows;
+    case GL_UNPACK_ALIGNMENT:
+        return UnpackAlignment;
+    case GL_PACK_ALIGNMENT:
+        return PackAlignment;
+    default:
+        return -1;
+    }
+}
+
+int GLStateTracker::BufferField(GLenum target) {
+    switch (target) {
+    case GL_ARRAY_BUFFER:
+        return ArrayBuffer;
+    case GL_PIXEL_PACK_BUFFER:
+        return PixelPackBuffer;
+    case GL_PIXEL_UNPACK_BUFFER:
+        return PixelUnpackBuffer;
+    default:
+        return -1;
+    }
+}
+
+GLenum GLStateTracker::CapabilityEnum(int field) {
+    static const GLenum caps[] = { GL_BLEND, GL_DEPTH_TEST, GL_SCISSOR_TEST, GL_FRAMEBUFFER_SRGB, GL_CULL_FACE, GL_STENCIL_TEST };
+    static_assert(sizeof(caps) / sizeof(caps[0]) == CapStencilTest - CapBlend + 1, "Capabilities out of sync");
+    return caps[field - CapBlend];
+}
+
+const char* GLStateTracker::FieldName(int field) {
+    static const char* names[] = { "program",          "vertex array",      "array buffer",      "pixel pack buffer",
+                                   "pixel unpack buffer", "read framebuffer", "draw framebuffer", "active texture",
+                                   "GL_BLEND",         "GL_DEPTH_TEST",     "GL_SCISSOR_TEST",   "GL_FRAMEBUFFER_SRGB",
+                                   "GL_CULL_FACE",     "GL_STENCIL_TEST",   "blend func",        "viewport",
+                                   "scissor box",      "clear color",       "line width",        "color mask",
+                                   "unpack row length", "unpack skip pixels", "unpack skip rows", "unpack alignment",
+                                   "pack alignment" };
+    static_assert(sizeof(names) / sizeof(names[0]) == Texture2DUnit0, "Field names out of sync");
+    return field < Texture2DUnit0 ? names[field] : "texture 2D binding";
+}
+
+void GLStateTracker::Query(int field, Value& out, bool allowHook) {
+    out = Value{};
+    auto getInt = [this](GLenum pname, GLint* dst) {
+        m_backend.GetIntegerv(pname, dst);
+        m_stats.queries++;
+    };
+
+    switch (field) {
+    case Program:
+        getInt(GL_CURRENT_PROGRAM, out.i);
+        return;
+    case VertexArray:
+        getInt(GL_VERTEX_ARRAY_BINDING, out.i);
+        return;
+    case ArrayBuffer:
+        getInt(GL_ARRAY_BUFFER_BINDING, out.i);
+        return;
+    case PixelPackBuffer:
+        getInt(GL_PIXEL_PACK_BUFFER_BINDING, out.i);
+        return;
+    case PixelUnpackBuffer:
+        getInt(GL_PIXEL_UNPACK_BUFFER_BINDING, out.i);
+        return;
+    case ReadFramebuffer:
+        getInt(GL_READ_FRAMEBUFFER_BINDING, out.i);
+        return;
+    case DrawFramebuffer:
+        getInt(GL_DRAW_FRAMEBUFFER_BINDING, out.i);
+        return;
+    case ActiveTextureUnit:
+        getInt(GL_ACTIVE_TEXTURE, out.i);
+        return;
+    case BlendFuncs:
+        getInt(GL_BLEND_SRC_RGB, &out.i[0]);
+        getInt(GL_BLEND_DST_RGB, &out.i[1]);
+        getInt(GL_BLEND_SRC_ALPHA, &out.i[2]);
+        getInt(GL_BLEND_DST_ALPHA, &out.i[3]);
+        return;
+    case ViewportBox:
+        if (allowHook && m_hookViewportContext && m_hookViewportContext == m_backend.CurrentContext()) {
+            out = m_hookViewport;
+            return;
+        }
+        getInt(GL_VIEWPORT, out.i);
+        return;
+    case ScissorBox:
+        getInt(GL_SCISSOR_BOX, out.i);
+        return;
+    case ClearColorValue:
+        m_backend.GetFloatv(GL_COLOR_CLEAR_VALUE, out.f);
+        m_stats.queries++;
+        return;
+    case LineWidthValue:
+        m_backend.GetFloatv(GL_LINE_WIDTH, out.f);
+        m_stats.queries++;
+        return;
+    case ColorMaskValue: {
+        GLboolean mask[4] = {};
+        m_backend.GetBooleanv(GL_COLOR_WRITEMASK, mask);
+        m_stats.queries++;
+        for (int k = 0; k < 4; k++) { out.i[k] = mask[k]; }
+        return;
+    }
+    case UnpackRowLength:
+        getInt(GL_UNPACK_ROW_LENGTH, out.i);
+        return;
+    case UnpackSkipPixels:
+        getInt(GL_UNPACK_SKIP_PIXELS, out.i);
+        return;
+    case UnpackSkipRows:
+        getInt(GL_UNPACK_SKIP_ROWS, out.i);
+        return;
+    case UnpackAlignment:
+        getInt(GL_UNPACK_ALIGNMENT, out.i);
+        return;
+    case PackAlignment:
+        getInt(GL_PACK_ALIGNMENT, out.i);
+        return;
+    default:
+        break;
+    }
+
+    if (field >= CapBlend && field <= CapStencilTest) {
+        out.i[0] = m_backend.IsEnabled(CapabilityEnum(field)) ? 1 : 0;
+        m_stats.queries++;
+        return;
+    }
+
+    // Texture unit binding
+    const int unit = field - Texture2DUnit0;
+    const int activeUnit = CurrentTextureUnit();
+    if (unit == activeUnit) {
+        getInt(GL_TEXTURE_BINDING_2D, out.i);
+        return;
+    }
+    m_backend.ActiveTexture(GL_TEXTURE0 + unit);
+    getInt(GL_TEXTURE_BINDING_2D, out.i);
+    m_backend.ActiveTexture(GL_TEXTURE0 + activeUnit);
+}
+
+void GLStateTracker::Apply(int field, const Value& v) {
+    switch (field) {
+    case Program:
+        m_backend.UseProgram(v.i[0]);
+        return;
+    case VertexArray:
+        m_backend.BindVertexArray(v.i[0]);
+        return;
+    case ArrayBuffer:
+        m_backend.BindBuffer(GL_ARRAY_BUFFER, v.i[0]);
+        return;
+    case PixelPackBuffer:
+        m_backend.BindBuffer(GL_PIXEL_PACK_BUFFER, v.i[0]);
+        return;
+    case PixelUnpackBuffer:
+        m_backend.BindBuffer(GL_PIXEL_UNPACK_BUFFER, v.i[0]);
+        return;
+    case ReadFramebuffer:
+        m_backend.BindFramebuffer(GL_READ_FRAMEBUFFER, v.i[0]);
+        return;
+    case DrawFramebuffer:
+        m_backend.BindFramebuffer(GL_DRAW_FRAMEBUFFER, v.i[0]);
+        return;
+    case ActiveTextureUnit:
+        m_backend.ActiveTexture(v.i[0]);
+        return;
+    case BlendFuncs:
+        m_backend.BlendFuncSeparate(v.i[0], v.i[1], v.i[2], v.i[3]);
+        return;
+    case ViewportBox:
+        m_backend.Viewport(v.i[0], v.i[1], v.i[2], v.i[3]);
+        return;
+    case ScissorBox:
+        m_backend.Scissor(v.i[0], v.i[1], v.i[2], v.i[3]);
+        return;
+    case ClearColorValue:
+        m_backend.ClearColor(v.f[0], v.f[1], v.f[2], v.f[3]);
+        return;
+    case LineWidthValue:
+        m_backend.LineWidth(v.f[0]);
+        return;
+    case ColorMaskValue:
+        m_backend.ColorMask(v.i[0], v.i[1], v.i[2], v.i[3]);
+        return;
+    case UnpackRowLength:
+        m_backend.PixelStorei(GL_UNPACK_ROW_LENGTH, v.i[0]);
+        return;
+    case UnpackSkipPixels:
+        m_backend.PixelStorei(GL_UNPACK_SKIP_PIXELS, v.i[0]);
+        return;
+    case UnpackSkipRows:
+        m_backend.PixelStorei(GL_UNPACK_SKIP_ROWS, v.i[0]);
+        return;
+    case UnpackAlignment:
+        m_backend.PixelStorei(GL_UNPACK_ALIGNMENT, v.i[0]);
+        return;
+    case PackAlignment:
+        m_backend.PixelStorei(GL_PACK_ALIGNMENT, v.i[0]);
+        return;
+    default:
+        break;
+    }
+
+    if (field >= CapBlend && field <= CapStencilTest) {
+        m_backend.SetEnabled(CapabilityEnum(field), v.i[0] != 0);
+        return;
+    }
+
+    // Texture unit binding - the caller has made the unit active
+    m_backend.BindTexture(GL_TEXTURE_2D, v.i[0]);
+}
+
+const GLStateTracker::Value& GLStateTracker::Current(int field) {
+    const uint64_t bit = Bit(field);
+    if (!(m_captured & bit)) {
+        Query(field, m_game[field], true);
+        m_current[field] = m_game[field];
+        m_captured |= bit;
+    }
+    return m_current[field];
+}
+
+int GLStateTracker::CurrentTextureUnit() { return Current(ActiveTextureUnit).i[0] - GL_TEXTURE0; }
+
+bool GLStateTracker::Update(int field, const Value& v, bool elidable) {
+    m_stats.calls++;
+    if (elidable && Current(field) == v) return false;
+    Current(field); // Captures the game value before the first change
+    m_current[field] = v;
+    m_stats.issued++;
+    return true;
+}
+
+void GLStateTracker::BeginFrame() {
+    m_active = true;
+    m_captured = 0;
+    m_stats = {};
+}
+
+void GLStateTracker::EndFrame() {
+    if (!m_active) return;
+
+#ifdef _DEBUG
+    Validate("before restore");
+#endif
+
+    // Texture bindings first: each needs its unit active, and the active unit is restored below
+    for (int unit = 0; unit < MAX_TEXTURE_UNITS; unit++) {
+        const int field = Texture2DUnit0 + unit;
+        if (!(m_captured & Bit(field)) || m_current[field] == m_game[field]) continue;
+        Value activeUnit;
+        activeUnit.i[0] = GL_TEXTURE0 + unit;
+        if (m_current[ActiveTextureUnit] != activeUnit) {
+            m_backend.ActiveTexture(activeUnit.i[0]);
+            m_current[ActiveTextureUnit] = activeUnit;
+            m_stats.restoreCalls++;
+        }
+        Apply(field, m_game[field]);
+        m_current[field] = m_game[field];
+        m_stats.restoreCalls++;
+    }
+
+    for (int field = 0; field < Texture2DUnit0; field++) {
+        if (!(m_captured & Bit(field)) || m_current[field] == m_game[field]) continue;
+        Apply(field, m_game[field]);
+        m_current[field] = m_game[field];
+        m_stats.restoreCalls++;
+    }
+
+#ifdef _DEBUG
+    Validate("after restore");
+#endif
+
+    m_active = false;
+    m_lastStats = m_stats;
+    PROFILE_HITS("GL State Calls Issued", m_stats.issued, m_stats.calls);
+    PROFILE_HITS("GL Save/Restore Calls (vs Full)", m_stats.queries + m_stats.restoreCalls, FULL_SAVE_RESTORE_GL_CALLS);
+}
+
+int GLStateTracker::Validate(const char* when) {
+    const GLStateFrameStats statsBefore = m_stats; // Validation queries are not part of the frame's cost
+    int mismatches = 0;
+    for (int field = 0; field < FieldCount; field++) {
+        if (!(m_captured & Bit(field))) continue;
+        Value actual;
+        Query(field, actual, false);
+        if (actual == m_current[field]) continue;
+
+        mismatches++;
+        std::string msg = "GLStateTracker: " + std::string(FieldName(field));
+        if (field >= Texture2DUnit0) msg += " (unit " + std::to_string(field - Texture2DUnit0) + ")";
+        msg += " mismatch " + std::string(when) + ": tracked {";
+        for (int k = 0; k < 4; k++) { msg += std::to_string(m_current[field].i[k]) + "/" + std::to_string(m_current[field].f[k]) + " "; }
+        msg += "} actual {";
+        for (int k = 0; k < 4; k++) { msg += std::to_string(actual.i[k]) + "/" + std::to_string(actual.f[k]) + " "; }
+        msg += "}";
+        LogCategory("glstate", msg);
+    }
+    m_stats = statsBefore;
+    return mismatches;
+}
+
+GLint GLStateTracker::GameDrawFramebuffer() {
+    Current(DrawFramebuffer);
+    return m_game[DrawFramebuffer].i[0];
+}
+
+GLint GLStateTracker::GameReadFramebuffer() {
+    Current(ReadFramebuffer);
+    return m_game[ReadFramebuffer].i[0];
+}
+
+GLint GLStateTracker::GameVertexArray() {
+    Current(VertexArray);
+    return m_game[VertexArray].i[0];
+}
+
+void GLStateTracker::GameViewport(GLint out[4]) {
+    Current(ViewportBox);
+    for (int k = 0; k < 4; k++) { out[k] = m_game[ViewportBox].i[k]; }
+}
+
+void GLStateTracker::NoteGameViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    // Viewport calls made while a frame is tracked are ours, not the game's
+    if (m_active) return;
+    m_hookViewport = Value{};
+    m_hookViewport.i[0] = x;
+    m_hookViewport.i[1] = y;
+    m_hookViewport.i[2] = width;
+    m_hookViewport.i[3] = height;
+    m_hookViewportContext = m_backend.CurrentContext();
+}
+
+void GLStateTracker::UseProgram(GLuint program) {
+    if (!m_active) return m_backend.UseProgram(program);
+    Value v;
+    v.i[0] = static_cast<GLint>(program);
+    if (Update(Program, v, true)) m_backend.UseProgram(program);
+}
+
+void GLStateTracker::BindVertexArray(GLuint vao) {
+    if (!m_active) return m_backend.BindVertexArray(vao);
+    Value v;
+    v.i[0] = static_cast<GLint>(vao);
+    Update(VertexArray, v, false);
+    m_backend.BindVertexArray(vao);
+}
+
+void GLStateTracker::BindBuffer(GLenum target, GLuint buffer) {
+    const int field = BufferField(target);
+    if (!m_active || field < 0) return m_backend.BindBuffer(target, buffer);
+    Value v;
+    v.i[0] = static_cast<GLint>(buffer);
+    Update(field, v, false);
+    m_backend.BindBuffer(target, buffer);
+}
+
+void GLStateTracker::BindFramebuffer(GLenum target, GLuint framebuffer) {
+    if (!m_active) return m_backend.BindFramebuffer(target, framebuffer);
+    Value v;
+    v.i[0] = static_cast<GLint>(framebuffer);
+    if (target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER) Update(ReadFramebuffer, v, false);
+    if (target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER) Update(DrawFramebuffer, v, false);
+    if (target == GL_FRAMEBUFFER) m_stats.calls--, m_stats.issued--; // One call, two fields
+    m_backend.BindFramebuffer(target, framebuffer);
+}
+
+void GLStateTracker::ActiveTexture(GLenum unit) {
+    if (!m_active) return m_backend.ActiveTexture(unit);
+    Value v;
+    v.i[0] = static_cast<GLint>(unit);
+    if (Update(ActiveTextureUnit, v, true)) m_backend.ActiveTexture(unit);
+}
+
+void GLStateTracker::BindTexture(GLenum target, GLuint texture) {
+    if (!m_active || target != GL_TEXTURE_2D) return m_backend.BindTexture(target, texture);
+    const int unit = CurrentTextureUnit();
+    if (unit < 0 || unit >= MAX_TEXTURE_UNITS) return m_backend.BindTexture(target, texture);
+    Value v;
+    v.i[0] = static_cast<GLint>(texture);
+    Update(Texture2DUnit0 + unit, v, false);
+    m_backend.BindTexture(target, texture);
+}
+
+void GLStateTracker::SetCapability(GLenum cap, bool enabled) {
+    const int field = CapabilityField(cap);
+    if (!m_active || field < 0) return m_backend.SetEnabled(cap, enabled);
+    Value v;
+    v.i[0] = enabled ? 1 : 0;
+    if (Update(field, v, true)) Apply(field, v);
+}
+
+void GLStateTracker::BlendFuncSeparate(GLenum srcRgb, GLenum dstRgb, GLenum srcAlpha, GLenum dstAlpha) {
+    if (!m_active) return m_backend.BlendFuncSeparate(srcRgb, dstRgb, srcAlpha, dstAlpha);
+    Value v;
+    v.i[0] = static_cast<GLint>(srcRgb);
+    v.i[1] = static_cast<GLint>(dstRgb);
+    v.i[2] = static_cast<GLint>(srcAlpha);
+    v.i[3] = static_cast<GLint>(dstAlpha);
+    if (Update(BlendFuncs, v, true)) Apply(BlendFuncs, v);
+}
+
+void GLStateTracker::Viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    Value v;
+    v.i[0] = x;
+    v.i[1] = y;
+    v.i[2] = width;
+    v.i[3] = height;
+    if (!m_active || Update(ViewportBox, v, true)) Apply(ViewportBox, v);
+}
+
+void GLStateTracker::Scissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+    if (!m_active) return m_backend.Scissor(x, y, width, height);
+    Value v;
+    v.i[0] = x;
+    v.i[1] = y;
+    v.i[2] = width;
+    v.i[3] = height;
+    if (Update(ScissorBox, v, true)) Apply(ScissorBox, v);
+}
+
+void GLStateTracker::ClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a) {
+    if (!m_active) return m_backend.ClearColor(r, g, b, a);
+    Value v;
+    v.f[0] = r;
+    v.f[1] = g;
+    v.f[2] = b;
+    v.f[3] = a;
+    if (Update(ClearColorValue, v, true)) Apply(ClearColorValue, v);
+}
+
+void GLStateTracker::LineWidth(GLfloat width) {
+    if (!m_active) return m_backend.LineWidth(width);
+    Value v;
+    v.f[0] = width;
+    if (Update(LineWidthValue, v, true)) Apply(LineWidthValue, v);
+}
+
+void GLStateTracker::ColorMask(GLboolean r, GLboolean g, GLboolean b, GLboolean a) {
+    if (!m_active) return m_backend.ColorMask(r, g, b, a);
+    Value v;
+    v.i[0] = r ? 1 : 0;
+    v.i[1] = g ? 1 : 0;
+    v.i[2] = b ? 1 : 0;
+    v.i[3] = a ? 1 : 0;
+    if (Update(ColorMaskValue, v, true)) Apply(ColorMaskValue, v);
+}
+
+void GLStateTracker::PixelStorei(GLenum pname, GLint value) {
+    const int field = PixelStoreField(pname);
+    if (!m_active || field < 0) return m_backend.PixelStorei(pname, value);
+    Value v;
+    v.i[0] = value;
+    if (Update(field, v, true)) Apply(field, v);
+}
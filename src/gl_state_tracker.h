@@ -0,0 +1,201 @@
+#pragma once
+
+// ============================================================================
+// GL_STATE_TRACKER.H - Shadowed GL state for rendering on the game's context
+// ============================================================================
+// The SwapBuffers hook draws on the game's own context, so everything it changes has to be put back
+// before the game continues. Instead of querying the full state up front and restoring all of it, the
+// state-changing calls made from the hook go through the GLTracked:: wrappers below:
+//
+//   - The first time a frame changes a piece of state, its game value is captured (one glGet). The
+//     viewport needs no query at all: the glViewport hook reports every viewport the game sets.
+//   - EndFrame restores only the state whose current value differs from the captured game value.
+//   - Everything set or captured during the frame has a known current value, so redundant enable,
+//     disable, blend, program, pixel-store and viewport calls are dropped. Object bindings are always
+//     issued: deleting a bound object resets the binding behind the shadow's back, and a recreated
+//     object can come back under the same name.
+//
+// Tracking is per thread and only active between BeginFrame and EndFrame. Outside that window, and on
+// other threads, the wrappers call GL directly, so shared code can use them unconditionally.
+//
+// Debug builds compare the shadow against real glGet results before and after the restore and log any
+// mismatch; the per-frame call counts are reported to the profiler. The tracker reaches GL only through
+// GLStateBackend, so a fake backend can drive it without a context.
+// ============================================================================
+
+#ifndef GLEW_STATIC
+#define GLEW_STATIC
+#endif
+#include <GL/glew.h>
+#include <cstdint>
+
+struct GLStateFrameStats {
+    uint32_t calls = 0;        // Wrapper calls made during the frame
+    uint32_t issued = 0;       // Of those, calls that reached GL
+    uint32_t queries = 0;      // glGet calls made to capture game state
+    uint32_t restoreCalls = 0; // GL calls EndFrame made to put game state back
+};
+
+// The GL calls the tracker makes, on the calling thread's current context
+class GLStateBackend {
+  public:
+    virtual ~GLStateBackend() = default;
+
+    virtual void GetIntegerv(GLenum pname, GLint* out) = 0;
+    virtual void GetFloatv(GLenum pname, GLfloat* out) = 0;
+    virtual void GetBooleanv(GLenum pname, GLboolean* out) = 0;
+    virtual bool IsEnabled(GLenum cap) = 0;
+    virtual void SetEnabled(GLenum cap, bool enabled) = 0;
+    virtual void UseProgram(GLuint program) = 0;
+    virtual void BindVertexArray(GLuint vao) = 0;
+    virtual void BindBuffer(GLenum target, GLuint buffer) = 0;
+    virtual void BindFramebuffer(GLenum target, GLuint framebuffer) = 0;
+    virtual void ActiveTexture(GLenum unit) = 0;
+    virtual void BindTexture(GLenum target, GLuint texture) = 0;
+    virtual void BlendFuncSeparate(GLenum srcRgb, GLenum dstRgb, GLenum srcAlpha, GLenum dstAlpha) = 0;
+    virtual void Viewport(GLint x, GLint y, GLsizei width, GLsizei height) = 0; // Must bypass the glViewport hook
+    virtual void Scissor(GLint x, GLint y, GLsizei width, GLsizei height) = 0;
+    virtual void ClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a) = 0;
+    virtual void LineWidth(GLfloat width) = 0;
+    virtual void ColorMask(GLboolean r, GLboolean g, GLboolean b, GLboolean a) = 0;
+    virtual void PixelStorei(GLenum pname, GLint value) = 0;
+    // Identifies the context, so a viewport noted on one context is never used on another
+    virtual void* CurrentContext() = 0;
+};
+
+class GLStateTracker {
+  public:
+    static constexpr int MAX_TEXTURE_UNITS = 16;
+
+    // `backend` must outlive the tracker
+    explicit GLStateTracker(GLStateBackend& backend) : m_backend(backend) {}
+
+    // The tracker for the calling thread, backed by GL calls
+    static GLStateTracker& ForCurrentThread();
+
+    void BeginFrame();
+    void EndFrame();
+    bool IsActive() const { return m_active; }
+    const GLStateFrameStats& LastFrameStats() const { return m_lastStats; }
+
+    // The game's value of a piece of state, whether or not the frame has changed it since
+    GLint GameDrawFramebuffer();
+    GLint GameReadFramebuffer();
+    GLint GameVertexArray();
+    void GameViewport(GLint out[4]);
+
+    // Called by the glViewport hook with the viewport the game actually set
+    void NoteGameViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    void UseProgram(GLuint program);
+    void BindVertexArray(GLuint vao);
+    void BindBuffer(GLenum target, GLuint buffer);
+    void BindFramebuffer(GLenum target, GLuint framebuffer);
+    void ActiveTexture(GLenum unit);
+    void BindTexture(GLenum target, GLuint texture);
+    void SetCapability(GLenum cap, bool enabled);
+    void BlendFunc(GLenum src, GLenum dst) { BlendFuncSeparate(src, dst, src, dst); }
+    void BlendFuncSeparate(GLenum srcRgb, GLenum dstRgb, GLenum srcAlpha, GLenum dstAlpha);
+    void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+    void Scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+    void ClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a);
+    void LineWidth(GLfloat width);
+    void ColorMask(GLboolean r, GLboolean g, GLboolean b, GLboolean a);
+    void PixelStorei(GLenum pname, GLint value);
+
+    // Compares every piece of state captured this frame with GL and logs the ones whose shadow value is
+    // wrong; returns how many. Debug builds run it before and after EndFrame's restore
+    int Validate(const char* when);
+
+  private:
+    enum Field : int {
+        Program,
+        VertexArray,
+        ArrayBuffer,
+        PixelPackBuffer,
+        PixelUnpackBuffer,
+        ReadFramebuffer,
+        DrawFramebuffer,
+        ActiveTextureUnit,
+        CapBlend,
+        CapDepthTest,
+        CapScissorTest,
+        CapFramebufferSrgb,
+        CapCullFace,
+        CapStencilTest,
+        BlendFuncs,
+        ViewportBox,
+        ScissorBox,
+        ClearColorValue,
+        LineWidthValue,
+        ColorMaskValue,
+        UnpackRowLength,
+        UnpackSkipPixels,
+        UnpackSkipRows,
+        UnpackAlignment,
+        PackAlignment,
+        Texture2DUnit0, // One field per unit up to MAX_TEXTURE_UNITS
+        FieldCount = Texture2DUnit0 + MAX_TEXTURE_UNITS
+    };
+    static_assert(FieldCount <= 64, "Field masks are 64-bit");
+
+    // Integer and float views of one field; unused components stay zero so values compare exactly
+    struct Value {
+        GLint i[4] = {};
+        GLfloat f[4] = {};
+        bool operator==(const Value& o) const;
+        bool operator!=(const Value& o) const { return !(*this == o); }
+    };
+
+    static uint64_t Bit(int field) { return 1ull << field; }
+    static int CapabilityField(GLenum cap);
+    static GLenum CapabilityEnum(int field);
+    static int PixelStoreField(GLenum pname);
+    static int BufferField(GLenum target);
+    static const char* FieldName(int field);
+
+    // Reads a field from GL (the viewport from the hook when allowed). Texture units other than the
+    // active one are read by switching units
+    void Query(int field, Value& out, bool allowHook);
+    void Apply(int field, const Value& v);
+    // Captures the game value on first use and updates the shadow; false when the call is redundant
+    bool Update(int field, const Value& v, bool elidable);
+    const Value& Current(int field);
+    int CurrentTextureUnit();
+
+    GLStateBackend& m_backend;
+    bool m_active = false;
+    uint64_t m_captured = 0; // Fields whose game value is in m_game (current value is in m_current)
+    Value m_game[FieldCount];
+    Value m_current[FieldCount];
+
+    // Last viewport reported by the glViewport hook; stays valid across frames
+    void* m_hookViewportContext = nullptr; // HGLRC the viewport was set on
+    Value m_hookViewport;
+
+    GLStateFrameStats m_stats;
+    GLStateFrameStats m_lastStats;
+};
+
+// Drop-in replacements for the GL calls of the same name
+namespace GLTracked {
+inline void UseProgram(GLuint program) { GLStateTracker::ForCurrentThread().UseProgram(program); }
+inline void BindVertexArray(GLuint vao) { GLStateTracker::ForCurrentThread().BindVertexArray(vao); }
+inline void BindBuffer(GLenum target, GLuint buffer) { GLStateTracker::ForCurrentThread().BindBuffer(target, buffer); }
+inline void BindFramebuffer(GLenum target, GLuint fb) { GLStateTracker::ForCurrentThread().BindFramebuffer(target, fb); }
+inline void ActiveTexture(GLenum unit) { GLStateTracker::ForCurrentThread().ActiveTexture(unit); }
+inline void BindTexture(GLenum target, GLuint texture) { GLStateTracker::ForCurrentThread().BindTexture(target, texture); }
+inline void Enable(GLenum cap) { GLStateTracker::ForCurrentThread().SetCapability(cap, true); }
+inline void Disable(GLenum cap) { GLStateTracker::ForCurrentThread().SetCapability(cap, false); }
+inline void BlendFunc(GLenum src, GLenum dst) { GLStateTracker::ForCurrentThread().BlendFunc(src, dst); }
+inline void BlendFuncSeparate(GLenum srcRgb, GLenum dstRgb, GLenum srcAlpha, GLenum dstAlpha) {
+    GLStateTracker::ForCurrentThread().BlendFuncSeparate(srcRgb, dstRgb, srcAlpha, dstAlpha);
+}
+// Bypasses the glViewport hook like a direct oglViewport call
+inline void Viewport(GLint x, GLint y, GLsizei width, GLsizei height) { GLStateTracker::ForCurrentThread().Viewport(x, y, width, height); }
+inline void Scissor(GLint x, GLint y, GLsizei width, GLsizei height) { GLStateTracker::ForCurrentThread().Scissor(x, y, width, height); }
+inline void ClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a) { GLStateTracker::ForCurrentThread().ClearColor(r, g, b, a); }
+inline void LineWidth(GLfloat width) { GLStateTracker::ForCurrentThread().LineWidth(width); }
+inline void ColorMask(GLboolean r, GLboolean g, GLboolean b, GLboolean a) { GLStateTracker::ForCurrentThread().ColorMask(r, g, b, a); }
+inline void PixelStorei(GLenum pname, GLint value) { GLStateTracker::ForCurrentThread().PixelStorei(pname, value); }
+} // namespace GLTracked
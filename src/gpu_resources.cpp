@@ -0,0 +1,221 @@
+// ============================================================================
+// GPU_RESOURCES.CPP - Generational handles and deferred destruction for GL objects
+// ============================================================================
+
+#include "gpu_resources.h"
+
+#ifndef GLEW_STATIC
+#define GLEW_STATIC
+#endif
+#include <GL/glew.h>
+
+namespace {
+
+class GLResourceBackend final : public GpuResourceBackend {
+  public:
+    void DeleteObjects(GpuResourceKind kind, const uint32_t* names, int count) override {
+        switch (kind) {
+        case GpuResourceKind::Texture:
+            glDeleteTextures(count, names);
+            break;
+        case GpuResourceKind::Buffer:
+            glDeleteBuffers(count, names);
+            break;
+        case GpuResourceKind::Framebuffer:
+            glDeleteFramebuffers(count, names);
+            break;
+        case GpuResourceKind::Renderbuffer:
+            glDeleteRenderbuffers(count, names);
+            break;
+        default:
+            break;
+        }
+    }
+    uint64_t InsertFence() override {
+        return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)));
+    }
+    bool IsFenceSignaled(uint64_t fence) override {
+        if (fence == 0) return true; // Fence creation failed; nothing to wait for
+        GLenum result = glClientWaitSync(ToSync(fence), 0, 0);
+        return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED;
+    }
+    void DeleteFence(uint64_t fence) override {
+        if (fence != 0) glDeleteSync(ToSync(fence));
+    }
+
+  private:
+    static GLsync ToSync(uint64_t fence) { return reinterpret_cast<GLsync>(static_cast<uintptr_t>(fence)); }
+};
+
+} // namespace
+
+const char* GpuSubsystemName(GpuSubsystem subsystem) {
+    switch (subsystem) {
+    case GpuSubsystem::Mirrors:
+        return "Mirrors";
+    case GpuSubsystem::Images:
+        return "Images";
+    case GpuSubsystem::Backgrounds:
+        return "Backgrounds";
+    case GpuSubsystem::WindowOverlays:
+        return "Window Overlays";
+    case GpuSubsystem::Cursors:
+        return "Cursors";
+    default:
+        return "Other";
+    }
+}
+
+uint64_t GpuTextureBytes(int width, int height, int bytesPerPixel, bool mipmapped) {
+    if (width <= 0 || height <= 0 || bytesPerPixel <= 0) return 0;
+    const uint64_t base = static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * static_cast<uint64_t>(bytesPerPixel);
+    // A full mip chain adds a third
+    return mipmapped ? base + base / 3 : base;
+}
+
+GpuResourceManager::GpuResourceManager(GpuResourceBackend& backend) : m_backend(backend) {}
+
+GpuResourceManager& GpuResourceManager::Get() {
+    static GLResourceBackend s_backend;
+    static GpuResourceManager s_manager(s_backend);
+    return s_manager;
+}
+
+GpuResourceHandle GpuResourceManager::Register(GpuResourceKind kind, uint32_t name, GpuSubsystem subsystem, uint64_t bytes) {
+    if (name == 0) return GpuResourceHandle{};
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    uint32_t index;
+    if (!m_freeSlots.empty()) {
+        index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        index = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+
+    Slot& s = m_slots[index];
+    if (++s.generation == 0) s.generation = 1; // 0 marks an invalid handle
+    s.name = name;
+    s.kind = kind;
+    s.subsystem = subsystem;
+    s.live = true;
+    s.bytes = bytes;
+
+    m_bytes[static_cast<int>(subsystem)] += bytes;
+    m_objects[static_cast<int>(subsystem)]++;
+    return GpuResourceHandle{ index, s.generation };
+}
+
+uint32_t GpuResourceManager::Resolve(GpuResourceHandle handle) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return IsLive(handle) ? m_slots[handle.index].name : 0;
+}
+
+void GpuResourceManager::SetBytes(GpuResourceHandle handle, uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!IsLive(handle)) return;
+    Slot& s = m_slots[handle.index];
+    uint64_t& total = m_bytes[static_cast<int>(s.subsystem)];
+    total = total - s.bytes + bytes;
+    s.bytes = bytes;
+}
+
+void GpuResourceManager::Release(GpuResourceHandle& handle, GpuContextQueue queue) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (IsLive(handle)) {
+            m_queues[static_cast<int>(queue)].unfenced.push_back(EndSlot(handle.index));
+            m_pendingCount[static_cast<int>(queue)].fetch_add(1, std::memory_order_release);
+        }
+    }
+    handle = GpuResourceHandle{};
+}
+
+void GpuResourceManager::ReleaseNow(GpuResourceHandle& handle) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (IsLive(handle)) {
+            const PendingObject object = EndSlot(handle.index);
+            m_backend.DeleteObjects(object.kind, &object.name, 1);
+        }
+    }
+    handle = GpuResourceHandle{};
+}
+
+void GpuResourceManager::Retire(GpuContextQueue queue) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Queue& q = m_queues[static_cast<int>(queue)];
+
+    if (!q.unfenced.empty()) {
+        Batch batch;
+        batch.fence = m_backend.InsertFence();
+        batch.objects.swap(q.unfenced);
+        q.batches.push_back(std::move(batch));
+    }
+
+    // Fences on one context signal in order, so stop at the first one that has not
+    while (!q.batches.empty() && m_backend.IsFenceSignaled(q.batches.front().fence)) {
+        Batch& batch = q.batches.front();
+        m_backend.DeleteFence(batch.fence);
+        m_pendingCount[static_cast<int>(queue)].fetch_sub(static_cast<uint32_t>(batch.objects.size()), std::memory_order_release);
+        DeleteObjects(batch.objects);
+        q.batches.pop_front();
+    }
+}
+
+void GpuResourceManager::Flush(GpuContextQueue queue) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Queue& q = m_queues[static_cast<int>(queue)];
+    for (Batch& batch : q.batches) {
+        m_backend.DeleteFence(batch.fence);
+        DeleteObjects(batch.objects);
+    }
+    q.batches.clear();
+    DeleteObjects(q.unfenced);
+    q.unfenced.clear();
+    m_pendingCount[static_cast<int>(queue)].store(0, std::memory_order_release);
+}
+
+GpuMemoryStats GpuResourceManager::Stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    GpuMemoryStats stats;
+    for (int i = 0; i < static_cast<int>(GpuSubsystem::Count); i++) {
+        stats.bytes[i] = m_bytes[i];
+        stats.objects[i] = m_objects[i];
+        stats.totalBytes += m_bytes[i];
+    }
+    for (int i = 0; i < static_cast<int>(GpuContextQueue::Count); i++) { stats.pendingDeletes += m_pendingCount[i].load(std::memory_order_relaxed); }
+    return stats;
+}
+
+bool GpuResourceManager::IsLive(GpuResourceHandle handle) const {
+    if (!handle.IsValid() || handle.index >= m_slots.size()) return false;
+    const Slot& s = m_slots[handle.index];
+    return s.live && s.generation == handle.generation;
+}
+
+GpuResourceManager::PendingObject GpuResourceManager::EndSlot(uint32_t index) {
+    Slot& s = m_slots[index];
+    m_bytes[static_cast<int>(s.subsystem)] -= s.bytes;
+    m_objects[static_cast<int>(s.subsystem)]--;
+    s.live = false;
+    s.bytes = 0;
+    // Bumping the generation here (not only on reuse) makes every copy of the handle stale at once
+    if (++s.generation == 0) s.generation = 1;
+    m_freeSlots.push_back(index);
+    return PendingObject{ s.kind, s.name };
+}
+
+void GpuResourceManager::DeleteObjects(std::vector<PendingObject>& objects) {
+    // One call per kind
+    std::vector<uint32_t> names;
+    for (int k = 0; k < static_cast<int>(GpuResourceKind::Count); k++) {
+        names.clear();
+        for (const PendingObject& o : objects) {
+            if (static_cast<int>(o.kind) == k) names.push_back(o.name);
+        }
+        if (!names.empty()) m_backend.DeleteObjects(static_cast<GpuResourceKind>(k), names.data(), static_cast<int>(names.size()));
+    }
+    objects.clear();
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+// ============================================================================
+// GPU_RESOURCES.H - Generational handles and deferred destruction for GL objects
+// ============================================================================
+// GL objects are created on several contexts (game, render thread, mirror thread) that share one object
+// namespace, and the object names get reused as soon as they are deleted. Code that keeps a bare GLuint
+// around can end up using somebody else's texture. GpuResourceManager hands out a handle per object
+// instead: an index plus a generation that changes when the object is released, so a stale handle
+// resolves to 0 rather than to a recycled name.
+//
+// Releasing does not delete right away. The object goes into the deferred queue of the context that will
+// delete it; once per frame that context calls Retire(), which covers everything released since the last
+// call with one fence and deletes the batches whose fence has signaled. Objects released from a thread
+// without a context (config reloads, the GUI) are therefore still deleted on a context, after the work
+// queued before the release has finished. ReleaseNow() is for shutdown paths that delete on the current
+// context directly.
+//
+// Every registered object carries its size and the subsystem that owns it; the totals are shown in the
+// performance overlay. The manager reaches GL only through GpuResourceBackend, so the handle and retirement
+// logic runs against a fake backend without a GPU.
+// ============================================================================
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+enum class GpuResourceKind : uint8_t { Texture, Buffer, Framebuffer, Renderbuffer, Count };
+
+enum class GpuSubsystem : uint8_t { Mirrors, Images, Backgrounds, WindowOverlays, Cursors, Count };
+
+// The context whose thread deletes a released object
+enum class GpuContextQueue : uint8_t {
+    Game,         // SwapBuffers hook; always present, so the default for shared objects
+    RenderThread, // Render thread's shared context
+    Count
+};
+
+const char* GpuSubsystemName(GpuSubsystem subsystem);
+
+struct GpuResourceHandle {
+    uint32_t index = 0;
+    uint32_t generation = 0; // 0 = no object
+
+    bool IsValid() const { return generation != 0; }
+    bool operator==(const GpuResourceHandle& o) const { return index == o.index && generation == o.generation; }
+    bool operator!=(const GpuResourceHandle& o) const { return !(*this == o); }
+};
+
+class GpuResourceBackend {
+  public:
+    virtual ~GpuResourceBackend() = default;
+
+    virtual void DeleteObjects(GpuResourceKind kind, const uint32_t* names, int count) = 0;
+    virtual uint64_t InsertFence() = 0;
+    virtual bool IsFenceSignaled(uint64_t fence) = 0; // Must not block
+    virtual void DeleteFence(uint64_t fence) = 0;
+};
+
+struct GpuMemoryStats {
+    uint64_t bytes[static_cast<int>(GpuSubsystem::Count)] = {};
+    uint32_t objects[static_cast<int>(GpuSubsystem::Count)] = {};
+    uint64_t totalBytes = 0;
+    uint32_t pendingDeletes = 0; // Released, not yet deleted (all queues)
+};
+
+// Size of a 2D texture's storage, including the mip chain when it has one
+uint64_t GpuTextureBytes(int width, int height, int bytesPerPixel = 4, bool mipmapped = false);
+
+class GpuResourceManager {
+  public:
+    explicit GpuResourceManager(GpuResourceBackend& backend);
+
+    // Process-wide manager backed by GL calls on the calling thread's current context
+    static GpuResourceManager& Get();
+
+    // Takes ownership of a GL object; name 0 yields an invalid handle
+    GpuResourceHandle Register(GpuResourceKind kind, uint32_t name, GpuSubsystem subsystem, uint64_t bytes);
+    // The object's GL name, or 0 for released or invalid handles
+    uint32_t Resolve(GpuResourceHandle handle) const;
+    void SetBytes(GpuResourceHandle handle, uint64_t bytes); // After reallocating the object's storage
+
+    // Ends the handle now and queues the object for deletion on `queue`'s context. Ignores stale handles;
+    // always resets `handle`
+    void Release(GpuResourceHandle& handle, GpuContextQueue queue = GpuContextQueue::Game);
+    // Ends the handle and deletes the object on the current context immediately
+    void ReleaseNow(GpuResourceHandle& handle);
+
+    // Context thread, once per frame: fence what was released since the last call, delete what earlier
+    // fences cover
+    void Retire(GpuContextQueue queue);
+    // Deletes everything queued for `queue` without waiting; for a context that is about to go away
+    void Flush(GpuContextQueue queue);
+    // Cheap check before taking the lock
+    bool HasPending(GpuContextQueue queue) const { return m_pendingCount[static_cast<int>(queue)].load(std::memory_order_acquire) > 0; }
+
+    GpuMemoryStats Stats() const;
+
+  private:
+    struct Slot {
+        uint32_t generation = 0;
+        uint32_t name = 0;
+        GpuResourceKind kind = GpuResourceKind::Texture;
+        GpuSubsystem subsystem = GpuSubsystem::Images;
+        bool live = false;
+        uint64_t bytes = 0;
+    };
+    struct PendingObject {
+        GpuResourceKind kind;
+        uint32_t name;
+    };
+    struct Batch {
+        uint64_t fence;
+        std::vector<PendingObject> objects;
+    };
+    struct Queue {
+        std::vector<PendingObject> unfenced; // Released since the last Retire
+        std::deque<Batch> batches;           // Fenced, oldest first
+    };
+
+    bool IsLive(GpuResourceHandle handle) const; // Under m_mutex; false for stale handles
+    // Under m_mutex: ends the slot and returns the object it held
+    PendingObject EndSlot(uint32_t index);
+    void DeleteObjects(std::vector<PendingObject>& objects); // Under m_mutex
+
+    GpuResourceBackend& m_backend;
+    mutable std::mutex m_mutex;
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+    Queue m_queues[static_cast<int>(GpuContextQueue::Count)];
+    std::atomic<uint32_t> m_pendingCount[static_cast<int>(GpuContextQueue::Count)] = {};
+    uint64_t m_bytes[static_cast<int>(GpuSubsystem::Count)] = {};
+    uint32_t m_objects[static_cast<int>(GpuSubsystem::Count)] = {};
+};
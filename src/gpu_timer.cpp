@@ -0,0 +1,115 @@
+// ============================================================================
+// GPU_TIMER.CPP - GL_TIMESTAMP scope timing for the profiler
+// ============================================================================
+
+#include "gpu_timer.h"
+
+#ifndef GLEW_STATIC
+#define GLEW_STATIC
+#endif
+#include <GL/glew.h>
+#include <memory>
+#include <windows.h>
+
+namespace {
+
+class GLTimestampQueryBackend final : public GpuQueryBackend {
+  public:
+    static bool IsSupported() { return GLEW_VERSION_3_3 || GLEW_ARB_timer_query; }
+
+    void CreateQueries(uint32_t* names, int count) override { glGenQueries(count, names); }
+    void IssueTimestamp(uint32_t query) override { glQueryCounter(query, GL_TIMESTAMP); }
+    bool IsResultAvailable(uint32_t query) override {
+        GLint available = 0;
+        glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+        return available != 0;
+    }
+    uint64_t ResultNs(uint32_t query) override {
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &ns);
+        return ns;
+    }
+};
+
+} // namespace
+
+GpuTimerRing::GpuTimerRing(GpuQueryBackend& backend, int capacity) : m_backend(backend), m_slots(capacity > 0 ? capacity : 1) {
+    std::vector<uint32_t> names(m_slots.size() * 2);
+    m_backend.CreateQueries(names.data(), static_cast<int>(names.size()));
+    for (size_t i = 0; i < m_slots.size(); i++) {
+        m_slots[i].beginQuery = names[i * 2];
+        m_slots[i].endQuery = names[i * 2 + 1];
+    }
+}
+
+GpuTimerRing* GpuTimerRing::ForCurrentContext() {
+    struct ContextRing {
+        HGLRC context = nullptr;
+        GLTimestampQueryBackend backend;
+        std::unique_ptr<GpuTimerRing> ring;
+    };
+    thread_local ContextRing tls;
+
+    HGLRC context = wglGetCurrentContext();
+    if (!context) return nullptr;
+    if (context != tls.context) {
+        // A different context cannot use the old one's queries; they stay with it
+        tls.context = context;
+        tls.ring.reset();
+        if (GLTimestampQueryBackend::IsSupported()) { tls.ring = std::make_unique<GpuTimerRing>(tls.backend); }
+    }
+    return tls.ring.get();
+}
+
+int GpuTimerRing::BeginScope(const char* name) {
+    const int capacity = static_cast<int>(m_slots.size());
+    if (m_count == capacity) {
+        m_dropped++;
+        return -1;
+    }
+
+    const int slot = (m_head + m_count) % capacity;
+    m_count++;
+
+    Slot& s = m_slots[slot];
+    s.name = name;
+    s.parentName = m_open.empty() ? nullptr : m_slots[m_open.back()].name;
+    s.depth = static_cast<uint8_t>(m_open.size());
+    s.ended = false;
+    m_open.push_back(slot);
+
+    m_backend.IssueTimestamp(s.beginQuery);
+    return slot;
+}
+
+void GpuTimerRing::EndScope(int slot) {
+    if (slot < 0) return;
+    m_backend.IssueTimestamp(m_slots[slot].endQuery);
+    m_slots[slot].ended = true;
+    // Scopes end innermost-first, but tolerate any order
+    for (size_t i = m_open.size(); i-- > 0;) {
+        if (m_open[i] == slot) {
+            m_open.erase(m_open.begin() + i);
+            break;
+        }
+    }
+}
+
+int GpuTimerRing::Collect(std::vector<GpuScopeTiming>& out) {
+    int collected = 0;
+    while (m_count > 0) {
+        const Slot& s = m_slots[m_head];
+        // Still open (an enclosing scope), or the GPU has not reached it: everything after it is later still
+        if (!s.ended || !m_backend.IsResultAvailable(s.endQuery) || !m_backend.IsResultAvailable(s.beginQuery)) break;
+
+        const uint64_t begin = m_backend.ResultNs(s.beginQuery);
+        const uint64_t end = m_backend.ResultNs(s.endQuery);
+        const double durationMs = end > begin ? static_cast<double>(end - begin) / 1.0e6 : 0.0;
+        out.push_back({ s.name, s.parentName, s.depth, durationMs });
+        collected++;
+
+        m_head = (m_head + 1) % static_cast<int>(m_slots.size());
+        m_count--;
+    }
+    return collected;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+// ============================================================================
+// GPU_TIMER.H - GL_TIMESTAMP scope timing for the profiler
+// ============================================================================
+// PROFILE_SCOPE measures CPU time, which says little about GL work: a blit or a draw returns as soon as
+// it is queued. PROFILE_GPU_SCOPE (profiler.h) brackets a scope with two GL_TIMESTAMP queries on the
+// current context instead. Results are read a few frames later, once the driver reports them available,
+// so timing never waits on the GPU; resolved scopes go through the same aggregation as CPU scopes and are
+// shown in the profiler's GPU section.
+//
+// GpuTimerRing is the bookkeeping for one context: a fixed ring of query pairs, reused oldest-first. It
+// reaches GL only through GpuQueryBackend, so a fake backend can drive it without a GPU. When every pair
+// is still in flight, new scopes are dropped (and counted) rather than waited for.
+// ============================================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class GpuQueryBackend {
+  public:
+    virtual ~GpuQueryBackend() = default;
+
+    virtual void CreateQueries(uint32_t* names, int count) = 0;
+    // Records the GPU time at which all previously issued commands have completed
+    virtual void IssueTimestamp(uint32_t query) = 0;
+    // Must not block
+    virtual bool IsResultAvailable(uint32_t query) = 0;
+    // Nanoseconds; only called once the result is available
+    virtual uint64_t ResultNs(uint32_t query) = 0;
+};
+
+struct GpuScopeTiming {
+    const char* name;       // Static string from PROFILE_GPU_SCOPE
+    const char* parentName; // Enclosing GPU scope on the same context, or nullptr
+    uint8_t depth;
+    double durationMs;
+};
+
+class GpuTimerRing {
+  public:
+    static constexpr int DEFAULT_CAPACITY = 64; // Scopes in flight per context
+
+    // Creates the ring's queries through `backend`, which must outlive the ring
+    explicit GpuTimerRing(GpuQueryBackend& backend, int capacity = DEFAULT_CAPACITY);
+
+    // Ring for the calling thread's current GL context, or nullptr without a context or timer query support.
+    // Query objects are never shared between contexts and are freed with theirs, so rings never delete them.
+    static GpuTimerRing* ForCurrentContext();
+
+    // Starts a scope and returns its slot, or -1 when every slot is still in flight
+    int BeginScope(const char* name);
+    void EndScope(int slot); // Ignores -1
+    // Appends finished scopes to `out`, oldest first, stopping at the first one the GPU has not reached yet
+    int Collect(std::vector<GpuScopeTiming>& out);
+
+    int OpenScopes() const { return static_cast<int>(m_open.size()); }
+    int InFlight() const { return m_count; } // Begun and not yet collected
+    uint64_t DroppedScopes() const { return m_dropped; }
+
+  private:
+    struct Slot {
+        uint32_t beginQuery = 0, endQuery = 0;
+        const char* name = nullptr;
+        const char* parentName = nullptr;
+        uint8_t depth = 0;
+        bool ended = false;
+    };
+
+    GpuQueryBackend& m_backend;
+    std::vector<Slot> m_slots;
+    int m_head = 0;  // Oldest scope in flight
+    int m_count = 0; // Scopes in flight
+    std::vector<int> m_open; // Slots of scopes begun but not ended, innermost last
+    uint64_t m_dropped = 0;
+};
@@ -0,0 +1,218 @@
+// ============================================================================
+// GRADIENT_RAMP.CPP - Baked color ramps for gradient backgrounds
+// ============================================================================
+// GradientRampCoordinate follows main() of rt_gradient_frag_shader (render_thread.cpp) and
+// gradient_frag_shader (render.cpp) line by line. Keep them in sync when a shader changes.
+// ============================================================================
+
+#include "gradient_ramp.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+GradientColor Mix(const GradientColor& x, const GradientColor& y, float t) {
+    return { x.r + (y.r - x.r) * t, x.g + (y.g - x.g) * t, x.b + (y.b - x.b) * t, x.a + (y.a - x.a) * t };
+}
+
+float Fract(float v) { return v - std::floor(v); }
+float Clamp01(float v) { return (std::min)((std::max)(v, 0.0f), 1.0f); }
+
+GradientColor StopColor(const GradientStopSpan& s, int i) { return { s.stops[i].r, s.stops[i].g, s.stops[i].b, s.stops[i].a }; }
+float StopPos(const GradientStopSpan& s, int i) { return s.stops[i].position; }
+
+// The old getGradientColor: colorFade shifts every position over time before clamping
+GradientColor GradientStopsColor(const GradientStopSpan& s, float t, float timeOffset, bool colorFade) {
+    float adjustedT = t;
+    if (colorFade) { adjustedT = Fract(t + timeOffset * 0.1f); }
+    return GradientStopsClamped(s, adjustedT);
+}
+
+// The old getFadeColor: one solid color cycling through the stops
+GradientColor GradientStopsFade(const GradientStopSpan& s, float timeOffset) {
+    const float cyclePos = Fract(timeOffset * 0.1f);
+
+    GradientColor color = StopColor(s, 0);
+    for (int i = 0; i < s.count - 1; i++) {
+        if (cyclePos >= StopPos(s, i) && cyclePos <= StopPos(s, i + 1)) {
+            const float segmentT = (cyclePos - StopPos(s, i)) / (std::max)(StopPos(s, i + 1) - StopPos(s, i), 0.0001f);
+            color = Mix(StopColor(s, i), StopColor(s, i + 1), segmentT);
+            break;
+        }
+    }
+    const int last = s.count - 1;
+    const float wrapRange = 1.0f - StopPos(s, last) + StopPos(s, 0);
+    if (cyclePos > StopPos(s, last)) {
+        color = Mix(StopColor(s, last), StopColor(s, 0), (cyclePos - StopPos(s, last)) / (std::max)(wrapRange, 0.0001f));
+    } else if (cyclePos < StopPos(s, 0)) {
+        color = Mix(StopColor(s, 0), StopColor(s, last), (StopPos(s, 0) - cyclePos) / (std::max)(wrapRange, 0.0001f));
+    }
+    return color;
+}
+
+const float* RampTexel(const GradientRamp& ramp, GradientRampLayer layer, int i) {
+    return &ramp.texels[(static_cast<size_t>(layer) * GRADIENT_RAMP_TEXELS + i) * 4];
+}
+
+} // namespace
+
+GradientColor GradientStopsClamped(const GradientStopSpan& s, float t) {
+    const float adjustedT = Clamp01(t);
+
+    GradientColor color = StopColor(s, 0);
+    for (int i = 0; i < s.count - 1; i++) {
+        if (adjustedT >= StopPos(s, i) && adjustedT <= StopPos(s, i + 1)) {
+            const float segmentT = (adjustedT - StopPos(s, i)) / (std::max)(StopPos(s, i + 1) - StopPos(s, i), 0.0001f);
+            color = Mix(StopColor(s, i), StopColor(s, i + 1), segmentT);
+            break;
+        }
+    }
+    if (adjustedT >= StopPos(s, s.count - 1)) { color = StopColor(s, s.count - 1); }
+    return color;
+}
+
+GradientColor GradientStopsWrapped(const GradientStopSpan& s, float t) {
+    t = Fract(t);
+    const int last = s.count - 1;
+    const float lastPos = StopPos(s, last);
+    const float firstPos = StopPos(s, 0);
+    const float wrapSize = (1.0f - lastPos) + firstPos;
+
+    if (t <= firstPos && wrapSize > 0.001f) {
+        return Mix(StopColor(s, 0), StopColor(s, last), (firstPos - t) / wrapSize);
+    } else if (t >= lastPos && wrapSize > 0.001f) {
+        return Mix(StopColor(s, last), StopColor(s, 0), (t - lastPos) / wrapSize);
+    }
+
+    GradientColor color = StopColor(s, 0);
+    for (int i = 0; i < last; i++) {
+        if (t >= StopPos(s, i) && t <= StopPos(s, i + 1)) {
+            const float segmentT = (t - StopPos(s, i)) / (std::max)(StopPos(s, i + 1) - StopPos(s, i), 0.0001f);
+            color = Mix(StopColor(s, i), StopColor(s, i + 1), segmentT);
+            break;
+        }
+    }
+    return color;
+}
+
+GradientColor GradientStopsShade(const GradientStopSpan& s, const RenderCommand::Gradient& g, float u, float v) {
+    const float ux = u - 0.5f, uy = v - 0.5f;
+    const float timeOffset = g.time * g.animationSpeed;
+
+    switch (g.animationType) {
+    case 0: { // None
+        const float t = Clamp01(ux * std::cos(g.angle) + uy * std::sin(g.angle) + 0.5f);
+        return GradientStopsColor(s, t, timeOffset, g.colorFade);
+    }
+    case 1: { // Rotate
+        const float angle = g.angle + timeOffset;
+        const float t = Clamp01(ux * std::cos(angle) + uy * std::sin(angle) + 0.5f);
+        return GradientStopsColor(s, t, timeOffset, g.colorFade);
+    }
+    case 2: { // Slide
+        const float t = ux * std::cos(g.angle) + uy * std::sin(g.angle) + 0.5f + timeOffset * 0.2f;
+        return GradientStopsWrapped(s, t);
+    }
+    case 3: { // Wave
+        const float perpPos = ux * -std::sin(g.angle) + uy * std::cos(g.angle);
+        const float wave = std::sin(perpPos * 8.0f + timeOffset * 2.0f) * 0.08f;
+        const float t = Clamp01(ux * std::cos(g.angle) + uy * std::sin(g.angle) + 0.5f + wave);
+        return GradientStopsColor(s, t, timeOffset, g.colorFade);
+    }
+    case 4: { // Spiral
+        const float dist = std::sqrt(ux * ux + uy * uy) * 2.0f;
+        const float t = dist + std::atan2(uy, ux) / 6.28318f - timeOffset * 0.3f;
+        return GradientStopsWrapped(s, t);
+    }
+    case 5: // Fade
+        return GradientStopsFade(s, timeOffset);
+    default:
+        return GradientStopsColor(s, 0.0f, timeOffset, g.colorFade);
+    }
+}
+
+void BuildGradientRamp(const GradientStopSpan& s, GradientRamp& out) {
+    out.texels.resize(static_cast<size_t>(GRADIENT_RAMP_LAYERS) * GRADIENT_RAMP_TEXELS * 4);
+    if (s.count <= 0) {
+        std::fill(out.texels.begin(), out.texels.end(), 0.0f);
+        return;
+    }
+    for (int i = 0; i < GRADIENT_RAMP_TEXELS; i++) {
+        // Clamped texels run edge to edge over [0, 1]; wrapped texels tile one period
+        const GradientColor c = GradientStopsClamped(s, static_cast<float>(i) / (GRADIENT_RAMP_TEXELS - 1));
+        const GradientColor w = GradientStopsWrapped(s, static_cast<float>(i) / GRADIENT_RAMP_TEXELS);
+        float* ct = &out.texels[(static_cast<size_t>(GRADIENT_RAMP_CLAMPED) * GRADIENT_RAMP_TEXELS + i) * 4];
+        float* wt = &out.texels[(static_cast<size_t>(GRADIENT_RAMP_WRAPPED) * GRADIENT_RAMP_TEXELS + i) * 4];
+        ct[0] = c.r, ct[1] = c.g, ct[2] = c.b, ct[3] = c.a;
+        wt[0] = w.r, wt[1] = w.g, wt[2] = w.b, wt[3] = w.a;
+    }
+}
+
+uint64_t HashGradientStops(const GradientStopSpan& s) {
+    uint64_t hash = 14695981039346656037ull;
+    auto add = [&hash](uint64_t v) { hash = (hash ^ v) * 1099511628211ull; };
+    add(static_cast<uint64_t>(s.count));
+    for (int i = 0; i < s.count; i++) {
+        const float values[5] = { s.stops[i].r, s.stops[i].g, s.stops[i].b, s.stops[i].a, s.stops[i].position };
+        for (float f : values) {
+            uint32_t bits;
+            std::memcpy(&bits, &f, sizeof(bits));
+            add(bits);
+        }
+    }
+    return hash;
+}
+
+GradientRampCoord GradientRampCoordinate(const RenderCommand::Gradient& g, float u, float v) {
+    const float ux = u - 0.5f, uy = v - 0.5f;
+    const float timeOffset = g.time * g.animationSpeed;
+    // Modes on the clamped layer shift by the color fade
+    auto faded = [&](float t) -> GradientRampCoord { return { g.colorFade ? Fract(t + timeOffset * 0.1f) : t, GRADIENT_RAMP_CLAMPED }; };
+
+    switch (g.animationType) {
+    case 0: // None
+        return faded(Clamp01(ux * std::cos(g.angle) + uy * std::sin(g.angle) + 0.5f));
+    case 1: { // Rotate
+        const float angle = g.angle + timeOffset;
+        return faded(Clamp01(ux * std::cos(angle) + uy * std::sin(angle) + 0.5f));
+    }
+    case 2: // Slide
+        return { ux * std::cos(g.angle) + uy * std::sin(g.angle) + 0.5f + timeOffset * 0.2f, GRADIENT_RAMP_WRAPPED };
+    case 3: { // Wave
+        const float perpPos = ux * -std::sin(g.angle) + uy * std::cos(g.angle);
+        const float wave = std::sin(perpPos * 8.0f + timeOffset * 2.0f) * 0.08f;
+        return faded(Clamp01(ux * std::cos(g.angle) + uy * std::sin(g.angle) + 0.5f + wave));
+    }
+    case 4: { // Spiral
+        const float dist = std::sqrt(ux * ux + uy * uy) * 2.0f;
+        return { dist + std::atan2(uy, ux) / 6.28318f - timeOffset * 0.3f, GRADIENT_RAMP_WRAPPED };
+    }
+    case 5: // Fade
+        return { timeOffset * 0.1f, GRADIENT_RAMP_WRAPPED };
+    default:
+        return faded(0.0f);
+    }
+}
+
+GradientColor SampleGradientRamp(const GradientRamp& ramp, const GradientRampCoord& c) {
+    if (ramp.texels.empty()) return { 0.0f, 0.0f, 0.0f, 0.0f };
+
+    int i0, i1;
+    float frac;
+    if (c.layer == GRADIENT_RAMP_CLAMPED) {
+        const float fx = Clamp01(c.t) * (GRADIENT_RAMP_TEXELS - 1);
+        i0 = (std::min)(static_cast<int>(fx), GRADIENT_RAMP_TEXELS - 1);
+        i1 = (std::min)(i0 + 1, GRADIENT_RAMP_TEXELS - 1);
+        frac = fx - i0;
+    } else {
+        const float fx = Fract(c.t) * GRADIENT_RAMP_TEXELS;
+        i0 = static_cast<int>(fx) % GRADIENT_RAMP_TEXELS;
+        i1 = (i0 + 1) % GRADIENT_RAMP_TEXELS;
+        frac = fx - std::floor(fx);
+    }
+    const float* a = RampTexel(ramp, c.layer, i0);
+    const float* b = RampTexel(ramp, c.layer, i1);
+    return { a[0] + (b[0] - a[0]) * frac, a[1] + (b[1] - a[1]) * frac, a[2] + (b[2] - a[2]) * frac, a[3] + (b[3] - a[3]) * frac };
+}
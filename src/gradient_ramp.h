@@ -0,0 +1,75 @@
+#pragma once
+
+// ============================================================================
+// GRADIENT_RAMP.H - Baked color ramps for gradient backgrounds
+// ============================================================================
+// A gradient background used to search its stops for every fragment, and the slide, wave and spiral
+// animations did that on a full-screen quad every frame. The color along the gradient only depends on
+// the stops, so it is baked once per stop set into a ramp of GRADIENT_RAMP_TEXELS colors, and the shaders
+// reduce each animation to a coordinate transform followed by one linearly filtered lookup.
+//
+// A ramp has two layers. GRADIENT_RAMP_CLAMPED holds the plain gradient over [0, 1] (first and last stop
+// held beyond the ends), sampled edge to edge. GRADIENT_RAMP_WRAPPED holds the seamless loop used by the
+// slide, spiral and fade animations (last stop blending back into the first), sampled with wrap-around.
+// Ramps put no limit on the number of stops. Linear filtering rounds the corner at every stop by up to a
+// quarter texel times the change of slope there, so the ramp is 4096 texels wide: 20 to 32 closely spaced
+// stops with strong color changes stay within one 8-bit step of the per-stop search, where 1024 texels
+// were up to 5 steps off (gradient_ramp_test).
+//
+// The per-stop search the shaders did before (GradientStopsShade) stays here as the reference ramps are
+// built from and compared against; GradientRampShade does on the CPU what the ramp shaders do. This file
+// uses no GL.
+// ============================================================================
+
+#include <cstdint>
+#include <vector>
+
+#include "render_commands.h"
+
+constexpr int GRADIENT_RAMP_TEXELS = 4096; // Per layer
+
+enum GradientRampLayer { GRADIENT_RAMP_CLAMPED, GRADIENT_RAMP_WRAPPED, GRADIENT_RAMP_LAYERS };
+
+struct GradientColor {
+    float r, g, b, a;
+};
+
+struct GradientStopSpan {
+    const RenderGradientStop* stops = nullptr;
+    int count = 0;
+};
+
+// ---- Per-stop reference (the gradient shaders before ramps) ----
+
+// Plain gradient at t, clamped to [0, 1]
+GradientColor GradientStopsClamped(const GradientStopSpan& s, float t);
+// Seamless loop at fract(t): the last stop blends back into the first
+GradientColor GradientStopsWrapped(const GradientStopSpan& s, float t);
+// Color of the whole command at texture coordinate (u, v)
+GradientColor GradientStopsShade(const GradientStopSpan& s, const RenderCommand::Gradient& g, float u, float v);
+
+// ---- Ramps ----
+
+struct GradientRamp {
+    // GRADIENT_RAMP_LAYERS rows of GRADIENT_RAMP_TEXELS RGBA colors
+    std::vector<float> texels;
+};
+
+void BuildGradientRamp(const GradientStopSpan& s, GradientRamp& out);
+
+// Identifies a stop set, so ramps are only rebuilt when the stops change
+uint64_t HashGradientStops(const GradientStopSpan& s);
+
+// Where the ramp shaders sample for (u, v): the animation as a coordinate transform
+struct GradientRampCoord {
+    float t;
+    GradientRampLayer layer;
+};
+GradientRampCoord GradientRampCoordinate(const RenderCommand::Gradient& g, float u, float v);
+
+// Linear filtering as the GL sampler does it: clamped layer edge to edge, wrapped layer with wrap-around
+GradientColor SampleGradientRamp(const GradientRamp& ramp, const GradientRampCoord& c);
+
+inline GradientColor GradientRampShade(const GradientRamp& ramp, const RenderCommand::Gradient& g, float u, float v) {
+    return SampleGradientRamp(ramp, GradientRampCoordinate(g, u, v));
+}
@@ -2,6 +2,7 @@
 #include "config_toml.h"
 #include "expression_parser.h"
 #include "fake_cursor.h"
+#include "gpu_resources.h"
 #include "imgui_impl_opengl3.h"
 #include "imgui_impl_win32.h"
 #include "imgui_stdlib.h"
@@ -552,6 +553,26 @@ GameTransitionType StringToGameTransitionType(const std::string& str) {
     return GameTransitionType::Bounce; // Default to Bounce
 }
 
+std::string EasingTypeToString(EasingType type) {
+    switch (type) {
+    case EasingType::EaseOut:
+        return "EaseOut";
+    case EasingType::EaseIn:
+        return "EaseIn";
+    case EasingType::EaseInOut:
+        return "EaseInOut";
+    default:
+        return "Linear";
+    }
+}
+
+EasingType StringToEasingType(const std::string& str) {
+    if (str == "EaseOut") return EasingType::EaseOut;
+    if (str == "EaseIn") return EasingType::EaseIn;
+    if (str == "EaseInOut") return EasingType::EaseInOut;
+    return EasingType::Linear; // Default to Linear
+}
+
 std::string OverlayTransitionTypeToString(OverlayTransitionType type) {
     switch (type) {
     case OverlayTransitionType::Cut:
@@ -3285,6 +3306,20 @@ void RenderPerformanceOverlay(bool showPerformanceOverlay) {
                      ImGuiWindowFlags_AlwaysAutoResize);
     ImGui::Text("Render Hook Overhead: %.2f ms", cachedFrameTime);
     ImGui::Text("Original Frame Time: %.2f ms", cachedOriginalFrameTime);
+
+    // GPU memory owned through GpuResourceManager, largest subsystems first in one line
+    const GpuMemoryStats gpuMemory = GpuResourceManager::Get().Stats();
+    const double MB = 1.0 / (1024.0 * 1024.0);
+    ImGui::Text("GPU Memory: %.1f MB (%u pending delete)", gpuMemory.totalBytes * MB, gpuMemory.pendingDeletes);
+    std::string breakdown;
+    for (int i = 0; i < static_cast<int>(GpuSubsystem::Count); i++) {
+        if (gpuMemory.objects[i] == 0) continue;
+        char part[64];
+        snprintf(part, sizeof(part), "%s%s %.1f", breakdown.empty() ? "" : ", ", GpuSubsystemName(static_cast<GpuSubsystem>(i)),
+                 gpuMemory.bytes[i] * MB);
+        breakdown += part;
+    }
+    if (!breakdown.empty()) { ImGui::TextDisabled("%s", breakdown.c_str()); }
     ImGui::End();
 }
 
@@ -3293,7 +3328,7 @@ void RenderProfilerOverlay(bool showProfiler, bool showPerformanceOverlay) {
 
     auto displayData = Profiler::GetInstance().GetProfileData();
 
-    ImGui::SetNextWindowPos(ImVec2(5.0f, showPerformanceOverlay ? 80.0f : 5.0f));
+    ImGui::SetNextWindowPos(ImVec2(5.0f, showPerformanceOverlay ? 115.0f : 5.0f));
     ImGui::SetNextWindowBgAlpha(0.35f);
     ImGui::Begin("ProfilerOverlay", nullptr,
                  ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoInputs |
@@ -3415,6 +3450,25 @@ void RenderProfilerOverlay(bool showProfiler, bool showPerformanceOverlay) {
         renderTreeSection("Other Threads", displayData.otherThreads, ImVec4(0.4f, 0.7f, 1.0f, 1.0f));
     }
 
+    // GPU time from PROFILE_GPU_SCOPE, resolved a few frames late
+    if (!displayData.gpu.empty()) {
+        ImGui::Separator();
+        renderTreeSection("GPU", displayData.gpu, ImVec4(1.0f, 0.5f, 0.5f, 1.0f));
+    }
+
+    auto hitRates = Profiler::GetInstance().GetHitRates();
+    if (!hitRates.empty()) {
+        ImGui::Separator();
+        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.8f, 0.4f, 1.0f));
+        ImGui::Text("Hit Rates");
+        ImGui::PopStyleColor();
+        for (const auto& rate : hitRates) {
+            double percent = rate.total > 0 ? 100.0 * static_cast<double>(rate.hits) / static_cast<double>(rate.total) : 0.0;
+            ImGui::Text("  %s: %.1f%% (%llu / %llu)", rate.name.c_str(), percent, static_cast<unsigned long long>(rate.hits),
+                        static_cast<unsigned long long>(rate.total));
+        }
+    }
+
     ImGui::End();
 }
 
@@ -14,7 +14,11 @@
 #include <vector>
 
 #include "config_defaults.h"
+#include "easing_curve.h"
 #include "imgui.h"
+#include "mode_ids.h"
+#include "mode_transition.h"
+#include "overlay_timeline.h"
 #include "version.h"
 
 // Forward declarations for OpenGL types
@@ -217,8 +221,9 @@ struct ImageConfig {
     float opacity = 1.0f;
     ImageBackgroundConfig background;
     bool pixelatedScaling = false;
-    bool onlyOnMyScreen = false; // If true, render only to user's screen, not to OBS
-    BorderConfig border;         // Border around the image overlay
+    bool onlyOnMyScreen = false;     // If true, render only to user's screen, not to OBS
+    BorderConfig border;             // Border around the image overlay
+    OverlayTimelineConfig animation; // Keyframe timeline (no keyframes = static)
 };
 struct WindowOverlayConfig {
     std::string name;
@@ -243,6 +248,7 @@ struct WindowOverlayConfig {
     std::string captureMethod = "Windows 10+"; // Capture method: "Windows 10+" (default) or "BitBlt"
     bool enableInteraction = false;            // Enable mouse/keyboard interaction forwarding to the real window
     BorderConfig border;                       // Border around the window overlay
+    OverlayTimelineConfig animation;           // Keyframe timeline (no keyframes = static)
 };
 // StretchConfig and BorderConfig are defined above ImageConfig
 
@@ -259,15 +265,11 @@ enum class BackgroundTransitionType {
     Cut // Instant switch, no animation
 };
 
-enum class EasingType {
-    Linear,   // No easing, constant speed
-    EaseOut,  // Slow down at end
-    EaseIn,   // Speed up from start
-    EaseInOut // Slow start and end
-};
+// EasingType is defined in easing_curve.h
 
 struct ModeConfig {
     std::string id;
+    ModeIdHandle internId = MODE_ID_NONE; // Cached InternModeId(id), refreshed by PublishConfigSnapshot (not serialized)
     int width = 0, height = 0;
     bool useRelativeSize = false; // When true, width/height are calculated from relativeWidth/relativeHeight
     float relativeWidth = 0.5f;   // Width as percentage of screen (0.0-1.0, where 1.0 = 100%)
@@ -362,6 +364,7 @@ struct DebugGlobalConfig {
     bool showTextureGrid = false;
     bool delayRenderingUntilFinished = false; // Call glFinish() before SwapBuffers to ensure all rendering is complete
     bool delayRenderingUntilBlitted = false;  // Wait on async overlay blit fence before SwapBuffers
+    bool disableOverlayLayerCache = false;    // Redraw static overlay layers every frame instead of reusing their textures
     bool virtualCameraEnabled = false;        // Output to OBS Virtual Camera driver
     int virtualCameraFps = 60;                // Virtual camera FPS limit
 
@@ -490,63 +493,6 @@ struct GameViewportGeometry {
     int finalX = 0, finalY = 0, finalW = 0, finalH = 0;
 };
 
-// --- Mode Transition Animation State ---
-struct ModeTransitionAnimation {
-    bool active = false;
-    std::chrono::steady_clock::time_point startTime;
-    float duration = 0.3f; // Game animation duration in seconds (300ms default)
-
-    // Transition configuration
-    GameTransitionType gameTransition = GameTransitionType::Cut;
-    OverlayTransitionType overlayTransition = OverlayTransitionType::Cut;
-    BackgroundTransitionType backgroundTransition = BackgroundTransitionType::Cut;
-
-    // Easing and bounce settings (copied from ModeConfig)
-    float easeInPower = 1.0f;
-    float easeOutPower = 3.0f;
-    int bounceCount = 0;
-    float bounceIntensity = 0.15f;
-    int bounceDurationMs = 150;
-    bool skipAnimateX = false; // When true, X axis instantly jumps to target
-    bool skipAnimateY = false; // When true, Y axis instantly jumps to target
-
-    // Source mode (animating FROM)
-    std::string fromModeId;
-    int fromWidth = 0;
-    int fromHeight = 0;
-    int fromX = 0;
-    int fromY = 0;
-
-    // Target mode (animating TO)
-    std::string toModeId;
-    int toWidth = 0;
-    int toHeight = 0;
-    int toX = 0;
-    int toY = 0;
-
-    // Native (non-stretched) dimensions - used for viewport matching
-    // When stretch is enabled, these differ from toWidth/toHeight
-    int fromNativeWidth = 0;
-    int fromNativeHeight = 0;
-    int toNativeWidth = 0;
-    int toNativeHeight = 0;
-
-    // Current animated values (for game Move transition)
-    int currentWidth = 0;
-    int currentHeight = 0;
-    int currentX = 0;
-    int currentY = 0;
-    float progress = 0.0f;     // 0.0 to 1.0 - overall animation progress
-    float moveProgress = 0.0f; // 0.0 to 1.0 - movement-only progress, reaches 1.0 when bounce starts
-
-    // Last WM_SIZE sent dimensions (to avoid sending duplicate messages)
-    int lastSentWidth = 0;
-    int lastSentHeight = 0;
-
-    // Flag to track if WM_SIZE has been sent for this transition
-    bool wmSizeSent = false;
-};
-
 extern Config g_config;
 extern std::atomic<bool> g_configIsDirty;
 
@@ -635,52 +581,16 @@ extern std::mutex g_tempSensitivityMutex;
 // Clear the temporary sensitivity override (called on mode switch)
 void ClearTempSensitivityOverride();
 
-extern ModeTransitionAnimation g_modeTransition;
-extern std::mutex g_modeTransitionMutex;
+// Active mode transition (see mode_transition.h), published by StartModeTransition and retired by the game
+// thread after the frame that completes it. Null when no transition is active. Access with
+// std::atomic_load/std::atomic_store like the config snapshot.
+extern std::shared_ptr<const ModeTransitionDescriptor> g_activeModeTransition;
+// Present time of the game frame the viewport hook and game-thread rendering evaluate the transition for
+// (steady_clock ticks); advanced once per frame by UpdateModeTransition
+extern std::atomic<int64_t> g_modeTransitionFrameTicks;
 extern std::atomic<bool> g_skipViewportAnimation; // When true, viewport hook uses target position (for animations)
 extern std::atomic<int> g_wmMouseMoveCount;       // Counter for WM_MOUSEMOVE events without raw input
 
-// This is a compact snapshot updated atomically for lock-free reads
-struct ViewportTransitionSnapshot {
-    bool active = false;
-    bool isBounceTransition = false;
-    // From mode
-    std::string fromModeId; // Mode ID we're transitioning FROM (for background rendering)
-    // To mode
-    std::string toModeId; // Mode ID we're transitioning TO (for sensitivity override)
-    int fromWidth = 0;
-    int fromHeight = 0;
-    int fromX = 0;
-    int fromY = 0;
-    // Current animated values
-    int currentX = 0;
-    int currentY = 0;
-    int currentWidth = 0;
-    int currentHeight = 0;
-    // Target values
-    int toX = 0;
-    int toY = 0;
-    int toWidth = 0;
-    int toHeight = 0;
-    // Native (non-stretched) dimensions - used for viewport matching
-    int fromNativeWidth = 0;
-    int fromNativeHeight = 0;
-    int toNativeWidth = 0;
-    int toNativeHeight = 0;
-    // Transition types (for GetModeTransitionState)
-    GameTransitionType gameTransition = GameTransitionType::Cut;
-    OverlayTransitionType overlayTransition = OverlayTransitionType::Cut;
-    BackgroundTransitionType backgroundTransition = BackgroundTransitionType::Cut;
-    // Progress values
-    float progress = 1.0f;     // Overall animation progress including bounces
-    float moveProgress = 1.0f; // Movement-only progress, reaches 1.0 when bounce starts
-
-    // Start time for progress calculation
-    std::chrono::steady_clock::time_point startTime;
-};
-extern ViewportTransitionSnapshot g_viewportTransitionSnapshots[2];
-extern std::atomic<int> g_viewportTransitionSnapshotIndex;
-
 extern std::string g_lastFrameModeIdBuffers[2];
 extern std::atomic<int> g_lastFrameModeIdIndex;
 
@@ -756,6 +666,8 @@ void CopyToClipboard(HWND hwnd, const std::string& text);
 
 std::string GameTransitionTypeToString(GameTransitionType type);
 GameTransitionType StringToGameTransitionType(const std::string& str);
+std::string EasingTypeToString(EasingType type);
+EasingType StringToEasingType(const std::string& str);
 std::string OverlayTransitionTypeToString(OverlayTransitionType type);
 OverlayTransitionType StringToOverlayTransitionType(const std::string& str);
 std::string BackgroundTransitionTypeToString(BackgroundTransitionType type);
@@ -771,4 +683,9 @@ bool IsModeTransitionActive();
 GameTransitionType GetGameTransitionType();
 OverlayTransitionType GetOverlayTransitionType();
 BackgroundTransitionType GetBackgroundTransitionType();
-void GetAnimatedModeViewport(int& outWidth, int& outHeight); // Get current animated dimensions
\ No newline at end of file
+void GetAnimatedModeViewport(int& outWidth, int& outHeight); // Get current animated dimensions
+// Active transition descriptor, or null when none is active. Lock-free.
+std::shared_ptr<const ModeTransitionDescriptor> GetActiveModeTransition();
+// Present time of the game frame being built. The viewport hook and game-thread rendering both evaluate the
+// transition at this time, so the viewport and the background around it agree within a frame.
+TransitionClock::time_point GetModeTransitionFrameTime();
\ No newline at end of file
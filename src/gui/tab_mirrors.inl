@@ -79,28 +79,19 @@ if (ImGui::BeginTabItem("Mirrors")) {
                                 if (item.mirrorId == oldMirrorName) { item.mirrorId = mirror.name; }
                             }
                         }
-                        // Update g_mirrorInstances map key so the mirror continues rendering
+                        // Rename the g_mirrorInstances entry in place so the mirror keeps its slot and continues rendering
                         {
                             std::unique_lock<std::shared_mutex> lock(g_mirrorInstancesMutex);
-                            auto it = g_mirrorInstances.find(oldMirrorName);
-                            if (it != g_mirrorInstances.end()) {
-                                MirrorInstance inst = std::move(it->second);
-                                g_mirrorInstances.erase(it);
-                                inst.cachedRenderState.isValid = false;
-                                inst.forceUpdateFrames = 3;
-                                g_mirrorInstances[mirror.name] = std::move(inst);
-                            }
-                        }
-                        // Update g_threadedMirrorConfigs so capture thread uses new name
-                        {
-                            std::lock_guard<std::mutex> lock(g_threadedMirrorConfigMutex);
-                            for (auto& conf : g_threadedMirrorConfigs) {
-                                if (conf.name == oldMirrorName) {
-                                    conf.name = mirror.name;
-                                    break;
+                            if (g_mirrorInstances.Rename(oldMirrorName, mirror.name)) {
+                                auto it = g_mirrorInstances.find(mirror.name);
+                                if (it != g_mirrorInstances.end()) {
+                                    it->second.cachedRenderState.isValid = false;
+                                    it->second.forceUpdateFrames = 3;
                                 }
                             }
                         }
+                        // Republish the threaded configs so capture thread uses new name
+                        RenameMirrorCaptureConfig(oldMirrorName, mirror.name);
                         // Update selected mirror name if it was the one being renamed
                         if (selectedMirrorName == oldMirrorName) { selectedMirrorName = mirror.name; }
                     }
@@ -378,7 +369,7 @@ if (ImGui::BeginTabItem("Mirrors")) {
             ImGui::Separator();
 
             // Target Colors section - multiple colors can be matched
-            ImGui::Text("Target Colors (max 8)");
+            ImGui::Text("Target Colors");
             int target_color_to_remove = -1;
             for (size_t j = 0; j < mirror.colors.targetColors.size(); ++j) {
                 ImGui::PushID(static_cast<int>(j));
@@ -427,19 +418,17 @@ if (ImGui::BeginTabItem("Mirrors")) {
                 if (it != g_mirrorInstances.end()) it->second.forceUpdateFrames = 3;
             }
 
-            // Add new target color button (max 8)
-            if (mirror.colors.targetColors.size() < 8) {
-                if (ImGui::Button("+ Add Target Color")) {
-                    // Add a new default color (green)
-                    Color newColor = { 0.0f, 1.0f, 0.0f };
-                    mirror.colors.targetColors.push_back(newColor);
-                    g_configIsDirty = true;
-                    UpdateMirrorCaptureSettings(mirror.name, mirror.captureWidth, mirror.captureHeight, mirror.border, mirror.colors,
-                                                mirror.colorSensitivity, mirror.rawOutput, mirror.colorPassthrough);
-                    std::unique_lock<std::shared_mutex> lock(g_mirrorInstancesMutex);
-                    auto it = g_mirrorInstances.find(mirror.name);
-                    if (it != g_mirrorInstances.end()) it->second.forceUpdateFrames = 3;
-                }
+            // Add new target color button (no limit - large sets are matched through a lookup table)
+            if (ImGui::Button("+ Add Target Color")) {
+                // Add a new default color (green)
+                Color newColor = { 0.0f, 1.0f, 0.0f };
+                mirror.colors.targetColors.push_back(newColor);
+                g_configIsDirty = true;
+                UpdateMirrorCaptureSettings(mirror.name, mirror.captureWidth, mirror.captureHeight, mirror.border, mirror.colors,
+                                            mirror.colorSensitivity, mirror.rawOutput, mirror.colorPassthrough);
+                std::unique_lock<std::shared_mutex> lock(g_mirrorInstancesMutex);
+                auto it = g_mirrorInstances.find(mirror.name);
+                if (it != g_mirrorInstances.end()) it->second.forceUpdateFrames = 3;
             }
 
             if (ImGui::SliderFloat("Color Sensitivity", &mirror.colorSensitivity, 0.001f, 1.0f)) {
@@ -607,8 +607,8 @@
                             g_configIsDirty = true;
                         }
 
-                        // Add stop button (max 8 stops)
-                        if (mode.background.gradientStops.size() < 8) {
+                        // Add stop button
+                        if (mode.background.gradientStops.size() < RenderCommandList::MAX_GRADIENT_STOPS) {
                             if (ImGui::Button("+ Add Color Stop##bgGrad")) {
                                 // Add at midpoint with gray color
                                 GradientColorStop newStop;
@@ -1042,8 +1042,8 @@
                             g_configIsDirty = true;
                         }
 
-                        // Add stop button (max 8 stops)
-                        if (mode.background.gradientStops.size() < 8) {
+                        // Add stop button
+                        if (mode.background.gradientStops.size() < RenderCommandList::MAX_GRADIENT_STOPS) {
                             if (ImGui::Button("+ Add Color Stop##bgGradPreemptive")) {
                                 // Add at midpoint with gray color
                                 GradientColorStop newStop;
@@ -1441,7 +1441,7 @@
                             mode.background.gradientStops.erase(mode.background.gradientStops.begin() + stopToRemove);
                             g_configIsDirty = true;
                         }
-                        if (mode.background.gradientStops.size() < 8) {
+                        if (mode.background.gradientStops.size() < RenderCommandList::MAX_GRADIENT_STOPS) {
                             if (ImGui::Button("+ Add Color Stop##bgGradThin")) {
                                 GradientColorStop newStop;
                                 newStop.position = 0.5f;
@@ -1811,7 +1811,7 @@
                             mode.background.gradientStops.erase(mode.background.gradientStops.begin() + stopToRemove);
                             g_configIsDirty = true;
                         }
-                        if (mode.background.gradientStops.size() < 8) {
+                        if (mode.background.gradientStops.size() < RenderCommandList::MAX_GRADIENT_STOPS) {
                             if (ImGui::Button("+ Add Color Stop##bgGradWide")) {
                                 GradientColorStop newStop;
                                 newStop.position = 0.5f;
@@ -2276,7 +2276,7 @@
                             mode.background.gradientStops.erase(mode.background.gradientStops.begin() + stopToRemove);
                             g_configIsDirty = true;
                         }
-                        if (mode.background.gradientStops.size() < 8) {
+                        if (mode.background.gradientStops.size() < RenderCommandList::MAX_GRADIENT_STOPS) {
                             if (ImGui::Button(("+ Add Color Stop" + gradId).c_str())) {
                                 GradientColorStop newStop;
                                 newStop.position = 0.5f;
@@ -153,6 +153,11 @@ if (ImGui::BeginTabItem("Settings")) {
                    "This is a lighter-weight alternative to 'Delay Rendering Until Finished'\n"
                    "that only waits for the overlay blit operation specifically.\n\n"
                    "May help with capture timing issues while having less performance impact.");
+        if (ImGui::Checkbox("Disable Overlay Layer Cache", &g_config.debug.disableOverlayLayerCache)) { g_configIsDirty = true; }
+        ImGui::SameLine();
+        HelpMarker("Redraws image overlays every frame instead of reusing a cached layer texture\n"
+                   "while nothing about them changed.\n\n"
+                   "Only useful for diagnosing rendering differences.");
         ImGui::Spacing();
         if (ImGui::Checkbox("Show Performance Overlay", &g_config.debug.showPerformanceOverlay)) { g_configIsDirty = true; }
         if (ImGui::Checkbox("Show Profiler", &g_config.debug.showProfiler)) { g_configIsDirty = true; }
@@ -0,0 +1,152 @@
+// ============================================================================
+// MIRROR_ANALYSIS.CPP - Mirror capture subscriptions and the analysis thread
+// ============================================================================
+
+#include "mirror_analysis.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "profiler.h"
+#include "utils.h"
+
+namespace {
+
+constexpr size_t MAX_QUEUED_FRAMES = 8;
+
+struct Subscription {
+    uint64_t id = 0;
+    std::string mirrorName;
+    MirrorAnalysisCallback callback;
+    bool computeStats = false;
+};
+
+std::mutex g_subscriptionMutex;
+std::vector<Subscription> g_subscriptions;
+uint64_t g_nextSubscriptionId = 1;
+std::atomic<int> g_subscriptionCount{ 0 };
+
+// Held while callbacks run, so UnregisterMirrorAnalysis can wait for an in-flight call
+std::mutex g_dispatchMutex;
+
+std::mutex g_queueMutex;
+std::condition_variable g_queueCV;
+std::deque<MirrorAnalysisFrame> g_queue;
+std::thread g_analysisThread;
+bool g_analysisThreadRunning = false; // Guarded by g_queueMutex
+bool g_analysisShouldStop = false;
+
+void DispatchFrame(MirrorAnalysisFrame& frame) {
+    PROFILE_SCOPE_CAT("Mirror Analysis", "Mirror Analysis");
+    std::lock_guard<std::mutex> dispatchLock(g_dispatchMutex);
+
+    std::vector<Subscription> targets;
+    {
+        std::lock_guard<std::mutex> lock(g_subscriptionMutex);
+        for (const auto& sub : g_subscriptions) {
+            if (sub.mirrorName == frame.mirrorName) { targets.push_back(sub); }
+        }
+    }
+    if (targets.empty()) return;
+
+    bool wantStats = false;
+    for (const auto& sub : targets) { wantStats |= sub.computeStats; }
+    if (wantStats) {
+        PROFILE_SCOPE_CAT("Pixel Stats", "Mirror Analysis");
+        MirrorFilterComputeStats(frame.params, frame.pixels.data(), frame.width, frame.height, 0, frame.stats);
+    }
+
+    for (const auto& sub : targets) {
+        try {
+            sub.callback(frame);
+        } catch (const std::exception& e) {
+            Log("Mirror analysis callback for '" + frame.mirrorName + "' threw: " + e.what());
+        } catch (...) {
+            Log("Mirror analysis callback for '" + frame.mirrorName + "' threw an unknown exception");
+        }
+    }
+}
+
+void AnalysisThreadMain() {
+    while (true) {
+        MirrorAnalysisFrame frame;
+        {
+            std::unique_lock<std::mutex> lock(g_queueMutex);
+            g_queueCV.wait(lock, [] { return g_analysisShouldStop || !g_queue.empty(); });
+            if (g_analysisShouldStop) return;
+            frame = std::move(g_queue.front());
+            g_queue.pop_front();
+        }
+        DispatchFrame(frame);
+    }
+}
+
+} // namespace
+
+uint64_t RegisterMirrorAnalysis(const std::string& mirrorName, MirrorAnalysisCallback callback, bool computeStats) {
+    if (!callback) return 0;
+    std::lock_guard<std::mutex> lock(g_subscriptionMutex);
+    Subscription sub;
+    sub.id = g_nextSubscriptionId++;
+    sub.mirrorName = mirrorName;
+    sub.callback = std::move(callback);
+    sub.computeStats = computeStats;
+    g_subscriptions.push_back(std::move(sub));
+    g_subscriptionCount.store(static_cast<int>(g_subscriptions.size()), std::memory_order_release);
+    return g_subscriptions.back().id;
+}
+
+void UnregisterMirrorAnalysis(uint64_t id) {
+    {
+        std::lock_guard<std::mutex> lock(g_subscriptionMutex);
+        for (auto it = g_subscriptions.begin(); it != g_subscriptions.end(); ++it) {
+            if (it->id == id) {
+                g_subscriptions.erase(it);
+                break;
+            }
+        }
+        g_subscriptionCount.store(static_cast<int>(g_subscriptions.size()), std::memory_order_release);
+    }
+    // Wait for a dispatch that may have picked up the callback before it was removed
+    std::lock_guard<std::mutex> dispatchLock(g_dispatchMutex);
+}
+
+bool HasMirrorAnalysisSubscribers() { return g_subscriptionCount.load(std::memory_order_acquire) > 0; }
+
+bool IsMirrorAnalysisRequested(const std::string& mirrorName) {
+    if (!HasMirrorAnalysisSubscribers()) return false;
+    std::lock_guard<std::mutex> lock(g_subscriptionMutex);
+    for (const auto& sub : g_subscriptions) {
+        if (sub.mirrorName == mirrorName) return true;
+    }
+    return false;
+}
+
+void SubmitMirrorAnalysisFrame(MirrorAnalysisFrame&& frame) {
+    std::lock_guard<std::mutex> lock(g_queueMutex);
+    if (!g_analysisThreadRunning) {
+        g_analysisShouldStop = false;
+        g_analysisThread = std::thread(AnalysisThreadMain);
+        g_analysisThreadRunning = true;
+    }
+    if (g_queue.size() >= MAX_QUEUED_FRAMES) { g_queue.pop_front(); } // Consumer is behind: keep the newest frames
+    g_queue.push_back(std::move(frame));
+    g_queueCV.notify_one();
+}
+
+void StopMirrorAnalysisThread() {
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(g_queueMutex);
+        if (!g_analysisThreadRunning) return;
+        g_analysisShouldStop = true;
+        g_analysisThreadRunning = false;
+        g_queue.clear();
+        thread = std::move(g_analysisThread);
+    }
+    g_queueCV.notify_all();
+    if (thread.joinable()) { thread.join(); }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+// ============================================================================
+// MIRROR_ANALYSIS.H - Opt-in CPU access to mirror captures
+// ============================================================================
+// Lets code read mirror pixels back on the CPU (e.g. to read numbers off the pie chart or F3 screen)
+// without stalling the mirror capture thread. A subscriber registers a callback for a mirror name;
+// while at least one subscription exists for a mirror, the capture thread reads that mirror's capture
+// image (pass 1 output, fbo_w x fbo_h) into a small ring of PBOs and harvests whichever readbacks the
+// GPU has finished, without waiting on them. Harvested frames are handed to an analysis thread, which
+// optionally computes pixel statistics (MirrorFilterComputeStats) and invokes the callbacks.
+//
+// Callbacks run on the analysis thread, never on the game or capture thread. If the consumer is slower
+// than the capture rate, the oldest queued frames are dropped.
+// ============================================================================
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "mirror_filter.h"
+
+struct MirrorAnalysisFrame {
+    std::string mirrorName;
+    int width = 0, height = 0;
+    std::vector<uint8_t> pixels; // RGBA8, tightly packed, bottom-up rows (GL order)
+    bool rawOutput = false;      // Captured as raw output (game colors, no filtering)
+    MirrorFilterParams params;   // Filter settings the capture was made with (target colors, sensitivity, gamma)
+    MirrorPixelStats stats;      // Filled only if a subscriber asked for statistics
+    std::chrono::steady_clock::time_point captureTime;
+};
+
+using MirrorAnalysisCallback = std::function<void(const MirrorAnalysisFrame&)>;
+
+// Subscribe to a mirror's captures. Returns an id for UnregisterMirrorAnalysis (never 0).
+// computeStats: run MirrorFilterComputeStats before the callback (shared by all subscribers of the mirror).
+uint64_t RegisterMirrorAnalysis(const std::string& mirrorName, MirrorAnalysisCallback callback, bool computeStats);
+
+// Remove a subscription. Once this returns, the callback is not running and will not be called again,
+// so it must not be called from inside the callback itself.
+void UnregisterMirrorAnalysis(uint64_t id);
+
+// --- Capture thread side ---
+
+// Cheap check for the per-frame path: true if any subscription exists at all
+bool HasMirrorAnalysisSubscribers();
+
+// True if the named mirror has at least one subscriber
+bool IsMirrorAnalysisRequested(const std::string& mirrorName);
+
+// Queue a harvested frame for the analysis thread (started on first use)
+void SubmitMirrorAnalysisFrame(MirrorAnalysisFrame&& frame);
+
+// Stop the analysis thread and drop queued frames; subscriptions are kept
+void StopMirrorAnalysisThread();
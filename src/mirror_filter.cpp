@@ -0,0 +1,658 @@
+// ============================================================================
+// MIRROR_FILTER.CPP - CPU mirror color-filter pipeline
+// ============================================================================
+// The per-pixel target-color test is the only hot part, so it has SSE2 and AVX2 kernels.
+// Everything else (region addressing, blending, border resolve) is scalar and follows the
+// GLSL programs in mirror_thread.cpp line by line.
+// ============================================================================
+
+#include "mirror_filter.h"
+#include "mirror_match_lut.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define MIRROR_FILTER_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define MIRROR_FILTER_X86 0
+#endif
+
+// MSVC allows AVX2 intrinsics in any function; GCC/Clang need the target attribute.
+#if MIRROR_FILTER_X86 && (defined(__GNUC__) || defined(__clang__))
+#define MIRROR_FILTER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MIRROR_FILTER_TARGET_AVX2
+#endif
+
+// ============================================================================
+// Color conversion tables
+// ============================================================================
+
+float MirrorFilterSRGBToLinear(float c) {
+    if (c <= 0.04045f) { return c / 12.92f; }
+    return std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+namespace {
+
+// Input pixels are 8-bit, so both the normalized and the linearized channel value are table lookups
+struct ChannelTables {
+    float srgb[256];
+    float linear[256];
+
+    ChannelTables() {
+        for (int i = 0; i < 256; i++) {
+            srgb[i] = static_cast<float>(i) / 255.0f;
+            linear[i] = MirrorFilterSRGBToLinear(srgb[i]);
+        }
+    }
+};
+
+const ChannelTables& GetChannelTables() {
+    static const ChannelTables s_tables;
+    return s_tables;
+}
+
+inline uint8_t FloatToUnorm8(float v) {
+    if (v <= 0.0f) return 0;
+    if (v >= 1.0f) return 255;
+    return static_cast<uint8_t>(v * 255.0f + 0.5f);
+}
+
+inline uint8_t AddSaturate(uint8_t a, uint8_t b) {
+    int s = static_cast<int>(a) + static_cast<int>(b);
+    return static_cast<uint8_t>(s > 255 ? 255 : s);
+}
+
+// ============================================================================
+// CPU feature detection
+// ============================================================================
+
+bool CpuSupportsAVX2() {
+#if MIRROR_FILTER_X86 && defined(_MSC_VER)
+    int info[4] = { 0, 0, 0, 0 };
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx) return false;
+
+    // OS must save YMM state on context switch
+    if ((_xgetbv(0) & 0x6) != 0x6) return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#elif MIRROR_FILTER_X86 && (defined(__GNUC__) || defined(__clang__))
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+MirrorFilterKernel DetectBestKernel() {
+#if MIRROR_FILTER_X86
+    if (CpuSupportsAVX2()) return MirrorFilterKernel::AVX2;
+    return MirrorFilterKernel::SSE2;
+#else
+    return MirrorFilterKernel::Scalar;
+#endif
+}
+
+std::atomic<int> g_filterKernel{ -1 }; // -1 = not detected yet
+
+// ============================================================================
+// Match kernels
+// ============================================================================
+// All kernels evaluate exactly the same float expression in the same order, so they agree bit-for-bit:
+//   AssumeLinear: |srgb - targetLinear|^2
+//   AssumeSRGB:   |linear - targetLinear|^2
+//   Auto:         min(|srgb - targetSRGB|^2, |linear - targetLinear|^2)
+// and a pixel matches when the squared distance is below sensitivity^2.
+
+inline float DistSq(float r, float g, float b, const float* t) {
+    float dr = r - t[0];
+    float dg = g - t[1];
+    float db = b - t[2];
+    return dr * dr + dg * dg + db * db;
+}
+
+void MatchPixelsScalar(const MirrorFilterMatcher& m, const uint8_t* rgba, int count, uint8_t* outMask) {
+    const ChannelTables& tables = GetChannelTables();
+    for (int i = 0; i < count; i++) {
+        const uint8_t* px = rgba + i * 4;
+        const float sr = tables.srgb[px[0]], sg = tables.srgb[px[1]], sb = tables.srgb[px[2]];
+        const float lr = tables.linear[px[0]], lg = tables.linear[px[1]], lb = tables.linear[px[2]];
+
+        uint8_t match = 0;
+        for (int t = 0; t < m.targetCount && !match; t++) {
+            const float* tLin = &m.targetsLinear[t * 3];
+            float d;
+            if (m.gammaMode == MirrorGammaMode::AssumeLinear) {
+                d = DistSq(sr, sg, sb, tLin);
+            } else if (m.gammaMode == MirrorGammaMode::AssumeSRGB) {
+                d = DistSq(lr, lg, lb, tLin);
+            } else {
+                d = (std::min)(DistSq(sr, sg, sb, &m.targetsSRGB[t * 3]), DistSq(lr, lg, lb, tLin));
+            }
+            if (d < m.sensitivitySq) { match = 1; }
+        }
+        outMask[i] = match;
+    }
+}
+
+#if MIRROR_FILTER_X86
+
+inline __m128 DistSqSSE(__m128 r, __m128 g, __m128 b, const float* t) {
+    __m128 dr = _mm_sub_ps(r, _mm_set1_ps(t[0]));
+    __m128 dg = _mm_sub_ps(g, _mm_set1_ps(t[1]));
+    __m128 db = _mm_sub_ps(b, _mm_set1_ps(t[2]));
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(dg, dg)), _mm_mul_ps(db, db));
+}
+
+void MatchPixelsSSE2(const MirrorFilterMatcher& m, const uint8_t* rgba, int count, uint8_t* outMask) {
+    const ChannelTables& tables = GetChannelTables();
+    const __m128 sensSq = _mm_set1_ps(m.sensitivitySq);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const uint8_t* p = rgba + i * 4;
+        // SSE2 has no gather - table lookups are scalar, the distance math is vectorized
+        __m128 sr = _mm_setr_ps(tables.srgb[p[0]], tables.srgb[p[4]], tables.srgb[p[8]], tables.srgb[p[12]]);
+        __m128 sg = _mm_setr_ps(tables.srgb[p[1]], tables.srgb[p[5]], tables.srgb[p[9]], tables.srgb[p[13]]);
+        __m128 sb = _mm_setr_ps(tables.srgb[p[2]], tables.srgb[p[6]], tables.srgb[p[10]], tables.srgb[p[14]]);
+        __m128 lr = _mm_setr_ps(tables.linear[p[0]], tables.linear[p[4]], tables.linear[p[8]], tables.linear[p[12]]);
+        __m128 lg = _mm_setr_ps(tables.linear[p[1]], tables.linear[p[5]], tables.linear[p[9]], tables.linear[p[13]]);
+        __m128 lb = _mm_setr_ps(tables.linear[p[2]], tables.linear[p[6]], tables.linear[p[10]], tables.linear[p[14]]);
+
+        __m128 matched = _mm_setzero_ps();
+        for (int t = 0; t < m.targetCount; t++) {
+            const float* tLin = &m.targetsLinear[t * 3];
+            __m128 d;
+            if (m.gammaMode == MirrorGammaMode::AssumeLinear) {
+                d = DistSqSSE(sr, sg, sb, tLin);
+            } else if (m.gammaMode == MirrorGammaMode::AssumeSRGB) {
+                d = DistSqSSE(lr, lg, lb, tLin);
+            } else {
+                d = _mm_min_ps(DistSqSSE(sr, sg, sb, &m.targetsSRGB[t * 3]), DistSqSSE(lr, lg, lb, tLin));
+            }
+            matched = _mm_or_ps(matched, _mm_cmplt_ps(d, sensSq));
+            if (_mm_movemask_ps(matched) == 0xF) break; // All four already matched
+        }
+
+        int bits = _mm_movemask_ps(matched);
+        outMask[i + 0] = static_cast<uint8_t>(bits & 1);
+        outMask[i + 1] = static_cast<uint8_t>((bits >> 1) & 1);
+        outMask[i + 2] = static_cast<uint8_t>((bits >> 2) & 1);
+        outMask[i + 3] = static_cast<uint8_t>((bits >> 3) & 1);
+    }
+
+    if (i < count) { MatchPixelsScalar(m, rgba + i * 4, count - i, outMask + i); }
+}
+
+MIRROR_FILTER_TARGET_AVX2 inline __m256 DistSqAVX2(__m256 r, __m256 g, __m256 b, const float* t) {
+    __m256 dr = _mm256_sub_ps(r, _mm256_set1_ps(t[0]));
+    __m256 dg = _mm256_sub_ps(g, _mm256_set1_ps(t[1]));
+    __m256 db = _mm256_sub_ps(b, _mm256_set1_ps(t[2]));
+    // Deliberately no FMA: keep the same rounding as the scalar/SSE2 kernels
+    return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dr, dr), _mm256_mul_ps(dg, dg)), _mm256_mul_ps(db, db));
+}
+
+MIRROR_FILTER_TARGET_AVX2 void MatchPixelsAVX2(const MirrorFilterMatcher& m, const uint8_t* rgba, int count, uint8_t* outMask) {
+    const ChannelTables& tables = GetChannelTables();
+    const __m256 sensSq = _mm256_set1_ps(m.sensitivitySq);
+    const __m256i byteMask = _mm256_set1_epi32(0xFF);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        // 8 RGBA pixels = one 256-bit load; R is the low byte of each 32-bit lane
+        __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rgba + i * 4));
+        __m256i ir = _mm256_and_si256(px, byteMask);
+        __m256i ig = _mm256_and_si256(_mm256_srli_epi32(px, 8), byteMask);
+        __m256i ib = _mm256_and_si256(_mm256_srli_epi32(px, 16), byteMask);
+
+        __m256 sr = _mm256_i32gather_ps(tables.srgb, ir, 4);
+        __m256 sg = _mm256_i32gather_ps(tables.srgb, ig, 4);
+        __m256 sb = _mm256_i32gather_ps(tables.srgb, ib, 4);
+        __m256 lr = _mm256_i32gather_ps(tables.linear, ir, 4);
+        __m256 lg = _mm256_i32gather_ps(tables.linear, ig, 4);
+        __m256 lb = _mm256_i32gather_ps(tables.linear, ib, 4);
+
+        __m256 matched = _mm256_setzero_ps();
+        for (int t = 0; t < m.targetCount; t++) {
+            const float* tLin = &m.targetsLinear[t * 3];
+            __m256 d;
+            if (m.gammaMode == MirrorGammaMode::AssumeLinear) {
+                d = DistSqAVX2(sr, sg, sb, tLin);
+            } else if (m.gammaMode == MirrorGammaMode::AssumeSRGB) {
+                d = DistSqAVX2(lr, lg, lb, tLin);
+            } else {
+                d = _mm256_min_ps(DistSqAVX2(sr, sg, sb, &m.targetsSRGB[t * 3]), DistSqAVX2(lr, lg, lb, tLin));
+            }
+            matched = _mm256_or_ps(matched, _mm256_cmp_ps(d, sensSq, _CMP_LT_OQ));
+            if (_mm256_movemask_ps(matched) == 0xFF) break; // All eight already matched
+        }
+
+        int bits = _mm256_movemask_ps(matched);
+        for (int k = 0; k < 8; k++) { outMask[i + k] = static_cast<uint8_t>((bits >> k) & 1); }
+    }
+
+    if (i < count) { MatchPixelsScalar(m, rgba + i * 4, count - i, outMask + i); }
+}
+
+#endif // MIRROR_FILTER_X86
+
+// ============================================================================
+// Pixel statistics helpers
+// ============================================================================
+// Masks hold one byte (0 or 1) per pixel. Counting and bounding boxes work on 16 mask bytes at a time.
+
+inline int LowestBit(unsigned bits) {
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward(&idx, bits);
+    return static_cast<int>(idx);
+#else
+    return __builtin_ctz(bits);
+#endif
+}
+
+inline int HighestBit(unsigned bits) {
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanReverse(&idx, bits);
+    return static_cast<int>(idx);
+#else
+    return 31 - __builtin_clz(bits);
+#endif
+}
+
+// mask[i] = alpha[i] > 0
+void AlphaMaskScalar(const uint8_t* rgba, int count, uint8_t* outMask) {
+    for (int i = 0; i < count; i++) { outMask[i] = rgba[static_cast<size_t>(i) * 4 + 3] ? 1 : 0; }
+}
+
+// mask[i] &= other[i]
+void AndMaskScalar(uint8_t* mask, const uint8_t* other, int count) {
+    for (int i = 0; i < count; i++) { mask[i] &= other[i]; }
+}
+
+// Number of set bytes and the first/last set index (-1 if none)
+void ScanMaskScalar(const uint8_t* mask, int count, int& outCount, int& outFirst, int& outLast) {
+    outCount = 0;
+    outFirst = outLast = -1;
+    for (int i = 0; i < count; i++) {
+        if (!mask[i]) continue;
+        outCount++;
+        if (outFirst < 0) { outFirst = i; }
+        outLast = i;
+    }
+}
+
+#if MIRROR_FILTER_X86
+
+void AlphaMaskSSE2(const uint8_t* rgba, int count, uint8_t* outMask) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi8(1);
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i* p = reinterpret_cast<const __m128i*>(rgba + static_cast<size_t>(i) * 4);
+        // Alpha is the top byte of each 32-bit pixel; shift it down and pack 16 pixels into 16 bytes
+        __m128i a0 = _mm_srli_epi32(_mm_loadu_si128(p + 0), 24);
+        __m128i a1 = _mm_srli_epi32(_mm_loadu_si128(p + 1), 24);
+        __m128i a2 = _mm_srli_epi32(_mm_loadu_si128(p + 2), 24);
+        __m128i a3 = _mm_srli_epi32(_mm_loadu_si128(p + 3), 24);
+        __m128i a = _mm_packus_epi16(_mm_packs_epi32(a0, a1), _mm_packs_epi32(a2, a3));
+        __m128i isZero = _mm_cmpeq_epi8(a, zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(outMask + i), _mm_andnot_si128(isZero, one));
+    }
+    if (i < count) { AlphaMaskScalar(rgba + static_cast<size_t>(i) * 4, count - i, outMask + i); }
+}
+
+void AndMaskSSE2(uint8_t* mask, const uint8_t* other, int count) {
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(other + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(mask + i), _mm_and_si128(a, b));
+    }
+    if (i < count) { AndMaskScalar(mask + i, other + i, count - i); }
+}
+
+void ScanMaskSSE2(const uint8_t* mask, int count, int& outCount, int& outFirst, int& outLast) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sums = _mm_setzero_si128();
+    outFirst = outLast = -1;
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask + i));
+        sums = _mm_add_epi64(sums, _mm_sad_epu8(v, zero)); // Bytes are 0/1, so the byte sum is the count
+        unsigned bits = static_cast<unsigned>(~_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero))) & 0xFFFFu;
+        if (!bits) continue;
+        if (outFirst < 0) { outFirst = i + LowestBit(bits); }
+        outLast = i + HighestBit(bits);
+    }
+    outCount = _mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+
+    if (i < count) {
+        int tailCount, tailFirst, tailLast;
+        ScanMaskScalar(mask + i, count - i, tailCount, tailFirst, tailLast);
+        outCount += tailCount;
+        if (tailCount > 0) {
+            if (outFirst < 0) { outFirst = i + tailFirst; }
+            outLast = i + tailLast;
+        }
+    }
+}
+
+#endif // MIRROR_FILTER_X86
+
+void AccumulateStatsRow(MirrorPixelStatsEntry& entry, int y, int count, int first, int last) {
+    if (count == 0) return;
+    if (entry.count == 0) {
+        entry.minX = first;
+        entry.maxX = last;
+        entry.minY = y;
+    } else {
+        entry.minX = (std::min)(entry.minX, first);
+        entry.maxX = (std::max)(entry.maxX, last);
+    }
+    entry.maxY = y;
+    entry.count += count;
+}
+
+// Nearest-neighbour texel index for a destination pixel plus an offset in destination pixels,
+// clamped to the texture (GL_NEAREST + GL_CLAMP_TO_EDGE on a full-texture quad).
+inline int NearestTexel(int dst, int offset, int dstSize, int srcSize) {
+    // floor(((dst + 0.5 + offset) / dstSize) * srcSize) in exact integer arithmetic
+    long long num = (2LL * (dst + offset) + 1) * srcSize;
+    long long den = 2LL * dstSize;
+    long long t = num >= 0 ? num / den : -((-num + den - 1) / den);
+    if (t < 0) return 0;
+    if (t >= srcSize) return srcSize - 1;
+    return static_cast<int>(t);
+}
+
+} // namespace
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+MirrorFilterKernel GetMirrorFilterKernel() {
+    int k = g_filterKernel.load(std::memory_order_relaxed);
+    if (k < 0) {
+        k = static_cast<int>(DetectBestKernel());
+        g_filterKernel.store(k, std::memory_order_relaxed);
+    }
+    return static_cast<MirrorFilterKernel>(k);
+}
+
+void SetMirrorFilterKernel(MirrorFilterKernel kernel) {
+    MirrorFilterKernel best = DetectBestKernel();
+    if (static_cast<int>(kernel) > static_cast<int>(best)) { kernel = best; }
+    g_filterKernel.store(static_cast<int>(kernel), std::memory_order_relaxed);
+}
+
+MirrorFilterMatcher BuildMirrorFilterMatcher(const MirrorFilterParams& params) {
+    MirrorFilterMatcher m;
+    m.gammaMode = params.gammaMode;
+    m.targetCount = static_cast<int>(params.targetColors.size());
+    m.targetsSRGB.reserve(params.targetColors.size() * 3);
+    m.targetsLinear.reserve(params.targetColors.size() * 3);
+    for (const auto& c : params.targetColors) {
+        m.targetsSRGB.push_back(c.r);
+        m.targetsSRGB.push_back(c.g);
+        m.targetsSRGB.push_back(c.b);
+        m.targetsLinear.push_back(MirrorFilterSRGBToLinear(c.r));
+        m.targetsLinear.push_back(MirrorFilterSRGBToLinear(c.g));
+        m.targetsLinear.push_back(MirrorFilterSRGBToLinear(c.b));
+    }
+    // dist < sensitivity can never hold for sensitivity <= 0, and squaring would flip the sign
+    m.matchNothing = (m.targetCount == 0 || params.sensitivity <= 0.0f);
+    m.sensitivitySq = params.sensitivity * params.sensitivity;
+    return m;
+}
+
+void MirrorFilterMatchPixels(const MirrorFilterMatcher& matcher, const uint8_t* rgba, int count, uint8_t* outMask) {
+    if (count <= 0) return;
+    if (matcher.matchNothing) {
+        memset(outMask, 0, static_cast<size_t>(count));
+        return;
+    }
+    if (matcher.lut) {
+        const MirrorMatchLut& lut = *matcher.lut;
+        for (int i = 0; i < count; i++) {
+            const uint8_t* p = rgba + static_cast<size_t>(i) * 4;
+            outMask[i] = lut.Test(p[0], p[1], p[2]) ? 1 : 0;
+        }
+        return;
+    }
+
+    switch (GetMirrorFilterKernel()) {
+#if MIRROR_FILTER_X86
+    case MirrorFilterKernel::AVX2:
+        MatchPixelsAVX2(matcher, rgba, count, outMask);
+        return;
+    case MirrorFilterKernel::SSE2:
+        MatchPixelsSSE2(matcher, rgba, count, outMask);
+        return;
+#endif
+    default:
+        MatchPixelsScalar(matcher, rgba, count, outMask);
+        return;
+    }
+}
+
+void MirrorFilterCapture(const MirrorFilterParams& params, const MirrorFilterMatcher& matcher, const MirrorFilterSource& defaultSource,
+                         const std::vector<MirrorFilterRegion>& regions, int captureW, int captureH, int padding,
+                         MirrorFilterImage& capture) {
+    // Pass 1 always starts from a transparent clear
+    std::fill(capture.pixels.begin(), capture.pixels.end(), static_cast<uint8_t>(0));
+    if (captureW <= 0 || captureH <= 0) return;
+
+    const uint8_t out[4] = { FloatToUnorm8(params.outputColor.r), FloatToUnorm8(params.outputColor.g), FloatToUnorm8(params.outputColor.b),
+                             FloatToUnorm8(params.outputColor.a) };
+
+    // Viewport is (padding, padding, captureW, captureH) - clip it to the capture image
+    const int rows = (std::min)(captureH, capture.height - padding);
+    const int cols = (std::min)(captureW, capture.width - padding);
+    if (rows <= 0 || cols <= 0) return;
+
+    std::vector<uint8_t> rowPixels(static_cast<size_t>(cols) * 4);
+    std::vector<uint8_t> rowMask(static_cast<size_t>(cols));
+
+    for (const auto& region : regions) {
+        const MirrorFilterSource& source = region.source ? *region.source : defaultSource;
+        if (!source.pixels || source.width <= 0 || source.height <= 0) continue;
+        const size_t srcStride = source.stride > 0 ? static_cast<size_t>(source.stride) : static_cast<size_t>(source.width) * 4;
+
+        for (int y = 0; y < rows; y++) {
+            int sy = (std::clamp)(region.y + y - source.originY, 0, source.height - 1);
+            const uint8_t* srcRow = source.pixels + sy * srcStride;
+
+            // Gather the (edge-clamped) source row into a contiguous buffer for the match kernel
+            int x0 = region.x - source.originX;
+            if (x0 >= 0 && x0 + cols <= source.width) {
+                memcpy(rowPixels.data(), srcRow + static_cast<size_t>(x0) * 4, static_cast<size_t>(cols) * 4);
+            } else {
+                for (int x = 0; x < cols; x++) {
+                    int sx = (std::clamp)(x0 + x, 0, source.width - 1);
+                    memcpy(&rowPixels[static_cast<size_t>(x) * 4], srcRow + static_cast<size_t>(sx) * 4, 4);
+                }
+            }
+
+            uint8_t* dstRow = &capture.pixels[(static_cast<size_t>(padding + y) * capture.width + padding) * 4];
+
+            if (params.rawOutput) {
+                // Straight copy, no blending (last region wins). The copy texture has alpha = 1.
+                for (int x = 0; x < cols; x++) {
+                    memcpy(dstRow + x * 4, &rowPixels[static_cast<size_t>(x) * 4], 3);
+                    dstRow[x * 4 + 3] = 255;
+                }
+                continue;
+            }
+
+            MirrorFilterMatchPixels(matcher, rowPixels.data(), cols, rowMask.data());
+
+            // Additive blending (GL_ONE, GL_ONE) of the filter output
+            for (int x = 0; x < cols; x++) {
+                if (!rowMask[x]) continue;
+                uint8_t* d = dstRow + x * 4;
+                if (params.colorPassthrough) {
+                    const uint8_t* s = &rowPixels[static_cast<size_t>(x) * 4];
+                    d[0] = AddSaturate(d[0], s[0]);
+                    d[1] = AddSaturate(d[1], s[1]);
+                    d[2] = AddSaturate(d[2], s[2]);
+                    d[3] = 255;
+                } else {
+                    d[0] = AddSaturate(d[0], out[0]);
+                    d[1] = AddSaturate(d[1], out[1]);
+                    d[2] = AddSaturate(d[2], out[2]);
+                    d[3] = AddSaturate(d[3], out[3]);
+                }
+            }
+        }
+    }
+}
+
+void MirrorFilterResolve(const MirrorFilterParams& params, const MirrorFilterImage& capture, int finalW, int finalH,
+                         MirrorFilterImage& finalImage) {
+    finalImage.Resize(finalW, finalH);
+    if (finalW <= 0 || finalH <= 0 || capture.width <= 0 || capture.height <= 0) return;
+
+    std::vector<int> texX(static_cast<size_t>(finalW));
+    std::vector<int> texY(static_cast<size_t>(finalH));
+    for (int x = 0; x < finalW; x++) { texX[x] = NearestTexel(x, 0, finalW, capture.width); }
+    for (int y = 0; y < finalH; y++) { texY[y] = NearestTexel(y, 0, finalH, capture.height); }
+
+    auto texel = [&](int tx, int ty) { return &capture.pixels[(static_cast<size_t>(ty) * capture.width + tx) * 4]; };
+
+    const bool dynamicBorder = !params.rawOutput && params.borderType == MirrorBorderType::Dynamic;
+    if (!dynamicBorder) {
+        // Raw output (opaque clear) and static border mode (transparent clear) are a plain nearest-neighbour copy
+        for (int y = 0; y < finalH; y++) {
+            uint8_t* dst = &finalImage.pixels[static_cast<size_t>(y) * finalW * 4];
+            for (int x = 0; x < finalW; x++) { memcpy(dst + x * 4, texel(texX[x], texY[y]), 4); }
+        }
+        return;
+    }
+
+    // Dynamic border: a pixel is "on" when its alpha > 0.5; off pixels with an on neighbour within
+    // +-borderWidth (in final-image pixels) get the border color. The square neighbourhood max is separable,
+    // so dilate horizontally and then vertically over a mask extended by the border width on each side.
+    const int bw = (std::max)(params.dynamicBorderThickness, 0);
+    const int extW = finalW + 2 * bw;
+    const int extH = finalH + 2 * bw;
+
+    std::vector<int> extTexX(static_cast<size_t>(extW));
+    std::vector<int> extTexY(static_cast<size_t>(extH));
+    for (int x = 0; x < extW; x++) { extTexX[x] = NearestTexel(x - bw, 0, finalW, capture.width); }
+    for (int y = 0; y < extH; y++) { extTexY[y] = NearestTexel(y - bw, 0, finalH, capture.height); }
+
+    // Horizontal pass: hmax[ey][x] = any on-pixel in row ey within [x - bw, x + bw]
+    std::vector<uint8_t> rowOn(static_cast<size_t>(extW));
+    std::vector<uint8_t> hmax(static_cast<size_t>(extH) * finalW);
+    for (int ey = 0; ey < extH; ey++) {
+        for (int ex = 0; ex < extW; ex++) { rowOn[ex] = texel(extTexX[ex], extTexY[ey])[3] > 127 ? 1 : 0; }
+        uint8_t* hrow = &hmax[static_cast<size_t>(ey) * finalW];
+        for (int x = 0; x < finalW; x++) {
+            uint8_t any = 0;
+            for (int k = 0; k <= 2 * bw && !any; k++) { any = rowOn[x + k]; }
+            hrow[x] = any;
+        }
+    }
+
+    const uint8_t outColor[4] = { FloatToUnorm8(params.outputColor.r), FloatToUnorm8(params.outputColor.g),
+                                  FloatToUnorm8(params.outputColor.b), FloatToUnorm8(params.outputColor.a) };
+    const uint8_t borderColor[4] = { FloatToUnorm8(params.borderColor.r), FloatToUnorm8(params.borderColor.g),
+                                     FloatToUnorm8(params.borderColor.b), FloatToUnorm8(params.borderColor.a) };
+
+    for (int y = 0; y < finalH; y++) {
+        uint8_t* dst = &finalImage.pixels[static_cast<size_t>(y) * finalW * 4];
+        for (int x = 0; x < finalW; x++) {
+            const uint8_t* t = texel(texX[x], texY[y]);
+            if (t[3] > 127) {
+                if (params.colorPassthrough) {
+                    dst[x * 4 + 0] = t[0];
+                    dst[x * 4 + 1] = t[1];
+                    dst[x * 4 + 2] = t[2];
+                    dst[x * 4 + 3] = 255;
+                } else {
+                    memcpy(dst + x * 4, outColor, 4);
+                }
+                continue;
+            }
+
+            uint8_t any = 0;
+            for (int k = 0; k <= 2 * bw && !any; k++) { any = hmax[static_cast<size_t>(y + k) * finalW + x]; }
+            if (any) { memcpy(dst + x * 4, borderColor, 4); }
+            // else: discarded fragment, stays transparent
+        }
+    }
+}
+
+bool MirrorFilterHasContent(const MirrorFilterImage& image) {
+    const size_t total = image.pixels.size();
+    for (size_t i = 3; i < total; i += 4) {
+        if (image.pixels[i] > 0) return true;
+    }
+    return false;
+}
+
+void MirrorFilterComputeStats(const MirrorFilterParams& params, const uint8_t* rgba, int width, int height, int stride,
+                              MirrorPixelStats& out) {
+    out.width = width;
+    out.height = height;
+    out.content = MirrorPixelStatsEntry{};
+    out.targets.assign(params.targetColors.size(), MirrorPixelStatsEntry{});
+    if (!rgba || width <= 0 || height <= 0) return;
+    const size_t rowStride = stride > 0 ? static_cast<size_t>(stride) : static_cast<size_t>(width) * 4;
+
+    // One single-target matcher per color, so every color gets its own count
+    std::vector<MirrorFilterMatcher> matchers;
+    matchers.reserve(params.targetColors.size());
+    MirrorFilterParams single = params;
+    for (const auto& c : params.targetColors) {
+        single.targetColors.assign(1, c);
+        matchers.push_back(BuildMirrorFilterMatcher(single));
+    }
+
+#if MIRROR_FILTER_X86
+    const bool simd = GetMirrorFilterKernel() != MirrorFilterKernel::Scalar;
+    auto alphaMask = simd ? AlphaMaskSSE2 : AlphaMaskScalar;
+    auto andMask = simd ? AndMaskSSE2 : AndMaskScalar;
+    auto scanMask = simd ? ScanMaskSSE2 : ScanMaskScalar;
+#else
+    auto alphaMask = AlphaMaskScalar;
+    auto andMask = AndMaskScalar;
+    auto scanMask = ScanMaskScalar;
+#endif
+
+    std::vector<uint8_t> contentMask(static_cast<size_t>(width));
+    std::vector<uint8_t> targetMask(static_cast<size_t>(width));
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = rgba + y * rowStride;
+        int count, first, last;
+
+        alphaMask(row, width, contentMask.data());
+        scanMask(contentMask.data(), width, count, first, last);
+        AccumulateStatsRow(out.content, y, count, first, last);
+        if (count == 0) continue; // Only visible pixels can match a target
+
+        for (size_t t = 0; t < matchers.size(); t++) {
+            MirrorFilterMatchPixels(matchers[t], row, width, targetMask.data());
+            andMask(targetMask.data(), contentMask.data(), width);
+            scanMask(targetMask.data(), width, count, first, last);
+            AccumulateStatsRow(out.targets[t], y, count, first, last);
+        }
+    }
+}
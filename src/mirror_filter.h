@@ -0,0 +1,136 @@
+#pragma once
+
+// ============================================================================
+// MIRROR_FILTER.H - CPU implementation of the mirror color-filter pipeline
+// ============================================================================
+// Mirrors the semantics of the mirror thread's GLSL programs on plain RGBA8 buffers:
+//   Pass 1 (mt_filter_frag_shader / mt_filter_passthrough_frag_shader / mt_passthrough_frag_shader):
+//     sample each input region from the game frame, test against the target colors and
+//     accumulate into the mirror's capture image (additive, like GL_ONE/GL_ONE blending).
+//   Pass 2 (mt_render_frag_shader / mt_render_passthrough_frag_shader / mt_background_frag_shader):
+//     resolve the capture image into the screen-ready final image, drawing the dynamic border.
+//
+// Used by the mirror CPU fallback (when no shared GL context is available for the capture
+// thread) and as a reference implementation for the GPU path.
+//
+// All images are tightly packed RGBA8 and stored bottom-up (row 0 = bottom), like GL textures.
+// ============================================================================
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Need gui.h for Color, MirrorGammaMode and MirrorBorderType
+#include "gui.h"
+
+// Everything needed to filter one mirror (same fields the mirror thread reads from ThreadedMirrorConfig)
+struct MirrorFilterParams {
+    std::vector<Color> targetColors;
+    Color outputColor;
+    Color borderColor;
+    float sensitivity = 0.0f;
+    MirrorGammaMode gammaMode = MirrorGammaMode::Auto;
+    bool rawOutput = false;
+    bool colorPassthrough = false;
+    MirrorBorderType borderType = MirrorBorderType::Dynamic;
+    int dynamicBorderThickness = 0;
+};
+
+// Read-only view of (a window of) the game frame.
+// originX/originY give the position of pixels[0] inside the full game frame, so a caller can read back
+// only the part of the frame it needs. Samples outside the window are clamped to its edges, which matches
+// GL_CLAMP_TO_EDGE as long as the window covers the requested region clipped to the game frame.
+struct MirrorFilterSource {
+    const uint8_t* pixels = nullptr;
+    int width = 0, height = 0;
+    int stride = 0; // Bytes per row (0 = width * 4)
+    int originX = 0, originY = 0;
+};
+
+// A capture region in GL (bottom-up) game-frame coordinates
+struct MirrorFilterRegion {
+    int x = 0, y = 0;
+    const MirrorFilterSource* source = nullptr; // Window to sample this region from (nullptr = the capture's source)
+};
+
+struct MirrorFilterImage {
+    std::vector<uint8_t> pixels;
+    int width = 0, height = 0;
+
+    void Resize(int w, int h) {
+        width = w;
+        height = h;
+        pixels.assign(static_cast<size_t>(w) * h * 4, 0);
+    }
+};
+
+struct MirrorMatchLut; // mirror_match_lut.h
+
+// Which kernel MirrorFilterMatchPixels dispatches to
+enum class MirrorFilterKernel { Scalar, SSE2, AVX2 };
+
+// Pre-computed per-mirror match state (linearized targets, squared sensitivity).
+// Building it once per config change keeps the per-pixel path free of pow() calls.
+struct MirrorFilterMatcher {
+    std::vector<float> targetsSRGB;   // r,g,b triples
+    std::vector<float> targetsLinear; // r,g,b triples
+    int targetCount = 0;
+    float sensitivitySq = 0.0f;
+    bool matchNothing = true; // No targets or sensitivity <= 0
+    MirrorGammaMode gammaMode = MirrorGammaMode::Auto;
+
+    // Optional precomputed table for these targets. When set, matching is one lookup per pixel.
+    std::shared_ptr<const MirrorMatchLut> lut;
+};
+
+// Build the matcher for a set of filter parameters
+MirrorFilterMatcher BuildMirrorFilterMatcher(const MirrorFilterParams& params);
+
+// Same formula as SRGBToLinear() in the mirror shaders
+float MirrorFilterSRGBToLinear(float c);
+
+// Kernel used for this CPU (AVX2 if available, then SSE2, then scalar)
+MirrorFilterKernel GetMirrorFilterKernel();
+
+// Force a specific kernel (clamped to what the CPU supports). Intended for comparing kernels.
+void SetMirrorFilterKernel(MirrorFilterKernel kernel);
+
+// Test `count` RGBA8 pixels against the matcher, writing 1 (match) or 0 (no match) per pixel to outMask.
+void MirrorFilterMatchPixels(const MirrorFilterMatcher& matcher, const uint8_t* rgba, int count, uint8_t* outMask);
+
+// Pass 1: render all input regions of a mirror into `capture` (fbo_w x fbo_h, cleared first).
+// captureW/H is the capture size of each region; padding is the dynamic border padding.
+// defaultSource is sampled by regions that don't carry their own source window.
+void MirrorFilterCapture(const MirrorFilterParams& params, const MirrorFilterMatcher& matcher, const MirrorFilterSource& defaultSource,
+                         const std::vector<MirrorFilterRegion>& regions, int captureW, int captureH, int padding,
+                         MirrorFilterImage& capture);
+
+// Pass 2: resolve the capture image into the final screen-ready image (finalW x finalH).
+void MirrorFilterResolve(const MirrorFilterParams& params, const MirrorFilterImage& capture, int finalW, int finalH,
+                         MirrorFilterImage& finalImage);
+
+// Returns true if any pixel in the image has non-zero alpha (same test as the content-detection readback)
+bool MirrorFilterHasContent(const MirrorFilterImage& image);
+
+// Matched-pixel count and bounding box (inclusive, image coordinates, bottom-up rows)
+struct MirrorPixelStatsEntry {
+    int count = 0;
+    int minX = 0, minY = 0;
+    int maxX = -1, maxY = -1;
+
+    bool Empty() const { return count == 0; }
+};
+
+struct MirrorPixelStats {
+    int width = 0, height = 0;
+    MirrorPixelStatsEntry content;              // Pixels with non-zero alpha (everything a filter mirror drew)
+    std::vector<MirrorPixelStatsEntry> targets; // One per params.targetColors entry, visible pixels only
+};
+
+// Pixel statistics of an RGBA8 image (e.g. a mirror's capture image read back from the GPU).
+// Target colors are matched with the same rules (sensitivity, gamma mode) as the filter, one color at a time.
+// Filter mirrors draw every match in the output color, so for them only `content` is meaningful;
+// raw and color-passthrough mirrors keep the game colors and get per-target counts.
+// stride is the number of bytes per row (0 = width * 4). Row scanning uses SSE2 unless the scalar kernel is forced.
+void MirrorFilterComputeStats(const MirrorFilterParams& params, const uint8_t* rgba, int width, int height, int stride,
+                              MirrorPixelStats& out);
@@ -0,0 +1,208 @@
+// ============================================================================
+// MIRROR_MATCH_LUT.CPP - Color-match table builder
+// ============================================================================
+
+#include "mirror_match_lut.h"
+
+#include <cstring>
+
+MirrorMatchLutKey MakeMirrorMatchLutKey(const std::vector<Color>& targetColors, float sensitivity, MirrorGammaMode gammaMode) {
+    MirrorMatchLutKey key;
+    key.targets.reserve(targetColors.size() * 3);
+    for (const auto& c : targetColors) {
+        key.targets.push_back(c.r);
+        key.targets.push_back(c.g);
+        key.targets.push_back(c.b);
+    }
+    key.sensitivity = sensitivity;
+    key.gammaMode = gammaMode;
+
+    // FNV-1a over the raw bytes of everything that affects the table
+    uint64_t h = 1469598103934665603ULL;
+    auto mix = [&h](const void* data, size_t size) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            h ^= p[i];
+            h *= 1099511628211ULL;
+        }
+    };
+    int mode = static_cast<int>(gammaMode);
+    mix(&mode, sizeof(mode));
+    mix(&sensitivity, sizeof(sensitivity));
+    if (!key.targets.empty()) { mix(key.targets.data(), key.targets.size() * sizeof(float)); }
+    key.hash = h;
+    return key;
+}
+
+void BuildMirrorMatchLut(const MirrorMatchLutKey& key, MirrorMatchLut& out) {
+    auto start = std::chrono::steady_clock::now();
+
+    out.key = key;
+    out.words.assign(MIRROR_MATCH_LUT_WORDS, 0u);
+    out.empty = true;
+
+    const int targetCount = static_cast<int>(key.targets.size() / 3);
+    if (targetCount == 0 || key.sensitivity <= 0.0f) {
+        out.buildTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return;
+    }
+
+    float srgb[256], linear[256];
+    for (int i = 0; i < 256; i++) {
+        srgb[i] = static_cast<float>(i) / 255.0f;
+        linear[i] = MirrorFilterSRGBToLinear(srgb[i]);
+    }
+
+    const float sensSq = key.sensitivity * key.sensitivity;
+    auto within = [sensSq](float a, float b) {
+        float d = a - b;
+        return d * d < sensSq;
+    };
+
+    std::vector<uint8_t> candR, candG, candB;
+    std::vector<uint8_t> rowPixels;
+    std::vector<uint8_t> rowMask;
+    candR.reserve(256);
+    candG.reserve(256);
+    candB.reserve(256);
+    rowPixels.reserve(256 * 4);
+    rowMask.reserve(256);
+
+    for (int t = 0; t < targetCount; t++) {
+        // Single-target matcher so each box is only tested against the target it came from
+        MirrorFilterMatcher matcher;
+        matcher.gammaMode = key.gammaMode;
+        matcher.targetCount = 1;
+        matcher.sensitivitySq = sensSq;
+        matcher.matchNothing = false;
+        for (int ch = 0; ch < 3; ch++) {
+            float c = key.targets[t * 3 + ch];
+            matcher.targetsSRGB.push_back(c);
+            matcher.targetsLinear.push_back(MirrorFilterSRGBToLinear(c));
+        }
+
+        // A squared distance below sensitivity^2 needs every per-channel term below it as well,
+        // so each channel only has to visit the values that pass the per-channel test.
+        auto collect = [&](int ch, std::vector<uint8_t>& cand) {
+            cand.clear();
+            const float tS = matcher.targetsSRGB[ch];
+            const float tL = matcher.targetsLinear[ch];
+            for (int v = 0; v < 256; v++) {
+                bool ok;
+                if (key.gammaMode == MirrorGammaMode::AssumeLinear) {
+                    ok = within(srgb[v], tL);
+                } else if (key.gammaMode == MirrorGammaMode::AssumeSRGB) {
+                    ok = within(linear[v], tL);
+                } else {
+                    ok = within(srgb[v], tS) || within(linear[v], tL);
+                }
+                if (ok) { cand.push_back(static_cast<uint8_t>(v)); }
+            }
+        };
+        collect(0, candR);
+        collect(1, candG);
+        collect(2, candB);
+        if (candR.empty() || candG.empty() || candB.empty()) continue;
+
+        const int nb = static_cast<int>(candB.size());
+        rowPixels.assign(static_cast<size_t>(nb) * 4, 255);
+        rowMask.assign(static_cast<size_t>(nb), 0);
+        for (int i = 0; i < nb; i++) { rowPixels[static_cast<size_t>(i) * 4 + 2] = candB[i]; }
+
+        for (uint8_t r : candR) {
+            for (uint8_t g : candG) {
+                for (int i = 0; i < nb; i++) {
+                    rowPixels[static_cast<size_t>(i) * 4 + 0] = r;
+                    rowPixels[static_cast<size_t>(i) * 4 + 1] = g;
+                }
+                MirrorFilterMatchPixels(matcher, rowPixels.data(), nb, rowMask.data());
+
+                const uint32_t base = (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8);
+                for (int i = 0; i < nb; i++) {
+                    if (!rowMask[i]) continue;
+                    uint32_t idx = base | candB[i];
+                    out.words[idx >> 5] |= (1u << (idx & 31));
+                    out.empty = false;
+                }
+            }
+        }
+    }
+
+    out.buildTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::shared_ptr<const MirrorMatchLut> MirrorMatchLutCache::Get(const MirrorMatchLutKey& key, bool* wasBuilt, bool skipSettle) {
+    if (wasBuilt) { *wasBuilt = false; }
+
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        // Move to front (most recently used)
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        return *it->second;
+    }
+
+    if (m_settleMs > 0 && !skipSettle) {
+        auto now = std::chrono::steady_clock::now();
+        auto pendingIt = m_pending.find(key);
+        if (pendingIt == m_pending.end()) {
+            // Forget keys that never settled before remembering this one
+            for (auto p = m_pending.begin(); p != m_pending.end();) {
+                if (now - p->second > std::chrono::milliseconds(m_settleMs * 4)) {
+                    p = m_pending.erase(p);
+                } else {
+                    ++p;
+                }
+            }
+            m_pending.emplace(key, now);
+            return nullptr;
+        }
+        if (now - pendingIt->second < std::chrono::milliseconds(m_settleMs)) return nullptr;
+        m_pending.erase(pendingIt);
+    }
+
+    auto lut = std::make_shared<MirrorMatchLut>();
+    BuildMirrorMatchLut(key, *lut);
+    if (wasBuilt) { *wasBuilt = true; }
+
+    m_lru.push_front(lut);
+    m_entries[key] = m_lru.begin();
+
+    while (m_entries.size() > m_maxEntries && !m_lru.empty()) {
+        m_entries.erase(m_lru.back()->key);
+        m_lru.pop_back();
+    }
+    return lut;
+}
+
+void MirrorMatchLutCache::Clear() {
+    m_entries.clear();
+    m_lru.clear();
+    m_pending.clear();
+}
+
+MirrorFilterMatcherCache::Entry& MirrorFilterMatcherCache::Get(MirrorHandle handle, const MirrorFilterParams& params, bool* wasBuilt) {
+    if (wasBuilt) { *wasBuilt = false; }
+    Entry* entry = &m_scratch;
+    if (handle.IsValid()) {
+        if (handle.index >= m_entries.size()) { m_entries.resize(handle.index + 1); }
+        entry = &m_entries[handle.index];
+    }
+
+    const std::vector<float>& targets = entry->lutKey.targets;
+    bool current = entry != &m_scratch && entry->valid && entry->generation == handle.generation &&
+                   entry->sensitivity == params.sensitivity && entry->lutKey.gammaMode == params.gammaMode &&
+                   targets.size() == params.targetColors.size() * 3;
+    for (size_t i = 0; current && i < params.targetColors.size(); i++) {
+        const Color& c = params.targetColors[i];
+        current = targets[i * 3] == c.r && targets[i * 3 + 1] == c.g && targets[i * 3 + 2] == c.b;
+    }
+    if (current) return *entry;
+
+    entry->generation = handle.generation;
+    entry->valid = true;
+    entry->sensitivity = params.sensitivity;
+    entry->matcher = BuildMirrorFilterMatcher(params);
+    entry->lutKey = MakeMirrorMatchLutKey(params.targetColors, params.sensitivity, params.gammaMode);
+    if (wasBuilt) { *wasBuilt = true; }
+    return *entry;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+// ============================================================================
+// MIRROR_MATCH_LUT.H - Precomputed color-match table for mirror filtering
+// ============================================================================
+// The captured game texture is RGBA8, so the whole "does this pixel match any target color"
+// question has only 2^24 possible inputs. The table stores one bit per RGB value and is rebuilt
+// only when a mirror's target colors, sensitivity or the global gamma mode change.
+// The per-pixel test then becomes a single lookup, both in the mirror shaders and on the CPU.
+//
+// GPU layout: the 2^19 32-bit words are uploaded as one GL_R32UI layer of
+// MIRROR_MATCH_LUT_TEXTURE_WIDTH x MIRROR_MATCH_LUT_TEXTURE_HEIGHT texels.
+// ============================================================================
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "mirror_filter.h"
+#include "mirror_registry.h"
+
+#define MIRROR_MATCH_LUT_WORDS ((1 << 24) / 32)
+#define MIRROR_MATCH_LUT_TEXTURE_WIDTH 1024
+#define MIRROR_MATCH_LUT_TEXTURE_HEIGHT (MIRROR_MATCH_LUT_WORDS / MIRROR_MATCH_LUT_TEXTURE_WIDTH)
+
+// Identifies the inputs a table was built from
+struct MirrorMatchLutKey {
+    std::vector<float> targets; // r,g,b triples (sRGB, as configured)
+    float sensitivity = 0.0f;
+    MirrorGammaMode gammaMode = MirrorGammaMode::Auto;
+    uint64_t hash = 0;
+
+    bool operator==(const MirrorMatchLutKey& other) const {
+        return hash == other.hash && sensitivity == other.sensitivity && gammaMode == other.gammaMode && targets == other.targets;
+    }
+};
+
+struct MirrorMatchLutKeyHasher {
+    size_t operator()(const MirrorMatchLutKey& key) const { return static_cast<size_t>(key.hash); }
+};
+
+MirrorMatchLutKey MakeMirrorMatchLutKey(const std::vector<Color>& targetColors, float sensitivity, MirrorGammaMode gammaMode);
+
+struct MirrorMatchLut {
+    std::vector<uint32_t> words; // MIRROR_MATCH_LUT_WORDS entries, bit (r << 16 | g << 8 | b)
+    MirrorMatchLutKey key;
+    bool empty = true;           // No bit set - every pixel is rejected
+    double buildTimeMs = 0.0;
+
+    bool Test(uint8_t r, uint8_t g, uint8_t b) const {
+        uint32_t idx = (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) | b;
+        return (words[idx >> 5] >> (idx & 31)) & 1u;
+    }
+};
+
+// Build the table for a key. Only the RGB boxes that can possibly be within `sensitivity` of a target
+// are evaluated (with the same arithmetic as MirrorFilterMatchPixels), so small sensitivities build in a few
+// milliseconds. Worst case (sensitivity >= 1) evaluates the full cube once per target.
+void BuildMirrorMatchLut(const MirrorMatchLutKey& key, MirrorMatchLut& out);
+
+// Small LRU of built tables, shared between mirrors with identical match settings.
+// With a non-zero settle time, a key has to be requested continuously for that long before its table is
+// built (Get() returns nullptr until then), so dragging a color or sensitivity slider doesn't rebuild
+// the table every frame. Callers use the per-pixel matcher meanwhile.
+// Not thread-safe: each thread that filters mirrors keeps its own cache.
+class MirrorMatchLutCache {
+  public:
+    explicit MirrorMatchLutCache(size_t maxEntries = 16, int settleMs = 0) : m_maxEntries(maxEntries), m_settleMs(settleMs) {}
+
+    // Returns the table for the key, building it if needed. wasBuilt is set when a build happened.
+    // skipSettle builds immediately, for callers that have no per-pixel fallback for this key.
+    std::shared_ptr<const MirrorMatchLut> Get(const MirrorMatchLutKey& key, bool* wasBuilt = nullptr, bool skipSettle = false);
+
+    void Clear();
+    size_t Size() const { return m_entries.size(); }
+
+  private:
+    using LruList = std::list<std::shared_ptr<const MirrorMatchLut>>;
+
+    size_t m_maxEntries;
+    int m_settleMs;
+    LruList m_lru; // Most recently used first
+    std::unordered_map<MirrorMatchLutKey, LruList::iterator, MirrorMatchLutKeyHasher> m_entries;
+    std::unordered_map<MirrorMatchLutKey, std::chrono::steady_clock::time_point, MirrorMatchLutKeyHasher> m_pending; // First request
+};
+
+// Matchers of the mirrors a thread filters on the CPU, indexed by MirrorHandle::index. A slot's matcher and
+// table key are rebuilt only when the mirror's target colors, sensitivity or the gamma mode change, or the slot
+// is handed to a different mirror; the table itself still comes from a MirrorMatchLutCache.
+// Not thread-safe, like MirrorMatchLutCache.
+class MirrorFilterMatcherCache {
+  public:
+    struct Entry {
+        uint32_t generation = 0;
+        bool valid = false;
+        float sensitivity = 0.0f; // As configured; the matcher only keeps its square
+        MirrorFilterMatcher matcher;
+        MirrorMatchLutKey lutKey;
+    };
+
+    // The slot's entry for these params, rebuilt if their match settings differ. wasBuilt is set when a build
+    // happened. Invalid handles get a scratch entry that is rebuilt on every call.
+    Entry& Get(MirrorHandle handle, const MirrorFilterParams& params, bool* wasBuilt = nullptr);
+
+    void Clear() { m_entries.clear(); }
+
+  private:
+    std::vector<Entry> m_entries;
+    Entry m_scratch;
+};
@@ -0,0 +1,199 @@
+#pragma once
+
+// ============================================================================
+// MIRROR_REGISTRY.H - Dense handles and slot-map storage for mirrors
+// ============================================================================
+// Mirrors are configured by name, but the per-frame paths (capture thread, buffer swap, config
+// write-back) should not hash or compare strings. MirrorSlotMap gives every name a small integer
+// slot the first time it is seen and keeps it until the entry is erased; freed slots are reused,
+// so indices stay dense. A MirrorHandle carries the slot index plus the slot's generation, which
+// lets holders of an old handle detect that the slot has since been reused.
+//
+// Slots live in a std::deque so references stay valid while other mirrors are added
+// (the capture thread keeps MirrorInstance* across lock scopes, like it did with the node-based map).
+//
+// Not thread-safe: callers guard each map with its own mutex (g_mirrorInstancesMutex for g_mirrorInstances).
+// ============================================================================
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct MirrorHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return index != UINT32_MAX; }
+    bool operator==(const MirrorHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const MirrorHandle& other) const { return !(*this == other); }
+};
+
+// Name-keyed map with stable dense slots. Iteration visits occupied slots in slot order and yields
+// std::pair<std::string, T>, so it is a drop-in for the unordered_map<std::string, T> it replaces.
+template <typename T> class MirrorSlotMap {
+  public:
+    using value_type = std::pair<std::string, T>;
+
+  private:
+    struct Slot {
+        value_type entry;
+        uint32_t generation = 0;
+        bool named = false;    // Name registered (via Acquire or insertion)
+        bool occupied = false; // Holds a value (visible to find/iteration)
+    };
+
+    template <bool Const> class IteratorBase {
+      public:
+        using SlotDeque = std::conditional_t<Const, const std::deque<Slot>, std::deque<Slot>>;
+        using reference = std::conditional_t<Const, const value_type&, value_type&>;
+        using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+
+        IteratorBase(SlotDeque* slots, size_t index) : m_slots(slots), m_index(index) { SkipFree(); }
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        IteratorBase(const IteratorBase<false>& other) : m_slots(other.m_slots), m_index(other.m_index) {}
+
+        reference operator*() const { return (*m_slots)[m_index].entry; }
+        pointer operator->() const { return &(*m_slots)[m_index].entry; }
+        IteratorBase& operator++() {
+            m_index++;
+            SkipFree();
+            return *this;
+        }
+        bool operator==(const IteratorBase& other) const { return m_index == other.m_index; }
+        bool operator!=(const IteratorBase& other) const { return m_index != other.m_index; }
+
+        MirrorHandle Handle() const { return { static_cast<uint32_t>(m_index), (*m_slots)[m_index].generation }; }
+
+      private:
+        friend class MirrorSlotMap;
+        friend class IteratorBase<true>;
+
+        void SkipFree() {
+            while (m_index < m_slots->size() && !(*m_slots)[m_index].occupied) { m_index++; }
+        }
+
+        SlotDeque* m_slots;
+        size_t m_index;
+    };
+
+  public:
+    using iterator = IteratorBase<false>;
+    using const_iterator = IteratorBase<true>;
+
+    iterator begin() { return iterator(&m_slots, 0); }
+    iterator end() { return iterator(&m_slots, m_slots.size()); }
+    const_iterator begin() const { return const_iterator(&m_slots, 0); }
+    const_iterator end() const { return const_iterator(&m_slots, m_slots.size()); }
+
+    // Handle of the name's slot, registering the name (without a value) if it has none yet.
+    // Used when configs are published, so the capture thread can index instances created later.
+    MirrorHandle Acquire(const std::string& name) {
+        auto it = m_byName.find(name);
+        if (it != m_byName.end()) return { it->second, m_slots[it->second].generation };
+
+        uint32_t index;
+        if (!m_free.empty()) {
+            index = m_free.back();
+            m_free.pop_back();
+        } else {
+            index = static_cast<uint32_t>(m_slots.size());
+            m_slots.emplace_back();
+        }
+        Slot& slot = m_slots[index];
+        slot.entry.first = name;
+        slot.named = true;
+        m_byName.emplace(name, index);
+        return { index, slot.generation };
+    }
+
+    // Handle of the name's slot, or an invalid handle if the name was never registered
+    MirrorHandle HandleOf(const std::string& name) const {
+        auto it = m_byName.find(name);
+        if (it == m_byName.end()) return {};
+        return { it->second, m_slots[it->second].generation };
+    }
+
+    // Direct slot access - the per-frame path. Returns nullptr for stale handles and empty slots.
+    T* Get(MirrorHandle handle) {
+        if (handle.index >= m_slots.size()) return nullptr;
+        Slot& slot = m_slots[handle.index];
+        return (slot.occupied && slot.generation == handle.generation) ? &slot.entry.second : nullptr;
+    }
+    const T* Get(MirrorHandle handle) const { return const_cast<MirrorSlotMap*>(this)->Get(handle); }
+
+    iterator find(const std::string& name) {
+        auto it = m_byName.find(name);
+        if (it == m_byName.end() || !m_slots[it->second].occupied) return end();
+        return iterator(&m_slots, it->second);
+    }
+    const_iterator find(const std::string& name) const { return const_cast<MirrorSlotMap*>(this)->find(name); }
+
+    T& operator[](const std::string& name) {
+        Slot& slot = m_slots[Acquire(name).index];
+        if (!slot.occupied) {
+            slot.occupied = true;
+            m_size++;
+        }
+        return slot.entry.second;
+    }
+
+    // Moves the entry (and its slot) to a new name. Fails if newName already has a value.
+    bool Rename(const std::string& oldName, const std::string& newName) {
+        auto it = m_byName.find(oldName);
+        if (it == m_byName.end()) return false;
+        if (oldName == newName) return true;
+        auto existing = m_byName.find(newName);
+        if (existing != m_byName.end()) {
+            if (m_slots[existing->second].occupied) return false;
+            Release(existing->second);
+        }
+        uint32_t index = it->second;
+        m_byName.erase(oldName);
+        m_byName.emplace(newName, index);
+        m_slots[index].entry.first = newName;
+        return true;
+    }
+
+    void erase(iterator it) {
+        if (it.m_index < m_slots.size()) { Release(static_cast<uint32_t>(it.m_index)); }
+    }
+    void erase(const std::string& name) {
+        auto it = m_byName.find(name);
+        if (it != m_byName.end()) { Release(it->second); }
+    }
+
+    // Drops every entry and registration. Generations keep counting so old handles stay stale.
+    void clear() {
+        for (uint32_t i = 0; i < m_slots.size(); i++) {
+            if (m_slots[i].named) { Release(i); }
+        }
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    // Number of slots ever allocated - per-slot side tables (e.g. mirror-thread FBOs) are sized to this
+    size_t SlotCount() const { return m_slots.size(); }
+
+  private:
+    void Release(uint32_t index) {
+        Slot& slot = m_slots[index];
+        if (!slot.named) return;
+        m_byName.erase(slot.entry.first);
+        if (slot.occupied) { m_size--; }
+        slot.entry.first.clear();
+        slot.entry.second = T{};
+        slot.named = false;
+        slot.occupied = false;
+        slot.generation++;
+        m_free.push_back(index);
+    }
+
+    std::deque<Slot> m_slots;
+    std::unordered_map<std::string, uint32_t> m_byName;
+    std::vector<uint32_t> m_free;
+    size_t m_size = 0;
+};
@@ -0,0 +1,65 @@
+// ============================================================================
+// MIRROR_SCHEDULER.CPP - Per-mirror update scheduling
+// ============================================================================
+
+#include "mirror_scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+int64_t ToNs(MirrorUpdateScheduler::TimePoint t) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+// Frames arrive with some jitter; a due time this close ahead still counts, so a 30 FPS mirror on a
+// 60 Hz game isn't pushed to every third frame by a few microseconds.
+int64_t SlackNs(int64_t intervalNs) { return (std::min)(intervalNs / 8, static_cast<int64_t>(2000000)); }
+
+} // namespace
+
+double MirrorUpdateScheduler::PhaseFraction(uint32_t slotIndex) {
+    double f = static_cast<double>(slotIndex) * 0.6180339887498949;
+    return f - std::floor(f);
+}
+
+MirrorUpdateScheduler::Entry& MirrorUpdateScheduler::At(MirrorHandle handle) {
+    if (handle.index >= m_entries.size()) { m_entries.resize(handle.index + 1); }
+    Entry& e = m_entries[handle.index];
+    if (e.generation != handle.generation) { e = Entry{ handle.generation }; }
+    return e;
+}
+
+int64_t MirrorUpdateScheduler::NextGridPoint(const Entry& e, int64_t afterNs) const {
+    // Grid points are phaseNs + k * intervalNs; return the first one strictly after afterNs + slack
+    int64_t t = afterNs + SlackNs(e.intervalNs) - e.phaseNs;
+    int64_t k = t / e.intervalNs;
+    if (t % e.intervalNs != 0 && t < 0) { k--; } // floor division
+    return e.phaseNs + (k + 1) * e.intervalNs;
+}
+
+bool MirrorUpdateScheduler::IsDue(MirrorHandle handle, int fps, TimePoint now) {
+    if (fps <= 0) return true;
+
+    Entry& e = At(handle);
+    const int64_t nowNs = ToNs(now);
+    if (!e.known || e.fps != fps) {
+        const int oldFps = e.known ? e.fps : 0;
+        e.fps = fps;
+        e.intervalNs = 1000000000LL / fps;
+        e.phaseNs = static_cast<int64_t>(PhaseFraction(handle.index) * static_cast<double>(e.intervalNs));
+        // New mirror or a raised cap: due now. Lowered cap: continue from the last update on the new grid.
+        e.nextDueNs = (e.known && e.updated && fps < oldFps) ? NextGridPoint(e, e.lastUpdateNs) : nowNs;
+        e.known = true;
+    }
+    return nowNs + SlackNs(e.intervalNs) >= e.nextDueNs;
+}
+
+void MirrorUpdateScheduler::MarkUpdated(MirrorHandle handle, TimePoint now) {
+    Entry& e = At(handle);
+    const int64_t nowNs = ToNs(now);
+    e.lastUpdateNs = nowNs;
+    e.updated = true;
+    if (e.known && e.intervalNs > 0) { e.nextDueNs = NextGridPoint(e, nowNs); }
+}
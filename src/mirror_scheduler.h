@@ -0,0 +1,57 @@
+#pragma once
+
+// ============================================================================
+// MIRROR_SCHEDULER.H - Per-mirror update scheduling for FPS-capped mirrors
+// ============================================================================
+// The capture thread wakes once per game frame. A mirror with an FPS cap is updated on a fixed grid of
+// due times (one interval apart) instead of "interval since the last update", so frame quantization
+// doesn't stretch its period, and every mirror's grid is shifted by a phase derived from its slot
+// index. Mirrors sharing a cap therefore land on different game frames and the per-frame work stays
+// flat instead of spiking on every Nth frame.
+//
+// The policy only depends on the slot index and the time points passed in, so it is deterministic and
+// can be driven by a fake clock.
+// ============================================================================
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "mirror_registry.h"
+
+class MirrorUpdateScheduler {
+  public:
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+
+    // True if the mirror should be updated in the frame observed at `now`.
+    // fps <= 0 means uncapped (due every frame). A mirror seen for the first time, or whose cap was raised,
+    // is due immediately so new content shows up without waiting for its phase.
+    bool IsDue(MirrorHandle handle, int fps, TimePoint now);
+
+    // Record an update; the next due time is the first grid point after `now`.
+    void MarkUpdated(MirrorHandle handle, TimePoint now);
+
+    void Clear() { m_entries.clear(); }
+
+    // Phase of a slot as a fraction of the interval (golden-ratio sequence, so any number of mirrors
+    // with the same cap is spread roughly evenly).
+    static double PhaseFraction(uint32_t slotIndex);
+
+  private:
+    struct Entry {
+        uint32_t generation = 0;
+        bool known = false;
+        int fps = 0;
+        int64_t intervalNs = 0;
+        int64_t phaseNs = 0;
+        int64_t nextDueNs = 0;
+        int64_t lastUpdateNs = 0;
+        bool updated = false; // lastUpdateNs is valid
+    };
+
+    Entry& At(MirrorHandle handle);
+    int64_t NextGridPoint(const Entry& e, int64_t afterNs) const;
+
+    std::vector<Entry> m_entries; // Indexed by MirrorHandle::index
+};
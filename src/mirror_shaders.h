@@ -0,0 +1,432 @@
+#pragma once
+
+// ============================================================================
+// MIRROR_SHADERS.H - GLSL sources of the mirror capture thread's programs
+// ============================================================================
+// Kept apart from mirror_thread.cpp so the headless GL tests (tests/) compile exactly the shaders the
+// capture thread uses. Only mirror_thread.cpp includes this in the DLL.
+// ============================================================================
+
+// Vertex shader (shared by all fragment shaders)
+static const char* const mt_passthrough_vert_shader = R"(#version 330 core
+layout(location = 0) in vec2 aPos;
+layout(location = 1) in vec2 aTexCoord;
+out vec2 TexCoord;
+void main() {
+    gl_Position = vec4(aPos, 0.0, 1.0);
+    TexCoord = aTexCoord;
+})";
+
+// Size of u_targetColors in the per-pixel loop filter shaders. Mirrors with more target colors always go
+// through the match-table shaders, whose cost doesn't depend on the number of colors.
+static constexpr int MT_MAX_LOOP_TARGET_COLORS = 32;
+
+// Filter shader - applies color filter to captured content (supports multiple target colors)
+static const char* const mt_filter_frag_shader = R"(#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+uniform sampler2D screenTexture;
+uniform vec4 u_sourceRect;
+uniform int u_gammaMode;       // 0=Auto, 1=Assume sRGB, 2=Assume Linear
+uniform vec3 u_targetColors[32]; // MT_MAX_LOOP_TARGET_COLORS - larger sets use the match table
+uniform int u_targetColorCount;  // Number of active target colors
+uniform vec4 outputColor;
+uniform float u_sensitivity;
+
+vec3 SRGBToLinear(vec3 c) {
+    bvec3 cutoff = lessThanEqual(c, vec3(0.04045));
+    vec3 low = c / 12.92;
+    vec3 high = pow((c + 0.055) / 1.055, vec3(2.4));
+    return mix(high, low, vec3(cutoff));
+}
+void main() {
+    vec2 srcCoord = u_sourceRect.xy + TexCoord * u_sourceRect.zw;
+    vec3 screenColor = texture(screenTexture, srcCoord).rgb;
+    vec3 screenColorLinear = SRGBToLinear(screenColor);
+    
+    bool matches = false;
+    for (int i = 0; i < u_targetColorCount; i++) {
+        vec3 targetColorSRGB = u_targetColors[i];
+        vec3 targetColorLinear = SRGBToLinear(targetColorSRGB);
+
+        float dist;
+        if (u_gammaMode == 2) {
+            // Assume input is linear (targets are sRGB -> convert targets only)
+            dist = distance(screenColor, targetColorLinear);
+        } else if (u_gammaMode == 1) {
+            // Assume input is sRGB (convert both input+target to linear)
+            dist = distance(screenColorLinear, targetColorLinear);
+        } else {
+            // Auto: evaluate both distances and accept the better match.
+            float distSRGB = distance(screenColor, targetColorSRGB);
+            float distLinear = distance(screenColorLinear, targetColorLinear);
+            dist = min(distSRGB, distLinear);
+        }
+
+        if (dist < u_sensitivity) {
+            matches = true;
+            break;
+        }
+    }
+    
+    if (matches) {
+        FragColor = outputColor;
+    } else {
+        FragColor = vec4(0.0, 0.0, 0.0, 0.0);
+    }
+})";
+
+// Color Passthrough filter shader - outputs original pixel color when matching target colors
+// Unlike the regular filter shader, this preserves the original pixel color instead of replacing it
+static const char* const mt_filter_passthrough_frag_shader = R"(#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+uniform sampler2D screenTexture;
+uniform vec4 u_sourceRect;
+uniform int u_gammaMode;       // 0=Auto, 1=Assume sRGB, 2=Assume Linear
+uniform vec3 u_targetColors[32]; // MT_MAX_LOOP_TARGET_COLORS - larger sets use the match table
+uniform int u_targetColorCount;  // Number of active target colors
+uniform float u_sensitivity;
+
+vec3 SRGBToLinear(vec3 c) {
+    bvec3 cutoff = lessThanEqual(c, vec3(0.04045));
+    vec3 low = c / 12.92;
+    vec3 high = pow((c + 0.055) / 1.055, vec3(2.4));
+    return mix(high, low, vec3(cutoff));
+}
+void main() {
+    vec2 srcCoord = u_sourceRect.xy + TexCoord * u_sourceRect.zw;
+    vec3 screenColor = texture(screenTexture, srcCoord).rgb;
+    vec3 screenColorLinear = SRGBToLinear(screenColor);
+    
+    bool matches = false;
+    for (int i = 0; i < u_targetColorCount; i++) {
+        vec3 targetColorSRGB = u_targetColors[i];
+        vec3 targetColorLinear = SRGBToLinear(targetColorSRGB);
+
+        float dist;
+        if (u_gammaMode == 2) {
+            dist = distance(screenColor, targetColorLinear);
+        } else if (u_gammaMode == 1) {
+            dist = distance(screenColorLinear, targetColorLinear);
+        } else {
+            float distSRGB = distance(screenColor, targetColorSRGB);
+            float distLinear = distance(screenColorLinear, targetColorLinear);
+            dist = min(distSRGB, distLinear);
+        }
+
+        if (dist < u_sensitivity) {
+            matches = true;
+            break;
+        }
+    }
+    
+    if (matches) {
+        // Output the original pixel color (passthrough)
+        FragColor = vec4(screenColor, 1.0);
+    } else {
+        FragColor = vec4(0.0, 0.0, 0.0, 0.0);
+    }
+})";
+
+// Lookup-table filter shaders - same output as the two shaders above, but the target-color test is a
+// single texelFetch into the precomputed match table (see mirror_match_lut.h) instead of a loop of pow() calls.
+// u_matchLut holds one bit per RGB8 value, packed into 32-bit words (1024 words per row), one table per layer.
+static const char* const mt_filter_lut_frag_shader = R"(#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+uniform sampler2D screenTexture;
+uniform usampler2DArray u_matchLut;
+uniform int u_matchLutLayer;
+uniform vec4 u_sourceRect;
+uniform vec4 outputColor;
+
+bool MatchesLut(vec3 c) {
+    uvec3 q = uvec3(c * 255.0 + 0.5);
+    uint idx = (q.r << 16) | (q.g << 8) | q.b;
+    uint word = idx >> 5;
+    uint bits = texelFetch(u_matchLut, ivec3(int(word & 1023u), int(word >> 10), u_matchLutLayer), 0).r;
+    return ((bits >> (idx & 31u)) & 1u) != 0u;
+}
+void main() {
+    vec2 srcCoord = u_sourceRect.xy + TexCoord * u_sourceRect.zw;
+    vec3 screenColor = texture(screenTexture, srcCoord).rgb;
+    if (MatchesLut(screenColor)) {
+        FragColor = outputColor;
+    } else {
+        FragColor = vec4(0.0, 0.0, 0.0, 0.0);
+    }
+})";
+
+static const char* const mt_filter_passthrough_lut_frag_shader = R"(#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+uniform sampler2D screenTexture;
+uniform usampler2DArray u_matchLut;
+uniform int u_matchLutLayer;
+uniform vec4 u_sourceRect;
+
+bool MatchesLut(vec3 c) {
+    uvec3 q = uvec3(c * 255.0 + 0.5);
+    uint idx = (q.r << 16) | (q.g << 8) | q.b;
+    uint word = idx >> 5;
+    uint bits = texelFetch(u_matchLut, ivec3(int(word & 1023u), int(word >> 10), u_matchLutLayer), 0).r;
+    return ((bits >> (idx & 31u)) & 1u) != 0u;
+}
+void main() {
+    vec2 srcCoord = u_sourceRect.xy + TexCoord * u_sourceRect.zw;
+    vec3 screenColor = texture(screenTexture, srcCoord).rgb;
+    if (MatchesLut(screenColor)) {
+        FragColor = vec4(screenColor, 1.0);
+    } else {
+        FragColor = vec4(0.0, 0.0, 0.0, 0.0);
+    }
+})";
+
+// Passthrough shader - just copies texture without modification
+static const char* const mt_passthrough_frag_shader = R"(#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+uniform sampler2D screenTexture;
+uniform vec4 u_sourceRect;
+void main() {
+    vec2 srcCoord = u_sourceRect.xy + TexCoord * u_sourceRect.zw;
+    FragColor = texture(screenTexture, srcCoord);
+})";
+
+// Background shader - simple texture blit with opacity
+static const char* const mt_background_frag_shader = R"(#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+uniform sampler2D backgroundTexture;
+uniform float u_opacity;
+void main() {
+    vec4 texColor = texture(backgroundTexture, TexCoord);
+    FragColor = vec4(texColor.rgb, texColor.a * u_opacity);
+})";
+
+// Render shader - brute force border rendering
+static const char* const mt_render_frag_shader = R"(#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+uniform sampler2D filterTexture;
+uniform int u_borderWidth;
+uniform vec4 u_outputColor;
+uniform vec4 u_borderColor;
+uniform vec2 u_screenPixel;
+void main() {
+    if (texture(filterTexture, TexCoord).a > 0.5) {
+        FragColor = u_outputColor;
+        return;
+    }
+    float maxA = 0.0;
+    for (int x = -u_borderWidth; x <= u_borderWidth; x++) {
+        for (int y = -u_borderWidth; y <= u_borderWidth; y++) {
+            if (x == 0 && y == 0) continue;
+            vec2 offset = vec2(x, y) * u_screenPixel;
+            maxA = max(maxA, texture(filterTexture, TexCoord + offset).a);
+        }
+    }
+    if (maxA > 0.5) {
+        FragColor = u_borderColor;
+    } else {
+        discard;
+    }
+})";
+
+// Render shader for color passthrough - preserves original pixel color from filter texture
+static const char* const mt_render_passthrough_frag_shader = R"(#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+uniform sampler2D filterTexture;
+uniform int u_borderWidth;
+uniform vec4 u_borderColor;
+uniform vec2 u_screenPixel;
+void main() {
+    vec4 texColor = texture(filterTexture, TexCoord);
+    if (texColor.a > 0.5) {
+        // Output original pixel color from filter texture
+        FragColor = vec4(texColor.rgb, 1.0);
+        return;
+    }
+    float maxA = 0.0;
+    for (int x = -u_borderWidth; x <= u_borderWidth; x++) {
+        for (int y = -u_borderWidth; y <= u_borderWidth; y++) {
+            if (x == 0 && y == 0) continue;
+            vec2 offset = vec2(x, y) * u_screenPixel;
+            maxA = max(maxA, texture(filterTexture, TexCoord + offset).a);
+        }
+    }
+    if (maxA > 0.5) {
+        FragColor = u_borderColor;
+    } else {
+        discard;
+    }
+})";
+
+// Static border shader - draws a border shape (rectangle or ellipse) on top of content
+// Uses SDF (Signed Distance Field) for smooth shape rendering
+static const char* const mt_static_border_frag_shader = R"(#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+uniform int u_shape;         // 0=Rectangle (with optional rounded corners), 1=Circle/Ellipse
+uniform vec4 u_borderColor;
+uniform float u_thickness;   // Border thickness in pixels
+uniform float u_radius;      // Corner radius for Rectangle in pixels (0 = sharp corners)
+uniform vec2 u_size;         // FBO size for aspect ratio correction
+
+// SDF for a rounded rectangle (works for sharp corners when r=0)
+float sdRoundedBox(vec2 p, vec2 b, float r) {
+    // Clamp radius to not exceed half of the smaller box dimension
+    float maxR = min(b.x, b.y);
+    r = clamp(r, 0.0, maxR);
+    vec2 q = abs(p) - b + r;
+    return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - r;
+}
+
+// SDF for an ellipse (approximation)
+float sdEllipse(vec2 p, vec2 ab) {
+    vec2 pn = p / ab;
+    float d = length(pn) - 1.0;
+    return d * min(ab.x, ab.y);
+}
+
+void main() {
+    // Map TexCoord (0-1) to centered coordinates (-1 to 1)
+    vec2 uv = TexCoord * 2.0 - 1.0;
+    
+    // Adjust for aspect ratio - ensure minimum size to avoid division issues
+    float aspectRatio = max(u_size.x, 1.0) / max(u_size.y, 1.0);
+    vec2 aspectUV = uv;
+    if (aspectRatio > 1.0) {
+        aspectUV.x *= aspectRatio;
+    } else {
+        aspectUV.y /= aspectRatio;
+    }
+    
+    // Normalize thickness to work with our coordinate space
+    float minSize = max(min(u_size.x, u_size.y), 1.0);
+    float borderThickness = u_thickness / minSize * 2.0;
+    
+    float dist;
+    
+    if (u_shape == 0) {
+        // Rectangle (with optional rounded corners via u_radius)
+        vec2 boxSize = vec2(1.0, 1.0);
+        if (aspectRatio > 1.0) {
+            boxSize.x = aspectRatio;
+        } else {
+            boxSize.y = 1.0 / aspectRatio;
+        }
+        float cornerRadius = u_radius / minSize * 2.0;
+        dist = sdRoundedBox(aspectUV, boxSize, cornerRadius);
+    } else {
+        // Circle/Ellipse
+        vec2 ellipseSize = vec2(1.0, 1.0);
+        if (aspectRatio > 1.0) {
+            ellipseSize.x = aspectRatio;
+        } else {
+            ellipseSize.y = 1.0 / aspectRatio;
+        }
+        dist = sdEllipse(aspectUV, ellipseSize);
+    }
+    
+    // Border is drawn at the shape edge (dist=0) outward to thickness
+    float innerEdge = 0.0;
+    float outerEdge = borderThickness;
+    
+    // Add small epsilon for floating-point precision at boundaries
+    float epsilon = 0.01;
+    
+    if (dist >= innerEdge - epsilon && dist <= outerEdge + epsilon) {
+        FragColor = u_borderColor;
+    } else {
+        discard;
+    }
+})";
+
+// Batched capture shaders - pass 1 of many mirrors in one instanced draw into the capture atlas.
+// Per instance (one per mirror input region): destination rect in atlas pixels, source rect (game UV, or
+// region cache UV when the source flag is set), output color, mode and match-table layer. The fragment stage reproduces mt_passthrough_frag_shader (mode 0),
+// mt_filter_lut_frag_shader (mode 1) and mt_filter_passthrough_lut_frag_shader (mode 2).
+static constexpr int MT_BATCH_INSTANCE_FLOATS = 16; // dstRect, srcRect, outputColor, mode, layer, source, 1 pad
+
+static const char* const mt_batch_vert_shader = R"(#version 330 core
+layout(location = 0) in vec2 aCorner;
+layout(location = 2) in vec4 aDstRect;
+layout(location = 3) in vec4 aSrcRect;
+layout(location = 4) in vec4 aOutputColor;
+layout(location = 5) in vec3 aModeLayerSource;
+uniform vec2 u_atlasSize;
+out vec2 TexCoord;
+flat out vec4 vSrcRect;
+flat out vec4 vOutputColor;
+flat out int vMode;
+flat out int vLayer;
+flat out int vSource;
+void main() {
+    vec2 pos = (aDstRect.xy + aCorner * aDstRect.zw) / u_atlasSize;
+    gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);
+    TexCoord = aCorner;
+    vSrcRect = aSrcRect;
+    vOutputColor = aOutputColor;
+    vMode = int(aModeLayerSource.x + 0.5);
+    vLayer = int(aModeLayerSource.y + 0.5);
+    vSource = int(aModeLayerSource.z + 0.5);
+})";
+
+static const char* const mt_batch_frag_shader = R"(#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+flat in vec4 vSrcRect;
+flat in vec4 vOutputColor;
+flat in int vMode;
+flat in int vLayer;
+flat in int vSource;
+uniform sampler2D screenTexture;
+uniform sampler2D u_regionCache;
+uniform usampler2DArray u_matchLut;
+
+bool MatchesLut(vec3 c) {
+    uvec3 q = uvec3(c * 255.0 + 0.5);
+    uint idx = (q.r << 16) | (q.g << 8) | q.b;
+    uint word = idx >> 5;
+    uint bits = texelFetch(u_matchLut, ivec3(int(word & 1023u), int(word >> 10), vLayer), 0).r;
+    return ((bits >> (idx & 31u)) & 1u) != 0u;
+}
+void main() {
+    vec2 srcCoord = vSrcRect.xy + TexCoord * vSrcRect.zw;
+    vec4 screenColor = (vSource == 1) ? texture(u_regionCache, srcCoord) : texture(screenTexture, srcCoord);
+    if (vMode == 0) {
+        FragColor = screenColor;
+    } else if (MatchesLut(screenColor.rgb)) {
+        FragColor = (vMode == 1) ? vOutputColor : vec4(screenColor.rgb, 1.0);
+    } else {
+        FragColor = vec4(0.0, 0.0, 0.0, 0.0);
+    }
+})";
+
+// Input signature reduction (mirror_signature.h) - one fragment per cell of a MIRROR_SIGNATURE_GRID^2 block.
+// Must hash exactly like ComputeMirrorSignatureCells: rows bottom-up, samples clamped to the game frame.
+static const char* const mt_signature_frag_shader = R"(#version 330 core
+out uint FragHash;
+uniform sampler2D screenTexture;
+uniform ivec4 u_region;     // x, y, w, h in game pixels
+uniform ivec2 u_cellOrigin; // Window position of this region's cell block
+uniform ivec2 u_gameSize;
+const int GRID = 8;
+void main() {
+    ivec2 cell = ivec2(gl_FragCoord.xy) - u_cellOrigin;
+    ivec2 block = (u_region.zw + GRID - 1) / GRID;
+    ivec2 p0 = u_region.xy + cell * block;
+    ivec2 p1 = min(p0 + block, u_region.xy + u_region.zw);
+    ivec2 maxTexel = u_gameSize - 1;
+    uint h = 2166136261u ^ uint(cell.y * GRID + cell.x);
+    for (int y = p0.y; y < p1.y; y++) {
+        for (int x = p0.x; x < p1.x; x++) {
+            uvec4 c = uvec4(texelFetch(screenTexture, clamp(ivec2(x, y), ivec2(0), maxTexel), 0) * 255.0 + 0.5);
+            h = (h ^ (c.r | (c.g << 8) | (c.b << 16) | (c.a << 24))) * 16777619u;
+        }
+    }
+    FragHash = h;
+})";
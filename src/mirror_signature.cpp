@@ -0,0 +1,76 @@
+// ============================================================================
+// MIRROR_SIGNATURE.CPP - Input signatures for skipping unchanged mirrors
+// ============================================================================
+
+#include "mirror_signature.h"
+
+#include <algorithm>
+#include <cstring>
+
+void ComputeMirrorSignatureCells(const MirrorFilterSource& src, int gameW, int gameH, const CaptureRect& rect,
+                                 uint32_t outCells[MIRROR_SIGNATURE_CELLS]) {
+    const int blockW = (rect.w + MIRROR_SIGNATURE_GRID - 1) / MIRROR_SIGNATURE_GRID;
+    const int blockH = (rect.h + MIRROR_SIGNATURE_GRID - 1) / MIRROR_SIGNATURE_GRID;
+    const size_t stride = src.stride > 0 ? static_cast<size_t>(src.stride) : static_cast<size_t>(src.width) * 4;
+    const bool hasPixels = src.pixels && src.width > 0 && src.height > 0 && gameW > 0 && gameH > 0;
+
+    for (int cy = 0; cy < MIRROR_SIGNATURE_GRID; cy++) {
+        for (int cx = 0; cx < MIRROR_SIGNATURE_GRID; cx++) {
+            const int cell = cy * MIRROR_SIGNATURE_GRID + cx;
+            uint32_t h = MirrorSignatureCellSeed(cell);
+            if (hasPixels) {
+                const int x0 = rect.x + cx * blockW, x1 = (std::min)(x0 + blockW, rect.Right());
+                const int y0 = rect.y + cy * blockH, y1 = (std::min)(y0 + blockH, rect.Top());
+                for (int y = y0; y < y1; y++) {
+                    int sy = std::clamp(y, 0, gameH - 1) - src.originY;
+                    sy = std::clamp(sy, 0, src.height - 1);
+                    const uint8_t* row = src.pixels + sy * stride;
+                    for (int x = x0; x < x1; x++) {
+                        int sx = std::clamp(x, 0, gameW - 1) - src.originX;
+                        sx = std::clamp(sx, 0, src.width - 1);
+                        uint32_t px;
+                        std::memcpy(&px, row + static_cast<size_t>(sx) * 4, 4); // R | G << 8 | B << 16 | A << 24 (little-endian)
+                        h = MirrorSignatureHashPixel(h, px);
+                    }
+                }
+            }
+            outCells[cell] = h;
+        }
+    }
+}
+
+uint64_t MirrorSignatureMixCells(uint64_t h, const uint32_t* cells, int count) {
+    for (int i = 0; i < count; i++) { h = MirrorSignatureMix(h, cells[i]); }
+    return h;
+}
+
+bool MirrorSignatureCache::BeginFrame() {
+    m_frame++;
+    return !IsBackedOff() || m_frame % BACKOFF_INTERVAL == 0;
+}
+
+void MirrorSignatureCache::EndFrame(int checked, int unchanged) {
+    if (checked <= 0) return;
+    m_missStreak = unchanged > 0 ? 0 : (std::min)(m_missStreak + 1, BACKOFF_AFTER_FRAMES);
+}
+
+bool MirrorSignatureCache::Matches(MirrorHandle handle, uint64_t signature) const {
+    if (handle.index >= m_entries.size()) return false;
+    const Entry& e = m_entries[handle.index];
+    return e.valid && e.generation == handle.generation && e.signature == signature;
+}
+
+void MirrorSignatureCache::Store(MirrorHandle handle, uint64_t signature) {
+    if (!handle.IsValid()) return;
+    if (handle.index >= m_entries.size()) { m_entries.resize(handle.index + 1); }
+    m_entries[handle.index] = Entry{ handle.generation, true, signature };
+}
+
+void MirrorSignatureCache::Invalidate(MirrorHandle handle) {
+    if (handle.index < m_entries.size()) { m_entries[handle.index].valid = false; }
+}
+
+void MirrorSignatureCache::Clear() {
+    m_entries.clear();
+    m_missStreak = 0;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+// ============================================================================
+// MIRROR_SIGNATURE.H - Input signatures for skipping unchanged mirrors
+// ============================================================================
+// While the game is paused or the player stands still, a mirror's input regions are identical from
+// frame to frame and re-filtering them reproduces the texture already on screen. Each input region is
+// reduced to a grid of MIRROR_SIGNATURE_GRID^2 cell hashes (every pixel of the region feeds exactly one
+// cell, so any single-pixel change alters the signature). The capture thread computes the cells on the
+// GPU with a tiny reduction pass; ComputeMirrorSignatureCells is the CPU version of the same hash, used by
+// the CPU fallback and to validate the shader.
+//
+// A mirror's signature folds its cell hashes together with everything else its output depends on
+// (config epoch, gamma mode, raw output, texture sizes, screen geometry). If it equals the signature of
+// the mirror's last completed capture, the mirror keeps its front texture and is not re-rendered.
+// Skipped mirrors also produce no content-detection or analysis readbacks (mirror_analysis.h) that frame.
+// ============================================================================
+
+#include <cstdint>
+#include <vector>
+
+#include "capture_regions.h"
+#include "mirror_filter.h"
+#include "mirror_registry.h"
+
+constexpr int MIRROR_SIGNATURE_GRID = 8;
+constexpr int MIRROR_SIGNATURE_CELLS = MIRROR_SIGNATURE_GRID * MIRROR_SIGNATURE_GRID;
+
+// Pixel hash step shared with the GLSL reduction pass (FNV-1a over whole RGBA8 words)
+inline uint32_t MirrorSignatureCellSeed(int cell) { return 2166136261u ^ static_cast<uint32_t>(cell); }
+inline uint32_t MirrorSignatureHashPixel(uint32_t h, uint32_t rgba) { return (h ^ rgba) * 16777619u; }
+
+// Cell hashes of one region (GL bottom-up game-frame coordinates). Cell (cx, cy) covers a
+// ceil(w / GRID) x ceil(h / GRID) block; its pixels are hashed row by row, bottom row first.
+// Samples outside the game frame are clamped to its edges like GL_CLAMP_TO_EDGE, then to src's window.
+// A null src.pixels hashes the seeds only.
+void ComputeMirrorSignatureCells(const MirrorFilterSource& src, int gameW, int gameH, const CaptureRect& rect,
+                                 uint32_t outCells[MIRROR_SIGNATURE_CELLS]);
+
+// Fold values into a 64-bit signature (FNV-1a over 64-bit words)
+constexpr uint64_t MIRROR_SIGNATURE_BASIS = 14695981039346656037ull;
+inline uint64_t MirrorSignatureMix(uint64_t h, uint64_t v) { return (h ^ v) * 1099511628211ull; }
+uint64_t MirrorSignatureMixCells(uint64_t h, const uint32_t* cells, int count);
+
+// Last-capture signatures per mirror slot, plus a back-off for scenes that change every frame:
+// computing signatures costs a small synchronous readback, so after a long streak of frames where no
+// mirror was skipped, signatures are only computed every few frames until one hits again.
+class MirrorSignatureCache {
+  public:
+    static constexpr int BACKOFF_AFTER_FRAMES = 30; // Consecutive probed frames without a hit
+    static constexpr int BACKOFF_INTERVAL = 8;      // Probe every Nth frame while backed off
+
+    // Whether to compute signatures this frame. Call once per frame.
+    bool BeginFrame();
+    // Result of a probed frame: how many mirrors were checked and how many were unchanged
+    void EndFrame(int checked, int unchanged);
+
+    // True if the slot's last completed capture had this signature
+    bool Matches(MirrorHandle handle, uint64_t signature) const;
+    // Record the signature of a completed capture
+    void Store(MirrorHandle handle, uint64_t signature);
+    // The slot was captured without a signature (e.g. while backed off): never match until stored again
+    void Invalidate(MirrorHandle handle);
+    void Clear();
+
+    bool IsBackedOff() const { return m_missStreak >= BACKOFF_AFTER_FRAMES; }
+
+  private:
+    struct Entry {
+        uint32_t generation = 0;
+        bool valid = false;
+        uint64_t signature = 0;
+    };
+
+    std::vector<Entry> m_entries; // Indexed by MirrorHandle::index
+    int m_missStreak = 0;
+    uint64_t m_frame = 0;
+};
@@ -1,11 +1,21 @@
 #include "mirror_thread.h"
+#include "capture_regions.h"
 #include "gui.h"
 #include "logic_thread.h"
+#include "mirror_analysis.h"
+#include "mirror_filter.h"
+#include "mirror_match_lut.h"
+#include "mirror_scheduler.h"
+#include "mirror_shaders.h"
+#include "mirror_signature.h"
 #include "profiler.h"
+#include "program_cache.h"
+#include "rcu_snapshot.h"
 #include "render.h"
 #include "shared_contexts.h"
 #include "utils.h"
 #include <algorithm>
+#include <chrono>
 #include <unordered_map>
 #include <thread>
 
@@ -24,10 +34,78 @@ static HGLRC g_mirrorCaptureContext = NULL;
 static HDC g_mirrorCaptureDC = NULL;
 static bool g_mirrorContextIsShared = false; // True if using pre-shared context
 
-// Shared capture data (main thread writes, capture thread reads)
-std::vector<ThreadedMirrorConfig> g_threadedMirrorConfigs;
+// Shared capture data (main thread writes, capture thread reads).
+// RCU like the config snapshot: readers atomically load an immutable list, writers copy, edit and republish it
+// under g_threadedMirrorConfigMutex. The shared_ptr refcount frees a list once the last reader drops it.
+static RcuSnapshot<ThreadedMirrorConfigList> g_threadedMirrorConfigs;
 std::mutex g_threadedMirrorConfigMutex;
 
+// Slot index (MirrorHandle::index) -> position in the published list, rebuilt on every publish.
+// Writer-side only, guarded by g_threadedMirrorConfigMutex.
+static std::vector<uint32_t> g_threadedMirrorConfigSlots;
+
+std::shared_ptr<const ThreadedMirrorConfigList> GetThreadedMirrorConfigs() {
+    return g_threadedMirrorConfigs.Load();
+}
+
+// Caller holds g_threadedMirrorConfigMutex
+static void MT_PublishThreadedConfigs(std::shared_ptr<const ThreadedMirrorConfigList> configs) {
+    g_threadedMirrorConfigSlots.assign(g_mirrorInstances.SlotCount(), UINT32_MAX);
+    for (size_t i = 0; i < configs->size(); i++) {
+        const MirrorHandle& handle = (*configs)[i].handle;
+        if (!handle.IsValid()) continue;
+        if (handle.index >= g_threadedMirrorConfigSlots.size()) { g_threadedMirrorConfigSlots.resize(handle.index + 1, UINT32_MAX); }
+        g_threadedMirrorConfigSlots[handle.index] = static_cast<uint32_t>(i);
+    }
+
+    // Publish a cheap summary so the SwapBuffers hook can skip SubmitFrameCapture when nothing needs it.
+    g_activeMirrorCaptureCount.store(static_cast<int>(configs->size()), std::memory_order_release);
+    g_threadedMirrorConfigs.Publish(std::move(configs));
+}
+
+// Position of a mirror in the published list, or -1. The name is resolved once through the registry.
+// Caller holds g_threadedMirrorConfigMutex.
+static int MT_FindThreadedConfig(const ThreadedMirrorConfigList& configs, const std::string& mirrorName) {
+    MirrorHandle handle;
+    {
+        std::shared_lock<std::shared_mutex> lock(g_mirrorInstancesMutex);
+        handle = g_mirrorInstances.HandleOf(mirrorName);
+    }
+    if (handle.index < g_threadedMirrorConfigSlots.size()) {
+        uint32_t pos = g_threadedMirrorConfigSlots[handle.index];
+        if (pos < configs.size() && configs[pos].handle == handle) return static_cast<int>(pos);
+    }
+
+    // Registry was reset since the configs were published - fall back to the name
+    for (size_t i = 0; i < configs.size(); i++) {
+        if (configs[i].name == mirrorName) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+// Copy-on-write edit of one mirror's published config. Readers keep whatever list they already hold.
+template <typename Fn> static void MT_EditThreadedConfig(const std::string& mirrorName, Fn&& edit) {
+    std::lock_guard<std::mutex> lock(g_threadedMirrorConfigMutex);
+    auto current = GetThreadedMirrorConfigs();
+    int pos = MT_FindThreadedConfig(*current, mirrorName);
+    if (pos < 0) return;
+
+    auto next = std::make_shared<ThreadedMirrorConfigList>(*current);
+    edit((*next)[pos]);
+    MT_PublishThreadedConfigs(std::move(next));
+}
+
+// Caller holds g_mirrorInstancesMutex. outHandle is the instance's current slot, which differs from
+// conf.handle if instances were recreated after the configs were published.
+static MirrorInstance* MT_FindMirrorInstance(const ThreadedMirrorConfig& conf, MirrorHandle& outHandle) {
+    outHandle = conf.handle;
+    if (MirrorInstance* inst = g_mirrorInstances.Get(conf.handle)) return inst;
+    auto it = g_mirrorInstances.find(conf.name);
+    if (it == g_mirrorInstances.end()) return nullptr;
+    outHandle = it.Handle();
+    return &it->second;
+}
+
 // Game state for capture thread
 std::atomic<int> g_captureGameW{ 0 };
 std::atomic<int> g_captureGameH{ 0 };
@@ -131,288 +209,9 @@ static void MT_LogSharedContextHealthOnce() {
 // MIRROR THREAD LOCAL SHADER PROGRAMS
 // These shaders are created on the mirror thread context (not shared with main thread)
 // OpenGL shader programs are NOT shared between contexts via wglShareLists
+// Sources: mirror_shaders.h
 // ============================================================================
 
-// Vertex shader (shared by all fragment shaders)
-static const char* mt_passthrough_vert_shader = R"(#version 330 core
-layout(location = 0) in vec2 aPos;
-layout(location = 1) in vec2 aTexCoord;
-out vec2 TexCoord;
-void main() {
-    gl_Position = vec4(aPos, 0.0, 1.0);
-    TexCoord = aTexCoord;
-})";
-
-// Filter shader - applies color filter to captured content (supports multiple target colors)
-static const char* mt_filter_frag_shader = R"(#version 330 core
-out vec4 FragColor;
-in vec2 TexCoord;
-uniform sampler2D screenTexture;
-uniform vec4 u_sourceRect;
-uniform int u_gammaMode;       // 0=Auto, 1=Assume sRGB, 2=Assume Linear
-uniform vec3 u_targetColors[8];  // Support up to 8 target colors
-uniform int u_targetColorCount;  // Number of active target colors
-uniform vec4 outputColor;
-uniform float u_sensitivity;
-
-vec3 SRGBToLinear(vec3 c) {
-    bvec3 cutoff = lessThanEqual(c, vec3(0.04045));
-    vec3 low = c / 12.92;
-    vec3 high = pow((c + 0.055) / 1.055, vec3(2.4));
-    return mix(high, low, vec3(cutoff));
-}
-void main() {
-    vec2 srcCoord = u_sourceRect.xy + TexCoord * u_sourceRect.zw;
-    vec3 screenColor = texture(screenTexture, srcCoord).rgb;
-    vec3 screenColorLinear = SRGBToLinear(screenColor);
-    
-    bool matches = false;
-    for (int i = 0; i < u_targetColorCount; i++) {
-        vec3 targetColorSRGB = u_targetColors[i];
-        vec3 targetColorLinear = SRGBToLinear(targetColorSRGB);
-
-        float dist;
-        if (u_gammaMode == 2) {
-            // Assume input is linear (targets are sRGB -> convert targets only)
-            dist = distance(screenColor, targetColorLinear);
-        } else if (u_gammaMode == 1) {
-            // Assume input is sRGB (convert both input+target to linear)
-            dist = distance(screenColorLinear, targetColorLinear);
-        } else {
-            // Auto: evaluate both distances and accept the better match.
-            float distSRGB = distance(screenColor, targetColorSRGB);
-            float distLinear = distance(screenColorLinear, targetColorLinear);
-            dist = min(distSRGB, distLinear);
-        }
-
-        if (dist < u_sensitivity) {
-            matches = true;
-            break;
-        }
-    }
-    
-    if (matches) {
-        FragColor = outputColor;
-    } else {
-        FragColor = vec4(0.0, 0.0, 0.0, 0.0);
-    }
-})";
-
-// Color Passthrough filter shader - outputs original pixel color when matching target colors
-// Unlike the regular filter shader, this preserves the original pixel color instead of replacing it
-static const char* mt_filter_passthrough_frag_shader = R"(#version 330 core
-out vec4 FragColor;
-in vec2 TexCoord;
-uniform sampler2D screenTexture;
-uniform vec4 u_sourceRect;
-uniform int u_gammaMode;       // 0=Auto, 1=Assume sRGB, 2=Assume Linear
-uniform vec3 u_targetColors[8];  // Support up to 8 target colors
-uniform int u_targetColorCount;  // Number of active target colors
-uniform float u_sensitivity;
-
-vec3 SRGBToLinear(vec3 c) {
-    bvec3 cutoff = lessThanEqual(c, vec3(0.04045));
-    vec3 low = c / 12.92;
-    vec3 high = pow((c + 0.055) / 1.055, vec3(2.4));
-    return mix(high, low, vec3(cutoff));
-}
-void main() {
-    vec2 srcCoord = u_sourceRect.xy + TexCoord * u_sourceRect.zw;
-    vec3 screenColor = texture(screenTexture, srcCoord).rgb;
-    vec3 screenColorLinear = SRGBToLinear(screenColor);
-    
-    bool matches = false;
-    for (int i = 0; i < u_targetColorCount; i++) {
-        vec3 targetColorSRGB = u_targetColors[i];
-        vec3 targetColorLinear = SRGBToLinear(targetColorSRGB);
-
-        float dist;
-        if (u_gammaMode == 2) {
-            dist = distance(screenColor, targetColorLinear);
-        } else if (u_gammaMode == 1) {
-            dist = distance(screenColorLinear, targetColorLinear);
-        } else {
-            float distSRGB = distance(screenColor, targetColorSRGB);
-            float distLinear = distance(screenColorLinear, targetColorLinear);
-            dist = min(distSRGB, distLinear);
-        }
-
-        if (dist < u_sensitivity) {
-            matches = true;
-            break;
-        }
-    }
-    
-    if (matches) {
-        // Output the original pixel color (passthrough)
-        FragColor = vec4(screenColor, 1.0);
-    } else {
-        FragColor = vec4(0.0, 0.0, 0.0, 0.0);
-    }
-})";
-
-// Passthrough shader - just copies texture without modification
-static const char* mt_passthrough_frag_shader = R"(#version 330 core
-out vec4 FragColor;
-in vec2 TexCoord;
-uniform sampler2D screenTexture;
-uniform vec4 u_sourceRect;
-void main() {
-    vec2 srcCoord = u_sourceRect.xy + TexCoord * u_sourceRect.zw;
-    FragColor = texture(screenTexture, srcCoord);
-})";
-
-// Background shader - simple texture blit with opacity
-static const char* mt_background_frag_shader = R"(#version 330 core
-out vec4 FragColor;
-in vec2 TexCoord;
-uniform sampler2D backgroundTexture;
-uniform float u_opacity;
-void main() {
-    vec4 texColor = texture(backgroundTexture, TexCoord);
-    FragColor = vec4(texColor.rgb, texColor.a * u_opacity);
-})";
-
-// Render shader - brute force border rendering
-static const char* mt_render_frag_shader = R"(#version 330 core
-out vec4 FragColor;
-in vec2 TexCoord;
-uniform sampler2D filterTexture;
-uniform int u_borderWidth;
-uniform vec4 u_outputColor;
-uniform vec4 u_borderColor;
-uniform vec2 u_screenPixel;
-void main() {
-    if (texture(filterTexture, TexCoord).a > 0.5) {
-        FragColor = u_outputColor;
-        return;
-    }
-    float maxA = 0.0;
-    for (int x = -u_borderWidth; x <= u_borderWidth; x++) {
-        for (int y = -u_borderWidth; y <= u_borderWidth; y++) {
-            if (x == 0 && y == 0) continue;
-            vec2 offset = vec2(x, y) * u_screenPixel;
-            maxA = max(maxA, texture(filterTexture, TexCoord + offset).a);
-        }
-    }
-    if (maxA > 0.5) {
-        FragColor = u_borderColor;
-    } else {
-        discard;
-    }
-})";
-
-// Render shader for color passthrough - preserves original pixel color from filter texture
-static const char* mt_render_passthrough_frag_shader = R"(#version 330 core
-out vec4 FragColor;
-in vec2 TexCoord;
-uniform sampler2D filterTexture;
-uniform int u_borderWidth;
-uniform vec4 u_borderColor;
-uniform vec2 u_screenPixel;
-void main() {
-    vec4 texColor = texture(filterTexture, TexCoord);
-    if (texColor.a > 0.5) {
-        // Output original pixel color from filter texture
-        FragColor = vec4(texColor.rgb, 1.0);
-        return;
-    }
-    float maxA = 0.0;
-    for (int x = -u_borderWidth; x <= u_borderWidth; x++) {
-        for (int y = -u_borderWidth; y <= u_borderWidth; y++) {
-            if (x == 0 && y == 0) continue;
-            vec2 offset = vec2(x, y) * u_screenPixel;
-            maxA = max(maxA, texture(filterTexture, TexCoord + offset).a);
-        }
-    }
-    if (maxA > 0.5) {
-        FragColor = u_borderColor;
-    } else {
-        discard;
-    }
-})";
-
-// Static border shader - draws a border shape (rectangle or ellipse) on top of content
-// Uses SDF (Signed Distance Field) for smooth shape rendering
-static const char* mt_static_border_frag_shader = R"(#version 330 core
-out vec4 FragColor;
-in vec2 TexCoord;
-uniform int u_shape;         // 0=Rectangle (with optional rounded corners), 1=Circle/Ellipse
-uniform vec4 u_borderColor;
-uniform float u_thickness;   // Border thickness in pixels
-uniform float u_radius;      // Corner radius for Rectangle in pixels (0 = sharp corners)
-uniform vec2 u_size;         // FBO size for aspect ratio correction
-
-// SDF for a rounded rectangle (works for sharp corners when r=0)
-float sdRoundedBox(vec2 p, vec2 b, float r) {
-    // Clamp radius to not exceed half of the smaller box dimension
-    float maxR = min(b.x, b.y);
-    r = clamp(r, 0.0, maxR);
-    vec2 q = abs(p) - b + r;
-    return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - r;
-}
-
-// SDF for an ellipse (approximation)
-float sdEllipse(vec2 p, vec2 ab) {
-    vec2 pn = p / ab;
-    float d = length(pn) - 1.0;
-    return d * min(ab.x, ab.y);
-}
-
-void main() {
-    // Map TexCoord (0-1) to centered coordinates (-1 to 1)
-    vec2 uv = TexCoord * 2.0 - 1.0;
-    
-    // Adjust for aspect ratio - ensure minimum size to avoid division issues
-    float aspectRatio = max(u_size.x, 1.0) / max(u_size.y, 1.0);
-    vec2 aspectUV = uv;
-    if (aspectRatio > 1.0) {
-        aspectUV.x *= aspectRatio;
-    } else {
-        aspectUV.y /= aspectRatio;
-    }
-    
-    // Normalize thickness to work with our coordinate space
-    float minSize = max(min(u_size.x, u_size.y), 1.0);
-    float borderThickness = u_thickness / minSize * 2.0;
-    
-    float dist;
-    
-    if (u_shape == 0) {
-        // Rectangle (with optional rounded corners via u_radius)
-        vec2 boxSize = vec2(1.0, 1.0);
-        if (aspectRatio > 1.0) {
-            boxSize.x = aspectRatio;
-        } else {
-            boxSize.y = 1.0 / aspectRatio;
-        }
-        float cornerRadius = u_radius / minSize * 2.0;
-        dist = sdRoundedBox(aspectUV, boxSize, cornerRadius);
-    } else {
-        // Circle/Ellipse
-        vec2 ellipseSize = vec2(1.0, 1.0);
-        if (aspectRatio > 1.0) {
-            ellipseSize.x = aspectRatio;
-        } else {
-            ellipseSize.y = 1.0 / aspectRatio;
-        }
-        dist = sdEllipse(aspectUV, ellipseSize);
-    }
-    
-    // Border is drawn at the shape edge (dist=0) outward to thickness
-    float innerEdge = 0.0;
-    float outerEdge = borderThickness;
-    
-    // Add small epsilon for floating-point precision at boundaries
-    float epsilon = 0.01;
-    
-    if (dist >= innerEdge - epsilon && dist <= outerEdge + epsilon) {
-        FragColor = u_borderColor;
-    } else {
-        discard;
-    }
-})";
-
 // Local shader program handles (created on mirror thread context)
 static GLuint mt_filterProgram = 0;
 static GLuint mt_filterPassthroughProgram = 0; // Color passthrough filter shader
@@ -421,12 +220,16 @@ static GLuint mt_backgroundProgram = 0;
 static GLuint mt_renderProgram = 0;
 static GLuint mt_renderPassthroughProgram = 0; // Color passthrough render shader
 static GLuint mt_staticBorderProgram = 0;      // Static border shape shader
+static GLuint mt_filterLutProgram = 0;            // Optional: filter via match table
+static GLuint mt_filterPassthroughLutProgram = 0; // Optional: color passthrough filter via match table
+static GLuint mt_batchProgram = 0;                // Optional: batched pass 1 into the capture atlas
+static GLuint mt_signatureProgram = 0;            // Optional: input signatures for skipping unchanged mirrors
 
 // Uniform locations for local shaders
 struct MT_FilterShaderLocs {
     GLint screenTexture = -1, sourceRect = -1;
     GLint gammaMode = -1;
-    GLint targetColors = -1;     // Array of target colors (up to 8)
+    GLint targetColors = -1;     // Array of target colors (up to MT_MAX_LOOP_TARGET_COLORS)
     GLint targetColorCount = -1; // Number of active target colors
     GLint outputColor = -1, sensitivity = -1;
 };
@@ -434,7 +237,7 @@ struct MT_FilterShaderLocs {
 struct MT_FilterPassthroughShaderLocs {
     GLint screenTexture = -1, sourceRect = -1;
     GLint gammaMode = -1;
-    GLint targetColors = -1;     // Array of target colors (up to 8)
+    GLint targetColors = -1;     // Array of target colors (up to MT_MAX_LOOP_TARGET_COLORS)
     GLint targetColorCount = -1; // Number of active target colors
     GLint sensitivity = -1;
 };
@@ -451,6 +254,18 @@ struct MT_RenderShaderLocs {
 struct MT_RenderPassthroughShaderLocs {
     GLint filterTexture = -1, borderWidth = -1, borderColor = -1, screenPixel = -1;
 };
+// Match-table filter shader uniform locations (outputColor unused by the passthrough variant)
+struct MT_FilterLutShaderLocs {
+    GLint screenTexture = -1, matchLut = -1, matchLutLayer = -1, sourceRect = -1, outputColor = -1;
+};
+// Batched capture shader uniform locations
+struct MT_BatchShaderLocs {
+    GLint screenTexture = -1, regionCache = -1, matchLut = -1, atlasSize = -1;
+};
+// Input signature shader uniform locations
+struct MT_SignatureShaderLocs {
+    GLint screenTexture = -1, region = -1, cellOrigin = -1, gameSize = -1;
+};
 // Static border shader uniform locations
 struct MT_StaticBorderShaderLocs {
     GLint shape = -1, borderColor = -1, thickness = -1, radius = -1, size = -1;
@@ -464,6 +279,10 @@ static MT_RenderPassthroughShaderLocs mt_renderPassthroughShaderLocs;
 static MT_StaticBorderShaderLocs mt_staticBorderShaderLocs;
 
 static MT_FilterPassthroughShaderLocs mt_filterPassthroughShaderLocs;
+static MT_FilterLutShaderLocs mt_filterLutShaderLocs;
+static MT_FilterLutShaderLocs mt_filterPassthroughLutShaderLocs;
+static MT_BatchShaderLocs mt_batchShaderLocs;
+static MT_SignatureShaderLocs mt_signatureShaderLocs;
 
 // Shader compilation helper
 static GLuint MT_CompileShader(GLenum type, const char* source) {
@@ -483,6 +302,10 @@ static GLuint MT_CompileShader(GLenum type, const char* source) {
 }
 
 static GLuint MT_CreateShaderProgram(const char* vertSrc, const char* fragSrc) {
+    const char* sources[] = { vertSrc, fragSrc };
+    const ProgramCacheKey cacheKey = MakeProgramCacheKeyForCurrentContext(sources, 2);
+    if (GLuint cached = LoadCachedProgram(cacheKey)) return cached;
+
     GLuint vs = MT_CompileShader(GL_VERTEX_SHADER, vertSrc);
     GLuint fs = MT_CompileShader(GL_FRAGMENT_SHADER, fragSrc);
     if (!vs || !fs) {
@@ -493,6 +316,7 @@ static GLuint MT_CreateShaderProgram(const char* vertSrc, const char* fragSrc) {
     GLuint p = glCreateProgram();
     glAttachShader(p, vs);
     glAttachShader(p, fs);
+    PrepareProgramForCache(p);
     glLinkProgram(p);
     glDeleteShader(vs);
     glDeleteShader(fs);
@@ -505,11 +329,13 @@ static GLuint MT_CreateShaderProgram(const char* vertSrc, const char* fragSrc) {
         glDeleteProgram(p);
         return 0;
     }
+    StoreCachedProgram(cacheKey, p);
     return p;
 }
 
 static bool MT_InitializeShaders() {
     LogCategory("init", "Mirror Thread: Initializing local shaders...");
+    ScopedProgramCacheReport cacheReport("Mirror Thread");
 
     mt_filterProgram = MT_CreateShaderProgram(mt_passthrough_vert_shader, mt_filter_frag_shader);
     mt_filterPassthroughProgram = MT_CreateShaderProgram(mt_passthrough_vert_shader, mt_filter_passthrough_frag_shader);
@@ -525,6 +351,60 @@ static bool MT_InitializeShaders() {
         return false;
     }
 
+    // Match-table programs are optional - mirrors fall back to the uniform-loop filter shaders without them
+    mt_filterLutProgram = MT_CreateShaderProgram(mt_passthrough_vert_shader, mt_filter_lut_frag_shader);
+    mt_filterPassthroughLutProgram = MT_CreateShaderProgram(mt_passthrough_vert_shader, mt_filter_passthrough_lut_frag_shader);
+    if (!mt_filterLutProgram || !mt_filterPassthroughLutProgram) {
+        LogCategory("init", "Mirror Thread: Match-table filter shaders unavailable, using per-pixel target loop");
+    }
+    if (mt_filterLutProgram) {
+        mt_filterLutShaderLocs.screenTexture = glGetUniformLocation(mt_filterLutProgram, "screenTexture");
+        mt_filterLutShaderLocs.matchLut = glGetUniformLocation(mt_filterLutProgram, "u_matchLut");
+        mt_filterLutShaderLocs.matchLutLayer = glGetUniformLocation(mt_filterLutProgram, "u_matchLutLayer");
+        mt_filterLutShaderLocs.sourceRect = glGetUniformLocation(mt_filterLutProgram, "u_sourceRect");
+        mt_filterLutShaderLocs.outputColor = glGetUniformLocation(mt_filterLutProgram, "outputColor");
+        glUseProgram(mt_filterLutProgram);
+        glUniform1i(mt_filterLutShaderLocs.screenTexture, 0);
+        glUniform1i(mt_filterLutShaderLocs.matchLut, 1);
+    }
+    if (mt_filterPassthroughLutProgram) {
+        mt_filterPassthroughLutShaderLocs.screenTexture = glGetUniformLocation(mt_filterPassthroughLutProgram, "screenTexture");
+        mt_filterPassthroughLutShaderLocs.matchLut = glGetUniformLocation(mt_filterPassthroughLutProgram, "u_matchLut");
+        mt_filterPassthroughLutShaderLocs.matchLutLayer = glGetUniformLocation(mt_filterPassthroughLutProgram, "u_matchLutLayer");
+        mt_filterPassthroughLutShaderLocs.sourceRect = glGetUniformLocation(mt_filterPassthroughLutProgram, "u_sourceRect");
+        glUseProgram(mt_filterPassthroughLutProgram);
+        glUniform1i(mt_filterPassthroughLutShaderLocs.screenTexture, 0);
+        glUniform1i(mt_filterPassthroughLutShaderLocs.matchLut, 1);
+    }
+
+    // Batched capture program is optional too - without it every mirror renders pass 1 on its own
+    mt_batchProgram = MT_CreateShaderProgram(mt_batch_vert_shader, mt_batch_frag_shader);
+    if (mt_batchProgram) {
+        mt_batchShaderLocs.screenTexture = glGetUniformLocation(mt_batchProgram, "screenTexture");
+        mt_batchShaderLocs.regionCache = glGetUniformLocation(mt_batchProgram, "u_regionCache");
+        mt_batchShaderLocs.matchLut = glGetUniformLocation(mt_batchProgram, "u_matchLut");
+        mt_batchShaderLocs.atlasSize = glGetUniformLocation(mt_batchProgram, "u_atlasSize");
+        glUseProgram(mt_batchProgram);
+        glUniform1i(mt_batchShaderLocs.screenTexture, 0);
+        glUniform1i(mt_batchShaderLocs.matchLut, 1);
+        glUniform1i(mt_batchShaderLocs.regionCache, 2);
+    } else {
+        LogCategory("init", "Mirror Thread: Batched capture shader unavailable, rendering mirrors individually");
+    }
+
+    // Without the signature program every due mirror is re-rendered, as before
+    mt_signatureProgram = MT_CreateShaderProgram(mt_passthrough_vert_shader, mt_signature_frag_shader);
+    if (mt_signatureProgram) {
+        mt_signatureShaderLocs.screenTexture = glGetUniformLocation(mt_signatureProgram, "screenTexture");
+        mt_signatureShaderLocs.region = glGetUniformLocation(mt_signatureProgram, "u_region");
+        mt_signatureShaderLocs.cellOrigin = glGetUniformLocation(mt_signatureProgram, "u_cellOrigin");
+        mt_signatureShaderLocs.gameSize = glGetUniformLocation(mt_signatureProgram, "u_gameSize");
+        glUseProgram(mt_signatureProgram);
+        glUniform1i(mt_signatureShaderLocs.screenTexture, 0);
+    } else {
+        LogCategory("init", "Mirror Thread: Signature shader unavailable, unchanged mirrors will not be skipped");
+    }
+
     // Get uniform locations for basic shaders
     mt_filterShaderLocs.screenTexture = glGetUniformLocation(mt_filterProgram, "screenTexture");
     mt_filterShaderLocs.sourceRect = glGetUniformLocation(mt_filterProgram, "u_sourceRect");
@@ -623,6 +503,146 @@ static void MT_CleanupShaders() {
         glDeleteProgram(mt_staticBorderProgram);
         mt_staticBorderProgram = 0;
     }
+    if (mt_filterLutProgram) {
+        glDeleteProgram(mt_filterLutProgram);
+        mt_filterLutProgram = 0;
+    }
+    if (mt_filterPassthroughLutProgram) {
+        glDeleteProgram(mt_filterPassthroughLutProgram);
+        mt_filterPassthroughLutProgram = 0;
+    }
+    if (mt_batchProgram) {
+        glDeleteProgram(mt_batchProgram);
+        mt_batchProgram = 0;
+    }
+    if (mt_signatureProgram) {
+        glDeleteProgram(mt_signatureProgram);
+        mt_signatureProgram = 0;
+    }
+}
+
+// ============================================================================
+// Match-table textures (mirror thread only)
+// ============================================================================
+// All tables live in one GL_R32UI texture array, one layer per distinct (target colors, sensitivity,
+// gamma mode) combination, so mirrors sharing a color setup share a layer and the batched capture pass
+// can address every mirror's table from a single draw. Tables come from a settling cache: until a key
+// has been stable for MT_MATCH_LUT_SETTLE_MS the mirror keeps using the per-pixel target loop shaders,
+// unless it has more colors than the loop shaders can hold - then the table is built right away.
+
+static constexpr int MT_MATCH_LUT_SETTLE_MS = 150;
+static constexpr int MT_MATCH_LUT_MAX_LAYERS = 8; // 2 MB each
+
+struct MT_MatchLutLayer {
+    int layer = -1;
+    uint64_t lastUsedFrame = 0;
+};
+
+static MirrorMatchLutCache mt_matchLutCache(4, MT_MATCH_LUT_SETTLE_MS);
+static GLuint mt_matchLutArray = 0;
+static std::unordered_map<MirrorMatchLutKey, MT_MatchLutLayer, MirrorMatchLutKeyHasher> mt_matchLutLayers;
+static uint64_t mt_matchLutFrame = 0;
+
+// Returns the match-table layer for a mirror, or -1 if the per-pixel loop shaders should be used this frame.
+// A layer handed out this frame is never reused for another key in the same frame.
+static int MT_GetMatchLutLayer(const ThreadedMirrorConfig& conf, MirrorGammaMode gammaMode) {
+    if (!mt_filterLutProgram || !mt_filterPassthroughLutProgram) return -1;
+
+    MirrorMatchLutKey key = MakeMirrorMatchLutKey(conf.targetColors, conf.colorSensitivity, gammaMode);
+    auto it = mt_matchLutLayers.find(key);
+    if (it != mt_matchLutLayers.end()) {
+        it->second.lastUsedFrame = mt_matchLutFrame;
+        return it->second.layer;
+    }
+
+    // Pick a free layer, or the least recently used one that isn't in use this frame
+    int layer = -1;
+    auto victim = mt_matchLutLayers.end();
+    if (static_cast<int>(mt_matchLutLayers.size()) < MT_MATCH_LUT_MAX_LAYERS) {
+        std::vector<bool> used(MT_MATCH_LUT_MAX_LAYERS, false);
+        for (const auto& kv : mt_matchLutLayers) { used[kv.second.layer] = true; }
+        for (int i = 0; i < MT_MATCH_LUT_MAX_LAYERS && layer < 0; i++) {
+            if (!used[i]) { layer = i; }
+        }
+    } else {
+        for (auto e = mt_matchLutLayers.begin(); e != mt_matchLutLayers.end(); ++e) {
+            if (e->second.lastUsedFrame == mt_matchLutFrame) continue;
+            if (victim == mt_matchLutLayers.end() || e->second.lastUsedFrame < victim->second.lastUsedFrame) { victim = e; }
+        }
+        if (victim == mt_matchLutLayers.end()) return -1;
+        layer = victim->second.layer;
+    }
+
+    std::shared_ptr<const MirrorMatchLut> lut;
+    bool wasBuilt = false;
+    {
+        PROFILE_SCOPE_CAT("Build Match LUT", "Mirror Thread");
+        bool needsTable = static_cast<int>(conf.targetColors.size()) > MT_MAX_LOOP_TARGET_COLORS;
+        lut = mt_matchLutCache.Get(key, &wasBuilt, needsTable);
+    }
+    if (!lut) return -1;
+    if (wasBuilt) {
+        LogCategory("performance", "Mirror Thread: Built color-match table for '" + conf.name + "' (" +
+                                       std::to_string(conf.targetColors.size()) + " colors) in " + std::to_string(lut->buildTimeMs) +
+                                       " ms");
+    }
+    if (victim != mt_matchLutLayers.end()) { mt_matchLutLayers.erase(victim); }
+
+    GLint prevActiveTexture = 0, prevTexture = 0, prevUnpackAlignment = 4;
+    glGetIntegerv(GL_ACTIVE_TEXTURE, &prevActiveTexture);
+    glActiveTexture(GL_TEXTURE1);
+    glGetIntegerv(GL_TEXTURE_BINDING_2D_ARRAY, &prevTexture);
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &prevUnpackAlignment);
+
+    if (mt_matchLutArray == 0) {
+        glGenTextures(1, &mt_matchLutArray);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, mt_matchLutArray);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R32UI, MIRROR_MATCH_LUT_TEXTURE_WIDTH, MIRROR_MATCH_LUT_TEXTURE_HEIGHT,
+                     MT_MATCH_LUT_MAX_LAYERS, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    } else {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, mt_matchLutArray);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, MIRROR_MATCH_LUT_TEXTURE_WIDTH, MIRROR_MATCH_LUT_TEXTURE_HEIGHT, 1,
+                    GL_RED_INTEGER, GL_UNSIGNED_INT, lut->words.data());
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, prevUnpackAlignment);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, prevTexture);
+    glActiveTexture(prevActiveTexture);
+
+    MT_MatchLutLayer entry;
+    entry.layer = layer;
+    entry.lastUsedFrame = mt_matchLutFrame;
+    mt_matchLutLayers.emplace(key, entry);
+    return layer;
+}
+
+// Number of target colors to upload to the loop shaders (only clamps if the match-table shaders are unavailable)
+static int MT_LoopTargetColorCount(const ThreadedMirrorConfig& conf) {
+    int count = static_cast<int>(conf.targetColors.size());
+    if (count > MT_MAX_LOOP_TARGET_COLORS) {
+        static bool s_loggedClamp = false;
+        if (!s_loggedClamp) {
+            s_loggedClamp = true;
+            Log("Mirror Thread: WARNING - '" + conf.name + "' has " + std::to_string(count) +
+                " target colors but match-table shaders are unavailable, using the first " + std::to_string(MT_MAX_LOOP_TARGET_COLORS));
+        }
+        count = MT_MAX_LOOP_TARGET_COLORS;
+    }
+    return count;
+}
+
+static void MT_CleanupMatchLutTextures() {
+    if (mt_matchLutArray) {
+        glDeleteTextures(1, &mt_matchLutArray);
+        mt_matchLutArray = 0;
+    }
+    mt_matchLutLayers.clear();
+    mt_matchLutCache.Clear();
 }
 
 // Get the most recent copy texture (for OBS/render_thread to use)
@@ -995,12 +1015,84 @@ static void ComputeMirrorRenderCache(MirrorInstance* inst, const ThreadedMirrorC
     cache.isValid = true;
 }
 
+// Resize a mirror's capture (fbo) and back final textures to match its current config.
+// Caller must hold g_mirrorInstancesMutex exclusively and have a GL context that shares the mirror textures.
+static void EnsureMirrorBackBufferSizes(MirrorInstance* inst, const ThreadedMirrorConfig& conf) {
+    // Capture (pass 1) textures: capture size plus dynamic border padding on each side
+    int borderPadding = (conf.borderType == MirrorBorderType::Dynamic) ? conf.dynamicBorderThickness : 0;
+    int requiredFboW = conf.captureWidth + 2 * borderPadding;
+    int requiredFboH = conf.captureHeight + 2 * borderPadding;
+
+    if (inst->fbo_w != requiredFboW || inst->fbo_h != requiredFboH) {
+        // Resize both front and back buffers
+        inst->fbo_w = requiredFboW;
+        inst->fbo_h = requiredFboH;
+        inst->forceUpdateFrames = 3;
+
+        // Resize front texture - use NEAREST for sharp pixel-perfect scaling (front/back get swapped)
+        glBindTexture(GL_TEXTURE_2D, inst->fboTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, inst->fbo_w, inst->fbo_h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        // Resize back texture
+        // Use GL_NEAREST for sharp pixel-perfect scaling
+        glBindTexture(GL_TEXTURE_2D, inst->fboTextureBack);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, inst->fbo_w, inst->fbo_h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        const uint64_t captureBytes = GpuTextureBytes(inst->fbo_w, inst->fbo_h);
+        GpuResourceManager::Get().SetBytes(inst->fboTextureHandle, captureBytes);
+        GpuResourceManager::Get().SetBytes(inst->fboTextureBackHandle, captureBytes);
+    }
+
+    // === FINAL FBO RESIZE: Also resize the final (screen-ready) FBOs ===
+    // These are sized to match output dimensions (fbo_w * scaleX, fbo_h * scaleY)
+    float finalScaleX = conf.outputSeparateScale ? conf.outputScaleX : conf.outputScale;
+    float finalScaleY = conf.outputSeparateScale ? conf.outputScaleY : conf.outputScale;
+    int requiredFinalW = static_cast<int>(inst->fbo_w * finalScaleX);
+    int requiredFinalH = static_cast<int>(inst->fbo_h * finalScaleY);
+
+    if (inst->final_w_back != requiredFinalW || inst->final_h_back != requiredFinalH) {
+        // Only resize BACK buffer now - front buffer keeps old content to avoid flicker
+        // Front buffer dimensions are preserved, will be updated in SwapMirrorBuffers
+
+        // Resize back final texture only
+        glBindTexture(GL_TEXTURE_2D, inst->finalTextureBack);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, requiredFinalW, requiredFinalH, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        // Track back buffer dimensions separately
+        inst->final_w_back = requiredFinalW;
+        inst->final_h_back = requiredFinalH;
+        GpuResourceManager::Get().SetBytes(inst->finalTextureBackHandle, GpuTextureBytes(requiredFinalW, requiredFinalH));
+
+        // Invalidate back cache since dimensions changed (front cache stays valid until swap)
+        inst->cachedRenderStateBack.isValid = false;
+    }
+}
+
+static void RenderMirrorFinalPass(MirrorInstance* inst, const ThreadedMirrorConfig& conf, GLuint captureVAO, GLuint captureVBO,
+                                  GLuint captureFinalBackFbo);
+
 // Helper: Render a single mirror to its back buffer
 // Returns true if rendering succeeded
 static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorConfig& conf, GLuint validCopyTexture, GLuint captureVAO,
                                      GLuint captureVBO, GLuint captureBackFbo, GLuint captureFinalBackFbo, MirrorGammaMode gammaMode,
                                      int gameW, int gameH) {
     PROFILE_SCOPE_CAT("Capture Single Mirror", "Mirror Thread");
+    PROFILE_GPU_SCOPE("Capture Single Mirror");
 
     // Capture to back buffer
     glBindFramebuffer(GL_FRAMEBUFFER, captureBackFbo);
@@ -1027,10 +1119,26 @@ static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorC
     bool useRawOutput = inst->desiredRawOutput.load(std::memory_order_acquire);
     bool useColorPassthrough = conf.colorPassthrough;
 
+    // Precomputed match table for this mirror's colors (-1 = not built yet, use the per-pixel loop)
+    int matchLutLayer = useRawOutput ? -1 : MT_GetMatchLutLayer(conf, gammaMode);
+
     // Use appropriate shader (local shader programs - not shared between GL contexts)
     if (useRawOutput) {
         glUseProgram(mt_passthroughProgram);
         glUniform1i(mt_passthroughShaderLocs.screenTexture, 0);
+    } else if (matchLutLayer >= 0) {
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, mt_matchLutArray);
+        glActiveTexture(GL_TEXTURE0);
+        if (useColorPassthrough) {
+            glUseProgram(mt_filterPassthroughLutProgram);
+            glUniform1i(mt_filterPassthroughLutShaderLocs.matchLutLayer, matchLutLayer);
+        } else {
+            glUseProgram(mt_filterLutProgram);
+            glUniform1i(mt_filterLutShaderLocs.matchLutLayer, matchLutLayer);
+            glUniform4f(mt_filterLutShaderLocs.outputColor, conf.outputColor.r, conf.outputColor.g, conf.outputColor.b,
+                        conf.outputColor.a);
+        }
     } else if (useColorPassthrough) {
         // Color passthrough mode: output original pixel color when matching target colors
         glUseProgram(mt_filterPassthroughProgram);
@@ -1039,8 +1147,7 @@ static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorC
             glUniform1i(mt_filterPassthroughShaderLocs.gammaMode, static_cast<int>(gammaMode));
         }
 
-        // Pass multiple target colors to shader (max 8)
-        int colorCount = (std::min)(static_cast<int>(conf.targetColors.size()), 8);
+        int colorCount = MT_LoopTargetColorCount(conf);
         glUniform1i(mt_filterPassthroughShaderLocs.targetColorCount, colorCount);
 
         // Set each target color in the array
@@ -1057,8 +1164,7 @@ static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorC
             glUniform1i(mt_filterShaderLocs.gammaMode, static_cast<int>(gammaMode));
         }
 
-        // Pass multiple target colors to shader (max 8)
-        int colorCount = (std::min)(static_cast<int>(conf.targetColors.size()), 8);
+        int colorCount = MT_LoopTargetColorCount(conf);
         glUniform1i(mt_filterShaderLocs.targetColorCount, colorCount);
 
         // Set each target color in the array
@@ -1105,6 +1211,9 @@ static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorC
 
         if (useRawOutput) {
             glUniform4f(mt_passthroughShaderLocs.sourceRect, sx, sy, sw, sh);
+        } else if (matchLutLayer >= 0) {
+            glUniform4f(useColorPassthrough ? mt_filterPassthroughLutShaderLocs.sourceRect : mt_filterLutShaderLocs.sourceRect, sx, sy,
+                        sw, sh);
         } else if (useColorPassthrough) {
             glUniform4f(mt_filterPassthroughShaderLocs.sourceRect, sx, sy, sw, sh);
         } else {
@@ -1115,6 +1224,11 @@ static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorC
 
     // Reset GL state after pass 1
     glDisable(GL_BLEND);
+    if (matchLutLayer >= 0) {
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        glActiveTexture(GL_TEXTURE0);
+    }
 
     // === Content Detection: Async PBO readback for non-zero alpha check ===
     // This is used by static borders to avoid rendering when mirror has no matching pixels.
@@ -1128,9 +1242,22 @@ static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorC
     // else: hasFrameContentBack keeps its previous value until async readback updates it
     // (the async readback initiation and harvest happens in the caller after this function)
 
-    // === PASS 2: Apply border shader and render to final texture ===
-    // This produces screen-ready content so render thread just needs to blit.
-    // IMPORTANT: Use the mirror-thread-local FBO (framebuffer objects may not be shared across contexts).
+    RenderMirrorFinalPass(inst, conf, captureVAO, captureVBO, captureFinalBackFbo);
+    return true;
+}
+
+// === PASS 2: Apply border shader and render to final texture ===
+// Reads inst->fboTextureBack (pass 1 output) and produces screen-ready content so render thread just needs to blit.
+// IMPORTANT: Use the mirror-thread-local FBO (framebuffer objects may not be shared across contexts).
+static void RenderMirrorFinalPass(MirrorInstance* inst, const ThreadedMirrorConfig& conf, GLuint captureVAO, GLuint captureVBO,
+                                  GLuint captureFinalBackFbo) {
+    bool useRawOutput = inst->desiredRawOutput.load(std::memory_order_acquire);
+    bool useColorPassthrough = conf.colorPassthrough;
+
+    glBindVertexArray(captureVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, captureVBO);
+    glActiveTexture(GL_TEXTURE0);
+
     if (captureFinalBackFbo != 0 && inst->finalTextureBack != 0) {
         PROFILE_SCOPE_CAT("Apply Border Shader", "Mirror Thread");
 
@@ -1208,14 +1335,738 @@ static bool RenderMirrorToBackBuffer(MirrorInstance* inst, const ThreadedMirrorC
         // NOTE: Static border is rendered in render_thread.cpp after mirror compositing
         // to allow the border to extend beyond the mirror bounds
     }
+}
+
+// ============================================================================
+// BATCHED CAPTURE PASS
+// Pass 1 of all eligible mirrors is drawn with a single instanced draw into a shared atlas texture,
+// then each mirror's slot is blitted into its own fboTextureBack. Pass 2, content detection and the
+// front/back swap are unchanged, so the render thread still sees one texture pair per mirror.
+// Eligible: raw output mirrors, and filter mirrors whose match table is ready. Everything else
+// (tables still settling, atlas full, batch shader unavailable) goes through RenderMirrorToBackBuffer.
+// ============================================================================
+
+struct MT_BatchMirror {
+    MirrorInstance* inst = nullptr;
+    const ThreadedMirrorConfig* conf = nullptr;
+    MirrorHandle instHandle; // Current slot of inst (see MT_FindMirrorInstance)
+    GLuint backFbo = 0;
+    GLuint finalBackFbo = 0;
+    bool batched = false; // Pass 1 done by the batch (set by MT_RenderBatchedCapturePass)
+    uint64_t stateKey = 0;  // Instance state the output depends on (sizes, textures, raw output)
+    uint64_t signature = 0; // Input signature, valid if hasSignature (see mirror_signature.h)
+    bool hasSignature = false;
+};
+
+static GLuint mt_batchVAO = 0;
+static GLuint mt_batchCornerVBO = 0;
+static GLuint mt_batchInstanceVBO = 0;
+static GLuint mt_batchAtlasTexture = 0;
+static GLuint mt_batchAtlasFbo = 0;
+static int mt_batchAtlasW = 0, mt_batchAtlasH = 0;
+
+static constexpr int MT_BATCH_ATLAS_MIN_WIDTH = 1024;
+
+// Region cache: each distinct game region sampled this frame, copied once (see capture_regions.h)
+static GLuint mt_regionCacheTexture = 0;
+static GLuint mt_regionCacheFbo = 0;
+static GLuint mt_regionCacheReadFbo = 0; // Attaches the game copy texture as blit source
+static int mt_regionCacheW = 0, mt_regionCacheH = 0;
+
+static bool MT_EnsureBatchResources(int atlasW, int atlasH) {
+    if (mt_batchVAO == 0) {
+        static const float corners[] = { 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1 };
+        glGenVertexArrays(1, &mt_batchVAO);
+        glGenBuffers(1, &mt_batchCornerVBO);
+        glGenBuffers(1, &mt_batchInstanceVBO);
+        glBindVertexArray(mt_batchVAO);
+
+        glBindBuffer(GL_ARRAY_BUFFER, mt_batchCornerVBO);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+
+        const GLsizei stride = MT_BATCH_INSTANCE_FLOATS * sizeof(float);
+        glBindBuffer(GL_ARRAY_BUFFER, mt_batchInstanceVBO);
+        for (int i = 0; i < 4; i++) {
+            GLuint loc = 2 + i;
+            glVertexAttribPointer(loc, i == 3 ? 3 : 4, GL_FLOAT, GL_FALSE, stride, (void*)(i * 4 * sizeof(float)));
+            glEnableVertexAttribArray(loc);
+            glVertexAttribDivisor(loc, 1);
+        }
+        glBindVertexArray(0);
+    }
+
+    if (atlasW <= mt_batchAtlasW && atlasH <= mt_batchAtlasH && mt_batchAtlasTexture != 0) return true;
+
+    // Grow only - mirror sizes rarely shrink and reallocating every config change isn't worth it
+    int newW = (std::max)(atlasW, mt_batchAtlasW);
+    int newH = (std::max)(atlasH, mt_batchAtlasH);
+    if (mt_batchAtlasTexture == 0) { glGenTextures(1, &mt_batchAtlasTexture); }
+    if (mt_batchAtlasFbo == 0) { glGenFramebuffers(1, &mt_batchAtlasFbo); }
 
+    glBindTexture(GL_TEXTURE_2D, mt_batchAtlasTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, newW, newH, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, mt_batchAtlasFbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mt_batchAtlasTexture, 0);
+    GLenum st = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (st != GL_FRAMEBUFFER_COMPLETE) {
+        Log("Mirror Capture Thread: capture atlas FBO incomplete (status " + std::to_string(st) + ")");
+        mt_batchAtlasW = mt_batchAtlasH = 0;
+        return false;
+    }
+
+    mt_batchAtlasW = newW;
+    mt_batchAtlasH = newH;
+    LogCategory("texture_ops", "Mirror Capture Thread: capture atlas resized to " + std::to_string(newW) + "x" + std::to_string(newH));
     return true;
 }
 
+// Copy every region of the plan from the game copy texture into the region cache (grow-only texture)
+static bool MT_FillRegionCache(const CaptureRegionPlan& plan, GLuint validCopyTexture) {
+    if (plan.regions.empty() || plan.cacheW <= 0 || plan.cacheH <= 0) return false;
+
+    if (mt_regionCacheFbo == 0) { glGenFramebuffers(1, &mt_regionCacheFbo); }
+    if (mt_regionCacheReadFbo == 0) { glGenFramebuffers(1, &mt_regionCacheReadFbo); }
+    if (plan.cacheW > mt_regionCacheW || plan.cacheH > mt_regionCacheH || mt_regionCacheTexture == 0) {
+        int newW = (std::max)(plan.cacheW, mt_regionCacheW);
+        int newH = (std::max)(plan.cacheH, mt_regionCacheH);
+        if (mt_regionCacheTexture == 0) { glGenTextures(1, &mt_regionCacheTexture); }
+        glBindTexture(GL_TEXTURE_2D, mt_regionCacheTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, newW, newH, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, mt_regionCacheFbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mt_regionCacheTexture, 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            mt_regionCacheW = mt_regionCacheH = 0;
+            return false;
+        }
+        mt_regionCacheW = newW;
+        mt_regionCacheH = newH;
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, mt_regionCacheReadFbo);
+    glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, validCopyTexture, 0);
+    if (glCheckFramebufferStatus(GL_READ_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        return false;
+    }
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mt_regionCacheFbo);
+    for (size_t i = 0; i < plan.regions.size(); i++) {
+        const CaptureRect& src = plan.regions[i];
+        const CaptureRect& dst = plan.packed[i];
+        glBlitFramebuffer(src.x, src.y, src.Right(), src.Top(), dst.x, dst.y, dst.Right(), dst.Top(), GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    }
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    return true;
+}
+
+static void MT_CleanupBatchResources() {
+    if (mt_batchVAO) { glDeleteVertexArrays(1, &mt_batchVAO); }
+    if (mt_batchCornerVBO) { glDeleteBuffers(1, &mt_batchCornerVBO); }
+    if (mt_batchInstanceVBO) { glDeleteBuffers(1, &mt_batchInstanceVBO); }
+    if (mt_batchAtlasFbo) { glDeleteFramebuffers(1, &mt_batchAtlasFbo); }
+    if (mt_batchAtlasTexture) { glDeleteTextures(1, &mt_batchAtlasTexture); }
+    mt_batchVAO = mt_batchCornerVBO = mt_batchInstanceVBO = mt_batchAtlasFbo = mt_batchAtlasTexture = 0;
+    mt_batchAtlasW = mt_batchAtlasH = 0;
+
+    if (mt_regionCacheFbo) { glDeleteFramebuffers(1, &mt_regionCacheFbo); }
+    if (mt_regionCacheReadFbo) { glDeleteFramebuffers(1, &mt_regionCacheReadFbo); }
+    if (mt_regionCacheTexture) { glDeleteTextures(1, &mt_regionCacheTexture); }
+    mt_regionCacheFbo = mt_regionCacheReadFbo = mt_regionCacheTexture = 0;
+    mt_regionCacheW = mt_regionCacheH = 0;
+}
+
+// Render pass 1 for all eligible mirrors in one draw. Sets MT_BatchMirror::batched for the mirrors it handled.
+static void MT_RenderBatchedCapturePass(std::vector<MT_BatchMirror>& mirrors, GLuint validCopyTexture, MirrorGammaMode gammaMode, int gameW,
+                                        int gameH) {
+    if (!mt_batchProgram || mirrors.size() < 2) return;
+    PROFILE_SCOPE_CAT("Batched Capture Pass", "Mirror Thread");
+    PROFILE_GPU_SCOPE("Batched Capture Pass");
+
+    struct Slot {
+        size_t index;
+        int mode, layer;
+        int x = 0, y = 0;
+    };
+    std::vector<Slot> slots;
+    slots.reserve(mirrors.size());
+    for (size_t i = 0; i < mirrors.size(); i++) {
+        const MT_BatchMirror& m = mirrors[i];
+        if (m.conf->input.empty() || m.inst->fbo_w <= 0 || m.inst->fbo_h <= 0) continue;
+        if (m.inst->desiredRawOutput.load(std::memory_order_acquire)) {
+            slots.push_back({ i, 0, 0 });
+        } else {
+            int layer = MT_GetMatchLutLayer(*m.conf, gammaMode);
+            if (layer < 0) continue;
+            slots.push_back({ i, m.conf->colorPassthrough ? 2 : 1, layer });
+        }
+    }
+    if (slots.size() < 2) return;
+
+    // Shelf packing, tallest first
+    GLint maxTexSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTexSize);
+    if (maxTexSize <= 0) return;
+    std::sort(slots.begin(), slots.end(), [&](const Slot& a, const Slot& b) { return mirrors[a.index].inst->fbo_h > mirrors[b.index].inst->fbo_h; });
+    int atlasW = MT_BATCH_ATLAS_MIN_WIDTH;
+    for (const auto& sl : slots) { atlasW = (std::max)(atlasW, mirrors[sl.index].inst->fbo_w); }
+    atlasW = (std::min)(atlasW, static_cast<int>(maxTexSize));
+
+    int cursorX = 0, cursorY = 0, shelfH = 0;
+    size_t placed = 0;
+    for (; placed < slots.size(); placed++) {
+        Slot& sl = slots[placed];
+        int w = mirrors[sl.index].inst->fbo_w;
+        int h = mirrors[sl.index].inst->fbo_h;
+        if (w > atlasW) break;
+        if (cursorX + w > atlasW) {
+            cursorY += shelfH;
+            cursorX = 0;
+            shelfH = 0;
+        }
+        if (cursorY + h > maxTexSize) break;
+        sl.x = cursorX;
+        sl.y = cursorY;
+        cursorX += w;
+        shelfH = (std::max)(shelfH, h);
+    }
+    slots.resize(placed); // Mirrors that didn't fit render individually
+    if (slots.size() < 2) return;
+    int atlasH = cursorY + shelfH;
+
+    if (!MT_EnsureBatchResources(atlasW, atlasH)) return;
+
+    // One instance per input region. Raw mirrors draw without blending in the per-mirror path, so only their
+    // last region is visible there - emit just that one, which the additive blend over a cleared atlas copies exactly.
+    static std::vector<CaptureRect> s_sourceRects;
+    static std::vector<float> s_instances;
+    s_sourceRects.clear();
+    s_instances.clear();
+    for (const auto& sl : slots) {
+        const ThreadedMirrorConfig& conf = *mirrors[sl.index].conf;
+        int padding = (conf.borderType == MirrorBorderType::Dynamic) ? conf.dynamicBorderThickness : 0;
+        size_t first = (sl.mode == 0) ? conf.input.size() - 1 : 0;
+        for (size_t r = first; r < conf.input.size(); r++) {
+            const auto& in = conf.input[r];
+            int capX, capY;
+            GetRelativeCoords(in.relativeTo, in.x, in.y, conf.captureWidth, conf.captureHeight, gameW, gameH, capX, capY);
+            int capY_gl = gameH - capY - conf.captureHeight;
+            // Rects reaching outside the game frame keep sampling the game texture so edge clamping stays identical
+            bool inside = capX >= 0 && capY_gl >= 0 && capX + conf.captureWidth <= gameW && capY_gl + conf.captureHeight <= gameH;
+            if (inside) {
+                s_sourceRects.push_back({ capX, capY_gl, conf.captureWidth, conf.captureHeight });
+            } else {
+                s_sourceRects.push_back({}); // Empty rect - not part of the region plan
+            }
+            const float inst[MT_BATCH_INSTANCE_FLOATS] = {
+                static_cast<float>(sl.x + padding),
+                static_cast<float>(sl.y + padding),
+                static_cast<float>(conf.captureWidth),
+                static_cast<float>(conf.captureHeight),
+                static_cast<float>(capX) / gameW,
+                static_cast<float>(capY_gl) / gameH,
+                static_cast<float>(conf.captureWidth) / gameW,
+                static_cast<float>(conf.captureHeight) / gameH,
+                conf.outputColor.r,
+                conf.outputColor.g,
+                conf.outputColor.b,
+                conf.outputColor.a,
+                static_cast<float>(sl.mode),
+                static_cast<float>(sl.layer),
+                0.0f, // Source: 0 = game texture, 1 = region cache
+                0.0f,
+            };
+            s_instances.insert(s_instances.end(), inst, inst + MT_BATCH_INSTANCE_FLOATS);
+        }
+    }
+    GLsizei instanceCount = static_cast<GLsizei>(s_instances.size() / MT_BATCH_INSTANCE_FLOATS);
+
+    // Shared regions: when mirrors overlap, copy each distinct region once and sample the compact cache instead
+    static CaptureRegionPlan s_plan;
+    BuildCaptureRegionPlan(s_sourceRects, gameW, gameH, MT_BATCH_ATLAS_MIN_WIDTH, s_plan);
+    bool useRegionCache = false;
+    if (s_plan.mergedArea < s_plan.inputArea) {
+        PROFILE_SCOPE_CAT("Fill Region Cache", "Mirror Thread");
+        useRegionCache = MT_FillRegionCache(s_plan, validCopyTexture);
+    }
+    if (useRegionCache) {
+        for (size_t i = 0; i < s_sourceRects.size(); i++) {
+            const CaptureRegionRef& ref = s_plan.refs[i];
+            if (ref.region < 0) continue;
+            const CaptureRect& packed = s_plan.packed[ref.region];
+            float* inst = &s_instances[i * MT_BATCH_INSTANCE_FLOATS];
+            inst[4] = static_cast<float>(packed.x + ref.offsetX) / mt_regionCacheW;
+            inst[5] = static_cast<float>(packed.y + ref.offsetY) / mt_regionCacheH;
+            inst[6] = static_cast<float>(s_sourceRects[i].w) / mt_regionCacheW;
+            inst[7] = static_cast<float>(s_sourceRects[i].h) / mt_regionCacheH;
+            inst[14] = 1.0f;
+        }
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, mt_batchAtlasFbo);
+    if (oglViewport)
+        oglViewport(0, 0, mt_batchAtlasW, mt_batchAtlasH);
+    else
+        glViewport(0, 0, mt_batchAtlasW, mt_batchAtlasH);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_STENCIL_TEST);
+    glDisable(GL_SCISSOR_TEST);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, useRegionCache ? mt_regionCacheTexture : 0);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, mt_matchLutArray);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, validCopyTexture);
+
+    glUseProgram(mt_batchProgram);
+    glUniform2f(mt_batchShaderLocs.atlasSize, static_cast<float>(mt_batchAtlasW), static_cast<float>(mt_batchAtlasH));
+
+    glBindVertexArray(mt_batchVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, mt_batchInstanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, s_instances.size() * sizeof(float), s_instances.data(), GL_STREAM_DRAW);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 6, instanceCount);
+    glDisable(GL_BLEND);
+
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    glActiveTexture(GL_TEXTURE0);
+
+    // Copy each slot into the mirror's own pass 1 texture
+    {
+        PROFILE_SCOPE_CAT("Copy Atlas Slots", "Mirror Thread");
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, mt_batchAtlasFbo);
+        for (const auto& sl : slots) {
+            MT_BatchMirror& m = mirrors[sl.index];
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m.backFbo);
+            glBlitFramebuffer(sl.x, sl.y, sl.x + m.inst->fbo_w, sl.y + m.inst->fbo_h, 0, 0, m.inst->fbo_w, m.inst->fbo_h,
+                              GL_COLOR_BUFFER_BIT, GL_NEAREST);
+            if (sl.mode == 0) { m.inst->hasFrameContentBack = true; }
+            m.batched = true;
+        }
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    }
+}
+
+// ============================================================================
+// UNCHANGED-INPUT DETECTION
+// Every due mirror's input regions are reduced to cell hashes in one small R32UI render target, which is
+// read back synchronously (64 uints per region). The copy texture is already complete when mirrors are
+// processed, so the wait only covers these few tiny draws. See mirror_signature.h for the policy.
+// ============================================================================
+
+static_assert(MIRROR_SIGNATURE_GRID == 8, "mt_signature_frag_shader hardcodes GRID = 8");
+
+static constexpr int MT_SIGNATURE_COLUMNS = 64; // Regions per row of the signature texture
+
+static GLuint mt_signatureTexture = 0;
+static GLuint mt_signatureFbo = 0;
+static int mt_signatureW = 0, mt_signatureH = 0;
+
+static void MT_CleanupSignatureResources() {
+    if (mt_signatureFbo) { glDeleteFramebuffers(1, &mt_signatureFbo); }
+    if (mt_signatureTexture) { glDeleteTextures(1, &mt_signatureTexture); }
+    mt_signatureFbo = mt_signatureTexture = 0;
+    mt_signatureW = mt_signatureH = 0;
+}
+
+static uint64_t MT_PackPair(int a, int b) { return static_cast<uint64_t>(static_cast<uint32_t>(a)) << 32 | static_cast<uint32_t>(b); }
+
+// Output state a mirror's capture depends on besides its inputs. Call with g_mirrorInstancesMutex held.
+// Front/back textures are folded order-independently so a buffer swap doesn't change the key.
+static uint64_t MT_MirrorStateKey(const MirrorInstance* inst) {
+    auto texturePair = [](GLuint a, GLuint b) {
+        return static_cast<uint64_t>((std::min)(a, b)) << 32 | (std::max)(a, b);
+    };
+    uint64_t h = MirrorSignatureMix(MIRROR_SIGNATURE_BASIS, MT_PackPair(inst->fbo_w, inst->fbo_h));
+    h = MirrorSignatureMix(h, MT_PackPair(inst->final_w_back, inst->final_h_back));
+    h = MirrorSignatureMix(h, texturePair(inst->fboTexture, inst->fboTextureBack));
+    h = MirrorSignatureMix(h, texturePair(inst->finalTexture, inst->finalTextureBack));
+    return MirrorSignatureMix(h, inst->desiredRawOutput.load(std::memory_order_acquire) ? 1 : 0);
+}
+
+// Frame-wide state every mirror's output depends on besides its inputs: gamma mode, game size, screen geometry
+static uint64_t MT_FrameStateKey(MirrorGammaMode gammaMode, int gameW, int gameH) {
+    uint64_t h = MirrorSignatureMix(MIRROR_SIGNATURE_BASIS, static_cast<uint64_t>(gammaMode));
+    h = MirrorSignatureMix(h, MT_PackPair(gameW, gameH));
+    h = MirrorSignatureMix(h, MT_PackPair(g_captureScreenW.load(std::memory_order_acquire), g_captureScreenH.load(std::memory_order_acquire)));
+    h = MirrorSignatureMix(h, MT_PackPair(g_captureFinalX.load(std::memory_order_acquire), g_captureFinalY.load(std::memory_order_acquire)));
+    return MirrorSignatureMix(h, MT_PackPair(g_captureFinalW.load(std::memory_order_acquire), g_captureFinalH.load(std::memory_order_acquire)));
+}
+
+// Cell hashes for each rect (MIRROR_SIGNATURE_CELLS per rect, in rect order). False if the pass is unavailable.
+static bool MT_ComputeRegionSignatures(const std::vector<CaptureRect>& rects, GLuint gameTexture, int gameW, int gameH, GLuint vao,
+                                       std::vector<uint32_t>& outCells) {
+    if (!mt_signatureProgram || rects.empty()) return false;
+    PROFILE_SCOPE_CAT("Input Signatures", "Mirror Thread");
+
+    const int count = static_cast<int>(rects.size());
+    const int columns = (std::min)(count, MT_SIGNATURE_COLUMNS);
+    const int rows = (count + MT_SIGNATURE_COLUMNS - 1) / MT_SIGNATURE_COLUMNS;
+    const int texW = columns * MIRROR_SIGNATURE_GRID, texH = rows * MIRROR_SIGNATURE_GRID;
+
+    if (texW > mt_signatureW || texH > mt_signatureH) {
+        mt_signatureW = (std::max)(texW, mt_signatureW);
+        mt_signatureH = (std::max)(texH, mt_signatureH);
+        if (!mt_signatureTexture) { glGenTextures(1, &mt_signatureTexture); }
+        glBindTexture(GL_TEXTURE_2D, mt_signatureTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, mt_signatureW, mt_signatureH, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        if (!mt_signatureFbo) { glGenFramebuffers(1, &mt_signatureFbo); }
+        glBindFramebuffer(GL_FRAMEBUFFER, mt_signatureFbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mt_signatureTexture, 0);
+        GLenum st = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        if (st != GL_FRAMEBUFFER_COMPLETE) {
+            Log("Mirror Capture Thread: signature FBO incomplete (status " + std::to_string(st) + "), disabling unchanged-mirror skipping");
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            MT_CleanupSignatureResources();
+            glDeleteProgram(mt_signatureProgram);
+            mt_signatureProgram = 0;
+            return false;
+        }
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, mt_signatureFbo);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_STENCIL_TEST);
+    glDisable(GL_SCISSOR_TEST);
+    glDisable(GL_BLEND);
+    glUseProgram(mt_signatureProgram);
+    glUniform2i(mt_signatureShaderLocs.gameSize, gameW, gameH);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, gameTexture);
+    glBindVertexArray(vao);
+    for (int i = 0; i < count; i++) {
+        const CaptureRect& r = rects[i];
+        const int cellX = (i % MT_SIGNATURE_COLUMNS) * MIRROR_SIGNATURE_GRID;
+        const int cellY = (i / MT_SIGNATURE_COLUMNS) * MIRROR_SIGNATURE_GRID;
+        if (oglViewport)
+            oglViewport(cellX, cellY, MIRROR_SIGNATURE_GRID, MIRROR_SIGNATURE_GRID);
+        else
+            glViewport(cellX, cellY, MIRROR_SIGNATURE_GRID, MIRROR_SIGNATURE_GRID);
+        glUniform4i(mt_signatureShaderLocs.region, r.x, r.y, r.w, r.h);
+        glUniform2i(mt_signatureShaderLocs.cellOrigin, cellX, cellY);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+    }
+
+    // Synchronous, but only texW * texH * 4 bytes
+    static std::vector<uint32_t> s_readback;
+    s_readback.resize(static_cast<size_t>(texW) * texH);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, texW, texH, GL_RED_INTEGER, GL_UNSIGNED_INT, s_readback.data());
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    outCells.resize(static_cast<size_t>(count) * MIRROR_SIGNATURE_CELLS);
+    for (int i = 0; i < count; i++) {
+        const int cellX = (i % MT_SIGNATURE_COLUMNS) * MIRROR_SIGNATURE_GRID;
+        const int cellY = (i / MT_SIGNATURE_COLUMNS) * MIRROR_SIGNATURE_GRID;
+        for (int cy = 0; cy < MIRROR_SIGNATURE_GRID; cy++) {
+            const uint32_t* row = s_readback.data() + static_cast<size_t>(cellY + cy) * texW + cellX;
+            std::copy(row, row + MIRROR_SIGNATURE_GRID, outCells.begin() + static_cast<size_t>(i) * MIRROR_SIGNATURE_CELLS + cy * MIRROR_SIGNATURE_GRID);
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// CPU FALLBACK
+// When the capture thread cannot get a GL context that shares objects with the game
+// (InitializeSharedContexts and the wglShareLists fallback both failed), mirrors are filtered
+// on the CPU with mirror_filter.h instead. This runs on the game thread from the SwapBuffers hook,
+// so it only reads back the distinct regions (capture_regions.h) the due mirrors actually sample, all
+// into one pixel pack buffer: the game thread waits for the GPU once per frame, not once per region.
+// ============================================================================
+
+static std::atomic<bool> g_mirrorCpuFallbackActive{ false };
+
+bool IsMirrorCpuFallbackActive() { return g_mirrorCpuFallbackActive.load(std::memory_order_acquire); }
+
+// Input regions of a mirror in GL (bottom-up) game-texture coordinates
+static void GetMirrorFilterRegions(const ThreadedMirrorConfig& conf, int gameW, int gameH, std::vector<MirrorFilterRegion>& outRegions) {
+    outRegions.clear();
+    outRegions.reserve(conf.input.size());
+    for (const auto& r : conf.input) {
+        int capX, capY;
+        GetRelativeCoords(r.relativeTo, r.x, r.y, conf.captureWidth, conf.captureHeight, gameW, gameH, capX, capY);
+        outRegions.push_back({ capX, gameH - capY - conf.captureHeight });
+    }
+}
+
+// Filter settings of a mirror in mirror_filter.h form
+static MirrorFilterParams MT_FilterParams(const ThreadedMirrorConfig& conf, MirrorGammaMode gammaMode) {
+    MirrorFilterParams params;
+    params.targetColors = conf.targetColors;
+    params.outputColor = conf.outputColor;
+    params.borderColor = conf.borderColor;
+    params.sensitivity = conf.colorSensitivity;
+    params.gammaMode = gammaMode;
+    params.colorPassthrough = conf.colorPassthrough;
+    params.borderType = conf.borderType;
+    params.dynamicBorderThickness = conf.dynamicBorderThickness;
+    return params;
+}
+
+void RunMirrorCpuFallback(GLuint gameTexture, int gameW, int gameH) {
+    PROFILE_SCOPE_CAT("Mirror CPU Fallback", "Mirror Thread");
+    if (gameW <= 0 || gameH <= 0) return;
+
+    auto configsSnapshot = GetThreadedMirrorConfigs();
+    const ThreadedMirrorConfigList& configs = *configsSnapshot;
+    if (configs.empty()) return;
+
+    auto now = std::chrono::steady_clock::now();
+    MirrorGammaMode gammaMode = GetGlobalMirrorGammaMode();
+
+    // CRITICAL: Preserve GL state - this runs on the game's GL context from SwapBuffers.
+    GLint prevReadFBO = 0, prevTexture2D = 0, prevPackBuffer = 0, prevUnpackBuffer = 0;
+    GLint prevPackAlignment = 4, prevUnpackAlignment = 4, prevPackRowLength = 0, prevUnpackRowLength = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevReadFBO);
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &prevTexture2D);
+    glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &prevPackBuffer);
+    glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &prevUnpackBuffer);
+    glGetIntegerv(GL_PACK_ALIGNMENT, &prevPackAlignment);
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &prevUnpackAlignment);
+    glGetIntegerv(GL_PACK_ROW_LENGTH, &prevPackRowLength);
+    glGetIntegerv(GL_UNPACK_ROW_LENGTH, &prevUnpackRowLength);
+
+    auto restoreState = [&]() {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, prevReadFBO);
+        glBindTexture(GL_TEXTURE_2D, prevTexture2D);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, prevPackBuffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, prevUnpackBuffer);
+        glPixelStorei(GL_PACK_ALIGNMENT, prevPackAlignment);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, prevUnpackAlignment);
+        glPixelStorei(GL_PACK_ROW_LENGTH, prevPackRowLength);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, prevUnpackRowLength);
+    };
+
+    static GLuint s_readFbo = 0;
+    if (s_readFbo == 0) { glGenFramebuffers(1, &s_readFbo); }
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, s_readFbo);
+    glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, gameTexture, 0);
+    if (glCheckFramebufferStatus(GL_READ_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        // Game texture is being recreated (WM_SIZE) - try again next frame
+        restoreState();
+        return;
+    }
+
+    // Client-memory transfers with tightly packed RGBA rows
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+    // Reused across frames (game thread only)
+    static GLuint s_packBuffer = 0;
+    static size_t s_packBufferSize = 0;
+    static std::vector<uint8_t> s_readback;
+    static std::vector<MirrorFilterSource> s_regionSources;
+    static std::vector<MirrorFilterRegion> s_regions;
+    static std::vector<CaptureRect> s_inputRects;
+    static CaptureRegionPlan s_plan;
+    static MirrorFilterImage s_capture;
+    static MirrorFilterImage s_final;
+    static MirrorMatchLutCache s_matchLuts(4, 150);
+    static MirrorFilterMatcherCache s_matchers;
+    static MirrorUpdateScheduler s_scheduler;
+    static MirrorSignatureCache s_signatures;
+    static std::shared_ptr<const ThreadedMirrorConfigList> s_signatureConfigs;
+    if (configsSnapshot != s_signatureConfigs) {
+        s_signatures.Clear();
+        s_signatureConfigs = configsSnapshot;
+    }
+
+    // Mirrors due this frame and where their input rects start in s_inputRects
+    std::vector<std::pair<const ThreadedMirrorConfig*, size_t>> due;
+    s_inputRects.clear();
+    for (const auto& conf : configs) {
+        if (!s_scheduler.IsDue(conf.handle, conf.fps, now)) continue;
+        if (conf.input.empty() || conf.captureWidth <= 0 || conf.captureHeight <= 0) continue;
+
+        due.push_back({ &conf, s_inputRects.size() });
+        GetMirrorFilterRegions(conf, gameW, gameH, s_regions);
+        for (const auto& r : s_regions) { s_inputRects.push_back({ r.x, r.y, conf.captureWidth, conf.captureHeight }); }
+    }
+    if (due.empty()) {
+        restoreState();
+        return;
+    }
+
+    // One readback per distinct region, shared by every mirror sampling it
+    BuildCaptureRegionPlan(s_inputRects, gameW, gameH, gameW, s_plan);
+    {
+        PROFILE_SCOPE_CAT("CPU Fallback Readback", "Mirror Thread");
+        const size_t readbackBytes = static_cast<size_t>(s_plan.mergedArea) * 4;
+        s_readback.resize(readbackBytes);
+        s_regionSources.resize(s_plan.regions.size());
+
+        // Reads into a pack buffer are queued without waiting; mapping it is the only sync point
+        if (s_packBuffer == 0) { glGenBuffers(1, &s_packBuffer); }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, s_packBuffer);
+        if (readbackBytes > s_packBufferSize) {
+            glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(readbackBytes), nullptr, GL_STREAM_READ);
+            s_packBufferSize = readbackBytes;
+        }
+        size_t offset = 0;
+        for (const CaptureRect& r : s_plan.regions) {
+            glReadPixels(r.x, r.y, r.w, r.h, GL_RGBA, GL_UNSIGNED_BYTE, reinterpret_cast<void*>(offset));
+            offset += static_cast<size_t>(r.Area()) * 4;
+        }
+        const void* mapped = nullptr;
+        if (readbackBytes > 0) { mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(readbackBytes), GL_MAP_READ_BIT); }
+        if (mapped) {
+            memcpy(s_readback.data(), mapped, readbackBytes);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        if (!mapped && readbackBytes > 0) {
+            // Mapping failed (out of memory, lost context): read straight into client memory instead
+            offset = 0;
+            for (const CaptureRect& r : s_plan.regions) {
+                glReadPixels(r.x, r.y, r.w, r.h, GL_RGBA, GL_UNSIGNED_BYTE, s_readback.data() + offset);
+                offset += static_cast<size_t>(r.Area()) * 4;
+            }
+        }
+
+        offset = 0;
+        for (size_t i = 0; i < s_plan.regions.size(); i++) {
+            const CaptureRect& r = s_plan.regions[i];
+            MirrorFilterSource& src = s_regionSources[i];
+            src.pixels = s_readback.data() + offset;
+            src.width = r.w;
+            src.height = r.h;
+            src.stride = 0;
+            src.originX = r.x;
+            src.originY = r.y;
+            offset += static_cast<size_t>(r.Area()) * 4;
+        }
+    }
+
+    // The regions are already on the CPU, so signatures are computed for every due mirror (no back-off needed)
+    const uint64_t frameKey = MT_FrameStateKey(gammaMode, gameW, gameH);
+    uint32_t unchangedCount = 0;
+
+    bool didCapture = false;
+    for (const auto& [confPtr, firstRect] : due) {
+        const ThreadedMirrorConfig& conf = *confPtr;
+        GetMirrorFilterRegions(conf, gameW, gameH, s_regions);
+        for (size_t k = 0; k < s_regions.size(); k++) {
+            int region = s_plan.refs[firstRect + k].region;
+            s_regions[k].source = region >= 0 ? &s_regionSources[region] : nullptr;
+        }
+
+        MirrorFilterParams params = MT_FilterParams(conf, gammaMode);
+
+        std::unique_lock<std::shared_mutex> lock(g_mirrorInstancesMutex);
+        MirrorHandle instHandle;
+        MirrorInstance* inst = MT_FindMirrorInstance(conf, instHandle);
+        if (!inst) continue;
+        if (!inst->fboTextureBack || !inst->finalTextureBack) continue;
+
+        // Skip if previous capture not yet consumed
+        if (inst->captureReady.load(std::memory_order_acquire)) continue;
+
+        EnsureMirrorBackBufferSizes(inst, conf);
+        params.rawOutput = inst->desiredRawOutput.load(std::memory_order_acquire);
+
+        uint64_t signature = MirrorSignatureMix(frameKey, MT_MirrorStateKey(inst));
+        {
+            PROFILE_SCOPE_CAT("Input Signatures", "Mirror Thread");
+            uint32_t cells[MIRROR_SIGNATURE_CELLS];
+            for (const auto& r : s_regions) {
+                ComputeMirrorSignatureCells(r.source ? *r.source : MirrorFilterSource{}, gameW, gameH,
+                                            { r.x, r.y, conf.captureWidth, conf.captureHeight }, cells);
+                signature = MirrorSignatureMixCells(signature, cells, MIRROR_SIGNATURE_CELLS);
+            }
+        }
+        if (s_signatures.Matches(instHandle, signature)) {
+            s_scheduler.MarkUpdated(conf.handle, now);
+            unchangedCount++;
+            continue;
+        }
+
+        {
+            PROFILE_SCOPE_CAT("CPU Fallback Filter", "Mirror Thread");
+            int padding = (conf.borderType == MirrorBorderType::Dynamic) ? conf.dynamicBorderThickness : 0;
+            if (s_capture.width != inst->fbo_w || s_capture.height != inst->fbo_h) { s_capture.Resize(inst->fbo_w, inst->fbo_h); }
+            MirrorFilterMatcherCache::Entry& cached = s_matchers.Get(instHandle, params);
+            MirrorFilterMatcher& matcher = cached.matcher;
+            if (!params.rawOutput && !matcher.matchNothing) { matcher.lut = s_matchLuts.Get(cached.lutKey); }
+            MirrorFilterCapture(params, matcher, MirrorFilterSource{}, s_regions, conf.captureWidth, conf.captureHeight, padding,
+                                s_capture);
+            matcher.lut.reset(); // s_matchLuts alone decides which tables stay alive
+            MirrorFilterResolve(params, s_capture, inst->final_w_back, inst->final_h_back, s_final);
+        }
+
+        glBindTexture(GL_TEXTURE_2D, inst->fboTextureBack);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, s_capture.width, s_capture.height, GL_RGBA, GL_UNSIGNED_BYTE, s_capture.pixels.data());
+        if (s_final.width > 0 && s_final.height > 0) {
+            glBindTexture(GL_TEXTURE_2D, inst->finalTextureBack);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, s_final.width, s_final.height, GL_RGBA, GL_UNSIGNED_BYTE, s_final.pixels.data());
+        }
+
+        // Content detection is free here - the filtered pixels are already on the CPU
+        inst->hasFrameContentBack = params.rawOutput || MirrorFilterHasContent(s_capture);
+
+        int screenW = g_captureScreenW.load(std::memory_order_acquire);
+        int screenH = g_captureScreenH.load(std::memory_order_acquire);
+        if (screenW > 0 && screenH > 0) {
+            ComputeMirrorRenderCache(inst, conf, gameW, gameH, screenW, screenH, g_captureFinalX.load(std::memory_order_acquire),
+                                     g_captureFinalY.load(std::memory_order_acquire), g_captureFinalW.load(std::memory_order_acquire),
+                                     g_captureFinalH.load(std::memory_order_acquire));
+        }
+
+        inst->capturedAsRawOutputBack = params.rawOutput;
+        if (inst->gpuFenceBack) { glDeleteSync(inst->gpuFenceBack); }
+        inst->gpuFenceBack = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        inst->captureReady.store(true, std::memory_order_release);
+        s_scheduler.MarkUpdated(conf.handle, now);
+        s_signatures.Store(instHandle, signature);
+        didCapture = true;
+    }
+    PROFILE_HITS("Mirrors Skipped (Unchanged Input)", unchangedCount, static_cast<uint32_t>(due.size()));
+
+    restoreState();
+
+    if (didCapture) { glFlush(); }
+}
+
 // Mirror-thread local FBOs.
 // IMPORTANT: Framebuffer objects are not reliably shared between WGL contexts across all drivers.
 // We therefore create FBO objects on the mirror capture context and only attach the shared textures.
+// Indexed by MirrorHandle::index; generation tells when a slot was handed to a different mirror.
 struct MT_MirrorFbos {
+    uint32_t generation = 0;
     GLuint backFbo = 0;       // attaches inst->fboTextureBack
     GLuint finalBackFbo = 0;  // attaches inst->finalTextureBack
     GLuint lastBackTex = 0;
@@ -1230,8 +2081,91 @@ struct MT_MirrorFbos {
     int contentPBOHeight = 0;
     bool contentReadbackPending = false; // True when an async readback is in-flight
     GLsync contentReadbackFence = nullptr; // Fence for the async readback
+
+    // Readback ring for mirror_analysis.h subscribers. A slot is in flight from glReadPixels until its fence
+    // signals; when every slot is in flight the capture is skipped rather than waited for.
+    struct AnalysisReadback {
+        GLuint pbo = 0;
+        size_t pboBytes = 0;
+        GLsync fence = nullptr; // Non-null while in flight
+        int width = 0, height = 0;
+        std::string mirrorName;
+        bool rawOutput = false;
+        MirrorFilterParams params;
+        std::chrono::steady_clock::time_point captureTime;
+    };
+    static constexpr int ANALYSIS_RING_SIZE = 3;
+    AnalysisReadback analysis[ANALYSIS_RING_SIZE];
+    int analysisNext = 0; // Next slot to issue (also the oldest in flight)
+
+    void DropAnalysisReadbacks() {
+        for (auto& rb : analysis) {
+            if (rb.fence) {
+                glDeleteSync(rb.fence);
+                rb.fence = nullptr;
+            }
+        }
+    }
 };
 
+// Start an async readback of the capture image into the mirror's analysis ring
+static void MT_IssueAnalysisReadback(MT_MirrorFbos& fb, GLuint backFbo, int width, int height, const ThreadedMirrorConfig& conf,
+                                     bool rawOutput, MirrorGammaMode gammaMode, std::chrono::steady_clock::time_point now) {
+    if (backFbo == 0 || width <= 0 || height <= 0) return;
+    MT_MirrorFbos::AnalysisReadback& rb = fb.analysis[fb.analysisNext];
+    if (rb.fence) return; // Ring full: the GPU or the harvest is behind, skip this capture
+
+    size_t bytes = static_cast<size_t>(width) * height * 4;
+    if (rb.pbo == 0) { glGenBuffers(1, &rb.pbo); }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, rb.pbo);
+    if (rb.pboBytes != bytes) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_READ);
+        rb.pboBytes = bytes;
+    }
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, backFbo);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    rb.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    rb.width = width;
+    rb.height = height;
+    rb.mirrorName = conf.name;
+    rb.rawOutput = rawOutput;
+    rb.params = MT_FilterParams(conf, gammaMode);
+    rb.captureTime = now;
+    fb.analysisNext = (fb.analysisNext + 1) % MT_MirrorFbos::ANALYSIS_RING_SIZE;
+}
+
+// Hand finished analysis readbacks to mirror_analysis.h, oldest first, without waiting on the GPU
+static void MT_HarvestAnalysisReadbacks(MT_MirrorFbos& fb) {
+    for (int i = 0; i < MT_MirrorFbos::ANALYSIS_RING_SIZE; i++) {
+        MT_MirrorFbos::AnalysisReadback& rb = fb.analysis[(fb.analysisNext + i) % MT_MirrorFbos::ANALYSIS_RING_SIZE];
+        if (!rb.fence) continue;
+        GLenum status = glClientWaitSync(rb.fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) break; // Later slots finish later
+        glDeleteSync(rb.fence);
+        rb.fence = nullptr;
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, rb.pbo);
+        const uint8_t* mapped = static_cast<const uint8_t*>(
+            glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(rb.pboBytes), GL_MAP_READ_BIT));
+        if (mapped) {
+            MirrorAnalysisFrame frame;
+            frame.mirrorName = rb.mirrorName;
+            frame.width = rb.width;
+            frame.height = rb.height;
+            frame.pixels.assign(mapped, mapped + rb.pboBytes);
+            frame.rawOutput = rb.rawOutput;
+            frame.params = rb.params;
+            frame.captureTime = rb.captureTime;
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            SubmitMirrorAnalysisFrame(std::move(frame));
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+}
+
 static void MirrorCaptureThreadFunc(void* unused) {
     _set_se_translator(SEHTranslator);
 
@@ -1295,8 +2229,35 @@ static void MirrorCaptureThreadFunc(void* unused) {
         bool hasValidTexture = false;
 
 
-        // Per-mirror FBOs created on THIS context.
-        std::unordered_map<std::string, MT_MirrorFbos> mt_fbos;
+        // FPS caps with phase spreading (see mirror_scheduler.h); per thread, so capturing never writes shared state
+        MirrorUpdateScheduler mt_scheduler;
+
+        // Last-capture input signatures for skipping unchanged mirrors (see mirror_signature.h)
+        MirrorSignatureCache mt_signatures;
+        std::shared_ptr<const ThreadedMirrorConfigList> mt_signatureConfigs; // Config list the signatures were taken with
+        std::vector<MirrorFilterRegion> mt_signatureRegions;
+        std::vector<CaptureRect> mt_signatureRects;
+        std::vector<uint32_t> mt_signatureCells;
+
+        // Per-mirror FBOs created on THIS context, indexed by mirror slot.
+        std::vector<MT_MirrorFbos> mt_fbos;
+        auto mirrorFbos = [&mt_fbos](MirrorHandle handle) -> MT_MirrorFbos& {
+            if (handle.index >= mt_fbos.size()) { mt_fbos.resize(handle.index + 1); }
+            MT_MirrorFbos& fb = mt_fbos[handle.index];
+            if (fb.generation != handle.generation) {
+                // Slot now belongs to another mirror: keep the GL objects, drop per-mirror state
+                fb.generation = handle.generation;
+                fb.lastBackTex = 0;
+                fb.lastFinalBackTex = 0;
+                if (fb.contentReadbackFence) {
+                    glDeleteSync(fb.contentReadbackFence);
+                    fb.contentReadbackFence = nullptr;
+                }
+                fb.contentReadbackPending = false;
+                fb.DropAnalysisReadbacks();
+            }
+            return fb;
+        };
 
         // Debug: sample pixels from the shared copy texture (only when Texture Ops logging is enabled)
         GLuint debugSampleFbo = 0;
@@ -1360,6 +2321,7 @@ static void MirrorCaptureThreadFunc(void* unused) {
 
         while (!g_mirrorCaptureShouldStop.load()) {
             PROFILE_SCOPE_CAT("Mirror Capture Thread Frame", "Mirror Thread");
+            mt_matchLutFrame++;
 
             auto now = std::chrono::steady_clock::now();
 
@@ -1375,11 +2337,7 @@ static void MirrorCaptureThreadFunc(void* unused) {
             if (!hasNotification) {
                 // Nothing new submitted. Don't spin at 1kHz.
                 // If we have no valid texture and/or no active configs, we can wait longer.
-                bool hasConfigs = false;
-                {
-                    std::lock_guard<std::mutex> lock(g_threadedMirrorConfigMutex);
-                    hasConfigs = !g_threadedMirrorConfigs.empty();
-                }
+                bool hasConfigs = !GetThreadedMirrorConfigs()->empty();
 
                 const auto waitTime = (!hasValidTexture && !hasConfigs) ? std::chrono::milliseconds(100) : std::chrono::milliseconds(16);
                 std::unique_lock<std::mutex> lk(g_captureSignalMutex);
@@ -1453,101 +2411,46 @@ static void MirrorCaptureThreadFunc(void* unused) {
             int gameH = validH;
 
             // === PHASE 2: Process mirrors using the valid texture ===
-            std::vector<ThreadedMirrorConfig> configs;
-            {
-                PROFILE_SCOPE_CAT("Get Mirror Configs", "Mirror Thread");
-                std::lock_guard<std::mutex> lock(g_threadedMirrorConfigMutex);
-                configs = g_threadedMirrorConfigs;
-            }
+            // Lock-free snapshot - GUI edits publish a new list and never block this thread
+            auto configsSnapshot = GetThreadedMirrorConfigs();
+            const ThreadedMirrorConfigList& configs = *configsSnapshot;
 
             if (configs.empty()) { continue; }
 
             // Global colorspace mode for matching (applies to all mirrors)
             MirrorGammaMode gammaMode = GetGlobalMirrorGammaMode();
 
-            // Process each mirror using the copied texture
-            bool didCapture = false;
-            for (auto& conf : configs) {
-                PROFILE_SCOPE_CAT("Process Mirror", "Mirror Thread");
-                // Check FPS throttling for this mirror
-                if (conf.fps > 0) {
-                    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - conf.lastCaptureTime).count();
-                    if (elapsed < (1000 / conf.fps)) { continue; }
-                }
+            // Deliver finished analysis readbacks of earlier frames (cheap no-op while nothing is in flight)
+            {
+                PROFILE_SCOPE_CAT("Harvest Analysis", "Mirror Thread");
+                for (auto& fb : mt_fbos) { MT_HarvestAnalysisReadbacks(fb); }
+            }
+
+            // Gather the mirrors due this frame, then render pass 1 for as many as possible in one batched draw
+            std::vector<MT_BatchMirror> dueMirrors;
+            dueMirrors.reserve(configs.size());
+            for (const auto& conf : configs) {
+                PROFILE_SCOPE_CAT("Prepare Mirror", "Mirror Thread");
+                // Only mirrors due on this game frame according to their FPS cap
+                if (!mt_scheduler.IsDue(conf.handle, conf.fps, now)) continue;
 
                 // Get mirror instance (unique lock - capture thread writes to instance)
                 MirrorInstance* inst = nullptr;
+                MirrorHandle instHandle;
                 GLuint localBackFbo = 0;
                 GLuint localFinalBackFbo = 0;
+                uint64_t stateKey = 0;
                 {
                     std::unique_lock<std::shared_mutex> lock(g_mirrorInstancesMutex);
-                    auto it = g_mirrorInstances.find(conf.name);
-                    if (it == g_mirrorInstances.end()) continue;
-                    inst = &it->second;
-
-                    // === FBO RESIZE: Handle FBO resize in capture thread (moved from main thread) ===
-                    int borderPadding = (conf.borderType == MirrorBorderType::Dynamic) ? conf.dynamicBorderThickness : 0;
-                    int requiredFboW = conf.captureWidth + 2 * borderPadding;
-                    int requiredFboH = conf.captureHeight + 2 * borderPadding;
-
-                    if (inst->fbo_w != requiredFboW || inst->fbo_h != requiredFboH) {
-                        // Resize both front and back buffers
-                        inst->fbo_w = requiredFboW;
-                        inst->fbo_h = requiredFboH;
-                        inst->forceUpdateFrames = 3;
-
-                        // Resize front texture - use NEAREST for sharp pixel-perfect scaling (front/back get swapped)
-                        glBindTexture(GL_TEXTURE_2D, inst->fboTexture);
-                        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, inst->fbo_w, inst->fbo_h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
-                        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-                        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-                        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-                        // Resize back texture
-                        // Use GL_NEAREST for sharp pixel-perfect scaling
-                        glBindTexture(GL_TEXTURE_2D, inst->fboTextureBack);
-                        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, inst->fbo_w, inst->fbo_h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
-                        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-                        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-                        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-                        glBindTexture(GL_TEXTURE_2D, 0);
-                    }
+                    inst = MT_FindMirrorInstance(conf, instHandle);
+                    if (!inst) continue;
 
-                    // === FINAL FBO RESIZE: Also resize the final (screen-ready) FBOs ===
-                    // These are sized to match output dimensions (fbo_w * scaleX, fbo_h * scaleY)
-                    float finalScaleX = conf.outputSeparateScale ? conf.outputScaleX : conf.outputScale;
-                    float finalScaleY = conf.outputSeparateScale ? conf.outputScaleY : conf.outputScale;
-                    int requiredFinalW = static_cast<int>(inst->fbo_w * finalScaleX);
-                    int requiredFinalH = static_cast<int>(inst->fbo_h * finalScaleY);
-
-                    if (inst->final_w_back != requiredFinalW || inst->final_h_back != requiredFinalH) {
-                        // Only resize BACK buffer now - front buffer keeps old content to avoid flicker
-                        // Front buffer dimensions are preserved, will be updated in SwapMirrorBuffers
-
-                        // Resize back final texture only
-                        glBindTexture(GL_TEXTURE_2D, inst->finalTextureBack);
-                        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, requiredFinalW, requiredFinalH, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
-                        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-                        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-                        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                        glBindTexture(GL_TEXTURE_2D, 0);
-
-                        // Track back buffer dimensions separately
-                        inst->final_w_back = requiredFinalW;
-                        inst->final_h_back = requiredFinalH;
-
-                        // Invalidate back cache since dimensions changed (front cache stays valid until swap)
-                        inst->cachedRenderStateBack.isValid = false;
-                    }
+                    EnsureMirrorBackBufferSizes(inst, conf);
 
                     // Ensure mirror-thread-local FBOs exist and are attached to the current back textures.
                     // NOTE: We must NOT rely on inst->fboBack / inst->finalFboBack being usable in this context.
                     // Those may have been created on the game context.
-                    MT_MirrorFbos& fb = mt_fbos[conf.name];
+                    MT_MirrorFbos& fb = mirrorFbos(instHandle);
                     if (fb.backFbo == 0) { glGenFramebuffers(1, &fb.backFbo); }
                     if (fb.finalBackFbo == 0) { glGenFramebuffers(1, &fb.finalBackFbo); }
 
@@ -1573,6 +2476,7 @@ static void MirrorCaptureThreadFunc(void* unused) {
 
                     localBackFbo = fb.backFbo;
                     localFinalBackFbo = fb.finalBackFbo;
+                    stateKey = MT_MirrorStateKey(inst);
                 }
 
                 // Validate instance
@@ -1590,7 +2494,7 @@ static void MirrorCaptureThreadFunc(void* unused) {
                 // If so, read the result and update hasFrameContentBack.
                 // If not ready yet, keep the previous value (no flicker).
                 {
-                    MT_MirrorFbos& fb = mt_fbos[conf.name];
+                    MT_MirrorFbos& fb = mt_fbos[instHandle.index];
                     if (fb.contentReadbackPending && fb.contentReadbackFence) {
                         GLenum fenceStatus = glClientWaitSync(fb.contentReadbackFence, 0, 0); // Non-blocking check
                         if (fenceStatus == GL_ALREADY_SIGNALED || fenceStatus == GL_CONDITION_SATISFIED) {
@@ -1622,17 +2526,83 @@ static void MirrorCaptureThreadFunc(void* unused) {
                     }
                 }
 
+                MT_BatchMirror due;
+                due.inst = inst;
+                due.conf = &conf;
+                due.instHandle = instHandle;
+                due.backFbo = localBackFbo;
+                due.finalBackFbo = localFinalBackFbo;
+                due.stateKey = stateKey;
+                dueMirrors.push_back(due);
+            }
+
+            // === Skip mirrors whose inputs and output state did not change since their last capture ===
+            // They keep their front texture; nothing is rendered or swapped for them this frame.
+            if (configsSnapshot != mt_signatureConfigs) {
+                // Every config edit republishes the list - start over instead of diffing configs
+                mt_signatures.Clear();
+                mt_signatureConfigs = configsSnapshot;
+            }
+            if (!dueMirrors.empty()) {
+                const uint32_t dueCount = static_cast<uint32_t>(dueMirrors.size());
+                uint32_t unchangedCount = 0;
+                if (mt_signatureProgram && mt_signatures.BeginFrame()) {
+                    mt_signatureRects.clear();
+                    for (const auto& due : dueMirrors) {
+                        GetMirrorFilterRegions(*due.conf, gameW, gameH, mt_signatureRegions);
+                        for (const auto& r : mt_signatureRegions) {
+                            mt_signatureRects.push_back({ r.x, r.y, due.conf->captureWidth, due.conf->captureHeight });
+                        }
+                    }
+
+                    if (MT_ComputeRegionSignatures(mt_signatureRects, validTexture, gameW, gameH, captureVAO, mt_signatureCells)) {
+                        const uint64_t frameKey = MT_FrameStateKey(gammaMode, gameW, gameH);
+                        size_t cellOffset = 0;
+                        for (auto& due : dueMirrors) {
+                            const int cellCount = static_cast<int>(due.conf->input.size()) * MIRROR_SIGNATURE_CELLS;
+                            due.signature = MirrorSignatureMixCells(MirrorSignatureMix(frameKey, due.stateKey),
+                                                                    mt_signatureCells.data() + cellOffset, cellCount);
+                            due.hasSignature = true;
+                            cellOffset += cellCount;
+                        }
+
+                        auto newEnd = std::remove_if(dueMirrors.begin(), dueMirrors.end(), [&](const MT_BatchMirror& due) {
+                            if (!mt_signatures.Matches(due.instHandle, due.signature)) return false;
+                            mt_scheduler.MarkUpdated(due.conf->handle, now); // Output is current for this frame
+                            return true;
+                        });
+                        unchangedCount = static_cast<uint32_t>(dueMirrors.end() - newEnd);
+                        dueMirrors.erase(newEnd, dueMirrors.end());
+                    }
+                    mt_signatures.EndFrame(static_cast<int>(dueCount), static_cast<int>(unchangedCount));
+                }
+                PROFILE_HITS("Mirrors Skipped (Unchanged Input)", unchangedCount, dueCount);
+            }
+
+            MT_RenderBatchedCapturePass(dueMirrors, validTexture, gammaMode, gameW, gameH);
+
+            // Process each mirror using the copied texture
+            for (auto& due : dueMirrors) {
+                PROFILE_SCOPE_CAT("Process Mirror", "Mirror Thread");
+                MirrorInstance* inst = due.inst;
+                const ThreadedMirrorConfig& conf = *due.conf;
+                GLuint localBackFbo = due.backFbo;
+
                 // Render the mirror
                 debugSamplePixel(conf, validTexture, gameW, gameH);
 
-                RenderMirrorToBackBuffer(inst, conf, validTexture, captureVAO, captureVBO, localBackFbo, localFinalBackFbo, gammaMode, gameW,
-                                         gameH);
+                if (due.batched) {
+                    RenderMirrorFinalPass(inst, conf, captureVAO, captureVBO, due.finalBackFbo);
+                } else {
+                    RenderMirrorToBackBuffer(inst, conf, validTexture, captureVAO, captureVBO, localBackFbo, due.finalBackFbo, gammaMode,
+                                             gameW, gameH);
+                }
 
                 // === Start async PBO readback for content detection ===
                 // Only for non-raw mirrors: initiate an async glReadPixels into a PBO.
                 // The result will be harvested on the NEXT frame (non-blocking).
                 if (!inst->desiredRawOutput.load(std::memory_order_acquire)) {
-                    MT_MirrorFbos& fb = mt_fbos[conf.name];
+                    MT_MirrorFbos& fb = mt_fbos[due.instHandle.index];
                     int fboW = inst->fbo_w;
                     int fboH = inst->fbo_h;
 
@@ -1664,6 +2634,12 @@ static void MirrorCaptureThreadFunc(void* unused) {
                     fb.contentReadbackPending = true;
                 }
 
+                // === Async readback for mirror_analysis.h subscribers ===
+                if (HasMirrorAnalysisSubscribers() && IsMirrorAnalysisRequested(conf.name)) {
+                    MT_IssueAnalysisReadback(mt_fbos[due.instHandle.index], localBackFbo, inst->fbo_w, inst->fbo_h, conf,
+                                             inst->desiredRawOutput.load(std::memory_order_acquire), gammaMode, now);
+                }
+
                 // Pre-compute render cache for the render thread
                 // Read current screen geometry from atomics
                 int screenW = g_captureScreenW.load(std::memory_order_acquire);
@@ -1696,21 +2672,11 @@ static void MirrorCaptureThreadFunc(void* unused) {
 
                 // Signal that back buffer is ready
                 inst->captureReady.store(true, std::memory_order_release);
-                conf.lastCaptureTime = now;
-                didCapture = true;
-            }
-
-            // Update only lastCaptureTime in global configs, NOT the full config
-            // This preserves FPS and other settings that may have been updated by GUI during capture
-            if (didCapture) {
-                std::lock_guard<std::mutex> lock(g_threadedMirrorConfigMutex);
-                for (const auto& localConf : configs) {
-                    for (auto& globalConf : g_threadedMirrorConfigs) {
-                        if (globalConf.name == localConf.name) {
-                            globalConf.lastCaptureTime = localConf.lastCaptureTime;
-                            break;
-                        }
-                    }
+                mt_scheduler.MarkUpdated(conf.handle, now);
+                if (due.hasSignature) {
+                    mt_signatures.Store(due.instHandle, due.signature);
+                } else {
+                    mt_signatures.Invalidate(due.instHandle); // Captured blind: the stored signature no longer describes the front texture
                 }
             }
 
@@ -1735,15 +2701,22 @@ static void MirrorCaptureThreadFunc(void* unused) {
 
         // Cleanup local shader programs (created on this thread's context)
         MT_CleanupShaders();
+        MT_CleanupMatchLutTextures();
+        MT_CleanupBatchResources();
+        MT_CleanupSignatureResources();
 
         if (debugSampleFbo) { glDeleteFramebuffers(1, &debugSampleFbo); }
 
         // Cleanup mirror-thread local FBOs and PBOs
-        for (auto& kv : mt_fbos) {
-            if (kv.second.backFbo) { glDeleteFramebuffers(1, &kv.second.backFbo); }
-            if (kv.second.finalBackFbo) { glDeleteFramebuffers(1, &kv.second.finalBackFbo); }
-            if (kv.second.contentDetectionPBO) { glDeleteBuffers(1, &kv.second.contentDetectionPBO); }
-            if (kv.second.contentReadbackFence) { glDeleteSync(kv.second.contentReadbackFence); }
+        for (auto& fb : mt_fbos) {
+            if (fb.backFbo) { glDeleteFramebuffers(1, &fb.backFbo); }
+            if (fb.finalBackFbo) { glDeleteFramebuffers(1, &fb.finalBackFbo); }
+            if (fb.contentDetectionPBO) { glDeleteBuffers(1, &fb.contentDetectionPBO); }
+            if (fb.contentReadbackFence) { glDeleteSync(fb.contentReadbackFence); }
+            fb.DropAnalysisReadbacks();
+            for (auto& rb : fb.analysis) {
+                if (rb.pbo) { glDeleteBuffers(1, &rb.pbo); }
+            }
         }
         mt_fbos.clear();
 
@@ -1809,7 +2782,8 @@ void StartMirrorCaptureThread(void* gameGLContext) {
         }
 
         if (!hdc) {
-            Log("Mirror Capture Thread: No DC available");
+            Log("Mirror Capture Thread: No DC available - using CPU mirror fallback");
+            g_mirrorCpuFallbackActive.store(true, std::memory_order_release);
             return;
         }
 
@@ -1819,7 +2793,9 @@ void StartMirrorCaptureThread(void* gameGLContext) {
         // Create the capture context on main thread
         g_mirrorCaptureContext = wglCreateContext(hdc);
         if (!g_mirrorCaptureContext) {
-            Log("Mirror Capture Thread: Failed to create GL context (error " + std::to_string(GetLastError()) + ")");
+            Log("Mirror Capture Thread: Failed to create GL context (error " + std::to_string(GetLastError()) +
+                ") - using CPU mirror fallback");
+            g_mirrorCpuFallbackActive.store(true, std::memory_order_release);
             return;
         }
 
@@ -1836,10 +2812,12 @@ void StartMirrorCaptureThread(void* gameGLContext) {
             // Try reverse order
             if (!wglShareLists(g_mirrorCaptureContext, (HGLRC)gameGLContext)) {
                 DWORD err2 = GetLastError();
-                Log("Mirror Capture Thread: wglShareLists failed (errors " + std::to_string(err1) + ", " + std::to_string(err2) + ")");
+                Log("Mirror Capture Thread: wglShareLists failed (errors " + std::to_string(err1) + ", " + std::to_string(err2) +
+                    ") - using CPU mirror fallback");
                 wglDeleteContext(g_mirrorCaptureContext);
                 g_mirrorCaptureContext = NULL;
                 if (prevRC && prevDC) { wglMakeCurrent(prevDC, prevRC); }
+                g_mirrorCpuFallbackActive.store(true, std::memory_order_release);
                 return;
             }
         }
@@ -1858,6 +2836,7 @@ void StartMirrorCaptureThread(void* gameGLContext) {
         InitCaptureTexture(screenW, screenH);
     }
 
+    g_mirrorCpuFallbackActive.store(false, std::memory_order_release);
     g_mirrorCaptureShouldStop.store(false);
     g_mirrorCaptureRunning.store(true); // Mark as running BEFORE starting thread
     g_mirrorCaptureThread = std::thread(MirrorCaptureThreadFunc, gameGLContext);
@@ -1872,6 +2851,8 @@ void StopMirrorCaptureThread() {
     g_mirrorCaptureShouldStop.store(true);
 
     if (g_mirrorCaptureThread.joinable()) { g_mirrorCaptureThread.join(); }
+    // No more frames can arrive; subscriptions stay registered for the next capture thread
+    StopMirrorAnalysisThread();
 
     Log("Mirror Capture Thread: Joined");
 }
@@ -1890,10 +2871,12 @@ void SwapMirrorBuffers() {
             // Back becomes the new Front for render thread to read from
             std::swap(inst.fbo, inst.fboBack);
             std::swap(inst.fboTexture, inst.fboTextureBack);
+            std::swap(inst.fboTextureHandle, inst.fboTextureBackHandle);
             std::swap(inst.capturedAsRawOutput, inst.capturedAsRawOutputBack);
             std::swap(inst.cachedRenderState, inst.cachedRenderStateBack);
             std::swap(inst.finalFbo, inst.finalFboBack);
             std::swap(inst.finalTexture, inst.finalTextureBack);
+            std::swap(inst.finalTextureHandle, inst.finalTextureBackHandle);
             std::swap(inst.final_w, inst.final_w_back); // Swap dimensions with textures
             std::swap(inst.final_h, inst.final_h_back);
             std::swap(inst.hasFrameContent, inst.hasFrameContentBack); // Swap content presence flag
@@ -1910,10 +2893,9 @@ void SwapMirrorBuffers() {
 
 // Update capture configs from main thread (call when active mirrors change)
 void UpdateMirrorCaptureConfigs(const std::vector<MirrorConfig>& activeMirrors) {
-    std::vector<ThreadedMirrorConfig> configs;
-    configs.reserve(activeMirrors.size());
+    auto configs = std::make_shared<ThreadedMirrorConfigList>();
+    configs->reserve(activeMirrors.size());
 
-    // Get existing configs to preserve timing data (lastCaptureTime)
     std::lock_guard<std::mutex> lock(g_threadedMirrorConfigMutex);
 
     for (const auto& m : activeMirrors) {
@@ -1949,15 +2931,7 @@ void UpdateMirrorCaptureConfigs(const std::vector<MirrorConfig>& activeMirrors)
         conf.outputY = m.output.y;
         conf.outputRelativeTo = m.output.relativeTo;
 
-        // Preserve lastCaptureTime from existing config to maintain FPS throttling
-        for (const auto& existingConf : g_threadedMirrorConfigs) {
-            if (existingConf.name == m.name) {
-                conf.lastCaptureTime = existingConf.lastCaptureTime;
-                break;
-            }
-        }
-
-        configs.push_back(conf);
+        configs->push_back(conf);
     }
 
     // Clear captureReady for all mirrors to allow capture thread to start fresh
@@ -1965,6 +2939,7 @@ void UpdateMirrorCaptureConfigs(const std::vector<MirrorConfig>& activeMirrors)
     // (captureReady would stay true if main thread never consumed the capture)
     // Also invalidate cached render state to force recompute with new output positions
     // (needed for group output positions to take effect on startup)
+    // Assign each mirror its registry slot here, so the per-frame paths index instances and configs directly
     {
         std::unique_lock<std::shared_mutex> clearLock(g_mirrorInstancesMutex);
         for (auto& [name, inst] : g_mirrorInstances) {
@@ -1972,42 +2947,29 @@ void UpdateMirrorCaptureConfigs(const std::vector<MirrorConfig>& activeMirrors)
             inst.cachedRenderState.isValid = false;
             inst.cachedRenderStateBack.isValid = false;
         }
+        for (auto& conf : *configs) { conf.handle = g_mirrorInstances.Acquire(conf.name); }
     }
 
-    g_threadedMirrorConfigs = configs;
-
-    // Publish a cheap summary so the SwapBuffers hook can skip SubmitFrameCapture when nothing needs it.
-    g_activeMirrorCaptureCount.store(static_cast<int>(g_threadedMirrorConfigs.size()), std::memory_order_release);
+    // Capture threads schedule mirrors per slot, so republishing doesn't reset FPS throttling
+    MT_PublishThreadedConfigs(std::move(configs));
 }
 
 void UpdateMirrorFPS(const std::string& mirrorName, int fps) {
-    std::lock_guard<std::mutex> lock(g_threadedMirrorConfigMutex);
-    for (auto& conf : g_threadedMirrorConfigs) {
-        if (conf.name == mirrorName) {
-            conf.fps = fps;
-            break;
-        }
-    }
+    MT_EditThreadedConfig(mirrorName, [&](ThreadedMirrorConfig& conf) { conf.fps = fps; });
 }
 
 void UpdateMirrorOutputPosition(const std::string& mirrorName, int x, int y, float scale, bool separateScale, float scaleX, float scaleY,
                                 const std::string& relativeTo) {
     // Update the threaded config
-    {
-        std::lock_guard<std::mutex> lock(g_threadedMirrorConfigMutex);
-        for (auto& conf : g_threadedMirrorConfigs) {
-            if (conf.name == mirrorName) {
-                conf.outputX = x;
-                conf.outputY = y;
-                conf.outputScale = scale;
-                conf.outputSeparateScale = separateScale;
-                conf.outputScaleX = scaleX;
-                conf.outputScaleY = scaleY;
-                conf.outputRelativeTo = relativeTo;
-                break;
-            }
-        }
-    }
+    MT_EditThreadedConfig(mirrorName, [&](ThreadedMirrorConfig& conf) {
+        conf.outputX = x;
+        conf.outputY = y;
+        conf.outputScale = scale;
+        conf.outputSeparateScale = separateScale;
+        conf.outputScaleX = scaleX;
+        conf.outputScaleY = scaleY;
+        conf.outputRelativeTo = relativeTo;
+    });
 
     // Invalidate cached render state in mirror instance
     // This ensures the render thread recalculates positions immediately
@@ -2033,15 +2995,20 @@ void UpdateMirrorGroupOutputPosition(const std::vector<std::string>& mirrorIds,
     // used outside the group).
     {
         std::lock_guard<std::mutex> lock(g_threadedMirrorConfigMutex);
-        for (auto& conf : g_threadedMirrorConfigs) {
-            // Check if this mirror is in the group
-            if (std::find(mirrorIds.begin(), mirrorIds.end(), conf.name) != mirrorIds.end()) {
-                conf.outputX = x;
-                conf.outputY = y;
-                // Scale is NOT updated here - only position and relativeTo
-                conf.outputRelativeTo = relativeTo;
-            }
+        auto current = GetThreadedMirrorConfigs();
+        auto next = std::make_shared<ThreadedMirrorConfigList>(*current);
+        bool changed = false;
+        for (const auto& mirrorName : mirrorIds) {
+            int pos = MT_FindThreadedConfig(*next, mirrorName);
+            if (pos < 0) continue;
+            ThreadedMirrorConfig& conf = (*next)[pos];
+            conf.outputX = x;
+            conf.outputY = y;
+            // Scale is NOT updated here - only position and relativeTo
+            conf.outputRelativeTo = relativeTo;
+            changed = true;
         }
+        if (changed) { MT_PublishThreadedConfigs(std::move(next)); }
     }
 
     // Invalidate cached render state for all mirrors in the group
@@ -2058,42 +3025,45 @@ void UpdateMirrorGroupOutputPosition(const std::vector<std::string>& mirrorIds,
 }
 
 void UpdateMirrorInputRegions(const std::string& mirrorName, const std::vector<MirrorCaptureConfig>& inputRegions) {
+    MT_EditThreadedConfig(mirrorName, [&](ThreadedMirrorConfig& conf) { conf.input = inputRegions; });
+}
+
+void RenameMirrorCaptureConfig(const std::string& oldName, const std::string& newName) {
     std::lock_guard<std::mutex> lock(g_threadedMirrorConfigMutex);
-    for (auto& conf : g_threadedMirrorConfigs) {
-        if (conf.name == mirrorName) {
-            conf.input = inputRegions;
-            break;
-        }
-    }
+    auto current = GetThreadedMirrorConfigs();
+    // g_mirrorInstances is renamed first, so the slot normally already resolves under the new name
+    int pos = MT_FindThreadedConfig(*current, newName);
+    if (pos < 0) { pos = MT_FindThreadedConfig(*current, oldName); }
+    if (pos < 0) return;
+
+    auto next = std::make_shared<ThreadedMirrorConfigList>(*current);
+    (*next)[pos].name = newName;
+    MT_PublishThreadedConfigs(std::move(next));
 }
 
 void UpdateMirrorCaptureSettings(const std::string& mirrorName, int captureWidth, int captureHeight, const MirrorBorderConfig& border,
                                  const MirrorColors& colors, float colorSensitivity, bool rawOutput, bool colorPassthrough) {
-    std::lock_guard<std::mutex> lock(g_threadedMirrorConfigMutex);
-    for (auto& conf : g_threadedMirrorConfigs) {
-        if (conf.name == mirrorName) {
-            conf.captureWidth = captureWidth;
-            conf.captureHeight = captureHeight;
-
-            // Border configuration
-            conf.borderType = border.type;
-            conf.dynamicBorderThickness = border.dynamicThickness;
-            conf.staticBorderShape = border.staticShape;
-            conf.staticBorderColor = border.staticColor;
-            conf.staticBorderThickness = border.staticThickness;
-            conf.staticBorderRadius = border.staticRadius;
-            conf.staticBorderOffsetX = border.staticOffsetX;
-            conf.staticBorderOffsetY = border.staticOffsetY;
-            conf.staticBorderWidth = border.staticWidth;
-            conf.staticBorderHeight = border.staticHeight;
-
-            conf.targetColors = colors.targetColors; // Copy vector of target colors
-            conf.outputColor = colors.output;
-            conf.borderColor = colors.border;
-            conf.colorSensitivity = colorSensitivity;
-            conf.rawOutput = rawOutput;
-            conf.colorPassthrough = colorPassthrough;
-            break;
-        }
-    }
+    MT_EditThreadedConfig(mirrorName, [&](ThreadedMirrorConfig& conf) {
+        conf.captureWidth = captureWidth;
+        conf.captureHeight = captureHeight;
+
+        // Border configuration
+        conf.borderType = border.type;
+        conf.dynamicBorderThickness = border.dynamicThickness;
+        conf.staticBorderShape = border.staticShape;
+        conf.staticBorderColor = border.staticColor;
+        conf.staticBorderThickness = border.staticThickness;
+        conf.staticBorderRadius = border.staticRadius;
+        conf.staticBorderOffsetX = border.staticOffsetX;
+        conf.staticBorderOffsetY = border.staticOffsetY;
+        conf.staticBorderWidth = border.staticWidth;
+        conf.staticBorderHeight = border.staticHeight;
+
+        conf.targetColors = colors.targetColors; // Copy vector of target colors
+        conf.outputColor = colors.output;
+        conf.borderColor = colors.border;
+        conf.colorSensitivity = colorSensitivity;
+        conf.rawOutput = rawOutput;
+        conf.colorPassthrough = colorPassthrough;
+    });
 }
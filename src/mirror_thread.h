@@ -6,6 +6,7 @@
 #include <GL/glew.h>
 #include <atomic>
 #include <chrono>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
@@ -13,6 +14,7 @@
 
 // Need gui.h for Color and MirrorCaptureConfig used as value types in ThreadedMirrorConfig
 #include "gui.h"
+#include "mirror_registry.h"
 
 // Forward declarations
 struct MirrorInstance;
@@ -34,6 +36,7 @@ extern std::atomic<int> g_activeMirrorCaptureCount;
 // Named ThreadedMirrorConfig to avoid conflict with MirrorCaptureConfig in gui.h
 struct ThreadedMirrorConfig {
     std::string name;
+    MirrorHandle handle; // Slot in g_mirrorInstances, assigned when configs are published
     int captureWidth = 0;
     int captureHeight = 0;
 
@@ -58,7 +61,6 @@ struct ThreadedMirrorConfig {
     Color borderColor; // Border color for dynamic render shader
     float colorSensitivity = 0.0f;
     std::vector<MirrorCaptureConfig> input; // Uses MirrorCaptureConfig from gui.h
-    std::chrono::steady_clock::time_point lastCaptureTime;
 
     // Output positioning config (for pre-computing render cache)
     float outputScale = 1.0f;
@@ -69,8 +71,12 @@ struct ThreadedMirrorConfig {
     std::string outputRelativeTo;
 };
 
-// External access to threaded mirror configs (protected by mutex)
-extern std::vector<ThreadedMirrorConfig> g_threadedMirrorConfigs;
+// Published mirror configs (RCU, same scheme as GetConfigSnapshot).
+// Readers (capture thread, CPU fallback) get an immutable list without locking and keep it alive for as
+// long as they hold the shared_ptr. Writers go through the Update*/Rename* functions below, which copy,
+// edit and republish the list under g_threadedMirrorConfigMutex (serializes writers only).
+using ThreadedMirrorConfigList = std::vector<ThreadedMirrorConfig>;
+std::shared_ptr<const ThreadedMirrorConfigList> GetThreadedMirrorConfigs();
 extern std::mutex g_threadedMirrorConfigMutex;
 
 // Game state for capture thread (main thread writes, capture thread reads)
@@ -159,6 +165,9 @@ void UpdateMirrorGroupOutputPosition(const std::vector<std::string>& mirrorIds,
 // Update input/capture regions for a specific mirror (call from GUI when input zones change)
 void UpdateMirrorInputRegions(const std::string& mirrorName, const std::vector<MirrorCaptureConfig>& inputRegions);
 
+// Rename a mirror's published config (call from GUI after renaming the g_mirrorInstances entry)
+void RenameMirrorCaptureConfig(const std::string& oldName, const std::string& newName);
+
 // Update capture-related settings for a specific mirror (call from GUI when capture settings change)
 void UpdateMirrorCaptureSettings(const std::string& mirrorName, int captureWidth, int captureHeight, const MirrorBorderConfig& border,
                                  const MirrorColors& colors, float colorSensitivity, bool rawOutput, bool colorPassthrough);
@@ -170,6 +179,12 @@ MirrorGammaMode GetGlobalMirrorGammaMode();
 void InitCaptureTexture(int width, int height);
 void CleanupCaptureTexture();
 
+// CPU mirror fallback (see mirror_filter.h)
+// Active when the capture thread could not get a GL context sharing objects with the game context.
+// RunMirrorCpuFallback filters all due mirrors on the CPU and must be called from SwapBuffers (game context current).
+bool IsMirrorCpuFallbackActive();
+void RunMirrorCpuFallback(GLuint gameTexture, int width, int height);
+
 // Start async GPU blit to copy game texture (called from SwapBuffers, non-blocking)
 // The GPU executes the blit in background. Consumers call GetGameCopyTexture/Fence to access.
 void SubmitFrameCapture(GLuint gameTexture, int width, int height);
@@ -0,0 +1,62 @@
+// ============================================================================
+// MODE_IDS.CPP - Interned mode ID handles
+// ============================================================================
+
+#include "mode_ids.h"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include "gui.h"
+
+namespace {
+
+// Names live in fixed-size chunks that are allocated once and never moved, so readers can index
+// them without a lock. Handle h is stored at chunk (h / CHUNK_SIZE), entry (h % CHUNK_SIZE).
+constexpr uint32_t CHUNK_SIZE = 256;
+constexpr uint32_t MAX_CHUNKS = 64; // 16384 distinct IDs per process - far beyond any real config
+
+std::atomic<std::string*> g_chunks[MAX_CHUNKS] = {};
+std::atomic<uint32_t> g_count{ 1 }; // Handle 0 is MODE_ID_NONE
+
+std::mutex g_internMutex;
+std::unordered_map<std::string, ModeIdHandle> g_handles; // Guarded by g_internMutex
+
+const std::string g_emptyName;
+
+} // namespace
+
+ModeIdHandle InternModeId(const std::string& id) {
+    if (id.empty()) return MODE_ID_NONE;
+
+    std::lock_guard<std::mutex> lock(g_internMutex);
+    if (auto it = g_handles.find(id); it != g_handles.end()) return it->second;
+
+    const uint32_t handle = g_count.load(std::memory_order_relaxed);
+    const uint32_t chunk = handle / CHUNK_SIZE;
+    if (chunk >= MAX_CHUNKS) {
+        Log("WARNING: Mode ID table is full, '" + id + "' is treated as an empty mode ID");
+        return MODE_ID_NONE;
+    }
+    std::string* names = g_chunks[chunk].load(std::memory_order_relaxed);
+    if (!names) {
+        names = new std::string[CHUNK_SIZE]; // Intentionally never freed (see header)
+        g_chunks[chunk].store(names, std::memory_order_relaxed);
+    }
+    names[handle % CHUNK_SIZE] = id;
+    g_handles.emplace(id, handle);
+    g_count.store(handle + 1, std::memory_order_release); // Publishes the name and its chunk
+    return handle;
+}
+
+const std::string& ModeIdName(ModeIdHandle handle) {
+    if (handle == MODE_ID_NONE || handle >= g_count.load(std::memory_order_acquire)) return g_emptyName;
+    return g_chunks[handle / CHUNK_SIZE].load(std::memory_order_relaxed)[handle % CHUNK_SIZE];
+}
+
+ModeIdHandle GetModeIdHandle(const ModeConfig& mode) {
+    // The cached handle goes stale if the ID is edited or the mode was created after the last publish
+    if (mode.internId != MODE_ID_NONE && ModeIdName(mode.internId) == mode.id) return mode.internId;
+    return InternModeId(mode.id);
+}
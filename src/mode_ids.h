@@ -0,0 +1,30 @@
+#pragma once
+
+// ============================================================================
+// MODE_IDS.H - Interned mode ID handles
+// ============================================================================
+// Per-frame structs that cross threads (FrameRenderRequest, ObsFrameContext) carry a mode as a small
+// integer handle instead of a std::string, so they stay trivially copyable and the game thread does not
+// copy strings every frame. Handles are assigned once per distinct ID (exact, case-sensitive match) and
+// never reused; names are never freed, so ModeIdName may be called from any thread without locking.
+//
+// PublishConfigSnapshot interns every mode's ID and caches the handle in ModeConfig::internId, which
+// makes GetModeIdHandle a compare instead of a map lookup on the per-frame paths.
+// ============================================================================
+
+#include <cstdint>
+#include <string>
+
+struct ModeConfig;
+
+using ModeIdHandle = uint32_t;
+constexpr ModeIdHandle MODE_ID_NONE = 0; // The empty ID
+
+// Handle for an ID, assigning one on first use. Takes a mutex; not meant for per-frame use.
+ModeIdHandle InternModeId(const std::string& id);
+
+// ID for a handle; "" for MODE_ID_NONE or unknown handles. Lock-free.
+const std::string& ModeIdName(ModeIdHandle handle);
+
+// Handle for a mode, using its cached internId while that still matches the mode's ID
+ModeIdHandle GetModeIdHandle(const ModeConfig& mode);
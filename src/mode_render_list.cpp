@@ -0,0 +1,207 @@
+// ============================================================================
+// MODE_RENDER_LIST.CPP - Compiled per-mode overlay lists for the render thread
+// ============================================================================
+
+#include "mode_render_list.h"
+
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "profiler.h"
+#include "render.h"
+#include "utils.h"
+
+namespace {
+
+// Group members inherit the group's position; per-item sizing multiplies the mirror's own scale
+MirrorConfig MakeGroupedMirror(const MirrorConfig& mirror, const MirrorGroupConfig& group, const MirrorGroupItem& item, int screenW,
+                               int screenH) {
+    MirrorConfig grouped = mirror;
+    int groupX = group.output.x;
+    int groupY = group.output.y;
+    if (group.output.useRelativePosition) {
+        groupX = static_cast<int>(group.output.relativeX * screenW);
+        groupY = static_cast<int>(group.output.relativeY * screenH);
+    }
+    grouped.output.x = groupX + item.offsetX;
+    grouped.output.y = groupY + item.offsetY;
+    grouped.output.relativeTo = group.output.relativeTo;
+    grouped.output.useRelativePosition = group.output.useRelativePosition;
+    grouped.output.relativeX = group.output.relativeX;
+    grouped.output.relativeY = group.output.relativeY;
+    // Use separate scale when per-item sizing differs from 100%; otherwise keep the mirror's own scale settings
+    if (item.widthPercent != 1.0f || item.heightPercent != 1.0f) {
+        grouped.output.separateScale = true;
+        float baseScaleX = mirror.output.separateScale ? mirror.output.scaleX : mirror.output.scale;
+        float baseScaleY = mirror.output.separateScale ? mirror.output.scaleY : mirror.output.scale;
+        grouped.output.scaleX = baseScaleX * item.widthPercent;
+        grouped.output.scaleY = baseScaleY * item.heightPercent;
+    }
+    return grouped;
+}
+
+void ResolveMirrorHandles(ModeRenderList& list) {
+    list.mirrorHandles.resize(list.mirrors.size());
+    std::shared_lock<std::shared_mutex> lock(g_mirrorInstancesMutex);
+    for (size_t i = 0; i < list.mirrors.size(); i++) { list.mirrorHandles[i] = g_mirrorInstances.HandleOf(list.mirrors[i].name); }
+}
+
+bool HasOnlyOnMyScreenItems(const ModeRenderList& list) {
+    for (const auto& m : list.mirrors) {
+        if (m.onlyOnMyScreen) return true;
+    }
+    for (const auto& img : list.images) {
+        if (img.onlyOnMyScreen) return true;
+    }
+    for (const WindowOverlayConfig* o : list.windowOverlays) {
+        if (o && o->onlyOnMyScreen) return true;
+    }
+    return false;
+}
+
+void CompileOverlayTimelines(ModeRenderList& list) {
+    list.imageTimelines.resize(list.images.size());
+    for (size_t i = 0; i < list.images.size(); i++) {
+        CompileOverlayTimeline(list.images[i].animation, list.imageTimelines[i]);
+        list.hasAnimatedOverlays |= list.imageTimelines[i].IsAnimated();
+    }
+    list.windowOverlayTimelines.resize(list.windowOverlays.size());
+    for (size_t i = 0; i < list.windowOverlays.size(); i++) {
+        CompileOverlayTimeline(list.windowOverlays[i]->animation, list.windowOverlayTimelines[i]);
+        list.hasAnimatedOverlays |= list.windowOverlayTimelines[i].IsAnimated();
+    }
+}
+
+} // namespace
+
+std::shared_ptr<const ModeRenderList> CompileModeRenderList(const std::shared_ptr<const Config>& snapshot, ModeIdHandle mode, int screenW,
+                                                            int screenH, bool imagesVisible, bool windowOverlaysVisible) {
+    PROFILE_SCOPE_CAT("Compile Mode Render List", "Render Thread");
+    auto list = std::make_shared<ModeRenderList>();
+    list->snapshot = snapshot;
+    list->mode = mode;
+    list->screenW = screenW;
+    list->screenH = screenH;
+    list->imagesVisible = imagesVisible;
+    list->windowOverlaysVisible = windowOverlaysVisible;
+    if (!snapshot) return list;
+
+    const Config& config = *snapshot;
+    const ModeConfig* modeConfig = GetModeFromSnapshot(config, ModeIdName(mode));
+    if (!modeConfig) return list;
+
+    std::unordered_map<std::string, const MirrorConfig*> mirrorByName;
+    mirrorByName.reserve(config.mirrors.size());
+    for (const auto& m : config.mirrors) { mirrorByName[m.name] = &m; }
+    std::unordered_map<std::string, const MirrorGroupConfig*> groupByName;
+    groupByName.reserve(config.mirrorGroups.size());
+    for (const auto& g : config.mirrorGroups) { groupByName[g.name] = &g; }
+
+    list->mirrors.reserve(modeConfig->mirrorIds.size() + modeConfig->mirrorGroupIds.size());
+    for (const auto& mirrorName : modeConfig->mirrorIds) {
+        auto it = mirrorByName.find(mirrorName);
+        if (it != mirrorByName.end()) { list->mirrors.push_back(*it->second); }
+    }
+
+    for (const auto& groupName : modeConfig->mirrorGroupIds) {
+        auto git = groupByName.find(groupName);
+        if (git == groupByName.end()) continue;
+        const MirrorGroupConfig& group = *git->second;
+        for (const auto& item : group.mirrors) {
+            if (!item.enabled) continue;
+            auto it = mirrorByName.find(item.mirrorId);
+            if (it != mirrorByName.end()) { list->mirrors.push_back(MakeGroupedMirror(*it->second, group, item, screenW, screenH)); }
+        }
+    }
+    ResolveMirrorHandles(*list);
+
+    if (imagesVisible) {
+        std::unordered_map<std::string, const ImageConfig*> imageByName;
+        imageByName.reserve(config.images.size());
+        for (const auto& img : config.images) { imageByName[img.name] = &img; }
+        list->images.reserve(modeConfig->imageIds.size());
+        for (const auto& imageName : modeConfig->imageIds) {
+            auto it = imageByName.find(imageName);
+            if (it != imageByName.end()) { list->images.push_back(*it->second); }
+        }
+    }
+
+    if (windowOverlaysVisible) {
+        std::unordered_map<std::string, const WindowOverlayConfig*> overlayByName;
+        overlayByName.reserve(config.windowOverlays.size());
+        for (const auto& o : config.windowOverlays) { overlayByName[o.name] = &o; }
+        list->windowOverlays.reserve(modeConfig->windowOverlayIds.size());
+        for (const auto& overlayId : modeConfig->windowOverlayIds) {
+            auto it = overlayByName.find(overlayId);
+            if (it != overlayByName.end()) { list->windowOverlays.push_back(it->second); }
+        }
+    }
+    CompileOverlayTimelines(*list);
+    list->hasOnlyOnMyScreenItems = HasOnlyOnMyScreenItems(*list);
+    return list;
+}
+
+std::shared_ptr<const ModeRenderList> CompileSlideOutRenderList(const ModeRenderList& from, const ModeRenderList& target) {
+    auto list = std::make_shared<ModeRenderList>();
+    list->snapshot = from.snapshot;
+    list->mode = from.mode;
+    list->screenW = from.screenW;
+    list->screenH = from.screenH;
+
+    std::unordered_set<std::string> targetNames;
+    targetNames.reserve(target.mirrors.size());
+    for (const auto& m : target.mirrors) { targetNames.insert(m.name); }
+
+    for (size_t i = 0; i < from.mirrors.size(); i++) {
+        if (targetNames.count(from.mirrors[i].name)) continue;
+        list->mirrors.push_back(from.mirrors[i]);
+        list->mirrorHandles.push_back(from.mirrorHandles[i]);
+    }
+    list->hasOnlyOnMyScreenItems = HasOnlyOnMyScreenItems(*list);
+    return list;
+}
+
+std::shared_ptr<const ModeRenderList> ModeRenderListCache::Get(const std::shared_ptr<const Config>& snapshot, ModeIdHandle mode, int screenW,
+                                                               int screenH, bool imagesVisible, bool windowOverlaysVisible) {
+    m_useCounter++;
+    Entry* victim = &m_entries[0];
+    for (Entry& e : m_entries) {
+        const ModeRenderList* l = e.list.get();
+        if (l && l->snapshot == snapshot && l->mode == mode && l->screenW == screenW && l->screenH == screenH &&
+            l->imagesVisible == imagesVisible && l->windowOverlaysVisible == windowOverlaysVisible) {
+            e.lastUse = m_useCounter;
+            return e.list;
+        }
+        if (!l) {
+            victim = &e;
+        } else if (victim->list && e.lastUse < victim->lastUse) {
+            victim = &e;
+        }
+    }
+
+    // A new snapshot makes every older list unreachable; drop them now so their configs are freed
+    for (Entry& e : m_entries) {
+        if (e.list && e.list->snapshot != snapshot) { e = Entry{}; }
+    }
+    victim->list = CompileModeRenderList(snapshot, mode, screenW, screenH, imagesVisible, windowOverlaysVisible);
+    victim->lastUse = m_useCounter;
+    return victim->list;
+}
+
+std::shared_ptr<const ModeRenderList> ModeRenderListCache::GetSlideOut(const std::shared_ptr<const ModeRenderList>& from,
+                                                                       const std::shared_ptr<const ModeRenderList>& target) {
+    if (!m_slideOut || m_slideOutFrom != from || m_slideOutTarget != target) {
+        m_slideOutFrom = from;
+        m_slideOutTarget = target;
+        m_slideOut = CompileSlideOutRenderList(*from, *target);
+    }
+    return m_slideOut;
+}
+
+void ModeRenderListCache::Clear() {
+    for (Entry& e : m_entries) { e = Entry{}; }
+    m_slideOutFrom.reset();
+    m_slideOutTarget.reset();
+    m_slideOut.reset();
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+// ============================================================================
+// MODE_RENDER_LIST.H - Compiled per-mode overlay lists for the render thread
+// ============================================================================
+// Resolving a mode's overlays means name lookups for every mirror, group, image and window overlay,
+// plus group-adjusted MirrorConfig copies whose relative positions depend on the screen size. None
+// of that changes between config snapshots, so it is compiled once into a ModeRenderList and reused
+// for every frame with the same (snapshot, mode, screen size, visibility toggles).
+//
+// Lists are immutable once built and hold their config snapshot alive, so the WindowOverlayConfig
+// pointers and a list's identity stay valid for as long as anyone holds the list.
+// ============================================================================
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gui.h"
+#include "mirror_registry.h"
+#include "mode_ids.h"
+#include "overlay_timeline.h"
+
+struct ModeRenderList {
+    std::shared_ptr<const Config> snapshot;
+    ModeIdHandle mode = MODE_ID_NONE;
+    int screenW = 0, screenH = 0;
+    bool imagesVisible = false;
+    bool windowOverlaysVisible = false;
+
+    // The mode's direct mirrors, then enabled group members with the group's position and per-item scale applied
+    std::vector<MirrorConfig> mirrors;
+    // Parallel to mirrors: g_mirrorInstances slot resolved at compile time. Invalid or stale handles
+    // (mirror created or recreated after the compile) fall back to a lookup by name.
+    std::vector<MirrorHandle> mirrorHandles;
+    std::vector<ImageConfig> images; // Empty while image overlays are hidden
+    std::vector<const WindowOverlayConfig*> windowOverlays; // Empty while window overlays are hidden
+    // Parallel to images / windowOverlays: keyframe timelines sampled at compile time
+    std::vector<CompiledOverlayTimeline> imageTimelines;
+    std::vector<CompiledOverlayTimeline> windowOverlayTimelines;
+    // Any timeline above is animated, so the overlay layers change every frame while the mode is shown
+    bool hasAnimatedOverlays = false;
+    // Any item above is marked onlyOnMyScreen, so the OBS and on-screen passes draw different sets
+    bool hasOnlyOnMyScreenItems = false;
+};
+
+// Build the list for a mode. Unknown modes produce an empty list.
+std::shared_ptr<const ModeRenderList> CompileModeRenderList(const std::shared_ptr<const Config>& snapshot, ModeIdHandle mode, int screenW,
+                                                            int screenH, bool imagesVisible, bool windowOverlaysVisible);
+
+// Mirrors of `from` that `target` does not also show (matched by name) - the slide-out set of a transition
+std::shared_ptr<const ModeRenderList> CompileSlideOutRenderList(const ModeRenderList& from, const ModeRenderList& target);
+
+// Render-thread cache of compiled lists. A frame typically needs the current mode, plus the from-mode
+// and EyeZoom during transitions, so a handful of entries with least-recently-used eviction is enough.
+class ModeRenderListCache {
+  public:
+    static constexpr int CAPACITY = 4;
+
+    std::shared_ptr<const ModeRenderList> Get(const std::shared_ptr<const Config>& snapshot, ModeIdHandle mode, int screenW, int screenH,
+                                              bool imagesVisible, bool windowOverlaysVisible);
+
+    // Slide-out set for a (from, target) pair of lists from this cache; rebuilt only when either changes
+    std::shared_ptr<const ModeRenderList> GetSlideOut(const std::shared_ptr<const ModeRenderList>& from,
+                                                      const std::shared_ptr<const ModeRenderList>& target);
+
+    void Clear();
+
+  private:
+    struct Entry {
+        std::shared_ptr<const ModeRenderList> list;
+        uint64_t lastUse = 0;
+    };
+
+    Entry m_entries[CAPACITY];
+    uint64_t m_useCounter = 0;
+
+    std::shared_ptr<const ModeRenderList> m_slideOutFrom, m_slideOutTarget, m_slideOut;
+};
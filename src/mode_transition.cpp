@@ -0,0 +1,137 @@
+// ============================================================================
+// MODE_TRANSITION.CPP - Clock-injected evaluation of mode transitions
+// ============================================================================
+
+#include "mode_transition.h"
+#include "easing_curve.h"
+
+#include <algorithm>
+
+namespace {
+
+// One axis of the base (pre-bounce) geometry. If from and to are identical, skip interpolation entirely
+// to avoid floating-point precision issues causing tiny visual artifacts (1-2 pixel jitter)
+int LerpAxis(int from, int to, float t) {
+    if (from == to) return to;
+    return static_cast<int>(from + (to - from) * t);
+}
+
+} // namespace
+
+float ModeTransitionTotalDuration(const ModeTransitionDescriptor& desc) {
+    float totalBounceDuration = (desc.bounceCount > 0) ? (desc.bounceCount * desc.bounceDurationMs / 1000.0f) : 0.0f;
+    return desc.duration + totalBounceDuration;
+}
+
+ModeTransitionFrame EvaluateModeTransition(const ModeTransitionDescriptor& desc, TransitionClock::time_point now) {
+    ModeTransitionFrame frame;
+
+    const float elapsed = (std::max)(0.0f, std::chrono::duration<float>(now - desc.startTime).count());
+    const float baseDuration = desc.duration;
+    const float totalDuration = ModeTransitionTotalDuration(desc);
+    const float totalBounceDuration = totalDuration - baseDuration;
+
+    // Overlay/background transitions are always Cut, so the game transition decides when it's done
+    if (totalDuration <= 0.0f || elapsed >= totalDuration) {
+        // Exactly at target, so no stale bounce values survive into the last frame
+        frame.complete = true;
+        frame.progress = 1.0f;
+        frame.moveProgress = 1.0f;
+        frame.width = desc.toWidth;
+        frame.height = desc.toHeight;
+        frame.x = desc.toX;
+        frame.y = desc.toY;
+        return frame;
+    }
+
+    frame.progress = elapsed / totalDuration;
+
+    if (!desc.animateGame) {
+        // Game cuts instantly; moveProgress equals overall progress
+        frame.moveProgress = frame.progress;
+        frame.width = desc.toWidth;
+        frame.height = desc.toHeight;
+        frame.x = desc.toX;
+        frame.y = desc.toY;
+        return frame;
+    }
+
+    // Calculate the ratio of base animation within total duration
+    const float baseRatio = baseDuration / totalDuration;
+
+    // Determine which phase we're in: movement or bounce
+    float moveProgress = 0.0f;
+    float bounceOffset = 0.0f;
+
+    if (frame.progress < baseRatio) {
+        // Still in movement phase
+        moveProgress = std::clamp(frame.progress / baseRatio, 0.0f, 1.0f);
+        // Apply dual easing with separate ease-in and ease-out powers
+        moveProgress = desc.moveEasing ? desc.moveEasing->Sample(moveProgress)
+                                       : ApplyDualEasing(moveProgress, desc.easeInPower, desc.easeOutPower);
+    } else {
+        // In bounce phase - movement is complete
+        moveProgress = 1.0f;
+
+        if (desc.bounceCount > 0 && totalBounceDuration > 0) {
+            float bounceElapsed = (frame.progress - baseRatio) * totalDuration;
+            float singleBounceDuration = desc.bounceDurationMs / 1000.0f;
+
+            float bounceUnits = bounceElapsed / singleBounceDuration;
+            int currentBounce = static_cast<int>(bounceUnits);
+            if (currentBounce < desc.bounceCount) {
+                float bouncePhaseProgress = bounceUnits - static_cast<float>(currentBounce);
+                bounceOffset = CalculateBounceOffset(bouncePhaseProgress, currentBounce, desc.bounceCount, desc.bounceIntensity);
+            }
+        }
+    }
+
+    // Save EASED moveProgress for overlay lerping (matches viewport easing)
+    frame.moveProgress = moveProgress;
+
+    if (bounceOffset != 0.0f) {
+        // Bounce goes BACK towards origin (opposite direction of movement)
+        // If we moved from large to small, bounce makes it temporarily larger again
+        // If we moved from small to large, bounce makes it temporarily smaller again
+        // Skip bounce on an axis if skipAnimate is enabled OR if that axis isn't changing
+        bool skipBounceX = desc.skipAnimateX || (desc.fromWidth == desc.toWidth && desc.fromX == desc.toX);
+        if (skipBounceX) {
+            frame.width = desc.toWidth;
+            frame.x = desc.toX;
+        } else {
+            frame.width = desc.toWidth - static_cast<int>((desc.toWidth - desc.fromWidth) * bounceOffset);
+            frame.x = desc.toX - static_cast<int>((desc.toX - desc.fromX) * bounceOffset);
+        }
+        bool skipBounceY = desc.skipAnimateY || (desc.fromHeight == desc.toHeight && desc.fromY == desc.toY);
+        if (skipBounceY) {
+            frame.height = desc.toHeight;
+            frame.y = desc.toY;
+        } else {
+            frame.height = desc.toHeight - static_cast<int>((desc.toHeight - desc.fromHeight) * bounceOffset);
+            frame.y = desc.toY - static_cast<int>((desc.toY - desc.fromY) * bounceOffset);
+        }
+        return frame;
+    }
+
+    frame.width = LerpAxis(desc.fromWidth, desc.toWidth, moveProgress);
+    frame.height = LerpAxis(desc.fromHeight, desc.toHeight, moveProgress);
+    frame.x = LerpAxis(desc.fromX, desc.toX, moveProgress);
+    frame.y = LerpAxis(desc.fromY, desc.toY, moveProgress);
+
+    // Apply skip axis options - if enabled, that axis instantly jumps to target
+    if (desc.skipAnimateX) {
+        frame.width = desc.toWidth;
+        frame.x = desc.toX;
+    }
+    if (desc.skipAnimateY) {
+        frame.height = desc.toHeight;
+        frame.y = desc.toY;
+    }
+    return frame;
+}
+
+void BakeModeTransitionEasing(ModeTransitionDescriptor& desc) {
+    auto lut = std::make_shared<EasingCurveLut>();
+    BuildDualEasingLut(desc.easeInPower, desc.easeOutPower, *lut);
+    desc.moveEasing = std::move(lut);
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+// ============================================================================
+// MODE_TRANSITION.H - Clock-injected evaluation of mode transitions
+// ============================================================================
+// A mode transition is fully described when it starts: where the game viewport comes from and goes to,
+// how long the move takes, the easing and bounce settings. StartModeTransition captures that in an
+// immutable ModeTransitionDescriptor and publishes it; nothing about it changes afterwards. The animated
+// state for a given moment is then a pure function of the descriptor and a timestamp, so every consumer
+// (viewport hook, game-thread render, OBS pass) evaluates it for its own present time without a lock,
+// and the same descriptor evaluated at the same time always gives the same frame. The easing curve is baked
+// into the descriptor when it is built, so evaluation is table lookups and a few multiplies.
+//
+// This file uses no GL or Win32, so transitions can be stepped frame by frame with made-up timestamps.
+// ============================================================================
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "mode_ids.h"
+
+struct EasingCurveLut;
+
+using TransitionClock = std::chrono::steady_clock;
+
+struct ModeTransitionDescriptor {
+    TransitionClock::time_point startTime;
+    float duration = 0.3f; // Movement phase in seconds; bounces come after it
+
+    // Bounce = the game viewport animates from -> to; otherwise it cuts to the target immediately
+    bool animateGame = false;
+
+    // Easing and bounce settings (copied from ModeConfig)
+    float easeInPower = 1.0f;
+    float easeOutPower = 3.0f;
+    int bounceCount = 0;
+    float bounceIntensity = 0.15f;
+    int bounceDurationMs = 150;
+    // ApplyDualEasing(easeInPower, easeOutPower) baked by BakeModeTransitionEasing; null evaluates the closed form
+    std::shared_ptr<const EasingCurveLut> moveEasing;
+    bool skipAnimateX = false; // When true, X axis instantly jumps to target
+    bool skipAnimateY = false; // When true, Y axis instantly jumps to target
+
+    // Source mode (animating FROM)
+    std::string fromModeId;
+    ModeIdHandle fromModeHandle = MODE_ID_NONE;
+    int fromWidth = 0;
+    int fromHeight = 0;
+    int fromX = 0;
+    int fromY = 0;
+
+    // Target mode (animating TO)
+    std::string toModeId;
+    int toWidth = 0;
+    int toHeight = 0;
+    int toX = 0;
+    int toY = 0;
+
+    // Native (non-stretched) dimensions - used for viewport matching
+    // When stretch is enabled, these differ from toWidth/toHeight
+    int fromNativeWidth = 0;
+    int fromNativeHeight = 0;
+    int toNativeWidth = 0;
+    int toNativeHeight = 0;
+};
+
+// Animated state of a transition at one timestamp
+struct ModeTransitionFrame {
+    bool complete = false; // The timestamp is at or past the end (including bounces)
+    int width = 0;
+    int height = 0;
+    int x = 0;
+    int y = 0;
+    float progress = 0.0f;     // 0.0 to 1.0 - overall animation progress including bounces
+    float moveProgress = 0.0f; // 0.0 to 1.0 - eased movement-only progress, reaches 1.0 when bounce starts
+};
+
+// Movement plus all bounces, in seconds
+float ModeTransitionTotalDuration(const ModeTransitionDescriptor& desc);
+
+// Pure: depends only on the descriptor and `now`. Times before startTime evaluate as the first frame.
+ModeTransitionFrame EvaluateModeTransition(const ModeTransitionDescriptor& desc, TransitionClock::time_point now);
+
+// Samples the move easing for the descriptor's powers (see easing_curve.h); call before publishing
+void BakeModeTransitionEasing(ModeTransitionDescriptor& desc);
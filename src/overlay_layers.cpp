@@ -0,0 +1,98 @@
+// ============================================================================
+// OVERLAY_LAYERS.CPP - Retained overlay layers for the render thread
+// ============================================================================
+
+#include "overlay_layers.h"
+
+#include <algorithm>
+#include <string>
+
+#include "utils.h"
+
+void OverlayLayerRegion::Include(float x1, float y1, float x2, float y2) {
+    if (x1 >= x2 || y1 >= y2) return;
+    for (int i = 0; i < count;) {
+        const Rect& r = rects[i];
+        // Full: fold into the last rectangle rather than drop coverage
+        const bool mustMerge = count == MAX_RECTS && i == count - 1;
+        if (mustMerge || (x1 < r.x2 && r.x1 < x2 && y1 < r.y2 && r.y1 < y2)) {
+            x1 = (std::min)(x1, r.x1);
+            y1 = (std::min)(y1, r.y1);
+            x2 = (std::max)(x2, r.x2);
+            y2 = (std::max)(y2, r.y2);
+            rects[i] = rects[--count];
+            i = 0; // The union may now overlap rectangles already checked
+            continue;
+        }
+        i++;
+    }
+    rects[count++] = { x1, y1, x2, y2 };
+}
+
+bool RetainedOverlayLayer::BeginUpdate(uint64_t contentHash, int width, int height) {
+    if (width <= 0 || height <= 0) return false;
+    if (m_valid && m_hash == contentHash && m_width == width && m_height == height) return false;
+
+    if (m_fbo == 0) { glGenFramebuffers(1, &m_fbo); }
+    if (m_texture == 0) { glGenTextures(1, &m_texture); }
+
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &m_prevDrawFbo);
+    glGetIntegerv(GL_VIEWPORT, m_prevViewport);
+
+    if (m_width != width || m_height != height) {
+        glBindTexture(GL_TEXTURE_2D, m_texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_fbo);
+        glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_texture, 0);
+        GLenum status = glCheckFramebufferStatus(GL_DRAW_FRAMEBUFFER);
+        if (status != GL_FRAMEBUFFER_COMPLETE) {
+            Log("RenderThread: overlay layer FBO incomplete: " + std::to_string(status));
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_prevDrawFbo);
+            m_valid = false;
+            return false;
+        }
+        m_width = width;
+        m_height = height;
+    } else {
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_fbo);
+    }
+
+    glViewport(0, 0, width, height);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    m_hash = contentHash;
+    m_valid = true;
+    return true;
+}
+
+void RetainedOverlayLayer::EndUpdate(const OverlayLayerRegion& drawn) {
+    m_region = OverlayLayerRegion{};
+    for (int i = 0; i < drawn.count; i++) {
+        const OverlayLayerRegion::Rect& r = drawn.rects[i];
+        m_region.Include((std::max)(r.x1, -1.0f), (std::max)(r.y1, -1.0f), (std::min)(r.x2, 1.0f), (std::min)(r.y2, 1.0f));
+    }
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_prevDrawFbo);
+    glViewport(m_prevViewport[0], m_prevViewport[1], m_prevViewport[2], m_prevViewport[3]);
+}
+
+void RetainedOverlayLayer::Release() {
+    if (m_fbo) {
+        glDeleteFramebuffers(1, &m_fbo);
+        m_fbo = 0;
+    }
+    if (m_texture) {
+        glDeleteTextures(1, &m_texture);
+        m_texture = 0;
+    }
+    m_width = m_height = 0;
+    m_valid = false;
+    m_region = OverlayLayerRegion{};
+    m_hasLastSeen = false;
+}
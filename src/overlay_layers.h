@@ -0,0 +1,91 @@
+#pragma once
+
+// ============================================================================
+// OVERLAY_LAYERS.H - Retained overlay layers for the render thread
+// ============================================================================
+// Most overlay content is static from frame to frame (image overlays with their backgrounds and
+// borders), yet each frame redraws it item by item. A RetainedOverlayLayer holds such content in its
+// own texture: the caller hashes every input of the layer (OverlayLayerHash) and only re-renders into
+// the texture when the hash changes; every frame it composites the texture with one fullscreen quad.
+//
+// Layer textures hold premultiplied alpha (the overlay shaders already blend alpha with
+// GL_ONE, GL_ONE_MINUS_SRC_ALPHA), so compositing with GL_ONE, GL_ONE_MINUS_SRC_ALPHA gives the same
+// result as drawing the items directly, up to 8-bit rounding. Only the rectangles the items actually
+// covered are composited (overlapping ones merged), so sparse layers do not pay for a fullscreen blend.
+// ============================================================================
+
+#ifndef GLEW_STATIC
+#define GLEW_STATIC
+#endif
+#include <GL/glew.h>
+#include <cstdint>
+#include <cstring>
+
+// FNV-1a over 64-bit words - collisions only cost a stale layer, and only for inputs that differ
+class OverlayLayerHash {
+  public:
+    void Add(uint64_t v) { m_hash = (m_hash ^ v) * 1099511628211ull; }
+    void AddFloat(float f) {
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        Add(bits);
+    }
+    void AddPointer(const void* p) { Add(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(p))); }
+    uint64_t Value() const { return m_hash; }
+
+  private:
+    uint64_t m_hash = 14695981039346656037ull;
+};
+
+// What was drawn into a layer, as disjoint NDC rectangles. Overlapping rectangles are merged into their
+// union so compositing never blends a texel twice; past MAX_RECTS everything collapses into fewer, larger ones.
+struct OverlayLayerRegion {
+    static constexpr int MAX_RECTS = 8;
+    struct Rect {
+        float x1, y1, x2, y2;
+    };
+
+    Rect rects[MAX_RECTS];
+    int count = 0;
+
+    void Include(float x1, float y1, float x2, float y2);
+    bool IsEmpty() const { return count == 0; }
+};
+
+class RetainedOverlayLayer {
+  public:
+    // Records this frame's content hash. Returns true once it matches the previous frame's - content that
+    // changes every frame (transitions, animations) is cheaper to draw directly than to re-render and composite.
+    bool NoteContent(uint64_t contentHash) {
+        bool settled = m_hasLastSeen && m_lastSeenHash == contentHash;
+        m_lastSeenHash = contentHash;
+        m_hasLastSeen = true;
+        return settled;
+    }
+
+    // If the layer is missing, resized or its hash changed: binds the layer as the draw framebuffer,
+    // clears it to transparent and returns true - draw the layer's items, then call EndUpdate().
+    // Returns false when the retained texture is still current.
+    bool BeginUpdate(uint64_t contentHash, int width, int height);
+    // Restores the draw framebuffer and viewport saved by BeginUpdate; `drawn` is what the items covered
+    void EndUpdate(const OverlayLayerRegion& drawn);
+
+    GLuint Texture() const { return m_texture; }
+    const OverlayLayerRegion& Region() const { return m_region; } // Clipped to the layer
+    bool IsValid() const { return m_valid; } // False until the first successful update, or after Invalidate()
+    void Invalidate() { m_valid = false; }
+    void Release(); // Deletes GL objects (render thread context must be current)
+
+  private:
+    GLuint m_fbo = 0;
+    GLuint m_texture = 0;
+    int m_width = 0, m_height = 0;
+    uint64_t m_hash = 0;
+    bool m_valid = false;
+    OverlayLayerRegion m_region;
+    uint64_t m_lastSeenHash = 0;
+    bool m_hasLastSeen = false;
+
+    GLint m_prevDrawFbo = 0;
+    GLint m_prevViewport[4] = {};
+};
@@ -0,0 +1,34 @@
+// ============================================================================
+// OVERLAY_STACK_KEY.CPP - Identity of the overlay stack a render pass draws
+// ============================================================================
+
+#include "overlay_stack_key.h"
+
+#include "mode_render_list.h"
+#include "overlay_layers.h"
+#include "render_thread.h"
+
+uint64_t HashOverlayStack(const FrameRenderRequest& request, bool isObsPass, const ModeRenderList& list, float timelineSeconds) {
+    OverlayLayerHash hash;
+    hash.AddPointer(&list);
+    const int geoX = isObsPass ? request.animatedX : request.finalX;
+    const int geoY = isObsPass ? request.animatedY : request.finalY;
+    const int geoW = isObsPass ? request.animatedW : request.finalW;
+    const int geoH = isObsPass ? request.animatedH : request.finalH;
+    for (int v : { request.fullW, request.fullH, request.gameW, request.gameH, geoX, geoY, geoW, geoH, request.fromX, request.fromY,
+                   request.fromW, request.fromH, request.toX, request.toY, request.toW, request.toH, request.eyeZoomAnimatedViewportX }) {
+        hash.Add(static_cast<uint32_t>(v));
+    }
+    hash.Add(request.fromModeHandle);
+    hash.Add(request.gameTextureId);
+    hash.AddFloat(request.overlayOpacity);
+    hash.AddFloat(request.transitionProgress);
+    hash.AddFloat(request.mirrorSlideProgress);
+    hash.AddFloat(list.hasAnimatedOverlays ? timelineSeconds : 0.0f);
+    const bool slideOutPossible = request.isTransitioningFromEyeZoom || (request.fromSlideMirrorsIn && request.mirrorSlideProgress < 1.0f);
+    const bool excludeMatters = list.hasOnlyOnMyScreenItems || slideOutPossible;
+    hash.Add((request.relativeStretching ? 1u : 0u) | (request.skipAnimation ? 2u : 0u) | (request.isRawWindowedMode ? 4u : 0u) |
+             (request.isTransitioningFromEyeZoom ? 8u : 0u) | (request.fromSlideMirrorsIn ? 16u : 0u) |
+             (request.toSlideMirrorsIn ? 32u : 0u) | (excludeMatters && request.excludeOnlyOnMyScreen ? 64u : 0u));
+    return hash.Value();
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+// ============================================================================
+// OVERLAY_STACK_KEY.H - Identity of the overlay stack a render pass draws
+// ============================================================================
+// Each render thread iteration can run an OBS pass and an on-screen pass. In steady state both draw the same
+// overlay stack (mirrors, slide-outs, images, window overlays), so the OBS pass renders it once into a shared
+// layer and the on-screen pass composites that instead of drawing it again (render_thread.cpp). The key below
+// decides when that is allowed: two passes with equal keys must draw identical stacks.
+// ============================================================================
+
+#include <cstdint>
+
+struct FrameRenderRequest;
+struct ModeRenderList;
+
+// Every request input the overlay stack reads, for the pass it would be drawn in: overlay placement follows
+// the animated viewport in the OBS pass and the final one on screen. onlyOnMyScreen filtering only counts when
+// some item could be filtered - the list's own items, or a slide-out set. timelineSeconds only counts for
+// lists with animated overlays.
+uint64_t HashOverlayStack(const FrameRenderRequest& request, bool isObsPass, const ModeRenderList& list, float timelineSeconds);
@@ -0,0 +1,138 @@
+// ============================================================================
+// OVERLAY_TIMELINE.CPP - Keyframe animation timelines for image and window overlays
+// ============================================================================
+
+#include "overlay_timeline.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+void KeyframeValues(const OverlayKeyframeConfig& k, float* out) {
+    out[TIMELINE_X] = static_cast<float>(k.x);
+    out[TIMELINE_Y] = static_cast<float>(k.y);
+    out[TIMELINE_SCALE] = k.scale;
+    out[TIMELINE_OPACITY] = k.opacity;
+    out[TIMELINE_CROP_TOP] = static_cast<float>(k.cropTop);
+    out[TIMELINE_CROP_BOTTOM] = static_cast<float>(k.cropBottom);
+    out[TIMELINE_CROP_LEFT] = static_cast<float>(k.cropLeft);
+    out[TIMELINE_CROP_RIGHT] = static_cast<float>(k.cropRight);
+}
+
+// Position within [0, duration]: wrapped when looping, held at the ends otherwise
+float TimelineTime(float seconds, float duration, bool loop) {
+    if (!(seconds > 0.0f) || duration <= 0.0f) return 0.0f;
+    if (loop) return std::fmod(seconds, duration);
+    return (std::min)(seconds, duration);
+}
+
+// `keyframes` sorted by time and not empty
+void EvaluateSorted(const std::vector<OverlayKeyframeConfig>& keyframes, bool loop, float seconds, float* out) {
+    const float duration = keyframes.back().timeMs / 1000.0f;
+    const float t = TimelineTime(seconds, duration, loop);
+
+    // Before the first keyframe, hold it; past the last one, hold that
+    size_t next = 0;
+    while (next < keyframes.size() && keyframes[next].timeMs / 1000.0f <= t) next++;
+    if (next == 0) {
+        KeyframeValues(keyframes.front(), out);
+        return;
+    }
+    if (next == keyframes.size()) {
+        KeyframeValues(keyframes.back(), out);
+        return;
+    }
+
+    const OverlayKeyframeConfig& a = keyframes[next - 1];
+    const OverlayKeyframeConfig& b = keyframes[next];
+    const float t0 = a.timeMs / 1000.0f;
+    const float t1 = b.timeMs / 1000.0f;
+    const float u = (t1 > t0) ? (t - t0) / (t1 - t0) : 1.0f;
+    const float e = ApplyEasing(a.easing, std::clamp(u, 0.0f, 1.0f));
+
+    float va[TIMELINE_CHANNEL_COUNT], vb[TIMELINE_CHANNEL_COUNT];
+    KeyframeValues(a, va);
+    KeyframeValues(b, vb);
+    for (int c = 0; c < TIMELINE_CHANNEL_COUNT; c++) { out[c] = va[c] + (vb[c] - va[c]) * e; }
+}
+
+std::vector<OverlayKeyframeConfig> SortedKeyframes(const OverlayTimelineConfig& config) {
+    std::vector<OverlayKeyframeConfig> keyframes = config.keyframes;
+    for (auto& k : keyframes) { k.timeMs = (std::max)(0, k.timeMs); }
+    std::stable_sort(keyframes.begin(), keyframes.end(),
+                     [](const OverlayKeyframeConfig& a, const OverlayKeyframeConfig& b) { return a.timeMs < b.timeMs; });
+    return keyframes;
+}
+
+} // namespace
+
+void CompiledOverlayTimeline::Evaluate(float seconds, float* out) const {
+    if (m_rows <= 0) {
+        // Identity: no offsets, unit multipliers
+        for (int c = 0; c < TIMELINE_CHANNEL_COUNT; c++) out[c] = 0.0f;
+        out[TIMELINE_SCALE] = 1.0f;
+        out[TIMELINE_OPACITY] = 1.0f;
+        return;
+    }
+    if (m_rows == 1) {
+        for (int c = 0; c < TIMELINE_CHANNEL_COUNT; c++) out[c] = m_samples[c];
+        return;
+    }
+
+    const float pos = TimelineTime(seconds, m_duration, m_loop) * m_rowsPerSecond;
+    const int i = (std::min)(static_cast<int>(pos), m_rows - 2);
+    const float frac = (std::min)(pos - static_cast<float>(i), 1.0f);
+    const float* r0 = &m_samples[static_cast<size_t>(i) * TIMELINE_CHANNEL_COUNT];
+    const float* r1 = r0 + TIMELINE_CHANNEL_COUNT;
+    for (int c = 0; c < TIMELINE_CHANNEL_COUNT; c++) { out[c] = r0[c] + (r1[c] - r0[c]) * frac; }
+}
+
+void CompileOverlayTimeline(const OverlayTimelineConfig& config, CompiledOverlayTimeline& out) {
+    out = CompiledOverlayTimeline{};
+    if (config.keyframes.empty()) return;
+
+    const std::vector<OverlayKeyframeConfig> keyframes = SortedKeyframes(config);
+    out.m_loop = config.loop;
+    out.m_duration = keyframes.back().timeMs / 1000.0f;
+
+    if (out.m_duration <= 0.0f) {
+        // A single pose
+        out.m_rows = 1;
+        out.m_samples.resize(TIMELINE_CHANNEL_COUNT);
+        EvaluateSorted(keyframes, false, 0.0f, out.m_samples.data());
+        return;
+    }
+
+    const int wanted = static_cast<int>(std::ceil(out.m_duration * OVERLAY_TIMELINE_SAMPLE_RATE)) + 1;
+    out.m_rows = std::clamp(wanted, 2, OVERLAY_TIMELINE_MAX_ROWS);
+    out.m_rowsPerSecond = (out.m_rows - 1) / out.m_duration;
+    out.m_samples.resize(static_cast<size_t>(out.m_rows) * TIMELINE_CHANNEL_COUNT);
+    for (int i = 0; i < out.m_rows; i++) {
+        // Sample without wrapping so the last row is the last keyframe
+        const float t = (i == out.m_rows - 1) ? out.m_duration : i / out.m_rowsPerSecond;
+        EvaluateSorted(keyframes, false, t, &out.m_samples[static_cast<size_t>(i) * TIMELINE_CHANNEL_COUNT]);
+    }
+}
+
+void EvaluateOverlayKeyframes(const OverlayTimelineConfig& config, float seconds, float* out) {
+    if (config.keyframes.empty()) {
+        CompiledOverlayTimeline{}.Evaluate(seconds, out);
+        return;
+    }
+    EvaluateSorted(SortedKeyframes(config), config.loop, seconds, out);
+}
+
+void ApplyOverlayTimeline(const CompiledOverlayTimeline& timeline, float seconds, OverlayPlacement& placement) {
+    if (!timeline.IsAnimated()) return;
+    float v[TIMELINE_CHANNEL_COUNT];
+    timeline.Evaluate(seconds, v);
+    placement.x += static_cast<int>(std::lround(v[TIMELINE_X]));
+    placement.y += static_cast<int>(std::lround(v[TIMELINE_Y]));
+    placement.scale *= (std::max)(v[TIMELINE_SCALE], 0.0f);
+    placement.opacity *= std::clamp(v[TIMELINE_OPACITY], 0.0f, 1.0f);
+    placement.cropTop = (std::max)(0, placement.cropTop + static_cast<int>(std::lround(v[TIMELINE_CROP_TOP])));
+    placement.cropBottom = (std::max)(0, placement.cropBottom + static_cast<int>(std::lround(v[TIMELINE_CROP_BOTTOM])));
+    placement.cropLeft = (std::max)(0, placement.cropLeft + static_cast<int>(std::lround(v[TIMELINE_CROP_LEFT])));
+    placement.cropRight = (std::max)(0, placement.cropRight + static_cast<int>(std::lround(v[TIMELINE_CROP_RIGHT])));
+}
@@ -1,4 +1,5 @@
 #include "profiler.h"
+#include "gpu_timer.h"
 #include "utils.h" // For Log()
 #include <algorithm>
 #include <functional>
@@ -78,8 +79,29 @@ Profiler::ScopedTimer::~ScopedTimer() {
     }
 }
 
+// GPU scopes - resolving earlier scopes only at the outermost one keeps nested scopes at two timestamps each
+Profiler::ScopedGpuTimer::ScopedGpuTimer(Profiler& profiler, const char* sectionName) : m_ring(nullptr), m_slot(-1) {
+    if (!profiler.IsEnabled()) return;
+    GpuTimerRing* ring = GpuTimerRing::ForCurrentContext();
+    if (!ring) return;
+
+    if (ring->OpenScopes() == 0) {
+        thread_local std::vector<GpuScopeTiming> resolved;
+        resolved.clear();
+        ring->Collect(resolved);
+        for (const GpuScopeTiming& t : resolved) { profiler.SubmitEvent(t.name, t.parentName, t.durationMs, t.depth, true); }
+    }
+
+    m_slot = ring->BeginScope(sectionName);
+    if (m_slot >= 0) { m_ring = ring; }
+}
+
+Profiler::ScopedGpuTimer::~ScopedGpuTimer() {
+    if (m_ring) { m_ring->EndScope(m_slot); }
+}
+
 // Lock-free event submission - O(1), no locks, no allocations
-void Profiler::SubmitEvent(const char* sectionName, const char* parentName, double durationMs, uint8_t depth) {
+void Profiler::SubmitEvent(const char* sectionName, const char* parentName, double durationMs, uint8_t depth, bool isGpu) {
     if (!m_enabled) return;
 
     ThreadRingBuffer& buffer = GetThreadBuffer();
@@ -111,6 +133,7 @@ void Profiler::SubmitEvent(const char* sectionName, const char* parentName, doub
     event.threadId = buffer.threadId;
     event.depth = depth;
     event.isRenderThread = buffer.isRenderThread;
+    event.isGpu = isGpu;
 
     // Publish the write (release semantics ensure event data is visible)
     buffer.writeIndex.store(nextWritePos, std::memory_order_release);
@@ -155,7 +178,7 @@ void Profiler::ProcessEvents() {
             const TimingEvent& event = buffer->events[readPos];
 
             // Process this event into our aggregated data
-            auto& targetEntries = event.isRenderThread ? m_renderThreadEntries : m_otherThreadEntries;
+            auto& targetEntries = event.isGpu ? m_gpuEntries : (event.isRenderThread ? m_renderThreadEntries : m_otherThreadEntries);
 
             // Use section name as key
             std::string pathKey = event.sectionName;
@@ -288,17 +311,24 @@ void Profiler::EndFrame() {
     // Calculate totals
     m_totalRenderTime = 0.0;
     m_totalOtherTime = 0.0;
+    m_totalGpuTime = 0.0;
 
     for (const auto& [path, entry] : m_renderThreadEntries) { m_totalRenderTime += entry.totalTime; }
     for (const auto& [path, entry] : m_otherThreadEntries) { m_totalOtherTime += entry.totalTime; }
+    // GPU scopes nest in one timeline per context, so only root scopes add up to GPU time
+    for (const auto& [path, entry] : m_gpuEntries) {
+        if (entry.parentPath.empty()) { m_totalGpuTime += entry.totalTime; }
+    }
 
     // Calculate hierarchy (self time, percentages)
     CalculateHierarchy(m_renderThreadEntries, m_totalRenderTime);
     CalculateHierarchy(m_otherThreadEntries, m_totalOtherTime);
+    CalculateHierarchy(m_gpuEntries, m_totalGpuTime);
 
     // Accumulate for rolling average
     m_accumulatedRenderTime += m_totalRenderTime;
     m_accumulatedOtherTime += m_totalOtherTime;
+    m_accumulatedGpuTime += m_totalGpuTime;
     m_frameCountForAveraging++;
 
     // Accumulate per-entry data
@@ -312,6 +342,7 @@ void Profiler::EndFrame() {
     };
     accumulateEntries(m_renderThreadEntries);
     accumulateEntries(m_otherThreadEntries);
+    accumulateEntries(m_gpuEntries);
 
     // Reset frame data for next frame
     for (auto& [path, entry] : m_renderThreadEntries) {
@@ -324,9 +355,14 @@ void Profiler::EndFrame() {
         entry.selfTime = 0.0;
         entry.callCount = 0;
     }
+    for (auto& [path, entry] : m_gpuEntries) {
+        entry.totalTime = 0.0;
+        entry.selfTime = 0.0;
+        entry.callCount = 0;
+    }
 
     // Remove stale entries that haven't been updated in 5 seconds
-    constexpr auto STALE_THRESHOLD = std::chrono::seconds(5);
+    static constexpr auto STALE_THRESHOLD = std::chrono::seconds(5);
     auto removeStaleEntries = [&currentTime](std::unordered_map<std::string, ProfileEntry>& entries) {
         for (auto it = entries.begin(); it != entries.end();) {
             auto timeSinceUpdate = currentTime - it->second.lastUpdateTime;
@@ -339,12 +375,14 @@ void Profiler::EndFrame() {
     };
     removeStaleEntries(m_renderThreadEntries);
     removeStaleEntries(m_otherThreadEntries);
+    removeStaleEntries(m_gpuEntries);
 
     // Update display cache
     auto timeSinceLastUpdate = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - m_lastUpdateTime);
     if (timeSinceLastUpdate.count() >= UPDATE_INTERVAL_MS) {
         double avgRenderTime = m_frameCountForAveraging > 0 ? m_accumulatedRenderTime / m_frameCountForAveraging : 0.0;
         double avgOtherTime = m_frameCountForAveraging > 0 ? m_accumulatedOtherTime / m_frameCountForAveraging : 0.0;
+        double avgGpuTime = m_frameCountForAveraging > 0 ? m_accumulatedGpuTime / m_frameCountForAveraging : 0.0;
 
         auto updateRollingAverages = [this](std::unordered_map<std::string, ProfileEntry>& entries, double avgTotal) {
             for (auto& [path, entry] : entries) {
@@ -357,12 +395,14 @@ void Profiler::EndFrame() {
         };
         updateRollingAverages(m_renderThreadEntries, avgRenderTime);
         updateRollingAverages(m_otherThreadEntries, avgOtherTime);
+        updateRollingAverages(m_gpuEntries, avgGpuTime);
 
         // Lock mutex while updating display cache to prevent race with GetProfileData
         {
             std::lock_guard<std::mutex> lock(m_displayDataMutex);
             BuildDisplayTree(m_renderThreadEntries, m_cachedDisplayData.renderThread);
             BuildDisplayTree(m_otherThreadEntries, m_cachedDisplayData.otherThreads);
+            BuildDisplayTree(m_gpuEntries, m_cachedDisplayData.gpu);
         }
 
         m_lastUpdateTime = currentTime;
@@ -377,9 +417,45 @@ Profiler::DisplayData Profiler::GetProfileData() const {
 std::vector<std::pair<std::string, Profiler::ProfileEntry>> Profiler::GetProfileDataFlat() const {
     std::lock_guard<std::mutex> lock(m_displayDataMutex);
     std::vector<std::pair<std::string, ProfileEntry>> result;
-    result.reserve(m_cachedDisplayData.renderThread.size() + m_cachedDisplayData.otherThreads.size());
+    result.reserve(m_cachedDisplayData.renderThread.size() + m_cachedDisplayData.otherThreads.size() + m_cachedDisplayData.gpu.size());
     for (const auto& entry : m_cachedDisplayData.renderThread) result.push_back(entry);
     for (const auto& entry : m_cachedDisplayData.otherThreads) result.push_back(entry);
+    for (const auto& entry : m_cachedDisplayData.gpu) result.push_back(entry);
+    return result;
+}
+
+void Profiler::RecordHits(const char* name, uint32_t hits, uint32_t total) {
+    if (!m_enabled) return;
+    auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(m_hitCounterMutex);
+    auto it = std::find_if(m_hitCounters.begin(), m_hitCounters.end(), [name](const auto& c) { return c.first == name; });
+    if (it == m_hitCounters.end()) {
+        m_hitCounters.push_back({ name, HitCounter{} });
+        it = m_hitCounters.end() - 1;
+        it->second.windowStart = now;
+    }
+
+    HitCounter& counter = it->second;
+    counter.hits += hits;
+    counter.total += total;
+    if (std::chrono::duration_cast<std::chrono::milliseconds>(now - counter.windowStart).count() >= UPDATE_INTERVAL_MS) {
+        counter.shownHits = counter.hits;
+        counter.shownTotal = counter.total;
+        counter.hits = counter.total = 0;
+        counter.windowStart = now;
+    }
+}
+
+std::vector<Profiler::HitRate> Profiler::GetHitRates() const {
+    std::lock_guard<std::mutex> lock(m_hitCounterMutex);
+    std::vector<HitRate> result;
+    result.reserve(m_hitCounters.size());
+    for (const auto& [name, counter] : m_hitCounters) {
+        // Until the first window completes, show the partial one
+        bool completed = counter.shownTotal > 0;
+        result.push_back({ name, completed ? counter.shownHits : counter.hits, completed ? counter.shownTotal : counter.total });
+    }
     return result;
 }
 
@@ -397,11 +473,18 @@ void Profiler::Clear() {
 
     m_renderThreadEntries.clear();
     m_otherThreadEntries.clear();
+    m_gpuEntries.clear();
     m_cachedDisplayData.renderThread.clear();
     m_cachedDisplayData.otherThreads.clear();
+    m_cachedDisplayData.gpu.clear();
     m_totalRenderTime = 0.0;
     m_totalOtherTime = 0.0;
+    m_totalGpuTime = 0.0;
     m_accumulatedRenderTime = 0.0;
     m_accumulatedOtherTime = 0.0;
+    m_accumulatedGpuTime = 0.0;
     m_frameCountForAveraging = 0;
+
+    std::lock_guard<std::mutex> lock(m_hitCounterMutex);
+    m_hitCounters.clear();
 }
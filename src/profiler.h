@@ -8,6 +8,8 @@
 #include <unordered_map>
 #include <vector>
 
+class GpuTimerRing;
+
 // Lock-free hierarchical profiler using a single-producer queue per thread
 // Hot path (PROFILE_SCOPE) is completely lock-free - just writes to a ring buffer
 // Background thread aggregates and processes timing data
@@ -51,6 +53,7 @@ class Profiler {
         uint32_t threadId;       // Thread that generated this event
         uint8_t depth;           // Stack depth when event was created
         bool isRenderThread;     // Whether from render thread
+        bool isGpu;              // GPU time from PROFILE_GPU_SCOPE (any thread)
     };
 
     // Lock-free ring buffer for timing events (per-thread)
@@ -84,6 +87,21 @@ class Profiler {
         bool m_active;
     };
 
+    // GPU counterpart of ScopedTimer: GL_TIMESTAMP queries around the scope on the current context (gpu_timer.h).
+    // Results arrive a few frames late and are aggregated separately from CPU time
+    class ScopedGpuTimer {
+      public:
+        ScopedGpuTimer(Profiler& profiler, const char* sectionName);
+        ~ScopedGpuTimer();
+
+        ScopedGpuTimer(const ScopedGpuTimer&) = delete;
+        ScopedGpuTimer& operator=(const ScopedGpuTimer&) = delete;
+
+      private:
+        GpuTimerRing* m_ring;
+        int m_slot;
+    };
+
     static Profiler& GetInstance();
     static ThreadRingBuffer& GetThreadBuffer();
 
@@ -91,7 +109,7 @@ class Profiler {
     void MarkAsRenderThread();
 
     // Lock-free event submission (called from ScopedTimer destructor)
-    void SubmitEvent(const char* sectionName, const char* parentName, double durationMs, uint8_t depth);
+    void SubmitEvent(const char* sectionName, const char* parentName, double durationMs, uint8_t depth, bool isGpu = false);
 
     // Frame management
     void EndFrame();
@@ -104,12 +122,23 @@ class Profiler {
     struct DisplayData {
         std::vector<std::pair<std::string, ProfileEntry>> renderThread;
         std::vector<std::pair<std::string, ProfileEntry>> otherThreads;
+        std::vector<std::pair<std::string, ProfileEntry>> gpu;
     };
     DisplayData GetProfileData() const;
 
     // Legacy API for compatibility
     std::vector<std::pair<std::string, ProfileEntry>> GetProfileDataFlat() const;
 
+    // Hit counters (cache hit rates and the like), shown below the timings.
+    // Each rate covers the last completed UPDATE_INTERVAL_MS window. Takes a mutex, so record once per frame, not per item.
+    struct HitRate {
+        std::string name;
+        uint64_t hits = 0;
+        uint64_t total = 0;
+    };
+    void RecordHits(const char* name, uint32_t hits, uint32_t total);
+    std::vector<HitRate> GetHitRates() const;
+
     void Clear();
     void SetEnabled(bool enabled) { m_enabled = enabled; }
     bool IsEnabled() const { return m_enabled; }
@@ -127,17 +156,28 @@ class Profiler {
     // Processed data (only accessed by processing thread and display)
     std::unordered_map<std::string, ProfileEntry> m_renderThreadEntries;
     std::unordered_map<std::string, ProfileEntry> m_otherThreadEntries;
+    std::unordered_map<std::string, ProfileEntry> m_gpuEntries;
 
     double m_totalRenderTime = 0.0;
     double m_totalOtherTime = 0.0;
+    double m_totalGpuTime = 0.0;
     double m_accumulatedRenderTime = 0.0;
     double m_accumulatedOtherTime = 0.0;
+    double m_accumulatedGpuTime = 0.0;
     int m_frameCountForAveraging = 0;
     static constexpr int MAX_FRAMES_FOR_AVERAGING = 360;
 
     // Display cache - protected by mutex for thread-safe access
     mutable std::mutex m_displayDataMutex;
     DisplayData m_cachedDisplayData;
+
+    struct HitCounter {
+        uint64_t hits = 0, total = 0;             // Current window
+        uint64_t shownHits = 0, shownTotal = 0;   // Last completed window
+        std::chrono::steady_clock::time_point windowStart{};
+    };
+    mutable std::mutex m_hitCounterMutex;
+    std::vector<std::pair<std::string, HitCounter>> m_hitCounters; // Few entries - linear search
     std::chrono::steady_clock::time_point m_lastUpdateTime;
     static constexpr int UPDATE_INTERVAL_MS = 1000;
 
@@ -158,4 +198,9 @@ class Profiler {
 // Category macro is now an alias (category becomes parent override if needed in future)
 #define PROFILE_SCOPE_CAT(name, category) PROFILE_SCOPE(name)
 
+// GPU time of the enclosed GL work; combine with PROFILE_SCOPE to see both sides of the same section
+#define PROFILE_GPU_SCOPE(name) Profiler::ScopedGpuTimer _profiler_gpu_timer_##__LINE__(Profiler::GetInstance(), name)
+
+#define PROFILE_HITS(name, hits, total) Profiler::GetInstance().RecordHits(name, hits, total)
+
 #define PROFILE_START(name) /* deprecated - use PROFILE_SCOPE */
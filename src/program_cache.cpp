@@ -0,0 +1,249 @@
+// ============================================================================
+// PROGRAM_CACHE.CPP - On-disk cache of linked GL program binaries
+// ============================================================================
+
+#include "program_cache.h"
+#include "utils.h"
+
+#ifndef GLEW_STATIC
+#define GLEW_STATIC
+#endif
+#include <GL/glew.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <windows.h>
+
+namespace {
+
+constexpr uint32_t PROGRAM_CACHE_MAGIC = 0x42505354; // "TSPB"
+constexpr size_t HEADER_SIZE = 40;
+constexpr size_t MAX_BINARY_SIZE = 16u * 1024u * 1024u; // Sanity limit for a corrupt length field
+
+// FNV-1a over bytes
+uint64_t HashBytes(uint64_t h, const void* data, size_t size) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+constexpr uint64_t HASH_BASIS = 14695981039346656037ull;
+
+void PutU32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = static_cast<uint8_t>(v >> (i * 8));
+}
+void PutU64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; i++) p[i] = static_cast<uint8_t>(v >> (i * 8));
+}
+uint32_t GetU32(const uint8_t* p) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) v |= static_cast<uint32_t>(p[i]) << (i * 8);
+    return v;
+}
+uint64_t GetU64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) v |= static_cast<uint64_t>(p[i]) << (i * 8);
+    return v;
+}
+
+// Per-thread lookups, read by ScopedProgramCacheReport
+thread_local uint32_t t_cacheHits = 0;
+thread_local uint32_t t_cacheMisses = 0;
+
+bool IsBinaryCacheSupported() {
+    if (!(GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)) return false;
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+// Empty when there is no toolscreen directory to put the cache in
+std::wstring CacheDirectory() {
+    static std::mutex s_dirMutex;
+    static bool s_dirCreated = false;
+    if (g_toolscreenPath.empty()) return std::wstring();
+    std::wstring dir = g_toolscreenPath + L"\\shader_cache";
+    std::lock_guard<std::mutex> lock(s_dirMutex);
+    if (!s_dirCreated) {
+        CreateDirectoryW(dir.c_str(), NULL);
+        s_dirCreated = true;
+    }
+    return dir;
+}
+
+std::wstring CachePath(const ProgramCacheKey& key) {
+    std::wstring dir = CacheDirectory();
+    if (dir.empty()) return dir;
+    const std::string name = key.FileName();
+    return dir + L"\\" + std::wstring(name.begin(), name.end());
+}
+
+} // namespace
+
+std::string ProgramCacheKey::FileName() const {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%016llx%016llx.bin", static_cast<unsigned long long>(sourceHash),
+             static_cast<unsigned long long>(driverHash));
+    return buf;
+}
+
+ProgramCacheKey MakeProgramCacheKey(const char* const* sources, int count, const std::string& driver) {
+    ProgramCacheKey key;
+    uint64_t h = HASH_BASIS;
+    for (int i = 0; i < count; i++) {
+        const size_t len = sources[i] ? strlen(sources[i]) : 0;
+        // Lengths keep "ab"+"c" and "a"+"bc" apart
+        const uint64_t len64 = len;
+        h = HashBytes(h, &len64, sizeof(len64));
+        h = HashBytes(h, sources[i], len);
+    }
+    key.sourceHash = h;
+    key.driverHash = HashBytes(HASH_BASIS, driver.data(), driver.size());
+    return key;
+}
+
+std::vector<uint8_t> SerializeProgramBinary(const ProgramCacheKey& key, const ProgramBinaryBlob& blob) {
+    std::vector<uint8_t> out(HEADER_SIZE + blob.data.size());
+    uint8_t* p = out.data();
+    PutU32(p + 0, PROGRAM_CACHE_MAGIC);
+    PutU32(p + 4, PROGRAM_CACHE_FORMAT_VERSION);
+    PutU64(p + 8, key.sourceHash);
+    PutU64(p + 16, key.driverHash);
+    PutU32(p + 24, blob.format);
+    PutU32(p + 28, static_cast<uint32_t>(blob.data.size()));
+    PutU64(p + 32, HashBytes(HASH_BASIS, blob.data.data(), blob.data.size()));
+    if (!blob.data.empty()) memcpy(p + HEADER_SIZE, blob.data.data(), blob.data.size());
+    return out;
+}
+
+bool ParseProgramBinary(const uint8_t* bytes, size_t size, const ProgramCacheKey& expected, ProgramBinaryBlob& out) {
+    if (!bytes || size < HEADER_SIZE) return false;
+    if (GetU32(bytes + 0) != PROGRAM_CACHE_MAGIC || GetU32(bytes + 4) != PROGRAM_CACHE_FORMAT_VERSION) return false;
+    if (GetU64(bytes + 8) != expected.sourceHash || GetU64(bytes + 16) != expected.driverHash) return false;
+
+    const uint32_t length = GetU32(bytes + 28);
+    if (length == 0 || length > MAX_BINARY_SIZE || size - HEADER_SIZE != length) return false;
+    if (GetU64(bytes + 32) != HashBytes(HASH_BASIS, bytes + HEADER_SIZE, length)) return false;
+
+    out.format = GetU32(bytes + 24);
+    out.data.assign(bytes + HEADER_SIZE, bytes + HEADER_SIZE + length);
+    return true;
+}
+
+ProgramCacheKey MakeProgramCacheKeyForCurrentContext(const char* const* sources, int count) {
+    std::string driver;
+    const GLenum names[] = { GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION };
+    for (GLenum name : names) {
+        const GLubyte* s = glGetString(name);
+        if (s) driver += reinterpret_cast<const char*>(s);
+        driver += '\n';
+    }
+    return MakeProgramCacheKey(sources, count, driver);
+}
+
+uint32_t LoadCachedProgram(const ProgramCacheKey& key) {
+    t_cacheMisses++; // Undone on success
+    if (!IsBinaryCacheSupported()) return 0;
+    const std::wstring path = CachePath(key);
+    if (path.empty()) return 0;
+
+    std::vector<uint8_t> file;
+    {
+        // IMPORTANT (Windows/Unicode): open via std::filesystem::path so wide Win32 APIs are used.
+        std::ifstream in(std::filesystem::path(path), std::ios::binary | std::ios::ate);
+        if (!in.is_open()) return 0;
+        std::streamoff size = in.tellg();
+        if (size <= 0 || static_cast<uint64_t>(size) > HEADER_SIZE + MAX_BINARY_SIZE) return 0;
+        in.seekg(0, std::ios::beg);
+        file.resize(static_cast<size_t>(size));
+        in.read(reinterpret_cast<char*>(file.data()), static_cast<std::streamsize>(file.size()));
+        if (static_cast<size_t>(in.gcount()) != file.size()) return 0;
+    }
+
+    ProgramBinaryBlob blob;
+    if (!ParseProgramBinary(file.data(), file.size(), key, blob)) {
+        DeleteFileW(path.c_str());
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, blob.format, blob.data.data(), static_cast<GLsizei>(blob.data.size()));
+    GLint ok = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        // Same driver strings but the binary is no longer accepted; compile from source and rewrite it
+        LogCategory("init", "Program cache: driver rejected " + key.FileName() + ", recompiling");
+        glDeleteProgram(program);
+        DeleteFileW(path.c_str());
+        return 0;
+    }
+
+    t_cacheMisses--;
+    t_cacheHits++;
+    return program;
+}
+
+void PrepareProgramForCache(uint32_t program) {
+    if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary) { glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE); }
+}
+
+void StoreCachedProgram(const ProgramCacheKey& key, uint32_t program) {
+    if (!program || !IsBinaryCacheSupported()) return;
+    const std::wstring path = CachePath(key);
+    if (path.empty()) return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0 || static_cast<size_t>(length) > MAX_BINARY_SIZE) return;
+
+    ProgramBinaryBlob blob;
+    blob.data.resize(static_cast<size_t>(length));
+    GLsizei written = 0;
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &written, &format, blob.data.data());
+    if (written <= 0) return;
+    blob.data.resize(static_cast<size_t>(written));
+    blob.format = format;
+
+    const std::vector<uint8_t> bytes = SerializeProgramBinary(key, blob);
+
+    // Several contexts can store the same program at once; each writes its own temp file and the rename
+    // replaces the entry atomically
+    const std::wstring tempPath = path + L"." + std::to_wstring(GetCurrentThreadId()) + L".tmp";
+    {
+        // IMPORTANT (Windows/Unicode): open via std::filesystem::path so wide Win32 APIs are used.
+        std::ofstream out(std::filesystem::path(tempPath), std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return;
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        out.flush();
+        if (!out.good()) {
+            out.close();
+            DeleteFileW(tempPath.c_str());
+            return;
+        }
+    }
+    if (!MoveFileExW(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING)) { DeleteFileW(tempPath.c_str()); }
+}
+
+ScopedProgramCacheReport::ScopedProgramCacheReport(const char* logPrefix)
+    : m_logPrefix(logPrefix),
+      m_startTicks(std::chrono::steady_clock::now().time_since_epoch().count()),
+      m_startHits(t_cacheHits),
+      m_startMisses(t_cacheMisses) {}
+
+ScopedProgramCacheReport::~ScopedProgramCacheReport() {
+    const std::chrono::steady_clock::duration elapsed =
+        std::chrono::steady_clock::now().time_since_epoch() - std::chrono::steady_clock::duration(m_startTicks);
+    const double ms = std::chrono::duration<double, std::milli>(elapsed).count();
+    const uint32_t hits = t_cacheHits - m_startHits;
+    const uint32_t total = hits + (t_cacheMisses - m_startMisses);
+
+    char buf[128];
+    snprintf(buf, sizeof(buf), "%s: Shaders initialized in %.1f ms (%u/%u programs from binary cache)", m_logPrefix, ms, hits, total);
+    LogCategory("init", buf);
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+// ============================================================================
+// PROGRAM_CACHE.H - On-disk cache of linked GL program binaries
+// ============================================================================
+// GL programs are not shared between contexts, so the main context, the render thread and the mirror
+// thread each compile and link their own programs at startup. With GL_ARB_get_program_binary the linked
+// result can be saved (glGetProgramBinary) and restored on the next start (glProgramBinary), skipping the
+// compiler entirely. Contexts that build a program from the same sources share one cache file.
+//
+// Entries are keyed by a hash of the shader sources plus a hash of the driver identification (vendor,
+// renderer, version strings): a driver update changes the key, and a binary the driver rejects anyway is
+// deleted and the program compiled from source as before. Files live in <toolscreen>\shader_cache, one per
+// program. The key and file format code below uses no GL, so it can be exercised without a context.
+// ============================================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Bump when the file layout changes; older files are then treated as misses
+constexpr uint32_t PROGRAM_CACHE_FORMAT_VERSION = 1;
+
+struct ProgramCacheKey {
+    uint64_t sourceHash = 0;
+    uint64_t driverHash = 0;
+
+    // Cache file name (no directory): 32 hex digits plus extension
+    std::string FileName() const;
+};
+
+// `sources` are the stage sources in attach order; `driver` identifies the driver that built the binary
+ProgramCacheKey MakeProgramCacheKey(const char* const* sources, int count, const std::string& driver);
+
+struct ProgramBinaryBlob {
+    uint32_t format = 0; // GL binary format enum reported by glGetProgramBinary
+    std::vector<uint8_t> data;
+};
+
+// Header (key, format version, binary format, length, payload checksum) followed by the binary
+std::vector<uint8_t> SerializeProgramBinary(const ProgramCacheKey& key, const ProgramBinaryBlob& blob);
+// False for truncated or corrupt files and for files written under a different key or format version
+bool ParseProgramBinary(const uint8_t* bytes, size_t size, const ProgramCacheKey& expected, ProgramBinaryBlob& out);
+
+// === GL side (current context) ===
+
+// Key for a program built from `sources` by the current context's driver
+ProgramCacheKey MakeProgramCacheKeyForCurrentContext(const char* const* sources, int count);
+// Linked program restored from the cache, or 0 (miss, unsupported, or rejected by the driver)
+uint32_t LoadCachedProgram(const ProgramCacheKey& key);
+// Call before glLinkProgram on a program that will be stored
+void PrepareProgramForCache(uint32_t program);
+// Saves a successfully linked program
+void StoreCachedProgram(const ProgramCacheKey& key, uint32_t program);
+
+// Times one shader initialization pass on the calling thread and logs it with the number of programs
+// the cache supplied, so cold (compile) and warm (binary load) starts can be compared
+class ScopedProgramCacheReport {
+  public:
+    explicit ScopedProgramCacheReport(const char* logPrefix);
+    ~ScopedProgramCacheReport();
+
+    ScopedProgramCacheReport(const ScopedProgramCacheReport&) = delete;
+    ScopedProgramCacheReport& operator=(const ScopedProgramCacheReport&) = delete;
+
+  private:
+    const char* m_logPrefix;
+    int64_t m_startTicks;
+    uint32_t m_startHits;
+    uint32_t m_startMisses;
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+// ============================================================================
+// RCU_SNAPSHOT.H - Immutable value published through an atomic shared_ptr
+// ============================================================================
+// Readers Load() the current value and keep it alive for as long as they hold the shared_ptr; a publish
+// never changes a value a reader already has. Writers build the next value off to the side (usually a copy
+// of Load() with one edit) and Publish() it. Writers must be serialized by the caller, otherwise concurrent
+// copy-edit-publish sequences lose each other's edits; readers never take that lock.
+//
+// Reclamation is the shared_ptr refcount: whoever drops the last reference to an old value frees it, so no
+// epochs or grace periods are needed. The atomic load/store themselves go through the standard library's
+// shared_ptr atomics, which (MSVC and libstdc++ alike) guard the pointer swap with a short internal
+// spinlock. A reader can therefore wait for another thread's pointer swap, but never for a writer's
+// copy and edit.
+// ============================================================================
+
+#include <atomic>
+#include <memory>
+
+template <typename T> class RcuSnapshot {
+  public:
+    RcuSnapshot() : m_current(std::make_shared<const T>()) {}
+
+    std::shared_ptr<const T> Load() const { return std::atomic_load_explicit(&m_current, std::memory_order_acquire); }
+
+    // Caller serializes writers
+    void Publish(std::shared_ptr<const T> next) { std::atomic_store_explicit(&m_current, std::move(next), std::memory_order_release); }
+
+  private:
+    std::shared_ptr<const T> m_current;
+};
@@ -1,10 +1,12 @@
 #include "render.h"
 #include "fake_cursor.h"
+#include "gl_state_tracker.h"
 #include "gui.h"
 #include "logic_thread.h"
 #include "mirror_thread.h"
 #include "obs_thread.h"
 #include "profiler.h"
+#include "program_cache.h"
 #include "render_thread.h"
 #include "stb_image.h"
 #include "utils.h"
@@ -80,6 +82,7 @@ SolidColorShaderLocs g_solidColorShaderLocs;
 ImageRenderShaderLocs g_imageRenderShaderLocs;
 PassthroughShaderLocs g_passthroughShaderLocs;
 GradientShaderLocs g_gradientShaderLocs;
+GradientRampTextures g_gradientRamps; // Game context
 
 std::atomic<bool> g_shouldRenderGui{ false };
 std::atomic<bool> g_showPerformanceOverlay{ false };
@@ -111,9 +114,10 @@ GLuint GetEyeZoomSnapshotTexture() { return s_eyeZoomSnapshotTexture; }
 int GetEyeZoomSnapshotWidth() { return s_eyeZoomSnapshotWidth; }
 int GetEyeZoomSnapshotHeight() { return s_eyeZoomSnapshotHeight; }
 
-std::unordered_map<std::string, MirrorInstance> g_mirrorInstances;
+MirrorSlotMap<MirrorInstance> g_mirrorInstances;
 std::unordered_map<std::string, BackgroundTextureInstance> g_backgroundTextures;
 std::unordered_map<std::string, UserImageInstance> g_userImages;
+uint64_t g_userImagesGeneration = 0;
 GLuint g_vao = 0;
 GLuint g_vbo = 0;
 GLuint g_debugVAO = 0;
@@ -132,9 +136,6 @@ std::shared_mutex g_mirrorInstancesMutex;
 std::mutex g_userImagesMutex;
 std::mutex g_backgroundTexturesMutex;
 
-std::vector<GLuint> g_texturesToDelete;
-std::mutex g_texturesToDeleteMutex;
-std::atomic<bool> g_hasTexturesToDelete{ false };
 bool g_glInitialized = false;
 std::atomic<bool> g_isGameFocused{ true };
 GameViewportGeometry g_lastFrameGeometry;
@@ -197,11 +198,11 @@ static void CacheEyeZoomTextLabel(int number, float centerX, float centerY, cons
 // Standardized overlay border rendering function
 void DrawOverlayBorder(float nx1, float ny1, float nx2, float ny2, float borderWidth, float borderHeight, bool isDragging,
                        bool drawCorners = false) {
-    glUseProgram(g_solidColorProgram);
-    glBindVertexArray(g_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, g_vbo);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLTracked::UseProgram(g_solidColorProgram);
+    GLTracked::BindVertexArray(g_vao);
+    GLTracked::BindBuffer(GL_ARRAY_BUFFER, g_vbo);
+    GLTracked::Enable(GL_BLEND);
+    GLTracked::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Use different colors for hover vs drag
     if (isDragging) {
@@ -262,7 +263,7 @@ void DrawOverlayBorder(float nx1, float ny1, float nx2, float ny2, float borderW
         glDrawArrays(GL_TRIANGLES, 0, 24);
     }
 
-    glDisable(GL_BLEND);
+    GLTracked::Disable(GL_BLEND);
 }
 
 // Render a border around the game viewport with optional rounded corners
@@ -272,11 +273,11 @@ void DrawOverlayBorder(float nx1, float ny1, float nx2, float ny2, float borderW
 void RenderGameBorder(int x, int y, int w, int h, int borderWidth, int radius, const Color& color, int fullW, int fullH) {
     if (borderWidth <= 0) return;
 
-    glUseProgram(g_solidColorProgram);
-    glBindVertexArray(g_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, g_vbo);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLTracked::UseProgram(g_solidColorProgram);
+    GLTracked::BindVertexArray(g_vao);
+    GLTracked::BindBuffer(GL_ARRAY_BUFFER, g_vbo);
+    GLTracked::Enable(GL_BLEND);
+    GLTracked::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     glUniform4f(g_solidColorShaderLocs.color, color.r, color.g, color.b, 1.0f);
 
@@ -393,7 +394,7 @@ void RenderGameBorder(int x, int y, int w, int h, int borderWidth, int radius, c
         renderCornerArc((float)(x + w - effectiveRadius), (float)(y_gl + effectiveRadius), innerR, outerR, PI * 1.5f, PI * 2.0f);
     }
 
-    glDisable(GL_BLEND);
+    GLTracked::Disable(GL_BLEND);
 }
 
 // Helper functions to calculate actual dimensions from scale
@@ -603,12 +604,11 @@ void main() {
     FragColor = texture(screenTexture, TexCoord);
 })";
 
-// Gradient shader for multi-stop linear gradients with angle and animation support
+// Gradient shader: each animation is a coordinate transform followed by one lookup in the baked ramp
 const char* gradient_frag_shader = R"(#version 330 core
 out vec4 FragColor;
 in vec2 TexCoord;
 
-#define MAX_STOPS 8
 #define ANIM_NONE 0
 #define ANIM_ROTATE 1
 #define ANIM_SLIDE 2
@@ -616,133 +616,53 @@ in vec2 TexCoord;
 #define ANIM_SPIRAL 4
 #define ANIM_FADE 5
 
-uniform int u_numStops;
-uniform vec4 u_stopColors[MAX_STOPS];
-uniform float u_stopPositions[MAX_STOPS];
+uniform sampler2D u_ramp; // Row 0 = clamped gradient, row 1 = seamless loop (gradient_ramp.h)
 uniform float u_angle; // radians (base angle)
 uniform float u_time;  // animation time in seconds
 uniform int u_animationType;
 uniform float u_animationSpeed;
 uniform bool u_colorFade;
 
-// Get color at position t (0-1) with seamless wrapping for slide animation
-vec4 getGradientColorSeamless(float t) {
-    // Wrap t to 0-1 range
-    t = fract(t);
-    
-    // For seamless tiling, we treat the gradient as a loop:
-    // The gradient goes from first stop to last stop, then blends back to first
-    // We remap t so that the full 0-1 range covers stops AND the wrap-around blend
-    
-    // Find position in extended gradient (including wrap segment)
-    float lastPos = u_stopPositions[u_numStops - 1];
-    float firstPos = u_stopPositions[0];
-    float wrapSize = (1.0 - lastPos) + firstPos; // Size of wrap-around segment
-    
-    if (t <= firstPos && wrapSize > 0.001) {
-        // In the wrap-around blend zone (before first stop)
-        float wrapT = (firstPos - t) / wrapSize;
-        return mix(u_stopColors[0], u_stopColors[u_numStops - 1], wrapT);
-    }
-    else if (t >= lastPos && wrapSize > 0.001) {
-        // In the wrap-around blend zone (after last stop)
-        float wrapT = (t - lastPos) / wrapSize;
-        return mix(u_stopColors[u_numStops - 1], u_stopColors[0], wrapT);
-    }
-    
-    // Normal gradient interpolation between stops
-    vec4 color = u_stopColors[0];
-    for (int i = 0; i < u_numStops - 1; i++) {
-        if (t >= u_stopPositions[i] && t <= u_stopPositions[i + 1]) {
-            float segmentT = (t - u_stopPositions[i]) / max(u_stopPositions[i + 1] - u_stopPositions[i], 0.0001);
-            color = mix(u_stopColors[i], u_stopColors[i + 1], segmentT);
-            break;
-        }
-    }
-    return color;
+// Gradient at t, clamped to [0, 1]: texel centers run edge to edge
+vec4 rampClamped(float t) {
+    float texels = float(textureSize(u_ramp, 0).x);
+    return texture(u_ramp, vec2((clamp(t, 0.0, 1.0) * (texels - 1.0) + 0.5) / texels, 0.25));
 }
 
-// Get color at position t with optional time-based color cycling
-vec4 getGradientColor(float t, float timeOffset) {
-    // Apply color fade - shifts all stop positions over time
-    float adjustedT = t;
-    if (u_colorFade) {
-        adjustedT = fract(t + timeOffset * 0.1);
-    }
-    adjustedT = clamp(adjustedT, 0.0, 1.0);
-    
-    // Find which segment we're in and interpolate
-    vec4 color = u_stopColors[0];
-    for (int i = 0; i < u_numStops - 1; i++) {
-        if (adjustedT >= u_stopPositions[i] && adjustedT <= u_stopPositions[i + 1]) {
-            float segmentT = (adjustedT - u_stopPositions[i]) / max(u_stopPositions[i + 1] - u_stopPositions[i], 0.0001);
-            color = mix(u_stopColors[i], u_stopColors[i + 1], segmentT);
-            break;
-        }
-    }
-    // Handle edge cases (beyond last stop)
-    if (adjustedT >= u_stopPositions[u_numStops - 1]) {
-        color = u_stopColors[u_numStops - 1];
-    }
-    return color;
+// Seamless loop at fract(t), last stop blending back into the first; the sampler repeats horizontally
+vec4 rampWrapped(float t) {
+    float texels = float(textureSize(u_ramp, 0).x);
+    return texture(u_ramp, vec2(fract(t) + 0.5 / texels, 0.75));
 }
 
-// Get solid color that cycles through gradient stops over time
-vec4 getFadeColor(float timeOffset) {
-    // Cycle through stops: time maps to position in color sequence
-    float cyclePos = fract(timeOffset * 0.1); // Speed of cycling
-    
-    // Find which segment we're in and interpolate smoothly
-    vec4 color = u_stopColors[0];
-    for (int i = 0; i < u_numStops - 1; i++) {
-        if (cyclePos >= u_stopPositions[i] && cyclePos <= u_stopPositions[i + 1]) {
-            float segmentT = (cyclePos - u_stopPositions[i]) / max(u_stopPositions[i + 1] - u_stopPositions[i], 0.0001);
-            color = mix(u_stopColors[i], u_stopColors[i + 1], segmentT);
-            break;
-        }
-    }
-    // Wrap around: blend from last color back to first
-    if (cyclePos > u_stopPositions[u_numStops - 1]) {
-        float wrapRange = 1.0 - u_stopPositions[u_numStops - 1] + u_stopPositions[0];
-        float wrapT = (cyclePos - u_stopPositions[u_numStops - 1]) / max(wrapRange, 0.0001);
-        color = mix(u_stopColors[u_numStops - 1], u_stopColors[0], wrapT);
-    }
-    else if (cyclePos < u_stopPositions[0]) {
-        float wrapRange = 1.0 - u_stopPositions[u_numStops - 1] + u_stopPositions[0];
-        float wrapT = (u_stopPositions[0] - cyclePos) / max(wrapRange, 0.0001);
-        color = mix(u_stopColors[0], u_stopColors[u_numStops - 1], wrapT);
+// Gradient at t with optional time-based color cycling
+vec4 getGradientColor(float t, float timeOffset) {
+    if (u_colorFade) {
+        t = fract(t + timeOffset * 0.1);
     }
-    return color;
+    return rampClamped(t);
 }
 
 void main() {
     vec2 center = vec2(0.5, 0.5);
     vec2 uv = TexCoord - center;
-    float effectiveAngle = u_angle;
-    float t = 0.0;
     float timeOffset = u_time * u_animationSpeed;
     
     if (u_animationType == ANIM_NONE) {
-        // Static gradient - original behavior
+        // Static gradient
         vec2 dir = vec2(cos(u_angle), sin(u_angle));
-        t = dot(uv, dir) + 0.5;
-        t = clamp(t, 0.0, 1.0);
-        FragColor = getGradientColor(t, timeOffset);
+        FragColor = getGradientColor(clamp(dot(uv, dir) + 0.5, 0.0, 1.0), timeOffset);
     }
     else if (u_animationType == ANIM_ROTATE) {
         // Rotating gradient - angle changes over time
-        effectiveAngle = u_angle + timeOffset;
+        float effectiveAngle = u_angle + timeOffset;
         vec2 dir = vec2(cos(effectiveAngle), sin(effectiveAngle));
-        t = dot(uv, dir) + 0.5;
-        t = clamp(t, 0.0, 1.0);
-        FragColor = getGradientColor(t, timeOffset);
+        FragColor = getGradientColor(clamp(dot(uv, dir) + 0.5, 0.0, 1.0), timeOffset);
     }
     else if (u_animationType == ANIM_SLIDE) {
         // Sliding gradient - seamless scrolling along the gradient direction
         vec2 dir = vec2(cos(u_angle), sin(u_angle));
-        t = dot(uv, dir) + 0.5;
-        t = t + timeOffset * 0.2; // Shift position over time
-        FragColor = getGradientColorSeamless(t);
+        FragColor = rampWrapped(dot(uv, dir) + 0.5 + timeOffset * 0.2);
     }
     else if (u_animationType == ANIM_WAVE) {
         // Wave distortion - sine wave applied to gradient
@@ -750,29 +670,26 @@ void main() {
         vec2 perpDir = vec2(-sin(u_angle), cos(u_angle));
         float perpPos = dot(uv, perpDir);
         float wave = sin(perpPos * 8.0 + timeOffset * 2.0) * 0.08;
-        t = dot(uv, dir) + 0.5 + wave;
-        t = clamp(t, 0.0, 1.0);
-        FragColor = getGradientColor(t, timeOffset);
+        FragColor = getGradientColor(clamp(dot(uv, dir) + 0.5 + wave, 0.0, 1.0), timeOffset);
     }
     else if (u_animationType == ANIM_SPIRAL) {
         // Spiral effect - colors spiral outward from center
         float dist = length(uv) * 2.0;
         float angle = atan(uv.y, uv.x);
-        t = dist + angle / 6.28318 - timeOffset * 0.3;
-        FragColor = getGradientColorSeamless(t);
+        FragColor = rampWrapped(dist + angle / 6.28318 - timeOffset * 0.3);
     }
     else if (u_animationType == ANIM_FADE) {
         // Fade - solid color that smoothly cycles through all gradient stops
-        FragColor = getFadeColor(timeOffset);
+        FragColor = rampWrapped(timeOffset * 0.1);
     }
     else {
-        t = clamp(t, 0.0, 1.0);
-        FragColor = getGradientColor(t, timeOffset);
+        FragColor = getGradientColor(0.0, timeOffset);
     }
 })";
 
 void InitializeShaders() {
     PROFILE_SCOPE_CAT("Shader Initialization", "GPU Operations");
+    ScopedProgramCacheReport cacheReport("Main Context");
     // Create shader programs
     g_filterProgram = CreateShaderProgram(filter_vert_shader, filter_frag_shader);
     g_renderProgram = CreateShaderProgram(passthrough_vert_shader, render_frag_shader);
@@ -815,9 +732,7 @@ void InitializeShaders() {
     g_passthroughShaderLocs.screenTexture = glGetUniformLocation(g_passthroughProgram, "screenTexture");
     g_passthroughShaderLocs.sourceRect = glGetUniformLocation(g_passthroughProgram, "u_sourceRect");
 
-    g_gradientShaderLocs.numStops = glGetUniformLocation(g_gradientProgram, "u_numStops");
-    g_gradientShaderLocs.stopColors = glGetUniformLocation(g_gradientProgram, "u_stopColors");
-    g_gradientShaderLocs.stopPositions = glGetUniformLocation(g_gradientProgram, "u_stopPositions");
+    g_gradientShaderLocs.ramp = glGetUniformLocation(g_gradientProgram, "u_ramp");
     g_gradientShaderLocs.angle = glGetUniformLocation(g_gradientProgram, "u_angle");
     g_gradientShaderLocs.time = glGetUniformLocation(g_gradientProgram, "u_time");
     g_gradientShaderLocs.animationType = glGetUniformLocation(g_gradientProgram, "u_animationType");
@@ -826,22 +741,25 @@ void InitializeShaders() {
 
     // OPTIMIZATION: Set texture sampler uniforms once (they're always 0 for all shader usage)
     // This avoids redundant glUniform1i calls during rendering
-    glUseProgram(g_renderProgram);
+    GLTracked::UseProgram(g_renderProgram);
     glUniform1i(g_renderShaderLocs.filterTexture, 0);
 
-    glUseProgram(g_backgroundProgram);
+    GLTracked::UseProgram(g_backgroundProgram);
     glUniform1i(g_backgroundShaderLocs.backgroundTexture, 0);
 
-    glUseProgram(g_imageRenderProgram);
+    GLTracked::UseProgram(g_imageRenderProgram);
     glUniform1i(g_imageRenderShaderLocs.imageTexture, 0);
 
-    glUseProgram(g_filterProgram);
+    GLTracked::UseProgram(g_filterProgram);
     glUniform1i(g_filterShaderLocs.screenTexture, 0);
 
-    glUseProgram(g_passthroughProgram);
+    GLTracked::UseProgram(g_passthroughProgram);
     glUniform1i(g_passthroughShaderLocs.screenTexture, 0);
 
-    glUseProgram(0); // Reset program
+    GLTracked::UseProgram(g_gradientProgram);
+    glUniform1i(g_gradientShaderLocs.ramp, 0);
+
+    GLTracked::UseProgram(0); // Reset program
 
     // Initialize video YCbCr shader
     // InitVideoShader();
@@ -876,158 +794,115 @@ void CleanupShaders() {
         glDeleteProgram(g_gradientProgram);
         g_gradientProgram = 0;
     }
+    g_gradientRamps.Release();
+}
+
+GLuint GradientRampTextures::Get(const GradientStopSpan& stops) {
+    const uint64_t hash = HashGradientStops(stops);
+    m_useCounter++;
+
+    Entry* victim = &m_entries[0];
+    for (Entry& e : m_entries) {
+        if (e.texture != 0 && e.hash == hash) {
+            e.lastUse = m_useCounter;
+            return e.texture;
+        }
+        if (e.lastUse < victim->lastUse) victim = &e;
+    }
+
+    BuildGradientRamp(stops, m_ramp);
+    if (victim->texture == 0) {
+        glGenTextures(1, &victim->texture);
+        GLTracked::BindTexture(GL_TEXTURE_2D, victim->texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    } else {
+        GLTracked::BindTexture(GL_TEXTURE_2D, victim->texture);
+    }
+    GLTracked::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    GLTracked::PixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    GLTracked::PixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    GLTracked::PixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+    GLTracked::PixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, GRADIENT_RAMP_TEXELS, GRADIENT_RAMP_LAYERS, 0, GL_RGBA, GL_FLOAT, m_ramp.texels.data());
+
+    victim->hash = hash;
+    victim->lastUse = m_useCounter;
+    return victim->texture;
+}
+
+void GradientRampTextures::Release() {
+    for (Entry& e : m_entries) {
+        if (e.texture != 0) { glDeleteTextures(1, &e.texture); }
+        e = Entry{};
+    }
+    m_useCounter = 0;
+}
+
+// Queues an image's textures (every animation frame) for deletion on `queue`'s context
+static void ReleaseImageTextures(std::vector<GpuResourceHandle>& textureHandles, GpuContextQueue queue) {
+    GpuResourceManager& resources = GpuResourceManager::Get();
+    for (GpuResourceHandle& handle : textureHandles) { resources.Release(handle, queue); }
+    textureHandles.clear();
+}
+
+// Creates and fills one image texture (an animation frame or a static image) on the current context
+static GLuint CreateImageTexture(int width, int height, const unsigned char* pixels, GpuSubsystem subsystem,
+                                 std::vector<GpuResourceHandle>& textureHandles) {
+    GLuint t;
+    glGenTextures(1, &t);
+    GLTracked::BindTexture(GL_TEXTURE_2D, t);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    GLTracked::PixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    GLTracked::PixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    GLTracked::PixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+    GLTracked::PixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    UploadTexturePixels(width, height, pixels);
+    glGenerateMipmap(GL_TEXTURE_2D);
+
+    textureHandles.push_back(
+        GpuResourceManager::Get().Register(GpuResourceKind::Texture, t, subsystem, GpuTextureBytes(width, height, 4, true)));
+    return t;
 }
 
 void DiscardAllGPUImages() {
     PROFILE_SCOPE_CAT("GPU Image Discard", "GPU Operations");
-    std::vector<GLuint> texturesToDelete;
 
-    // Collect + clear background textures (static and animated)
+    // Textures are deleted by the game context's next retire, after its queued draws
     {
         std::lock_guard<std::mutex> bgLock(g_backgroundTexturesMutex);
-        for (auto const& [id, inst] : g_backgroundTextures) {
-            if (inst.isAnimated) {
-                for (GLuint tex : inst.frameTextures) {
-                    if (tex != 0) texturesToDelete.push_back(tex);
-                }
-            } else if (inst.textureId != 0) {
-                texturesToDelete.push_back(inst.textureId);
-            }
-        }
+        for (auto& [id, inst] : g_backgroundTextures) { ReleaseImageTextures(inst.textureHandles, GpuContextQueue::Game); }
         g_backgroundTextures.clear();
     }
-
-    // Collect + clear user images (static and animated)
     {
         std::lock_guard<std::mutex> imageLock(g_userImagesMutex);
-        for (auto const& [id, inst] : g_userImages) {
-            if (inst.isAnimated) {
-                for (GLuint tex : inst.frameTextures) {
-                    if (tex != 0) texturesToDelete.push_back(tex);
-                }
-            } else if (inst.textureId != 0) {
-                texturesToDelete.push_back(inst.textureId);
-            }
-        }
+        for (auto& [id, inst] : g_userImages) { ReleaseImageTextures(inst.textureHandles, GpuContextQueue::Game); }
         g_userImages.clear();
+        g_userImagesGeneration++;
     }
-
-    // Enqueue for deletion after releasing resource-map locks.
-    {
-        std::lock_guard<std::mutex> lock(g_texturesToDeleteMutex);
-        g_texturesToDelete.insert(g_texturesToDelete.end(), texturesToDelete.begin(), texturesToDelete.end());
-    }
-    if (!texturesToDelete.empty()) { g_hasTexturesToDelete.store(true, std::memory_order_release); }
     Log("All background and user image textures have been queued for deletion.");
 }
 
-void SaveGLState(GLState* s) {
-    // Core bindings
-    glGetIntegerv(GL_CURRENT_PROGRAM, &s->p);
-    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &s->va);
-    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &s->ab);
-    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &s->read_fb);
-    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &s->draw_fb);
-    glGetIntegerv(GL_ACTIVE_TEXTURE, &s->at);
-
-    // NOTE: We do a lot of rendering with GL_TEXTURE0 regardless of what the game had active.
-    // Save binding for the originally-active unit, plus binding for unit 0 specifically.
-    glGetIntegerv(GL_TEXTURE_BINDING_2D, &s->t);
-    if (s->at == GL_TEXTURE0) {
-        s->t0 = s->t;
-    } else {
-        glActiveTexture(GL_TEXTURE0);
-        glGetIntegerv(GL_TEXTURE_BINDING_2D, &s->t0);
-        glActiveTexture(s->at); // Restore original active texture
-    }
+void BeginGLStateTracking(GLState* s) {
+    GLStateTracker& tracker = GLStateTracker::ForCurrentThread();
+    tracker.BeginFrame();
 
-    // For historical callers inside render.cpp: treat fb as the original DRAW framebuffer.
+    // Only what the render code reads up front; everything else is captured when first changed
+    s->draw_fb = tracker.GameDrawFramebuffer();
+    s->read_fb = tracker.GameReadFramebuffer();
     s->fb = s->draw_fb;
-
-    // Enable/disable states we modify
-    s->be = glIsEnabled(GL_BLEND);
-    s->de = glIsEnabled(GL_DEPTH_TEST);
-    s->sc = glIsEnabled(GL_SCISSOR_TEST);
-    s->srgb_enabled = glIsEnabled(GL_FRAMEBUFFER_SRGB);
-
-    // Blend function state
-    glGetIntegerv(GL_BLEND_SRC_RGB, &s->blend_src_rgb);
-    glGetIntegerv(GL_BLEND_DST_RGB, &s->blend_dst_rgb);
-    glGetIntegerv(GL_BLEND_SRC_ALPHA, &s->blend_src_alpha);
-    glGetIntegerv(GL_BLEND_DST_ALPHA, &s->blend_dst_alpha);
-
-    // Viewport and scissor
-    glGetIntegerv(GL_VIEWPORT, &s->vp[0]);
-    glGetIntegerv(GL_SCISSOR_BOX, s->sb);
-
-    // Other state we modify
-    glGetFloatv(GL_COLOR_CLEAR_VALUE, s->cc);
-    glGetFloatv(GL_LINE_WIDTH, &s->lw);
-    glGetBooleanv(GL_COLOR_WRITEMASK, s->color_mask);
-    glGetIntegerv(GL_UNPACK_ROW_LENGTH, &s->unpack_row_length);
-    glGetIntegerv(GL_UNPACK_SKIP_PIXELS, &s->unpack_skip_pixels);
-    glGetIntegerv(GL_UNPACK_SKIP_ROWS, &s->unpack_skip_rows);
-    glGetIntegerv(GL_PACK_ALIGNMENT, &s->pack_alignment);
-    glGetIntegerv(GL_UNPACK_ALIGNMENT, &s->unpack_alignment);
+    s->va = tracker.GameVertexArray();
+    tracker.GameViewport(s->vp);
 }
 
-void RestoreGLState(const GLState& s) {
-    // Core bindings
-    glUseProgram(s.p);
-    glBindVertexArray(s.va);
-    glBindBuffer(GL_ARRAY_BUFFER, s.ab);
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, s.read_fb);
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, s.draw_fb);
-
-    // Restore texture bindings (we only touch GL_TEXTURE0, plus we may have changed the active unit)
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, s.t0);
-    if (s.at != GL_TEXTURE0) {
-        glActiveTexture(s.at);
-        glBindTexture(GL_TEXTURE_2D, s.t);
-    } else {
-        // If the original active unit was 0, the above bind already restored it.
-        glActiveTexture(s.at);
-    }
-
-    // Enable/disable states
-    if (s.be)
-        glEnable(GL_BLEND);
-    else
-        glDisable(GL_BLEND);
-    if (s.de)
-        glEnable(GL_DEPTH_TEST);
-    else
-        glDisable(GL_DEPTH_TEST);
-    if (s.sc)
-        glEnable(GL_SCISSOR_TEST);
-    else
-        glDisable(GL_SCISSOR_TEST);
-    if (s.srgb_enabled)
-        glEnable(GL_FRAMEBUFFER_SRGB);
-    else
-        glDisable(GL_FRAMEBUFFER_SRGB);
-
-    // Blend function state
-    glBlendFuncSeparate(s.blend_src_rgb, s.blend_dst_rgb, s.blend_src_alpha, s.blend_dst_alpha);
-
-    // Viewport and scissor - use unhooked glViewport to avoid interfering with viewport hook state
-    if (oglViewport)
-        oglViewport(s.vp[0], s.vp[1], s.vp[2], s.vp[3]);
-    else
-        glViewport(s.vp[0], s.vp[1], s.vp[2], s.vp[3]);
-    glScissor(s.sb[0], s.sb[1], s.sb[2], s.sb[3]);
-
-    // Other state
-    glClearColor(s.cc[0], s.cc[1], s.cc[2], s.cc[3]);
-    glLineWidth(s.lw);
-    glColorMask(s.color_mask[0], s.color_mask[1], s.color_mask[2], s.color_mask[3]);
-    glPixelStorei(GL_UNPACK_ROW_LENGTH, s.unpack_row_length);
-    glPixelStorei(GL_UNPACK_SKIP_PIXELS, s.unpack_skip_pixels);
-    glPixelStorei(GL_UNPACK_SKIP_ROWS, s.unpack_skip_rows);
-    glPixelStorei(GL_PACK_ALIGNMENT, s.pack_alignment);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, s.unpack_alignment);
-}
+void EndGLStateTracking() { GLStateTracker::ForCurrentThread().EndFrame(); }
 
 void CleanupGPUResources() {
     Log("CleanupGPUResources: Starting cleanup...");
@@ -1089,25 +964,14 @@ void CleanupGPUResources() {
 
     // Then clean up textures
     try {
-        for (auto const& [k, v] : g_mirrorInstances) {
-            if (v.fboTexture) {
-                glDeleteTextures(1, &v.fboTexture);
-                while (glGetError() != GL_NO_ERROR) {}
-            }
-            // Clean up back-buffer texture used by capture thread
-            if (v.fboTextureBack) {
-                glDeleteTextures(1, &v.fboTextureBack);
-                while (glGetError() != GL_NO_ERROR) {}
-            }
-            // Clean up final textures
-            if (v.finalTexture) {
-                glDeleteTextures(1, &v.finalTexture);
-                while (glGetError() != GL_NO_ERROR) {}
-            }
-            if (v.finalTextureBack) {
-                glDeleteTextures(1, &v.finalTextureBack);
-                while (glGetError() != GL_NO_ERROR) {}
-            }
+        GpuResourceManager& resources = GpuResourceManager::Get();
+        for (auto& [k, v] : g_mirrorInstances) {
+            // Front/back capture and final textures
+            resources.ReleaseNow(v.fboTextureHandle);
+            resources.ReleaseNow(v.fboTextureBackHandle);
+            resources.ReleaseNow(v.finalTextureHandle);
+            resources.ReleaseNow(v.finalTextureBackHandle);
+            while (glGetError() != GL_NO_ERROR) {}
 
             // Clean up GPU sync fences
             if (v.gpuFence) { glDeleteSync(v.gpuFence); }
@@ -1123,14 +987,9 @@ void CleanupGPUResources() {
 
         DiscardAllGPUImages();
 
-        {
-            std::lock_guard<std::mutex> lock(g_texturesToDeleteMutex);
-            if (!g_texturesToDelete.empty()) {
-                glDeleteTextures((GLsizei)g_texturesToDelete.size(), g_texturesToDelete.data());
-                while (glGetError() != GL_NO_ERROR) {}
-                g_texturesToDelete.clear();
-            }
-        }
+        // Everything queued for the game context, including the images just discarded
+        GpuResourceManager::Get().Flush(GpuContextQueue::Game);
+        while (glGetError() != GL_NO_ERROR) {}
     } catch (...) { Log("CleanupGPUResources: Exception during texture cleanup"); }
 
     {
@@ -1189,16 +1048,8 @@ void UploadDecodedImageToGPU(const DecodedImageData& imgData) {
         // Clean up old instance if it exists
         auto it = g_backgroundTextures.find(imgData.id);
         if (it != g_backgroundTextures.end()) {
-            BackgroundTextureInstance& oldInst = it->second;
-            std::lock_guard<std::mutex> lock(g_texturesToDeleteMutex);
-            if (oldInst.isAnimated) {
-                for (GLuint tex : oldInst.frameTextures) {
-                    if (tex != 0) g_texturesToDelete.push_back(tex);
-                }
-            } else if (oldInst.textureId != 0) {
-                g_texturesToDelete.push_back(oldInst.textureId);
-            }
-            g_hasTexturesToDelete.store(true, std::memory_order_release);
+            // This context drew the old textures; its own fence covers those draws
+            ReleaseImageTextures(it->second.textureHandles, GpuContextQueue::RenderThread);
             g_backgroundTextures.erase(it);
         }
 
@@ -1214,24 +1065,9 @@ void UploadDecodedImageToGPU(const DecodedImageData& imgData) {
 
                 int frameHeight = imgData.frameHeight;
                 for (int i = 0; i < imgData.frameCount; i++) {
-                    GLuint t;
-                    glGenTextures(1, &t);
-                    glBindTexture(GL_TEXTURE_2D, t);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-                    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
-                    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
-                    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-
-                    // Upload this frame (frames are stacked vertically in the data)
+                    // Frames are stacked vertically in the data
                     unsigned char* frameData = imgData.data + (i * frameHeight * imgData.width * 4);
-                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, imgData.width, frameHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, frameData);
-                    glGenerateMipmap(GL_TEXTURE_2D);
-
-                    inst.frameTextures.push_back(t);
+                    inst.frameTextures.push_back(CreateImageTexture(imgData.width, frameHeight, frameData, GpuSubsystem::Backgrounds, inst.textureHandles));
                 }
                 inst.textureId = inst.frameTextures[0]; // Start with first frame
 
@@ -1241,22 +1077,8 @@ void UploadDecodedImageToGPU(const DecodedImageData& imgData) {
                 // Static background
                 inst.isAnimated = false;
 
-                GLuint t;
-                glGenTextures(1, &t);
-                glBindTexture(GL_TEXTURE_2D, t);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-                glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
-                glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
-                glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, imgData.width, imgData.frameHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, imgData.data);
-                glGenerateMipmap(GL_TEXTURE_2D);
-
-                inst.textureId = t;
+                inst.textureId =
+                    CreateImageTexture(imgData.width, imgData.frameHeight, imgData.data, GpuSubsystem::Backgrounds, inst.textureHandles);
                 g_backgroundTextures[imgData.id] = inst;
                 Log("Uploaded background for '" + imgData.id + "' to GPU.");
             }
@@ -1273,20 +1095,11 @@ void UploadDecodedImageToGPU(const DecodedImageData& imgData) {
             if (it != g_userImages.end()) {
                 oldInst = std::move(it->second);
                 g_userImages.erase(it);
+                g_userImagesGeneration++;
                 hadOldInst = true;
             }
         }
-        if (hadOldInst) {
-            std::lock_guard<std::mutex> lock(g_texturesToDeleteMutex);
-            if (oldInst.isAnimated) {
-                for (GLuint tex : oldInst.frameTextures) {
-                    if (tex != 0) g_texturesToDelete.push_back(tex);
-                }
-            } else if (oldInst.textureId != 0) {
-                g_texturesToDelete.push_back(oldInst.textureId);
-            }
-        }
-        if (hadOldInst) { g_hasTexturesToDelete.store(true, std::memory_order_release); }
+        if (hadOldInst) { ReleaseImageTextures(oldInst.textureHandles, GpuContextQueue::RenderThread); }
 
         if (imgData.data) {
             UserImageInstance inst;
@@ -1312,53 +1125,29 @@ void UploadDecodedImageToGPU(const DecodedImageData& imgData) {
 
                 int frameHeight = imgData.frameHeight;
                 for (int i = 0; i < imgData.frameCount; i++) {
-                    GLuint t;
-                    glGenTextures(1, &t);
-                    glBindTexture(GL_TEXTURE_2D, t);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-                    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
-                    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
-                    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-
-                    // Upload this frame (frames are stacked vertically in the data)
+                    // Frames are stacked vertically in the data
                     unsigned char* frameData = imgData.data + (i * frameHeight * imgData.width * 4);
-                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, imgData.width, frameHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, frameData);
-                    glGenerateMipmap(GL_TEXTURE_2D);
-
-                    inst.frameTextures.push_back(t);
+                    inst.frameTextures.push_back(CreateImageTexture(imgData.width, frameHeight, frameData, GpuSubsystem::Images, inst.textureHandles));
                 }
                 inst.textureId = inst.frameTextures[0]; // Start with first frame
 
                 {
                     std::lock_guard<std::mutex> imageLock(g_userImagesMutex);
                     g_userImages[imgData.id] = std::move(inst);
+                    g_userImagesGeneration++;
                 }
                 Log("Uploaded animated user image '" + imgData.id + "' to GPU (" + std::to_string(imgData.frameCount) + " frames).");
             } else {
                 // Static user image
                 inst.isAnimated = false;
 
-                glGenTextures(1, &inst.textureId);
-                glBindTexture(GL_TEXTURE_2D, inst.textureId);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-                glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
-                glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
-                glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, imgData.width, imgData.frameHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, imgData.data);
-                glGenerateMipmap(GL_TEXTURE_2D);
+                inst.textureId =
+                    CreateImageTexture(imgData.width, imgData.frameHeight, imgData.data, GpuSubsystem::Images, inst.textureHandles);
 
                 {
                     std::lock_guard<std::mutex> imageLock(g_userImagesMutex);
                     g_userImages[imgData.id] = std::move(inst);
+                    g_userImagesGeneration++;
                 }
                 Log("Uploaded user image '" + imgData.id + "' to GPU.");
             }
@@ -1400,9 +1189,9 @@ void InitializeGPUResources() {
     if (!g_filterProgram || !g_renderProgram || !g_backgroundProgram || !g_solidColorProgram || !g_imageRenderProgram ||
         !g_passthroughProgram) {
         Log("FATAL: Failed to create one or more shader programs. Aborting GPU resource initialization.");
-        glBindFramebuffer(GL_FRAMEBUFFER, last_framebuffer);
-        glBindVertexArray(last_vertex_array);
-        glUseProgram(last_program);
+        GLTracked::BindFramebuffer(GL_FRAMEBUFFER, last_framebuffer);
+        GLTracked::BindVertexArray(last_vertex_array);
+        GLTracked::UseProgram(last_program);
         return;
     }
 
@@ -1415,7 +1204,7 @@ void InitializeGPUResources() {
         LogCategory("init", "Found " + std::to_string(mirrorsToCreate.size()) + " mirrors in config to create.");
     }
     // Release the framebuffer binding before calling CreateMirrorGPUResources
-    glBindFramebuffer(GL_FRAMEBUFFER, last_framebuffer);
+    GLTracked::BindFramebuffer(GL_FRAMEBUFFER, last_framebuffer);
 
     for (const auto& conf : mirrorsToCreate) {
         // CreateMirrorGPUResources handles triple-buffered FBO creation
@@ -1423,11 +1212,11 @@ void InitializeGPUResources() {
         CreateMirrorGPUResources(conf);
     }
 
-    glBindFramebuffer(GL_FRAMEBUFFER, last_framebuffer);
+    GLTracked::BindFramebuffer(GL_FRAMEBUFFER, last_framebuffer);
     glGenVertexArrays(1, &g_vao);
     glGenBuffers(1, &g_vbo);
-    glBindVertexArray(g_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, g_vbo);
+    GLTracked::BindVertexArray(g_vao);
+    GLTracked::BindBuffer(GL_ARRAY_BUFFER, g_vbo);
     // Allocate buffer large enough for: border drawing with corners (48 vertices * 4 floats = 192 floats)
     glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 192, nullptr, GL_DYNAMIC_DRAW);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
@@ -1436,8 +1225,8 @@ void InitializeGPUResources() {
     glEnableVertexAttribArray(1);
     glGenVertexArrays(1, &g_debugVAO);
     glGenBuffers(1, &g_debugVBO);
-    glBindVertexArray(g_debugVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, g_debugVBO);
+    GLTracked::BindVertexArray(g_debugVAO);
+    GLTracked::BindBuffer(GL_ARRAY_BUFFER, g_debugVBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 4 * 2, nullptr, GL_DYNAMIC_DRAW);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
@@ -1454,23 +1243,23 @@ void InitializeGPUResources() {
     };
     glGenVertexArrays(1, &g_fullscreenQuadVAO);
     glGenBuffers(1, &g_fullscreenQuadVBO);
-    glBindVertexArray(g_fullscreenQuadVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, g_fullscreenQuadVBO);
+    GLTracked::BindVertexArray(g_fullscreenQuadVAO);
+    GLTracked::BindBuffer(GL_ARRAY_BUFFER, g_fullscreenQuadVBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(fullscreenQuadVerts), fullscreenQuadVerts, GL_STATIC_DRAW);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
     glEnableVertexAttribArray(1);
 
-    glBindVertexArray(0);
+    GLTracked::BindVertexArray(0);
 
     LogCategory("init", "Restoring original OpenGL state...");
-    glUseProgram(last_program);
-    glActiveTexture(last_active_texture);
-    glBindTexture(GL_TEXTURE_2D, last_texture);
-    glBindVertexArray(last_vertex_array);
-    glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
-    glBindFramebuffer(GL_FRAMEBUFFER, last_framebuffer);
+    GLTracked::UseProgram(last_program);
+    GLTracked::ActiveTexture(last_active_texture);
+    GLTracked::BindTexture(GL_TEXTURE_2D, last_texture);
+    GLTracked::BindVertexArray(last_vertex_array);
+    GLTracked::BindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
+    GLTracked::BindFramebuffer(GL_FRAMEBUFFER, last_framebuffer);
 
     g_glInitialized = true;
     LogCategory("init", "--- GPU resources initialized successfully. ---");
@@ -1509,9 +1298,9 @@ void CreateMirrorGPUResources(const MirrorConfig& conf) {
     // Helper lambda to create an FBO with texture
     auto createFBO = [&](GLuint& fbo, GLuint& texture, int w, int h, GLenum filter) -> bool {
         glGenFramebuffers(1, &fbo);
-        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        GLTracked::BindFramebuffer(GL_FRAMEBUFFER, fbo);
         glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
+        GLTracked::BindTexture(GL_TEXTURE_2D, texture);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
@@ -1540,6 +1329,13 @@ void CreateMirrorGPUResources(const MirrorConfig& conf) {
     bool finalBackComplete = createFBO(inst.finalFboBack, inst.finalTextureBack, inst.final_w, inst.final_h, GL_NEAREST);
 
     if (frontComplete && backComplete && finalFrontComplete && finalBackComplete) {
+        GpuResourceManager& resources = GpuResourceManager::Get();
+        const uint64_t captureBytes = GpuTextureBytes(inst.fbo_w, inst.fbo_h);
+        const uint64_t finalBytes = GpuTextureBytes(inst.final_w, inst.final_h);
+        inst.fboTextureHandle = resources.Register(GpuResourceKind::Texture, inst.fboTexture, GpuSubsystem::Mirrors, captureBytes);
+        inst.fboTextureBackHandle = resources.Register(GpuResourceKind::Texture, inst.fboTextureBack, GpuSubsystem::Mirrors, captureBytes);
+        inst.finalTextureHandle = resources.Register(GpuResourceKind::Texture, inst.finalTexture, GpuSubsystem::Mirrors, finalBytes);
+        inst.finalTextureBackHandle = resources.Register(GpuResourceKind::Texture, inst.finalTextureBack, GpuSubsystem::Mirrors, finalBytes);
         inst.captureReady.store(false, std::memory_order_relaxed);
         inst.hasValidContent = false; // Front starts empty
         // Initialize rawOutput state from config for proper initial synchronization
@@ -1564,8 +1360,8 @@ void CreateMirrorGPUResources(const MirrorConfig& conf) {
     }
 
     // Restore OpenGL state
-    glBindFramebuffer(GL_FRAMEBUFFER, last_framebuffer);
-    glBindTexture(GL_TEXTURE_2D, last_texture);
+    GLTracked::BindFramebuffer(GL_FRAMEBUFFER, last_framebuffer);
+    GLTracked::BindTexture(GL_TEXTURE_2D, last_texture);
 }
 
 // MirrorRenderData struct is now defined in render.h for sharing with render_thread.cpp
@@ -1576,6 +1372,7 @@ void CreateMirrorGPUResources(const MirrorConfig& conf) {
 
 void handleEyeZoomMode(const GLState& s, float opacity, int animatedViewportX) {
     PROFILE_SCOPE_CAT("EyeZoom Mode Rendering", "Rendering");
+    PROFILE_GPU_SCOPE("EyeZoom Mode Rendering");
 
     // Skip rendering if fully transparent
     if (opacity <= 0.0f) { return; }
@@ -1606,13 +1403,10 @@ void handleEyeZoomMode(const GLState& s, float opacity, int animatedViewportX) {
     }
 
     // Bind the default framebuffer to render to the main screen output
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    if (oglViewport)
-        oglViewport(0, 0, fullW, fullH);
-    else
-        glViewport(0, 0, fullW, fullH);
-    glDisable(GL_FRAMEBUFFER_SRGB);
-    glDisable(GL_SCISSOR_TEST);
+    GLTracked::BindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLTracked::Viewport(0, 0, fullW, fullH);
+    GLTracked::Disable(GL_FRAMEBUFFER_SRGB);
+    GLTracked::Disable(GL_SCISSOR_TEST);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -1686,13 +1480,13 @@ void handleEyeZoomMode(const GLState& s, float opacity, int animatedViewportX) {
             if (s_eyeZoomSnapshotFBO != 0) { glDeleteFramebuffers(1, &s_eyeZoomSnapshotFBO); }
 
             glGenTextures(1, &s_eyeZoomSnapshotTexture);
-            glBindTexture(GL_TEXTURE_2D, s_eyeZoomSnapshotTexture);
+            GLTracked::BindTexture(GL_TEXTURE_2D, s_eyeZoomSnapshotTexture);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, zoomOutputWidth, zoomOutputHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
             glGenFramebuffers(1, &s_eyeZoomSnapshotFBO);
-            glBindFramebuffer(GL_FRAMEBUFFER, s_eyeZoomSnapshotFBO);
+            GLTracked::BindFramebuffer(GL_FRAMEBUFFER, s_eyeZoomSnapshotFBO);
             glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, s_eyeZoomSnapshotTexture, 0);
 
             s_eyeZoomSnapshotWidth = zoomOutputWidth;
@@ -1711,67 +1505,61 @@ void handleEyeZoomMode(const GLState& s, float opacity, int animatedViewportX) {
             glGenFramebuffers(1, &s_eyeZoomTempFBO);
             glGenTextures(1, &s_eyeZoomTempTexture);
 
-            glBindTexture(GL_TEXTURE_2D, s_eyeZoomTempTexture);
+            GLTracked::BindTexture(GL_TEXTURE_2D, s_eyeZoomTempTexture);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, zoomOutputWidth, zoomOutputHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-            glBindFramebuffer(GL_FRAMEBUFFER, s_eyeZoomTempFBO);
+            GLTracked::BindFramebuffer(GL_FRAMEBUFFER, s_eyeZoomTempFBO);
             glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, s_eyeZoomTempTexture, 0);
 
             s_eyeZoomTempWidth = zoomOutputWidth;
             s_eyeZoomTempHeight = zoomOutputHeight;
         }
 
-        glBindFramebuffer(GL_FRAMEBUFFER, s_eyeZoomTempFBO);
-        if (oglViewport)
-            oglViewport(0, 0, zoomOutputWidth, zoomOutputHeight);
-        else
-            glViewport(0, 0, zoomOutputWidth, zoomOutputHeight);
+        GLTracked::BindFramebuffer(GL_FRAMEBUFFER, s_eyeZoomTempFBO);
+        GLTracked::Viewport(0, 0, zoomOutputWidth, zoomOutputHeight);
 
         // Clear the temp FBO
-        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        GLTracked::ClearColor(0.0f, 0.0f, 0.0f, 0.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 
         // Blit clone into temp FBO.
         // If transitioning OUT of EyeZoom, render from the snapshot cache.
         if (useSnapshot) {
             if (s_eyeZoomBlitFBO == 0) { glGenFramebuffers(1, &s_eyeZoomBlitFBO); }
-            glBindFramebuffer(GL_READ_FRAMEBUFFER, s_eyeZoomBlitFBO);
+            GLTracked::BindFramebuffer(GL_READ_FRAMEBUFFER, s_eyeZoomBlitFBO);
             glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, s_eyeZoomSnapshotTexture, 0);
-            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, s_eyeZoomTempFBO);
+            GLTracked::BindFramebuffer(GL_DRAW_FRAMEBUFFER, s_eyeZoomTempFBO);
             glBlitFramebuffer(0, 0, s_eyeZoomSnapshotWidth, s_eyeZoomSnapshotHeight, 0, 0, zoomOutputWidth, zoomOutputHeight,
                               GL_COLOR_BUFFER_BIT, GL_NEAREST);
         } else {
             // Uncapped: blit directly from game texture each frame
             if (s_eyeZoomBlitFBO == 0) { glGenFramebuffers(1, &s_eyeZoomBlitFBO); }
-            glBindFramebuffer(GL_READ_FRAMEBUFFER, s_eyeZoomBlitFBO);
+            GLTracked::BindFramebuffer(GL_READ_FRAMEBUFFER, s_eyeZoomBlitFBO);
             glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, gameTextureToUse, 0);
-            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, s_eyeZoomTempFBO);
+            GLTracked::BindFramebuffer(GL_DRAW_FRAMEBUFFER, s_eyeZoomTempFBO);
             glBlitFramebuffer(srcLeft, srcBottom, srcRight, srcTop, 0, 0, zoomOutputWidth, zoomOutputHeight, GL_COLOR_BUFFER_BIT, GL_NEAREST);
 
             // Capture snapshot for future transition-out (clone only, before overlay boxes).
             EnsureEyeZoomSnapshotAllocated();
-            glBindFramebuffer(GL_READ_FRAMEBUFFER, s_eyeZoomTempFBO);
-            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, s_eyeZoomSnapshotFBO);
+            GLTracked::BindFramebuffer(GL_READ_FRAMEBUFFER, s_eyeZoomTempFBO);
+            GLTracked::BindFramebuffer(GL_DRAW_FRAMEBUFFER, s_eyeZoomSnapshotFBO);
             glBlitFramebuffer(0, 0, zoomOutputWidth, zoomOutputHeight, 0, 0, s_eyeZoomSnapshotWidth, s_eyeZoomSnapshotHeight,
                               GL_COLOR_BUFFER_BIT, GL_NEAREST);
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            GLTracked::BindFramebuffer(GL_FRAMEBUFFER, 0);
             s_eyeZoomSnapshotValid = true;
         }
 
         // Now render the colored boxes and center line to the temp FBO
-        glBindFramebuffer(GL_FRAMEBUFFER, s_eyeZoomTempFBO);
-        if (oglViewport)
-            oglViewport(0, 0, zoomOutputWidth, zoomOutputHeight);
-        else
-            glViewport(0, 0, zoomOutputWidth, zoomOutputHeight);
-
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glUseProgram(g_solidColorProgram);
-        glBindVertexArray(g_vao);
-        glBindBuffer(GL_ARRAY_BUFFER, g_vbo);
+        GLTracked::BindFramebuffer(GL_FRAMEBUFFER, s_eyeZoomTempFBO);
+        GLTracked::Viewport(0, 0, zoomOutputWidth, zoomOutputHeight);
+
+        GLTracked::Enable(GL_BLEND);
+        GLTracked::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLTracked::UseProgram(g_solidColorProgram);
+        GLTracked::BindVertexArray(g_vao);
+        GLTracked::BindBuffer(GL_ARRAY_BUFFER, g_vbo);
 
         float pixelWidthOnScreen = zoomOutputWidth / (float)zoomConfig.cloneWidth;
         int labelsPerSide = zoomConfig.cloneWidth / 2;
@@ -1855,17 +1643,14 @@ void handleEyeZoomMode(const GLState& s, float opacity, int animatedViewportX) {
         glDrawArrays(GL_TRIANGLES, 0, 6);
 
         // Now blend the complete temp texture to the screen with opacity
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        if (oglViewport)
-            oglViewport(0, 0, fullW, fullH);
-        else
-            glViewport(0, 0, fullW, fullH);
+        GLTracked::BindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLTracked::Viewport(0, 0, fullW, fullH);
 
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLTracked::Enable(GL_BLEND);
+        GLTracked::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-        glUseProgram(g_imageRenderProgram);
-        glBindTexture(GL_TEXTURE_2D, s_eyeZoomTempTexture);
+        GLTracked::UseProgram(g_imageRenderProgram);
+        GLTracked::BindTexture(GL_TEXTURE_2D, s_eyeZoomTempTexture);
         glUniform1i(g_imageRenderShaderLocs.imageTexture, 0);
         glUniform1i(g_imageRenderShaderLocs.enableColorKey, 0);
         glUniform1f(g_imageRenderShaderLocs.opacity, opacity);
@@ -1881,7 +1666,7 @@ void handleEyeZoomMode(const GLState& s, float opacity, int animatedViewportX) {
         glDrawArrays(GL_TRIANGLES, 0, 6);
     } else {
         // Full opacity - use original direct rendering path
-        glDisable(GL_BLEND);
+        GLTracked::Disable(GL_BLEND);
 
         // STEP 1: Render zoom section from game texture (live) or snapshot (transition-out)
         if (useSnapshot) {
@@ -1889,10 +1674,10 @@ void handleEyeZoomMode(const GLState& s, float opacity, int animatedViewportX) {
             // The snapshot contains the complete zoom output from the last EyeZoom frame
             // PERF: Reuse cached blit FBO instead of creating/destroying every frame
             if (s_eyeZoomBlitFBO == 0) { glGenFramebuffers(1, &s_eyeZoomBlitFBO); }
-            glBindFramebuffer(GL_READ_FRAMEBUFFER, s_eyeZoomBlitFBO);
+            GLTracked::BindFramebuffer(GL_READ_FRAMEBUFFER, s_eyeZoomBlitFBO);
             glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, s_eyeZoomSnapshotTexture, 0);
 
-            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+            GLTracked::BindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
 
             // Blit entire snapshot to destination (snapshot is already the right content)
             glBlitFramebuffer(0, 0, s_eyeZoomSnapshotWidth, s_eyeZoomSnapshotHeight, dstLeft, dstBottom, dstRight, dstTop,
@@ -1904,10 +1689,10 @@ void handleEyeZoomMode(const GLState& s, float opacity, int animatedViewportX) {
             // First, render to screen from game texture
             // PERF: Reuse cached blit FBO instead of creating/destroying every frame
             if (s_eyeZoomBlitFBO == 0) { glGenFramebuffers(1, &s_eyeZoomBlitFBO); }
-            glBindFramebuffer(GL_READ_FRAMEBUFFER, s_eyeZoomBlitFBO);
+            GLTracked::BindFramebuffer(GL_READ_FRAMEBUFFER, s_eyeZoomBlitFBO);
             glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, gameTextureToUse, 0);
 
-            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+            GLTracked::BindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
 
             glBlitFramebuffer(srcLeft, srcBottom, srcRight, srcTop, dstLeft, dstBottom, dstRight, dstTop, GL_COLOR_BUFFER_BIT, GL_NEAREST);
 
@@ -1915,21 +1700,21 @@ void handleEyeZoomMode(const GLState& s, float opacity, int animatedViewportX) {
             EnsureEyeZoomSnapshotAllocated();
 
             // Copy from screen to snapshot (just the zoom region, without overlay boxes)
-            glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
-            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, s_eyeZoomSnapshotFBO);
+            GLTracked::BindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+            GLTracked::BindFramebuffer(GL_DRAW_FRAMEBUFFER, s_eyeZoomSnapshotFBO);
             glBlitFramebuffer(dstLeft, dstBottom, dstRight, dstTop, 0, 0, s_eyeZoomSnapshotWidth, s_eyeZoomSnapshotHeight,
                               GL_COLOR_BUFFER_BIT, GL_NEAREST);
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            GLTracked::BindFramebuffer(GL_FRAMEBUFFER, 0);
 
             s_eyeZoomSnapshotValid = true;
         }
 
         // STEP 2: Render colored overlay boxes with numbers
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glUseProgram(g_solidColorProgram);
-        glBindVertexArray(g_vao);
-        glBindBuffer(GL_ARRAY_BUFFER, g_vbo);
+        GLTracked::Enable(GL_BLEND);
+        GLTracked::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLTracked::UseProgram(g_solidColorProgram);
+        GLTracked::BindVertexArray(g_vao);
+        GLTracked::BindBuffer(GL_ARRAY_BUFFER, g_vbo);
 
         float pixelWidthOnScreen = zoomOutputWidth / (float)zoomConfig.cloneWidth;
         int labelsPerSide = zoomConfig.cloneWidth / 2;
@@ -2014,13 +1799,10 @@ void handleEyeZoomMode(const GLState& s, float opacity, int animatedViewportX) {
         glDrawArrays(GL_TRIANGLES, 0, 6);
     }
 
-    glDisable(GL_BLEND);
+    GLTracked::Disable(GL_BLEND);
     // Restore framebuffer and viewport
-    glBindFramebuffer(GL_FRAMEBUFFER, s.fb);
-    if (oglViewport)
-        oglViewport(0, 0, fullW, fullH);
-    else
-        glViewport(0, 0, fullW, fullH);
+    GLTracked::BindFramebuffer(GL_FRAMEBUFFER, s.fb);
+    GLTracked::Viewport(0, 0, fullW, fullH);
 }
 
 // Forward declaration for the internal implementation
@@ -2076,8 +1858,8 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
 
     {
         PROFILE_SCOPE_CAT("GL State Setup", "Rendering");
-        glDisable(GL_FRAMEBUFFER_SRGB);
-        glDisable(GL_BLEND);
+        GLTracked::Disable(GL_FRAMEBUFFER_SRGB);
+        GLTracked::Disable(GL_BLEND);
     }
 
     // Note: Active elements (mirrors/images/overlays) are collected on the render thread
@@ -2088,11 +1870,8 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
     // Handle normal mode specific rendering (viewport setup, backgrounds, etc.)
     {
         PROFILE_SCOPE_CAT("Framebuffer/Viewport Setup", "Rendering");
-        glBindFramebuffer(GL_FRAMEBUFFER, s.fb);
-        if (oglViewport)
-            oglViewport(0, 0, fullW, fullH);
-        else
-            glViewport(0, 0, fullW, fullH);
+        GLTracked::BindFramebuffer(GL_FRAMEBUFFER, s.fb);
+        GLTracked::Viewport(0, 0, fullW, fullH);
     }
 
     // Get game texture (needed for mirror rendering)
@@ -2144,8 +1923,8 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
             if (transitionState.fromHeight != transitionState.targetHeight) { letterboxExtendY = 1; }
         }*/
 
-        glEnable(GL_SCISSOR_TEST);
-        glDisable(GL_DEPTH_TEST);
+        GLTracked::Enable(GL_SCISSOR_TEST);
+        GLTracked::Disable(GL_DEPTH_TEST);
 
         // Determine Fullscreen transition cases
         // Use fromModeId from transitionState (atomically read from snapshot) to avoid race conditions
@@ -2233,7 +2012,7 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
         // Helper lambda to draw a textured quad in the given region using scissor test
         auto drawTexturedRegion = [&](int rx, int ry_gl, int rw, int rh, GLuint texId, float opacity) {
             if (rw <= 0 || rh <= 0) return;
-            glScissor(rx, ry_gl, rw, rh);
+            GLTracked::Scissor(rx, ry_gl, rw, rh);
 
             // Calculate UV coordinates for this region (map screen coords to texture coords)
             float u1 = static_cast<float>(rx) / fullW;
@@ -2255,7 +2034,7 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
         // Helper lambda to draw a solid color quad in the given region using scissor test
         auto drawColorRegion = [&](int rx, int ry_gl, int rw, int rh) {
             if (rw <= 0 || rh <= 0) return;
-            glScissor(rx, ry_gl, rw, rh);
+            GLTracked::Scissor(rx, ry_gl, rw, rh);
 
             // NDC coordinates for this region
             float nx1 = (static_cast<float>(rx) / fullW) * 2.0f - 1.0f;
@@ -2272,7 +2051,7 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
         // Unlike drawColorRegion, this includes proper UV coordinates for gradient interpolation
         auto drawGradientRegion = [&](int rx, int ry_gl, int rw, int rh) {
             if (rw <= 0 || rh <= 0) return;
-            glScissor(rx, ry_gl, rw, rh);
+            GLTracked::Scissor(rx, ry_gl, rw, rh);
 
             // Calculate UV coordinates for this region (map screen coords to texture coords)
             // This allows the gradient shader to know the position within the full screen
@@ -2303,19 +2082,19 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
             GLint savedTexture = 0;
             glGetIntegerv(GL_TEXTURE_BINDING_2D, &savedTexture);
 
-            glEnable(GL_SCISSOR_TEST);
-            glUseProgram(g_backgroundProgram);
-            glBindTexture(GL_TEXTURE_2D, texId);
+            GLTracked::Enable(GL_SCISSOR_TEST);
+            GLTracked::UseProgram(g_backgroundProgram);
+            GLTracked::BindTexture(GL_TEXTURE_2D, texId);
             glUniform1i(g_backgroundShaderLocs.backgroundTexture, 0);
             glUniform1f(g_backgroundShaderLocs.opacity, opacity);
-            glBindVertexArray(g_vao);
-            glBindBuffer(GL_ARRAY_BUFFER, g_vbo);
+            GLTracked::BindVertexArray(g_vao);
+            GLTracked::BindBuffer(GL_ARRAY_BUFFER, g_vbo);
 
             if (opacity < 1.0f) {
-                glEnable(GL_BLEND);
-                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                GLTracked::Enable(GL_BLEND);
+                GLTracked::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
             } else {
-                glDisable(GL_BLEND);
+                GLTracked::Disable(GL_BLEND);
             }
 
             // Calculate viewport bounds in GL coordinates (shrink inward by letterboxExtend)
@@ -2334,10 +2113,10 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
             // Right region: from vpRight to fullW, between vpBottom_gl and vpTop_gl
             drawTexturedRegion(vpRight, vpBottom_gl, fullW - vpRight, vpTop_gl - vpBottom_gl, texId, opacity);
 
-            glDisable(GL_SCISSOR_TEST);
+            GLTracked::Disable(GL_SCISSOR_TEST);
 
             // Restore texture binding
-            glBindTexture(GL_TEXTURE_2D, savedTexture);
+            GLTracked::BindTexture(GL_TEXTURE_2D, savedTexture);
         };
 
         // Lambda to render solid color background by drawing 4 letterbox regions directly
@@ -2345,17 +2124,17 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
         auto renderBackgroundColor = [&](const Color& color, float opacity) {
             PROFILE_SCOPE_CAT("Scissor Background Color", "Rendering");
 
-            glEnable(GL_SCISSOR_TEST);
-            glUseProgram(g_solidColorProgram);
+            GLTracked::Enable(GL_SCISSOR_TEST);
+            GLTracked::UseProgram(g_solidColorProgram);
             glUniform4f(g_solidColorShaderLocs.color, color.r, color.g, color.b, opacity);
-            glBindVertexArray(g_vao);
-            glBindBuffer(GL_ARRAY_BUFFER, g_vbo);
+            GLTracked::BindVertexArray(g_vao);
+            GLTracked::BindBuffer(GL_ARRAY_BUFFER, g_vbo);
 
             if (opacity < 1.0f) {
-                glEnable(GL_BLEND);
-                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                GLTracked::Enable(GL_BLEND);
+                GLTracked::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
             } else {
-                glDisable(GL_BLEND);
+                GLTracked::Disable(GL_BLEND);
             }
 
             // Calculate viewport bounds in GL coordinates (shrink inward by letterboxExtend)
@@ -2374,7 +2153,7 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
             // Right region: from vpRight to fullW, between vpBottom_gl and vpTop_gl
             drawColorRegion(vpRight, vpBottom_gl, fullW - vpRight, vpTop_gl - vpBottom_gl);
 
-            glDisable(GL_SCISSOR_TEST);
+            GLTracked::Disable(GL_SCISSOR_TEST);
         };
 
         // Lambda to render gradient background by drawing 4 letterbox regions directly
@@ -2383,26 +2162,20 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
 
             PROFILE_SCOPE_CAT("Scissor Background Gradient", "Rendering");
 
-            glEnable(GL_SCISSOR_TEST);
-            glUseProgram(g_gradientProgram);
-            glBindVertexArray(g_vao);
-            glBindBuffer(GL_ARRAY_BUFFER, g_vbo);
-
-            // Set gradient uniforms
-            int numStops = (std::min)(static_cast<int>(bg.gradientStops.size()), MAX_GRADIENT_STOPS);
-            glUniform1i(g_gradientShaderLocs.numStops, numStops);
+            GLTracked::Enable(GL_SCISSOR_TEST);
+            GLTracked::UseProgram(g_gradientProgram);
+            GLTracked::BindVertexArray(g_vao);
+            GLTracked::BindBuffer(GL_ARRAY_BUFFER, g_vbo);
 
-            float colors[MAX_GRADIENT_STOPS * 4]; // 4 components per color
-            float positions[MAX_GRADIENT_STOPS];
+            // Baked ramp for the stops (rebuilt only when they change)
+            int numStops = (std::min)(static_cast<int>(bg.gradientStops.size()), RenderCommandList::MAX_GRADIENT_STOPS);
+            RenderGradientStop stops[RenderCommandList::MAX_GRADIENT_STOPS];
             for (int i = 0; i < numStops; i++) {
-                colors[i * 4 + 0] = bg.gradientStops[i].color.r;
-                colors[i * 4 + 1] = bg.gradientStops[i].color.g;
-                colors[i * 4 + 2] = bg.gradientStops[i].color.b;
-                colors[i * 4 + 3] = opacity;
-                positions[i] = bg.gradientStops[i].position;
+                const GradientColorStop& stop = bg.gradientStops[i];
+                stops[i] = { stop.color.r, stop.color.g, stop.color.b, opacity, stop.position };
             }
-            glUniform4fv(g_gradientShaderLocs.stopColors, numStops, colors);
-            glUniform1fv(g_gradientShaderLocs.stopPositions, numStops, positions);
+            GLTracked::ActiveTexture(GL_TEXTURE0);
+            GLTracked::BindTexture(GL_TEXTURE_2D, g_gradientRamps.Get({ stops, numStops }));
             glUniform1f(g_gradientShaderLocs.angle, bg.gradientAngle * 3.14159265f / 180.0f);
 
             // Animation uniforms
@@ -2415,10 +2188,10 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
             glUniform1i(g_gradientShaderLocs.colorFade, bg.gradientColorFade ? 1 : 0);
 
             if (opacity < 1.0f) {
-                glEnable(GL_BLEND);
-                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                GLTracked::Enable(GL_BLEND);
+                GLTracked::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
             } else {
-                glDisable(GL_BLEND);
+                GLTracked::Disable(GL_BLEND);
             }
 
             // Calculate viewport bounds in GL coordinates (shrink inward by letterboxExtend)
@@ -2437,7 +2210,7 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
             // Right region: from vpRight to fullW, between vpBottom_gl and vpTop_gl
             drawGradientRegion(vpRight, vpBottom_gl, fullW - vpRight, vpTop_gl - vpBottom_gl);
 
-            glDisable(GL_SCISSOR_TEST);
+            GLTracked::Disable(GL_SCISSOR_TEST);
         };
 
         // Render the "from" mode's background if we need to preserve it during transition
@@ -2466,9 +2239,9 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
             }
         }
 
-        glDisable(GL_SCISSOR_TEST);
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, g_sceneFBO);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, s.fb);
+        GLTracked::Disable(GL_SCISSOR_TEST);
+        GLTracked::BindFramebuffer(GL_READ_FRAMEBUFFER, g_sceneFBO);
+        GLTracked::BindFramebuffer(GL_DRAW_FRAMEBUFFER, s.fb);
 
         // Render game border if enabled (after background, before mirrors/images)
         {
@@ -2512,7 +2285,8 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
         g_captureGameH.store(current_gameH);
 
         // Lazy auto-start capture thread when game texture is available
-        if (!useFramebufferFallback && !g_mirrorCaptureRunning.load()) {
+        // Don't retry context creation every frame once the CPU mirror fallback has taken over
+        if (!useFramebufferFallback && !g_mirrorCaptureRunning.load() && !IsMirrorCpuFallbackActive()) {
             HGLRC gameContext = wglGetCurrentContext();
             if (gameContext) {
                 // Capture texture init is now done inside StartMirrorCaptureThread after wglShareLists
@@ -2634,10 +2408,10 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
 
             // Early exit if no mirrors need updating
             if (!mirrorsNeedingUpdate.empty()) {
-                glBindVertexArray(g_vao);
-                glBindBuffer(GL_ARRAY_BUFFER, g_vbo);
-                glEnable(GL_BLEND);
-                glBlendFunc(GL_ONE, GL_ONE);
+                GLTracked::BindVertexArray(g_vao);
+                GLTracked::BindBuffer(GL_ARRAY_BUFFER, g_vbo);
+                GLTracked::Enable(GL_BLEND);
+                GLTracked::BlendFunc(GL_ONE, GL_ONE);
 
                 PROFILE_SCOPE_CAT("Fallback Mirror Lock", "Rendering");
                 std::unique_lock<std::shared_mutex> mirrorLock(g_mirrorInstancesMutex); // Write lock - modifying instances
@@ -2660,7 +2434,7 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
                         inst.forceUpdateFrames = 3;
 
                         // NEAREST filtering for pixel-perfect scaling (front/back get swapped)
-                        glBindTexture(GL_TEXTURE_2D, inst.fboTexture);
+                        GLTracked::BindTexture(GL_TEXTURE_2D, inst.fboTexture);
                         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, inst.fbo_w, inst.fbo_h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
                         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
                         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -2668,7 +2442,7 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
                         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
                         // Also resize back buffer - use NEAREST filtering for pixel-perfect scaling
-                        glBindTexture(GL_TEXTURE_2D, inst.fboTextureBack);
+                        GLTracked::BindTexture(GL_TEXTURE_2D, inst.fboTextureBack);
                         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, inst.fbo_w, inst.fbo_h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
                         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
                         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -2676,17 +2450,14 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
                         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
                     }
 
-                    glBindFramebuffer(GL_FRAMEBUFFER, inst.fbo);
-                    if (oglViewport)
-                        oglViewport(0, 0, inst.fbo_w, inst.fbo_h);
-                    else
-                        glViewport(0, 0, inst.fbo_w, inst.fbo_h);
-                    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+                    GLTracked::BindFramebuffer(GL_FRAMEBUFFER, inst.fbo);
+                    GLTracked::Viewport(0, 0, inst.fbo_w, inst.fbo_h);
+                    GLTracked::ClearColor(0.0f, 0.0f, 0.0f, 0.0f);
                     glClear(GL_COLOR_BUFFER_BIT);
 
                     // FALLBACK MODE: Capture directly from main framebuffer
-                    glBindFramebuffer(GL_READ_FRAMEBUFFER, s.fb);
-                    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, inst.fbo);
+                    GLTracked::BindFramebuffer(GL_READ_FRAMEBUFFER, s.fb);
+                    GLTracked::BindFramebuffer(GL_DRAW_FRAMEBUFFER, inst.fbo);
 
                     for (const auto& r : conf.input) {
                         int capX, capY;
@@ -2711,7 +2482,7 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
                                           GL_NEAREST);
                     }
 
-                    glBindFramebuffer(GL_FRAMEBUFFER, inst.fbo);
+                    GLTracked::BindFramebuffer(GL_FRAMEBUFFER, inst.fbo);
                     inst.lastUpdateTime = now;
                     inst.hasValidContent = true; // Front buffer now has renderable content (fallback path)
                     // Fallback path uses glBlitFramebuffer which is always raw capture
@@ -2719,17 +2490,14 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
                     if (inst.forceUpdateFrames > 0) { inst.forceUpdateFrames--; }
                 }
 
-                glDisable(GL_BLEND);
+                GLTracked::Disable(GL_BLEND);
             }
         }
     }
 
     // Restore framebuffer and viewport
-    glBindFramebuffer(GL_FRAMEBUFFER, s.fb);
-    if (oglViewport)
-        oglViewport(0, 0, fullW, fullH);
-    else
-        glViewport(0, 0, fullW, fullH);
+    GLTracked::BindFramebuffer(GL_FRAMEBUFFER, s.fb);
+    GLTracked::Viewport(0, 0, fullW, fullH);
 
     // Handle image dragging when drag mode is active (BEFORE rendering)
     if (g_imageDragMode.load() && g_imageOverlaysVisible.load(std::memory_order_acquire)) {
@@ -3073,7 +2841,7 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
             request.finalW = currentGeo.finalW;
             request.finalH = currentGeo.finalH;
             request.gameTextureId = gameTextureToUse;
-            request.modeId = modeToRender->id;
+            request.modeHandle = GetModeIdHandle(*modeToRender);
             request.isAnimating = isAnimating;
             request.overlayOpacity = overlayOpacity;
             request.obsDetected = g_graphicsHookDetected.load();
@@ -3151,7 +2919,7 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
 
             // Transition-related background/border (for transitioning TO Fullscreen)
             request.transitioningToFullscreen = isAnimating && EqualsIgnoreCase(modeToRender->id, "Fullscreen");
-            request.fromModeId = transitionState.fromModeId;
+            request.fromModeHandle = transitionState.fromModeHandle;
             if (!transitionState.fromModeId.empty()) {
                 const ModeConfig* fromMode = GetMode_Internal(transitionState.fromModeId);
                 if (fromMode) {
@@ -3213,22 +2981,22 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
             glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT);
 
             // Use pre-allocated static fullscreen quad VAO/VBO - no per-frame vertex upload needed
-            glBindVertexArray(g_fullscreenQuadVAO);
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, completedTexture);
+            GLTracked::BindVertexArray(g_fullscreenQuadVAO);
+            GLTracked::ActiveTexture(GL_TEXTURE0);
+            GLTracked::BindTexture(GL_TEXTURE_2D, completedTexture);
 
             // Use background shader (simpler passthrough, uniforms already set during init)
-            glUseProgram(g_backgroundProgram);
+            GLTracked::UseProgram(g_backgroundProgram);
             glUniform1f(g_backgroundShaderLocs.opacity, 1.0f);
 
             // Composite async overlay using straight-alpha blending.
             // The render_thread output is NOT premultiplied (ImGui OpenGL3 backend + our shaders output straight alpha).
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            GLTracked::Enable(GL_BLEND);
+            GLTracked::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
             glDrawArrays(GL_TRIANGLES, 0, 6);
 
-            glDisable(GL_BLEND);
+            GLTracked::Disable(GL_BLEND);
 
             // Publish a consumer fence for this specific completed FBO.
             // This prevents the render thread from reusing/clearing the same texture while the GPU
@@ -3265,12 +3033,12 @@ void RenderDebugBordersForMirror(const MirrorConfig* conf, Color captureColor, C
         geo = g_lastFrameGeometry;
     }
 
-    glUseProgram(g_solidColorProgram);
-    glLineWidth(2.0f);
-    glDisable(GL_BLEND);
+    GLTracked::UseProgram(g_solidColorProgram);
+    GLTracked::LineWidth(2.0f);
+    GLTracked::Disable(GL_BLEND);
 
-    glBindVertexArray(g_debugVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, g_debugVBO);
+    GLTracked::BindVertexArray(g_debugVAO);
+    GLTracked::BindBuffer(GL_ARRAY_BUFFER, g_debugVBO);
 
     float xScale = geo.gameW > 0 ? (float)geo.finalW / geo.gameW : 1.0f;
     float yScale = geo.gameH > 0 ? (float)geo.finalH / geo.gameH : 1.0f;
@@ -3324,7 +3092,7 @@ void RenderDebugBordersForMirror(const MirrorConfig* conf, Color captureColor, C
         glDrawArrays(GL_LINE_LOOP, 0, 4);
     }
 
-    glBindVertexArray(originalVAO);
+    GLTracked::BindVertexArray(originalVAO);
 }
 
 // Initialize a larger font for overlay text rendering
@@ -3401,7 +3169,7 @@ void RenderTextureGridOverlay(bool showTextureGrid, int modeWidth, int modeHeigh
     std::vector<TexInfo> validTextures;
     for (GLuint id = 0; id <= MAX_TEXTURE_ID; id++) {
         if (glIsTexture(id)) {
-            glBindTexture(GL_TEXTURE_2D, id);
+            GLTracked::BindTexture(GL_TEXTURE_2D, id);
             GLint texWidth = 0, texHeight = 0, internalFormat = 0;
             glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &texWidth);
             glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &texHeight);
@@ -3449,15 +3217,15 @@ void RenderTextureGridOverlay(bool showTextureGrid, int modeWidth, int modeHeigh
     depthEnabled = glIsEnabled(GL_DEPTH_TEST);
 
     // Setup rendering state
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLTracked::Disable(GL_DEPTH_TEST);
+    GLTracked::Enable(GL_BLEND);
+    GLTracked::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Use the image render shader to display texture contents properly
-    glUseProgram(g_imageRenderProgram);
-    glBindVertexArray(g_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, g_vbo);
-    glActiveTexture(GL_TEXTURE0);
+    GLTracked::UseProgram(g_imageRenderProgram);
+    GLTracked::BindVertexArray(g_vao);
+    GLTracked::BindBuffer(GL_ARRAY_BUFFER, g_vbo);
+    GLTracked::ActiveTexture(GL_TEXTURE0);
 
     // Set shader uniforms - disable color key, full opacity
     glUniform1i(g_imageRenderShaderLocs.imageTexture, 0);
@@ -3475,7 +3243,7 @@ void RenderTextureGridOverlay(bool showTextureGrid, int modeWidth, int modeHeigh
         int y = MARGIN + row * (TILE_SIZE + PADDING);
 
         // Bind the texture to display
-        glBindTexture(GL_TEXTURE_2D, tex.id);
+        GLTracked::BindTexture(GL_TEXTURE_2D, tex.id);
 
         // Use cached dimensions from first pass (avoid redundant glGetTexLevelParameteriv)
         GLint texWidth = tex.width;
@@ -3541,28 +3309,28 @@ void RenderTextureGridOverlay(bool showTextureGrid, int modeWidth, int modeHeigh
 
     // Restore filter state for all modified textures
     for (const auto& pair : texFilterStates) {
-        glBindTexture(GL_TEXTURE_2D, pair.first);
+        GLTracked::BindTexture(GL_TEXTURE_2D, pair.first);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, pair.second.first);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, pair.second.second);
     }
 
     // Restore OpenGL state
-    glActiveTexture(lastActiveTexture);
-    glBindTexture(GL_TEXTURE_2D, lastTexture);
-    glBindVertexArray(lastVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, lastArrayBuffer);
-    glUseProgram(lastProgram);
+    GLTracked::ActiveTexture(lastActiveTexture);
+    GLTracked::BindTexture(GL_TEXTURE_2D, lastTexture);
+    GLTracked::BindVertexArray(lastVAO);
+    GLTracked::BindBuffer(GL_ARRAY_BUFFER, lastArrayBuffer);
+    GLTracked::UseProgram(lastProgram);
 
     if (depthEnabled)
-        glEnable(GL_DEPTH_TEST);
+        GLTracked::Enable(GL_DEPTH_TEST);
     else
-        glDisable(GL_DEPTH_TEST);
+        GLTracked::Disable(GL_DEPTH_TEST);
 
     if (blendEnabled) {
-        glEnable(GL_BLEND);
-        glBlendFunc(lastBlendSrc, lastBlendDst);
+        GLTracked::Enable(GL_BLEND);
+        GLTracked::BlendFunc(lastBlendSrc, lastBlendDst);
     } else {
-        glDisable(GL_BLEND);
+        GLTracked::Disable(GL_BLEND);
     }
 }
 
@@ -3672,80 +3440,29 @@ void RenderCachedTextureGridLabels() {
     }
 }
 
-// Easing functions with configurable power/exponent
-static float EaseOutPower(float t, float power) {
-    float t1 = t - 1.0f;
-    // For odd powers, we need abs to handle negative values correctly
-    float sign = (t1 < 0) ? -1.0f : 1.0f;
-    return sign * std::pow(std::abs(t1), power) + 1.0f;
+std::shared_ptr<const ModeTransitionDescriptor> GetActiveModeTransition() {
+    // Lock-free read: atomic load of shared_ptr
+    return std::atomic_load_explicit(&g_activeModeTransition, std::memory_order_acquire);
 }
 
-static float EaseInPower(float t, float power) { return std::pow(t, power); }
-
-// Combined ease-in and ease-out with separate power controls
-// easeInPower: 1.0 = no ease-in (linear start), higher = more pronounced slow start
-// easeOutPower: 1.0 = no ease-out (linear end), higher = more pronounced slow stop
-static float ApplyDualEasing(float t, float easeInPower, float easeOutPower) {
-    // Clamp powers to reasonable range
-    easeInPower = std::clamp(easeInPower, 1.0f, 10.0f);
-    easeOutPower = std::clamp(easeOutPower, 1.0f, 10.0f);
-
-    // If both are 1.0, it's linear
-    if (easeInPower <= 1.0f && easeOutPower <= 1.0f) { return t; }
-
-    // Split the animation into two halves
-    // First half: apply ease-in (slow start)
-    // Second half: apply ease-out (slow stop)
-    if (t < 0.5f) {
-        // First half - apply ease-in
-        float halfT = t * 2.0f; // Scale input from [0, 0.5] to [0, 1]
-        float easedHalfT = EaseInPower(halfT, easeInPower);
-        return easedHalfT * 0.5f; // Scale output back to [0, 0.5]
-    } else {
-        // Second half - apply ease-out
-        float halfT = (t - 0.5f) * 2.0f; // Scale input from [0.5, 1] to [0, 1]
-        float easedHalfT = EaseOutPower(halfT, easeOutPower);
-        return 0.5f + easedHalfT * 0.5f; // Scale output to [0.5, 1]
-    }
-}
-
-// Apply bounce effect - returns an offset multiplier for the bounce oscillation
-// The bounce goes BACK towards origin (opposite direction of movement)
-// bounceProgress: 0.0 to 1.0 within the bounce phase
-// bounceIndex: which bounce we're on (0 = first bounce)
-// totalBounces: total number of bounces
-// intensity: base intensity (0.0-0.5)
-static float CalculateBounceOffset(float bounceProgress, int bounceIndex, int totalBounces, float intensity) {
-    if (totalBounces <= 0 || bounceIndex >= totalBounces) return 0.0f;
-
-    // Each successive bounce has reduced intensity
-    float decayFactor = 1.0f - (static_cast<float>(bounceIndex) / static_cast<float>(totalBounces));
-    decayFactor = decayFactor * decayFactor; // Quadratic decay for more natural feel
-
-    // Sine wave for smooth bounce oscillation (half cycle per bounce)
-    float angle = bounceProgress * 3.14159265f; // 0 to PI for one half-cycle
-    float bounce = std::sin(angle) * intensity * decayFactor;
-
-    return bounce;
+TransitionClock::time_point GetModeTransitionFrameTime() {
+    return TransitionClock::time_point(TransitionClock::duration(g_modeTransitionFrameTicks.load(std::memory_order_acquire)));
 }
 
 void StartModeTransition(const std::string& fromModeId, const std::string& toModeId, int fromWidth, int fromHeight, int fromX, int fromY,
                          int toWidth, int toHeight, int toX, int toY, const ModeConfig& toMode) {
-    LogCategory("animation", "[ANIMATION] StartModeTransition entry - acquiring g_modeTransitionMutex...");
-    std::lock_guard<std::mutex> lock(g_modeTransitionMutex);
-    LogCategory("animation", "[ANIMATION] g_modeTransitionMutex acquired");
-
     // Handle Cut/Cut/Cut transition - needs first-frame protection to prevent black flash
     // EXCEPTION: When transitioning TO Fullscreen, we ALWAYS need to animate to keep the from-mode's
     // background visible during the transition (Fullscreen has no background of its own)
     bool transitioningToFullscreen = EqualsIgnoreCase(toModeId, "Fullscreen");
-    bool transitioningFromFullscreen = EqualsIgnoreCase(fromModeId, "Fullscreen");
 
     // ALL Cut/Cut/Cut transitions need at least 1-frame protection to prevent black flash.
     // The game clears its buffer when it receives WM_SIZE, so we need to:
     // 1. Keep showing the old mode's content for 1 frame
     // 2. Only send WM_SIZE AFTER that first frame is rendered
     // This applies regardless of hideAnimationsInGame setting.
+    // The frame is guaranteed because the transition stays published until UpdateModeTransition retires it
+    // at the end of a game frame, however short its duration.
     bool isAllCutTransition = toMode.gameTransition == GameTransitionType::Cut && toMode.overlayTransition == OverlayTransitionType::Cut &&
                               toMode.backgroundTransition == BackgroundTransitionType::Cut;
 
@@ -3753,98 +3470,78 @@ void StartModeTransition(const std::string& fromModeId, const std::string& toMod
         LogCategory("animation", "[ANIMATION] Cut/Cut/Cut transition - using 1-frame protection to prevent black flash");
     }
 
-    g_modeTransition.active = true;
-    g_modeTransition.startTime = std::chrono::steady_clock::now();
+    auto desc = std::make_shared<ModeTransitionDescriptor>();
+    desc->startTime = TransitionClock::now();
 
     // For Cut transitions (game=Cut), use minimal duration for first-frame protection
     // Since overlay/background transitions are always Cut now, simplify the check
     bool allCutToFullscreen = transitioningToFullscreen && toMode.gameTransition == GameTransitionType::Cut;
     bool allCutWithFirstFrameProtection = isAllCutTransition && !transitioningToFullscreen;
     if (allCutToFullscreen || allCutWithFirstFrameProtection) {
-        g_modeTransition.duration = 0.001f; // Minimal duration - just one frame
+        desc->duration = 0.001f; // Minimal duration - just one frame
     } else {
-        g_modeTransition.duration = toMode.transitionDurationMs / 1000.0f;
+        desc->duration = toMode.transitionDurationMs / 1000.0f;
     }
 
-    // Store transition configuration
-    g_modeTransition.gameTransition = toMode.gameTransition;
-    g_modeTransition.overlayTransition = OverlayTransitionType::Cut;       // Always Cut
-    g_modeTransition.backgroundTransition = BackgroundTransitionType::Cut; // Always Cut
+    // Overlay/background transitions are always Cut; only the game transition is stored
+    desc->animateGame = toMode.gameTransition == GameTransitionType::Bounce;
 
     // Copy easing and bounce settings
-    g_modeTransition.easeInPower = toMode.easeInPower;
-    g_modeTransition.easeOutPower = toMode.easeOutPower;
-    g_modeTransition.bounceCount = toMode.bounceCount;
-    g_modeTransition.bounceIntensity = toMode.bounceIntensity;
-    g_modeTransition.bounceDurationMs = toMode.bounceDurationMs;
+    desc->easeInPower = toMode.easeInPower;
+    desc->easeOutPower = toMode.easeOutPower;
+    desc->bounceCount = toMode.bounceCount;
+    desc->bounceIntensity = toMode.bounceIntensity;
+    desc->bounceDurationMs = toMode.bounceDurationMs;
+    // Sample the easing curve once so per-frame evaluation is a table lookup
+    BakeModeTransitionEasing(*desc);
 
     // For skip axis settings, use EyeZoom's settings when transitioning TO or FROM EyeZoom
     // This ensures EyeZoom transitions consistently use its own settings in both directions
     bool transitioningToEyeZoom = EqualsIgnoreCase(toModeId, "EyeZoom");
     bool transitioningFromEyeZoom = EqualsIgnoreCase(fromModeId, "EyeZoom");
 
+    // Use one snapshot for thread-safe mode lookups (called from multiple threads)
+    auto transSnap = GetConfigSnapshot();
     if (transitioningFromEyeZoom && !transitioningToEyeZoom) {
-        // Transitioning FROM EyeZoom - look up EyeZoom's skip settings (use snapshot for thread safety)
-        auto transSnap = GetConfigSnapshot();
+        // Transitioning FROM EyeZoom - look up EyeZoom's skip settings
         const ModeConfig* eyeZoomMode = transSnap ? GetModeFromSnapshot(*transSnap, "EyeZoom") : nullptr;
         if (eyeZoomMode) {
-            g_modeTransition.skipAnimateX = eyeZoomMode->skipAnimateX;
-            g_modeTransition.skipAnimateY = eyeZoomMode->skipAnimateY;
+            desc->skipAnimateX = eyeZoomMode->skipAnimateX;
+            desc->skipAnimateY = eyeZoomMode->skipAnimateY;
         }
     } else {
         // Transitioning TO EyeZoom or other transitions - use destination mode's settings
-        g_modeTransition.skipAnimateX = toMode.skipAnimateX;
-        g_modeTransition.skipAnimateY = toMode.skipAnimateY;
+        desc->skipAnimateX = toMode.skipAnimateX;
+        desc->skipAnimateY = toMode.skipAnimateY;
     }
 
-    g_modeTransition.fromModeId = fromModeId;
-    g_modeTransition.fromWidth = fromWidth;
-    g_modeTransition.fromHeight = fromHeight;
-    g_modeTransition.fromX = fromX;
-    g_modeTransition.fromY = fromY;
+    desc->fromModeId = fromModeId;
+    desc->fromModeHandle = InternModeId(fromModeId);
+    desc->fromWidth = fromWidth;
+    desc->fromHeight = fromHeight;
+    desc->fromX = fromX;
+    desc->fromY = fromY;
 
-    g_modeTransition.toModeId = toModeId;
-    g_modeTransition.toWidth = toWidth;
-    g_modeTransition.toHeight = toHeight;
-    g_modeTransition.toX = toX;
-    g_modeTransition.toY = toY;
+    desc->toModeId = toModeId;
+    desc->toWidth = toWidth;
+    desc->toHeight = toHeight;
+    desc->toX = toX;
+    desc->toY = toY;
 
     // Store native (non-stretched) dimensions for viewport matching
     // The game's glViewport calls use native dimensions, not stretched
-    // Use snapshot for thread-safe lookup of fromMode (called from multiple threads)
-    auto nativeSnap = GetConfigSnapshot();
-    const ModeConfig* fromModePtr = nativeSnap ? GetModeFromSnapshot(*nativeSnap, fromModeId) : nullptr;
+    const ModeConfig* fromModePtr = transSnap ? GetModeFromSnapshot(*transSnap, fromModeId) : nullptr;
     if (fromModePtr) {
-        g_modeTransition.fromNativeWidth = fromModePtr->width;
-        g_modeTransition.fromNativeHeight = fromModePtr->height;
+        desc->fromNativeWidth = fromModePtr->width;
+        desc->fromNativeHeight = fromModePtr->height;
     } else {
         // Fallback: if no stretch, fromWidth/Height are already native
-        g_modeTransition.fromNativeWidth = fromWidth;
-        g_modeTransition.fromNativeHeight = fromHeight;
+        desc->fromNativeWidth = fromWidth;
+        desc->fromNativeHeight = fromHeight;
     }
     // toMode is passed by reference, use its native dimensions
-    g_modeTransition.toNativeWidth = toMode.width > 0 ? toMode.width : toWidth;
-    g_modeTransition.toNativeHeight = toMode.height > 0 ? toMode.height : toHeight;
-
-    // Initialize current values based on game transition type
-    if (toMode.gameTransition == GameTransitionType::Bounce) {
-        g_modeTransition.currentWidth = fromWidth;
-        g_modeTransition.currentHeight = fromHeight;
-        g_modeTransition.currentX = fromX;
-        g_modeTransition.currentY = fromY;
-    } else {
-        // Game cuts instantly
-        g_modeTransition.currentWidth = toWidth;
-        g_modeTransition.currentHeight = toHeight;
-        g_modeTransition.currentX = toX;
-        g_modeTransition.currentY = toY;
-    }
-    g_modeTransition.progress = 0.0f;
-    g_modeTransition.moveProgress = 0.0f; // Must initialize to 0 for first frame overlay positioning
-    g_modeTransition.wmSizeSent = false;  // Reset WM_SIZE flag
-
-    g_modeTransition.lastSentWidth = 0;
-    g_modeTransition.lastSentHeight = 0;
+    desc->toNativeWidth = toMode.width > 0 ? toMode.width : toWidth;
+    desc->toNativeHeight = toMode.height > 0 ? toMode.height : toHeight;
 
     // CRITICAL: Set isTransitioningFromEyeZoom BEFORE sending WM_SIZE
     // This freezes the EyeZoom snapshot immediately so it's captured before the game texture resizes
@@ -3855,17 +3552,19 @@ void StartModeTransition(const std::string& fromModeId, const std::string& toMod
         g_isTransitioningFromEyeZoom.store(false, std::memory_order_release);
     }
 
+    // Publish before WM_SIZE so the viewport hook already matches the new native size when the game resizes.
+    // The frame time moves to the start first: a reader that sees the new descriptor evaluates its first frame.
+    g_modeTransitionFrameTicks.store(desc->startTime.time_since_epoch().count(), std::memory_order_release);
+    std::atomic_store_explicit(&g_activeModeTransition, std::shared_ptr<const ModeTransitionDescriptor>(desc), std::memory_order_release);
+
     // Send WM_SIZE immediately when transition starts - don't wait for first frame
     // FIX: Always send the native mode dimensions to WM_SIZE, not the stretched dimensions
-    int wmWidth = toMode.width > 0 ? toMode.width : toWidth;
-    int wmHeight = toMode.height > 0 ? toMode.height : toHeight;
+    int wmWidth = desc->toNativeWidth;
+    int wmHeight = desc->toNativeHeight;
 
     HWND hwnd = g_minecraftHwnd.load();
     if (hwnd && wmWidth > 0 && wmHeight > 0) {
         PostMessage(hwnd, WM_SIZE, SIZE_RESTORED, MAKELPARAM(wmWidth, wmHeight));
-        g_modeTransition.wmSizeSent = true;
-        g_modeTransition.lastSentWidth = wmWidth;
-        g_modeTransition.lastSentHeight = wmHeight;
         LogCategory("animation", "[ANIMATION] WM_SIZE sent immediately: " + std::to_string(wmWidth) + "x" + std::to_string(wmHeight));
     }
 
@@ -3876,270 +3575,54 @@ void StartModeTransition(const std::string& fromModeId, const std::string& toMod
                                  "x" + std::to_string(fromHeight) + " at " + std::to_string(fromX) + "," + std::to_string(fromY) + ")" +
                                  " -> " + toModeId + " (" + std::to_string(toWidth) + "x" + std::to_string(toHeight) + " at " +
                                  std::to_string(toX) + "," + std::to_string(toY) + ")");
-
-    // Update lock-free snapshot for viewport hook and GetModeTransitionState (done inside the lock)
-    int nextSnapshotIndex = 1 - g_viewportTransitionSnapshotIndex.load(std::memory_order_relaxed);
-    ViewportTransitionSnapshot& snapshot = g_viewportTransitionSnapshots[nextSnapshotIndex];
-    snapshot.active = g_modeTransition.active;
-    snapshot.isBounceTransition = (g_modeTransition.gameTransition == GameTransitionType::Bounce);
-    snapshot.fromModeId = g_modeTransition.fromModeId;
-    snapshot.toModeId = g_modeTransition.toModeId;
-    snapshot.fromWidth = g_modeTransition.fromWidth;
-    snapshot.fromHeight = g_modeTransition.fromHeight;
-    snapshot.fromX = g_modeTransition.fromX;
-    snapshot.fromY = g_modeTransition.fromY;
-    snapshot.currentX = g_modeTransition.currentX;
-    snapshot.currentY = g_modeTransition.currentY;
-    snapshot.currentWidth = g_modeTransition.currentWidth;
-    snapshot.currentHeight = g_modeTransition.currentHeight;
-    snapshot.toX = g_modeTransition.toX;
-    snapshot.toY = g_modeTransition.toY;
-    snapshot.toWidth = g_modeTransition.toWidth;
-    snapshot.toHeight = g_modeTransition.toHeight;
-    // Native dimensions for viewport matching
-    snapshot.fromNativeWidth = g_modeTransition.fromNativeWidth;
-    snapshot.fromNativeHeight = g_modeTransition.fromNativeHeight;
-    snapshot.toNativeWidth = g_modeTransition.toNativeWidth;
-    snapshot.toNativeHeight = g_modeTransition.toNativeHeight;
-    // New fields for GetModeTransitionState
-    snapshot.gameTransition = g_modeTransition.gameTransition;
-    snapshot.overlayTransition = g_modeTransition.overlayTransition;
-    snapshot.backgroundTransition = g_modeTransition.backgroundTransition;
-    snapshot.progress = g_modeTransition.progress;
-    snapshot.moveProgress = g_modeTransition.moveProgress;
-    // Fade duration fields removed - overlay/background transitions are always Cut
-    snapshot.startTime = g_modeTransition.startTime;
-    g_viewportTransitionSnapshotIndex.store(nextSnapshotIndex, std::memory_order_release);
-
-    LogCategory("animation", "[ANIMATION] StartModeTransition complete - releasing g_modeTransitionMutex");
 }
 
 void UpdateModeTransition() {
-    std::lock_guard<std::mutex> lock(g_modeTransitionMutex);
-
-    if (!g_modeTransition.active) return;
-
-    auto now = std::chrono::steady_clock::now();
-    float elapsed = std::chrono::duration<float>(now - g_modeTransition.startTime).count();
-
-    // Calculate total animation duration including bounces
-    float baseDuration = g_modeTransition.duration;
-    float totalBounceDuration =
-        (g_modeTransition.bounceCount > 0) ? (g_modeTransition.bounceCount * g_modeTransition.bounceDurationMs / 1000.0f) : 0.0f;
-    float totalDuration = baseDuration + totalBounceDuration;
-
-    float progress = elapsed / totalDuration;
-    g_modeTransition.progress = (progress < 1.0f) ? progress : 1.0f;
-
-    // Update game viewport animation (if Bounce)
-    if (g_modeTransition.gameTransition == GameTransitionType::Bounce) {
-        // Calculate the ratio of base animation within total duration
-        float baseRatio = baseDuration / totalDuration;
-
-        // Determine which phase we're in: movement or bounce
-        float moveProgress = 0.0f;
-        float bounceOffset = 0.0f;
-
-        if (g_modeTransition.progress < baseRatio) {
-            // Still in movement phase
-            float phaseProgress = g_modeTransition.progress / baseRatio;
-            moveProgress = std::clamp(phaseProgress, 0.0f, 1.0f);
-            // Apply dual easing with separate ease-in and ease-out powers
-            moveProgress = ApplyDualEasing(moveProgress, g_modeTransition.easeInPower, g_modeTransition.easeOutPower);
-        } else {
-            // In bounce phase - movement is complete
-            moveProgress = 1.0f;
-
-            if (g_modeTransition.bounceCount > 0 && totalBounceDuration > 0) {
-                float bounceElapsed = (g_modeTransition.progress - baseRatio) * totalDuration;
-                float singleBounceDuration = g_modeTransition.bounceDurationMs / 1000.0f;
-
-                int currentBounce = static_cast<int>(bounceElapsed / singleBounceDuration);
-                if (currentBounce < g_modeTransition.bounceCount) {
-                    float bouncePhaseProgress = std::fmod(bounceElapsed, singleBounceDuration) / singleBounceDuration;
-                    bounceOffset = CalculateBounceOffset(bouncePhaseProgress, currentBounce, g_modeTransition.bounceCount,
-                                                         g_modeTransition.bounceIntensity);
-                }
-            }
-        }
-
-        // Calculate base interpolated values
-        // IMPORTANT: If from and to values are identical for an axis, skip interpolation entirely
-        // to avoid floating-point precision issues causing tiny visual artifacts (1-2 pixel jitter)
-        int baseWidth, baseHeight, baseX, baseY;
-
-        // Width: only animate if actually changing
-        if (g_modeTransition.fromWidth == g_modeTransition.toWidth) {
-            baseWidth = g_modeTransition.toWidth;
-        } else {
-            baseWidth =
-                static_cast<int>(g_modeTransition.fromWidth + (g_modeTransition.toWidth - g_modeTransition.fromWidth) * moveProgress);
-        }
+    const TransitionClock::time_point now = TransitionClock::now();
+    std::shared_ptr<const ModeTransitionDescriptor> desc = GetActiveModeTransition();
+    if (!desc) return;
 
-        // Height: only animate if actually changing
-        if (g_modeTransition.fromHeight == g_modeTransition.toHeight) {
-            baseHeight = g_modeTransition.toHeight;
-        } else {
-            baseHeight =
-                static_cast<int>(g_modeTransition.fromHeight + (g_modeTransition.toHeight - g_modeTransition.fromHeight) * moveProgress);
-        }
-
-        // X position: only animate if actually changing
-        if (g_modeTransition.fromX == g_modeTransition.toX) {
-            baseX = g_modeTransition.toX;
-        } else {
-            baseX = static_cast<int>(g_modeTransition.fromX + (g_modeTransition.toX - g_modeTransition.fromX) * moveProgress);
-        }
-
-        // Y position: only animate if actually changing
-        if (g_modeTransition.fromY == g_modeTransition.toY) {
-            baseY = g_modeTransition.toY;
-        } else {
-            baseY = static_cast<int>(g_modeTransition.fromY + (g_modeTransition.toY - g_modeTransition.fromY) * moveProgress);
-        }
-
-        // Apply skip axis options - if enabled, that axis instantly jumps to target
-        if (g_modeTransition.skipAnimateX) {
-            baseWidth = g_modeTransition.toWidth;
-            baseX = g_modeTransition.toX;
-        }
-        if (g_modeTransition.skipAnimateY) {
-            baseHeight = g_modeTransition.toHeight;
-            baseY = g_modeTransition.toY;
-        }
-
-        // Apply bounce offset - bounce goes BACK towards origin (opposite direction of movement)
-        // If we moved from large to small, bounce makes it temporarily larger again
-        // If we moved from small to large, bounce makes it temporarily smaller again
-        if (bounceOffset != 0.0f) {
-            int deltaW = g_modeTransition.toWidth - g_modeTransition.fromWidth;
-            int deltaH = g_modeTransition.toHeight - g_modeTransition.fromHeight;
-            // Negate the offset to bounce BACK towards origin
-            // Skip bounce on X axis if skipAnimateX is enabled OR if width/X aren't changing
-            bool skipBounceX = g_modeTransition.skipAnimateX ||
-                               (g_modeTransition.fromWidth == g_modeTransition.toWidth && g_modeTransition.fromX == g_modeTransition.toX);
-            if (skipBounceX) {
-                g_modeTransition.currentWidth = g_modeTransition.toWidth;
-                g_modeTransition.currentX = g_modeTransition.toX;
-            } else {
-                g_modeTransition.currentWidth = g_modeTransition.toWidth - static_cast<int>(deltaW * bounceOffset);
-                int deltaX = g_modeTransition.toX - g_modeTransition.fromX;
-                g_modeTransition.currentX = g_modeTransition.toX - static_cast<int>(deltaX * bounceOffset);
-            }
-            // Skip bounce on Y axis if skipAnimateY is enabled OR if height/Y aren't changing
-            bool skipBounceY = g_modeTransition.skipAnimateY ||
-                               (g_modeTransition.fromHeight == g_modeTransition.toHeight && g_modeTransition.fromY == g_modeTransition.toY);
-            if (skipBounceY) {
-                g_modeTransition.currentHeight = g_modeTransition.toHeight;
-                g_modeTransition.currentY = g_modeTransition.toY;
-            } else {
-                g_modeTransition.currentHeight = g_modeTransition.toHeight - static_cast<int>(deltaH * bounceOffset);
-                int deltaY = g_modeTransition.toY - g_modeTransition.fromY;
-                g_modeTransition.currentY = g_modeTransition.toY - static_cast<int>(deltaY * bounceOffset);
-            }
-        } else {
-            g_modeTransition.currentWidth = baseWidth;
-            g_modeTransition.currentHeight = baseHeight;
-            g_modeTransition.currentX = baseX;
-            g_modeTransition.currentY = baseY;
-        }
-
-        // Save EASED moveProgress for overlay lerping (matches viewport easing)
-        // Reaches 1.0 when movement phase ends and bounce starts
-        g_modeTransition.moveProgress = moveProgress;
-    } else {
-        // For non-bounce (Cut) transitions, moveProgress equals overall progress
-        g_modeTransition.moveProgress = g_modeTransition.progress;
-    }
+    // Next game frame's viewport hook and RenderModeInternal evaluate at this time.
+    // Called AFTER all rendering is complete, so both see the same values for the whole frame.
+    g_modeTransitionFrameTicks.store(now.time_since_epoch().count(), std::memory_order_release);
 
     // WM_SIZE is sent once at the start in StartModeTransition
     // The game's internal framebuffer only updates when the transition starts, not during
+    if (!EvaluateModeTransition(*desc, now).complete) return;
 
-    // Check if animation is complete
-    // Overlay/background transitions are always Cut, so just check game transition duration
-    bool allComplete = (elapsed >= totalDuration);
-
-    if (allComplete) {
-        LogCategory("animation", "[ANIMATION] Mode transition complete: " + g_modeTransition.toModeId + " (final stretch: " +
-                                     std::to_string(g_modeTransition.toWidth) + "x" + std::to_string(g_modeTransition.toHeight) + " at " +
-                                     std::to_string(g_modeTransition.toX) + "," + std::to_string(g_modeTransition.toY) + ")");
-
-        // Ensure current values are exactly at target before deactivating to prevent
-        // any stale bounce values from being read in the brief window before deactivation
-        g_modeTransition.currentWidth = g_modeTransition.toWidth;
-        g_modeTransition.currentHeight = g_modeTransition.toHeight;
-        g_modeTransition.currentX = g_modeTransition.toX;
-        g_modeTransition.currentY = g_modeTransition.toY;
-
-        g_modeTransition.active = false;
-        // WM_SIZE is already sent immediately in StartModeTransition
+    // Retire only the transition that was evaluated; one started in the meantime stays published
+    std::shared_ptr<const ModeTransitionDescriptor> expected = desc;
+    if (std::atomic_compare_exchange_strong_explicit(&g_activeModeTransition, &expected, std::shared_ptr<const ModeTransitionDescriptor>(),
+                                                     std::memory_order_acq_rel, std::memory_order_acquire)) {
+        LogCategory("animation", "[ANIMATION] Mode transition complete: " + desc->toModeId + " (final stretch: " +
+                                     std::to_string(desc->toWidth) + "x" + std::to_string(desc->toHeight) + " at " +
+                                     std::to_string(desc->toX) + "," + std::to_string(desc->toY) + ")");
     }
-
-    // Update lock-free snapshot for viewport hook and GetModeTransitionState (done inside the lock)
-    int nextSnapshotIndex = 1 - g_viewportTransitionSnapshotIndex.load(std::memory_order_relaxed);
-    ViewportTransitionSnapshot& snapshot = g_viewportTransitionSnapshots[nextSnapshotIndex];
-    snapshot.active = g_modeTransition.active;
-    snapshot.isBounceTransition = (g_modeTransition.gameTransition == GameTransitionType::Bounce);
-    snapshot.fromModeId = g_modeTransition.fromModeId;
-    snapshot.toModeId = g_modeTransition.toModeId;
-    snapshot.fromWidth = g_modeTransition.fromWidth;
-    snapshot.fromHeight = g_modeTransition.fromHeight;
-    snapshot.fromX = g_modeTransition.fromX;
-    snapshot.fromY = g_modeTransition.fromY;
-    snapshot.currentX = g_modeTransition.currentX;
-    snapshot.currentY = g_modeTransition.currentY;
-    snapshot.currentWidth = g_modeTransition.currentWidth;
-    snapshot.currentHeight = g_modeTransition.currentHeight;
-    snapshot.toX = g_modeTransition.toX;
-    snapshot.toY = g_modeTransition.toY;
-    snapshot.toWidth = g_modeTransition.toWidth;
-    snapshot.toHeight = g_modeTransition.toHeight;
-    // Native dimensions for viewport matching
-    snapshot.fromNativeWidth = g_modeTransition.fromNativeWidth;
-    snapshot.fromNativeHeight = g_modeTransition.fromNativeHeight;
-    snapshot.toNativeWidth = g_modeTransition.toNativeWidth;
-    snapshot.toNativeHeight = g_modeTransition.toNativeHeight;
-    // New fields for GetModeTransitionState
-    snapshot.gameTransition = g_modeTransition.gameTransition;
-    snapshot.overlayTransition = g_modeTransition.overlayTransition;
-    snapshot.backgroundTransition = g_modeTransition.backgroundTransition;
-    snapshot.progress = g_modeTransition.progress;
-    snapshot.moveProgress = g_modeTransition.moveProgress;
-    // Fade duration fields removed - overlay/background transitions are always Cut
-    snapshot.startTime = g_modeTransition.startTime;
-    g_viewportTransitionSnapshotIndex.store(nextSnapshotIndex, std::memory_order_release);
 }
 
-bool IsModeTransitionActive() {
-    std::lock_guard<std::mutex> lock(g_modeTransitionMutex);
-    return g_modeTransition.active;
-}
+bool IsModeTransitionActive() { return GetActiveModeTransition() != nullptr; }
 
 GameTransitionType GetGameTransitionType() {
-    std::lock_guard<std::mutex> lock(g_modeTransitionMutex);
-    return g_modeTransition.active ? g_modeTransition.gameTransition : GameTransitionType::Cut;
+    std::shared_ptr<const ModeTransitionDescriptor> desc = GetActiveModeTransition();
+    return (desc && desc->animateGame) ? GameTransitionType::Bounce : GameTransitionType::Cut;
 }
 
-OverlayTransitionType GetOverlayTransitionType() {
-    std::lock_guard<std::mutex> lock(g_modeTransitionMutex);
-    return g_modeTransition.active ? g_modeTransition.overlayTransition : OverlayTransitionType::Cut;
-}
+// Overlay and background transitions are always Cut
+OverlayTransitionType GetOverlayTransitionType() { return OverlayTransitionType::Cut; }
 
-BackgroundTransitionType GetBackgroundTransitionType() {
-    std::lock_guard<std::mutex> lock(g_modeTransitionMutex);
-    return g_modeTransition.active ? g_modeTransition.backgroundTransition : BackgroundTransitionType::Cut;
-}
+BackgroundTransitionType GetBackgroundTransitionType() { return BackgroundTransitionType::Cut; }
 
 std::string GetModeTransitionFromModeId() {
-    std::lock_guard<std::mutex> lock(g_modeTransitionMutex);
-    return g_modeTransition.active ? g_modeTransition.fromModeId : "";
+    std::shared_ptr<const ModeTransitionDescriptor> desc = GetActiveModeTransition();
+    return desc ? desc->fromModeId : "";
 }
 
 void GetAnimatedModeViewport(int& outWidth, int& outHeight) {
-    std::lock_guard<std::mutex> lock(g_modeTransitionMutex);
-    if (g_modeTransition.active) {
-        outWidth = g_modeTransition.currentWidth;
-        outHeight = g_modeTransition.currentHeight;
+    std::shared_ptr<const ModeTransitionDescriptor> desc = GetActiveModeTransition();
+    if (desc) {
+        ModeTransitionFrame frame = EvaluateModeTransition(*desc, GetModeTransitionFrameTime());
+        outWidth = frame.width;
+        outHeight = frame.height;
     } else {
         // No transition active - use the current mode's actual dimensions
         ModeViewportInfo viewport = GetCurrentModeViewport();
@@ -4155,10 +3638,11 @@ void GetAnimatedModeViewport(int& outWidth, int& outHeight) {
 }
 
 void GetAnimatedModePosition(int& outX, int& outY) {
-    std::lock_guard<std::mutex> lock(g_modeTransitionMutex);
-    if (g_modeTransition.active) {
-        outX = g_modeTransition.currentX;
-        outY = g_modeTransition.currentY;
+    std::shared_ptr<const ModeTransitionDescriptor> desc = GetActiveModeTransition();
+    if (desc) {
+        ModeTransitionFrame frame = EvaluateModeTransition(*desc, GetModeTransitionFrameTime());
+        outX = frame.x;
+        outY = frame.y;
     } else {
         // No transition active - use the current mode's actual position
         ModeViewportInfo viewport = GetCurrentModeViewport();
@@ -4185,49 +3669,48 @@ bool WaitForOverlayBlitFence() {
     return false;
 }
 
-ModeTransitionState GetModeTransitionState() {
-    // Lock-free read from double-buffered snapshot
-    const ViewportTransitionSnapshot& snapshot =
-        g_viewportTransitionSnapshots[g_viewportTransitionSnapshotIndex.load(std::memory_order_acquire)];
+ModeTransitionState GetModeTransitionState() { return GetModeTransitionState(GetModeTransitionFrameTime()); }
+
+ModeTransitionState GetModeTransitionState(TransitionClock::time_point presentTime) {
+    // Lock-free: the descriptor is immutable, the state is evaluated from it for presentTime
+    std::shared_ptr<const ModeTransitionDescriptor> desc = GetActiveModeTransition();
 
     ModeTransitionState state;
-    state.active = snapshot.active;
+    state.active = desc != nullptr;
+    // Overlay/background transitions are always Cut
+    state.overlayTransition = OverlayTransitionType::Cut;
+    state.backgroundTransition = BackgroundTransitionType::Cut;
     if (state.active) {
-        state.width = snapshot.currentWidth;
-        state.height = snapshot.currentHeight;
-        state.x = snapshot.currentX;
-        state.y = snapshot.currentY;
-        state.gameTransition = snapshot.gameTransition;
-        state.overlayTransition = snapshot.overlayTransition;
-        state.backgroundTransition = snapshot.backgroundTransition;
-        state.progress = snapshot.progress;
-        state.moveProgress = snapshot.moveProgress;
-
-        // Fade progress values removed - overlay/background transitions are always Cut
-        // No need to calculate elapsed time for fade progress anymore
+        ModeTransitionFrame frame = EvaluateModeTransition(*desc, presentTime);
+        state.width = frame.width;
+        state.height = frame.height;
+        state.x = frame.x;
+        state.y = frame.y;
+        state.gameTransition = desc->animateGame ? GameTransitionType::Bounce : GameTransitionType::Cut;
+        state.progress = frame.progress;
+        state.moveProgress = frame.moveProgress;
+
         // Target (final) position - where game should render during Move animation
-        state.targetWidth = snapshot.toWidth;
-        state.targetHeight = snapshot.toHeight;
-        state.targetX = snapshot.toX;
-        state.targetY = snapshot.toY;
+        state.targetWidth = desc->toWidth;
+        state.targetHeight = desc->toHeight;
+        state.targetX = desc->toX;
+        state.targetY = desc->toY;
         // From mode geometry - for background rendering during Fullscreen transitions
-        state.fromWidth = snapshot.fromWidth;
-        state.fromHeight = snapshot.fromHeight;
-        state.fromX = snapshot.fromX;
-        state.fromY = snapshot.fromY;
+        state.fromWidth = desc->fromWidth;
+        state.fromHeight = desc->fromHeight;
+        state.fromX = desc->fromX;
+        state.fromY = desc->fromY;
         // From mode ID - for background rendering during transitions
-        state.fromModeId = snapshot.fromModeId;
+        state.fromModeId = desc->fromModeId;
+        state.fromModeHandle = desc->fromModeHandle;
     } else {
         state.width = 0;
         state.height = 0;
         state.x = 0;
         state.y = 0;
         state.gameTransition = GameTransitionType::Cut;
-        state.overlayTransition = OverlayTransitionType::Cut;
-        state.backgroundTransition = BackgroundTransitionType::Cut;
         state.progress = 1.0f;
-        state.moveProgress = 1.0f; // Add missing moveProgress initialization
-        // overlayProgress and backgroundProgress removed - fade transitions no longer supported
+        state.moveProgress = 1.0f;
         state.targetWidth = 0;
         state.targetHeight = 0;
         state.targetX = 0;
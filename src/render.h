@@ -15,6 +15,8 @@
 #include <windows.h>
 
 // Need gui.h for enum definitions used in function signatures
+#include "gpu_resources.h"
+#include "gradient_ramp.h"
 #include "gui.h"
 #include "mirror_thread.h"
 
@@ -83,11 +85,8 @@ struct PassthroughShaderLocs {
 };
 
 // Gradient shader uniforms (for background gradients)
-#define MAX_GRADIENT_STOPS 8
 struct GradientShaderLocs {
-    GLint numStops;       // Number of color stops
-    GLint stopColors;     // Array of vec4 colors
-    GLint stopPositions;  // Array of float positions
+    GLint ramp;           // Baked color ramp (GradientRampTextures)
     GLint angle;          // Gradient angle in radians
     GLint time;           // Animation time in seconds
     GLint animationType;  // Animation type enum
@@ -95,42 +94,37 @@ struct GradientShaderLocs {
     GLint colorFade;      // Whether color fade is enabled
 };
 
-// Struct to hold original GL state
-// Only includes state that we actually modify during rendering
+// Ramp textures for the gradient stop sets drawn on one context: GRADIENT_RAMP_TEXELS x GRADIENT_RAMP_LAYERS,
+// one row per GradientRampLayer, linearly filtered and repeating horizontally. A frame draws one gradient, or
+// two during a transition (from- and to-mode), so two entries with least-recently-used replacement keep both
+// resident and a ramp is only rebuilt when its stops change.
+class GradientRampTextures {
+  public:
+    static constexpr int CAPACITY = 2;
+
+    // Texture for `stops`, built on first use (binds GL_TEXTURE_2D on the active unit when it has to build)
+    GLuint Get(const GradientStopSpan& stops);
+    void Release(); // Deletes the textures (owning context must be current)
+
+  private:
+    struct Entry {
+        GLuint texture = 0;
+        uint64_t hash = 0;
+        uint64_t lastUse = 0;
+    };
+
+    Entry m_entries[CAPACITY];
+    uint64_t m_useCounter = 0;
+    GradientRamp m_ramp; // Build scratch
+};
+
+// Game state the frame's render code reads. Everything we change on the game's context is
+// captured and restored by GLStateTracker (gl_state_tracker.h), not stored here.
 struct GLState {
-    // Core bindings
-    GLint p;                   // Current program
-    GLint t;                   // Texture binding for originally active texture unit
-    GLint t0;                  // Texture binding for GL_TEXTURE0 (we always render with unit 0)
-    GLint ab;                  // Array buffer binding
-    GLint va;                  // Vertex array binding
-    GLint fb;                  // Framebuffer binding
-    GLint read_fb, draw_fb;    // Read/Draw framebuffer bindings
-    GLint at;                  // Active texture unit
-
-    // Enable/disable states we modify
-    GLboolean be;                   // GL_BLEND
-    GLboolean de;                   // GL_DEPTH_TEST
-    GLboolean sc;                   // GL_SCISSOR_TEST
-    GLboolean srgb_enabled;         // GL_FRAMEBUFFER_SRGB
-
-    // Blend function state
-    GLint blend_src_rgb, blend_dst_rgb, blend_src_alpha, blend_dst_alpha;
-
-    // Viewport and scissor
-    GLint vp[4]; // Viewport
-    GLint sb[4]; // Scissor box
-
-    // Other state we modify
-    GLfloat cc[4];                          // Clear color
-    GLfloat lw;                             // Line width
-    GLboolean color_mask[4];                // Color write mask (R, G, B, A)
-    // Pixel store state (we frequently change these during texture uploads)
-    GLint unpack_row_length;
-    GLint unpack_skip_pixels;
-    GLint unpack_skip_rows;
-    GLint pack_alignment;
-    GLint unpack_alignment;
+    GLint va;               // Vertex array binding
+    GLint fb;               // Framebuffer binding (same as draw_fb)
+    GLint read_fb, draw_fb; // Read/Draw framebuffer bindings
+    GLint vp[4];            // Viewport
 };
 
 extern GLuint g_filterProgram;
@@ -167,7 +161,7 @@ GLuint GetEyeZoomSnapshotTexture();
 int GetEyeZoomSnapshotWidth();
 int GetEyeZoomSnapshotHeight();
 
-extern std::unordered_map<std::string, MirrorInstance> g_mirrorInstances;
+extern MirrorSlotMap<MirrorInstance> g_mirrorInstances;
 
 // Animated background texture instance
 struct BackgroundTextureInstance {
@@ -179,10 +173,12 @@ struct BackgroundTextureInstance {
     std::vector<int> frameDelays;      // Delay in ms between each frame
     size_t currentFrame = 0;
     std::chrono::steady_clock::time_point lastFrameTime;
+    std::vector<GpuResourceHandle> textureHandles; // Owns the textures above (one per frame)
 };
 
 extern std::unordered_map<std::string, BackgroundTextureInstance> g_backgroundTextures;
 extern std::unordered_map<std::string, UserImageInstance> g_userImages;
+extern uint64_t g_userImagesGeneration; // Bumped (under g_userImagesMutex) whenever g_userImages entries change - GL names get reused
 extern GLuint g_vao;
 extern GLuint g_vbo;
 extern GLuint g_debugVAO;
@@ -198,9 +194,6 @@ extern std::shared_mutex g_mirrorInstancesMutex;
 extern std::mutex g_userImagesMutex;
 extern std::mutex g_backgroundTexturesMutex;
 
-extern std::vector<GLuint> g_texturesToDelete;
-extern std::mutex g_texturesToDeleteMutex;
-extern std::atomic<bool> g_hasTexturesToDelete;
 extern bool g_glInitialized;
 extern std::atomic<bool> g_isGameFocused;
 extern GameViewportGeometry g_lastFrameGeometry;
@@ -257,13 +250,14 @@ void SetOverlayTextFontSize(int sizePixels);
 // Helper functions for calculating dimensions
 void CalculateImageDimensions(const ImageConfig& img, int& outW, int& outH);
 
-// OpenGL State Management
-void SaveGLState(GLState* s);
-void RestoreGLState(const GLState& s);
+// OpenGL State Management - starts/ends GL state tracking for a frame on the game's context
+void BeginGLStateTracking(GLState* s);
+void EndGLStateTracking();
 
 // Original (unhooked) glViewport - bypasses hkglViewport hook.
 // All internal rendering code should use this instead of glViewport to avoid
 // interfering with the viewport hook's state tracking (lastViewportW/H).
+// On the game's context, use GLTracked::Viewport, which calls this and tracks the change.
 typedef void(WINAPI* GLVIEWPORTPROC)(GLint x, GLint y, GLsizei width, GLsizei height);
 extern GLVIEWPORTPROC oglViewport;
 
@@ -280,7 +274,7 @@ OverlayTransitionType GetOverlayTransitionType();
 BackgroundTransitionType GetBackgroundTransitionType();
 std::string GetModeTransitionFromModeId();
 
-// Struct to hold all transition state atomically
+// Evaluated transition state for one present time
 struct ModeTransitionState {
     bool active;
     int width;
@@ -304,10 +298,13 @@ struct ModeTransitionState {
     int fromY;
     // From mode ID - needed for background rendering during transitions
     std::string fromModeId;
+    ModeIdHandle fromModeHandle = MODE_ID_NONE;
 };
 
-// Get all transition state in a single atomic operation to avoid race conditions
+// Get all transition state for the game frame's present time. Lock-free.
 ModeTransitionState GetModeTransitionState();
+// Same, evaluated at the caller's own present time (OBS pass on the render thread)
+ModeTransitionState GetModeTransitionState(TransitionClock::time_point presentTime);
 
 // Debug Texture Grid
 void RenderTextureGridOverlay(bool showTextureGrid, int modeWidth = 0, int modeHeight = 0);
@@ -0,0 +1,109 @@
+// ============================================================================
+// RENDER_COMMANDS.CPP - Recorded overlay draw commands for the render thread
+// ============================================================================
+
+#include "render_commands.h"
+
+#include <algorithm>
+
+void RenderCommandList::SolidQuad(const RenderRect& rect, float r, float g, float b, float a, RenderBlendMode blend) {
+    RenderCommand& cmd = m_commands.emplace_back();
+    cmd.type = RenderCommandType::SolidQuad;
+    cmd.blend = blend;
+    cmd.rect = rect;
+    cmd.color[0] = r;
+    cmd.color[1] = g;
+    cmd.color[2] = b;
+    cmd.color[3] = a;
+}
+
+void RenderCommandList::TexturedQuad(const RenderRect& rect, const RenderRect& uv, uint32_t texture, float opacity, RenderFilter filter,
+                                     RenderBlendMode blend) {
+    RenderCommand& cmd = m_commands.emplace_back();
+    cmd.type = RenderCommandType::TexturedQuad;
+    cmd.blend = blend;
+    cmd.filter = filter;
+    cmd.rect = rect;
+    cmd.uv = uv;
+    cmd.texture = texture;
+    cmd.textured.opacity = opacity;
+}
+
+void RenderCommandList::KeyedTexturedQuad(const RenderRect& rect, const RenderRect& uv, uint32_t texture, float opacity, RenderFilter filter,
+                                          RenderBlendMode blend, float keyR, float keyG, float keyB, float sensitivity) {
+    TexturedQuad(rect, uv, texture, opacity, filter, blend);
+    RenderCommand::Textured& t = m_commands.back().textured;
+    t.colorKeyEnabled = true;
+    t.colorKey[0] = keyR;
+    t.colorKey[1] = keyG;
+    t.colorKey[2] = keyB;
+    t.keySensitivity = sensitivity;
+}
+
+void RenderCommandList::Border(const RenderRect& rect, int shape, float thickness, float radius, float shapeW, float shapeH, float quadW,
+                               float quadH, float r, float g, float b, float a, RenderBlendMode blend) {
+    RenderCommand& cmd = m_commands.emplace_back();
+    cmd.type = RenderCommandType::Border;
+    cmd.blend = blend;
+    cmd.rect = rect;
+    cmd.color[0] = r;
+    cmd.color[1] = g;
+    cmd.color[2] = b;
+    cmd.color[3] = a;
+    cmd.border = { shape, thickness, radius, shapeW, shapeH, quadW, quadH };
+}
+
+void RenderCommandList::Gradient(const RenderRect& rect, const RenderGradientStop* stops, int stopCount, float angle, float time,
+                                 int animationType, float animationSpeed, bool colorFade, RenderBlendMode blend) {
+    stopCount = (std::min)(stopCount, MAX_GRADIENT_STOPS);
+    if (stopCount < 2) return;
+
+    RenderCommand& cmd = m_commands.emplace_back();
+    cmd.type = RenderCommandType::Gradient;
+    cmd.blend = blend;
+    cmd.rect = rect;
+    cmd.gradient = { static_cast<uint32_t>(m_gradientStops.size()), static_cast<uint32_t>(stopCount), angle, time, animationSpeed,
+                     animationType, colorFade };
+    m_gradientStops.insert(m_gradientStops.end(), stops, stops + stopCount);
+}
+
+void RenderCommandList::Text(const RenderRect& rect, const RenderRect& uv, uint32_t atlasTexture, float r, float g, float b, float a,
+                             RenderFilter filter, RenderBlendMode blend) {
+    RenderCommand& cmd = m_commands.emplace_back();
+    cmd.type = RenderCommandType::Text;
+    cmd.blend = blend;
+    cmd.filter = filter;
+    cmd.rect = rect;
+    cmd.uv = uv;
+    cmd.texture = atlasTexture;
+    cmd.color[0] = r;
+    cmd.color[1] = g;
+    cmd.color[2] = b;
+    cmd.color[3] = a;
+}
+
+void RenderCommandStats::Add(const RenderCommandStats& other) {
+    commands += other.commands;
+    for (int i = 0; i < static_cast<int>(RenderCommandType::Count); i++) { byType[i] += other.byType[i]; }
+    batchable += other.batchable;
+    stateChanges += other.stateChanges;
+}
+
+RenderCommandStats AnalyzeRenderCommands(const RenderCommandList& list) {
+    RenderCommandStats stats;
+    const RenderCommand* prev = nullptr;
+    for (const RenderCommand& cmd : list.Commands()) {
+        stats.commands++;
+        stats.byType[static_cast<int>(cmd.type)]++;
+        const bool usesTexture = cmd.type == RenderCommandType::TexturedQuad || cmd.type == RenderCommandType::Text;
+        const bool samePipeline = prev && prev->type == cmd.type && prev->blend == cmd.blend &&
+                                  (!usesTexture || (prev->texture == cmd.texture && prev->filter == cmd.filter));
+        if (samePipeline) {
+            stats.batchable++;
+        } else {
+            stats.stateChanges++;
+        }
+        prev = &cmd;
+    }
+    return stats;
+}
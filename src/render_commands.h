@@ -0,0 +1,142 @@
+#pragma once
+
+// ============================================================================
+// RENDER_COMMANDS.H - Recorded overlay draw commands for the render thread
+// ============================================================================
+// Overlay draws (image and window overlays with their backgrounds and borders, game borders, gradient
+// backgrounds) are recorded into a RenderCommandList instead of being issued inline. The render thread
+// replays a list with its own GL programs (RT_ExecuteRenderCommands in render_thread.cpp), and
+// SoftwareRenderBackend (render_commands_sw.h) rasterizes the same list on the CPU, which gives
+// reference images for layout and compositing without a GPU.
+//
+// Commands are axis-aligned quads in NDC, exactly like the vertex data they replace. Each command
+// carries its complete pipeline state (program, texture, blend), so a list replays identically no
+// matter what was bound before it. Texture uploads and sampler setup stay immediate GL calls; only
+// draws are recorded.
+// ============================================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class RenderCommandType : uint8_t {
+    SolidQuad,    // Flat color
+    TexturedQuad, // Texture * opacity, optional color key (image render program)
+    Border,       // Rectangle/ellipse outline from an SDF (static border program)
+    Gradient,     // Multi-stop linear gradient with animation (gradient program, baked ramp texture)
+    Text,         // Glyph quad: color * texture, for font atlases
+    Count
+};
+
+enum class RenderBlendMode : uint8_t {
+    Opaque,          // Blending disabled
+    Alpha,           // GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA on all channels
+    AlphaPremulDest, // RGB as Alpha, alpha GL_ONE, GL_ONE_MINUS_SRC_ALPHA - keeps the target premultiplied
+    Premultiplied,   // GL_ONE, GL_ONE_MINUS_SRC_ALPHA - for sources that are already premultiplied
+};
+
+enum class RenderFilter : uint8_t { Linear, Nearest };
+
+struct RenderRect {
+    float x1, y1, x2, y2;
+};
+
+struct RenderGradientStop {
+    float r, g, b, a;
+    float position;
+};
+
+struct RenderCommand {
+    RenderCommandType type = RenderCommandType::SolidQuad;
+    RenderBlendMode blend = RenderBlendMode::Alpha;
+    RenderFilter filter = RenderFilter::Linear; // How the GL texture is already set up to sample
+    RenderRect rect{};                          // NDC
+    RenderRect uv{ 0.0f, 0.0f, 1.0f, 1.0f };    // Texture coordinates at (x1, y1) and (x2, y2)
+    float color[4] = { 0.0f, 0.0f, 0.0f, 0.0f }; // SolidQuad, Border and Text
+    uint32_t texture = 0;                        // GL texture name - TexturedQuad and Text
+
+    struct Textured {
+        float opacity;
+        bool colorKeyEnabled;
+        float colorKey[3];
+        float keySensitivity;
+    };
+    struct Border {
+        int shape;        // 0 = rectangle (with optional rounded corners), 1 = ellipse
+        float thickness;  // Pixels, drawn outward from the shape edge
+        float radius;     // Corner radius in pixels (rectangle only)
+        float shapeW, shapeH; // Base shape size in pixels
+        float quadW, quadH;   // Size of the expanded quad in pixels
+    };
+    struct Gradient {
+        uint32_t firstStop; // Into RenderCommandList::GradientStops()
+        uint32_t stopCount;
+        float angle; // Radians
+        float time;  // Seconds
+        float animationSpeed;
+        int animationType; // GradientAnimationType value
+        bool colorFade;
+    };
+    union {
+        Textured textured;
+        Border border;
+        Gradient gradient;
+    };
+
+    RenderCommand() : textured{ 1.0f, false, { 0.0f, 0.0f, 0.0f }, 0.0f } {}
+};
+
+class RenderCommandList {
+  public:
+    // Editor and recording limit (gradients are drawn from baked ramps, which have none); extra stops are
+    // dropped when recording
+    static constexpr int MAX_GRADIENT_STOPS = 32;
+
+    void Clear() {
+        m_commands.clear();
+        m_gradientStops.clear();
+    }
+    bool Empty() const { return m_commands.empty(); }
+    size_t Size() const { return m_commands.size(); }
+    const std::vector<RenderCommand>& Commands() const { return m_commands; }
+    const std::vector<RenderGradientStop>& GradientStops() const { return m_gradientStops; }
+
+    void SolidQuad(const RenderRect& rect, float r, float g, float b, float a, RenderBlendMode blend);
+    void TexturedQuad(const RenderRect& rect, const RenderRect& uv, uint32_t texture, float opacity, RenderFilter filter,
+                      RenderBlendMode blend);
+    // TexturedQuad with the image shader's color key (linear-space distance below `sensitivity` is discarded)
+    void KeyedTexturedQuad(const RenderRect& rect, const RenderRect& uv, uint32_t texture, float opacity, RenderFilter filter,
+                           RenderBlendMode blend, float keyR, float keyG, float keyB, float sensitivity);
+    // `rect` is the expanded quad; the border is drawn from the shape edge outward by `thickness` pixels
+    void Border(const RenderRect& rect, int shape, float thickness, float radius, float shapeW, float shapeH, float quadW, float quadH,
+                float r, float g, float b, float a, RenderBlendMode blend);
+    void Gradient(const RenderRect& rect, const RenderGradientStop* stops, int stopCount, float angle, float time, int animationType,
+                  float animationSpeed, bool colorFade, RenderBlendMode blend);
+    void Text(const RenderRect& rect, const RenderRect& uv, uint32_t atlasTexture, float r, float g, float b, float a, RenderFilter filter,
+              RenderBlendMode blend);
+
+  private:
+    std::vector<RenderCommand> m_commands;
+    std::vector<RenderGradientStop> m_gradientStops;
+};
+
+// Per-list (or per-frame, via Add) counts for spotting batching opportunities. A command is batchable
+// when it uses the same program, texture, filter and blend as the command before it, so both could be
+// one draw if the per-quad parameters moved into vertex data.
+struct RenderCommandStats {
+    uint32_t commands = 0;
+    uint32_t byType[static_cast<int>(RenderCommandType::Count)] = {};
+    uint32_t batchable = 0;
+    uint32_t stateChanges = 0; // Commands that need a program, texture or blend change first
+
+    void Add(const RenderCommandStats& other);
+};
+
+RenderCommandStats AnalyzeRenderCommands(const RenderCommandList& list);
+
+// Window pixel rectangle (origin top-left, y down) to NDC for a fullW x fullH target
+inline RenderRect PixelRectToNdc(int x, int y, int w, int h, int fullW, int fullH) {
+    const int yGl = fullH - y - h;
+    return { (static_cast<float>(x) / fullW) * 2.0f - 1.0f, (static_cast<float>(yGl) / fullH) * 2.0f - 1.0f,
+             (static_cast<float>(x + w) / fullW) * 2.0f - 1.0f, (static_cast<float>(yGl + h) / fullH) * 2.0f - 1.0f };
+}
@@ -0,0 +1,218 @@
+// ============================================================================
+// RENDER_COMMANDS_SW.CPP - CPU rasterizer for RenderCommandLists
+// ============================================================================
+// Each shading function follows the matching GLSL program in render_thread.cpp line by line
+// (rt_solid_color_frag_shader, rt_image_render_frag_shader, rt_static_border_frag_shader,
+// rt_text_frag_shader). Keep them in sync when a shader changes. Gradients are shaded by gradient_ramp.cpp.
+// ============================================================================
+
+#include "render_commands_sw.h"
+#include "gradient_ramp.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+struct Vec4 {
+    float r, g, b, a;
+};
+
+Vec4 Mix(const Vec4& x, const Vec4& y, float t) {
+    return { x.r + (y.r - x.r) * t, x.g + (y.g - x.g) * t, x.b + (y.b - x.b) * t, x.a + (y.a - x.a) * t };
+}
+
+float Clamp01(float v) { return (std::min)((std::max)(v, 0.0f), 1.0f); }
+
+Vec4 Texel(const SoftwareImage& tex, int x, int y) {
+    x = (std::min)((std::max)(x, 0), tex.width - 1);
+    y = (std::min)((std::max)(y, 0), tex.height - 1);
+    const uint8_t* p = tex.At(x, y);
+    return { p[0] / 255.0f, p[1] / 255.0f, p[2] / 255.0f, p[3] / 255.0f };
+}
+
+Vec4 Sample(const SoftwareImage& tex, float u, float v, RenderFilter filter) {
+    if (filter == RenderFilter::Nearest) {
+        return Texel(tex, static_cast<int>(std::floor(u * tex.width)), static_cast<int>(std::floor(v * tex.height)));
+    }
+    const float fx = u * tex.width - 0.5f;
+    const float fy = v * tex.height - 0.5f;
+    const int x0 = static_cast<int>(std::floor(fx));
+    const int y0 = static_cast<int>(std::floor(fy));
+    const float tx = fx - x0;
+    const float ty = fy - y0;
+    const Vec4 bottom = Mix(Texel(tex, x0, y0), Texel(tex, x0 + 1, y0), tx);
+    const Vec4 top = Mix(Texel(tex, x0, y0 + 1), Texel(tex, x0 + 1, y0 + 1), tx);
+    return Mix(bottom, top, ty);
+}
+
+// ---- rt_static_border_frag_shader ----
+
+float SdRoundedBox(float px, float py, float bx, float by, float r) {
+    r = (std::min)((std::max)(r, 0.0f), (std::min)(bx, by));
+    const float qx = std::fabs(px) - bx + r;
+    const float qy = std::fabs(py) - by + r;
+    const float mx = (std::max)(qx, 0.0f), my = (std::max)(qy, 0.0f);
+    return std::sqrt(mx * mx + my * my) + (std::min)((std::max)(qx, qy), 0.0f) - r;
+}
+
+float SdEllipse(float px, float py, float ax, float by) {
+    const float nx = px / ax, ny = py / by;
+    const float len = std::sqrt(nx * nx + ny * ny);
+    if (len < 0.0001f) return -(std::min)(ax, by);
+    const float gx = nx / (ax * len), gy = ny / (by * len);
+    return (len - 1.0f) / std::sqrt(gx * gx + gy * gy);
+}
+
+bool ShadeBorder(const RenderCommand::Border& b, float u, float v) {
+    const float px = u * b.quadW - b.quadW * 0.5f;
+    const float py = v * b.quadH - b.quadH * 0.5f;
+    const float hx = (std::max)(b.shapeW * 0.5f, 1.0f);
+    const float hy = (std::max)(b.shapeH * 0.5f, 1.0f);
+    const float dist = b.shape == 0 ? SdRoundedBox(px, py, hx, hy, b.radius) : SdEllipse(px, py, hx, hy);
+    const float epsilon = 0.5f;
+    return dist >= -epsilon && dist <= b.thickness + epsilon;
+}
+
+// ---- rt_image_render_frag_shader ----
+
+bool KeyedOut(const RenderCommand::Textured& t, const Vec4& c) {
+    const float dr = std::pow(c.r, 2.2f) - std::pow(t.colorKey[0], 2.2f);
+    const float dg = std::pow(c.g, 2.2f) - std::pow(t.colorKey[1], 2.2f);
+    const float db = std::pow(c.b, 2.2f) - std::pow(t.colorKey[2], 2.2f);
+    return std::sqrt(dr * dr + dg * dg + db * db) < t.keySensitivity;
+}
+
+uint8_t ToUnorm8(float v) { return static_cast<uint8_t>(std::lround(Clamp01(v) * 255.0f)); }
+
+void Blend(uint8_t* dst, Vec4 src, RenderBlendMode mode) {
+    src = { Clamp01(src.r), Clamp01(src.g), Clamp01(src.b), Clamp01(src.a) };
+    const Vec4 d = { dst[0] / 255.0f, dst[1] / 255.0f, dst[2] / 255.0f, dst[3] / 255.0f };
+    Vec4 out;
+    switch (mode) {
+    case RenderBlendMode::Opaque:
+        out = src;
+        break;
+    case RenderBlendMode::Alpha:
+        out = Mix(d, src, src.a);
+        break;
+    case RenderBlendMode::AlphaPremulDest:
+        out = Mix(d, src, src.a);
+        out.a = src.a + d.a * (1.0f - src.a);
+        break;
+    case RenderBlendMode::Premultiplied:
+    default:
+        out = { src.r + d.r * (1.0f - src.a), src.g + d.g * (1.0f - src.a), src.b + d.b * (1.0f - src.a), src.a + d.a * (1.0f - src.a) };
+        break;
+    }
+    dst[0] = ToUnorm8(out.r);
+    dst[1] = ToUnorm8(out.g);
+    dst[2] = ToUnorm8(out.b);
+    dst[3] = ToUnorm8(out.a);
+}
+
+} // namespace
+
+void SoftwareImage::Clear(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    for (size_t i = 0; i + 3 < pixels.size(); i += 4) {
+        pixels[i + 0] = r;
+        pixels[i + 1] = g;
+        pixels[i + 2] = b;
+        pixels[i + 3] = a;
+    }
+}
+
+int CountDifferingPixels(const SoftwareImage& a, const SoftwareImage& b, int tolerance) {
+    if (a.width != b.width || a.height != b.height) return (std::max)(a.width * a.height, b.width * b.height);
+    int differing = 0;
+    for (size_t i = 0; i < a.pixels.size(); i += 4) {
+        for (int c = 0; c < 4; c++) {
+            if (std::abs(static_cast<int>(a.pixels[i + c]) - static_cast<int>(b.pixels[i + c])) > tolerance) {
+                differing++;
+                break;
+            }
+        }
+    }
+    return differing;
+}
+
+void SoftwareRenderBackend::SetTexture(uint32_t name, int width, int height, const uint8_t* rgba) {
+    if (width <= 0 || height <= 0 || !rgba) return;
+    SoftwareImage& tex = m_textures[name];
+    tex.Resize(width, height);
+    std::memcpy(tex.pixels.data(), rgba, tex.pixels.size());
+}
+
+void SoftwareRenderBackend::Execute(const RenderCommandList& list, SoftwareImage& target) const {
+    if (target.width <= 0 || target.height <= 0) return;
+    const float W = static_cast<float>(target.width);
+    const float H = static_cast<float>(target.height);
+
+    for (const RenderCommand& cmd : list.Commands()) {
+        const RenderRect& r = cmd.rect;
+        if (r.x1 >= r.x2 || r.y1 >= r.y2) continue;
+
+        const SoftwareImage* tex = nullptr;
+        if (cmd.type == RenderCommandType::TexturedQuad || cmd.type == RenderCommandType::Text) {
+            auto it = m_textures.find(cmd.texture);
+            if (it == m_textures.end()) continue;
+            tex = &it->second;
+        }
+        GradientStopSpan stops;
+        GradientRamp ramp;
+        if (cmd.type == RenderCommandType::Gradient) {
+            stops = { list.GradientStops().data() + cmd.gradient.firstStop, static_cast<int>(cmd.gradient.stopCount) };
+            if (!m_gradientStopSearch) { BuildGradientRamp(stops, ramp); }
+        }
+
+        // Pixels whose centers lie in [x1, x2) x [y1, y2) of window space
+        const float wx1 = (r.x1 + 1.0f) * 0.5f * W, wx2 = (r.x2 + 1.0f) * 0.5f * W;
+        const float wy1 = (r.y1 + 1.0f) * 0.5f * H, wy2 = (r.y2 + 1.0f) * 0.5f * H;
+        const int px1 = (std::max)(0, static_cast<int>(std::ceil(wx1 - 0.5f)));
+        const int px2 = (std::min)(target.width, static_cast<int>(std::ceil(wx2 - 0.5f)));
+        const int py1 = (std::max)(0, static_cast<int>(std::ceil(wy1 - 0.5f)));
+        const int py2 = (std::min)(target.height, static_cast<int>(std::ceil(wy2 - 0.5f)));
+
+        for (int y = py1; y < py2; y++) {
+            const float fy = (y + 0.5f - wy1) / (wy2 - wy1);
+            const float v = cmd.uv.y1 + (cmd.uv.y2 - cmd.uv.y1) * fy;
+            for (int x = px1; x < px2; x++) {
+                const float fx = (x + 0.5f - wx1) / (wx2 - wx1);
+                const float u = cmd.uv.x1 + (cmd.uv.x2 - cmd.uv.x1) * fx;
+
+                Vec4 src;
+                switch (cmd.type) {
+                case RenderCommandType::SolidQuad:
+                    src = { cmd.color[0], cmd.color[1], cmd.color[2], cmd.color[3] };
+                    break;
+                case RenderCommandType::TexturedQuad: {
+                    const Vec4 c = Sample(*tex, u, v, cmd.filter);
+                    if (cmd.textured.colorKeyEnabled && KeyedOut(cmd.textured, c)) continue;
+                    src = { c.r, c.g, c.b, c.a * cmd.textured.opacity };
+                    break;
+                }
+                case RenderCommandType::Border:
+                    if (!ShadeBorder(cmd.border, u, v)) continue;
+                    src = { cmd.color[0], cmd.color[1], cmd.color[2], cmd.color[3] };
+                    break;
+                case RenderCommandType::Gradient: {
+                    const GradientColor c =
+                        m_gradientStopSearch ? GradientStopsShade(stops, cmd.gradient, u, v) : GradientRampShade(ramp, cmd.gradient, u, v);
+                    src = { c.r, c.g, c.b, c.a };
+                    break;
+                }
+                case RenderCommandType::Text: {
+                    const Vec4 c = Sample(*tex, u, v, cmd.filter);
+                    src = { cmd.color[0] * c.r, cmd.color[1] * c.g, cmd.color[2] * c.b, cmd.color[3] * c.a };
+                    break;
+                }
+                default:
+                    continue;
+                }
+                Blend(target.At(x, y), src, cmd.blend);
+            }
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+// ============================================================================
+// RENDER_COMMANDS_SW.H - CPU rasterizer for RenderCommandLists
+// ============================================================================
+// Executes a RenderCommandList into an RGBA8 image with the same semantics as the render thread's
+// GLSL programs and blend states, so layout, transitions and compositing produce reference images
+// on any platform. No GL headers are involved.
+//
+// Rasterization follows GL for axis-aligned quads: a pixel is covered when its center lies in
+// [x1, x2) x [y1, y2), attributes are interpolated at pixel centers, textures sample with
+// GL_CLAMP_TO_EDGE, and every blend result is rounded to 8 bits like an RGBA8 framebuffer.
+//
+// Images are tightly packed RGBA8 and stored bottom-up (row 0 = bottom), like GL textures.
+// ============================================================================
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "render_commands.h"
+
+struct SoftwareImage {
+    std::vector<uint8_t> pixels;
+    int width = 0, height = 0;
+
+    void Resize(int w, int h) {
+        width = w;
+        height = h;
+        pixels.assign(static_cast<size_t>(w) * h * 4, 0);
+    }
+    void Clear(uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+    uint8_t* At(int x, int y) { return &pixels[(static_cast<size_t>(y) * width + x) * 4]; }
+    const uint8_t* At(int x, int y) const { return &pixels[(static_cast<size_t>(y) * width + x) * 4]; }
+};
+
+// Pixels whose channels differ by more than `tolerance` (sizes must match; mismatched sizes count every pixel)
+int CountDifferingPixels(const SoftwareImage& a, const SoftwareImage& b, int tolerance);
+
+class SoftwareRenderBackend {
+  public:
+    // Textures are looked up by the GL name recorded in the command; `rgba` is bottom-up
+    void SetTexture(uint32_t name, int width, int height, const uint8_t* rgba);
+    void RemoveTexture(uint32_t name) { m_textures.erase(name); }
+    void ClearTextures() { m_textures.clear(); }
+
+    // Gradients are shaded from a baked ramp like the GL programs; true shades them with the per-stop
+    // search the programs used before ramps, to compare the two
+    void SetGradientStopSearch(bool enabled) { m_gradientStopSearch = enabled; }
+
+    // Commands referencing textures that were never set are skipped
+    void Execute(const RenderCommandList& list, SoftwareImage& target) const;
+
+  private:
+    std::unordered_map<uint32_t, SoftwareImage> m_textures;
+    bool m_gradientStopSearch = false;
+};
@@ -0,0 +1,293 @@
+#pragma once
+
+// ============================================================================
+// RENDER_SHADERS.H - GLSL sources of the render thread's programs
+// ============================================================================
+// Kept apart from render_thread.cpp so the headless GL tests (tests/) compile exactly the shaders the
+// render thread uses. Only render_thread.cpp includes this in the DLL.
+// ============================================================================
+
+static const char* const rt_solid_vert_shader = R"(#version 330 core
+layout(location = 0) in vec2 aPos;
+void main() {
+    gl_Position = vec4(aPos.x, aPos.y, 0.0, 1.0);
+})";
+
+static const char* const rt_passthrough_vert_shader = R"(#version 330 core
+layout(location = 0) in vec2 aPos;
+layout(location = 1) in vec2 aTexCoord;
+out vec2 TexCoord;
+void main() {
+    gl_Position = vec4(aPos, 0.0, 1.0);
+    TexCoord = aTexCoord;
+})";
+
+static const char* const rt_background_frag_shader = R"(#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+uniform sampler2D backgroundTexture;
+uniform float u_opacity;
+void main() {
+    vec4 texColor = texture(backgroundTexture, TexCoord);
+    FragColor = vec4(texColor.rgb, texColor.a * u_opacity);
+})";
+
+static const char* const rt_solid_color_frag_shader = R"(#version 330 core
+out vec4 FragColor;
+uniform vec4 u_color;
+void main() {
+    FragColor = u_color;
+})";
+
+static const char* const rt_image_render_frag_shader = R"(#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+
+uniform sampler2D imageTexture;
+uniform bool u_enableColorKey;
+uniform vec3 u_colorKey;
+uniform float u_sensitivity;
+uniform float u_opacity;
+
+void main() {
+    vec4 texColor = texture(imageTexture, TexCoord);
+
+    if (u_enableColorKey) {
+        vec3 linearTexColor = pow(texColor.rgb, vec3(2.2));
+        vec3 linearKeyColor = pow(u_colorKey, vec3(2.2));
+        float dist = distance(linearTexColor, linearKeyColor);
+        if (dist < u_sensitivity) {
+            discard;
+        }
+    }
+    
+    FragColor = vec4(texColor.rgb, texColor.a * u_opacity);
+})";
+
+// Static border shader - draws a border shape (rectangle or ellipse)
+// Uses SDF (Signed Distance Field) for smooth shape rendering
+// The quad is expanded by thickness on each side to accommodate borders
+// that extend outside the shape. The shader calculates the shape edge position
+// relative to the expanded quad.
+static const char* const rt_static_border_frag_shader = R"(#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+uniform int u_shape;         // 0=Rectangle (with optional rounded corners), 1=Circle/Ellipse
+uniform vec4 u_borderColor;
+uniform float u_thickness;   // Border thickness in pixels
+uniform float u_radius;      // Corner radius for Rectangle in pixels (0 = sharp corners)
+uniform vec2 u_size;         // BASE shape size (width/height) - NOT the expanded quad size
+uniform vec2 u_quadSize;     // Actual expanded quad size rendered by GPU
+
+// SDF for a rounded rectangle (works for sharp corners when r=0)
+float sdRoundedBox(vec2 p, vec2 b, float r) {
+    // Clamp radius to not exceed half of the smaller box dimension
+    float maxR = min(b.x, b.y);
+    r = clamp(r, 0.0, maxR);
+    vec2 q = abs(p) - b + r;
+    return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - r;
+}
+
+// SDF for an ellipse - proper signed distance approximation
+// Uses gradient-based correction for more accurate distance
+float sdEllipse(vec2 p, vec2 ab) {
+    // Normalize to unit circle space
+    vec2 pn = p / ab;
+    float len = length(pn);
+    if (len < 0.0001) return -min(ab.x, ab.y); // At center
+    
+    // Distance in normalized space
+    float d = len - 1.0;
+    
+    // Correct for the stretching using the gradient magnitude
+    // The gradient of the implicit function f(p) = |p/ab| - 1 is p/(ab^2 * |p/ab|)
+    // Its magnitude gives the local scaling factor
+    vec2 grad = pn / (ab * len);
+    float gradLen = length(grad);
+    
+    // Scale distance back to pixel space
+    return d / gradLen;
+}
+
+void main() {
+    // Map TexCoord (0-1) to pixel coordinates within the actual GPU quad
+    vec2 pixelPos = TexCoord * u_quadSize;
+    
+    // Offset so (0,0) is at the center of the quad
+    vec2 centeredPixelPos = pixelPos - u_quadSize * 0.5;
+    
+    // Calculate distance in pixels from the shape edge
+    // The shape has size u_size, centered at origin
+    // Ensure halfSize has a minimum value to avoid degenerate shapes
+    vec2 halfSize = max(u_size * 0.5, vec2(1.0, 1.0));
+    
+    float dist;
+    
+    if (u_shape == 0) {
+        // Rectangle (with optional rounded corners via u_radius)
+        dist = sdRoundedBox(centeredPixelPos, halfSize, u_radius);
+    } else {
+        // Circle/Ellipse
+        dist = sdEllipse(centeredPixelPos, halfSize);
+    }
+    
+    // Border is drawn at the shape edge (dist=0) outward to thickness
+    float innerEdge = 0.0;
+    float outerEdge = u_thickness;
+    
+    // Add small epsilon for floating-point precision at quad boundaries
+    // The SDF approximations can have slight errors, especially for ellipses
+    float epsilon = 0.5;
+    
+    if (dist >= innerEdge - epsilon && dist <= outerEdge + epsilon) {
+        FragColor = u_borderColor;
+    } else {
+        discard;
+    }
+})";
+
+// Gradient shader: each animation is a coordinate transform followed by one lookup in the baked ramp
+static const char* const rt_gradient_frag_shader = R"(#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+
+#define ANIM_NONE 0
+#define ANIM_ROTATE 1
+#define ANIM_SLIDE 2
+#define ANIM_WAVE 3
+#define ANIM_SPIRAL 4
+#define ANIM_FADE 5
+
+uniform sampler2D u_ramp; // Row 0 = clamped gradient, row 1 = seamless loop (gradient_ramp.h)
+uniform float u_angle; // radians (base angle)
+uniform float u_time;  // animation time in seconds
+uniform int u_animationType;
+uniform float u_animationSpeed;
+uniform bool u_colorFade;
+
+// Gradient at t, clamped to [0, 1]: texel centers run edge to edge
+vec4 rampClamped(float t) {
+    float texels = float(textureSize(u_ramp, 0).x);
+    return texture(u_ramp, vec2((clamp(t, 0.0, 1.0) * (texels - 1.0) + 0.5) / texels, 0.25));
+}
+
+// Seamless loop at fract(t), last stop blending back into the first; the sampler repeats horizontally
+vec4 rampWrapped(float t) {
+    float texels = float(textureSize(u_ramp, 0).x);
+    return texture(u_ramp, vec2(fract(t) + 0.5 / texels, 0.75));
+}
+
+// Gradient at t with optional time-based color cycling
+vec4 getGradientColor(float t, float timeOffset) {
+    if (u_colorFade) {
+        t = fract(t + timeOffset * 0.1);
+    }
+    return rampClamped(t);
+}
+
+void main() {
+    vec2 center = vec2(0.5, 0.5);
+    vec2 uv = TexCoord - center;
+    float timeOffset = u_time * u_animationSpeed;
+    
+    if (u_animationType == ANIM_NONE) {
+        // Static gradient
+        vec2 dir = vec2(cos(u_angle), sin(u_angle));
+        FragColor = getGradientColor(clamp(dot(uv, dir) + 0.5, 0.0, 1.0), timeOffset);
+    }
+    else if (u_animationType == ANIM_ROTATE) {
+        // Rotating gradient - angle changes over time
+        float effectiveAngle = u_angle + timeOffset;
+        vec2 dir = vec2(cos(effectiveAngle), sin(effectiveAngle));
+        FragColor = getGradientColor(clamp(dot(uv, dir) + 0.5, 0.0, 1.0), timeOffset);
+    }
+    else if (u_animationType == ANIM_SLIDE) {
+        // Sliding gradient - seamless scrolling along the gradient direction
+        vec2 dir = vec2(cos(u_angle), sin(u_angle));
+        FragColor = rampWrapped(dot(uv, dir) + 0.5 + timeOffset * 0.2);
+    }
+    else if (u_animationType == ANIM_WAVE) {
+        // Wave distortion - sine wave applied to gradient
+        vec2 dir = vec2(cos(u_angle), sin(u_angle));
+        vec2 perpDir = vec2(-sin(u_angle), cos(u_angle));
+        float perpPos = dot(uv, perpDir);
+        float wave = sin(perpPos * 8.0 + timeOffset * 2.0) * 0.08;
+        FragColor = getGradientColor(clamp(dot(uv, dir) + 0.5 + wave, 0.0, 1.0), timeOffset);
+    }
+    else if (u_animationType == ANIM_SPIRAL) {
+        // Spiral effect - colors spiral outward from center
+        float dist = length(uv) * 2.0;
+        float angle = atan(uv.y, uv.x);
+        FragColor = rampWrapped(dist + angle / 6.28318 - timeOffset * 0.3);
+    }
+    else if (u_animationType == ANIM_FADE) {
+        // Fade - solid color that smoothly cycles through all gradient stops
+        FragColor = rampWrapped(timeOffset * 0.1);
+    }
+    else {
+        FragColor = getGradientColor(0.0, timeOffset);
+    }
+})";
+
+// Glyph quads from a font atlas (RenderCommandType::Text), tinted like ImGui vertices
+static const char* const rt_text_frag_shader = R"(#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+uniform sampler2D fontTexture;
+uniform vec4 u_color;
+void main() {
+    FragColor = u_color * texture(fontTexture, TexCoord);
+})";
+
+// NOTE: Border rendering shaders (brute force and JFA) have been removed from render_thread.
+// All border rendering is now done by mirror_thread.cpp which has its own local shader programs.
+// Render thread just blits the pre-rendered finalTexture using the passthrough/background shader.
+
+// RGBA->NV12 compute shader using Rec. 709 coefficients
+// Reads from a sampler2D, writes NV12 (Y plane + interleaved UV plane) to an SSBO
+// Optimized NV12 compute shader: writes Y plane as r8ui image (no atomics)
+// UV plane is written to a separate r8ui image by even-coordinate threads only
+static const char* const rt_nv12_compute_shader = R"(
+#version 430
+layout(local_size_x = 16, local_size_y = 16) in;
+
+uniform sampler2D u_rgbaTexture;
+uniform uint u_width;
+uniform uint u_height;
+
+// Y plane: width x height, each pixel is one luma byte
+layout(r8ui, binding = 0) uniform writeonly uimage2D u_yPlane;
+// UV plane: width x (height/2), interleaved U,V pairs stored as bytes
+layout(r8ui, binding = 1) uniform writeonly uimage2D u_uvPlane;
+
+void main() {
+    uvec2 pos = gl_GlobalInvocationID.xy;
+    if (pos.x >= u_width || pos.y >= u_height) return;
+
+    // Flip Y: OpenGL bottom-up -> NV12 top-down
+    uint srcY = u_height - 1u - pos.y;
+    vec4 rgba = texelFetch(u_rgbaTexture, ivec2(pos.x, srcY), 0);
+
+    // Rec. 709 RGB->Y (limited range 16-235)
+    float Y = 0.1826 * rgba.r + 0.6142 * rgba.g + 0.0620 * rgba.b + 0.0625;
+    imageStore(u_yPlane, ivec2(pos.x, pos.y), uvec4(uint(clamp(Y * 255.0, 0.0, 255.0)), 0u, 0u, 0u));
+
+    // UV plane: only even-coordinate threads (2x2 subsampling)
+    if ((pos.x & 1u) == 0u && (pos.y & 1u) == 0u) {
+        // Average 2x2 block for chroma
+        vec4 p10 = texelFetch(u_rgbaTexture, ivec2(pos.x + 1u, srcY), 0);
+        vec4 p01 = texelFetch(u_rgbaTexture, ivec2(pos.x, srcY - 1u), 0);
+        vec4 p11 = texelFetch(u_rgbaTexture, ivec2(pos.x + 1u, srcY - 1u), 0);
+        vec4 avg = (rgba + p10 + p01 + p11) * 0.25;
+
+        // Rec. 709 RGB->Cb,Cr (limited range 16-240)
+        float U = -0.1006 * avg.r - 0.3386 * avg.g + 0.4392 * avg.b + 0.5;
+        float V =  0.4392 * avg.r - 0.3989 * avg.g - 0.0403 * avg.b + 0.5;
+
+        // UV plane: row = pos.y/2, columns = pos.x (U) and pos.x+1 (V)
+        uint uvRow = pos.y >> 1u;
+        imageStore(u_uvPlane, ivec2(pos.x, uvRow), uvec4(uint(clamp(U * 255.0, 0.0, 255.0)), 0u, 0u, 0u));
+        imageStore(u_uvPlane, ivec2(pos.x + 1u, uvRow), uvec4(uint(clamp(V * 255.0, 0.0, 255.0)), 0u, 0u, 0u));
+    }
+}
+)";
@@ -1,13 +1,23 @@
 #include "render_thread.h"
+#include "eyezoom_layout.h"
 #include "fake_cursor.h"
+#include "gpu_resources.h"
 #include "gui.h"
 #include "imgui_input_queue.h"
 #include "mirror_thread.h"
+#include "mode_render_list.h"
 #include "obs_thread.h"
+#include "overlay_layers.h"
+#include "overlay_stack_key.h"
 #include "profiler.h"
+#include "program_cache.h"
 #include "render.h"
+#include "render_commands.h"
+#include "render_shaders.h"
+#include "seqlock_mailbox.h"
 #include "shared_contexts.h"
 #include "stb_image.h"
+#include "streaming_upload.h"
 #include "utils.h"
 #include "virtual_camera.h"
 #include "window_overlay.h"
@@ -142,28 +152,14 @@ static GLint g_vcLocRgbaTexture = -1;
 static GLint g_vcLocWidth = -1;
 static GLint g_vcLocHeight = -1;
 
-// Double-buffered request queue: main thread writes to one slot, render thread reads from other
-// This allows lock-free submission - main thread never blocks waiting for render thread
-static FrameRenderRequest g_requestSlots[2];
-static std::atomic<int> g_requestWriteSlot{ 0 };    // Slot main thread writes to next
-// IMPORTANT: FrameRenderRequest contains non-trivial types (std::string). With only 2 slots,
-// the producer can lap and overwrite the slot the render thread is currently copying from
-// (e.g. at very high FPS), which is a C++ data race and can manifest as a 1-frame "missing overlay".
-// We mark the slot being copied so the producer can avoid it.
-static std::atomic<int> g_requestReadSlot{ -1 };    // Slot currently being copied by render thread (-1 = none)
-// Mailbox: which slot currently contains the newest request ready to consume (-1 = none).
-// Producer stores with release AFTER fully writing the struct. Consumer exchanges with acq_rel
-// to guarantee it never copies a partially-written struct.
-static std::atomic<int> g_requestReadySlot{ -1 };
-static std::mutex g_requestSignalMutex;             // Only for CV signaling, not data protection
+// Latest-value mailboxes: the main thread overwrites without ever blocking, the render thread takes
+// the newest request. Both payloads are trivially copyable (mode IDs are interned handles), so a
+// seqlock replaces the old double-buffered slots and their read-slot bookkeeping.
+static SeqlockMailbox<FrameRenderRequest> g_requestMailbox;
+static SeqlockMailbox<ObsFrameSubmission> g_obsMailbox;
+static std::mutex g_requestSignalMutex; // Only for CV signaling, not data protection
 static std::condition_variable g_requestCV;
 
-// Double-buffered OBS submission (same pattern)
-static ObsFrameSubmission g_obsSubmissionSlots[2];
-static std::atomic<int> g_obsWriteSlot{ 0 };
-static std::atomic<int> g_obsReadSlot{ -1 }; // Slot currently being copied by render thread (-1 = none)
-static std::atomic<int> g_obsReadySlot{ -1 }; // Mailbox slot for newest OBS submission (-1 = none)
-
 static std::mutex g_completionMutex;
 static std::condition_variable g_completionCV;
 static std::atomic<bool> g_frameComplete{ false };
@@ -172,12 +168,50 @@ static std::mutex g_obsCompletionMutex;
 static std::condition_variable g_obsCompletionCV;
 static std::atomic<bool> g_obsFrameComplete{ false };
 
-// Captured when stable in EyeZoom mode, used during transition-out animation
-static GLuint rt_eyeZoomSnapshotTexture = 0;
-static GLuint rt_eyeZoomSnapshotFBO = 0;
-static int rt_eyeZoomSnapshotWidth = 0;
-static int rt_eyeZoomSnapshotHeight = 0;
-static bool rt_eyeZoomSnapshotValid = false;
+// EyeZoom state per pass ([0] = on-screen, [1] = OBS). The resolve texture holds the source pixels of the
+// magnified column, copied 1:1 from the game frame; the strip is magnified from it, and it stays frozen while
+// transitioning out of EyeZoom. The overlay (boxes, center line, numbers) is laid out once per settings, strip
+// size and font, and kept pre-rendered at strip size in overlayLayer.
+struct RT_EyeZoomPass {
+    GLuint resolveTexture = 0;
+    GLuint resolveFBO = 0;
+    int resolveWidth = 0;
+    int resolveHeight = 0;
+    bool resolveValid = false;
+
+    uint64_t overlayKey = 0;
+    bool overlayLaidOut = false;
+    EyeZoomOverlay overlay;
+    RetainedOverlayLayer overlayLayer;
+};
+static RT_EyeZoomPass rt_eyeZoomPasses[2];
+
+// Compiled overlay lists per (snapshot, mode, screen size, visibility toggles) - render thread only
+static ModeRenderListCache rt_modeRenderLists;
+
+// Retained image-overlay layer per pass ([0] = on-screen, [1] = OBS). The list each layer was last hashed
+// with is kept alive so its address (part of the hash) cannot be reused by a different list.
+static RetainedOverlayLayer rt_imageLayers[2];
+static std::shared_ptr<const ModeRenderList> rt_imageLayerLists[2];
+
+// Keyframe timeline clock per pass ([0] = on-screen, [1] = OBS): a mode's overlay timelines run from when the
+// pass switched to it. A pass switching to the mode the other pass already shows takes over its start, so
+// both passes sample the same time and can still share one overlay stack.
+struct RT_OverlayTimelineClock {
+    ModeIdHandle mode = MODE_ID_NONE;
+    std::chrono::steady_clock::time_point start;
+};
+static RT_OverlayTimelineClock rt_overlayTimelineClocks[2];
+
+// Overlay stack rendered by the OBS pass for the on-screen pass of the same iteration to composite
+// (see HashOverlayStack). Invalidated after every iteration: mirror and window contents change each frame.
+static RetainedOverlayLayer rt_sharedOverlayStack;
+
+// Upload ring shared with producer threads; created and closed by the render thread, the mutex only guards
+// the pointer. Sized for a few window-overlay frames in flight at 1080p.
+static constexpr size_t STREAMING_UPLOAD_RING_BYTES = 64u * 1024u * 1024u;
+static std::mutex g_streamingUploadsMutex;
+static std::shared_ptr<StreamingUploadRing> g_streamingUploads;
 
 static std::atomic<uint64_t> g_framesRendered{ 0 };
 static std::atomic<uint64_t> g_framesDropped{ 0 };
@@ -196,6 +230,7 @@ static ImFont* g_eyeZoomTextFont = nullptr;
 static std::string g_eyeZoomFontPathCached = "";
 static float g_eyeZoomScaleFactor = 1.0f;
 static bool g_fontsValid = false; // True when font atlas is built and texture is uploaded; false during rebuild
+static uint64_t g_fontGeneration = 0; // Bumped whenever g_fontsValid becomes true, so layouts using old glyphs are redone
 
 // Font loading can fail or behave inconsistently with some font files.
 // We treat any font that can't be built reliably as invalid and fall back to Arial.
@@ -309,6 +344,7 @@ static bool RT_TryInitializeImGui(HWND hwnd, const Config& cfg) {
     }
 
     g_fontsValid = true;
+    g_fontGeneration++;
     g_renderThreadImGuiInitialized = true;
     LogCategory("init", "Render Thread: ImGui initialized successfully");
     return true;
@@ -316,372 +352,14 @@ static bool RT_TryInitializeImGui(HWND hwnd, const Config& cfg) {
 
 // RENDER THREAD SHADER PROGRAMS
 // These shaders are created on the render thread context (not shared with main thread)
-
-static const char* rt_solid_vert_shader = R"(#version 330 core
-layout(location = 0) in vec2 aPos;
-void main() {
-    gl_Position = vec4(aPos.x, aPos.y, 0.0, 1.0);
-})";
-
-static const char* rt_passthrough_vert_shader = R"(#version 330 core
-layout(location = 0) in vec2 aPos;
-layout(location = 1) in vec2 aTexCoord;
-out vec2 TexCoord;
-void main() {
-    gl_Position = vec4(aPos, 0.0, 1.0);
-    TexCoord = aTexCoord;
-})";
-
-static const char* rt_background_frag_shader = R"(#version 330 core
-out vec4 FragColor;
-in vec2 TexCoord;
-uniform sampler2D backgroundTexture;
-uniform float u_opacity;
-void main() {
-    vec4 texColor = texture(backgroundTexture, TexCoord);
-    FragColor = vec4(texColor.rgb, texColor.a * u_opacity);
-})";
-
-static const char* rt_solid_color_frag_shader = R"(#version 330 core
-out vec4 FragColor;
-uniform vec4 u_color;
-void main() {
-    FragColor = u_color;
-})";
-
-static const char* rt_image_render_frag_shader = R"(#version 330 core
-out vec4 FragColor;
-in vec2 TexCoord;
-
-uniform sampler2D imageTexture;
-uniform bool u_enableColorKey;
-uniform vec3 u_colorKey;
-uniform float u_sensitivity;
-uniform float u_opacity;
-
-void main() {
-    vec4 texColor = texture(imageTexture, TexCoord);
-
-    if (u_enableColorKey) {
-        vec3 linearTexColor = pow(texColor.rgb, vec3(2.2));
-        vec3 linearKeyColor = pow(u_colorKey, vec3(2.2));
-        float dist = distance(linearTexColor, linearKeyColor);
-        if (dist < u_sensitivity) {
-            discard;
-        }
-    }
-    
-    FragColor = vec4(texColor.rgb, texColor.a * u_opacity);
-})";
-
-// Static border shader - draws a border shape (rectangle or ellipse)
-// Uses SDF (Signed Distance Field) for smooth shape rendering
-// The quad is expanded by thickness on each side to accommodate borders
-// that extend outside the shape. The shader calculates the shape edge position
-// relative to the expanded quad.
-static const char* rt_static_border_frag_shader = R"(#version 330 core
-out vec4 FragColor;
-in vec2 TexCoord;
-uniform int u_shape;         // 0=Rectangle (with optional rounded corners), 1=Circle/Ellipse
-uniform vec4 u_borderColor;
-uniform float u_thickness;   // Border thickness in pixels
-uniform float u_radius;      // Corner radius for Rectangle in pixels (0 = sharp corners)
-uniform vec2 u_size;         // BASE shape size (width/height) - NOT the expanded quad size
-uniform vec2 u_quadSize;     // Actual expanded quad size rendered by GPU
-
-// SDF for a rounded rectangle (works for sharp corners when r=0)
-float sdRoundedBox(vec2 p, vec2 b, float r) {
-    // Clamp radius to not exceed half of the smaller box dimension
-    float maxR = min(b.x, b.y);
-    r = clamp(r, 0.0, maxR);
-    vec2 q = abs(p) - b + r;
-    return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - r;
-}
-
-// SDF for an ellipse - proper signed distance approximation
-// Uses gradient-based correction for more accurate distance
-float sdEllipse(vec2 p, vec2 ab) {
-    // Normalize to unit circle space
-    vec2 pn = p / ab;
-    float len = length(pn);
-    if (len < 0.0001) return -min(ab.x, ab.y); // At center
-    
-    // Distance in normalized space
-    float d = len - 1.0;
-    
-    // Correct for the stretching using the gradient magnitude
-    // The gradient of the implicit function f(p) = |p/ab| - 1 is p/(ab^2 * |p/ab|)
-    // Its magnitude gives the local scaling factor
-    vec2 grad = pn / (ab * len);
-    float gradLen = length(grad);
-    
-    // Scale distance back to pixel space
-    return d / gradLen;
-}
-
-void main() {
-    // Map TexCoord (0-1) to pixel coordinates within the actual GPU quad
-    vec2 pixelPos = TexCoord * u_quadSize;
-    
-    // Offset so (0,0) is at the center of the quad
-    vec2 centeredPixelPos = pixelPos - u_quadSize * 0.5;
-    
-    // Calculate distance in pixels from the shape edge
-    // The shape has size u_size, centered at origin
-    // Ensure halfSize has a minimum value to avoid degenerate shapes
-    vec2 halfSize = max(u_size * 0.5, vec2(1.0, 1.0));
-    
-    float dist;
-    
-    if (u_shape == 0) {
-        // Rectangle (with optional rounded corners via u_radius)
-        dist = sdRoundedBox(centeredPixelPos, halfSize, u_radius);
-    } else {
-        // Circle/Ellipse
-        dist = sdEllipse(centeredPixelPos, halfSize);
-    }
-    
-    // Border is drawn at the shape edge (dist=0) outward to thickness
-    float innerEdge = 0.0;
-    float outerEdge = u_thickness;
-    
-    // Add small epsilon for floating-point precision at quad boundaries
-    // The SDF approximations can have slight errors, especially for ellipses
-    float epsilon = 0.5;
-    
-    if (dist >= innerEdge - epsilon && dist <= outerEdge + epsilon) {
-        FragColor = u_borderColor;
-    } else {
-        discard;
-    }
-})";
-
-// Gradient shader for multi-stop linear gradients with angle and animation support
-static const char* rt_gradient_frag_shader = R"(#version 330 core
-out vec4 FragColor;
-in vec2 TexCoord;
-
-#define MAX_STOPS 8
-#define ANIM_NONE 0
-#define ANIM_ROTATE 1
-#define ANIM_SLIDE 2
-#define ANIM_WAVE 3
-#define ANIM_SPIRAL 4
-#define ANIM_FADE 5
-
-uniform int u_numStops;
-uniform vec4 u_stopColors[MAX_STOPS];
-uniform float u_stopPositions[MAX_STOPS];
-uniform float u_angle; // radians (base angle)
-uniform float u_time;  // animation time in seconds
-uniform int u_animationType;
-uniform float u_animationSpeed;
-uniform bool u_colorFade;
-
-// Get color at position t (0-1) with seamless wrapping for slide animation
-vec4 getGradientColorSeamless(float t) {
-    // Wrap t to 0-1 range
-    t = fract(t);
-    
-    // For seamless tiling, we treat the gradient as a loop:
-    // The gradient goes from first stop to last stop, then blends back to first
-    // We remap t so that the full 0-1 range covers stops AND the wrap-around blend
-    
-    // Find position in extended gradient (including wrap segment)
-    float lastPos = u_stopPositions[u_numStops - 1];
-    float firstPos = u_stopPositions[0];
-    float wrapSize = (1.0 - lastPos) + firstPos; // Size of wrap-around segment
-    
-    if (t <= firstPos && wrapSize > 0.001) {
-        // In the wrap-around blend zone (before first stop)
-        float wrapT = (firstPos - t) / wrapSize;
-        return mix(u_stopColors[0], u_stopColors[u_numStops - 1], wrapT);
-    }
-    else if (t >= lastPos && wrapSize > 0.001) {
-        // In the wrap-around blend zone (after last stop)
-        float wrapT = (t - lastPos) / wrapSize;
-        return mix(u_stopColors[u_numStops - 1], u_stopColors[0], wrapT);
-    }
-    
-    // Normal gradient interpolation between stops
-    vec4 color = u_stopColors[0];
-    for (int i = 0; i < u_numStops - 1; i++) {
-        if (t >= u_stopPositions[i] && t <= u_stopPositions[i + 1]) {
-            float segmentT = (t - u_stopPositions[i]) / max(u_stopPositions[i + 1] - u_stopPositions[i], 0.0001);
-            color = mix(u_stopColors[i], u_stopColors[i + 1], segmentT);
-            break;
-        }
-    }
-    return color;
-}
-
-// Get color at position t with optional time-based color cycling
-vec4 getGradientColor(float t, float timeOffset) {
-    // Apply color fade - shifts all stop positions over time
-    float adjustedT = t;
-    if (u_colorFade) {
-        adjustedT = fract(t + timeOffset * 0.1);
-    }
-    adjustedT = clamp(adjustedT, 0.0, 1.0);
-    
-    // Find which segment we're in and interpolate
-    vec4 color = u_stopColors[0];
-    for (int i = 0; i < u_numStops - 1; i++) {
-        if (adjustedT >= u_stopPositions[i] && adjustedT <= u_stopPositions[i + 1]) {
-            float segmentT = (adjustedT - u_stopPositions[i]) / max(u_stopPositions[i + 1] - u_stopPositions[i], 0.0001);
-            color = mix(u_stopColors[i], u_stopColors[i + 1], segmentT);
-            break;
-        }
-    }
-    // Handle edge cases (beyond last stop)
-    if (adjustedT >= u_stopPositions[u_numStops - 1]) {
-        color = u_stopColors[u_numStops - 1];
-    }
-    return color;
-}
-
-// Get solid color that cycles through gradient stops over time
-vec4 getFadeColor(float timeOffset) {
-    // Cycle through stops: time maps to position in color sequence
-    float cyclePos = fract(timeOffset * 0.1); // Speed of cycling
-    
-    // Find which segment we're in and interpolate smoothly
-    vec4 color = u_stopColors[0];
-    for (int i = 0; i < u_numStops - 1; i++) {
-        if (cyclePos >= u_stopPositions[i] && cyclePos <= u_stopPositions[i + 1]) {
-            float segmentT = (cyclePos - u_stopPositions[i]) / max(u_stopPositions[i + 1] - u_stopPositions[i], 0.0001);
-            color = mix(u_stopColors[i], u_stopColors[i + 1], segmentT);
-            break;
-        }
-    }
-    // Wrap around: blend from last color back to first
-    if (cyclePos > u_stopPositions[u_numStops - 1]) {
-        float wrapRange = 1.0 - u_stopPositions[u_numStops - 1] + u_stopPositions[0];
-        float wrapT = (cyclePos - u_stopPositions[u_numStops - 1]) / max(wrapRange, 0.0001);
-        color = mix(u_stopColors[u_numStops - 1], u_stopColors[0], wrapT);
-    }
-    else if (cyclePos < u_stopPositions[0]) {
-        float wrapRange = 1.0 - u_stopPositions[u_numStops - 1] + u_stopPositions[0];
-        float wrapT = (u_stopPositions[0] - cyclePos) / max(wrapRange, 0.0001);
-        color = mix(u_stopColors[0], u_stopColors[u_numStops - 1], wrapT);
-    }
-    return color;
-}
-
-void main() {
-    vec2 center = vec2(0.5, 0.5);
-    vec2 uv = TexCoord - center;
-    float effectiveAngle = u_angle;
-    float t = 0.0;
-    float timeOffset = u_time * u_animationSpeed;
-    
-    if (u_animationType == ANIM_NONE) {
-        // Static gradient - original behavior
-        vec2 dir = vec2(cos(u_angle), sin(u_angle));
-        t = dot(uv, dir) + 0.5;
-        t = clamp(t, 0.0, 1.0);
-        FragColor = getGradientColor(t, timeOffset);
-    }
-    else if (u_animationType == ANIM_ROTATE) {
-        // Rotating gradient - angle changes over time
-        effectiveAngle = u_angle + timeOffset;
-        vec2 dir = vec2(cos(effectiveAngle), sin(effectiveAngle));
-        t = dot(uv, dir) + 0.5;
-        t = clamp(t, 0.0, 1.0);
-        FragColor = getGradientColor(t, timeOffset);
-    }
-    else if (u_animationType == ANIM_SLIDE) {
-        // Sliding gradient - seamless scrolling along the gradient direction
-        vec2 dir = vec2(cos(u_angle), sin(u_angle));
-        t = dot(uv, dir) + 0.5;
-        t = t + timeOffset * 0.2; // Shift position over time
-        FragColor = getGradientColorSeamless(t);
-    }
-    else if (u_animationType == ANIM_WAVE) {
-        // Wave distortion - sine wave applied to gradient
-        vec2 dir = vec2(cos(u_angle), sin(u_angle));
-        vec2 perpDir = vec2(-sin(u_angle), cos(u_angle));
-        float perpPos = dot(uv, perpDir);
-        float wave = sin(perpPos * 8.0 + timeOffset * 2.0) * 0.08;
-        t = dot(uv, dir) + 0.5 + wave;
-        t = clamp(t, 0.0, 1.0);
-        FragColor = getGradientColor(t, timeOffset);
-    }
-    else if (u_animationType == ANIM_SPIRAL) {
-        // Spiral effect - colors spiral outward from center
-        float dist = length(uv) * 2.0;
-        float angle = atan(uv.y, uv.x);
-        t = dist + angle / 6.28318 - timeOffset * 0.3;
-        FragColor = getGradientColorSeamless(t);
-    }
-    else if (u_animationType == ANIM_FADE) {
-        // Fade - solid color that smoothly cycles through all gradient stops
-        FragColor = getFadeColor(timeOffset);
-    }
-    else {
-        t = clamp(t, 0.0, 1.0);
-        FragColor = getGradientColor(t, timeOffset);
-    }
-})";
-
-// NOTE: Border rendering shaders (brute force and JFA) have been removed from render_thread.
-// All border rendering is now done by mirror_thread.cpp which has its own local shader programs.
-// Render thread just blits the pre-rendered finalTexture using the passthrough/background shader.
-
-// RGBA->NV12 compute shader using Rec. 709 coefficients
-// Reads from a sampler2D, writes NV12 (Y plane + interleaved UV plane) to an SSBO
-// Optimized NV12 compute shader: writes Y plane as r8ui image (no atomics)
-// UV plane is written to a separate r8ui image by even-coordinate threads only
-static const char* rt_nv12_compute_shader = R"(
-#version 430
-layout(local_size_x = 16, local_size_y = 16) in;
-
-uniform sampler2D u_rgbaTexture;
-uniform uint u_width;
-uniform uint u_height;
-
-// Y plane: width x height, each pixel is one luma byte
-layout(r8ui, binding = 0) uniform writeonly uimage2D u_yPlane;
-// UV plane: width x (height/2), interleaved U,V pairs stored as bytes
-layout(r8ui, binding = 1) uniform writeonly uimage2D u_uvPlane;
-
-void main() {
-    uvec2 pos = gl_GlobalInvocationID.xy;
-    if (pos.x >= u_width || pos.y >= u_height) return;
-
-    // Flip Y: OpenGL bottom-up -> NV12 top-down
-    uint srcY = u_height - 1u - pos.y;
-    vec4 rgba = texelFetch(u_rgbaTexture, ivec2(pos.x, srcY), 0);
-
-    // Rec. 709 RGB->Y (limited range 16-235)
-    float Y = 0.1826 * rgba.r + 0.6142 * rgba.g + 0.0620 * rgba.b + 0.0625;
-    imageStore(u_yPlane, ivec2(pos.x, pos.y), uvec4(uint(clamp(Y * 255.0, 0.0, 255.0)), 0u, 0u, 0u));
-
-    // UV plane: only even-coordinate threads (2x2 subsampling)
-    if ((pos.x & 1u) == 0u && (pos.y & 1u) == 0u) {
-        // Average 2x2 block for chroma
-        vec4 p10 = texelFetch(u_rgbaTexture, ivec2(pos.x + 1u, srcY), 0);
-        vec4 p01 = texelFetch(u_rgbaTexture, ivec2(pos.x, srcY - 1u), 0);
-        vec4 p11 = texelFetch(u_rgbaTexture, ivec2(pos.x + 1u, srcY - 1u), 0);
-        vec4 avg = (rgba + p10 + p01 + p11) * 0.25;
-
-        // Rec. 709 RGB->Cb,Cr (limited range 16-240)
-        float U = -0.1006 * avg.r - 0.3386 * avg.g + 0.4392 * avg.b + 0.5;
-        float V =  0.4392 * avg.r - 0.3989 * avg.g - 0.0403 * avg.b + 0.5;
-
-        // UV plane: row = pos.y/2, columns = pos.x (U) and pos.x+1 (V)
-        uint uvRow = pos.y >> 1u;
-        imageStore(u_uvPlane, ivec2(pos.x, uvRow), uvec4(uint(clamp(U * 255.0, 0.0, 255.0)), 0u, 0u, 0u));
-        imageStore(u_uvPlane, ivec2(pos.x + 1u, uvRow), uvec4(uint(clamp(V * 255.0, 0.0, 255.0)), 0u, 0u, 0u));
-    }
-}
-)";
+// Sources: render_shaders.h
 
 static GLuint rt_backgroundProgram = 0;
 static GLuint rt_solidColorProgram = 0;
 static GLuint rt_imageRenderProgram = 0;
 static GLuint rt_staticBorderProgram = 0;
 static GLuint rt_gradientProgram = 0;
+static GLuint rt_textProgram = 0;
 
 struct RT_BackgroundShaderLocs {
     GLint backgroundTexture = -1;
@@ -705,9 +383,7 @@ struct RT_StaticBorderShaderLocs {
 };
 
 struct RT_GradientShaderLocs {
-    GLint numStops = -1;
-    GLint stopColors = -1;
-    GLint stopPositions = -1;
+    GLint ramp = -1;
     GLint angle = -1;
     GLint time = -1;
     GLint animationType = -1;
@@ -715,11 +391,18 @@ struct RT_GradientShaderLocs {
     GLint colorFade = -1;
 };
 
+struct RT_TextShaderLocs {
+    GLint fontTexture = -1;
+    GLint color = -1;
+};
+
 static RT_BackgroundShaderLocs rt_backgroundShaderLocs;
 static RT_SolidColorShaderLocs rt_solidColorShaderLocs;
 static RT_ImageRenderShaderLocs rt_imageRenderShaderLocs;
 static RT_StaticBorderShaderLocs rt_staticBorderShaderLocs;
 static RT_GradientShaderLocs rt_gradientShaderLocs;
+static GradientRampTextures rt_gradientRamps; // Render thread context
+static RT_TextShaderLocs rt_textShaderLocs;
 
 static GLuint RT_CompileShader(GLenum type, const char* source) {
     GLuint shader = glCreateShader(type);
@@ -738,12 +421,17 @@ static GLuint RT_CompileShader(GLenum type, const char* source) {
 }
 
 static GLuint RT_CreateShaderProgram(const char* vert, const char* frag) {
+    const char* sources[] = { vert, frag };
+    const ProgramCacheKey cacheKey = MakeProgramCacheKeyForCurrentContext(sources, 2);
+    if (GLuint cached = LoadCachedProgram(cacheKey)) return cached;
+
     GLuint v = RT_CompileShader(GL_VERTEX_SHADER, vert);
     GLuint f = RT_CompileShader(GL_FRAGMENT_SHADER, frag);
     if (v == 0 || f == 0) return 0;
     GLuint p = glCreateProgram();
     glAttachShader(p, v);
     glAttachShader(p, f);
+    PrepareProgramForCache(p);
     glLinkProgram(p);
     GLint ok;
     glGetProgramiv(p, GL_LINK_STATUS, &ok);
@@ -753,6 +441,8 @@ static GLuint RT_CreateShaderProgram(const char* vert, const char* frag) {
         Log("RenderThread: Shader link failed: " + std::string(log));
         glDeleteProgram(p);
         p = 0;
+    } else {
+        StoreCachedProgram(cacheKey, p);
     }
     glDeleteShader(v);
     glDeleteShader(f);
@@ -761,10 +451,14 @@ static GLuint RT_CreateShaderProgram(const char* vert, const char* frag) {
 
 // Create a compute shader program from a single compute shader source
 static GLuint RT_CreateComputeProgram(const char* src) {
+    const ProgramCacheKey cacheKey = MakeProgramCacheKeyForCurrentContext(&src, 1);
+    if (GLuint cached = LoadCachedProgram(cacheKey)) return cached;
+
     GLuint cs = RT_CompileShader(GL_COMPUTE_SHADER, src);
     if (cs == 0) return 0;
     GLuint p = glCreateProgram();
     glAttachShader(p, cs);
+    PrepareProgramForCache(p);
     glLinkProgram(p);
     GLint ok;
     glGetProgramiv(p, GL_LINK_STATUS, &ok);
@@ -774,6 +468,8 @@ static GLuint RT_CreateComputeProgram(const char* src) {
         Log("RenderThread: Compute shader link failed: " + std::string(log));
         glDeleteProgram(p);
         p = 0;
+    } else {
+        StoreCachedProgram(cacheKey, p);
     }
     glDeleteShader(cs);
     return p;
@@ -781,6 +477,7 @@ static GLuint RT_CreateComputeProgram(const char* src) {
 
 static bool RT_InitializeShaders() {
     LogCategory("init", "RenderThread: Initializing shaders...");
+    ScopedProgramCacheReport cacheReport("RenderThread");
 
     // NOTE: Border rendering shaders have been removed - all border rendering is done by mirror_thread
     // Render thread only needs: background (for mirror blitting), solid color (for game borders), image render, static border, and gradient
@@ -789,8 +486,10 @@ static bool RT_InitializeShaders() {
     rt_imageRenderProgram = RT_CreateShaderProgram(rt_passthrough_vert_shader, rt_image_render_frag_shader);
     rt_staticBorderProgram = RT_CreateShaderProgram(rt_passthrough_vert_shader, rt_static_border_frag_shader);
     rt_gradientProgram = RT_CreateShaderProgram(rt_passthrough_vert_shader, rt_gradient_frag_shader);
+    rt_textProgram = RT_CreateShaderProgram(rt_passthrough_vert_shader, rt_text_frag_shader);
 
-    if (!rt_backgroundProgram || !rt_solidColorProgram || !rt_imageRenderProgram || !rt_staticBorderProgram || !rt_gradientProgram) {
+    if (!rt_backgroundProgram || !rt_solidColorProgram || !rt_imageRenderProgram || !rt_staticBorderProgram || !rt_gradientProgram ||
+        !rt_textProgram) {
         Log("RenderThread: FATAL - Failed to create shader programs");
         return false;
     }
@@ -835,15 +534,16 @@ static bool RT_InitializeShaders() {
     rt_imageRenderShaderLocs.opacity = glGetUniformLocation(rt_imageRenderProgram, "u_opacity");
 
     // Gradient shader uniforms
-    rt_gradientShaderLocs.numStops = glGetUniformLocation(rt_gradientProgram, "u_numStops");
-    rt_gradientShaderLocs.stopColors = glGetUniformLocation(rt_gradientProgram, "u_stopColors");
-    rt_gradientShaderLocs.stopPositions = glGetUniformLocation(rt_gradientProgram, "u_stopPositions");
+    rt_gradientShaderLocs.ramp = glGetUniformLocation(rt_gradientProgram, "u_ramp");
     rt_gradientShaderLocs.angle = glGetUniformLocation(rt_gradientProgram, "u_angle");
     rt_gradientShaderLocs.time = glGetUniformLocation(rt_gradientProgram, "u_time");
     rt_gradientShaderLocs.animationType = glGetUniformLocation(rt_gradientProgram, "u_animationType");
     rt_gradientShaderLocs.animationSpeed = glGetUniformLocation(rt_gradientProgram, "u_animationSpeed");
     rt_gradientShaderLocs.colorFade = glGetUniformLocation(rt_gradientProgram, "u_colorFade");
 
+    rt_textShaderLocs.fontTexture = glGetUniformLocation(rt_textProgram, "fontTexture");
+    rt_textShaderLocs.color = glGetUniformLocation(rt_textProgram, "u_color");
+
     // Set texture sampler uniforms once
     glUseProgram(rt_backgroundProgram);
     glUniform1i(rt_backgroundShaderLocs.backgroundTexture, 0);
@@ -852,6 +552,12 @@ static bool RT_InitializeShaders() {
     glUseProgram(rt_imageRenderProgram);
     glUniform1i(rt_imageRenderShaderLocs.imageTexture, 0);
 
+    glUseProgram(rt_textProgram);
+    glUniform1i(rt_textShaderLocs.fontTexture, 0);
+
+    glUseProgram(rt_gradientProgram);
+    glUniform1i(rt_gradientShaderLocs.ramp, 0);
+
     glUseProgram(0);
 
     LogCategory("init", "RenderThread: Shaders initialized successfully");
@@ -875,6 +581,133 @@ static void RT_CleanupShaders() {
         glDeleteProgram(rt_gradientProgram);
         rt_gradientProgram = 0;
     }
+    rt_gradientRamps.Release();
+    if (rt_textProgram) {
+        glDeleteProgram(rt_textProgram);
+        rt_textProgram = 0;
+    }
+}
+
+static void RT_ApplyBlendMode(RenderBlendMode blend) {
+    switch (blend) {
+    case RenderBlendMode::Opaque:
+        glDisable(GL_BLEND);
+        return;
+    case RenderBlendMode::Alpha:
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        break;
+    case RenderBlendMode::AlphaPremulDest:
+        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        break;
+    case RenderBlendMode::Premultiplied:
+        glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        break;
+    }
+    glEnable(GL_BLEND);
+}
+
+// GL backend for RenderCommandLists. Program, texture and blend are only re-bound when they change
+// between consecutive commands; uniforms are set per command. Leaves blending disabled.
+static void RT_ExecuteRenderCommands(const RenderCommandList& list, GLuint vao, GLuint vbo) {
+    if (list.Empty()) return;
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glActiveTexture(GL_TEXTURE0);
+
+    GLuint boundProgram = 0;
+    GLuint boundTexture = 0;
+    bool blendKnown = false;
+    RenderBlendMode boundBlend = RenderBlendMode::Opaque;
+    auto useProgram = [&](GLuint program) {
+        if (program != boundProgram) {
+            glUseProgram(program);
+            boundProgram = program;
+        }
+    };
+
+    const std::vector<RenderGradientStop>& gradientStops = list.GradientStops();
+    for (const RenderCommand& cmd : list.Commands()) {
+        if (!blendKnown || cmd.blend != boundBlend) {
+            RT_ApplyBlendMode(cmd.blend);
+            boundBlend = cmd.blend;
+            blendKnown = true;
+        }
+
+        switch (cmd.type) {
+        case RenderCommandType::SolidQuad:
+            useProgram(rt_solidColorProgram);
+            glUniform4fv(rt_solidColorShaderLocs.color, 1, cmd.color);
+            break;
+        case RenderCommandType::TexturedQuad:
+            useProgram(rt_imageRenderProgram);
+            glUniform1i(rt_imageRenderShaderLocs.enableColorKey, cmd.textured.colorKeyEnabled ? 1 : 0);
+            if (cmd.textured.colorKeyEnabled) {
+                glUniform3fv(rt_imageRenderShaderLocs.colorKey, 1, cmd.textured.colorKey);
+                glUniform1f(rt_imageRenderShaderLocs.sensitivity, cmd.textured.keySensitivity);
+            }
+            glUniform1f(rt_imageRenderShaderLocs.opacity, cmd.textured.opacity);
+            break;
+        case RenderCommandType::Border:
+            useProgram(rt_staticBorderProgram);
+            glUniform1i(rt_staticBorderShaderLocs.shape, cmd.border.shape);
+            glUniform4fv(rt_staticBorderShaderLocs.borderColor, 1, cmd.color);
+            glUniform1f(rt_staticBorderShaderLocs.thickness, cmd.border.thickness);
+            glUniform1f(rt_staticBorderShaderLocs.radius, cmd.border.radius);
+            glUniform2f(rt_staticBorderShaderLocs.size, cmd.border.shapeW, cmd.border.shapeH);
+            glUniform2f(rt_staticBorderShaderLocs.quadSize, cmd.border.quadW, cmd.border.quadH);
+            break;
+        case RenderCommandType::Gradient: {
+            useProgram(rt_gradientProgram);
+            const RenderCommand::Gradient& g = cmd.gradient;
+            const GLuint ramp = rt_gradientRamps.Get({ gradientStops.data() + g.firstStop, static_cast<int>(g.stopCount) });
+            if (ramp != boundTexture) {
+                glBindTexture(GL_TEXTURE_2D, ramp);
+                boundTexture = ramp;
+            }
+            glUniform1f(rt_gradientShaderLocs.angle, g.angle);
+            glUniform1f(rt_gradientShaderLocs.time, g.time);
+            glUniform1i(rt_gradientShaderLocs.animationType, g.animationType);
+            glUniform1f(rt_gradientShaderLocs.animationSpeed, g.animationSpeed);
+            glUniform1i(rt_gradientShaderLocs.colorFade, g.colorFade ? 1 : 0);
+            break;
+        }
+        case RenderCommandType::Text:
+            useProgram(rt_textProgram);
+            glUniform4fv(rt_textShaderLocs.color, 1, cmd.color);
+            break;
+        default:
+            continue;
+        }
+
+        if (cmd.type == RenderCommandType::TexturedQuad || cmd.type == RenderCommandType::Text) {
+            if (cmd.texture != boundTexture) {
+                glBindTexture(GL_TEXTURE_2D, cmd.texture);
+                boundTexture = cmd.texture;
+            }
+        }
+
+        const RenderRect& r = cmd.rect;
+        const RenderRect& t = cmd.uv;
+        float verts[] = { r.x1, r.y1, t.x1, t.y1, r.x2, r.y1, t.x2, t.y1, r.x2, r.y2, t.x2, t.y2,
+                          r.x1, r.y1, t.x1, t.y1, r.x2, r.y2, t.x2, t.y2, r.x1, r.y2, t.x1, t.y2 };
+        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(verts), verts);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+    }
+
+    glDisable(GL_BLEND);
+    if (boundTexture != 0) { glBindTexture(GL_TEXTURE_2D, 0); }
+}
+
+// Overlay draws of the current frame are recorded here and replayed by RT_FlushRenderCommands
+static RenderCommandList rt_renderCommands;
+static RenderCommandStats rt_frameCommandStats;
+
+static void RT_FlushRenderCommands(GLuint vao, GLuint vbo) {
+    if (rt_renderCommands.Empty()) return;
+    rt_frameCommandStats.Add(AnalyzeRenderCommands(rt_renderCommands));
+    RT_ExecuteRenderCommands(rt_renderCommands, vao, vbo);
+    rt_renderCommands.Clear();
 }
 
 // Render cursor for OBS/Virtual Camera output
@@ -988,67 +821,20 @@ static void RT_RenderCursorForObs(int fullW, int fullH, int viewportX, int viewp
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
-// Render a border around an element using the render thread's shaders
-// This mirrors RenderGameBorder() from render.cpp but uses render thread resources
-static void RT_RenderGameBorder(int x, int y, int w, int h, int borderWidth, int radius, const Color& color, int fullW, int fullH,
-                                GLuint vao, GLuint vbo) {
+// Record a border around an element (window coordinates, y down)
+// This mirrors RenderGameBorder() from render.cpp: four solid rectangles outside the element
+static void RT_RecordGameBorder(RenderCommandList& commands, int x, int y, int w, int h, int borderWidth, const Color& color, int fullW,
+                                int fullH) {
     if (borderWidth <= 0) return;
 
-    glUseProgram(rt_solidColorProgram);
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    glUniform4f(rt_solidColorShaderLocs.color, color.r, color.g, color.b, 1.0f);
-
-    // Convert window coordinates to GL coordinates (Y-flip)
-    int y_gl = fullH - y - h;
-
-    // The border extends OUTSIDE the element
-    int outerLeft = x - borderWidth;
-    int outerRight = x + w + borderWidth;
-    int outerBottom = y_gl - borderWidth;
-    int outerTop = y_gl + h + borderWidth;
-
-    // Clamp radius to valid range
-    int effectiveRadius = radius;
-    int maxRadius = (w < h ? w : h) / 2 + borderWidth;
-    if (effectiveRadius > maxRadius) effectiveRadius = maxRadius;
-
-    // Helper to convert pixel coords to NDC
-    auto toNdcX = [fullW](int px) { return (static_cast<float>(px) / fullW) * 2.0f - 1.0f; };
-    auto toNdcY = [fullH](int py) { return (static_cast<float>(py) / fullH) * 2.0f - 1.0f; };
-
-    // Sharp corners: render 4 border rectangles
-    // (Rounded corners would require more complex rendering, keeping it simple for now)
-    // Top border
-    float topBorder[] = { toNdcX(outerLeft),  toNdcY(y_gl + h), 0, 0, toNdcX(outerRight), toNdcY(y_gl + h), 0, 0,
-                          toNdcX(outerRight), toNdcY(outerTop), 0, 0, toNdcX(outerLeft),  toNdcY(y_gl + h), 0, 0,
-                          toNdcX(outerRight), toNdcY(outerTop), 0, 0, toNdcX(outerLeft),  toNdcY(outerTop), 0, 0 };
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(topBorder), topBorder);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-
-    // Bottom border
-    float bottomBorder[] = { toNdcX(outerLeft),  toNdcY(outerBottom), 0, 0, toNdcX(outerRight), toNdcY(outerBottom), 0, 0,
-                             toNdcX(outerRight), toNdcY(y_gl),        0, 0, toNdcX(outerLeft),  toNdcY(outerBottom), 0, 0,
-                             toNdcX(outerRight), toNdcY(y_gl),        0, 0, toNdcX(outerLeft),  toNdcY(y_gl),        0, 0 };
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(bottomBorder), bottomBorder);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-
-    // Left border
-    float leftBorder[] = { toNdcX(outerLeft), toNdcY(y_gl),     0, 0, toNdcX(x),         toNdcY(y_gl),     0, 0,
-                           toNdcX(x),         toNdcY(y_gl + h), 0, 0, toNdcX(outerLeft), toNdcY(y_gl),     0, 0,
-                           toNdcX(x),         toNdcY(y_gl + h), 0, 0, toNdcX(outerLeft), toNdcY(y_gl + h), 0, 0 };
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(leftBorder), leftBorder);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-
-    // Right border
-    float rightBorder[] = { toNdcX(x + w),      toNdcY(y_gl),     0, 0, toNdcX(outerRight), toNdcY(y_gl),     0, 0,
-                            toNdcX(outerRight), toNdcY(y_gl + h), 0, 0, toNdcX(x + w),      toNdcY(y_gl),     0, 0,
-                            toNdcX(outerRight), toNdcY(y_gl + h), 0, 0, toNdcX(x + w),      toNdcY(y_gl + h), 0, 0 };
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(rightBorder), rightBorder);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    // Sharp corners (rounded corners would need the SDF border, keeping it simple for now)
+    const RenderBlendMode blend = RenderBlendMode::Alpha;
+    commands.SolidQuad(PixelRectToNdc(x - borderWidth, y - borderWidth, w + borderWidth * 2, borderWidth, fullW, fullH), color.r, color.g,
+                       color.b, 1.0f, blend); // Top
+    commands.SolidQuad(PixelRectToNdc(x - borderWidth, y + h, w + borderWidth * 2, borderWidth, fullW, fullH), color.r, color.g, color.b,
+                       1.0f, blend); // Bottom
+    commands.SolidQuad(PixelRectToNdc(x - borderWidth, y, borderWidth, h, fullW, fullH), color.r, color.g, color.b, 1.0f, blend); // Left
+    commands.SolidQuad(PixelRectToNdc(x + w, y, borderWidth, h, fullW, fullH), color.r, color.g, color.b, 1.0f, blend);           // Right
 }
 
 // Render background using stencil buffer - draws only in letterbox area (outside game viewport)
@@ -1709,258 +1495,264 @@ static void RT_RenderGameTexture(GLuint gameTexture, int x, int y, int w, int h,
     glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE); // Restore
 }
 
-// Render EyeZoom overlay on render thread for OBS capture
-// This renders the magnified game texture, colored boxes, center line, and caches text labels
-static void RT_RenderEyeZoom(GLuint gameTexture, int requestViewportX, int fullW, int fullH, int gameTexW, int gameTexH, GLuint vao,
-                             GLuint vbo, bool isTransitioningFromEyeZoom = false, GLuint snapshotTexture = 0, int snapshotWidth = 0,
-                             int snapshotHeight = 0, const EyeZoomConfig* externalZoomConfig = nullptr) {
-    if (gameTexture == UINT_MAX) return;
+// Text metrics and glyphs of an ImGui font for the EyeZoom labels (ASCII digits)
+class RT_ImGuiEyeZoomFont : public EyeZoomFont {
+  public:
+    explicit RT_ImGuiEyeZoomFont(ImFont* font) : m_font(font) {}
 
-    // Use externally-provided config snapshot if available, otherwise grab our own.
-    // Using the caller's snapshot avoids a TOCTOU race where the config changes between
-    // the box renderer and the text renderer within the same frame.
-    EyeZoomConfig zoomConfig;
-    if (externalZoomConfig) {
-        zoomConfig = *externalZoomConfig;
-    } else {
-        auto zoomCfgSnap = GetConfigSnapshot();
-        if (!zoomCfgSnap) return; // Config not yet published
-        zoomConfig = zoomCfgSnap->eyezoom;
+    void MeasureText(float size, const char* text, float& width, float& height) const override {
+        const ImVec2 textSize = m_font->CalcTextSizeA(size, FLT_MAX, 0.0f, text);
+        width = textSize.x;
+        height = textSize.y;
     }
 
-    // Calculate target position (final destination for EyeZoom mode)
-    int modeWidth = zoomConfig.windowWidth;
-    int targetViewportX = (fullW - modeWidth) / 2;
-
-    // Use the passed-in requestViewportX parameter - this already accounts for hideAnimationsInGame
-    // (caller passes -1 when skipAnimation is true, meaning use target position)
-    int viewportX = (requestViewportX >= 0) ? requestViewportX : targetViewportX;
-
-    if (viewportX <= 0) return; // No space for EyeZoom on the left
-
-    // Calculate zoom output dimensions
-    int zoomOutputWidth, zoomX;
-    bool isTransitioningToEyeZoom = (viewportX < targetViewportX && !isTransitioningFromEyeZoom);
-
-    if (zoomConfig.slideZoomIn) {
-        // SLIDE MODE: Zoom is always at full target size, but slides in/out from the left
-        // Calculate full size based on target position
-        zoomOutputWidth = targetViewportX - (2 * zoomConfig.horizontalMargin);
-
-        // Calculate slide position based on transition progress
-        // When stable: zoomX = horizontalMargin (final position)
-        // When transitioning TO: slide in from left (starts off-screen)
-        // When transitioning FROM: slide out to left (ends off-screen)
-        int finalZoomX = zoomConfig.horizontalMargin;
-        int offScreenX = -zoomOutputWidth;
-
-        if (isTransitioningToEyeZoom && targetViewportX > 0) {
-            // Sliding IN: Calculate progress (0 = start, 1 = destination reached)
-            float progress = (float)viewportX / (float)targetViewportX;
-            // Slide from off-screen left to final position
-            zoomX = offScreenX + (int)((finalZoomX - offScreenX) * progress);
-        } else if (isTransitioningFromEyeZoom && targetViewportX > 0) {
-            // Sliding OUT: Progress goes from 1 (fully visible) to 0 (off-screen)
-            float progress = (float)viewportX / (float)targetViewportX;
-            // Slide from final position to off-screen left
-            zoomX = offScreenX + (int)((finalZoomX - offScreenX) * progress);
-        } else {
-            zoomX = finalZoomX;
+    // Places glyphs the way ImFont::RenderText does for AddText
+    void AppendGlyphs(float size, const char* text, std::vector<Glyph>& out) const override {
+        const float scale = size / m_font->FontSize;
+        float x = 0.0f;
+        for (const char* c = text; *c; c++) {
+            const ImFontGlyph* glyph = m_font->FindGlyph(static_cast<ImWchar>(static_cast<unsigned char>(*c)));
+            if (!glyph) continue;
+            if (glyph->Visible) {
+                out.push_back({ x + glyph->X0 * scale, glyph->Y0 * scale, x + glyph->X1 * scale, glyph->Y1 * scale, glyph->U0, glyph->V0,
+                                glyph->U1, glyph->V1 });
+            }
+            x += glyph->AdvanceX * scale;
         }
-    } else {
-        // GROW MODE (default): Zoom grows with the viewport
-        // Horizontal margin applies to both sides:
-        // - Left side: gap between screen edge and zoom section = horizontalMargin
-        // - Right side: gap between zoom section and game viewport = horizontalMargin
-        // During transitions (both in and out), the zoom section shrinks/grows to maintain these margins
-        zoomOutputWidth = viewportX - (2 * zoomConfig.horizontalMargin);
-        zoomX = zoomConfig.horizontalMargin;
     }
 
-    // Don't render if there's not enough space (would overlap game or be too small)
-    if (zoomOutputWidth <= 1) {
-        return; // Need at least some minimum width to be useful
-    }
+  private:
+    ImFont* m_font;
+};
 
-    int zoomOutputHeight = fullH - (2 * zoomConfig.verticalMargin);
-    int minHeight = (int)(0.2f * fullH);
-    if (zoomOutputHeight < minHeight) zoomOutputHeight = minHeight;
+static EyeZoomLayoutParams RT_EyeZoomLayoutParams(const EyeZoomConfig& zoomConfig) {
+    EyeZoomLayoutParams params;
+    params.cloneWidth = zoomConfig.cloneWidth;
+    params.overlayWidth = zoomConfig.overlayWidth;
+    params.windowWidth = zoomConfig.windowWidth;
+    params.horizontalMargin = zoomConfig.horizontalMargin;
+    params.verticalMargin = zoomConfig.verticalMargin;
+    params.slideZoomIn = zoomConfig.slideZoomIn;
+    params.autoFontSize = zoomConfig.autoFontSize;
+    params.textFontSize = zoomConfig.textFontSize;
+    params.rectHeight = zoomConfig.rectHeight;
+    params.linkRectToFont = zoomConfig.linkRectToFont;
+    return params;
+}
 
-    int zoomY = zoomConfig.verticalMargin;
-    int zoomY_gl = fullH - zoomY - zoomOutputHeight;
+static void RT_EyeZoomColor(const Color& color, float opacity, float* out) {
+    out[0] = color.r;
+    out[1] = color.g;
+    out[2] = color.b;
+    out[3] = opacity;
+}
 
-    // Get current draw framebuffer (the FBO we're rendering to)
-    GLint currentDrawFBO;
-    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &currentDrawFBO);
+// What an EyeZoom overlay covers in the NDC of its strip-sized layer: the row of boxes, the center line and the labels
+static OverlayLayerRegion RT_EyeZoomOverlayRegion(const EyeZoomOverlay& overlay) {
+    OverlayLayerRegion region;
+    if (overlay.width <= 0 || overlay.height <= 0) return region;
+    auto include = [&](float x1, float y1, float x2, float y2) {
+        region.Include((x1 / overlay.width) * 2.0f - 1.0f, 1.0f - (y2 / overlay.height) * 2.0f, (x2 / overlay.width) * 2.0f - 1.0f,
+                       1.0f - (y1 / overlay.height) * 2.0f);
+    };
 
-    // Snapshot cache used for transition-out (freeze the last rendered EyeZoom clone).
-    // NOTE: This is updated every frame while EyeZoom is live.
+    if (!overlay.boxes.empty()) { include(overlay.boxes.front().x1, overlay.boxes.front().y1, overlay.boxes.back().x2, overlay.boxes.back().y2); }
+    if (overlay.lineX2 > overlay.lineX1) { include(overlay.lineX1, 0.0f, overlay.lineX2, (float)overlay.height); }
+    if (!overlay.glyphs.empty()) {
+        EyeZoomFont::Glyph bounds = overlay.glyphs.front();
+        for (const EyeZoomFont::Glyph& g : overlay.glyphs) {
+            bounds.x1 = (std::min)(bounds.x1, g.x1);
+            bounds.y1 = (std::min)(bounds.y1, g.y1);
+            bounds.x2 = (std::max)(bounds.x2, g.x2);
+            bounds.y2 = (std::max)(bounds.y2, g.y2);
+        }
+        include(bounds.x1, bounds.y1, bounds.x2, bounds.y2);
+    }
+    return region;
+}
 
-    auto EnsureRtEyeZoomSnapshotAllocated = [&]() {
-        if (rt_eyeZoomSnapshotTexture == 0 || rt_eyeZoomSnapshotWidth != zoomOutputWidth || rt_eyeZoomSnapshotHeight != zoomOutputHeight) {
-            if (rt_eyeZoomSnapshotTexture != 0) { glDeleteTextures(1, &rt_eyeZoomSnapshotTexture); }
-            if (rt_eyeZoomSnapshotFBO != 0) { glDeleteFramebuffers(1, &rt_eyeZoomSnapshotFBO); }
+// Draw the covered parts of a strip-sized EyeZoom overlay layer with its top left at (x, y) of the target
+static void RT_CompositeEyeZoomLayer(const RetainedOverlayLayer& layer, int x, int y, int w, int h, int fullW, int fullH, GLuint vao,
+                                     GLuint vbo) {
+    const float left = (x / (float)fullW) * 2.0f - 1.0f;
+    const float bottom = 1.0f - ((y + h) / (float)fullH) * 2.0f;
+    const float width = (w / (float)fullW) * 2.0f;
+    const float height = (h / (float)fullH) * 2.0f;
+
+    const OverlayLayerRegion& region = layer.Region();
+    for (int i = 0; i < region.count; i++) {
+        const OverlayLayerRegion::Rect& r = region.rects[i];
+        const RenderRect uv = { (r.x1 + 1.0f) * 0.5f, (r.y1 + 1.0f) * 0.5f, (r.x2 + 1.0f) * 0.5f, (r.y2 + 1.0f) * 0.5f };
+        rt_renderCommands.TexturedQuad({ left + uv.x1 * width, bottom + uv.y1 * height, left + uv.x2 * width, bottom + uv.y2 * height }, uv,
+                                       layer.Texture(), 1.0f, RenderFilter::Nearest, RenderBlendMode::Premultiplied);
+    }
+    RT_FlushRenderCommands(vao, vbo);
+}
 
-            glGenTextures(1, &rt_eyeZoomSnapshotTexture);
-            glBindTexture(GL_TEXTURE_2D, rt_eyeZoomSnapshotTexture);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, zoomOutputWidth, zoomOutputHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+static void RT_ReleaseEyeZoomPasses() {
+    for (RT_EyeZoomPass& pass : rt_eyeZoomPasses) {
+        if (pass.resolveFBO != 0) { glDeleteFramebuffers(1, &pass.resolveFBO); }
+        if (pass.resolveTexture != 0) { glDeleteTextures(1, &pass.resolveTexture); }
+        pass.resolveFBO = 0;
+        pass.resolveTexture = 0;
+        pass.resolveWidth = pass.resolveHeight = 0;
+        pass.resolveValid = false;
+        pass.overlayLayer.Release();
+        pass.overlayLaidOut = false;
+    }
+}
 
-            glGenFramebuffers(1, &rt_eyeZoomSnapshotFBO);
-            glBindFramebuffer(GL_FRAMEBUFFER, rt_eyeZoomSnapshotFBO);
-            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, rt_eyeZoomSnapshotTexture, 0);
+// Render EyeZoom on the render thread: the magnified center column of the game frame, then its overlay (grid
+// boxes, center line and numbers). passIdx is 0 for the on-screen pass, 1 for OBS; labelOpacity scales the numbers.
+// Per frame only the column's source pixels are copied and magnified; the overlay comes from a texture that is
+// redrawn when the settings, strip size or font change (or drawn directly while the strip is resizing).
+static void RT_RenderEyeZoom(int passIdx, const EyeZoomConfig& zoomConfig, GLuint gameTexture, int requestViewportX, int fullW, int fullH,
+                             int gameTexW, int gameTexH, bool isTransitioningFromEyeZoom, float labelOpacity, bool useOverlayLayer,
+                             GLuint vao, GLuint vbo) {
+    if (gameTexture == UINT_MAX) return;
 
-            rt_eyeZoomSnapshotWidth = zoomOutputWidth;
-            rt_eyeZoomSnapshotHeight = zoomOutputHeight;
-            rt_eyeZoomSnapshotValid = false; // content needs refresh
-        }
-    };
+    // requestViewportX already accounts for hideAnimationsInGame (-1 = EyeZoom's resting position)
+    const EyeZoomLayoutParams params = RT_EyeZoomLayoutParams(zoomConfig);
+    const EyeZoomPlacement placement = ComputeEyeZoomPlacement(params, fullW, fullH, requestViewportX, isTransitioningFromEyeZoom);
+    if (!placement.visible) return;
 
-    auto BlitRtEyeZoomSnapshotToDest = [&]() {
-        static GLuint snapshotReadFBO = 0;
-        if (snapshotReadFBO == 0) { glGenFramebuffers(1, &snapshotReadFBO); }
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, snapshotReadFBO);
-        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, rt_eyeZoomSnapshotTexture, 0);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, currentDrawFBO);
-        glBlitFramebuffer(0, 0, rt_eyeZoomSnapshotWidth, rt_eyeZoomSnapshotHeight, zoomX, zoomY_gl, zoomX + zoomOutputWidth,
-                          zoomY_gl + zoomOutputHeight, GL_COLOR_BUFFER_BIT, GL_NEAREST);
-    };
+    RT_EyeZoomPass& pass = rt_eyeZoomPasses[passIdx];
+    const int zoomX = placement.x;
+    const int zoomY_gl = fullH - placement.y - placement.height;
+    const int zoomOutputWidth = placement.width;
+    const int zoomOutputHeight = placement.height;
 
-    // STEP 1: Render clone (either from cached snapshot, or live game texture)
-    if (isTransitioningFromEyeZoom && rt_eyeZoomSnapshotValid && rt_eyeZoomSnapshotTexture != 0) {
-        // Transitioning OUT: always freeze and use snapshot
-        BlitRtEyeZoomSnapshotToDest();
-    } else {
-        // Sample from game texture every frame and refresh snapshot for transition-out
-        int texWidth = gameTexW;
-        int texHeight = gameTexH;
+    // Get current draw framebuffer (the FBO we're rendering to)
+    GLint currentDrawFBO;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &currentDrawFBO);
 
-        int srcCenterX = texWidth / 2;
+    // STEP 1: Copy the column's source pixels 1:1 into the resolve texture. Transitioning out, the last live
+    // column stays frozen instead.
+    if (!(isTransitioningFromEyeZoom && pass.resolveValid)) {
+        int srcCenterX = gameTexW / 2;
         int srcLeft = srcCenterX - zoomConfig.cloneWidth / 2;
         int srcRight = srcCenterX + zoomConfig.cloneWidth / 2;
 
-        int srcCenterY = texHeight / 2;
+        int srcCenterY = gameTexH / 2;
         int srcBottom = srcCenterY - zoomConfig.cloneHeight / 2;
         int srcTop = srcCenterY + zoomConfig.cloneHeight / 2;
 
         // Clamp to valid source region to avoid undefined blits.
         srcLeft = (std::max)(0, srcLeft);
         srcBottom = (std::max)(0, srcBottom);
-        srcRight = (std::min)(texWidth, srcRight);
-        srcTop = (std::min)(texHeight, srcTop);
-        if (srcRight <= srcLeft || srcTop <= srcBottom) {
-            return;
-        }
+        srcRight = (std::min)(gameTexW, srcRight);
+        srcTop = (std::min)(gameTexH, srcTop);
+        if (srcRight <= srcLeft || srcTop <= srcBottom) { return; }
+
+        const int srcW = srcRight - srcLeft;
+        const int srcH = srcTop - srcBottom;
+        if (pass.resolveTexture == 0 || pass.resolveWidth != srcW || pass.resolveHeight != srcH) {
+            if (pass.resolveTexture == 0) { glGenTextures(1, &pass.resolveTexture); }
+            if (pass.resolveFBO == 0) { glGenFramebuffers(1, &pass.resolveFBO); }
+
+            glBindTexture(GL_TEXTURE_2D, pass.resolveTexture);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, srcW, srcH, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-        int dstLeft = zoomX;
-        int dstRight = zoomX + zoomOutputWidth;
-        int dstBottom = zoomY_gl;
-        int dstTop = zoomY_gl + zoomOutputHeight;
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, pass.resolveFBO);
+            glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, pass.resolveTexture, 0);
+
+            pass.resolveWidth = srcW;
+            pass.resolveHeight = srcH;
+        }
 
         static GLuint gameReadFBO = 0;
         if (gameReadFBO == 0) { glGenFramebuffers(1, &gameReadFBO); }
         glBindFramebuffer(GL_READ_FRAMEBUFFER, gameReadFBO);
         glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, gameTexture, 0);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, currentDrawFBO);
-        glBlitFramebuffer(srcLeft, srcBottom, srcRight, srcTop, dstLeft, dstBottom, dstRight, dstTop, GL_COLOR_BUFFER_BIT, GL_NEAREST);
-
-        // Capture snapshot for transition-out
-        EnsureRtEyeZoomSnapshotAllocated();
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, currentDrawFBO);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, rt_eyeZoomSnapshotFBO);
-        glBlitFramebuffer(dstLeft, dstBottom, dstRight, dstTop, 0, 0, zoomOutputWidth, zoomOutputHeight, GL_COLOR_BUFFER_BIT, GL_NEAREST);
-        glBindFramebuffer(GL_FRAMEBUFFER, currentDrawFBO);
-        rt_eyeZoomSnapshotValid = true;
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, pass.resolveFBO);
+        glBlitFramebuffer(srcLeft, srcBottom, srcRight, srcTop, 0, 0, srcW, srcH, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        pass.resolveValid = true;
     }
 
-    // STEP 2: Render colored overlay boxes with numbers
+    // STEP 2: Magnify the column into the strip (same texels as blitting straight from the game frame)
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, pass.resolveFBO);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, currentDrawFBO);
+    glBlitFramebuffer(0, 0, pass.resolveWidth, pass.resolveHeight, zoomX, zoomY_gl, zoomX + zoomOutputWidth, zoomY_gl + zoomOutputHeight,
+                      GL_COLOR_BUFFER_BIT, GL_NEAREST);
     glBindFramebuffer(GL_FRAMEBUFFER, currentDrawFBO);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glUseProgram(rt_solidColorProgram);
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-
-    float pixelWidthOnScreen = zoomOutputWidth / (float)zoomConfig.cloneWidth;
-    int labelsPerSide = zoomConfig.cloneWidth / 2;
-    int overlayLabelsPerSide = zoomConfig.overlayWidth;
-    if (overlayLabelsPerSide < 0) overlayLabelsPerSide = labelsPerSide;
-    if (overlayLabelsPerSide > labelsPerSide) overlayLabelsPerSide = labelsPerSide;
-    // Use zoomY_gl (OpenGL coordinates) for centerY since NDC conversion expects Y=0 at bottom
-    float centerY = zoomY_gl + zoomOutputHeight / 2.0f;
-
-    // Use configured font size for box height
-    float boxHeight = zoomConfig.linkRectToFont ? (zoomConfig.textFontSize * 1.2f) : (float)zoomConfig.rectHeight;
-
-    for (int xOffset = -overlayLabelsPerSide; xOffset <= overlayLabelsPerSide; xOffset++) {
-        if (xOffset == 0) continue;
-
-        // Map xOffset (relative to center) to the full clone column index [0..cloneWidth-1]
-        int boxIndex = xOffset + labelsPerSide - (xOffset > 0 ? 1 : 0);
-        float boxLeft = zoomX + (boxIndex * pixelWidthOnScreen);
-        float boxRight = boxLeft + pixelWidthOnScreen;
-        float boxBottom = centerY - boxHeight / 2.0f;
-        float boxTop = centerY + boxHeight / 2.0f;
-
-        Color boxColor = (boxIndex % 2 == 0) ? zoomConfig.gridColor1 : zoomConfig.gridColor2;
-        float boxOpacity = (boxIndex % 2 == 0) ? zoomConfig.gridColor1Opacity : zoomConfig.gridColor2Opacity;
-        glUniform4f(rt_solidColorShaderLocs.color, boxColor.r, boxColor.g, boxColor.b, boxOpacity);
-
-        float boxNdcLeft = (boxLeft / (float)fullW) * 2.0f - 1.0f;
-        float boxNdcRight = (boxRight / (float)fullW) * 2.0f - 1.0f;
-        float boxNdcBottom = (boxBottom / (float)fullH) * 2.0f - 1.0f;
-        float boxNdcTop = (boxTop / (float)fullH) * 2.0f - 1.0f;
-
-        float boxVerts[] = {
-            boxNdcLeft, boxNdcBottom, 0, 0, boxNdcRight, boxNdcBottom, 0, 0, boxNdcRight, boxNdcTop, 0, 0,
-            boxNdcLeft, boxNdcBottom, 0, 0, boxNdcRight, boxNdcTop,    0, 0, boxNdcLeft,  boxNdcTop, 0, 0,
-        };
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(boxVerts), boxVerts);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
 
-        // Cache text labels for ImGui rendering
-        int displayNumber = abs(xOffset);
-        float numberCenterX = boxLeft + pixelWidthOnScreen / 2.0f;
-        float numberCenterY = centerY;
-        // Note: CacheEyeZoomTextLabel is in render.cpp - we need to call it from here
-        // For now, we'll skip text labels for OBS (they require cross-thread coordination)
+    // STEP 3: Overlay. Layout (with text measurement) is redone only when one of its inputs changes.
+    ImFont* font = nullptr;
+    if (placement.labels && labelOpacity > 0.0f && g_renderThreadImGuiInitialized && g_fontsValid) {
+        font = g_eyeZoomTextFont ? g_eyeZoomTextFont : ImGui::GetFont();
     }
+    const GLuint atlasTexture = (font && font->ContainerAtlas) ? (GLuint)(intptr_t)font->ContainerAtlas->TexID : 0;
+    if (atlasTexture == 0) font = nullptr;
+
+    EyeZoomColors colors;
+    RT_EyeZoomColor(zoomConfig.gridColor1, zoomConfig.gridColor1Opacity, colors.gridColor1);
+    RT_EyeZoomColor(zoomConfig.gridColor2, zoomConfig.gridColor2Opacity, colors.gridColor2);
+    RT_EyeZoomColor(zoomConfig.centerLineColor, zoomConfig.centerLineColorOpacity, colors.centerLine);
+    RT_EyeZoomColor(zoomConfig.textColor, zoomConfig.textColorOpacity * labelOpacity, colors.text);
+
+    OverlayLayerHash hash;
+    const int layoutInts[] = { params.cloneWidth,       params.overlayWidth, params.textFontSize, params.rectHeight,
+                               params.linkRectToFont,   params.autoFontSize, zoomOutputWidth,     zoomOutputHeight };
+    for (int v : layoutInts) hash.Add(static_cast<uint64_t>(static_cast<int64_t>(v)));
+    hash.AddPointer(font);
+    hash.Add(atlasTexture);
+    hash.Add(g_fontGeneration);
+    for (const float* c : { colors.gridColor1, colors.gridColor2, colors.centerLine, colors.text }) {
+        for (int i = 0; i < 4; i++) hash.AddFloat(c[i]);
+    }
+    const uint64_t overlayKey = hash.Value();
 
-    // STEP 3: Render vertical center line
-    float centerX = zoomX + zoomOutputWidth / 2.0f;
-    float centerLineWidth = 2.0f;
-    float lineLeft = centerX - centerLineWidth / 2.0f;
-    float lineRight = centerX + centerLineWidth / 2.0f;
-    // Use zoomY_gl and zoomOutputHeight since dstBottom/dstTop are only in else branch
-    float lineBottom = (float)zoomY_gl;
-    float lineTop = (float)(zoomY_gl + zoomOutputHeight);
-
-    float lineNdcLeft = (lineLeft / (float)fullW) * 2.0f - 1.0f;
-    float lineNdcRight = (lineRight / (float)fullW) * 2.0f - 1.0f;
-    float lineNdcBottom = (lineBottom / (float)fullH) * 2.0f - 1.0f;
-    float lineNdcTop = (lineTop / (float)fullH) * 2.0f - 1.0f;
-
-    glUniform4f(rt_solidColorShaderLocs.color, zoomConfig.centerLineColor.r, zoomConfig.centerLineColor.g, zoomConfig.centerLineColor.b,
-                zoomConfig.centerLineColorOpacity);
-
-    float centerLineVerts[] = {
-        lineNdcLeft, lineNdcBottom, 0, 0, lineNdcRight, lineNdcBottom, 0, 0, lineNdcRight, lineNdcTop, 0, 0,
-        lineNdcLeft, lineNdcBottom, 0, 0, lineNdcRight, lineNdcTop,    0, 0, lineNdcLeft,  lineNdcTop, 0, 0,
-    };
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(centerLineVerts), centerLineVerts);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    if (!pass.overlayLaidOut || pass.overlayKey != overlayKey) {
+        PROFILE_SCOPE_CAT("RT EyeZoom Overlay Layout", "Render Thread");
+        if (font) {
+            RT_ImGuiEyeZoomFont eyeZoomFont(font);
+            LayoutEyeZoomOverlay(params, zoomOutputWidth, zoomOutputHeight, true, &eyeZoomFont, pass.overlay);
+        } else {
+            LayoutEyeZoomOverlay(params, zoomOutputWidth, zoomOutputHeight, false, nullptr, pass.overlay);
+        }
+        pass.overlayKey = overlayKey;
+        pass.overlayLaidOut = true;
+    }
 
-    glDisable(GL_BLEND);
+    // The overlay layer is used once the overlay stays the same for two frames: a strip growing with the
+    // viewport is cheaper to draw directly than to re-render. Both paths blend the same way, so switching
+    // between them only differs by 8-bit rounding.
+    bool composited = false;
+    if (useOverlayLayer) {
+        RetainedOverlayLayer& layer = pass.overlayLayer;
+        if (layer.NoteContent(overlayKey)) {
+            if (layer.BeginUpdate(overlayKey, zoomOutputWidth, zoomOutputHeight)) {
+                PROFILE_SCOPE_CAT("RT EyeZoom Overlay Update", "Render Thread");
+                RecordEyeZoomOverlay(pass.overlay, colors, 0, 0, zoomOutputWidth, zoomOutputHeight, atlasTexture,
+                                     RenderBlendMode::AlphaPremulDest, rt_renderCommands);
+                RT_FlushRenderCommands(vao, vbo);
+                layer.EndUpdate(RT_EyeZoomOverlayRegion(pass.overlay));
+            }
+            if (layer.IsValid()) {
+                RT_CompositeEyeZoomLayer(layer, zoomX, placement.y, zoomOutputWidth, zoomOutputHeight, fullW, fullH, vao, vbo);
+                composited = true;
+            }
+        }
+    } else if (pass.overlayLayer.IsValid()) {
+        pass.overlayLayer.Release();
+    }
+    if (!composited) {
+        RecordEyeZoomOverlay(pass.overlay, colors, zoomX, placement.y, fullW, fullH, atlasTexture, RenderBlendMode::AlphaPremulDest,
+                             rt_renderCommands);
+        RT_FlushRenderCommands(vao, vbo);
+    }
 }
 
 // Render mirrors using render thread's local shader programs
-static void RT_RenderMirrors(const std::vector<MirrorConfig>& activeMirrors, const GameViewportGeometry& geo, int fullW, int fullH,
+static void RT_RenderMirrors(const ModeRenderList& renderList, const GameViewportGeometry& geo, int fullW, int fullH,
                              float modeOpacity, bool excludeOnlyOnMyScreen, bool relativeStretching, float transitionProgress,
                              float mirrorSlideProgress, int fromX, int fromY, int fromW, int fromH, int toX, int toY, int toW, int toH,
                              bool isEyeZoomMode, bool isTransitioningFromEyeZoom, int eyeZoomAnimatedViewportX, bool skipAnimation,
                              const std::string& fromModeId, bool fromSlideMirrorsIn, bool toSlideMirrorsIn, bool isSlideOutPass, GLuint vao,
                              GLuint vbo) {
+    const std::vector<MirrorConfig>& activeMirrors = renderList.mirrors;
     if (activeMirrors.empty()) return;
 
     // Grab config snapshot for thread-safe access
@@ -2007,7 +1799,8 @@ static void RT_RenderMirrors(const std::vector<MirrorConfig>& activeMirrors, con
     {
         // PHASE 1: Shared (read) lock - just copy data, no GPU operations
         std::shared_lock<std::shared_mutex> mirrorLock(g_mirrorInstancesMutex);
-        for (const auto& conf : activeMirrors) {
+        for (size_t mirrorIndex = 0; mirrorIndex < activeMirrors.size(); mirrorIndex++) {
+            const MirrorConfig& conf = activeMirrors[mirrorIndex];
             if (excludeOnlyOnMyScreen && conf.onlyOnMyScreen) continue;
 
             // If the mirror is fully transparent, skip EVERYTHING (including fence waits).
@@ -2015,10 +1808,15 @@ static void RT_RenderMirrors(const std::vector<MirrorConfig>& activeMirrors, con
             const float effectiveOpacity = modeOpacity * conf.opacity;
             if (effectiveOpacity <= 0.0f) continue;
 
-            auto it = g_mirrorInstances.find(conf.name);
-            if (it == g_mirrorInstances.end()) continue;
+            // Slot resolved when the list was compiled; the name lookup only covers mirrors recreated since
+            const MirrorInstance* instPtr = g_mirrorInstances.Get(renderList.mirrorHandles[mirrorIndex]);
+            if (!instPtr) {
+                auto it = g_mirrorInstances.find(conf.name);
+                if (it == g_mirrorInstances.end()) continue;
+                instPtr = &it->second;
+            }
 
-            const MirrorInstance& inst = it->second;
+            const MirrorInstance& inst = *instPtr;
             if (!inst.hasValidContent) continue;
 
             MirrorRenderData data;
@@ -2033,7 +1831,7 @@ static void RT_RenderMirrors(const std::vector<MirrorConfig>& activeMirrors, con
             // NOTE: We calculate outW/outH from FBO base dimensions and config scale, NOT from
             // inst.final_w/h. This allows the same mirror texture to be rendered at different scales:
             // - Mirror's own scale when used directly
-            // - Group's scale when used in a group (conf.output comes from group via RT_CollectActiveElements)
+            // - Group's scale when used in a group (conf.output comes from group via CompileModeRenderList)
             if (inst.finalTexture != 0 && inst.final_w > 0 && inst.final_h > 0) {
                 data.texture = inst.finalTexture;
                 data.tex_w = inst.final_w;
@@ -2313,7 +2111,7 @@ static void RT_RenderMirrors(const std::vector<MirrorConfig>& activeMirrors, con
     // === PASS 2: Static Border Rendering ===
     // Render borders after all mirrors are drawn so they can overlay on top
     // and extend outside mirror bounds
-    glUseProgram(rt_staticBorderProgram);
+    glDisable(GL_BLEND);
 
     for (const auto& renderData : mirrorsToRender) {
         const MirrorConfig& conf = *renderData.config;
@@ -2358,30 +2156,15 @@ static void RT_RenderMirrors(const std::vector<MirrorConfig>& activeMirrors, con
         int quadX = renderData.screenX - centerOffsetX + border.staticOffsetX - borderExtension;
         int quadY = renderData.screenY - centerOffsetY + border.staticOffsetY - borderExtension;
 
-        // 2. Setup Uniforms
-        glUniform1i(rt_staticBorderShaderLocs.shape, static_cast<int>(border.staticShape));
-        glUniform4f(rt_staticBorderShaderLocs.borderColor, border.staticColor.r, border.staticColor.g, border.staticColor.b,
-                    border.staticColor.a * conf.opacity * modeOpacity);
-        glUniform1f(rt_staticBorderShaderLocs.thickness, static_cast<float>(border.staticThickness));
-        glUniform1f(rt_staticBorderShaderLocs.radius, static_cast<float>(border.staticRadius));
-        // Pass the BASE size for SDF calculations and the actual QUAD size for pixel coordinate mapping
-        glUniform2f(rt_staticBorderShaderLocs.size, static_cast<float>(baseW), static_cast<float>(baseH));
-        glUniform2f(rt_staticBorderShaderLocs.quadSize, static_cast<float>(quadW), static_cast<float>(quadH));
-
-        // 3. Render Quad
-        int finalY_gl = fullH - (quadY + quadH);
-
-        float nx1 = (static_cast<float>(quadX) / fullW) * 2.0f - 1.0f;
-        float ny1 = (static_cast<float>(finalY_gl) / fullH) * 2.0f - 1.0f;
-        float nx2 = (static_cast<float>(quadX + quadW) / fullW) * 2.0f - 1.0f;
-        float ny2 = (static_cast<float>(finalY_gl + quadH) / fullH) * 2.0f - 1.0f;
-
-        float verts[] = { nx1, ny1, 0, 0, nx2, ny1, 1, 0, nx2, ny2, 1, 1, nx1, ny1, 0, 0, nx2, ny2, 1, 1, nx1, ny2, 0, 1 };
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(verts), verts);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        // 2. Record the quad - the BASE size drives the SDF, the QUAD size maps pixel coordinates
+        rt_renderCommands.Border(PixelRectToNdc(quadX, quadY, quadW, quadH, fullW, fullH), static_cast<int>(border.staticShape),
+                                 static_cast<float>(border.staticThickness), static_cast<float>(border.staticRadius),
+                                 static_cast<float>(baseW), static_cast<float>(baseH), static_cast<float>(quadW), static_cast<float>(quadH),
+                                 border.staticColor.r, border.staticColor.g, border.staticColor.b,
+                                 border.staticColor.a * conf.opacity * modeOpacity, RenderBlendMode::AlphaPremulDest);
     }
 
-    glDisable(GL_BLEND);
+    RT_FlushRenderCommands(vao, vbo);
 }
 
 // Render images using render thread's local shader programs
@@ -2394,10 +2177,37 @@ struct RT_UserImageCache {
 
 static std::unordered_map<std::string, RT_UserImageCache> g_rtUserImageCache;
 
-static void RT_CalculateImageDimensionsFromTexture(int texWidth, int texHeight, const ImageConfig& img, int& outW, int& outH) {
+// Seconds into the overlay timelines of `mode` for one pass, as of `now` (one time per render-loop iteration)
+static float RT_OverlayTimelineSeconds(int passIdx, ModeIdHandle mode, std::chrono::steady_clock::time_point now) {
+    RT_OverlayTimelineClock& clock = rt_overlayTimelineClocks[passIdx];
+    if (clock.mode != mode) {
+        const RT_OverlayTimelineClock& other = rt_overlayTimelineClocks[1 - passIdx];
+        clock.mode = mode;
+        clock.start = (other.mode == mode) ? other.start : now;
+    }
+    return std::chrono::duration<float>(now - clock.start).count();
+}
+
+// An overlay's configured placement with its keyframe timeline (if any) applied
+template <typename OverlayConfig>
+static OverlayPlacement RT_AnimatedPlacement(const OverlayConfig& conf, const CompiledOverlayTimeline* timeline, float timelineSeconds) {
+    OverlayPlacement placement;
+    placement.x = conf.x;
+    placement.y = conf.y;
+    placement.scale = conf.scale;
+    placement.opacity = conf.opacity;
+    placement.cropTop = conf.crop_top;
+    placement.cropBottom = conf.crop_bottom;
+    placement.cropLeft = conf.crop_left;
+    placement.cropRight = conf.crop_right;
+    if (timeline) { ApplyOverlayTimeline(*timeline, timelineSeconds, placement); }
+    return placement;
+}
+
+static void RT_CalculateImageDimensionsFromTexture(int texWidth, int texHeight, const OverlayPlacement& img, int& outW, int& outH) {
     if (texWidth > 0 && texHeight > 0) {
-        int croppedWidth = texWidth - img.crop_left - img.crop_right;
-        int croppedHeight = texHeight - img.crop_top - img.crop_bottom;
+        int croppedWidth = texWidth - img.cropLeft - img.cropRight;
+        int croppedHeight = texHeight - img.cropTop - img.cropBottom;
         if (croppedWidth < 1) croppedWidth = 1;
         if (croppedHeight < 1) croppedHeight = 1;
         outW = static_cast<int>(croppedWidth * img.scale);
@@ -2413,23 +2223,23 @@ static void RT_CalculateImageDimensionsFromTexture(int texWidth, int texHeight,
     }
 }
 
-static void RT_RenderImages(const std::vector<ImageConfig>& activeImages, int fullW, int fullH, int gameX, int gameY, int gameW, int gameH,
-                            int gameResW, int gameResH, bool relativeStretching, float transitionProgress, int fromX, int fromY, int fromW,
-                            int fromH, float modeOpacity, bool excludeOnlyOnMyScreen, GLuint vao, GLuint vbo) {
+static void RT_RenderImages(const std::vector<ImageConfig>& activeImages, const std::vector<CompiledOverlayTimeline>& timelines,
+                            float timelineSeconds, int fullW, int fullH, int gameX, int gameY, int gameW, int gameH, int gameResW,
+                            int gameResH, bool relativeStretching, float transitionProgress, int fromX, int fromY, int fromW, int fromH,
+                            float modeOpacity, bool excludeOnlyOnMyScreen, GLuint vao, GLuint vbo,
+                            OverlayLayerRegion* drawnRegion = nullptr) {
     if (activeImages.empty()) return;
 
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glActiveTexture(GL_TEXTURE0);
-    glEnable(GL_BLEND);
-    // Use separate blend functions for RGB and Alpha:
+    // Separate blend functions for RGB and Alpha:
     // RGB: standard alpha blend (src.rgb * src.a + dst.rgb * (1 - src.a))
     // Alpha: additive with destination attenuation (src.a + dst.a * (1 - src.a))
     // This ensures the FBO contains properly premultiplied alpha content
-    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    const RenderBlendMode blend = RenderBlendMode::AlphaPremulDest;
+    RenderCommandList& commands = rt_renderCommands;
 
     struct RT_ImageDrawInput {
         const ImageConfig* conf;
+        OverlayPlacement placement;
         GLuint texId;
         int texWidth;
         int texHeight;
@@ -2441,17 +2251,21 @@ static void RT_RenderImages(const std::vector<ImageConfig>& activeImages, int fu
     drawInputs.reserve(activeImages.size());
     {
         std::lock_guard<std::mutex> lock(g_userImagesMutex);
-        for (const auto& conf : activeImages) {
+        for (size_t i = 0; i < activeImages.size(); i++) {
+            const ImageConfig& conf = activeImages[i];
             if (excludeOnlyOnMyScreen && conf.onlyOnMyScreen) continue;
             auto it_inst = g_userImages.find(conf.name);
             if (it_inst == g_userImages.end() || it_inst->second.textureId == 0) continue;
             const UserImageInstance& inst = it_inst->second;
-            drawInputs.push_back({ &conf, inst.textureId, inst.width, inst.height, inst.isFullyTransparent });
+            const CompiledOverlayTimeline* timeline = (i < timelines.size()) ? &timelines[i] : nullptr;
+            drawInputs.push_back({ &conf, RT_AnimatedPlacement(conf, timeline, timelineSeconds), inst.textureId, inst.width, inst.height,
+                                   inst.isFullyTransparent });
         }
     }
 
     for (const auto& in : drawInputs) {
         const ImageConfig& conf = *in.conf;
+        const OverlayPlacement& pl = in.placement;
         const GLuint texId = in.texId;
         const int texWidth = in.texWidth;
         const int texHeight = in.texHeight;
@@ -2460,7 +2274,7 @@ static void RT_RenderImages(const std::vector<ImageConfig>& activeImages, int fu
         RT_UserImageCache& rtInst = g_rtUserImageCache[conf.name];
 
         // Skip fully invisible images (opacity==0 and no visible background/border).
-        const float effectiveOpacity = conf.opacity * modeOpacity;
+        const float effectiveOpacity = pl.opacity * modeOpacity;
         const bool hasBg = conf.background.enabled && conf.background.opacity > 0.0f && !isFullyTransparent;
         const bool hasBorder = conf.border.enabled && conf.border.width > 0 && !isFullyTransparent;
         if (effectiveOpacity <= 0.0f && !hasBg && !hasBorder) { continue; }
@@ -2471,9 +2285,9 @@ static void RT_RenderImages(const std::vector<ImageConfig>& activeImages, int fu
         auto& cache = rtInst.cachedRenderState;
 
         // Check if config has changed - must match main thread's validation logic
-        bool configChanged = !cache.isValid || cache.crop_left != conf.crop_left || cache.crop_right != conf.crop_right ||
-                             cache.crop_top != conf.crop_top || cache.crop_bottom != conf.crop_bottom || cache.scale != conf.scale ||
-                             cache.x != conf.x || cache.y != conf.y || cache.relativeTo != conf.relativeTo || cache.screenWidth != fullW ||
+        bool configChanged = !cache.isValid || cache.crop_left != pl.cropLeft || cache.crop_right != pl.cropRight ||
+                             cache.crop_top != pl.cropTop || cache.crop_bottom != pl.cropBottom || cache.scale != pl.scale ||
+                             cache.x != pl.x || cache.y != pl.y || cache.relativeTo != conf.relativeTo || cache.screenWidth != fullW ||
                              cache.screenHeight != fullH;
 
         if (!configChanged) {
@@ -2485,7 +2299,7 @@ static void RT_RenderImages(const std::vector<ImageConfig>& activeImages, int fu
             displayH = cache.displayH;
         } else {
             // Cache is stale - recalculate
-            RT_CalculateImageDimensionsFromTexture(texWidth, texHeight, conf, displayW, displayH);
+            RT_CalculateImageDimensionsFromTexture(texWidth, texHeight, pl, displayW, displayH);
 
             // Check if viewport-relative (ends with "Viewport")
             bool isViewportRelative = conf.relativeTo.length() > 8 && conf.relativeTo.substr(conf.relativeTo.length() - 8) == "Viewport";
@@ -2509,12 +2323,12 @@ static void RT_RenderImages(const std::vector<ImageConfig>& activeImages, int fu
 
                 // Calculate position at TO viewport
                 int toPosX, toPosY;
-                GetRelativeCoordsForImageWithViewport(conf.relativeTo, conf.x, conf.y, toDisplayW, toDisplayH, gameX, gameY, gameW, gameH,
+                GetRelativeCoordsForImageWithViewport(conf.relativeTo, pl.x, pl.y, toDisplayW, toDisplayH, gameX, gameY, gameW, gameH,
                                                       fullW, fullH, toPosX, toPosY);
 
                 // Calculate position at FROM viewport
                 int fromPosX, fromPosY;
-                GetRelativeCoordsForImageWithViewport(conf.relativeTo, conf.x, conf.y, fromDisplayW, fromDisplayH, fromX, fromY, fromW,
+                GetRelativeCoordsForImageWithViewport(conf.relativeTo, pl.x, pl.y, fromDisplayW, fromDisplayH, fromX, fromY, fromW,
                                                       fromH, fullW, fullH, fromPosX, fromPosY);
 
                 // Lerp between FROM and TO positions
@@ -2528,7 +2342,7 @@ static void RT_RenderImages(const std::vector<ImageConfig>& activeImages, int fu
                 }
             } else {
                 // Screen-relative: no interpolation needed
-                GetRelativeCoordsForImageWithViewport(conf.relativeTo, conf.x, conf.y, finalDisplayW, finalDisplayH, gameX, gameY, gameW,
+                GetRelativeCoordsForImageWithViewport(conf.relativeTo, pl.x, pl.y, finalDisplayW, finalDisplayH, gameX, gameY, gameW,
                                                       gameH, fullW, fullH, finalScreenX_win, finalScreenY_win);
             }
 
@@ -2541,13 +2355,13 @@ static void RT_RenderImages(const std::vector<ImageConfig>& activeImages, int fu
             displayH = finalDisplayH;
 
             // Update render-thread-local cache
-            cache.crop_left = conf.crop_left;
-            cache.crop_right = conf.crop_right;
-            cache.crop_top = conf.crop_top;
-            cache.crop_bottom = conf.crop_bottom;
-            cache.scale = conf.scale;
-            cache.x = conf.x;
-            cache.y = conf.y;
+            cache.crop_left = pl.cropLeft;
+            cache.crop_right = pl.cropRight;
+            cache.crop_top = pl.cropTop;
+            cache.crop_bottom = pl.cropBottom;
+            cache.scale = pl.scale;
+            cache.x = pl.x;
+            cache.y = pl.y;
             cache.relativeTo = conf.relativeTo;
             cache.screenWidth = fullW;
             cache.screenHeight = fullH;
@@ -2560,22 +2374,21 @@ static void RT_RenderImages(const std::vector<ImageConfig>& activeImages, int fu
             cache.isValid = true;
         }
 
+        if (drawnRegion) {
+            const float bx = hasBorder ? conf.border.width * 2.0f / fullW : 0.0f;
+            const float by = hasBorder ? conf.border.width * 2.0f / fullH : 0.0f;
+            drawnRegion->Include(nx1 - bx, ny1 - by, nx2 + bx, ny2 + by);
+        }
+
         // Draw background if enabled
         if (hasBg) {
-            glUseProgram(rt_solidColorProgram);
-            glUniform4f(rt_solidColorShaderLocs.color, conf.background.color.r, conf.background.color.g, conf.background.color.b,
-                        conf.background.opacity * modeOpacity);
-            float bg_verts[] = { nx1, ny1, 0, 0, nx2, ny1, 0, 0, nx2, ny2, 0, 0, nx1, ny1, 0, 0, nx2, ny2, 0, 0, nx1, ny2, 0, 0 };
-            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(bg_verts), bg_verts);
-            glDrawArrays(GL_TRIANGLES, 0, 6);
+            commands.SolidQuad({ nx1, ny1, nx2, ny2 }, conf.background.color.r, conf.background.color.g, conf.background.color.b,
+                               conf.background.opacity * modeOpacity, blend);
         }
 
-        // Draw image
-        glUseProgram(rt_imageRenderProgram);
-        glBindTexture(GL_TEXTURE_2D, texId);
-
         // Set texture filtering based on pixelatedScaling config
         if (!rtInst.filterInitialized || rtInst.lastPixelatedScaling != conf.pixelatedScaling) {
+            glBindTexture(GL_TEXTURE_2D, texId);
             if (conf.pixelatedScaling) {
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -2586,12 +2399,6 @@ static void RT_RenderImages(const std::vector<ImageConfig>& activeImages, int fu
             rtInst.lastPixelatedScaling = conf.pixelatedScaling;
             rtInst.filterInitialized = true;
         }
-        glUniform1i(rt_imageRenderShaderLocs.enableColorKey, conf.enableColorKey && !conf.colorKeys.empty() ? 1 : 0);
-        if (conf.enableColorKey && !conf.colorKeys.empty()) {
-            glUniform3f(rt_imageRenderShaderLocs.colorKey, conf.colorKeys[0].color.r, conf.colorKeys[0].color.g, conf.colorKeys[0].color.b);
-            glUniform1f(rt_imageRenderShaderLocs.sensitivity, conf.colorKeys[0].sensitivity);
-        }
-        glUniform1f(rt_imageRenderShaderLocs.opacity, effectiveOpacity);
 
         // Calculate texture coordinates with cropping
         // OpenGL texture coordinates: Y=0 at bottom, Y=1 at top
@@ -2600,15 +2407,19 @@ static void RT_RenderImages(const std::vector<ImageConfig>& activeImages, int fu
         // Avoid divide-by-zero if the texture dimensions are unavailable.
         const float invW = (texWidth > 0) ? (1.0f / texWidth) : 0.0f;
         const float invH = (texHeight > 0) ? (1.0f / texHeight) : 0.0f;
-        float tu1 = conf.crop_left * invW;
-        float tu2 = (texWidth - conf.crop_right) * invW;
-        float tv1 = conf.crop_bottom * invH;
-        float tv2 = (texHeight - conf.crop_top) * invH;
+        float tu1 = pl.cropLeft * invW;
+        float tu2 = (texWidth - pl.cropRight) * invW;
+        float tv1 = pl.cropBottom * invH;
+        float tv2 = (texHeight - pl.cropTop) * invH;
 
-        float verts[] = { nx1, ny1, tu1, tv1, nx2, ny1, tu2, tv1, nx2, ny2, tu2, tv2,
-                          nx1, ny1, tu1, tv1, nx2, ny2, tu2, tv2, nx1, ny2, tu1, tv2 };
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(verts), verts);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        const RenderFilter filter = conf.pixelatedScaling ? RenderFilter::Nearest : RenderFilter::Linear;
+        if (conf.enableColorKey && !conf.colorKeys.empty()) {
+            const ColorKeyConfig& key = conf.colorKeys[0];
+            commands.KeyedTexturedQuad({ nx1, ny1, nx2, ny2 }, { tu1, tv1, tu2, tv2 }, texId, effectiveOpacity, filter, blend, key.color.r,
+                                       key.color.g, key.color.b, key.sensitivity);
+        } else {
+            commands.TexturedQuad({ nx1, ny1, nx2, ny2 }, { tu1, tv1, tu2, tv2 }, texId, effectiveOpacity, filter, blend);
+        }
 
         // Render border if enabled (matching RenderImages behavior in render.cpp)
         if (hasBorder) {
@@ -2617,52 +2428,109 @@ static void RT_RenderImages(const std::vector<ImageConfig>& activeImages, int fu
             int finalScreenY_gl = static_cast<int>((ny1 + 1.0f) / 2.0f * fullH);
             int finalScreenY_win = fullH - finalScreenY_gl - displayH;
 
-            RT_RenderGameBorder(finalScreenX_win, finalScreenY_win, displayW, displayH, conf.border.width, conf.border.radius,
-                                conf.border.color, fullW, fullH, vao, vbo);
-
-            // Restore state after border rendering
-            glBindVertexArray(vao);
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
+            RT_RecordGameBorder(commands, finalScreenX_win, finalScreenY_win, displayW, displayH, conf.border.width, conf.border.color, fullW,
+                                fullH);
         }
     }
 
-    glDisable(GL_BLEND);
+    RT_FlushRenderCommands(vao, vbo);
+}
+
+// Every input RT_RenderImages reads: the compiled list (immutable, so its address stands for the image configs),
+// the placement parameters, the timeline time when the list animates anything, and the loaded textures (any
+// change to g_userImages bumps its generation)
+static uint64_t RT_HashImageLayer(const ModeRenderList* list, float timelineSeconds, int fullW, int fullH, int gameX, int gameY, int gameW,
+                                  int gameH, int gameResW, int gameResH, bool relativeStretching, float transitionProgress, int fromX, int fromY,
+                                  int fromW, int fromH, float modeOpacity, bool excludeOnlyOnMyScreen) {
+    OverlayLayerHash hash;
+    hash.AddPointer(list);
+    for (int v : { fullW, fullH, gameX, gameY, gameW, gameH, gameResW, gameResH, fromX, fromY, fromW, fromH }) {
+        hash.Add(static_cast<uint32_t>(v));
+    }
+    hash.Add((relativeStretching ? 1u : 0u) | (excludeOnlyOnMyScreen ? 2u : 0u));
+    hash.AddFloat(transitionProgress);
+    hash.AddFloat(modeOpacity);
+    hash.AddFloat(list->hasAnimatedOverlays ? timelineSeconds : 0.0f);
+    {
+        std::lock_guard<std::mutex> lock(g_userImagesMutex);
+        hash.Add(g_userImagesGeneration);
+    }
+    return hash.Value();
+}
+
+// Draw the covered parts of a retained layer texture (premultiplied alpha) over the current framebuffer
+static void RT_CompositeOverlayLayer(const RetainedOverlayLayer& layer, GLuint vao, GLuint vbo) {
+    const OverlayLayerRegion& region = layer.Region();
+    // The layer covers the whole target, so texture coordinates are the NDC remapped to [0, 1]
+    for (int i = 0; i < region.count; i++) {
+        const OverlayLayerRegion::Rect& r = region.rects[i];
+        rt_renderCommands.TexturedQuad({ r.x1, r.y1, r.x2, r.y2 },
+                                       { (r.x1 + 1.0f) * 0.5f, (r.y1 + 1.0f) * 0.5f, (r.x2 + 1.0f) * 0.5f, (r.y2 + 1.0f) * 0.5f },
+                                       layer.Texture(), 1.0f, RenderFilter::Nearest, RenderBlendMode::Premultiplied);
+    }
+    RT_FlushRenderCommands(vao, vbo);
+}
+
+std::shared_ptr<StreamingUploadRing> GetStreamingUploadRing() {
+    std::lock_guard<std::mutex> lock(g_streamingUploadsMutex);
+    return g_streamingUploads;
+}
+
+bool UploadTexturePixels(int width, int height, StreamingUpload& upload) {
+    StreamingUploadRing* ring = upload.ring.get();
+    // Space from a ring that has since been closed (render thread restart) no longer has storage behind it
+    if (!ring || ring != GetStreamingUploadRing().get() || upload.size < static_cast<size_t>(width) * height * 4) {
+        StreamingUploadRing::Release(upload);
+        return false;
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, ring->StorageBuffer());
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, reinterpret_cast<const void*>(upload.offset));
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    ring->Submit(upload);
+    return true;
+}
+
+void UploadTexturePixels(int width, int height, const void* rgba) {
+    const size_t bytes = static_cast<size_t>(width) * height * 4;
+    std::shared_ptr<StreamingUploadRing> ring = GetStreamingUploadRing();
+    StreamingUpload upload;
+    if (ring && ring->Reserve(bytes, upload)) {
+        memcpy(upload.data, rgba, bytes);
+        ring->Commit(upload);
+        if (UploadTexturePixels(width, height, upload)) return;
+    }
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
 }
 
 // Render window overlays using render thread's local shader programs
 // gameX/Y/W/H = game viewport position on screen (for viewport-relative positioning)
-static void RT_RenderWindowOverlays(const std::vector<const WindowOverlayConfig*>& overlays, int fullW, int fullH, int gameX, int gameY,
-                                    int gameW, int gameH, int gameResW, int gameResH, bool relativeStretching, float transitionProgress,
-                                    int fromX, int fromY, int fromW, int fromH, float modeOpacity, bool excludeOnlyOnMyScreen, GLuint vao,
-                                    GLuint vbo) {
+static void RT_RenderWindowOverlays(const std::vector<const WindowOverlayConfig*>& overlays,
+                                    const std::vector<CompiledOverlayTimeline>& timelines, float timelineSeconds, int fullW, int fullH,
+                                    int gameX, int gameY, int gameW, int gameH, int gameResW, int gameResH, bool relativeStretching,
+                                    float transitionProgress, int fromX, int fromY, int fromW, int fromH, float modeOpacity,
+                                    bool excludeOnlyOnMyScreen, GLuint vao, GLuint vbo) {
     if (overlays.empty()) return;
 
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glActiveTexture(GL_TEXTURE0);
-    glEnable(GL_BLEND);
-    // Use separate blend functions for proper premultiplied alpha output
-    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-    glUseProgram(rt_imageRenderProgram);
-    glUniform1i(rt_imageRenderShaderLocs.enableColorKey, 0);
-    glUniform1f(rt_imageRenderShaderLocs.opacity, modeOpacity);
-
     std::unique_lock<std::mutex> cacheLock(g_windowOverlayCacheMutex, std::try_to_lock);
-    if (!cacheLock.owns_lock()) {
-        glDisable(GL_BLEND);
-        return; // Skip if can't get lock
-    }
+    if (!cacheLock.owns_lock()) { return; } // Skip if can't get lock
+
+    // Separate blend functions for proper premultiplied alpha output
+    const RenderBlendMode blend = RenderBlendMode::AlphaPremulDest;
+    RenderCommandList& commands = rt_renderCommands;
+    glActiveTexture(GL_TEXTURE0);
 
     const std::string focusedName = GetFocusedWindowOverlayName();
 
-    for (const WindowOverlayConfig* conf : overlays) {
+    for (size_t i = 0; i < overlays.size(); i++) {
+        const WindowOverlayConfig* conf = overlays[i];
         if (!conf) continue;
         if (excludeOnlyOnMyScreen && conf->onlyOnMyScreen) continue;
 
         const std::string& overlayId = conf->name;
+        const OverlayPlacement pl = RT_AnimatedPlacement(*conf, (i < timelines.size()) ? &timelines[i] : nullptr, timelineSeconds);
 
         // Skip fully invisible overlays (opacity==0 and no visible background/border).
-        const float effectiveOpacity = conf->opacity * modeOpacity;
+        const float effectiveOpacity = pl.opacity * modeOpacity;
         const bool hasBg = conf->background.enabled && conf->background.opacity > 0.0f;
         const bool hasBorder = conf->border.enabled && conf->border.width > 0;
         if (effectiveOpacity <= 0.0f && !hasBg && !hasBorder) { continue; }
@@ -2684,12 +2552,14 @@ static void RT_RenderWindowOverlays(const std::vector<const WindowOverlayConfig*
 
         // Now read from backBuffer - it's safe, capture thread won't touch it
         WindowOverlayRenderData* renderData = entry.backBuffer.get();
-        if (renderData && renderData->pixelData && renderData->width > 0 && renderData->height > 0) {
+        if (renderData && (renderData->pixelData || renderData->upload.IsValid()) && renderData->width > 0 && renderData->height > 0) {
             // Check if this is actually new data we haven't uploaded yet
             if (renderData != entry.lastUploadedRenderData) {
                 // Create texture if it doesn't exist
                 if (entry.glTextureId == 0) {
                     glGenTextures(1, &entry.glTextureId);
+                    entry.glTextureHandle =
+                        GpuResourceManager::Get().Register(GpuResourceKind::Texture, entry.glTextureId, GpuSubsystem::WindowOverlays, 0);
                     glBindTexture(GL_TEXTURE_2D, entry.glTextureId);
                     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
                     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
@@ -2704,12 +2574,15 @@ static void RT_RenderWindowOverlays(const std::vector<const WindowOverlayConfig*
                 if (entry.glTextureWidth != renderData->width || entry.glTextureHeight != renderData->height) {
                     entry.glTextureWidth = renderData->width;
                     entry.glTextureHeight = renderData->height;
-                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, renderData->width, renderData->height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
-                                 renderData->pixelData);
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, renderData->width, renderData->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+                    GpuResourceManager::Get().SetBytes(entry.glTextureHandle, GpuTextureBytes(renderData->width, renderData->height));
+                }
+
+                // Frames the capture thread wrote into the upload ring only need the copy command
+                if (renderData->upload.IsValid()) {
+                    UploadTexturePixels(renderData->width, renderData->height, renderData->upload);
                 } else {
-                    // Same size, just update the data
-                    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, renderData->width, renderData->height, GL_RGBA, GL_UNSIGNED_BYTE,
-                                    renderData->pixelData);
+                    UploadTexturePixels(renderData->width, renderData->height, renderData->pixelData);
                 }
 
                 // Track which data we uploaded
@@ -2721,12 +2594,12 @@ static void RT_RenderWindowOverlays(const std::vector<const WindowOverlayConfig*
         if (entry.glTextureId == 0) continue;
 
         // Calculate dimensions
-        int croppedW = entry.glTextureWidth - conf->crop_left - conf->crop_right;
-        int croppedH = entry.glTextureHeight - conf->crop_top - conf->crop_bottom;
+        int croppedW = entry.glTextureWidth - pl.cropLeft - pl.cropRight;
+        int croppedH = entry.glTextureHeight - pl.cropTop - pl.cropBottom;
         if (croppedW < 1) croppedW = 1;
         if (croppedH < 1) croppedH = 1;
-        int displayW = static_cast<int>(croppedW * conf->scale);
-        int displayH = static_cast<int>(croppedH * conf->scale);
+        int displayW = static_cast<int>(croppedW * pl.scale);
+        int displayH = static_cast<int>(croppedH * pl.scale);
         if (displayW < 1) displayW = 1;
         if (displayH < 1) displayH = 1;
 
@@ -2750,12 +2623,12 @@ static void RT_RenderWindowOverlays(const std::vector<const WindowOverlayConfig*
 
             // Calculate position at TO viewport
             int toPosX, toPosY;
-            GetRelativeCoordsForImageWithViewport(conf->relativeTo, conf->x, conf->y, toDisplayW, toDisplayH, gameX, gameY, gameW, gameH,
+            GetRelativeCoordsForImageWithViewport(conf->relativeTo, pl.x, pl.y, toDisplayW, toDisplayH, gameX, gameY, gameW, gameH,
                                                   fullW, fullH, toPosX, toPosY);
 
             // Calculate position at FROM viewport
             int fromPosX, fromPosY;
-            GetRelativeCoordsForImageWithViewport(conf->relativeTo, conf->x, conf->y, fromDisplayW, fromDisplayH, fromX, fromY, fromW,
+            GetRelativeCoordsForImageWithViewport(conf->relativeTo, pl.x, pl.y, fromDisplayW, fromDisplayH, fromX, fromY, fromW,
                                                   fromH, fullW, fullH, fromPosX, fromPosY);
 
             // Lerp between FROM and TO positions
@@ -2769,7 +2642,7 @@ static void RT_RenderWindowOverlays(const std::vector<const WindowOverlayConfig*
             }
         } else {
             // Screen-relative: no interpolation needed
-            GetRelativeCoordsForImageWithViewport(conf->relativeTo, conf->x, conf->y, displayW, displayH, gameX, gameY, gameW, gameH, fullW,
+            GetRelativeCoordsForImageWithViewport(conf->relativeTo, pl.x, pl.y, displayW, displayH, gameX, gameY, gameW, gameH, fullW,
                                                   fullH, screenX, screenY);
         }
 
@@ -2782,20 +2655,13 @@ static void RT_RenderWindowOverlays(const std::vector<const WindowOverlayConfig*
 
         // Draw background if enabled (matching image overlay behavior)
         if (hasBg) {
-            glUseProgram(rt_solidColorProgram);
-            glUniform4f(rt_solidColorShaderLocs.color, conf->background.color.r, conf->background.color.g, conf->background.color.b,
-                        conf->background.opacity * modeOpacity);
-            float bg_verts[] = { nx1, ny1, 0, 0, nx2, ny1, 0, 0, nx2, ny2, 0, 0, nx1, ny1, 0, 0, nx2, ny2, 0, 0, nx1, ny2, 0, 0 };
-            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(bg_verts), bg_verts);
-            glDrawArrays(GL_TRIANGLES, 0, 6);
+            commands.SolidQuad({ nx1, ny1, nx2, ny2 }, conf->background.color.r, conf->background.color.g, conf->background.color.b,
+                               conf->background.opacity * modeOpacity, blend);
         }
 
-        // Draw window overlay
-        glUseProgram(rt_imageRenderProgram);
-        glBindTexture(GL_TEXTURE_2D, entry.glTextureId);
-
         // Set texture filtering based on pixelatedScaling config
         if (!entry.filterInitialized || entry.lastPixelatedScaling != conf->pixelatedScaling) {
+            glBindTexture(GL_TEXTURE_2D, entry.glTextureId);
             if (conf->pixelatedScaling) {
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -2807,29 +2673,20 @@ static void RT_RenderWindowOverlays(const std::vector<const WindowOverlayConfig*
             entry.filterInitialized = true;
         }
 
-        glUniform1i(rt_imageRenderShaderLocs.enableColorKey, 0);
-        // Apply per-overlay opacity multiplied by mode opacity
-        glUniform1f(rt_imageRenderShaderLocs.opacity, effectiveOpacity);
-
         // Texture coordinates with cropping
-        float tu1 = static_cast<float>(conf->crop_left) / entry.glTextureWidth;
-        float tv1 = static_cast<float>(conf->crop_top) / entry.glTextureHeight;
-        float tu2 = static_cast<float>(entry.glTextureWidth - conf->crop_right) / entry.glTextureWidth;
-        float tv2 = static_cast<float>(entry.glTextureHeight - conf->crop_bottom) / entry.glTextureHeight;
+        float tu1 = static_cast<float>(pl.cropLeft) / entry.glTextureWidth;
+        float tv1 = static_cast<float>(pl.cropTop) / entry.glTextureHeight;
+        float tu2 = static_cast<float>(entry.glTextureWidth - pl.cropRight) / entry.glTextureWidth;
+        float tv2 = static_cast<float>(entry.glTextureHeight - pl.cropBottom) / entry.glTextureHeight;
 
-        float verts[] = { nx1, ny1, tu1, tv2, nx2, ny1, tu2, tv2, nx2, ny2, tu2, tv1,
-                          nx1, ny1, tu1, tv2, nx2, ny2, tu2, tv1, nx1, ny2, tu1, tv1 };
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(verts), verts);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        // Window captures are stored top-down, so the bottom edge samples tv2
+        // Apply per-overlay opacity multiplied by mode opacity
+        commands.TexturedQuad({ nx1, ny1, nx2, ny2 }, { tu1, tv2, tu2, tv1 }, entry.glTextureId, effectiveOpacity,
+                              conf->pixelatedScaling ? RenderFilter::Nearest : RenderFilter::Linear, blend);
 
         // Render border if enabled (matching RenderWindowOverlaysGL behavior in window_overlay.cpp)
         if (hasBorder) {
-            RT_RenderGameBorder(screenX, screenY, displayW, displayH, conf->border.width, conf->border.radius, conf->border.color, fullW,
-                                fullH, vao, vbo);
-
-            // Restore state after border rendering
-            glBindVertexArray(vao);
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
+            RT_RecordGameBorder(commands, screenX, screenY, displayW, displayH, conf->border.width, conf->border.color, fullW, fullH);
         }
 
         // Render special focused border if this overlay is currently taking inputs
@@ -2837,155 +2694,12 @@ static void RT_RenderWindowOverlays(const std::vector<const WindowOverlayConfig*
             // Bright green border to indicate focused state
             Color focusedBorderColor = { 0.0f, 1.0f, 0.0f, 1.0f }; // Bright green
             int focusedBorderWidth = 3;
-            int focusedBorderRadius = conf->border.enabled ? conf->border.radius : 0;
-
-            RT_RenderGameBorder(screenX, screenY, displayW, displayH, focusedBorderWidth, focusedBorderRadius, focusedBorderColor, fullW,
-                                fullH, vao, vbo);
 
-            // Restore state after border rendering
-            glBindVertexArray(vao);
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
+            RT_RecordGameBorder(commands, screenX, screenY, displayW, displayH, focusedBorderWidth, focusedBorderColor, fullW, fullH);
         }
     }
 
-    glDisable(GL_BLEND);
-}
-
-// Collect active mirrors/images/overlays for a mode from g_config
-// This runs on the render thread, moving the work off the main thread
-// When onlyOnMyScreenPass is true, only items with onlyOnMyScreen=true are collected
-static void RT_CollectActiveElements(const Config& config, const std::string& modeId, bool onlyOnMyScreenPass,
-                                     std::vector<MirrorConfig>& outMirrors, std::vector<ImageConfig>& outImages,
-                                     std::vector<const WindowOverlayConfig*>& outWindowOverlays) {
-    outMirrors.clear();
-    outImages.clear();
-    outWindowOverlays.clear();
-
-    // Build lookup maps for this specific immutable snapshot to avoid O(n^2) scans.
-    // These caches are safe because `config` is immutable for the lifetime of the snapshot.
-    static const Config* s_cachedConfigPtr = nullptr;
-    static std::unordered_map<std::string, const ModeConfig*> s_modeById;
-    static std::unordered_map<std::string, const MirrorConfig*> s_mirrorByName;
-    static std::unordered_map<std::string, const MirrorGroupConfig*> s_groupByName;
-    static std::unordered_map<std::string, const ImageConfig*> s_imageByName;
-    static std::unordered_map<std::string, const WindowOverlayConfig*> s_windowOverlayByName;
-
-    if (s_cachedConfigPtr != &config) {
-        s_cachedConfigPtr = &config;
-        s_modeById.clear();
-        s_mirrorByName.clear();
-        s_groupByName.clear();
-        s_imageByName.clear();
-        s_windowOverlayByName.clear();
-
-        s_modeById.reserve(config.modes.size());
-        for (const auto& m : config.modes) { s_modeById[m.id] = &m; }
-
-        s_mirrorByName.reserve(config.mirrors.size());
-        for (const auto& m : config.mirrors) { s_mirrorByName[m.name] = &m; }
-
-        s_groupByName.reserve(config.mirrorGroups.size());
-        for (const auto& g : config.mirrorGroups) { s_groupByName[g.name] = &g; }
-
-        s_imageByName.reserve(config.images.size());
-        for (const auto& img : config.images) { s_imageByName[img.name] = &img; }
-
-        s_windowOverlayByName.reserve(config.windowOverlays.size());
-        for (const auto& o : config.windowOverlays) { s_windowOverlayByName[o.name] = &o; }
-    }
-
-    // Look up mode by ID (case-insensitive fallback if exact not found)
-    const ModeConfig* mode = nullptr;
-    if (auto it = s_modeById.find(modeId); it != s_modeById.end()) {
-        mode = it->second;
-    } else {
-        for (const auto& kv : s_modeById) {
-            if (EqualsIgnoreCase(kv.first, modeId)) {
-                mode = kv.second;
-                break;
-            }
-        }
-    }
-    if (!mode) return;
-
-    // Reserve space upfront
-    outMirrors.reserve(mode->mirrorIds.size() + mode->mirrorGroupIds.size());
-    outImages.reserve(mode->imageIds.size());
-    outWindowOverlays.reserve(mode->windowOverlayIds.size());
-
-    // Collect mirrors
-    for (const auto& mirrorName : mode->mirrorIds) {
-        auto it = s_mirrorByName.find(mirrorName);
-        if (it == s_mirrorByName.end() || !it->second) continue;
-        const MirrorConfig& mirror = *it->second;
-        if (!onlyOnMyScreenPass || mirror.onlyOnMyScreen) { outMirrors.push_back(mirror); }
-    }
-
-    // Collect mirror groups (override output position for each mirror in the group)
-    // Per-item sizing: each mirror in the group has its own widthPercent/heightPercent
-    for (const auto& groupName : mode->mirrorGroupIds) {
-        auto git = s_groupByName.find(groupName);
-        if (git == s_groupByName.end() || !git->second) continue;
-        const auto& group = *git->second;
-
-            for (const auto& item : group.mirrors) {
-                if (!item.enabled) continue; // Skip disabled items
-                auto mit = s_mirrorByName.find(item.mirrorId);
-                if (mit != s_mirrorByName.end() && mit->second) {
-                    const auto& mirror = *mit->second;
-                    if (!onlyOnMyScreenPass || mirror.onlyOnMyScreen) {
-                        MirrorConfig groupedMirror = mirror;
-                            // Calculate group position - use relative percentages if enabled
-                            int groupX = group.output.x;
-                            int groupY = group.output.y;
-                            if (group.output.useRelativePosition) {
-                                int screenW = GetCachedScreenWidth();
-                                int screenH = GetCachedScreenHeight();
-                                groupX = static_cast<int>(group.output.relativeX * screenW);
-                                groupY = static_cast<int>(group.output.relativeY * screenH);
-                            }
-                            // Position comes from group output settings + per-item offset
-                            groupedMirror.output.x = groupX + item.offsetX;
-                            groupedMirror.output.y = groupY + item.offsetY;
-                            groupedMirror.output.relativeTo = group.output.relativeTo;
-                            groupedMirror.output.useRelativePosition = group.output.useRelativePosition;
-                            groupedMirror.output.relativeX = group.output.relativeX;
-                            groupedMirror.output.relativeY = group.output.relativeY;
-                            // Per-item sizing: multiply mirror's own scale by item's widthPercent/heightPercent
-                            // Use separate scale when per-item sizing differs from 100%
-                            if (item.widthPercent != 1.0f || item.heightPercent != 1.0f) {
-                                groupedMirror.output.separateScale = true;
-                                float baseScaleX = mirror.output.separateScale ? mirror.output.scaleX : mirror.output.scale;
-                                float baseScaleY = mirror.output.separateScale ? mirror.output.scaleY : mirror.output.scale;
-                                groupedMirror.output.scaleX = baseScaleX * item.widthPercent;
-                                groupedMirror.output.scaleY = baseScaleY * item.heightPercent;
-                            }
-                            // Otherwise keep mirror's original scale settings
-                        outMirrors.push_back(groupedMirror);
-                    }
-                }
-            }
-    }
-
-    // Collect images (honor runtime visibility toggle)
-    if (g_imageOverlaysVisible.load(std::memory_order_acquire)) {
-        for (const auto& imageName : mode->imageIds) {
-            auto it = s_imageByName.find(imageName);
-            if (it == s_imageByName.end() || !it->second) continue;
-            const ImageConfig& image = *it->second;
-            if (!onlyOnMyScreenPass || image.onlyOnMyScreen) { outImages.push_back(image); }
-        }
-    }
-
-    // Collect window overlays (honor runtime visibility toggle)
-    if (g_windowOverlaysVisible.load(std::memory_order_acquire)) {
-        for (const auto& overlayId : mode->windowOverlayIds) {
-            auto it = s_windowOverlayByName.find(overlayId);
-            if (it == s_windowOverlayByName.end() || !it->second) continue;
-            const WindowOverlayConfig& overlay = *it->second;
-            if (!onlyOnMyScreenPass || overlay.onlyOnMyScreen) { outWindowOverlays.push_back(it->second); }
-        }
-    }
+    RT_FlushRenderCommands(vao, vbo);
 }
 
 static void RenderThreadFunc(void* gameGLContext) {
@@ -3026,6 +2740,19 @@ static void RenderThreadFunc(void* gameGLContext) {
             return;
         }
 
+        // Persistently mapped upload ring for texture streaming (needs GL_ARB_buffer_storage; uploads fall back to
+        // client memory without it)
+        {
+            std::shared_ptr<StreamingUploadRing> ring = StreamingUploadRing::CreateForCurrentContext(STREAMING_UPLOAD_RING_BYTES);
+            if (ring) {
+                LogCategory("init", "Render Thread: Streaming upload ring mapped (" + std::to_string(STREAMING_UPLOAD_RING_BYTES >> 20) + " MB)");
+            } else {
+                LogCategory("init", "Render Thread: Persistent buffer mapping unavailable, texture uploads stay synchronous");
+            }
+            std::lock_guard<std::mutex> lock(g_streamingUploadsMutex);
+            g_streamingUploads = std::move(ring);
+        }
+
         // Initialize Virtual Camera if enabled in config
         auto initCfg = GetConfigSnapshot();
         if (initCfg && initCfg->debug.virtualCameraEnabled) {
@@ -3104,6 +2831,7 @@ static void RenderThreadFunc(void* gameGLContext) {
                 InitializeOverlayTextFont(fontPath, 16.0f, scaleFactor);
 
                 g_fontsValid = true;
+                g_fontGeneration++;
                 g_renderThreadImGuiInitialized = true;
                 LogCategory("init", "Render Thread: ImGui initialized successfully");
             } else {
@@ -3121,19 +2849,18 @@ static void RenderThreadFunc(void* gameGLContext) {
             {
                 std::unique_lock<std::mutex> lock(g_requestSignalMutex);
                 g_requestCV.wait(lock, [] {
-                    return g_requestReadySlot.load(std::memory_order_acquire) != -1 || g_obsReadySlot.load(std::memory_order_acquire) != -1 ||
-                           g_renderThreadShouldStop.load();
+                    return g_requestMailbox.HasPending() || g_obsMailbox.HasPending() || g_renderThreadShouldStop.load();
                 });
             }
             // Lock released - we don't hold it while processing
 
             if (g_renderThreadShouldStop.load()) break;
 
-            // Check which request types are pending
-            int obsSlot = g_obsReadySlot.exchange(-1, std::memory_order_acq_rel);
-            int mainSlot = g_requestReadySlot.exchange(-1, std::memory_order_acq_rel);
-            bool hasObsRequest = (obsSlot != -1);
-            bool hasMainRequest = (mainSlot != -1);
+            // Take the newest pending request of each type
+            ObsFrameSubmission submission;
+            FrameRenderRequest mainRequest;
+            bool hasObsRequest = g_obsMailbox.TryConsume(submission);
+            bool hasMainRequest = g_requestMailbox.TryConsume(mainRequest);
 
             if (!hasObsRequest && !hasMainRequest) {
                 continue; // Timeout, no request
@@ -3142,33 +2869,45 @@ static void RenderThreadFunc(void* gameGLContext) {
             // Process OBS request first if pending (virtual camera needs this)
             if (hasObsRequest) {
                 PROFILE_SCOPE_CAT("RT Build OBS Request", "Render Thread");
-                // Read the slot published to the mailbox.
-                g_obsReadSlot.store(obsSlot, std::memory_order_release);
-                ObsFrameSubmission submission = g_obsSubmissionSlots[obsSlot];
-                g_obsReadSlot.store(-1, std::memory_order_release);
                 // Build the full request on the render thread (deferred from main thread)
                 request = BuildObsFrameRequest(submission.context, submission.isDualRenderingPath);
                 request.gameTextureFence = submission.gameTextureFence;
                 isObsRequest = true;
             } else {
                 // Only main request pending
-                g_requestReadSlot.store(mainSlot, std::memory_order_release);
-                request = g_requestSlots[mainSlot];
-                g_requestReadSlot.store(-1, std::memory_order_release);
+                request = mainRequest;
                 isObsRequest = false;
             }
 
             // Store main request for later if we're processing OBS first
             FrameRenderRequest pendingMainRequest;
             bool hasPendingMain = hasObsRequest && hasMainRequest;
-            if (hasPendingMain) {
-                g_requestReadSlot.store(mainSlot, std::memory_order_release);
-                pendingMainRequest = g_requestSlots[mainSlot];
-                g_requestReadSlot.store(-1, std::memory_order_release);
-            }
+            if (hasPendingMain) { pendingMainRequest = mainRequest; }
+
+            // Set by the OBS pass when it rendered rt_sharedOverlayStack for the pending main pass. The list is
+            // held so its address, part of the key, cannot be reused before the main pass compares keys.
+            bool sharedStackReady = false;
+            uint64_t sharedStackKey = 0;
+            std::shared_ptr<const ModeRenderList> sharedStackList;
+
+            // Both passes of an iteration sample overlay timelines at the same time
+            const auto iterationTime = std::chrono::steady_clock::now();
 
         // Label for processing a request (used to process both OBS and main in same iteration)
         process_request:
+            PROFILE_SCOPE_CAT(isObsRequest ? "RT OBS Pass" : "RT Screen Pass", "Render Thread");
+            PROFILE_GPU_SCOPE(isObsRequest ? "RT OBS Pass" : "RT Screen Pass");
+
+            // One fence covers the uploads the previous pass copied; reclaim ring space whose copies are done
+            std::shared_ptr<StreamingUploadRing> streamingUploads = GetStreamingUploadRing();
+            if (streamingUploads) {
+                streamingUploads->FenceSubmitted();
+                streamingUploads->Retire();
+            }
+
+            // Objects released for this context (replaced images) once the passes that drew them are done
+            GpuResourceManager& gpuResources = GpuResourceManager::Get();
+            if (gpuResources.HasPending(GpuContextQueue::RenderThread)) { gpuResources.Retire(GpuContextQueue::RenderThread); }
 
             auto startTime = std::chrono::high_resolution_clock::now();
 
@@ -3176,6 +2915,9 @@ static void RenderThreadFunc(void* gameGLContext) {
             auto cfgSnapshot = GetConfigSnapshot();
             if (!cfgSnapshot) continue; // Config not yet published, skip frame
             const Config& cfg = *cfgSnapshot;
+            // Interned names are never freed, so these stay valid for the whole frame
+            const std::string& requestModeId = ModeIdName(request.modeHandle);
+            const std::string& requestFromModeId = ModeIdName(request.fromModeHandle);
 
             // === Image Processing (moved from main thread) ===
             // Process decoded images and upload to GPU
@@ -3239,14 +2981,14 @@ static void RenderThreadFunc(void* gameGLContext) {
                 // When transitioning FROM EyeZoom, use EyeZoom's background (not the target mode's)
                 // When transitioning TO Fullscreen, use the from-mode's background (Fullscreen has no background)
                 if (!request.isRawWindowedMode) {
-                    std::string bgModeId = request.modeId;
+                    std::string bgModeId = requestModeId;
                     // If transitioning FROM EyeZoom, use EyeZoom's background instead of target mode
                     if (request.isTransitioningFromEyeZoom) {
                         bgModeId = "EyeZoom";
                     }
                     // If transitioning TO Fullscreen, use the from-mode's background (Fullscreen has no background of its own)
-                    else if (EqualsIgnoreCase(request.modeId, "Fullscreen") && !request.fromModeId.empty()) {
-                        bgModeId = request.fromModeId;
+                    else if (EqualsIgnoreCase(requestModeId, "Fullscreen") && !requestFromModeId.empty()) {
+                        bgModeId = requestFromModeId;
                     }
 
                     const ModeConfig* mode = nullptr;
@@ -3259,41 +3001,25 @@ static void RenderThreadFunc(void* gameGLContext) {
 
                     if (mode && mode->background.selectedMode == "gradient" && mode->background.gradientStops.size() >= 2) {
                         // Render gradient background fullscreen
-                        glUseProgram(rt_gradientProgram);
-                        glBindVertexArray(renderVAO);
-                        glBindBuffer(GL_ARRAY_BUFFER, renderVBO);
-
-                        // Set gradient uniforms
-                        int numStops = (std::min)(static_cast<int>(mode->background.gradientStops.size()), 8);
-                        glUniform1i(rt_gradientShaderLocs.numStops, numStops);
-
-                        float colors[8 * 4]; // 4 components per color
-                        float positions[8];
+                        RenderGradientStop stops[RenderCommandList::MAX_GRADIENT_STOPS];
+                        int numStops = (std::min)(static_cast<int>(mode->background.gradientStops.size()),
+                                                  RenderCommandList::MAX_GRADIENT_STOPS);
                         for (int i = 0; i < numStops; i++) {
-                            colors[i * 4 + 0] = mode->background.gradientStops[i].color.r;
-                            colors[i * 4 + 1] = mode->background.gradientStops[i].color.g;
-                            colors[i * 4 + 2] = mode->background.gradientStops[i].color.b;
-                            colors[i * 4 + 3] = 1.0f; // Full opacity for OBS
-                            positions[i] = mode->background.gradientStops[i].position;
+                            const GradientColorStop& stop = mode->background.gradientStops[i];
+                            stops[i] = { stop.color.r, stop.color.g, stop.color.b, 1.0f, stop.position }; // Full opacity for OBS
                         }
-                        glUniform4fv(rt_gradientShaderLocs.stopColors, numStops, colors);
-                        glUniform1fv(rt_gradientShaderLocs.stopPositions, numStops, positions);
-                        glUniform1f(rt_gradientShaderLocs.angle, mode->background.gradientAngle * 3.14159265f / 180.0f);
 
-                        // Animation uniforms
+                        // Animation time
                         static auto startTime = std::chrono::steady_clock::now();
                         auto now = std::chrono::steady_clock::now();
                         float timeSeconds = std::chrono::duration<float>(now - startTime).count();
-                        glUniform1f(rt_gradientShaderLocs.time, timeSeconds);
-                        glUniform1i(rt_gradientShaderLocs.animationType, static_cast<int>(mode->background.gradientAnimation));
-                        glUniform1f(rt_gradientShaderLocs.animationSpeed, mode->background.gradientAnimationSpeed);
-                        glUniform1i(rt_gradientShaderLocs.colorFade, mode->background.gradientColorFade ? 1 : 0);
-
-                        // Fullscreen quad vertices
-                        float bgVerts[] = { -1.0f, -1.0f, 0.0f, 0.0f, 1.0f, -1.0f, 1.0f, 0.0f, 1.0f,  1.0f, 1.0f, 1.0f,
-                                            -1.0f, -1.0f, 0.0f, 0.0f, 1.0f, 1.0f,  1.0f, 1.0f, -1.0f, 1.0f, 0.0f, 1.0f };
-                        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(bgVerts), bgVerts);
-                        glDrawArrays(GL_TRIANGLES, 0, 6);
+
+                        rt_renderCommands.Gradient({ -1.0f, -1.0f, 1.0f, 1.0f }, stops, numStops,
+                                                   mode->background.gradientAngle * 3.14159265f / 180.0f, timeSeconds,
+                                                   static_cast<int>(mode->background.gradientAnimation),
+                                                   mode->background.gradientAnimationSpeed, mode->background.gradientColorFade,
+                                                   RenderBlendMode::Opaque);
+                        RT_FlushRenderCommands(renderVAO, renderVBO);
                     } else if (mode && mode->background.selectedMode == "image") {
                         GLuint bgTex = 0;
                         {
@@ -3392,22 +3118,21 @@ static void RenderThreadFunc(void* gameGLContext) {
                     if (!request.isRawWindowedMode && request.transitioningToFullscreen && request.fromBorderEnabled &&
                         request.fromBorderWidth > 0) {
                         Color fromBorderColor = { request.fromBorderR, request.fromBorderG, request.fromBorderB, 1.0f };
-                        RT_RenderGameBorder(request.animatedX, request.animatedY, request.animatedW, request.animatedH,
-                                            request.fromBorderWidth, request.fromBorderRadius, fromBorderColor, request.fullW,
-                                            request.fullH, renderVAO, renderVBO);
+                        RT_RecordGameBorder(rt_renderCommands, request.animatedX, request.animatedY, request.animatedW, request.animatedH,
+                                            request.fromBorderWidth, fromBorderColor, request.fullW, request.fullH);
                     } else if (!request.isRawWindowedMode && request.borderEnabled && request.borderWidth > 0) {
                         Color borderColor = { request.borderR, request.borderG, request.borderB, 1.0f };
-                        RT_RenderGameBorder(request.animatedX, request.animatedY, request.animatedW, request.animatedH, request.borderWidth,
-                                            request.borderRadius, borderColor, request.fullW, request.fullH, renderVAO, renderVBO);
+                        RT_RecordGameBorder(rt_renderCommands, request.animatedX, request.animatedY, request.animatedW, request.animatedH,
+                                            request.borderWidth, borderColor, request.fullW, request.fullH);
                     }
+                    RT_FlushRenderCommands(renderVAO, renderVBO);
 
                     // Render EyeZoom overlay for OBS if enabled (skip in raw windowed mode)
                     if (!request.isRawWindowedMode && request.showEyeZoom) {
                         // Pass animated viewport X directly - RT_RenderEyeZoom handles -1 by calculating target position
-                        // Also pass snapshot texture for transition-out consistency
-                        RT_RenderEyeZoom(readyTex, request.eyeZoomAnimatedViewportX, request.fullW, request.fullH, srcW, srcH, renderVAO,
-                                         renderVBO, request.isTransitioningFromEyeZoom, request.eyeZoomSnapshotTexture,
-                                         request.eyeZoomSnapshotWidth, request.eyeZoomSnapshotHeight, &cfg.eyezoom);
+                        RT_RenderEyeZoom(1, cfg.eyezoom, readyTex, request.eyeZoomAnimatedViewportX, request.fullW, request.fullH, srcW,
+                                         srcH, request.isTransitioningFromEyeZoom, request.eyeZoomFadeOpacity,
+                                         !cfg.debug.disableOverlayLayerCache, renderVAO, renderVBO);
                     }
                 }
                 // If no ready frame and no fallback available, just show background (first few frames at startup)
@@ -3440,34 +3165,19 @@ static void RenderThreadFunc(void* gameGLContext) {
                 geo.finalH = request.finalH;
             }
 
-            // Collect active elements from g_config (this work moved from main thread)
-            // PERF: Cache these per (snapshot ptr, modeId, runtime visibility toggles).
-            // In steady-state gameplay, config and mode are usually stable, so rebuilding these vectors every frame
-            // is wasted CPU (string lookups + vector growth/clear).
-            static const Config* s_cachedActiveCfgPtr = nullptr;
-            static std::string s_cachedActiveModeId;
-            static bool s_cachedActiveImagesVisible = false;
-            static bool s_cachedActiveWindowOverlaysVisible = false;
-            static std::vector<MirrorConfig> s_cachedActiveMirrors;
-            static std::vector<ImageConfig> s_cachedActiveImages;
-            static std::vector<const WindowOverlayConfig*> s_cachedActiveWindowOverlays;
-
+            // Compiled overlay list for this mode - rebuilt only when the snapshot, mode, screen size or a
+            // visibility toggle changes, so in steady state this is a cache hit
             const bool imagesVisible = g_imageOverlaysVisible.load(std::memory_order_acquire);
             const bool windowOverlaysVisible = g_windowOverlaysVisible.load(std::memory_order_acquire);
+            const int listScreenW = GetCachedScreenWidth();
+            const int listScreenH = GetCachedScreenHeight();
+            std::shared_ptr<const ModeRenderList> renderList =
+                rt_modeRenderLists.Get(cfgSnapshot, request.modeHandle, listScreenW, listScreenH, imagesVisible, windowOverlaysVisible);
 
-            if (s_cachedActiveCfgPtr != &cfg || s_cachedActiveModeId != request.modeId || s_cachedActiveImagesVisible != imagesVisible ||
-                s_cachedActiveWindowOverlaysVisible != windowOverlaysVisible) {
-                PROFILE_SCOPE_CAT("RT Collect Active Elements", "Render Thread");
-                s_cachedActiveCfgPtr = &cfg;
-                s_cachedActiveModeId = request.modeId;
-                s_cachedActiveImagesVisible = imagesVisible;
-                s_cachedActiveWindowOverlaysVisible = windowOverlaysVisible;
-                RT_CollectActiveElements(cfg, request.modeId, false, s_cachedActiveMirrors, s_cachedActiveImages, s_cachedActiveWindowOverlays);
-            }
-
-            const std::vector<MirrorConfig>& activeMirrors = s_cachedActiveMirrors;
-            const std::vector<ImageConfig>& activeImages = s_cachedActiveImages;
-            const std::vector<const WindowOverlayConfig*>& activeWindowOverlays = s_cachedActiveWindowOverlays;
+            const std::vector<MirrorConfig>& activeMirrors = renderList->mirrors;
+            const std::vector<ImageConfig>& activeImages = renderList->images;
+            const std::vector<const WindowOverlayConfig*>& activeWindowOverlays = renderList->windowOverlays;
+            const float timelineSeconds = RT_OverlayTimelineSeconds(isObsRequest ? 1 : 0, request.modeHandle, iterationTime);
 
             // Determine whether anything is actually VISIBLE.
             // A mode can have items configured but fully transparent (opacity=0), which used to keep
@@ -3514,7 +3224,7 @@ static void RenderThreadFunc(void* gameGLContext) {
 
             const bool hasAnyVisibleOverlay = hasVisibleMirrors || hasVisibleImages || hasVisibleWindowOverlays;
 
-            // Check if we need to render any ImGui content
+            // Check if we need to render any ImGui content (EyeZoom draws its numbers with the ImGui fonts)
             bool shouldRenderAnyImGui = request.shouldRenderGui || request.showPerformanceOverlay || request.showProfiler ||
                                         request.showEyeZoom || request.showTextureGrid;
 
@@ -3605,120 +3315,182 @@ static void RenderThreadFunc(void* gameGLContext) {
 
                 if (readyTex != 0 && srcW > 0 && srcH > 0) {
                     PROFILE_SCOPE_CAT("RT EyeZoom Render", "Render Thread");
-                    RT_RenderEyeZoom(readyTex, request.eyeZoomAnimatedViewportX, request.fullW, request.fullH, srcW, srcH, renderVAO,
-                                     renderVBO, request.isTransitioningFromEyeZoom, request.eyeZoomSnapshotTexture,
-                                     request.eyeZoomSnapshotWidth, request.eyeZoomSnapshotHeight, &cfg.eyezoom);
+                    PROFILE_GPU_SCOPE("RT EyeZoom Render");
+                    RT_RenderEyeZoom(0, cfg.eyezoom, readyTex, request.eyeZoomAnimatedViewportX, request.fullW, request.fullH, srcW, srcH,
+                                     request.isTransitioningFromEyeZoom, request.eyeZoomFadeOpacity, !cfg.debug.disableOverlayLayerCache,
+                                     renderVAO, renderVBO);
                 }
             }
 
-            // Render mirrors using local shaders (skip in raw windowed mode)
-            if (!request.isRawWindowedMode && !activeMirrors.empty()) {
-                PROFILE_SCOPE_CAT("RT Mirror Render", "Render Thread");
-                // Swap ready buffers from capture thread (done on render thread to avoid main thread locks)
-                // This must happen before reading mirror textures
-                SwapMirrorBuffers();
-
-                // Determine if we're in EyeZoom mode (for the collected mirrors)
-                bool isEyeZoomMode = (request.modeId == "EyeZoom");
-
-                RT_RenderMirrors(activeMirrors, geo, request.fullW, request.fullH, request.overlayOpacity, excludeOoms,
-                                 request.relativeStretching, request.transitionProgress, request.mirrorSlideProgress, request.fromX,
-                                 request.fromY, request.fromW, request.fromH, request.toX, request.toY, request.toW, request.toH,
-                                 isEyeZoomMode, request.isTransitioningFromEyeZoom, request.eyeZoomAnimatedViewportX, request.skipAnimation,
-                                 request.fromModeId, request.fromSlideMirrorsIn, request.toSlideMirrorsIn, false /* isSlideOutPass */,
-                                 renderVAO, renderVBO);
-            }
+            // Mirrors, slide-outs, images and window overlays, in that order
+            auto renderOverlayStack = [&]() {
+                // Render mirrors using local shaders (skip in raw windowed mode)
+                if (!request.isRawWindowedMode && !activeMirrors.empty()) {
+                    PROFILE_SCOPE_CAT("RT Mirror Render", "Render Thread");
+                    PROFILE_GPU_SCOPE("RT Mirror Render");
+                    // Swap ready buffers from capture thread (done on render thread to avoid main thread locks)
+                    // This must happen before reading mirror textures
+                    SwapMirrorBuffers();
 
-            // When transitioning FROM EyeZoom, also render EyeZoom-specific mirrors with slide-out animation
-            // These mirrors are NOT in the target mode's mirror list, so they need a separate render pass
-            // Skip this pass entirely when skipAnimation is true - mirrors should disappear immediately
-            // Also skip in raw windowed mode - no overlays
-            if (!request.isRawWindowedMode && request.isTransitioningFromEyeZoom && cfg.eyezoom.slideMirrorsIn && !request.skipAnimation) {
-                PROFILE_SCOPE_CAT("RT EyeZoom Mirror Slide Out", "Render Thread");
-
-                // Collect EyeZoom mirrors (not the target mode's mirrors)
-                std::vector<MirrorConfig> eyeZoomMirrors;
-                std::vector<ImageConfig> unusedImages;
-                std::vector<const WindowOverlayConfig*> unusedOverlays;
-                RT_CollectActiveElements(cfg, "EyeZoom", false, eyeZoomMirrors, unusedImages, unusedOverlays);
-
-                // Filter out mirrors that already exist in the target mode (don't slide those out)
-                std::vector<MirrorConfig> mirrorsToSlideOut;
-                for (const auto& ezMirror : eyeZoomMirrors) {
-                    bool existsInTarget = false;
-                    for (const auto& targetMirror : activeMirrors) {
-                        if (targetMirror.name == ezMirror.name) {
-                            existsInTarget = true;
-                            break;
-                        }
-                    }
-                    if (!existsInTarget) { mirrorsToSlideOut.push_back(ezMirror); }
-                }
+                    // Determine if we're in EyeZoom mode (for the collected mirrors)
+                    bool isEyeZoomMode = (requestModeId == "EyeZoom");
 
-                if (!mirrorsToSlideOut.empty()) {
-                    // Render these EyeZoom mirrors with slide-out animation
-                    // isEyeZoomMode=true because these ARE EyeZoom mirrors
-                    // Pass request.modeId as fromModeId - this is the target mode we're transitioning TO
-                    RT_RenderMirrors(mirrorsToSlideOut, geo, request.fullW, request.fullH, request.overlayOpacity, excludeOoms,
+                    RT_RenderMirrors(*renderList, geo, request.fullW, request.fullH, request.overlayOpacity, excludeOoms,
                                      request.relativeStretching, request.transitionProgress, request.mirrorSlideProgress, request.fromX,
-                                     request.fromY, request.fromW, request.fromH, request.toX, request.toY, request.toW, request.toH, true,
-                                     request.isTransitioningFromEyeZoom, request.eyeZoomAnimatedViewportX, request.skipAnimation,
-                                     request.modeId, cfg.eyezoom.slideMirrorsIn, request.toSlideMirrorsIn, true /* isSlideOutPass */,
+                                     request.fromY, request.fromW, request.fromH, request.toX, request.toY, request.toW, request.toH,
+                                     isEyeZoomMode, request.isTransitioningFromEyeZoom, request.eyeZoomAnimatedViewportX, request.skipAnimation,
+                                     requestFromModeId, request.fromSlideMirrorsIn, request.toSlideMirrorsIn, false /* isSlideOutPass */,
                                      renderVAO, renderVBO);
                 }
-            }
 
-            // When transitioning FROM a mode with slideMirrorsIn (non-EyeZoom), render slide-out animation
-            // for mirrors unique to the FROM mode
-            // Skip animation when hideAnimationsInGame is enabled (skipAnimation flag)
-            if (!request.isTransitioningFromEyeZoom && request.fromSlideMirrorsIn && !request.fromModeId.empty() &&
-                request.mirrorSlideProgress < 1.0f && !request.skipAnimation) {
-                PROFILE_SCOPE_CAT("RT Generic Mirror Slide Out", "Render Thread");
-
-                // Collect FROM mode mirrors
-                std::vector<MirrorConfig> fromModeMirrors;
-                std::vector<ImageConfig> unusedImages;
-                std::vector<const WindowOverlayConfig*> unusedOverlays;
-                RT_CollectActiveElements(cfg, request.fromModeId, false, fromModeMirrors, unusedImages, unusedOverlays);
-
-                // Filter out mirrors that already exist in the target mode (don't slide those out)
-                std::vector<MirrorConfig> mirrorsToSlideOut;
-                for (const auto& fromMirror : fromModeMirrors) {
-                    bool existsInTarget = false;
-                    for (const auto& targetMirror : activeMirrors) {
-                        if (targetMirror.name == fromMirror.name) {
-                            existsInTarget = true;
-                            break;
-                        }
+                // When transitioning FROM EyeZoom, also render EyeZoom-specific mirrors with slide-out animation
+                // These mirrors are NOT in the target mode's mirror list, so they need a separate render pass
+                // Skip this pass entirely when skipAnimation is true - mirrors should disappear immediately
+                // Also skip in raw windowed mode - no overlays
+                if (!request.isRawWindowedMode && request.isTransitioningFromEyeZoom && cfg.eyezoom.slideMirrorsIn && !request.skipAnimation) {
+                    PROFILE_SCOPE_CAT("RT EyeZoom Mirror Slide Out", "Render Thread");
+
+                    // EyeZoom mirrors (not the target mode's mirrors), minus those the target mode also shows
+                    static const ModeIdHandle s_eyeZoomModeHandle = InternModeId("EyeZoom");
+                    std::shared_ptr<const ModeRenderList> eyeZoomList =
+                        rt_modeRenderLists.Get(cfgSnapshot, s_eyeZoomModeHandle, listScreenW, listScreenH, imagesVisible, windowOverlaysVisible);
+                    std::shared_ptr<const ModeRenderList> slideOutList = rt_modeRenderLists.GetSlideOut(eyeZoomList, renderList);
+
+                    if (!slideOutList->mirrors.empty()) {
+                        // Render these EyeZoom mirrors with slide-out animation
+                        // isEyeZoomMode=true because these ARE EyeZoom mirrors
+                        // Pass the request mode as fromModeId - this is the target mode we're transitioning TO
+                        RT_RenderMirrors(*slideOutList, geo, request.fullW, request.fullH, request.overlayOpacity, excludeOoms,
+                                         request.relativeStretching, request.transitionProgress, request.mirrorSlideProgress, request.fromX,
+                                         request.fromY, request.fromW, request.fromH, request.toX, request.toY, request.toW, request.toH, true,
+                                         request.isTransitioningFromEyeZoom, request.eyeZoomAnimatedViewportX, request.skipAnimation,
+                                         requestModeId, cfg.eyezoom.slideMirrorsIn, request.toSlideMirrorsIn, true /* isSlideOutPass */,
+                                         renderVAO, renderVBO);
                     }
-                    if (!existsInTarget) { mirrorsToSlideOut.push_back(fromMirror); }
                 }
 
-                if (!mirrorsToSlideOut.empty()) {
-                    // Render these mirrors with slide-out animation
-                    RT_RenderMirrors(mirrorsToSlideOut, geo, request.fullW, request.fullH, request.overlayOpacity, excludeOoms,
-                                     request.relativeStretching, request.transitionProgress, request.mirrorSlideProgress, request.fromX,
-                                     request.fromY, request.fromW, request.fromH, request.toX, request.toY, request.toW, request.toH, false,
-                                     false, -1, request.skipAnimation, request.modeId, request.fromSlideMirrorsIn, request.toSlideMirrorsIn,
-                                     true /* isSlideOutPass */, renderVAO, renderVBO);
+                // When transitioning FROM a mode with slideMirrorsIn (non-EyeZoom), render slide-out animation
+                // for mirrors unique to the FROM mode
+                // Skip animation when hideAnimationsInGame is enabled (skipAnimation flag)
+                if (!request.isTransitioningFromEyeZoom && request.fromSlideMirrorsIn && !requestFromModeId.empty() &&
+                    request.mirrorSlideProgress < 1.0f && !request.skipAnimation) {
+                    PROFILE_SCOPE_CAT("RT Generic Mirror Slide Out", "Render Thread");
+
+                    // FROM mode mirrors, minus those the target mode also shows
+                    std::shared_ptr<const ModeRenderList> fromList =
+                        rt_modeRenderLists.Get(cfgSnapshot, request.fromModeHandle, listScreenW, listScreenH, imagesVisible, windowOverlaysVisible);
+                    std::shared_ptr<const ModeRenderList> slideOutList = rt_modeRenderLists.GetSlideOut(fromList, renderList);
+
+                    if (!slideOutList->mirrors.empty()) {
+                        // Render these mirrors with slide-out animation
+                        RT_RenderMirrors(*slideOutList, geo, request.fullW, request.fullH, request.overlayOpacity, excludeOoms,
+                                         request.relativeStretching, request.transitionProgress, request.mirrorSlideProgress, request.fromX,
+                                         request.fromY, request.fromW, request.fromH, request.toX, request.toY, request.toW, request.toH, false,
+                                         false, -1, request.skipAnimation, requestModeId, request.fromSlideMirrorsIn, request.toSlideMirrorsIn,
+                                         true /* isSlideOutPass */, renderVAO, renderVBO);
+                    }
                 }
-            }
 
-            // Render images using local shaders (skip in raw windowed mode)
-            if (!request.isRawWindowedMode && !activeImages.empty()) {
-                PROFILE_SCOPE_CAT("RT Image Render", "Render Thread");
-                RT_RenderImages(activeImages, request.fullW, request.fullH, request.toX, request.toY, request.toW, request.toH,
-                                request.gameW, request.gameH, request.relativeStretching, request.transitionProgress, request.fromX,
-                                request.fromY, request.fromW, request.fromH, request.overlayOpacity, excludeOoms, renderVAO, renderVBO);
-            }
+                // Render images using local shaders (skip in raw windowed mode)
+                if (!request.isRawWindowedMode && !activeImages.empty()) {
+                    PROFILE_SCOPE_CAT("RT Image Render", "Render Thread");
+                    PROFILE_GPU_SCOPE("RT Image Render");
+                    const int layerIdx = isObsRequest ? 1 : 0;
+                    RetainedOverlayLayer& imageLayer = rt_imageLayers[layerIdx];
+                    bool composited = false;
+                    if (!cfg.debug.disableOverlayLayerCache) {
+                        const uint64_t layerHash = RT_HashImageLayer(
+                            renderList.get(), timelineSeconds, request.fullW, request.fullH, request.toX, request.toY, request.toW, request.toH,
+                            request.gameW, request.gameH, request.relativeStretching, request.transitionProgress, request.fromX, request.fromY,
+                            request.fromW, request.fromH, request.overlayOpacity, excludeOoms);
+                        rt_imageLayerLists[layerIdx] = renderList;
+                        if (imageLayer.NoteContent(layerHash)) {
+                            if (imageLayer.BeginUpdate(layerHash, request.fullW, request.fullH)) {
+                                PROFILE_SCOPE_CAT("RT Image Layer Update", "Render Thread");
+                                OverlayLayerRegion drawn;
+                                RT_RenderImages(activeImages, renderList->imageTimelines, timelineSeconds, request.fullW, request.fullH,
+                                                request.toX, request.toY, request.toW, request.toH, request.gameW, request.gameH,
+                                                request.relativeStretching, request.transitionProgress, request.fromX, request.fromY,
+                                                request.fromW, request.fromH, request.overlayOpacity, excludeOoms, renderVAO, renderVBO, &drawn);
+                                imageLayer.EndUpdate(drawn);
+                            }
+                            if (imageLayer.IsValid()) {
+                                RT_CompositeOverlayLayer(imageLayer, renderVAO, renderVBO);
+                                composited = true;
+                            }
+                        }
+                    } else if (imageLayer.IsValid()) {
+                        imageLayer.Release();
+                        rt_imageLayerLists[layerIdx].reset();
+                    }
+                    if (!composited) {
+                        RT_RenderImages(activeImages, renderList->imageTimelines, timelineSeconds, request.fullW, request.fullH, request.toX,
+                                        request.toY, request.toW, request.toH, request.gameW, request.gameH, request.relativeStretching,
+                                        request.transitionProgress, request.fromX, request.fromY, request.fromW, request.fromH,
+                                        request.overlayOpacity, excludeOoms, renderVAO, renderVBO);
+                    }
+                }
 
-            // Render window overlays using local shaders
-            if (!activeWindowOverlays.empty()) {
-                PROFILE_SCOPE_CAT("RT Window Overlay Render", "Render Thread");
-                RT_RenderWindowOverlays(activeWindowOverlays, request.fullW, request.fullH, request.toX, request.toY, request.toW,
-                                        request.toH, request.gameW, request.gameH, request.relativeStretching, request.transitionProgress,
-                                        request.fromX, request.fromY, request.fromW, request.fromH, request.overlayOpacity, excludeOoms,
-                                        renderVAO, renderVBO);
+                // Render window overlays using local shaders
+                if (!activeWindowOverlays.empty()) {
+                    PROFILE_SCOPE_CAT("RT Window Overlay Render", "Render Thread");
+                    PROFILE_GPU_SCOPE("RT Window Overlay Render");
+                    RT_RenderWindowOverlays(activeWindowOverlays, renderList->windowOverlayTimelines, timelineSeconds, request.fullW,
+                                            request.fullH, request.toX, request.toY, request.toW, request.toH, request.gameW, request.gameH,
+                                            request.relativeStretching, request.transitionProgress, request.fromX, request.fromY,
+                                            request.fromW, request.fromH, request.overlayOpacity, excludeOoms, renderVAO, renderVBO);
+                }
+            };
+
+            // When the on-screen pass of this iteration would draw the same stack (steady state: same mode,
+            // geometry and opacity, and no onlyOnMyScreen items to tell the passes apart), the OBS pass renders
+            // it once into rt_sharedOverlayStack and both passes composite that texture.
+            if (isObsRequest && hasPendingMain) {
+                if (!cfg.debug.disableOverlayLayerCache) {
+                    std::shared_ptr<const ModeRenderList> mainList = rt_modeRenderLists.Get(
+                        cfgSnapshot, pendingMainRequest.modeHandle, listScreenW, listScreenH, imagesVisible, windowOverlaysVisible);
+                    const float mainTimelineSeconds = RT_OverlayTimelineSeconds(0, pendingMainRequest.modeHandle, iterationTime);
+                    const uint64_t stackKey = HashOverlayStack(request, true, *renderList, timelineSeconds);
+                    rt_sharedOverlayStack.Invalidate(); // Never reuse a previous iteration's mirror contents
+                    if (stackKey == HashOverlayStack(pendingMainRequest, false, *mainList, mainTimelineSeconds) &&
+                        rt_sharedOverlayStack.BeginUpdate(stackKey, request.fullW, request.fullH)) {
+                        {
+                            PROFILE_SCOPE_CAT("RT Shared Overlay Stack Update", "Render Thread");
+                            renderOverlayStack();
+                        }
+                        // Mirrors do not report what they cover, so the stack is composited whole
+                        OverlayLayerRegion everything;
+                        everything.Include(-1.0f, -1.0f, 1.0f, 1.0f);
+                        rt_sharedOverlayStack.EndUpdate(everything);
+                        if (rt_sharedOverlayStack.IsValid()) {
+                            sharedStackReady = true;
+                            sharedStackKey = stackKey;
+                            sharedStackList = renderList;
+                        }
+                    }
+                } else {
+                    rt_sharedOverlayStack.Release();
+                }
+                PROFILE_HITS("RT Overlay Stack Shared", sharedStackReady ? 1 : 0, 1);
+
+                if (sharedStackReady) {
+                    RT_CompositeOverlayLayer(rt_sharedOverlayStack, renderVAO, renderVBO);
+                } else {
+                    renderOverlayStack();
+                }
+            } else if (!isObsRequest && sharedStackReady) {
+                // The snapshot or mode may have changed since the OBS pass; draw directly unless the key still matches
+                if (HashOverlayStack(request, false, *renderList, timelineSeconds) == sharedStackKey) {
+                    PROFILE_SCOPE_CAT("RT Shared Overlay Stack Composite", "Render Thread");
+                    RT_CompositeOverlayLayer(rt_sharedOverlayStack, renderVAO, renderVBO);
+                } else {
+                    renderOverlayStack();
+                }
+                rt_sharedOverlayStack.Invalidate();
+                sharedStackReady = false;
+                sharedStackList.reset();
+            } else {
+                renderOverlayStack();
             }
 
             // Render ImGui to overlay FBO (if enabled) - runs every frame when any overlay is active
@@ -3782,6 +3554,7 @@ static void RenderThreadFunc(void* gameGLContext) {
                         }
 
                         g_fontsValid = true;
+                        g_fontGeneration++;
                         Log("Render Thread: Fonts reloaded successfully");
                     }
                 }
@@ -3811,128 +3584,6 @@ static void RenderThreadFunc(void* gameGLContext) {
                     RenderTextureGridOverlay(true, request.textureGridModeWidth, request.textureGridModeHeight);
                 }
 
-                // Render eye zoom text labels directly for all request types
-                // Boxes and text are now both rendered in the same FBO using the same request values,
-                // so they stay synchronized during transitions
-                // Skip text rendering when fonts are being rebuilt to avoid rendering with invalid font data
-                if (request.showEyeZoom && request.eyeZoomFadeOpacity > 0.0f && g_fontsValid) {
-                    // Calculate EyeZoom text positions directly
-                    EyeZoomConfig zoomConfig = cfg.eyezoom;
-
-                    // Calculate target position
-                    int modeWidth = zoomConfig.windowWidth;
-                    int targetViewportX = (request.fullW - modeWidth) / 2;
-
-                    // Use request.eyeZoomAnimatedViewportX - this already accounts for hideAnimationsInGame
-                    // (caller sets to -1 when skipAnimation is true, meaning use target position)
-                    int viewportX = (request.eyeZoomAnimatedViewportX >= 0) ? request.eyeZoomAnimatedViewportX : targetViewportX;
-
-                    // Calculate dimensions and position - must match RT_RenderEyeZoom logic
-                    int zoomOutputWidth, zoomX;
-                    // Use request value, NOT global atomic - ensures text and boxes use identical transition state
-                    bool isTransitioningFromEyeZoom = request.isTransitioningFromEyeZoom;
-                    bool isTransitioningToEyeZoom = (viewportX < targetViewportX && !isTransitioningFromEyeZoom);
-
-                    if (zoomConfig.slideZoomIn) {
-                        // SLIDE MODE: Full size, sliding X position
-                        zoomOutputWidth = targetViewportX - (2 * zoomConfig.horizontalMargin);
-                        int finalZoomX = zoomConfig.horizontalMargin;
-                        int offScreenX = -zoomOutputWidth;
-
-                        if (isTransitioningToEyeZoom && targetViewportX > 0) {
-                            // Sliding IN
-                            float progress = (float)viewportX / (float)targetViewportX;
-                            zoomX = offScreenX + (int)((finalZoomX - offScreenX) * progress);
-                        } else if (isTransitioningFromEyeZoom && targetViewportX > 0) {
-                            // Sliding OUT
-                            float progress = (float)viewportX / (float)targetViewportX;
-                            zoomX = offScreenX + (int)((finalZoomX - offScreenX) * progress);
-                        } else {
-                            zoomX = finalZoomX;
-                        }
-                    } else {
-                        // GROW MODE: Growing size, fixed X position
-                        zoomOutputWidth = viewportX - (2 * zoomConfig.horizontalMargin);
-                        zoomX = zoomConfig.horizontalMargin;
-                    }
-
-                    if (viewportX > 0 && zoomOutputWidth > 20) {
-
-                        int zoomOutputHeight = request.fullH - (2 * zoomConfig.verticalMargin);
-                        int minHeight = (int)(0.2f * request.fullH);
-                        if (zoomOutputHeight < minHeight) zoomOutputHeight = minHeight;
-
-                        int zoomY = zoomConfig.verticalMargin;
-
-                        // Calculate per-box width based on the actual output width
-                        float pixelWidthOnScreen = zoomOutputWidth / (float)zoomConfig.cloneWidth;
-                        int labelsPerSide = zoomConfig.cloneWidth / 2;
-                        int overlayLabelsPerSide = zoomConfig.overlayWidth;
-                        if (overlayLabelsPerSide < 0) overlayLabelsPerSide = labelsPerSide;
-                        if (overlayLabelsPerSide > labelsPerSide) overlayLabelsPerSide = labelsPerSide;
-                        float centerY = zoomY + zoomOutputHeight / 2.0f;
-
-                        ImDrawList* drawList = request.shouldRenderGui ? ImGui::GetBackgroundDrawList() : ImGui::GetForegroundDrawList();
-                        // Font sizing:
-                        // - autoFontSize=true: auto-fit down to box size (keeps numbers inside the boxes)
-                        // - autoFontSize=false: manual override, bypass all auto-fit clamps
-                        float requestedFontSize = (float)zoomConfig.textFontSize;
-                        if (requestedFontSize < 1.0f) requestedFontSize = 1.0f;
-
-                        float fontSize = requestedFontSize;
-                        if (zoomConfig.autoFontSize) {
-                            // Auto-scale font size down based on the current box size.
-                            // Even though overlayWidth only changes how many boxes are drawn, users often adjust these settings together;
-                            // scaling by box size ensures the numbers always fit.
-                            float boxHeight = zoomConfig.linkRectToFont ? (requestedFontSize * 1.2f) : (float)zoomConfig.rectHeight;
-                            // Note: padding factors intentionally leave headroom so digits don't touch borders.
-                            // Slightly relaxed to avoid the auto-fit looking too small.
-                            float maxFontByWidth = pixelWidthOnScreen * 0.90f; // leave some horizontal padding
-                            float maxFontByHeight = boxHeight * 0.85f;          // leave some vertical padding
-                            if (maxFontByWidth > 0.0f) fontSize = (std::min)(fontSize, maxFontByWidth);
-                            if (maxFontByHeight > 0.0f) fontSize = (std::min)(fontSize, maxFontByHeight);
-                            if (fontSize < 6.0f) fontSize = 6.0f;
-                        }
-                        // Combine textColorOpacity with the fade opacity
-                        float finalTextAlpha = zoomConfig.textColorOpacity * request.eyeZoomFadeOpacity;
-                        ImU32 textColor =
-                            IM_COL32(static_cast<int>(zoomConfig.textColor.r * 255), static_cast<int>(zoomConfig.textColor.g * 255),
-                                     static_cast<int>(zoomConfig.textColor.b * 255), static_cast<int>(finalTextAlpha * 255));
-
-                        // Get the font to use for rendering (use EyeZoom-specific font if available)
-                        ImFont* font = g_eyeZoomTextFont ? g_eyeZoomTextFont : ImGui::GetFont();
-
-                        for (int xOffset = -overlayLabelsPerSide; xOffset <= overlayLabelsPerSide; xOffset++) {
-                            if (xOffset == 0) continue;
-
-                            int boxIndex = xOffset + labelsPerSide - (xOffset > 0 ? 1 : 0);
-                            float boxLeft = zoomX + (boxIndex * pixelWidthOnScreen);
-
-                            int displayNumber = abs(xOffset);
-                            std::string text = std::to_string(displayNumber);
-
-                            // Shrink further for multi-digit numbers if needed to fit inside a single box.
-                            // (Auto mode only; manual override intentionally bypasses all fit limits.)
-                            float finalFontSize = fontSize;
-                            ImVec2 textSize = font->CalcTextSizeA(finalFontSize, FLT_MAX, 0.0f, text.c_str());
-                            if (zoomConfig.autoFontSize) {
-                                float maxTextWidth = pixelWidthOnScreen * 0.94f;
-                                if (maxTextWidth > 0.0f && textSize.x > maxTextWidth && textSize.x > 0.0f) {
-                                    float scale = maxTextWidth / textSize.x;
-                                    finalFontSize = (std::max)(6.0f, finalFontSize * scale);
-                                    textSize = font->CalcTextSizeA(finalFontSize, FLT_MAX, 0.0f, text.c_str());
-                                }
-                            }
-                            float numberCenterX = boxLeft + pixelWidthOnScreen / 2.0f;
-                            float numberCenterY = centerY;
-                            ImVec2 textPos(numberCenterX - textSize.x / 2.0f, numberCenterY - textSize.y / 2.0f);
-
-                            // Use AddText overload with font and fontSize to render at configured size
-                            drawList->AddText(font, finalFontSize, textPos, textColor, text.c_str());
-                        }
-                    }
-                }
-
                 // Render texture grid labels
                 RenderCachedTextureGridLabels();
 
@@ -4085,12 +3736,41 @@ static void RenderThreadFunc(void* gameGLContext) {
                 g_avgRenderTimeMs.store(avg * 0.95 + renderTime * 0.05);
 
                 g_framesRendered.fetch_add(1);
+
+                // Recorded overlay draws that could share a draw with the one before them (same program, texture and blend)
+                PROFILE_HITS("RT Draw Commands Batchable", rt_frameCommandStats.batchable, rt_frameCommandStats.commands);
+                rt_frameCommandStats = RenderCommandStats{};
+
+                // Texture uploads that found room in the upload ring (the rest went through client memory)
+                if (std::shared_ptr<StreamingUploadRing> ring = GetStreamingUploadRing()) {
+                    StreamingUploadStats uploadStats = ring->TakeStats();
+                    PROFILE_HITS("Texture Uploads Streamed", uploadStats.reserved, uploadStats.reserved + uploadStats.failed);
+                }
             }
         }
 
         Log("Render Thread: Cleaning up...");
 
         // Cleanup
+        for (int i = 0; i < 2; i++) {
+            rt_imageLayers[i].Release();
+            rt_imageLayerLists[i].reset();
+        }
+        rt_sharedOverlayStack.Release();
+        RT_ReleaseEyeZoomPasses();
+        {
+            std::shared_ptr<StreamingUploadRing> ring;
+            {
+                std::lock_guard<std::mutex> lock(g_streamingUploadsMutex);
+                ring.swap(g_streamingUploads);
+            }
+            // Waits for a capture thread still writing a frame into it
+            if (ring) { ring->Close(); }
+        }
+        // Nothing retires this queue once the context is gone
+        GpuResourceManager::Get().Flush(GpuContextQueue::RenderThread);
+        rt_modeRenderLists.Clear();
+        rt_renderCommands.Clear();
         RT_CleanupShaders();
         CleanupRenderFBOs();
         if (renderVAO) glDeleteVertexArrays(1, &renderVAO);
@@ -4202,8 +3882,8 @@ void StartRenderThread(void* gameGLContext) {
     // Reset state
     g_renderThreadShouldStop.store(false);
     g_renderThreadRunning.store(true);
-    g_requestReadySlot.store(-1);
-    g_obsReadySlot.store(-1);
+    g_requestMailbox.Reset();
+    g_obsMailbox.Reset();
     g_frameComplete.store(false);
     g_obsFrameComplete.store(false);
     g_writeFBOIndex.store(0);
@@ -4239,30 +3919,11 @@ void StopRenderThread() {
 }
 
 void SubmitFrameForRendering(const FrameRenderRequest& request) {
-    // Lock-free submission using double-buffered slots
+    // Lock-free submission through the latest-value mailbox
     // Main thread ALWAYS succeeds - never blocks waiting for render thread
 
     // If there was an unread request in the mailbox, this submission overwrites it (drop).
-    if (g_requestReadySlot.load(std::memory_order_relaxed) != -1) { g_framesDropped.fetch_add(1, std::memory_order_relaxed); }
-
-    // Write to a slot that is NOT currently being copied by the render thread.
-    // With only 2 slots, a fast producer can otherwise lap and overwrite the slot being read.
-    int writeSlot = g_requestWriteSlot.load(std::memory_order_relaxed);
-    int readSlotInUse = g_requestReadSlot.load(std::memory_order_acquire);
-    if (writeSlot == readSlotInUse) { writeSlot = 1 - writeSlot; }
-    if (writeSlot == readSlotInUse) {
-        // Extremely unlikely (would require invalid state), but never risk a data race.
-        g_framesDropped.fetch_add(1, std::memory_order_relaxed);
-        return;
-    }
-    g_requestSlots[writeSlot] = request;
-
-    // Swap write slot so next submission goes to the other slot
-    // This also tells render thread which slot to read from (the one we just wrote)
-    g_requestWriteSlot.store(1 - writeSlot, std::memory_order_relaxed);
-
-    // Publish to mailbox AFTER the full struct write completes.
-    g_requestReadySlot.store(writeSlot, std::memory_order_release);
+    if (g_requestMailbox.Publish(request)) { g_framesDropped.fetch_add(1, std::memory_order_relaxed); }
     g_frameComplete.store(false, std::memory_order_relaxed);
 
     // Signal the condition variable (brief lock only for CV, not for data protection)
@@ -4318,7 +3979,7 @@ void SubmitRenderFBOConsumerFence(int fboIndex, GLsync consumerFence) {
 }
 
 void SubmitObsFrameContext(const ObsFrameSubmission& submission) {
-    // Lock-free submission using double-buffered slots
+    // Lock-free submission through the latest-value mailbox
     // Main thread ALWAYS succeeds - never blocks waiting for render thread
 
     // NOTE: We do NOT delete fences here even if overwriting a pending submission.
@@ -4328,25 +3989,7 @@ void SubmitObsFrameContext(const ObsFrameSubmission& submission) {
     // Occasional fence leaks from dropped frames are acceptable and rare.
 
     // If there was an unread OBS submission in the mailbox, this submission overwrites it (drop).
-    if (g_obsReadySlot.load(std::memory_order_relaxed) != -1) { g_framesDropped.fetch_add(1, std::memory_order_relaxed); }
-
-    // Write to a slot that is NOT currently being copied by the render thread.
-    int writeSlot = g_obsWriteSlot.load(std::memory_order_relaxed);
-    int readSlotInUse = g_obsReadSlot.load(std::memory_order_acquire);
-    if (writeSlot == readSlotInUse) { writeSlot = 1 - writeSlot; }
-    if (writeSlot == readSlotInUse) {
-        // Avoid data race on ObsFrameSubmission (contains std::string in context).
-        // If this happens, drop the submission.
-        g_framesDropped.fetch_add(1, std::memory_order_relaxed);
-        return;
-    }
-    g_obsSubmissionSlots[writeSlot] = submission;
-
-    // Swap write slot
-    g_obsWriteSlot.store(1 - writeSlot, std::memory_order_relaxed);
-
-    // Publish to mailbox AFTER the full struct write completes.
-    g_obsReadySlot.store(writeSlot, std::memory_order_release);
+    if (g_obsMailbox.Publish(submission)) { g_framesDropped.fetch_add(1, std::memory_order_relaxed); }
     g_obsFrameComplete.store(false, std::memory_order_relaxed);
 
     // Signal the condition variable
@@ -4376,7 +4019,9 @@ FrameRenderRequest BuildObsFrameRequest(const ObsFrameContext& ctx, bool isDualR
     if (!obsCfgSnap) return {}; // Config not yet published
     const Config& obsCfg = *obsCfgSnap;
 
-    ModeTransitionState transitionState = GetModeTransitionState();
+    // The OBS frame is presented now, not when the game thread submitted it; evaluate the transition for that
+    ModeTransitionState transitionState = GetModeTransitionState(TransitionClock::now());
+    const std::string& ctxModeId = ModeIdName(ctx.modeHandle);
 
     FrameRenderRequest req;
     req.frameNumber = ++s_obsFrameNumber;
@@ -4385,21 +4030,21 @@ FrameRenderRequest BuildObsFrameRequest(const ObsFrameContext& ctx, bool isDualR
     req.gameW = ctx.gameW;
     req.gameH = ctx.gameH;
     req.gameTextureId = ctx.gameTextureId;
-    req.modeId = ctx.modeId;
+    req.modeHandle = ctx.modeHandle;
     req.overlayOpacity = 1.0f;
     req.obsDetected = true;
     req.excludeOnlyOnMyScreen = true;
     req.skipAnimation = false;
     req.isObsPass = true;
     req.relativeStretching = ctx.relativeStretching;
-    req.fromModeId = transitionState.fromModeId; // For source mirror check in sliding animation
+    req.fromModeHandle = transitionState.fromModeHandle; // For source mirror check in sliding animation
 
     // Slide mirrors animation settings
     if (!transitionState.fromModeId.empty()) {
         const ModeConfig* fromMode = GetModeFromSnapshot(obsCfg, transitionState.fromModeId);
         if (fromMode) { req.fromSlideMirrorsIn = fromMode->slideMirrorsIn; }
     }
-    const ModeConfig* toMode = GetModeFromSnapshot(obsCfg, ctx.modeId);
+    const ModeConfig* toMode = GetModeFromSnapshot(obsCfg, ctxModeId);
     if (toMode) { req.toSlideMirrorsIn = toMode->slideMirrorsIn; }
 
     // Mirror slide progress - uses actual moveProgress independent of overlay transition type
@@ -4598,7 +4243,7 @@ FrameRenderRequest BuildObsFrameRequest(const ObsFrameContext& ctx, bool isDualR
     }
 
     // Background color - check for fullscreen transition
-    bool transitioningToFullscreen = EqualsIgnoreCase(ctx.modeId, "Fullscreen") && !transitionState.fromModeId.empty();
+    bool transitioningToFullscreen = EqualsIgnoreCase(ctxModeId, "Fullscreen") && !transitionState.fromModeId.empty();
     if (transitioningToFullscreen && !transitionEffectivelyComplete) {
         const ModeConfig* fromMode = GetModeFromSnapshot(obsCfg, transitionState.fromModeId);
         if (fromMode) {
@@ -4617,7 +4262,7 @@ FrameRenderRequest BuildObsFrameRequest(const ObsFrameContext& ctx, bool isDualR
     }
 
     // Mode border config - look up from current mode
-    const ModeConfig* currentMode = GetModeFromSnapshot(obsCfg, ctx.modeId);
+    const ModeConfig* currentMode = GetModeFromSnapshot(obsCfg, ctxModeId);
     if (currentMode) {
         req.borderEnabled = currentMode->border.enabled;
         req.borderR = currentMode->border.color.r;
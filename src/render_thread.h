@@ -7,21 +7,28 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#include "mode_ids.h"
+
 // Forward declarations - render thread looks up configs directly from g_config
 struct ModeConfig;
 struct MirrorConfig;
 struct ImageConfig;
 struct GLState;
 struct GameViewportGeometry;
+class StreamingUploadRing;
+struct StreamingUpload;
 
 constexpr int RENDER_THREAD_FBO_COUNT = 3; // Triple buffering
 
 // Lightweight struct - render thread looks up active elements from g_config directly
-// This avoids expensive vector copies on every frame
+// This avoids expensive vector copies on every frame. Must stay trivially copyable (no strings or
+// containers): it is handed to the render thread through a SeqlockMailbox.
 struct FrameRenderRequest {
     // Frame identification
     uint64_t frameNumber = 0;
@@ -43,7 +50,7 @@ struct FrameRenderRequest {
     GLuint gameTextureId = 0;
 
     // Mode ID - render thread looks up ModeConfig and collects active elements
-    std::string modeId;
+    ModeIdHandle modeHandle = MODE_ID_NONE;
 
     // Transition state
     bool isAnimating = false;
@@ -106,7 +113,7 @@ struct FrameRenderRequest {
     float fromBorderB = 1.0f;
     int fromBorderWidth = 0;
     int fromBorderRadius = 0;
-    std::string fromModeId; // For looking up from-mode's background texture
+    ModeIdHandle fromModeHandle = MODE_ID_NONE; // For looking up from-mode's background texture
 
     // Slide mirrors animation - per-mode setting for mirror slide in/out
     bool fromSlideMirrorsIn = false;  // FROM mode's slideMirrorsIn setting
@@ -150,6 +157,7 @@ struct FrameRenderRequest {
     bool isPre113Windowed = false;  // true if isWindowed && g_gameVersion < 1.13.0
     bool isRawWindowedMode = false; // true = just blit raw game content + cursor, skip all overlays
 };
+static_assert(std::is_trivially_copyable_v<FrameRenderRequest>, "FrameRenderRequest is passed through a seqlock mailbox");
 
 extern std::atomic<bool> g_renderThreadRunning;
 extern std::atomic<uint64_t> g_renderFrameNumber;
@@ -205,6 +213,19 @@ CompletedRenderFrame GetCompletedRenderFrame();
 // Render thread: waits on this before reusing that FBO as a render target.
 void SubmitRenderFBOConsumerFence(int fboIndex, GLsync consumerFence);
 
+// === Texture streaming ===
+// The render thread's persistently mapped upload ring (streaming_upload.h), or nullptr while the render thread
+// is not running or the driver lacks GL_ARB_buffer_storage. Producers on other threads reserve space in it and
+// write their pixels directly; the render thread then only issues the copy.
+std::shared_ptr<StreamingUploadRing> GetStreamingUploadRing();
+
+// Render thread: fill level 0 of the texture bound to GL_TEXTURE_2D (already allocated) with tightly packed
+// RGBA8 pixels. Goes through the upload ring when it has room, else uploads from client memory.
+void UploadTexturePixels(int width, int height, const void* rgba);
+// Same, for pixels a producer already wrote into the ring. Consumes `upload`; false (nothing uploaded) when it
+// belongs to a ring that has since been closed
+bool UploadTexturePixels(int width, int height, StreamingUpload& upload);
+
 // Get the texture from the completed OBS render
 // Returns 0 if no texture is ready
 GLuint GetCompletedObsTexture();
@@ -221,7 +242,7 @@ struct ObsFrameContext {
     int fullW = 0, fullH = 0;
     int gameW = 0, gameH = 0;
     GLuint gameTextureId = 0;
-    std::string modeId;
+    ModeIdHandle modeHandle = MODE_ID_NONE;
     bool relativeStretching = false;
     float bgR = 0.0f, bgG = 0.0f, bgB = 0.0f;
 
@@ -255,6 +276,7 @@ struct ObsFrameSubmission {
     GLsync gameTextureFence = nullptr;
     bool isDualRenderingPath = false;
 };
+static_assert(std::is_trivially_copyable_v<ObsFrameSubmission>, "ObsFrameSubmission is passed through a seqlock mailbox");
 
 // Lightweight OBS submission - defers BuildObsFrameRequest to render thread
 // This is more efficient as it avoids lock-free reads and struct building on main thread
@@ -0,0 +1,81 @@
+#pragma once
+
+// ============================================================================
+// SEQLOCK_MAILBOX.H - Single-producer/single-consumer latest-value mailbox
+// ============================================================================
+// The producer overwrites the slot without ever waiting; the consumer takes the newest value or
+// learns there is none. A sequence counter is odd while a write is in progress and advances by 2 per
+// publish, so the consumer detects torn reads (counter changed during its copy) and simply retries.
+//
+// The payload is stored as relaxed atomic 64-bit words rather than a plain T, so concurrent reads and
+// writes are well-defined C++ (and clean under ThreadSanitizer). That requires T to be trivially
+// copyable - FrameRenderRequest and ObsFrameSubmission are kept that way for this reason.
+// ============================================================================
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+template <typename T> class SeqlockMailbox {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqlockMailbox payload must be trivially copyable");
+    static constexpr size_t WORD_COUNT = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  public:
+    // Producer only. Returns true if the previous value was never consumed (it is dropped).
+    bool Publish(const T& value) {
+        const uint64_t seq = m_seq.load(std::memory_order_relaxed);
+        const bool overwritten = m_consumedSeq.load(std::memory_order_relaxed) != seq;
+        m_seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release); // Odd counter is visible before any payload word
+
+        const unsigned char* src = reinterpret_cast<const unsigned char*>(&value);
+        for (size_t i = 0; i < WORD_COUNT; i++) {
+            uint64_t word = 0;
+            std::memcpy(&word, src + i * sizeof(uint64_t), WordBytes(i));
+            m_words[i].store(word, std::memory_order_relaxed);
+        }
+        m_seq.store(seq + 2, std::memory_order_release);
+        return overwritten;
+    }
+
+    // Consumer only. Copies the newest value into `out` if one was published since the last consume;
+    // `out` is left untouched when this returns false.
+    bool TryConsume(T& out) {
+        unsigned char* dst = reinterpret_cast<unsigned char*>(&out);
+        for (;;) {
+            const uint64_t before = m_seq.load(std::memory_order_acquire);
+            if (before == m_consumedSeq.load(std::memory_order_relaxed)) return false;
+            if (before & 1) {
+                std::this_thread::yield(); // Producer is mid-write; it never blocks, so this is short
+                continue;
+            }
+            // Copy straight into `out`: a torn copy is simply overwritten by the retry
+            for (size_t i = 0; i < WORD_COUNT; i++) {
+                const uint64_t word = m_words[i].load(std::memory_order_relaxed);
+                std::memcpy(dst + i * sizeof(uint64_t), &word, WordBytes(i));
+            }
+            std::atomic_thread_fence(std::memory_order_acquire); // Payload loads complete before re-checking the counter
+            if (m_seq.load(std::memory_order_relaxed) != before) continue; // Torn: a newer value was written meanwhile
+
+            m_consumedSeq.store(before, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // True if a value was published since the last consume (e.g. a condition variable predicate)
+    bool HasPending() const { return m_seq.load(std::memory_order_acquire) != m_consumedSeq.load(std::memory_order_relaxed); }
+
+    // Drop any pending value. Only while neither side is running.
+    void Reset() { m_consumedSeq.store(m_seq.load(std::memory_order_relaxed), std::memory_order_relaxed); }
+
+  private:
+    static constexpr size_t WordBytes(size_t i) {
+        return (i + 1) * sizeof(uint64_t) <= sizeof(T) ? sizeof(uint64_t) : sizeof(T) - i * sizeof(uint64_t);
+    }
+
+    std::atomic<uint64_t> m_seq{ 0 };
+    std::atomic<uint64_t> m_consumedSeq{ 0 }; // Written by the consumer; read by the producer for drop stats
+    std::atomic<uint64_t> m_words[WORD_COUNT] = {};
+};
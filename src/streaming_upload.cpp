@@ -0,0 +1,237 @@
+// ============================================================================
+// STREAMING_UPLOAD.CPP - Persistently mapped upload ring for texture streaming
+// ============================================================================
+
+#include "streaming_upload.h"
+
+#ifndef GLEW_STATIC
+#define GLEW_STATIC
+#endif
+#include <GL/glew.h>
+
+namespace {
+
+size_t AlignUp(size_t v) { return (v + StreamingUploadRing::ALIGNMENT - 1) & ~(StreamingUploadRing::ALIGNMENT - 1); }
+
+class GLStreamingUploadBackend final : public StreamingUploadBackend {
+  public:
+    static bool IsSupported() { return GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage; }
+
+    uint8_t* CreateStorage(size_t bytes) override {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glGenBuffers(1, &m_buffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_buffer);
+        glBufferStorage(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, flags);
+        void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes), flags);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        if (!mapped) { DestroyStorage(); }
+        return static_cast<uint8_t*>(mapped);
+    }
+    void DestroyStorage() override {
+        if (!m_buffer) return;
+        // Deleting a mapped buffer unmaps it
+        glDeleteBuffers(1, &m_buffer);
+        m_buffer = 0;
+    }
+    uint32_t StorageBuffer() const override { return m_buffer; }
+
+    uint64_t InsertFence() override {
+        return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)));
+    }
+    bool IsFenceSignaled(uint64_t fence) override {
+        GLenum result = glClientWaitSync(ToSync(fence), 0, 0);
+        return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED;
+    }
+    void DeleteFence(uint64_t fence) override { glDeleteSync(ToSync(fence)); }
+
+  private:
+    static GLsync ToSync(uint64_t fence) { return reinterpret_cast<GLsync>(static_cast<uintptr_t>(fence)); }
+
+    GLuint m_buffer = 0;
+};
+
+} // namespace
+
+std::shared_ptr<StreamingUploadRing> StreamingUploadRing::Create(std::unique_ptr<StreamingUploadBackend> backend, size_t capacity) {
+    capacity = capacity & ~(ALIGNMENT - 1);
+    if (!backend || capacity == 0) return nullptr;
+    uint8_t* storage = backend->CreateStorage(capacity);
+    if (!storage) return nullptr;
+    return std::shared_ptr<StreamingUploadRing>(new StreamingUploadRing(std::move(backend), storage, capacity));
+}
+
+std::shared_ptr<StreamingUploadRing> StreamingUploadRing::CreateForCurrentContext(size_t capacity) {
+    if (!GLStreamingUploadBackend::IsSupported()) return nullptr;
+    return Create(std::make_unique<GLStreamingUploadBackend>(), capacity);
+}
+
+StreamingUploadRing::StreamingUploadRing(std::unique_ptr<StreamingUploadBackend> backend, uint8_t* storage, size_t capacity)
+    : m_backend(std::move(backend)), m_storage(storage), m_capacity(capacity) {}
+
+// GL objects are freed by Close() on the render thread; by now only the bookkeeping is left
+StreamingUploadRing::~StreamingUploadRing() = default;
+
+bool StreamingUploadRing::Reserve(size_t bytes, StreamingUpload& out) {
+    Release(out);
+    const size_t size = AlignUp(bytes);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_closed || bytes == 0 || size > m_capacity) {
+        m_stats.failed++;
+        return false;
+    }
+
+    size_t offset;
+    if (m_allocations.empty()) {
+        m_head = 0;
+        offset = 0;
+    } else {
+        const size_t tail = m_allocations.front().begin;
+        if (m_head > tail) {
+            // Free space is [head, capacity) and [0, tail)
+            if (m_head + size <= m_capacity) {
+                offset = m_head;
+            } else if (size <= tail) {
+                offset = 0; // The end of the ring is skipped and reclaimed with this allocation
+            } else {
+                m_stats.failed++;
+                return false;
+            }
+        } else {
+            // Wrapped (exactly full when head == tail): free space is [head, tail)
+            if (m_head + size > tail) {
+                m_stats.failed++;
+                return false;
+            }
+            offset = m_head;
+        }
+    }
+
+    Allocation a;
+    a.id = m_nextId++;
+    a.begin = m_head;
+    a.offset = offset;
+    a.end = offset + size;
+    a.state = State::Writing;
+    a.fence = 0;
+    m_allocations.push_back(a);
+    m_head = a.end; // May equal capacity; the next allocation then wraps
+
+    m_stats.reserved++;
+    m_stats.reservedBytes += bytes;
+
+    out.ring = shared_from_this();
+    out.id = a.id;
+    out.offset = offset;
+    out.size = bytes;
+    out.data = m_storage + offset;
+    return true;
+}
+
+void StreamingUploadRing::Commit(StreamingUpload& upload) {
+    if (upload.ring.get() != this) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (Allocation* a = Find(upload.id)) {
+        if (a->state == State::Writing) {
+            a->state = State::Committed;
+            m_writersDone.notify_all();
+        }
+    }
+    upload.data = nullptr;
+}
+
+void StreamingUploadRing::Release(StreamingUpload& upload) {
+    if (StreamingUploadRing* ring = upload.ring.get()) {
+        std::lock_guard<std::mutex> lock(ring->m_mutex);
+        if (Allocation* a = ring->Find(upload.id)) {
+            if (a->state == State::Writing || a->state == State::Committed) {
+                if (a->state == State::Writing) { ring->m_writersDone.notify_all(); }
+                a->state = State::Free;
+                ring->PopFreed();
+            }
+        }
+    }
+    upload = StreamingUpload{};
+}
+
+void StreamingUploadRing::Submit(StreamingUpload& upload) {
+    if (upload.ring.get() == this) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (Allocation* a = Find(upload.id)) {
+            if (a->state == State::Committed || a->state == State::Writing) {
+                a->state = State::Submitted;
+                m_hasUnfenced = true;
+            }
+        }
+    }
+    upload = StreamingUpload{};
+}
+
+void StreamingUploadRing::FenceSubmitted() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_hasUnfenced || m_closed) return;
+    const uint64_t sequence = m_nextFence++;
+    for (Allocation& a : m_allocations) {
+        if (a.state == State::Submitted && a.fence == 0) { a.fence = sequence; }
+    }
+    m_fences.push_back({ m_backend->InsertFence(), sequence });
+    m_hasUnfenced = false;
+}
+
+void StreamingUploadRing::Retire() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint64_t signaled = 0;
+    // Fences signal in submission order, so stop at the first one that has not
+    while (!m_fences.empty() && m_backend->IsFenceSignaled(m_fences.front().handle)) {
+        signaled = m_fences.front().sequence;
+        m_backend->DeleteFence(m_fences.front().handle);
+        m_fences.pop_front();
+    }
+    if (signaled == 0) return;
+    for (Allocation& a : m_allocations) {
+        if (a.state == State::Submitted && a.fence != 0 && a.fence <= signaled) { a.state = State::Free; }
+    }
+    PopFreed();
+}
+
+void StreamingUploadRing::Close() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_closed) return;
+    m_closed = true;
+    // Producers write outside the lock; the storage must stay mapped until they are done
+    m_writersDone.wait(lock, [this] {
+        for (const Allocation& a : m_allocations) {
+            if (a.state == State::Writing) return false;
+        }
+        return true;
+    });
+    for (const Fence& f : m_fences) { m_backend->DeleteFence(f.handle); }
+    m_fences.clear();
+    m_allocations.clear();
+    m_backend->DestroyStorage();
+    m_storage = nullptr;
+}
+
+StreamingUploadStats StreamingUploadRing::TakeStats() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    StreamingUploadStats stats = m_stats;
+    m_stats = StreamingUploadStats{};
+    return stats;
+}
+
+size_t StreamingUploadRing::BytesInUse() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_allocations.empty()) return 0;
+    const size_t tail = m_allocations.front().begin;
+    return m_head > tail ? m_head - tail : m_capacity - tail + m_head;
+}
+
+StreamingUploadRing::Allocation* StreamingUploadRing::Find(uint64_t id) {
+    if (m_allocations.empty() || id < m_allocations.front().id) return nullptr;
+    const uint64_t index = id - m_allocations.front().id;
+    return index < m_allocations.size() ? &m_allocations[static_cast<size_t>(index)] : nullptr;
+}
+
+void StreamingUploadRing::PopFreed() {
+    while (!m_allocations.empty() && m_allocations.front().state == State::Free) { m_allocations.pop_front(); }
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+// ============================================================================
+// STREAMING_UPLOAD.H - Persistently mapped upload ring for texture streaming
+// ============================================================================
+// Texture uploads from client memory make the driver copy the pixels before glTexSubImage2D returns,
+// on the render thread. StreamingUploadRing is one large GL_PIXEL_UNPACK_BUFFER, mapped once with
+// GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT, that producers write into directly:
+//
+//   1. A producer (any thread) Reserve()s space, writes its pixels through StreamingUpload::data and
+//      Commit()s it. A frame that is replaced before anyone uploads it is Release()d instead.
+//   2. The render thread issues the copy from the buffer offset and Submit()s the upload.
+//   3. Once per frame the render thread calls FenceSubmitted(), which covers everything submitted since
+//      the last call with one fence, and Retire(), which frees the space of uploads whose fence has
+//      signaled. Space is reclaimed in allocation order, so one slow upload holds back the ones after it.
+//
+// Reserve never waits: when the ring is full, or unavailable, producers keep using client memory.
+// The ring reaches GL only through StreamingUploadBackend, so allocation and retirement can be driven
+// by a fake backend.
+// ============================================================================
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+class StreamingUploadRing;
+
+class StreamingUploadBackend {
+  public:
+    virtual ~StreamingUploadBackend() = default;
+
+    // Creates the mapped storage; nullptr on failure
+    virtual uint8_t* CreateStorage(size_t bytes) = 0;
+    virtual void DestroyStorage() = 0;
+    virtual uint32_t StorageBuffer() const = 0; // GL buffer name to bind as GL_PIXEL_UNPACK_BUFFER
+
+    virtual uint64_t InsertFence() = 0;
+    virtual bool IsFenceSignaled(uint64_t fence) = 0; // Must not block
+    virtual void DeleteFence(uint64_t fence) = 0;
+};
+
+// Space in the ring for one upload. Holding it keeps the ring object (not its storage) alive.
+struct StreamingUpload {
+    std::shared_ptr<StreamingUploadRing> ring;
+    uint64_t id = 0;
+    size_t offset = 0; // Into the buffer - the pointer argument of the copy command
+    size_t size = 0;
+    uint8_t* data = nullptr; // Mapped memory; only valid between Reserve and Commit/Release
+
+    bool IsValid() const { return ring != nullptr; }
+};
+
+struct StreamingUploadStats {
+    uint32_t reserved = 0; // Reserve calls that got space
+    uint32_t failed = 0;   // Reserve calls that found the ring full or closed
+    uint64_t reservedBytes = 0;
+};
+
+class StreamingUploadRing : public std::enable_shared_from_this<StreamingUploadRing> {
+  public:
+    static constexpr size_t ALIGNMENT = 256; // Upload offsets, well above any GL_UNPACK_ALIGNMENT
+
+    // Nullptr when the backend cannot create the storage
+    static std::shared_ptr<StreamingUploadRing> Create(std::unique_ptr<StreamingUploadBackend> backend, size_t capacity);
+    // GL_ARB_buffer_storage ring on the current context; nullptr when unsupported
+    static std::shared_ptr<StreamingUploadRing> CreateForCurrentContext(size_t capacity);
+
+    ~StreamingUploadRing();
+
+    // Producer side (any thread)
+    bool Reserve(size_t bytes, StreamingUpload& out);
+    void Commit(StreamingUpload& upload); // Pixels are written; clears `data`
+    // The upload will not be copied after all. No effect once it was submitted; always resets `upload`
+    static void Release(StreamingUpload& upload);
+
+    // Render thread
+    uint32_t StorageBuffer() const { return m_backend->StorageBuffer(); }
+    void Submit(StreamingUpload& upload); // The copy command was issued; resets `upload`
+    void FenceSubmitted();
+    void Retire();
+    // Stops new reservations, waits for producers still writing, then frees the storage and fences
+    void Close();
+
+    StreamingUploadStats TakeStats();
+    size_t Capacity() const { return m_capacity; }
+    size_t BytesInUse() const;
+
+  private:
+    enum class State : uint8_t { Writing, Committed, Submitted, Free };
+    struct Allocation {
+        uint64_t id;
+        size_t begin; // Start of the space this allocation holds (before any wrap padding)
+        size_t offset;
+        size_t end;
+        State state;
+        uint64_t fence; // Fence sequence covering a submitted allocation, 0 until FenceSubmitted
+    };
+    struct Fence {
+        uint64_t handle;
+        uint64_t sequence;
+    };
+
+    StreamingUploadRing(std::unique_ptr<StreamingUploadBackend> backend, uint8_t* storage, size_t capacity);
+
+    Allocation* Find(uint64_t id); // Under m_mutex
+    void PopFreed();               // Under m_mutex
+
+    std::unique_ptr<StreamingUploadBackend> m_backend;
+    uint8_t* m_storage;
+    const size_t m_capacity;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_writersDone;
+    std::deque<Allocation> m_allocations; // Allocation order
+    std::deque<Fence> m_fences;           // Insertion order
+    size_t m_head = 0;                    // Where the next allocation starts, in [0, capacity]
+    uint64_t m_nextId = 1;
+    uint64_t m_nextFence = 1;
+    bool m_hasUnfenced = false;
+    bool m_closed = false;
+    StreamingUploadStats m_stats;
+};
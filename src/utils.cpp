@@ -2,6 +2,7 @@
 #include "gui.h"
 #include "logic_thread.h"
 #include "profiler.h"
+#include "program_cache.h"
 
 // From dllmain.cpp (declared in render.h)
 extern std::atomic<GLuint> g_cachedGameTextureId;
@@ -1006,21 +1007,23 @@ bool SwitchToMode(const std::string& newModeId, const std::string& source, bool
     bool useAnimatedPosition = false;
     float distanceRatio = 1.0f; // Ratio of new distance to original full distance (for duration scaling)
     {
-        std::lock_guard<std::mutex> transitionLock(g_modeTransitionMutex);
-        if (g_modeTransition.active && g_modeTransition.gameTransition == GameTransitionType::Bounce) {
+        // Evaluated at the game frame's present time, i.e. where the viewport currently is
+        std::shared_ptr<const ModeTransitionDescriptor> activeTransition = GetActiveModeTransition();
+        if (activeTransition && activeTransition->animateGame) {
+            const ModeTransitionFrame frame = EvaluateModeTransition(*activeTransition, GetModeTransitionFrameTime());
             // Capture current animated position
-            fromWidth = g_modeTransition.currentWidth;
-            fromHeight = g_modeTransition.currentHeight;
-            fromX = g_modeTransition.currentX;
-            fromY = g_modeTransition.currentY;
+            fromWidth = frame.width;
+            fromHeight = frame.height;
+            fromX = frame.x;
+            fromY = frame.y;
             useAnimatedPosition = true;
 
             // Calculate distance ratio for duration scaling
             // Compare current-to-new-target distance vs original full distance
-            int origDeltaW = std::abs(g_modeTransition.toWidth - g_modeTransition.fromWidth);
-            int origDeltaH = std::abs(g_modeTransition.toHeight - g_modeTransition.fromHeight);
-            int origDeltaX = std::abs(g_modeTransition.toX - g_modeTransition.fromX);
-            int origDeltaY = std::abs(g_modeTransition.toY - g_modeTransition.fromY);
+            int origDeltaW = std::abs(activeTransition->toWidth - activeTransition->fromWidth);
+            int origDeltaH = std::abs(activeTransition->toHeight - activeTransition->fromHeight);
+            int origDeltaX = std::abs(activeTransition->toX - activeTransition->fromX);
+            int origDeltaY = std::abs(activeTransition->toY - activeTransition->fromY);
             float origDistance =
                 std::sqrt((float)(origDeltaW * origDeltaW + origDeltaH * origDeltaH + origDeltaX * origDeltaX + origDeltaY * origDeltaY));
 
@@ -1333,12 +1336,17 @@ GLuint CompileShader(GLenum type, const char* source) {
 
 GLuint CreateShaderProgram(const char* vert, const char* frag) {
     PROFILE_SCOPE_CAT("Shader Program Creation", "GPU Operations");
+    const char* sources[] = { vert, frag };
+    const ProgramCacheKey cacheKey = MakeProgramCacheKeyForCurrentContext(sources, 2);
+    if (GLuint cached = LoadCachedProgram(cacheKey)) return cached;
+
     GLuint v = CompileShader(GL_VERTEX_SHADER, vert);
     GLuint f = CompileShader(GL_FRAGMENT_SHADER, frag);
     if (v == 0 || f == 0) return 0;
     GLuint p = glCreateProgram();
     glAttachShader(p, v);
     glAttachShader(p, f);
+    PrepareProgramForCache(p);
     glLinkProgram(p);
     GLint ok;
     glGetProgramiv(p, GL_LINK_STATUS, &ok);
@@ -1348,6 +1356,8 @@ GLuint CreateShaderProgram(const char* vert, const char* frag) {
         Log("ERROR: Shader link failed: " + std::string(log));
         glDeleteProgram(p);
         p = 0;
+    } else {
+        StoreCachedProgram(cacheKey, p);
     }
     glDeleteShader(v);
     glDeleteShader(f);
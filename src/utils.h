@@ -16,6 +16,7 @@
 #include <vector>
 #include <windows.h>
 
+#include "gpu_resources.h"
 #include "gui.h"
 
 // Config access: Reader threads use GetConfigSnapshot() for safe, lock-free access.
@@ -53,6 +54,8 @@ struct MirrorInstance {
     GLuint finalTexture = 0;                // Front texture with screen-ready content
     GLuint finalFboBack = 0;                // Back FBO (capture thread writes)
     GLuint finalTextureBack = 0;            // Back texture (capture thread writes)
+    // GpuResourceManager handles of the four textures above; swapped along with them
+    GpuResourceHandle fboTextureHandle, fboTextureBackHandle, finalTextureHandle, finalTextureBackHandle;
     int final_w = 0, final_h = 0;           // Dimensions of FRONT final FBO
     int final_w_back = 0, final_h_back = 0; // Dimensions of BACK final FBO (may differ during scale changes)
 
@@ -122,6 +125,10 @@ struct MirrorInstance {
           finalTexture(other.finalTexture),
           finalFboBack(other.finalFboBack),
           finalTextureBack(other.finalTextureBack),
+          fboTextureHandle(other.fboTextureHandle),
+          fboTextureBackHandle(other.fboTextureBackHandle),
+          finalTextureHandle(other.finalTextureHandle),
+          finalTextureBackHandle(other.finalTextureBackHandle),
           final_w(other.final_w),
           final_h(other.final_h),
           final_w_back(other.final_w_back),
@@ -154,6 +161,10 @@ struct MirrorInstance {
           finalTexture(other.finalTexture),
           finalFboBack(other.finalFboBack),
           finalTextureBack(other.finalTextureBack),
+          fboTextureHandle(other.fboTextureHandle),
+          fboTextureBackHandle(other.fboTextureBackHandle),
+          finalTextureHandle(other.finalTextureHandle),
+          finalTextureBackHandle(other.finalTextureBackHandle),
           final_w(other.final_w),
           final_h(other.final_h),
           final_w_back(other.final_w_back),
@@ -191,6 +202,10 @@ struct MirrorInstance {
             finalTexture = other.finalTexture;
             finalFboBack = other.finalFboBack;
             finalTextureBack = other.finalTextureBack;
+            fboTextureHandle = other.fboTextureHandle;
+            fboTextureBackHandle = other.fboTextureBackHandle;
+            finalTextureHandle = other.finalTextureHandle;
+            finalTextureBackHandle = other.finalTextureBackHandle;
             final_w = other.final_w;
             final_h = other.final_h;
             final_w_back = other.final_w_back;
@@ -228,6 +243,10 @@ struct MirrorInstance {
             finalTexture = other.finalTexture;
             finalFboBack = other.finalFboBack;
             finalTextureBack = other.finalTextureBack;
+            fboTextureHandle = other.fboTextureHandle;
+            fboTextureBackHandle = other.fboTextureBackHandle;
+            finalTextureHandle = other.finalTextureHandle;
+            finalTextureBackHandle = other.finalTextureBackHandle;
             final_w = other.final_w;
             final_h = other.final_h;
             final_w_back = other.final_w_back;
@@ -263,6 +282,7 @@ struct UserImageInstance {
     std::vector<int> frameDelays;      // Delay in ms between each frame
     size_t currentFrame = 0;
     std::chrono::steady_clock::time_point lastFrameTime;
+    std::vector<GpuResourceHandle> textureHandles; // Owns the textures above (one per frame)
 
     // Cached rendering data (invalidated when config changes)
     struct CachedImageRenderState {
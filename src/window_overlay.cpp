@@ -2,6 +2,7 @@
 #include "gui.h"
 #include "profiler.h"
 #include "render.h"
+#include "render_thread.h"
 #include "utils.h"
 #include <GL/wglew.h>
 #include <algorithm>
@@ -372,6 +373,52 @@ void UpdateWindowOverlay(const std::string& overlayId) {
 }
 
 // Capture window content using various methods based on config
+// Hands entry.pixelData to the render thread through the write buffer. The frame is written straight into the
+// render thread's upload ring when it has room, so the render thread only issues the copy; otherwise it goes
+// through the write buffer's own heap copy as before.
+static void PublishCapturedFrame(WindowOverlayCacheEntry& entry) {
+    WindowOverlayRenderData& out = *entry.writeBuffer;
+    if (!entry.pixelData) return;
+    const size_t copySize = static_cast<size_t>(entry.width) * static_cast<size_t>(entry.height) * 4;
+
+    // The buffer may still hold a frame that was replaced before the render thread uploaded it
+    StreamingUploadRing::Release(out.upload);
+
+    std::shared_ptr<StreamingUploadRing> ring = GetStreamingUploadRing();
+    if (ring && ring->Reserve(copySize, out.upload)) {
+        memcpy(out.upload.data, entry.pixelData, copySize);
+        ring->Commit(out.upload);
+        if (out.pixelData) {
+            delete[] out.pixelData;
+            out.pixelData = nullptr;
+        }
+        out.width = entry.width;
+        out.height = entry.height;
+    } else {
+        if (!out.pixelData || out.width != entry.width || out.height != entry.height) {
+            if (out.pixelData) {
+                delete[] out.pixelData;
+                out.pixelData = nullptr;
+            }
+            out.width = entry.width;
+            out.height = entry.height;
+            // Validate size before allocation
+            if (copySize > 0 && copySize < 100 * 1024 * 1024) { out.pixelData = new unsigned char[copySize]; }
+        }
+        if (!out.pixelData) return;
+        memcpy(out.pixelData, entry.pixelData, copySize);
+    }
+
+    // Swap write and ready buffers under lock
+    {
+        std::lock_guard<std::mutex> lock(entry.swapMutex);
+        entry.writeBuffer.swap(entry.readyBuffer);
+    }
+
+    // Signal that a new frame is available for the render thread
+    entry.hasNewFrame.store(true, std::memory_order_release);
+}
+
 bool CaptureWindowContent(WindowOverlayCacheEntry& entry, const WindowOverlayConfig& config) {
     std::lock_guard<std::mutex> lock(entry.captureMutex);
 
@@ -623,31 +670,7 @@ bool CaptureWindowContent(WindowOverlayCacheEntry& entry, const WindowOverlayCon
     // Mark texture for update if capture was successful
     if (success) {
         // Copy to write buffer for thread-safe transfer to render thread (OpenGL path)
-        if (entry.writeBuffer->width != entry.width || entry.writeBuffer->height != entry.height) {
-            if (entry.writeBuffer->pixelData) {
-                delete[] entry.writeBuffer->pixelData;
-                entry.writeBuffer->pixelData = nullptr;
-            }
-            entry.writeBuffer->width = entry.width;
-            entry.writeBuffer->height = entry.height;
-            // Validate size before allocation
-            size_t bufferSize = static_cast<size_t>(entry.width) * static_cast<size_t>(entry.height) * 4;
-            if (bufferSize > 0 && bufferSize < 100 * 1024 * 1024) { entry.writeBuffer->pixelData = new unsigned char[bufferSize]; }
-        }
-
-        if (entry.writeBuffer->pixelData && entry.pixelData) {
-            size_t copySize = static_cast<size_t>(entry.width) * static_cast<size_t>(entry.height) * 4;
-            memcpy(entry.writeBuffer->pixelData, entry.pixelData, copySize);
-
-            // Swap write and ready buffers under lock, then signal new frame available
-            {
-                std::lock_guard<std::mutex> lock(entry.swapMutex);
-                entry.writeBuffer.swap(entry.readyBuffer);
-            }
-
-            // Signal that a new frame is available for the render thread
-            entry.hasNewFrame.store(true, std::memory_order_release);
-        }
+        PublishCapturedFrame(entry);
     }
 
     // Cleanup
@@ -688,31 +711,7 @@ bool CaptureWindowContent(WindowOverlayCacheEntry& entry, const WindowOverlayCon
         }
 
         // Copy error texture to write buffer
-        if (entry.writeBuffer->width != entry.width || entry.writeBuffer->height != entry.height) {
-            if (entry.writeBuffer->pixelData) {
-                delete[] entry.writeBuffer->pixelData;
-                entry.writeBuffer->pixelData = nullptr;
-            }
-            entry.writeBuffer->width = entry.width;
-            entry.writeBuffer->height = entry.height;
-            // Validate size before allocation
-            size_t bufferSize = static_cast<size_t>(entry.width) * static_cast<size_t>(entry.height) * 4;
-            if (bufferSize > 0 && bufferSize < 100 * 1024 * 1024) { entry.writeBuffer->pixelData = new unsigned char[bufferSize]; }
-        }
-
-        if (entry.writeBuffer->pixelData && entry.pixelData) {
-            size_t copySize = static_cast<size_t>(entry.width) * static_cast<size_t>(entry.height) * 4;
-            memcpy(entry.writeBuffer->pixelData, entry.pixelData, copySize);
-
-            // Swap write and ready buffers under lock
-            {
-                std::lock_guard<std::mutex> lock(entry.swapMutex);
-                entry.writeBuffer.swap(entry.readyBuffer);
-            }
-
-            // Signal that a new frame is available for the render thread
-            entry.hasNewFrame.store(true, std::memory_order_release);
-        }
+        PublishCapturedFrame(entry);
     }
 
     return success;
@@ -744,11 +743,9 @@ void RemoveWindowOverlayFromCache(const std::string& overlayId) {
     std::lock_guard<std::mutex> cacheLock(g_windowOverlayCacheMutex);
     auto it = g_windowOverlayCache.find(overlayId);
     if (it != g_windowOverlayCache.end()) {
-        // Clean up OpenGL texture if it exists
-        if (it->second->glTextureId != 0) {
-            glDeleteTextures(1, &it->second->glTextureId);
-            it->second->glTextureId = 0;
-        }
+        // Queue the OpenGL texture for deletion; this thread may not have a context
+        GpuResourceManager::Get().Release(it->second->glTextureHandle);
+        it->second->glTextureId = 0;
         g_windowOverlayCache.erase(it);
     }
 }
@@ -780,11 +777,9 @@ void CleanupWindowOverlayCacheEntry(const std::string& overlayId) {
         // Config doesn't exist, so actually erase the entry (safe case - overlay removed from config)
         auto it = g_windowOverlayCache.find(overlayId);
         if (it != g_windowOverlayCache.end()) {
-            // Clean up OpenGL texture if it exists
-            if (it->second->glTextureId != 0) {
-                glDeleteTextures(1, &it->second->glTextureId);
-                it->second->glTextureId = 0;
-            }
+            // Queue the OpenGL texture for deletion; this thread may not have a context
+            GpuResourceManager::Get().Release(it->second->glTextureHandle);
+            it->second->glTextureId = 0;
             g_windowOverlayCache.erase(it);
         }
     }
@@ -795,19 +790,17 @@ void CleanupWindowOverlayCache() {
     std::lock_guard<std::mutex> lock(g_windowOverlayCacheMutex);
 
     // CRITICAL: Clean up OpenGL textures before clearing the cache
-    // Only do this if we have a valid GL context to avoid crashes
-    HGLRC currentContext = wglGetCurrentContext();
-    if (currentContext) {
-        for (auto& [id, entry] : g_windowOverlayCache) {
-            if (entry && entry->glTextureId != 0) {
-                try {
-                    glDeleteTextures(1, &entry->glTextureId);
-                    entry->glTextureId = 0;
-                } catch (...) { Log("Exception cleaning up window overlay texture: " + id); }
-            }
+    // Delete right away when this thread has a context; otherwise the game context deletes them on its next frame
+    GpuResourceManager& resources = GpuResourceManager::Get();
+    const bool hasContext = wglGetCurrentContext() != NULL;
+    for (auto& [id, entry] : g_windowOverlayCache) {
+        if (!entry) continue;
+        if (hasContext) {
+            resources.ReleaseNow(entry->glTextureHandle);
+        } else {
+            resources.Release(entry->glTextureHandle);
         }
-    } else {
-        Log("CleanupWindowOverlayCache: No valid GL context, skipping texture cleanup to avoid crashes");
+        entry->glTextureId = 0;
     }
 
     g_windowOverlayCache.clear();
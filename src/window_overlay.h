@@ -3,7 +3,9 @@
 #ifndef NOMINMAX
 #define NOMINMAX
 #endif
+#include "gpu_resources.h"
 #include "gui.h"
+#include "streaming_upload.h"
 #include "utils.h"
 #include <atomic>
 #include <chrono>
@@ -22,6 +24,7 @@ struct Color;
 // Render data structure - contains only what the render thread needs (immutable after creation)
 struct WindowOverlayRenderData {
     unsigned char* pixelData = nullptr;
+    StreamingUpload upload; // Set instead of pixelData when the frame was written into the upload ring
     int width = 0;
     int height = 0;
 
@@ -31,6 +34,7 @@ struct WindowOverlayRenderData {
             delete[] pixelData;
             pixelData = nullptr;
         }
+        StreamingUploadRing::Release(upload);
     }
 
     // Delete copy but allow move
@@ -38,19 +42,24 @@ struct WindowOverlayRenderData {
     WindowOverlayRenderData& operator=(const WindowOverlayRenderData&) = delete;
     WindowOverlayRenderData(WindowOverlayRenderData&& other) noexcept
         : pixelData(other.pixelData),
+          upload(std::move(other.upload)),
           width(other.width),
           height(other.height) {
         other.pixelData = nullptr;
+        other.upload = StreamingUpload{};
         other.width = 0;
         other.height = 0;
     }
     WindowOverlayRenderData& operator=(WindowOverlayRenderData&& other) noexcept {
         if (this != &other) {
             if (pixelData) delete[] pixelData;
+            StreamingUploadRing::Release(upload);
             pixelData = other.pixelData;
+            upload = std::move(other.upload);
             width = other.width;
             height = other.height;
             other.pixelData = nullptr;
+            other.upload = StreamingUpload{};
             other.width = 0;
             other.height = 0;
         }
@@ -84,6 +93,7 @@ struct WindowOverlayCacheEntry {
 
     // OpenGL texture caching (render thread only - no locking needed)
     unsigned int glTextureId = 0;
+    GpuResourceHandle glTextureHandle; // Owns glTextureId
     int glTextureWidth = 0;
     int glTextureHeight = 0;
     WindowOverlayRenderData* lastUploadedRenderData = nullptr; // Track which buffer was last uploaded
@@ -0,0 +1,36 @@
+#pragma once
+
+// ============================================================================
+// BENCH_COMMON.H - Timing helpers for the headless benchmarks
+// ============================================================================
+
+#include <chrono>
+#include <cstdint>
+
+// Keeps a computed value alive so the optimizer cannot drop the work that produced it
+inline void BenchKeep(uint64_t value) {
+    static volatile uint64_t s_sink;
+    s_sink = s_sink + value;
+}
+
+// Mean nanoseconds per call of fn(), the fastest of `rounds` rounds. Each round runs fn() for at
+// least minSecondsPerRound, after one untimed warm-up call.
+template <typename Fn> double BenchNsPerCall(Fn&& fn, int rounds = 5, double minSecondsPerRound = 0.05) {
+    using Clock = std::chrono::steady_clock;
+    fn();
+    double best = 0.0;
+    for (int r = 0; r < rounds; r++) {
+        const Clock::time_point start = Clock::now();
+        const Clock::time_point minEnd = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(minSecondsPerRound));
+        uint64_t calls = 0;
+        Clock::time_point now;
+        do {
+            fn();
+            calls++;
+            now = Clock::now();
+        } while (now < minEnd);
+        const double ns = std::chrono::duration<double, std::nano>(now - start).count() / static_cast<double>(calls);
+        if (r == 0 || ns < best) best = ns;
+    }
+    return best;
+}
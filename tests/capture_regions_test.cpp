@@ -0,0 +1,169 @@
+// ============================================================================
+// CAPTURE_REGIONS_TEST.CPP - Region merging, input mapping and cache packing
+// ============================================================================
+
+#include "capture_regions.h"
+#include "test_common.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int FRAME_W = 640;
+constexpr int FRAME_H = 360;
+
+bool Contains(const CaptureRect& outer, const CaptureRect& inner) {
+    return inner.x >= outer.x && inner.y >= outer.y && inner.Right() <= outer.Right() && inner.Top() <= outer.Top();
+}
+
+bool Overlaps(const CaptureRect& a, const CaptureRect& b) { return a.x < b.Right() && b.x < a.Right() && a.y < b.Top() && b.y < a.Top(); }
+
+// Pixels of `region` covered by at least one input, counted on a pixel mask
+long long CoveredInside(const CaptureRect& region, const std::vector<CaptureRect>& inputs) {
+    std::vector<uint8_t> mask(static_cast<size_t>(region.w) * region.h, 0);
+    for (const CaptureRect& r : inputs) {
+        for (int y = (std::max)(r.y, region.y); y < (std::min)(r.Top(), region.Top()); y++) {
+            for (int x = (std::max)(r.x, region.x); x < (std::min)(r.Right(), region.Right()); x++) {
+                mask[static_cast<size_t>(y - region.y) * region.w + (x - region.x)] = 1;
+            }
+        }
+    }
+    long long covered = 0;
+    for (uint8_t m : mask) covered += m;
+    return covered;
+}
+
+// Invariants every plan must satisfy
+void CheckPlan(const std::vector<CaptureRect>& inputs, const CaptureRegionPlan& plan) {
+    REQUIRE(plan.refs.size() == inputs.size());
+    REQUIRE(plan.packed.size() == plan.regions.size());
+
+    std::vector<CaptureRect> clipped;
+    long long inputArea = 0;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        const CaptureRegionRef& ref = plan.refs[i];
+        if (inputs[i].w <= 0 || inputs[i].h <= 0) {
+            CHECK_EQ(ref.region, -1);
+            continue;
+        }
+        REQUIRE(ref.region >= 0 && ref.region < static_cast<int>(plan.regions.size()));
+        const CaptureRect& region = plan.regions[ref.region];
+        CHECK(Contains(region, ref.clipped));
+        CHECK_EQ(ref.offsetX, ref.clipped.x - region.x);
+        CHECK_EQ(ref.offsetY, ref.clipped.y - region.y);
+        CHECK(ref.clipped.x >= 0 && ref.clipped.y >= 0 && ref.clipped.Right() <= FRAME_W && ref.clipped.Top() <= FRAME_H);
+        CHECK(ref.clipped.w > 0 && ref.clipped.h > 0);
+        clipped.push_back(ref.clipped);
+        inputArea += ref.clipped.Area();
+    }
+    CHECK_EQ(plan.inputArea, inputArea);
+
+    long long mergedArea = 0;
+    for (size_t k = 0; k < plan.regions.size(); k++) {
+        const CaptureRect& region = plan.regions[k];
+        const CaptureRect& packed = plan.packed[k];
+        mergedArea += region.Area();
+        // Per-region waste bound, against the true union of the inputs inside the region
+        CHECK(static_cast<double>(region.Area()) <= static_cast<double>(CoveredInside(region, clipped)) * (1.0 + CAPTURE_REGION_MAX_WASTE));
+        CHECK_EQ(packed.w, region.w);
+        CHECK_EQ(packed.h, region.h);
+        CHECK(packed.x >= 0 && packed.y >= 0 && packed.Right() <= plan.cacheW && packed.Top() <= plan.cacheH);
+        for (size_t j = 0; j < k; j++) CHECK(!Overlaps(packed, plan.packed[j]));
+    }
+    CHECK_EQ(plan.mergedArea, mergedArea);
+}
+
+CaptureRegionPlan Plan(const std::vector<CaptureRect>& inputs, int maxCacheWidth = 1024) {
+    CaptureRegionPlan plan;
+    BuildCaptureRegionPlan(inputs, FRAME_W, FRAME_H, maxCacheWidth, plan);
+    CheckPlan(inputs, plan);
+    return plan;
+}
+
+} // namespace
+
+TEST_CASE(DuplicatesAndContainedRectsShareOneRegion) {
+    const CaptureRegionPlan plan = Plan({ { 100, 100, 50, 40 }, { 100, 100, 50, 40 }, { 110, 105, 20, 20 } });
+    CHECK_EQ(plan.regions.size(), 1u);
+    CHECK_EQ(plan.mergedArea, 50 * 40);
+    CHECK_EQ(plan.inputArea, 2 * 50 * 40 + 20 * 20);
+    CHECK_EQ(plan.refs[2].offsetX, 10);
+    CHECK_EQ(plan.refs[2].offsetY, 5);
+}
+
+TEST_CASE(DisjointRectsStaySeparate) {
+    const CaptureRegionPlan plan = Plan({ { 0, 0, 30, 30 }, { 200, 200, 30, 30 }, { 32, 0, 30, 30 } });
+    CHECK_EQ(plan.regions.size(), 3u);
+    CHECK_EQ(plan.mergedArea, plan.inputArea);
+}
+
+TEST_CASE(TouchingRectsMergeWithoutWaste) {
+    // Two halves of one rect share an edge: their bounding box is exactly their union
+    const CaptureRegionPlan plan = Plan({ { 10, 10, 40, 20 }, { 50, 10, 40, 20 } });
+    CHECK_EQ(plan.regions.size(), 1u);
+    CHECK_EQ(plan.mergedArea, 80 * 20);
+}
+
+TEST_CASE(WastefulOverlapIsNotMerged) {
+    // An L shape: the bounding box would copy far more than the two rects cover
+    const CaptureRegionPlan plan = Plan({ { 0, 0, 200, 10 }, { 0, 0, 10, 200 } });
+    CHECK_EQ(plan.regions.size(), 2u);
+}
+
+TEST_CASE(MergeChainsKeepTheWasteBoundPerRegion) {
+    // A staircase of thin, overlapping rects. Every single step is cheap compared to the previous bounding
+    // box, but the bounding box of the whole chain copies ~40% more pixels than the stairs cover; merging
+    // against the bounding boxes of intermediate regions would collapse it into one region anyway.
+    std::vector<CaptureRect> stairs;
+    for (int i = 0; i < 8; i++) stairs.push_back({ 20 + 10 * i, 20 + 10 * i, 100, 20 });
+    const CaptureRegionPlan plan = Plan(stairs);
+    CHECK(plan.regions.size() > 1u);
+    CHECK(static_cast<double>(plan.mergedArea) <= static_cast<double>(plan.inputArea));
+}
+
+TEST_CASE(RectsOutsideTheFrameKeepTheClampedEdge) {
+    const std::vector<CaptureRect> inputs = { { -50, 100, 60, 20 }, { 700, 400, 30, 30 }, { 600, -10, 80, 20 }, { 10, 10, 0, 5 } };
+    const CaptureRegionPlan plan = Plan(inputs);
+    CHECK(!plan.refs[0].insideFrame);
+    CHECK_EQ(plan.refs[0].clipped.x, 0);
+    CHECK_EQ(plan.refs[0].clipped.w, 10);
+    // Fully outside: collapses onto the corner texel clamped sampling reads
+    CHECK_EQ(plan.refs[1].clipped.x, FRAME_W - 1);
+    CHECK_EQ(plan.refs[1].clipped.y, FRAME_H - 1);
+    CHECK_EQ(plan.refs[1].clipped.Area(), 1);
+    CHECK_EQ(plan.refs[2].clipped.y, 0);
+    CHECK_EQ(plan.refs[2].clipped.Right(), FRAME_W);
+    CHECK_EQ(plan.refs[3].region, -1);
+}
+
+TEST_CASE(PackingHonorsTheCacheWidth) {
+    std::vector<CaptureRect> inputs;
+    for (int i = 0; i < 12; i++) inputs.push_back({ (i % 6) * 100, (i / 6) * 150, 60 + i, 40 + 3 * i });
+    const CaptureRegionPlan narrow = Plan(inputs, 200);
+    CHECK(narrow.cacheW <= 200);
+    // A region wider than the limit widens the cache rather than being dropped
+    const CaptureRegionPlan wide = Plan({ { 0, 0, 500, 10 }, { 0, 100, 20, 20 } }, 200);
+    CHECK_EQ(wide.cacheW, 500);
+}
+
+TEST_CASE(RandomInputsSatisfyThePlanInvariants) {
+    std::mt19937 rng(55);
+    std::uniform_int_distribution<int> pos(-40, 620), size(1, 120), count(1, 40);
+    for (int round = 0; round < 300; round++) {
+        SetTestContext("round " + std::to_string(round));
+        std::vector<CaptureRect> inputs;
+        const int n = count(rng);
+        for (int i = 0; i < n; i++) {
+            // Repeat earlier rects now and then, like mirrors sharing an input
+            if (i > 0 && rng() % 3 == 0) {
+                inputs.push_back(inputs[rng() % inputs.size()]);
+            } else {
+                inputs.push_back({ pos(rng), pos(rng) % FRAME_H, size(rng), size(rng) });
+            }
+        }
+        Plan(inputs, 256 + static_cast<int>(rng() % 768));
+    }
+}
@@ -0,0 +1,95 @@
+// ============================================================================
+// EASING_CURVE_BENCH.CPP - Closed-form move easing vs the baked table, 200 evaluations per call
+// ============================================================================
+// Each call evaluates 200 progress values spread over [0, 1] (a transition's worth of viewport hook calls),
+// once through ApplyDualEasing and once through the baked table, plus a whole EvaluateModeTransition
+// with and without the baked move easing.
+// ============================================================================
+
+#include "bench_common.h"
+#include "easing_curve.h"
+#include "mode_transition.h"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr int ELEMENTS = 200;
+
+uint64_t Bits(float f) {
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+void Report(const char* name, double closedNs, double tableNs) {
+    printf("%-32s %12.1f %12.1f %8.2fx\n", name, closedNs, tableNs, closedNs / tableNs);
+}
+
+} // namespace
+
+int main() {
+    std::vector<float> t(ELEMENTS);
+    std::mt19937 rng(200);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    for (float& v : t) v = unit(rng);
+
+    printf("%-32s %12s %12s %9s\n", "200 evaluations", "closed ns", "table ns", "speedup");
+
+    const float powers[][2] = { { 1.0f, 3.0f }, { 2.5f, 2.5f }, { 6.0f, 10.0f } };
+    for (const auto& p : powers) {
+        EasingCurveLut lut;
+        BuildDualEasingLut(p[0], p[1], lut);
+        const double closed = BenchNsPerCall([&] {
+            float sum = 0.0f;
+            for (float v : t) sum += ApplyDualEasing(v, p[0], p[1]);
+            BenchKeep(Bits(sum));
+        });
+        const double table = BenchNsPerCall([&] {
+            float sum = 0.0f;
+            for (float v : t) sum += lut.Sample(v);
+            BenchKeep(Bits(sum));
+        });
+        char name[64];
+        snprintf(name, sizeof(name), "dual easing %.1f/%.1f", p[0], p[1]);
+        Report(name, closed, table);
+    }
+
+    {
+        // A 0.3 s move with three 100 ms bounces, sampled at 200 points over its 0.6 s
+        ModeTransitionDescriptor desc;
+        desc.startTime = TransitionClock::now();
+        desc.duration = 0.3f;
+        desc.animateGame = true;
+        desc.easeInPower = 2.0f;
+        desc.easeOutPower = 3.0f;
+        desc.bounceCount = 3;
+        desc.bounceDurationMs = 100;
+        desc.fromWidth = 1920;
+        desc.fromHeight = 1080;
+        desc.toWidth = 300;
+        desc.toHeight = 800;
+        desc.toX = 810;
+        desc.toY = 140;
+        std::vector<TransitionClock::time_point> times;
+        for (int i = 0; i < ELEMENTS; i++) times.push_back(desc.startTime + std::chrono::microseconds(i * 3000));
+
+        ModeTransitionDescriptor baked = desc;
+        BakeModeTransitionEasing(baked);
+        auto evaluate = [&](const ModeTransitionDescriptor& d) {
+            return BenchNsPerCall([&] {
+                uint64_t sum = 0;
+                for (const TransitionClock::time_point& now : times) {
+                    const ModeTransitionFrame f = EvaluateModeTransition(d, now);
+                    sum += static_cast<uint64_t>(f.width + f.height + f.x + f.y);
+                }
+                BenchKeep(sum);
+            });
+        };
+        Report("EvaluateModeTransition", evaluate(desc), evaluate(baked));
+    }
+    return 0;
+}
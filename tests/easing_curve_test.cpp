@@ -0,0 +1,150 @@
+// ============================================================================
+// EASING_CURVE_TEST.CPP - Baked move easing against the closed forms
+// ============================================================================
+// The table built by BuildDualEasingLut is checked against ApplyDualEasing for every power pair ModeConfig
+// allows (1 to 10 in half steps), at points between the samples where interpolation error peaks, and a
+// baked transition against the closed-form one at pixel level on a 4K-wide move.
+// ============================================================================
+
+#include "easing_curve.h"
+#include "mode_transition.h"
+#include "test_common.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+namespace {
+
+std::string PowerContext(float in, float out) { return "powers " + std::to_string(in) + "/" + std::to_string(out); }
+
+} // namespace
+
+TEST_CASE(TableMatchesClosedFormForAllPowers) {
+    float worst = 0.0f;
+    for (float in = 1.0f; in <= 10.0f; in += 0.5f) {
+        for (float out = 1.0f; out <= 10.0f; out += 0.5f) {
+            SetTestContext(PowerContext(in, out));
+            EasingCurveLut lut;
+            BuildDualEasingLut(in, out, lut);
+            REQUIRE(lut.IsBuilt());
+            CHECK_EQ(lut.samples.size(), static_cast<size_t>(EASING_CURVE_SAMPLES + 1));
+
+            // Sample points, midpoints and quarter points between samples
+            float previous = -1.0f;
+            for (int i = 0; i <= EASING_CURVE_SAMPLES * 4; i++) {
+                const float t = static_cast<float>(i) / (EASING_CURVE_SAMPLES * 4);
+                const float sampled = lut.Sample(t);
+                const float exact = ApplyDualEasing(t, in, out);
+                worst = (std::max)(worst, std::fabs(sampled - exact));
+                CHECK(std::fabs(sampled - exact) < 1e-4f);
+                CHECK(sampled >= previous); // Monotonic
+                previous = sampled;
+            }
+        }
+    }
+    SetTestContext("");
+    std::printf("     max |table - ApplyDualEasing| = %.2g\n", worst);
+}
+
+TEST_CASE(TableEndpointsAndClamping) {
+    EasingCurveLut lut;
+    BuildDualEasingLut(1.0f, 3.0f, lut);
+    // Pinned, so a finished move lands exactly on the target
+    CHECK_EQ(lut.Sample(0.0f), 0.0f);
+    CHECK_EQ(lut.Sample(1.0f), 1.0f);
+    CHECK_EQ(lut.Sample(-0.5f), 0.0f);
+    CHECK_EQ(lut.Sample(1.5f), 1.0f);
+    CHECK_EQ(lut.Sample(std::numeric_limits<float>::quiet_NaN()), 0.0f);
+    CHECK_EQ(lut.Sample(std::numeric_limits<float>::infinity()), 1.0f);
+    // Largest float below 1 stays inside the table
+    const float almostOne = std::nextafter(1.0f, 0.0f);
+    CHECK_NEAR(lut.Sample(almostOne), 1.0f, 1e-6f);
+
+    // Linear powers bake the identity
+    EasingCurveLut linear;
+    BuildDualEasingLut(1.0f, 1.0f, linear);
+    for (int i = 0; i <= 100; i++) CHECK_NEAR(linear.Sample(i / 100.0f), i / 100.0f, 1e-6f);
+    CHECK(!EasingCurveLut{}.IsBuilt());
+}
+
+TEST_CASE(OutOfRangePowersAreClamped) {
+    EasingCurveLut low, one, high, ten;
+    BuildDualEasingLut(0.2f, -3.0f, low);
+    BuildDualEasingLut(1.0f, 1.0f, one);
+    BuildDualEasingLut(25.0f, 40.0f, high);
+    BuildDualEasingLut(10.0f, 10.0f, ten);
+    CHECK(low.samples == one.samples);
+    CHECK(high.samples == ten.samples);
+}
+
+TEST_CASE(BounceOffsetShapeAndDecay) {
+    // Half a sine per bounce, zero at both ends of every bounce
+    CHECK_NEAR(CalculateBounceOffset(0.0f, 0, 3, 0.2f), 0.0f, 1e-6f);
+    CHECK_NEAR(CalculateBounceOffset(0.5f, 0, 3, 0.2f), 0.2f, 1e-6f);
+    CHECK_NEAR(CalculateBounceOffset(1.0f, 0, 3, 0.2f), 0.0f, 1e-6f);
+    CHECK_NEAR(CalculateBounceOffset(0.25f, 0, 3, 0.2f), 0.2f * std::sqrt(0.5f), 1e-6f);
+    // Quadratic decay over the bounces
+    CHECK_NEAR(CalculateBounceOffset(0.5f, 1, 3, 0.2f), 0.2f * (4.0f / 9.0f), 1e-6f);
+    CHECK_NEAR(CalculateBounceOffset(0.5f, 2, 3, 0.2f), 0.2f * (1.0f / 9.0f), 1e-6f);
+    // No bounce outside the configured count
+    CHECK_EQ(CalculateBounceOffset(0.5f, 3, 3, 0.2f), 0.0f);
+    CHECK_EQ(CalculateBounceOffset(0.5f, 0, 0, 0.2f), 0.0f);
+}
+
+TEST_CASE(NamedEasingsSpanZeroToOne) {
+    for (EasingType type : { EasingType::Linear, EasingType::EaseOut, EasingType::EaseIn, EasingType::EaseInOut }) {
+        SetTestContext("type " + std::to_string(static_cast<int>(type)));
+        CHECK_NEAR(ApplyEasing(type, 0.0f), 0.0f, 1e-6f);
+        CHECK_NEAR(ApplyEasing(type, 1.0f), 1.0f, 1e-6f);
+        float previous = 0.0f;
+        for (int i = 1; i <= 100; i++) {
+            const float v = ApplyEasing(type, i / 100.0f);
+            CHECK(v >= previous);
+            previous = v;
+        }
+    }
+    SetTestContext("");
+    CHECK_NEAR(ApplyEasing(EasingType::EaseInOut, 0.5f), 0.5f, 1e-6f);
+    CHECK_NEAR(ApplyEasing(EasingType::EaseIn, 0.5f), 0.125f, 1e-6f);
+    CHECK_NEAR(ApplyEasing(EasingType::EaseOut, 0.5f), 0.875f, 1e-6f);
+}
+
+TEST_CASE(BakedTransitionWithinAPixelOfClosedForm) {
+    // 3840 px wide move, evaluated every 100 us with and without the baked easing
+    ModeTransitionDescriptor desc;
+    desc.startTime = TransitionClock::time_point{} + std::chrono::hours(1);
+    desc.duration = 0.4f;
+    desc.animateGame = true;
+    desc.bounceCount = 2;
+    desc.bounceDurationMs = 100;
+    desc.fromWidth = 3840;
+    desc.fromHeight = 2160;
+    desc.toWidth = 1;
+    desc.toHeight = 1;
+    desc.toX = 3839;
+    desc.toY = 2159;
+    for (float in : { 1.0f, 2.0f, 5.5f, 10.0f }) {
+        for (float out : { 1.0f, 3.0f, 10.0f }) {
+            SetTestContext(PowerContext(in, out));
+            desc.easeInPower = in;
+            desc.easeOutPower = out;
+            desc.moveEasing.reset();
+            ModeTransitionDescriptor baked = desc;
+            BakeModeTransitionEasing(baked);
+            int worst = 0;
+            for (int us = 0; us <= 700000; us += 100) {
+                const TransitionClock::time_point now = desc.startTime + std::chrono::microseconds(us);
+                const ModeTransitionFrame a = EvaluateModeTransition(desc, now);
+                const ModeTransitionFrame b = EvaluateModeTransition(baked, now);
+                worst = (std::max)({ worst, std::abs(a.width - b.width), std::abs(a.height - b.height), std::abs(a.x - b.x), std::abs(a.y - b.y) });
+                CHECK(a.complete == b.complete);
+            }
+            CHECK(worst <= 1);
+        }
+    }
+}
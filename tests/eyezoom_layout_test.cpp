@@ -0,0 +1,394 @@
+// ============================================================================
+// EYEZOOM_LAYOUT_TEST.CPP - EyeZoom strip placement and overlay layout
+// ============================================================================
+// ComputeEyeZoomPlacement is checked across window and viewport sizes, margins and animated viewport
+// positions (growing and sliding strips); LayoutEyeZoomOverlay across clone widths, box counts, strip
+// sizes and font settings with a fixed-pitch fake font, for box coverage, center line, label fit and glyph
+// clipping. The overlay is drawn at several strip positions through SoftwareRenderBackend to check it
+// covers the same pixels wherever the strip is.
+// ============================================================================
+
+#include "eyezoom_layout.h"
+#include "render_commands_sw.h"
+#include "test_common.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Fixed-pitch digits, 0.6 * size wide, from a 10-digit atlas row
+class TestFont : public EyeZoomFont {
+  public:
+    void MeasureText(float size, const char* text, float& width, float& height) const override {
+        width = 0.6f * size * static_cast<float>(std::string(text).size());
+        height = size;
+    }
+    void AppendGlyphs(float size, const char* text, std::vector<Glyph>& out) const override {
+        float x = 0.0f;
+        for (const char* c = text; *c; c++) {
+            const int d = *c - '0';
+            out.push_back({ x, 0.0f, x + 0.6f * size, size, d / 10.0f, 1.0f, (d + 0.75f) / 10.0f, 0.0f });
+            x += 0.6f * size;
+        }
+    }
+};
+
+std::string SizeContext(const EyeZoomLayoutParams& params, int width, int height) {
+    return "clone " + std::to_string(params.cloneWidth) + ", overlay " + std::to_string(params.overlayWidth) + ", strip " +
+           std::to_string(width) + "x" + std::to_string(height);
+}
+
+bool IsWhole(float v) { return v == std::floor(v); }
+
+// SoftwareImage rows are bottom-up like GL's; strip and window pixels are y down
+const uint8_t* WindowPixel(const SoftwareImage& image, int x, int y) { return image.At(x, image.height - 1 - y); }
+
+// Strip sizes EyeZoom sees in practice, from a thin window's strip to 4K
+struct StripCase {
+    int cloneWidth, overlayWidth, width, height;
+};
+const StripCase STRIP_CASES[] = { { 24, 12, 768, 1080 }, { 24, 12, 1728, 2160 }, { 30, 8, 700, 1000 }, { 7, 3, 355, 500 },
+                                  { 24, -1, 400, 720 },  { 24, 40, 400, 720 },   { 50, 25, 333, 600 }, { 2, 1, 90, 200 },
+                                  { 24, 12, 61, 150 } };
+
+} // namespace
+
+TEST_CASE(PlacementFillsTheSpaceLeftOfTheRestingViewport) {
+    struct Case {
+        int fullW, fullH, windowWidth, horizontalMargin, verticalMargin;
+    };
+    const Case cases[] = { { 1920, 1080, 384, 0, 0 }, { 1920, 1080, 384, 20, 40 }, { 2560, 1440, 60, 10, 10 },
+                           { 3840, 2160, 384, 0, 0 }, { 1366, 768, 1000, 5, 0 },   { 1920, 1080, 1000, 0, 500 } };
+    for (const Case& c : cases) {
+        SetTestContext(std::to_string(c.fullW) + "x" + std::to_string(c.fullH) + ", window " + std::to_string(c.windowWidth) + ", margins " +
+                       std::to_string(c.horizontalMargin) + "/" + std::to_string(c.verticalMargin));
+        EyeZoomLayoutParams params;
+        params.windowWidth = c.windowWidth;
+        params.horizontalMargin = c.horizontalMargin;
+        params.verticalMargin = c.verticalMargin;
+        for (bool slide : { false, true }) {
+            params.slideZoomIn = slide;
+            const EyeZoomPlacement p = ComputeEyeZoomPlacement(params, c.fullW, c.fullH, -1, false);
+            REQUIRE(p.visible);
+            // Resting: same for growing and sliding strips, the margin on both sides of it
+            CHECK_EQ(p.x, c.horizontalMargin);
+            CHECK_EQ(p.width, (c.fullW - c.windowWidth) / 2 - 2 * c.horizontalMargin);
+            CHECK_EQ(p.y, c.verticalMargin);
+            const int height = (std::max)(c.fullH - 2 * c.verticalMargin, static_cast<int>(0.2f * c.fullH));
+            CHECK_EQ(p.height, height);
+            CHECK(p.labels);
+        }
+    }
+    SetTestContext("");
+
+    // No room: the viewport fills the window, or the margins eat the strip
+    EyeZoomLayoutParams params;
+    params.windowWidth = 1920;
+    CHECK(!ComputeEyeZoomPlacement(params, 1920, 1080, -1, false).visible);
+    params.windowWidth = 2400;
+    CHECK(!ComputeEyeZoomPlacement(params, 1920, 1080, -1, false).visible);
+    params.windowWidth = 1000;
+    params.horizontalMargin = 230;
+    CHECK(!ComputeEyeZoomPlacement(params, 1920, 1080, -1, false).visible);
+    params.horizontalMargin = 229; // 2 pixels left
+    const EyeZoomPlacement thin = ComputeEyeZoomPlacement(params, 1920, 1080, -1, false);
+    CHECK(thin.visible);
+    CHECK_EQ(thin.width, 2);
+    CHECK(!thin.labels);
+}
+
+TEST_CASE(GrowingStripFollowsTheViewportOffset) {
+    EyeZoomLayoutParams params;
+    params.windowWidth = 384;
+    params.horizontalMargin = 8;
+    params.verticalMargin = 30;
+    const int restX = (1920 - 384) / 2;
+    for (bool fromEyeZoom : { false, true }) {
+        for (int viewportX : { 1, 16, 17, 28, 29, 100, 500, restX - 1, restX }) {
+            SetTestContext("viewport x " + std::to_string(viewportX) + (fromEyeZoom ? ", leaving" : ", entering"));
+            const EyeZoomPlacement p = ComputeEyeZoomPlacement(params, 1920, 1080, viewportX, fromEyeZoom);
+            const int width = viewportX - 16;
+            CHECK_EQ(p.visible, width > 1);
+            if (!p.visible) continue;
+            CHECK_EQ(p.x, 8);
+            CHECK_EQ(p.width, width);
+            CHECK_EQ(p.y, 30);
+            CHECK_EQ(p.height, 1020);
+            CHECK_EQ(p.labels, width > 20);
+        }
+    }
+    SetTestContext("");
+    // An explicit resting offset matches the default; viewports at or past the left edge hide the strip
+    const EyeZoomPlacement rest = ComputeEyeZoomPlacement(params, 1920, 1080, -1, false);
+    const EyeZoomPlacement explicitRest = ComputeEyeZoomPlacement(params, 1920, 1080, restX, false);
+    CHECK_EQ(rest.x, explicitRest.x);
+    CHECK_EQ(rest.width, explicitRest.width);
+    CHECK(!ComputeEyeZoomPlacement(params, 1920, 1080, 0, false).visible);
+}
+
+TEST_CASE(SlidingStripKeepsItsSizeAndMovesWithTheViewport) {
+    EyeZoomLayoutParams params;
+    params.slideZoomIn = true;
+    params.horizontalMargin = 12;
+    for (int fullW : { 1280, 1920, 3840 }) {
+        for (int windowWidth : { 60, 384, 700 }) {
+            params.windowWidth = windowWidth;
+            const int restX = (fullW - windowWidth) / 2;
+            const int width = restX - 24;
+            int previousX = -width - 1;
+            for (int step = 1; step <= 16; step++) {
+                const int viewportX = restX * step / 16;
+                SetTestContext(std::to_string(fullW) + " wide, window " + std::to_string(windowWidth) + ", viewport x " + std::to_string(viewportX));
+                for (bool fromEyeZoom : { false, true }) {
+                    const EyeZoomPlacement p = ComputeEyeZoomPlacement(params, fullW, 1080, viewportX, fromEyeZoom);
+                    REQUIRE(p.visible);
+                    CHECK_EQ(p.width, width);
+                    // From fully off screen at viewport x 0 to the margin at rest, in proportion
+                    const int expected = -width + static_cast<int>((12 + width) * (static_cast<float>(viewportX) / restX));
+                    CHECK_EQ(p.x, expected);
+                    CHECK(p.x <= 12);
+                    if (!fromEyeZoom) {
+                        CHECK(p.x > previousX);
+                        previousX = p.x;
+                    }
+                }
+            }
+            SetTestContext("");
+            // Past the resting offset (a viewport sliding further right) the strip stays at the margin
+            CHECK_EQ(ComputeEyeZoomPlacement(params, fullW, 1080, restX + 40, false).x, 12);
+        }
+    }
+}
+
+TEST_CASE(MinimumHeightIsAFifthOfTheWindow) {
+    EyeZoomLayoutParams params;
+    params.verticalMargin = 480;
+    const EyeZoomPlacement p = ComputeEyeZoomPlacement(params, 1920, 1080, -1, false);
+    REQUIRE(p.visible);
+    CHECK_EQ(p.height, 216);
+    CHECK_EQ(p.y, 480);
+    params.verticalMargin = 430;
+    CHECK_EQ(ComputeEyeZoomPlacement(params, 1920, 1080, -1, false).height, 220);
+}
+
+TEST_CASE(BoxesTileTheOverlayColumns) {
+    for (const StripCase& c : STRIP_CASES) {
+        for (bool linkRectToFont : { true, false }) {
+            EyeZoomLayoutParams params;
+            params.cloneWidth = c.cloneWidth;
+            params.overlayWidth = c.overlayWidth;
+            params.linkRectToFont = linkRectToFont;
+            params.textFontSize = 20;
+            params.rectHeight = 30;
+            SetTestContext(SizeContext(params, c.width, c.height) + (linkRectToFont ? ", linked" : ""));
+
+            EyeZoomOverlay overlay;
+            LayoutEyeZoomOverlay(params, c.width, c.height, false, nullptr, overlay);
+            CHECK_EQ(overlay.width, c.width);
+            CHECK_EQ(overlay.height, c.height);
+            CHECK_NEAR(overlay.columnWidth, static_cast<float>(c.width) / c.cloneWidth, 1e-4f);
+            CHECK(overlay.labels.empty());
+            CHECK(overlay.glyphs.empty());
+
+            const int perSide = (c.overlayWidth < 0) ? c.cloneWidth / 2 : (std::min)(c.overlayWidth, c.cloneWidth / 2);
+            REQUIRE(static_cast<int>(overlay.boxes.size()) == 2 * perSide);
+
+            const float boxHeight = linkRectToFont ? 24.0f : 30.0f;
+            for (size_t i = 0; i < overlay.boxes.size(); i++) {
+                const EyeZoomBox& box = overlay.boxes[i];
+                CHECK(IsWhole(box.x1) && IsWhole(box.x2) && IsWhole(box.y1) && IsWhole(box.y2));
+                CHECK(box.x1 >= 0.0f && box.x2 <= c.width && box.x2 > box.x1);
+                // Each box spans its column, to the pixel
+                CHECK(std::fabs((box.x2 - box.x1) - overlay.columnWidth) <= 1.0f);
+                CHECK(std::fabs((box.y2 - box.y1) - boxHeight) <= 1.0f);
+                CHECK(std::fabs((box.y1 + box.y2) / 2.0f - c.height / 2.0f) <= 1.0f);
+                // Numbered outward from the center line on both sides
+                const int side = static_cast<int>(i) < perSide ? perSide - static_cast<int>(i) : static_cast<int>(i) - perSide + 1;
+                CHECK_EQ(box.number, side);
+                if (i > 0) {
+                    const EyeZoomBox& prev = overlay.boxes[i - 1];
+                    CHECK(box.firstColor != prev.firstColor);
+                    // Neighbors share an edge
+                    CHECK_EQ(box.x1, prev.x2);
+                }
+            }
+            // With an even clone width, the boxes next to the center line meet under it and boxes covering the
+            // whole clone stretch edge to edge (an odd one centers the line on the first right box)
+            if (perSide * 2 == c.cloneWidth) {
+                const EyeZoomBox& centerLeft = overlay.boxes[perSide - 1];
+                CHECK(centerLeft.x2 >= overlay.lineX1 && centerLeft.x2 <= overlay.lineX2);
+                CHECK_EQ(overlay.boxes.front().x1, 0.0f);
+                CHECK_EQ(overlay.boxes.back().x2, static_cast<float>(c.width));
+            }
+
+            // Two pixels wide on the strip's center
+            CHECK(IsWhole(overlay.lineX1) && IsWhole(overlay.lineX2));
+            CHECK_EQ(overlay.lineX2 - overlay.lineX1, 2.0f);
+            CHECK(std::fabs((overlay.lineX1 + overlay.lineX2) / 2.0f - c.width / 2.0f) <= 0.5f);
+        }
+    }
+    SetTestContext("");
+}
+
+TEST_CASE(BoxesAreClippedToShortStrips) {
+    EyeZoomLayoutParams params;
+    params.linkRectToFont = false;
+    params.rectHeight = 100;
+    EyeZoomOverlay overlay;
+    LayoutEyeZoomOverlay(params, 240, 60, false, nullptr, overlay);
+    REQUIRE(overlay.boxes.size() == 24);
+    for (const EyeZoomBox& box : overlay.boxes) {
+        CHECK_EQ(box.y1, 0.0f);
+        CHECK_EQ(box.y2, 60.0f);
+    }
+
+    // Nothing to lay out: the overlay is emptied, keeping the requested size
+    LayoutEyeZoomOverlay(params, 0, 60, true, nullptr, overlay);
+    CHECK(overlay.boxes.empty());
+    CHECK_EQ(overlay.width, 0);
+    params.cloneWidth = 0;
+    LayoutEyeZoomOverlay(params, 240, 60, false, nullptr, overlay);
+    CHECK(overlay.boxes.empty());
+    CHECK_EQ(overlay.lineX2, overlay.lineX1);
+}
+
+TEST_CASE(AutoSizedLabelsFitAndCenterInTheirBoxes) {
+    const TestFont font;
+    float smallest = 1e9f;
+    for (const StripCase& c : STRIP_CASES) {
+        for (int requested : { 12, 24, 48 }) {
+            EyeZoomLayoutParams params;
+            params.cloneWidth = c.cloneWidth;
+            params.overlayWidth = c.overlayWidth;
+            params.textFontSize = requested;
+            SetTestContext(SizeContext(params, c.width, c.height) + ", font " + std::to_string(requested));
+
+            EyeZoomOverlay overlay;
+            LayoutEyeZoomOverlay(params, c.width, c.height, true, &font, overlay);
+            REQUIRE(overlay.labels.size() == overlay.boxes.size());
+
+            int glyphs = 0;
+            for (size_t i = 0; i < overlay.labels.size(); i++) {
+                const EyeZoomLabel& label = overlay.labels[i];
+                const EyeZoomBox& box = overlay.boxes[i];
+                CHECK_EQ(label.number, box.number);
+                CHECK(IsWhole(label.x) && IsWhole(label.y));
+                CHECK(label.fontSize <= requested);
+                CHECK(label.fontSize >= 6.0f);
+                smallest = (std::min)(smallest, label.fontSize);
+
+                float textW = 0.0f, textH = 0.0f;
+                font.MeasureText(label.fontSize, std::to_string(label.number).c_str(), textW, textH);
+                // Centered on the column (snapping moves it by under a pixel) and the strip's middle
+                const float columnCenter = (box.x1 + box.x2) / 2.0f;
+                CHECK(std::fabs(label.x + textW / 2.0f - columnCenter) <= 1.5f);
+                CHECK(std::fabs(label.y + textH / 2.0f - c.height / 2.0f) <= 1.0f);
+                // Inside the box unless the 6 px floor is hit
+                if (label.fontSize > 6.0f) {
+                    CHECK(textW <= overlay.columnWidth * 0.94f + 1e-3f);
+                    CHECK(textH <= 24.0f * requested / 20.0f);
+                }
+
+                CHECK_EQ(label.firstGlyph, glyphs);
+                glyphs += label.glyphCount;
+                CHECK(label.glyphCount <= static_cast<int>(std::to_string(label.number).size()));
+            }
+            CHECK_EQ(glyphs, static_cast<int>(overlay.glyphs.size()));
+            for (const EyeZoomFont::Glyph& g : overlay.glyphs) {
+                CHECK(g.x1 >= 0.0f && g.x2 <= c.width && g.x1 < g.x2);
+                CHECK(g.y1 >= 0.0f && g.y2 <= c.height && g.y1 < g.y2);
+            }
+        }
+    }
+    SetTestContext("");
+    std::printf("     smallest auto label size %.1f px\n", smallest);
+}
+
+TEST_CASE(FixedSizeLabelsAndMissingFont) {
+    const TestFont font;
+    EyeZoomLayoutParams params;
+    params.autoFontSize = false;
+    params.textFontSize = 40;
+    EyeZoomOverlay overlay;
+    LayoutEyeZoomOverlay(params, 480, 600, true, &font, overlay);
+    REQUIRE(overlay.labels.size() == 24);
+    for (const EyeZoomLabel& label : overlay.labels) CHECK_EQ(label.fontSize, 40.0f);
+    // Two-digit labels (48 px) overflow their 20 px columns but every glyph is kept, clipped at the strip's edges
+    CHECK_EQ(overlay.glyphs.size(), static_cast<size_t>(9 * 2 + 3 * 2 * 2));
+
+    // Text next to the strip's edge is cut at the edge, its atlas coordinates moved with it
+    params.textFontSize = 100;
+    params.cloneWidth = 2;
+    params.overlayWidth = 1;
+    LayoutEyeZoomOverlay(params, 40, 600, true, &font, overlay);
+    REQUIRE(overlay.labels.size() == 2);
+    REQUIRE(overlay.glyphs.size() == 2);
+    const EyeZoomFont::Glyph& left = overlay.glyphs[0];
+    CHECK_EQ(left.x1, 0.0f);
+    CHECK(left.x2 <= 40.0f);
+    // Digit 1 spans u 0.1 .. 0.175 over 60 px; the clipped glyph starts partway in
+    CHECK(left.u1 > 0.1f && left.u1 < left.u2 && left.u2 <= 0.175f + 1e-6f);
+
+    // No labels without a font or on strips too thin for them; boxes stay
+    LayoutEyeZoomOverlay(params, 40, 600, true, nullptr, overlay);
+    CHECK(overlay.labels.empty());
+    CHECK_EQ(overlay.boxes.size(), static_cast<size_t>(2));
+    LayoutEyeZoomOverlay(params, 40, 600, false, &font, overlay);
+    CHECK(overlay.labels.empty());
+    CHECK(overlay.glyphs.empty());
+}
+
+TEST_CASE(OverlayCoversTheSamePixelsWhereverTheStripIs) {
+    constexpr int FULL_W = 400, FULL_H = 240;
+    const EyeZoomColors colors{ { 1.0f, 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f, 1.0f }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f, 1.0f } };
+    const SoftwareRenderBackend backend;
+
+    for (const StripCase& c : { StripCase{ 24, 12, 150, 180 }, StripCase{ 7, 3, 101, 160 }, StripCase{ 30, 8, 173, 200 } }) {
+        EyeZoomLayoutParams params;
+        params.cloneWidth = c.cloneWidth;
+        params.overlayWidth = c.overlayWidth;
+        params.textFontSize = 18;
+        EyeZoomOverlay overlay;
+        LayoutEyeZoomOverlay(params, c.width, c.height, false, nullptr, overlay);
+
+        // The strip at rest, at odd offsets, and partly off screen to the left like a sliding strip
+        SoftwareImage reference;
+        const int positions[][2] = { { 0, 0 }, { 13, 7 }, { 57, 31 }, { -40, 20 }, { -c.width + 9, 3 } };
+        for (const auto& pos : positions) {
+            SetTestContext(SizeContext(params, c.width, c.height) + " at " + std::to_string(pos[0]) + "," + std::to_string(pos[1]));
+            RenderCommandList list;
+            RecordEyeZoomOverlay(overlay, colors, pos[0], pos[1], FULL_W, FULL_H, 0, RenderBlendMode::Alpha, list);
+            SoftwareImage image;
+            image.Resize(FULL_W, FULL_H);
+            image.Clear(0, 0, 0, 255);
+            backend.Execute(list, image);
+            if (pos[0] == 0 && pos[1] == 0) {
+                reference = image;
+                // Box and line pixels where the layout puts them
+                const EyeZoomBox& box = overlay.boxes.front();
+                const int channel = box.firstColor ? 0 : 1;
+                CHECK_EQ(WindowPixel(reference, static_cast<int>(box.x1), static_cast<int>(box.y1))[channel], 255);
+                CHECK_EQ(WindowPixel(reference, static_cast<int>(box.x1), static_cast<int>(box.y1) - 1)[channel], 0);
+                CHECK_EQ(WindowPixel(reference, static_cast<int>(overlay.lineX1), 0)[2], 255);
+                CHECK_EQ(WindowPixel(reference, static_cast<int>(overlay.lineX1) - 1, 0)[2], 0);
+                continue;
+            }
+            int differing = 0;
+            for (int y = 0; y < c.height; y++) {
+                for (int x = 0; x < c.width; x++) {
+                    const int tx = pos[0] + x, ty = pos[1] + y;
+                    if (tx < 0 || ty < 0 || tx >= FULL_W || ty >= FULL_H) continue;
+                    const uint8_t* a = WindowPixel(reference, x, y);
+                    const uint8_t* b = WindowPixel(image, tx, ty);
+                    if (a[0] != b[0] || a[1] != b[1] || a[2] != b[2]) differing++;
+                }
+            }
+            CHECK_EQ(differing, 0);
+        }
+    }
+    SetTestContext("");
+}
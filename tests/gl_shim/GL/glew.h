@@ -0,0 +1,25 @@
+#pragma once
+
+// ============================================================================
+// GL/GLEW.H (test shim) - Desktop GL entry points without GLEW
+// ============================================================================
+// The headless GL tests link libOpenGL directly, which exports every core entry point, so the modules
+// that include <GL/glew.h> get prototypes from glext.h instead. Extension flags report what the
+// llvmpipe context provides.
+// ============================================================================
+
+#ifndef GL_GLEXT_PROTOTYPES
+#define GL_GLEXT_PROTOTYPES 1
+#endif
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+#define GLEW_OK 0
+#define GLEW_VERSION_3_3 1
+#define GLEW_VERSION_4_1 1
+#define GLEW_VERSION_4_4 1
+#define GLEW_ARB_buffer_storage 1
+#define GLEW_ARB_get_program_binary 1
+#define GLEW_ARB_timer_query 1
+
+inline int glewInit() { return GLEW_OK; }
@@ -0,0 +1,465 @@
+// ============================================================================
+// GL_STATE_TRACKER_TEST.CPP - GLStateTracker capture, restore and elision on a fake GL backend
+// ============================================================================
+// The fake backend is a small GL state machine that counts every query and logs every state-changing call,
+// so the cases can check exactly what the tracker asks GL for, which calls reach GL, and that EndFrame puts
+// back the game's state with nothing more than the fields that differ. The last case runs the GL backend
+// on the headless context.
+// ============================================================================
+
+#include "gl_state_tracker.h"
+#include "gl_test_context.h"
+#include "test_common.h"
+
+#include <array>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <windows.h>
+
+// Set by the hook installer in the DLL (dllmain.cpp); without it the tracker calls glViewport
+void(WINAPI* oglViewport)(GLint x, GLint y, GLsizei width, GLsizei height) = nullptr;
+
+namespace {
+
+class FakeGLBackend final : public GLStateBackend {
+  public:
+    struct State {
+        std::map<GLenum, std::array<GLint, 4>> ints;
+        std::map<GLenum, std::array<GLfloat, 4>> floats;
+        std::set<GLenum> enabled;
+        GLint textures[GLStateTracker::MAX_TEXTURE_UNITS] = {};
+
+        bool operator==(const State& o) const {
+            for (int unit = 0; unit < GLStateTracker::MAX_TEXTURE_UNITS; unit++) {
+                if (textures[unit] != o.textures[unit]) return false;
+            }
+            return SameValues(ints, o.ints) && SameValues(floats, o.floats) && enabled == o.enabled;
+        }
+
+        // Values never set read as zero, like the fake's getters return them
+        template <typename Map> static bool SameValues(const Map& a, const Map& b) {
+            auto contained = [](const Map& x, const Map& y) {
+                for (const auto& [pname, v] : x) {
+                    auto it = y.find(pname);
+                    if (it == y.end() ? v != typename Map::mapped_type{} : it->second != v) return false;
+                }
+                return true;
+            };
+            return contained(a, b) && contained(b, a);
+        }
+    };
+
+    FakeGLBackend() {
+        // GL's initial values for what the defaults matter to
+        state.ints[GL_ACTIVE_TEXTURE] = { GL_TEXTURE0 };
+        state.ints[GL_BLEND_SRC_RGB] = { GL_ONE };
+        state.ints[GL_BLEND_SRC_ALPHA] = { GL_ONE };
+        state.ints[GL_BLEND_DST_RGB] = { GL_ZERO };
+        state.ints[GL_BLEND_DST_ALPHA] = { GL_ZERO };
+        state.ints[GL_COLOR_WRITEMASK] = { 1, 1, 1, 1 };
+        state.ints[GL_UNPACK_ALIGNMENT] = { 4 };
+        state.ints[GL_PACK_ALIGNMENT] = { 4 };
+        state.floats[GL_LINE_WIDTH] = { 1.0f };
+        state.enabled.insert(GL_DITHER);
+    }
+
+    void GetIntegerv(GLenum pname, GLint* out) override {
+        queries[pname]++;
+        if (pname == GL_TEXTURE_BINDING_2D) {
+            out[0] = state.textures[ActiveUnit()];
+            return;
+        }
+        const std::array<GLint, 4>& v = state.ints[pname];
+        const int count = (pname == GL_VIEWPORT || pname == GL_SCISSOR_BOX) ? 4 : 1;
+        for (int k = 0; k < count; k++) out[k] = v[k];
+    }
+    void GetFloatv(GLenum pname, GLfloat* out) override {
+        queries[pname]++;
+        const std::array<GLfloat, 4>& v = state.floats[pname];
+        const int count = (pname == GL_COLOR_CLEAR_VALUE) ? 4 : 1;
+        for (int k = 0; k < count; k++) out[k] = v[k];
+    }
+    void GetBooleanv(GLenum pname, GLboolean* out) override {
+        queries[pname]++;
+        for (int k = 0; k < 4; k++) out[k] = state.ints[pname][k] ? GL_TRUE : GL_FALSE;
+    }
+    bool IsEnabled(GLenum cap) override {
+        queries[cap]++;
+        return state.enabled.count(cap) != 0;
+    }
+
+    void SetEnabled(GLenum cap, bool on) override {
+        Call(on ? "Enable " : "Disable ", cap);
+        if (on)
+            state.enabled.insert(cap);
+        else
+            state.enabled.erase(cap);
+    }
+    void UseProgram(GLuint program) override { Set("UseProgram", GL_CURRENT_PROGRAM, program); }
+    void BindVertexArray(GLuint vao) override { Set("BindVertexArray", GL_VERTEX_ARRAY_BINDING, vao); }
+    void BindBuffer(GLenum target, GLuint buffer) override {
+        const GLenum binding = target == GL_ARRAY_BUFFER        ? GL_ARRAY_BUFFER_BINDING
+                               : target == GL_PIXEL_PACK_BUFFER ? GL_PIXEL_PACK_BUFFER_BINDING
+                                                                : GL_PIXEL_UNPACK_BUFFER_BINDING;
+        Set("BindBuffer", binding, buffer);
+    }
+    void BindFramebuffer(GLenum target, GLuint framebuffer) override {
+        Call("BindFramebuffer ", target);
+        if (target != GL_DRAW_FRAMEBUFFER) state.ints[GL_READ_FRAMEBUFFER_BINDING] = { static_cast<GLint>(framebuffer) };
+        if (target != GL_READ_FRAMEBUFFER) state.ints[GL_DRAW_FRAMEBUFFER_BINDING] = { static_cast<GLint>(framebuffer) };
+    }
+    void ActiveTexture(GLenum unit) override { Set("ActiveTexture", GL_ACTIVE_TEXTURE, unit); }
+    void BindTexture(GLenum, GLuint texture) override {
+        Call("BindTexture unit ", ActiveUnit());
+        state.textures[ActiveUnit()] = static_cast<GLint>(texture);
+    }
+    void BlendFuncSeparate(GLenum srcRgb, GLenum dstRgb, GLenum srcAlpha, GLenum dstAlpha) override {
+        calls.push_back("BlendFuncSeparate");
+        state.ints[GL_BLEND_SRC_RGB] = { static_cast<GLint>(srcRgb) };
+        state.ints[GL_BLEND_DST_RGB] = { static_cast<GLint>(dstRgb) };
+        state.ints[GL_BLEND_SRC_ALPHA] = { static_cast<GLint>(srcAlpha) };
+        state.ints[GL_BLEND_DST_ALPHA] = { static_cast<GLint>(dstAlpha) };
+    }
+    void Viewport(GLint x, GLint y, GLsizei width, GLsizei height) override {
+        calls.push_back("Viewport");
+        state.ints[GL_VIEWPORT] = { x, y, width, height };
+    }
+    void Scissor(GLint x, GLint y, GLsizei width, GLsizei height) override {
+        calls.push_back("Scissor");
+        state.ints[GL_SCISSOR_BOX] = { x, y, width, height };
+    }
+    void ClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a) override {
+        calls.push_back("ClearColor");
+        state.floats[GL_COLOR_CLEAR_VALUE] = { r, g, b, a };
+    }
+    void LineWidth(GLfloat width) override {
+        calls.push_back("LineWidth");
+        state.floats[GL_LINE_WIDTH] = { width };
+    }
+    void ColorMask(GLboolean r, GLboolean g, GLboolean b, GLboolean a) override {
+        calls.push_back("ColorMask");
+        state.ints[GL_COLOR_WRITEMASK] = { r, g, b, a };
+    }
+    void PixelStorei(GLenum pname, GLint value) override { Set("PixelStorei", pname, static_cast<GLuint>(value)); }
+    void* CurrentContext() override { return context; }
+
+    int TotalQueries() const {
+        int total = 0;
+        for (const auto& q : queries) total += q.second;
+        return total;
+    }
+    int QueriesOf(GLenum pname) const {
+        auto it = queries.find(pname);
+        return it == queries.end() ? 0 : it->second;
+    }
+
+    State state;
+    std::map<GLenum, int> queries;  // glGet/glIsEnabled calls per pname or capability
+    std::vector<std::string> calls; // State-changing calls, in order
+    void* context = reinterpret_cast<void*>(0x1);
+
+  private:
+    int ActiveUnit() { return state.ints[GL_ACTIVE_TEXTURE][0] - GL_TEXTURE0; }
+    void Call(const char* name, long long arg) { calls.push_back(name + std::to_string(arg)); }
+    void Set(const char* name, GLenum pname, GLuint value) {
+        calls.push_back(name);
+        state.ints[pname] = { static_cast<GLint>(value) };
+    }
+};
+
+// The game's state going into a frame: a program, blending on, two texture units bound, unit 2 active
+void SetGameState(FakeGLBackend& gl) {
+    gl.state.ints[GL_CURRENT_PROGRAM] = { 3 };
+    gl.state.ints[GL_DRAW_FRAMEBUFFER_BINDING] = { 7 };
+    gl.state.ints[GL_READ_FRAMEBUFFER_BINDING] = { 7 };
+    gl.state.ints[GL_VERTEX_ARRAY_BINDING] = { 5 };
+    gl.state.ints[GL_ACTIVE_TEXTURE] = { GL_TEXTURE2 };
+    gl.state.ints[GL_VIEWPORT] = { 0, 0, 1920, 1080 };
+    gl.state.enabled.insert(GL_BLEND);
+    gl.state.enabled.insert(GL_DEPTH_TEST);
+    gl.state.textures[0] = 11;
+    gl.state.textures[2] = 12;
+}
+
+} // namespace
+
+TEST_CASE(NothingIsQueriedUntilFirstChange) {
+    FakeGLBackend gl;
+    SetGameState(gl);
+    GLStateTracker tracker(gl);
+
+    tracker.BeginFrame();
+    CHECK(tracker.IsActive());
+    CHECK_EQ(gl.TotalQueries(), 0);
+
+    tracker.UseProgram(9);
+    CHECK_EQ(gl.QueriesOf(GL_CURRENT_PROGRAM), 1);
+    CHECK_EQ(gl.TotalQueries(), 1);
+    tracker.UseProgram(10);
+    tracker.UseProgram(3);
+    CHECK_EQ(gl.TotalQueries(), 1); // Captured once per frame
+
+    tracker.SetCapability(GL_BLEND, false);
+    CHECK_EQ(gl.QueriesOf(GL_BLEND), 1);
+    // Binding a texture needs the active unit, then the unit's binding
+    tracker.BindTexture(GL_TEXTURE_2D, 40);
+    CHECK_EQ(gl.QueriesOf(GL_ACTIVE_TEXTURE), 1);
+    CHECK_EQ(gl.QueriesOf(GL_TEXTURE_BINDING_2D), 1);
+    // Each unit is captured on its first binding
+    tracker.ActiveTexture(GL_TEXTURE0);
+    tracker.BindTexture(GL_TEXTURE_2D, 41);
+    CHECK_EQ(gl.QueriesOf(GL_TEXTURE_BINDING_2D), 2);
+    CHECK_EQ(gl.TotalQueries(), 5);
+    // State the frame never touched is never read
+    CHECK_EQ(gl.QueriesOf(GL_SCISSOR_BOX), 0);
+    CHECK_EQ(gl.QueriesOf(GL_DEPTH_TEST), 0);
+    CHECK_EQ(gl.QueriesOf(GL_VERTEX_ARRAY_BINDING), 0);
+    tracker.EndFrame();
+    CHECK_EQ(tracker.LastFrameStats().queries, 5u);
+
+    // The next frame captures again: the game may have changed anything in between
+    gl.state.ints[GL_CURRENT_PROGRAM] = { 4 };
+    tracker.BeginFrame();
+    tracker.UseProgram(9);
+    tracker.EndFrame();
+    CHECK_EQ(gl.QueriesOf(GL_CURRENT_PROGRAM), 2);
+    CHECK_EQ(gl.state.ints[GL_CURRENT_PROGRAM][0], 4);
+
+    // Game values read up front are captured once and then served from the capture
+    tracker.BeginFrame();
+    CHECK_EQ(tracker.GameDrawFramebuffer(), 7);
+    tracker.BindFramebuffer(GL_FRAMEBUFFER, 0);
+    CHECK_EQ(tracker.GameDrawFramebuffer(), 7);
+    CHECK_EQ(tracker.GameReadFramebuffer(), 7);
+    CHECK_EQ(gl.QueriesOf(GL_DRAW_FRAMEBUFFER_BINDING), 1);
+    CHECK_EQ(gl.QueriesOf(GL_READ_FRAMEBUFFER_BINDING), 1);
+    tracker.EndFrame();
+}
+
+TEST_CASE(ViewportComesFromTheHook) {
+    FakeGLBackend gl;
+    SetGameState(gl);
+    GLStateTracker tracker(gl);
+
+    // The glViewport hook reports what the game set; GL has the same viewport
+    gl.state.ints[GL_VIEWPORT] = { 10, 20, 800, 600 };
+    tracker.NoteGameViewport(10, 20, 800, 600);
+    tracker.BeginFrame();
+    GLint vp[4] = {};
+    tracker.GameViewport(vp);
+    CHECK(vp[0] == 10 && vp[1] == 20 && vp[2] == 800 && vp[3] == 600);
+    tracker.Viewport(0, 0, 1920, 1080);
+    // Our own viewport calls during the frame are not the game's
+    tracker.NoteGameViewport(0, 0, 1920, 1080);
+    tracker.EndFrame();
+    CHECK_EQ(gl.QueriesOf(GL_VIEWPORT), 0);
+    CHECK(gl.state.ints[GL_VIEWPORT] == (std::array<GLint, 4>{ 10, 20, 800, 600 }));
+
+    // A viewport noted on another context is not used: GL is asked instead
+    gl.context = reinterpret_cast<void*>(0x2);
+    gl.state.ints[GL_VIEWPORT] = { 0, 0, 640, 480 };
+    tracker.BeginFrame();
+    tracker.GameViewport(vp);
+    CHECK(vp[2] == 640 && vp[3] == 480);
+    CHECK_EQ(gl.QueriesOf(GL_VIEWPORT), 1);
+    tracker.EndFrame();
+}
+
+TEST_CASE(EndFrameRestoresExactlyTheFieldsThatDiffer) {
+    FakeGLBackend gl;
+    SetGameState(gl);
+    gl.state.ints[GL_VIEWPORT] = { 0, 0, 1920, 1080 };
+    GLStateTracker tracker(gl);
+    tracker.NoteGameViewport(0, 0, 1920, 1080);
+    const FakeGLBackend::State game = gl.state;
+
+    tracker.BeginFrame();
+    // Changed and left changed
+    tracker.UseProgram(9);
+    tracker.Viewport(100, 0, 384, 1080);
+    tracker.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    tracker.ActiveTexture(GL_TEXTURE0);
+    tracker.BindTexture(GL_TEXTURE_2D, 50);
+    tracker.PixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    // Changed and changed back
+    tracker.SetCapability(GL_DEPTH_TEST, false);
+    tracker.SetCapability(GL_DEPTH_TEST, true);
+    tracker.Scissor(1, 2, 3, 4);
+    tracker.Scissor(0, 0, 0, 0);
+    // Set to what it already was
+    tracker.SetCapability(GL_BLEND, true);
+    tracker.ColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    CHECK(!(gl.state == game));
+
+    gl.calls.clear();
+    tracker.EndFrame();
+    CHECK(gl.state == game);
+    // Texture bindings first (on their own unit), then the rest in field order, active unit included
+    const std::vector<std::string> expected = { "BindTexture unit 0", "UseProgram", "ActiveTexture", "BlendFuncSeparate", "Viewport",
+                                                "PixelStorei" };
+    CHECK_EQ(gl.calls.size(), expected.size());
+    CHECK_EQ(tracker.LastFrameStats().restoreCalls, static_cast<uint32_t>(expected.size()));
+    for (size_t i = 0; i < gl.calls.size(); i++) {
+        SetTestContext("call " + std::to_string(i));
+        CHECK_EQ(gl.calls[i], i < expected.size() ? expected[i] : std::string());
+    }
+    SetTestContext("");
+
+    // A texture unit other than the active one is restored by switching to it
+    tracker.BeginFrame();
+    tracker.ActiveTexture(GL_TEXTURE1);
+    tracker.BindTexture(GL_TEXTURE_2D, 60);
+    tracker.ActiveTexture(GL_TEXTURE2);
+    gl.calls.clear();
+    tracker.EndFrame();
+    CHECK(gl.state == game);
+    CHECK(gl.calls == (std::vector<std::string>{ "ActiveTexture", "BindTexture unit 1", "ActiveTexture" }));
+
+    // A frame that changes nothing restores nothing
+    tracker.BeginFrame();
+    tracker.SetCapability(GL_BLEND, true);
+    gl.calls.clear();
+    tracker.EndFrame();
+    CHECK(gl.calls.empty());
+    CHECK_EQ(tracker.LastFrameStats().restoreCalls, 0u);
+}
+
+TEST_CASE(RedundantSetsAreElided) {
+    FakeGLBackend gl;
+    SetGameState(gl);
+    GLStateTracker tracker(gl);
+
+    tracker.BeginFrame();
+    for (int i = 0; i < 3; i++) {
+        tracker.SetCapability(GL_BLEND, false);     // 1 of 3 issued
+        tracker.BlendFunc(GL_ONE, GL_ONE);          // 1 of 3
+        tracker.UseProgram(4);                      // 1 of 3
+        tracker.Viewport(0, 0, 64, 64);             // 1 of 3
+        tracker.PixelStorei(GL_PACK_ALIGNMENT, 1);  // 1 of 3
+        tracker.LineWidth(1.0f);                    // Already the game's: 0 of 3
+        tracker.BindTexture(GL_TEXTURE_2D, 8);      // Bindings are always issued: 3 of 3
+        tracker.BindFramebuffer(GL_FRAMEBUFFER, 2); // 3 of 3, one call for both bindings
+    }
+    CHECK_EQ(gl.calls.size(), static_cast<size_t>(5 + 3 + 3));
+    tracker.EndFrame();
+
+    // What "GL State Calls Issued" reports for the frame
+    const GLStateFrameStats& stats = tracker.LastFrameStats();
+    CHECK_EQ(stats.calls, 24u);
+    CHECK_EQ(stats.issued, 11u);
+
+    // Outside a frame every call goes straight to GL and nothing is counted
+    gl.calls.clear();
+    tracker.UseProgram(4);
+    tracker.UseProgram(4);
+    tracker.SetCapability(GL_BLEND, true);
+    CHECK_EQ(gl.calls.size(), static_cast<size_t>(3));
+    CHECK_EQ(tracker.LastFrameStats().calls, 24u);
+
+    // Capabilities and pixel-store parameters the tracker has no field for pass through during a frame
+    tracker.BeginFrame();
+    gl.calls.clear();
+    tracker.SetCapability(GL_DITHER, false);
+    tracker.SetCapability(GL_DITHER, false);
+    tracker.PixelStorei(GL_UNPACK_IMAGE_HEIGHT, 0);
+    CHECK_EQ(gl.calls.size(), static_cast<size_t>(3));
+    tracker.EndFrame();
+    CHECK_EQ(tracker.LastFrameStats().calls, 0u);
+}
+
+TEST_CASE(ValidateReportsShadowValuesThatDifferFromGL) {
+    FakeGLBackend gl;
+    SetGameState(gl);
+    GLStateTracker tracker(gl);
+    TakeTestLogMessages();
+
+    tracker.BeginFrame();
+    tracker.UseProgram(9);
+    tracker.SetCapability(GL_BLEND, false);
+    tracker.ActiveTexture(GL_TEXTURE0);
+    tracker.BindTexture(GL_TEXTURE_2D, 21);
+    CHECK_EQ(tracker.Validate("in frame"), 0);
+    CHECK(TakeTestLogMessages().empty());
+
+    // Changed behind the tracker's back
+    gl.state.ints[GL_CURRENT_PROGRAM] = { 77 };
+    gl.state.textures[0] = 0; // e.g. the bound texture was deleted
+    CHECK_EQ(tracker.Validate("in frame"), 2);
+    const std::vector<std::string> log = TakeTestLogMessages();
+    REQUIRE(log.size() == 2);
+    CHECK(log[0].find("[glstate]") == 0);
+    CHECK(log[0].find("program mismatch in frame") != std::string::npos);
+    CHECK(log[0].find("tracked {9/") != std::string::npos);
+    CHECK(log[0].find("actual {77/") != std::string::npos);
+    CHECK(log[1].find("texture 2D binding (unit 0) mismatch") != std::string::npos);
+
+    // Untracked state is not checked; validation queries are not counted against the frame
+    gl.state.ints[GL_SCISSOR_BOX] = { 1, 1, 1, 1 };
+    CHECK_EQ(tracker.Validate("in frame"), 2);
+    TakeTestLogMessages();
+    tracker.EndFrame();
+    CHECK_EQ(tracker.LastFrameStats().queries, 4u);
+    CHECK_EQ(gl.state.ints[GL_CURRENT_PROGRAM][0], 3);
+    CHECK_EQ(tracker.Validate("after"), 0);
+    TakeTestLogMessages();
+}
+
+TEST_CASE(GLBackendRestoresTheGameState) {
+    RequireGLContext();
+    GLuint tex = CreateTestTexture(4, 4);
+    GLuint fbo = CreateTestFramebuffer(tex);
+    GLuint program = BuildTestProgram("#version 330 core\nvoid main() { gl_Position = vec4(0.0); }\n",
+                                      "#version 330 core\nout vec4 c;\nvoid main() { c = vec4(1.0); }\n");
+
+    // The "game" state
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glUseProgram(0);
+    glDisable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ZERO);
+    glViewport(0, 0, 64, 48);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    GLStateTracker& tracker = GLStateTracker::ForCurrentThread();
+    tracker.NoteGameViewport(0, 0, 64, 48);
+
+    tracker.BeginFrame();
+    GLTracked::BindFramebuffer(GL_FRAMEBUFFER, fbo);
+    GLTracked::UseProgram(program);
+    GLTracked::Enable(GL_BLEND);
+    GLTracked::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLTracked::Viewport(0, 0, 4, 4);
+    GLTracked::PixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    GLTracked::ActiveTexture(GL_TEXTURE3);
+    GLTracked::BindTexture(GL_TEXTURE_2D, tex);
+    CHECK_EQ(tracker.Validate("in frame"), 0);
+    tracker.EndFrame();
+    CHECK_EQ(tracker.Validate("after"), 0);
+    CHECK(TakeTestLogMessages().empty());
+
+    GLint v[4] = {};
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, v);
+    CHECK_EQ(v[0], 0);
+    glGetIntegerv(GL_CURRENT_PROGRAM, v);
+    CHECK_EQ(v[0], 0);
+    CHECK(!glIsEnabled(GL_BLEND));
+    glGetIntegerv(GL_BLEND_SRC_RGB, v);
+    CHECK_EQ(v[0], GL_ONE);
+    glGetIntegerv(GL_VIEWPORT, v);
+    CHECK(v[0] == 0 && v[1] == 0 && v[2] == 64 && v[3] == 48);
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, v);
+    CHECK_EQ(v[0], 4);
+    glGetIntegerv(GL_ACTIVE_TEXTURE, v);
+    CHECK_EQ(v[0], GL_TEXTURE0);
+    glActiveTexture(GL_TEXTURE3);
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, v);
+    CHECK_EQ(v[0], 0);
+    glActiveTexture(GL_TEXTURE0);
+    CHECK_EQ(glGetError(), static_cast<GLenum>(GL_NO_ERROR));
+
+    glDeleteProgram(program);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &tex);
+}
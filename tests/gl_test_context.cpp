@@ -0,0 +1,125 @@
+// ============================================================================
+// GL_TEST_CONTEXT.CPP - Headless GL context for the GL tests
+// ============================================================================
+
+#include "gl_test_context.h"
+#include "test_common.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <cstdio>
+
+namespace {
+
+struct HeadlessContext {
+    bool attempted = false;
+    std::string error;
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLContext context = EGL_NO_CONTEXT;
+};
+
+HeadlessContext g_context;
+
+bool CreateContext(HeadlessContext& ctx) {
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (!getPlatformDisplay) {
+        ctx.error = "eglGetPlatformDisplayEXT unavailable";
+        return false;
+    }
+    ctx.display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (ctx.display == EGL_NO_DISPLAY || !eglInitialize(ctx.display, nullptr, nullptr)) {
+        ctx.error = "no surfaceless EGL display";
+        return false;
+    }
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        ctx.error = "eglBindAPI(EGL_OPENGL_API) failed";
+        return false;
+    }
+    const EGLint attribs[] = { EGL_CONTEXT_MAJOR_VERSION, 4, EGL_CONTEXT_MINOR_VERSION, 5, EGL_CONTEXT_OPENGL_PROFILE_MASK,
+                               EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT, EGL_NONE };
+    ctx.context = eglCreateContext(ctx.display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, attribs);
+    if (ctx.context == EGL_NO_CONTEXT) {
+        ctx.error = "no GL 4.5 context";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+void RequireGLContext() {
+    if (!g_context.attempted) {
+        g_context.attempted = true;
+        if (!CreateContext(g_context)) fprintf(stderr, "  headless GL unavailable: %s\n", g_context.error.c_str());
+    }
+    if (g_context.context == EGL_NO_CONTEXT) SkipTestCase("no headless GL context: " + g_context.error);
+    REQUIRE(eglMakeCurrent(g_context.display, EGL_NO_SURFACE, EGL_NO_SURFACE, g_context.context));
+}
+
+GLuint BuildTestProgram(const char* vertSrc, const char* fragSrc) {
+    auto compile = [](GLenum type, const char* src) {
+        GLuint shader = glCreateShader(type);
+        glShaderSource(shader, 1, &src, nullptr);
+        glCompileShader(shader);
+        GLint ok = 0;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+        if (!ok) {
+            char log[1024] = {};
+            glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+            ReportTestFailure(__FILE__, __LINE__, std::string("shader compile error: ") + log);
+            throw TestCaseAborted{};
+        }
+        return shader;
+    };
+    GLuint vs = compile(GL_VERTEX_SHADER, vertSrc);
+    GLuint fs = compile(GL_FRAGMENT_SHADER, fragSrc);
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    glLinkProgram(program);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+    GLint ok = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        char log[1024] = {};
+        glGetProgramInfoLog(program, sizeof(log), nullptr, log);
+        ReportTestFailure(__FILE__, __LINE__, std::string("program link error: ") + log);
+        throw TestCaseAborted{};
+    }
+    return program;
+}
+
+GLuint CreateTestTexture(int w, int h, const uint8_t* pixels) {
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return texture;
+}
+
+GLuint CreateTestFramebuffer(GLuint texture) {
+    GLuint fbo = 0;
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    REQUIRE(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return fbo;
+}
+
+std::vector<uint8_t> ReadTestFramebuffer(GLuint fbo, int w, int h) {
+    std::vector<uint8_t> pixels(static_cast<size_t>(w) * h * 4);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    return pixels;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+// ============================================================================
+// GL_TEST_CONTEXT.H - Headless GL context for the GL tests
+// ============================================================================
+// Creates one surfaceless EGL context (Mesa llvmpipe in CI) with a 4.5 compatibility profile and makes
+// it current on the calling thread. Tests render into their own FBOs and read results back.
+// ============================================================================
+
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Makes the shared test context current, creating it on first use. Skips the current test case when no
+// context can be created (no EGL device, no driver).
+void RequireGLContext();
+
+// Compiles and links a program from vertex and fragment sources; REQUIREs success
+GLuint BuildTestProgram(const char* vertSrc, const char* fragSrc);
+
+// RGBA8 texture with nearest filtering and clamp-to-edge, optionally initialized from `pixels` (bottom row first)
+GLuint CreateTestTexture(int w, int h, const uint8_t* pixels = nullptr);
+
+// Framebuffer with `texture` as its only color attachment; REQUIREs completeness
+GLuint CreateTestFramebuffer(GLuint texture);
+
+// Reads back the color attachment of `fbo`, bottom row first
+std::vector<uint8_t> ReadTestFramebuffer(GLuint fbo, int w, int h);
@@ -0,0 +1,404 @@
+// ============================================================================
+// GPU_RESOURCES_TEST.CPP - GpuResourceManager handles, retirement and accounting on a fake backend
+// ============================================================================
+// The fake backend records every delete call and hands out fences that signal only when the test says so,
+// so stale handles, the order in which Retire() deletes per queue, Flush() and the per-subsystem byte and
+// object totals can be checked exactly. The last case runs the GL backend on the headless context.
+// ============================================================================
+
+#include "gl_test_context.h"
+#include "gpu_resources.h"
+#include "test_common.h"
+
+#include <set>
+#include <vector>
+
+namespace {
+
+class FakeResourceBackend final : public GpuResourceBackend {
+  public:
+    struct DeleteCall {
+        GpuResourceKind kind;
+        std::vector<uint32_t> names;
+    };
+
+    void DeleteObjects(GpuResourceKind kind, const uint32_t* names, int count) override {
+        deleteCalls.push_back(DeleteCall{ kind, std::vector<uint32_t>(names, names + count) });
+    }
+    uint64_t InsertFence() override {
+        live.insert(m_nextFence);
+        return m_nextFence++;
+    }
+    bool IsFenceSignaled(uint64_t fence) override {
+        CHECK(live.count(fence) == 1);
+        return signaled.count(fence) != 0;
+    }
+    void DeleteFence(uint64_t fence) override {
+        CHECK(live.erase(fence) == 1);
+        deletedFences.push_back(fence);
+    }
+
+    // Names deleted so far, in call order
+    std::vector<uint32_t> DeletedNames() const {
+        std::vector<uint32_t> names;
+        for (const DeleteCall& call : deleteCalls) names.insert(names.end(), call.names.begin(), call.names.end());
+        return names;
+    }
+    uint64_t LastFence() const { return m_nextFence - 1; }
+
+    std::vector<DeleteCall> deleteCalls;
+    std::set<uint64_t> live;     // Inserted, not yet deleted
+    std::set<uint64_t> signaled; // Set by the test
+    std::vector<uint64_t> deletedFences;
+
+  private:
+    uint64_t m_nextFence = 1;
+};
+
+using Names = std::vector<uint32_t>;
+
+uint64_t SubsystemBytes(const GpuMemoryStats& stats, GpuSubsystem subsystem) { return stats.bytes[static_cast<int>(subsystem)]; }
+uint32_t SubsystemObjects(const GpuMemoryStats& stats, GpuSubsystem subsystem) { return stats.objects[static_cast<int>(subsystem)]; }
+
+GpuResourceHandle RegisterTexture(GpuResourceManager& manager, uint32_t name, uint64_t bytes = 64) {
+    return manager.Register(GpuResourceKind::Texture, name, GpuSubsystem::Images, bytes);
+}
+
+} // namespace
+
+TEST_CASE(NameZeroIsNotRegistered) {
+    FakeResourceBackend gpu;
+    GpuResourceManager manager(gpu);
+    const GpuResourceHandle handle = manager.Register(GpuResourceKind::Texture, 0, GpuSubsystem::Mirrors, 1024);
+    CHECK(!handle.IsValid());
+    CHECK_EQ(manager.Resolve(handle), 0u);
+    CHECK_EQ(manager.Stats().totalBytes, 0u);
+    CHECK_EQ(SubsystemObjects(manager.Stats(), GpuSubsystem::Mirrors), 0u);
+}
+
+TEST_CASE(ReleasedHandleCopiesGoStaleAtOnce) {
+    FakeResourceBackend gpu;
+    GpuResourceManager manager(gpu);
+    GpuResourceHandle a = RegisterTexture(manager, 11, 100);
+    const GpuResourceHandle copy = a;
+    CHECK(a.IsValid());
+    CHECK_EQ(manager.Resolve(copy), 11u);
+
+    manager.Release(a);
+    CHECK(!a.IsValid());
+    // Stale before the object is deleted: the generation was bumped in EndSlot
+    CHECK(gpu.deleteCalls.empty());
+    CHECK_EQ(manager.Resolve(copy), 0u);
+
+    // Nothing reaches the released slot through the stale copy
+    GpuResourceHandle staleRelease = copy;
+    manager.Release(staleRelease);
+    CHECK(!staleRelease.IsValid());
+    GpuResourceHandle staleNow = copy;
+    manager.ReleaseNow(staleNow);
+    CHECK(!staleNow.IsValid());
+    manager.SetBytes(copy, 1 << 20);
+    CHECK(gpu.deleteCalls.empty());
+    CHECK_EQ(manager.Stats().pendingDeletes, 1u);
+    CHECK_EQ(manager.Stats().totalBytes, 0u);
+}
+
+TEST_CASE(ReusedSlotGetsANewGeneration) {
+    FakeResourceBackend gpu;
+    GpuResourceManager manager(gpu);
+    GpuResourceHandle a = RegisterTexture(manager, 11);
+    const GpuResourceHandle oldA = a;
+    manager.Release(a);
+
+    // The GL name can come back too; the stale handle must not resolve to the new object
+    const GpuResourceHandle b = RegisterTexture(manager, 11);
+    CHECK_EQ(b.index, oldA.index);
+    CHECK_EQ(b.generation, oldA.generation + 2); // Once in EndSlot, once in Register
+    CHECK(b != oldA);
+    CHECK_EQ(manager.Resolve(oldA), 0u);
+    CHECK_EQ(manager.Resolve(b), 11u);
+
+    GpuResourceHandle stale = oldA;
+    manager.Release(stale);
+    CHECK_EQ(manager.Resolve(b), 11u);
+    CHECK_EQ(manager.Stats().pendingDeletes, 1u);
+
+    // Handles from other slots or out of range
+    CHECK_EQ(manager.Resolve(GpuResourceHandle{ 7, 1 }), 0u);
+    CHECK_EQ(manager.Resolve(GpuResourceHandle{ b.index, 0 }), 0u);
+}
+
+TEST_CASE(FreeSlotsAreReusedBeforeGrowing) {
+    FakeResourceBackend gpu;
+    GpuResourceManager manager(gpu);
+    std::vector<GpuResourceHandle> handles;
+    for (uint32_t i = 0; i < 4; i++) handles.push_back(RegisterTexture(manager, 20 + i));
+    for (uint32_t i = 0; i < 4; i++) CHECK_EQ(handles[i].index, i);
+    manager.Release(handles[1]);
+    manager.Release(handles[3]);
+    const GpuResourceHandle c = RegisterTexture(manager, 30);
+    const GpuResourceHandle d = RegisterTexture(manager, 31);
+    const GpuResourceHandle e = RegisterTexture(manager, 32);
+    CHECK(c.index == 1 || c.index == 3);
+    CHECK(d.index == 1 || d.index == 3);
+    CHECK(c.index != d.index);
+    CHECK_EQ(e.index, 4u);
+}
+
+TEST_CASE(RetireWaitsForTheBatchFence) {
+    FakeResourceBackend gpu;
+    GpuResourceManager manager(gpu);
+    GpuResourceHandle a = RegisterTexture(manager, 11);
+    GpuResourceHandle b = RegisterTexture(manager, 12);
+    CHECK(!manager.HasPending(GpuContextQueue::Game));
+    manager.Release(a);
+    manager.Release(b);
+    CHECK(manager.HasPending(GpuContextQueue::Game));
+    CHECK(!manager.HasPending(GpuContextQueue::RenderThread));
+
+    // One fence for everything released since the last call; not signaled yet
+    manager.Retire(GpuContextQueue::Game);
+    CHECK_EQ(gpu.live.size(), 1u);
+    CHECK(gpu.deleteCalls.empty());
+    CHECK_EQ(manager.Stats().pendingDeletes, 2u);
+
+    // Nothing new released: no second fence
+    manager.Retire(GpuContextQueue::Game);
+    CHECK_EQ(gpu.LastFence(), 1u);
+    CHECK(gpu.deleteCalls.empty());
+
+    gpu.signaled.insert(1);
+    manager.Retire(GpuContextQueue::Game);
+    CHECK(gpu.DeletedNames() == Names({ 11, 12 }));
+    CHECK_EQ(gpu.deleteCalls.size(), 1u);
+    CHECK(gpu.deletedFences == std::vector<uint64_t>({ 1 }));
+    CHECK(gpu.live.empty());
+    CHECK(!manager.HasPending(GpuContextQueue::Game));
+    CHECK_EQ(manager.Stats().pendingDeletes, 0u);
+}
+
+TEST_CASE(RetireDeletesBatchesInFenceOrder) {
+    FakeResourceBackend gpu;
+    GpuResourceManager manager(gpu);
+    for (uint32_t frame = 0; frame < 3; frame++) {
+        GpuResourceHandle h = RegisterTexture(manager, 100 + frame);
+        manager.Release(h);
+        manager.Retire(GpuContextQueue::Game); // Fence frame + 1
+    }
+    CHECK_EQ(gpu.live.size(), 3u);
+
+    // A later fence reporting first does not let its batch overtake the older ones
+    gpu.signaled.insert(2);
+    gpu.signaled.insert(3);
+    manager.Retire(GpuContextQueue::Game);
+    CHECK(gpu.deleteCalls.empty());
+    CHECK_EQ(manager.Stats().pendingDeletes, 3u);
+
+    gpu.signaled.insert(1);
+    manager.Retire(GpuContextQueue::Game);
+    CHECK(gpu.DeletedNames() == Names({ 100, 101, 102 }));
+    CHECK(gpu.deletedFences == std::vector<uint64_t>({ 1, 2, 3 }));
+
+    // Stops at the first unsignaled fence and keeps the rest for later frames
+    gpu.deleteCalls.clear();
+    for (uint32_t frame = 0; frame < 3; frame++) {
+        GpuResourceHandle h = RegisterTexture(manager, 200 + frame);
+        manager.Release(h);
+        manager.Retire(GpuContextQueue::Game); // Fences 4, 5, 6
+    }
+    gpu.signaled.insert(4);
+    gpu.signaled.insert(6);
+    manager.Retire(GpuContextQueue::Game);
+    CHECK(gpu.DeletedNames() == Names({ 200 }));
+    CHECK_EQ(manager.Stats().pendingDeletes, 2u);
+    gpu.signaled.insert(5);
+    manager.Retire(GpuContextQueue::Game);
+    CHECK(gpu.DeletedNames() == Names({ 200, 201, 202 }));
+    CHECK(gpu.live.empty());
+}
+
+TEST_CASE(QueuesRetireIndependently) {
+    FakeResourceBackend gpu;
+    GpuResourceManager manager(gpu);
+    GpuResourceHandle game = RegisterTexture(manager, 11);
+    GpuResourceHandle render = RegisterTexture(manager, 12);
+    manager.Release(game, GpuContextQueue::Game);
+    manager.Release(render, GpuContextQueue::RenderThread);
+    CHECK(manager.HasPending(GpuContextQueue::Game));
+    CHECK(manager.HasPending(GpuContextQueue::RenderThread));
+
+    // Each queue fences only its own releases
+    manager.Retire(GpuContextQueue::Game);
+    const uint64_t gameFence = gpu.LastFence();
+    manager.Retire(GpuContextQueue::RenderThread);
+    const uint64_t renderFence = gpu.LastFence();
+    CHECK(gameFence != renderFence);
+
+    // The render thread's batch goes first although the game's fence is older
+    gpu.signaled.insert(renderFence);
+    manager.Retire(GpuContextQueue::Game);
+    manager.Retire(GpuContextQueue::RenderThread);
+    CHECK(gpu.DeletedNames() == Names({ 12 }));
+    CHECK(manager.HasPending(GpuContextQueue::Game));
+    CHECK(!manager.HasPending(GpuContextQueue::RenderThread));
+
+    gpu.signaled.insert(gameFence);
+    manager.Retire(GpuContextQueue::RenderThread);
+    CHECK(gpu.DeletedNames() == Names({ 12 }));
+    manager.Retire(GpuContextQueue::Game);
+    CHECK(gpu.DeletedNames() == Names({ 12, 11 }));
+}
+
+TEST_CASE(RetireDeletesOncePerKind) {
+    FakeResourceBackend gpu;
+    GpuResourceManager manager(gpu);
+    GpuResourceHandle handles[] = { manager.Register(GpuResourceKind::Framebuffer, 1, GpuSubsystem::Mirrors, 0),
+                                    manager.Register(GpuResourceKind::Texture, 2, GpuSubsystem::Mirrors, 64),
+                                    manager.Register(GpuResourceKind::Buffer, 3, GpuSubsystem::Images, 64),
+                                    manager.Register(GpuResourceKind::Texture, 4, GpuSubsystem::Images, 64),
+                                    manager.Register(GpuResourceKind::Renderbuffer, 5, GpuSubsystem::Cursors, 64),
+                                    manager.Register(GpuResourceKind::Framebuffer, 6, GpuSubsystem::Mirrors, 0) };
+    for (GpuResourceHandle& h : handles) manager.Release(h);
+    gpu.signaled.insert(1);
+    manager.Retire(GpuContextQueue::Game);
+
+    REQUIRE(gpu.deleteCalls.size() == 4);
+    CHECK(gpu.deleteCalls[0].kind == GpuResourceKind::Texture);
+    CHECK(gpu.deleteCalls[0].names == Names({ 2, 4 }));
+    CHECK(gpu.deleteCalls[1].kind == GpuResourceKind::Buffer);
+    CHECK(gpu.deleteCalls[1].names == Names({ 3 }));
+    CHECK(gpu.deleteCalls[2].kind == GpuResourceKind::Framebuffer);
+    CHECK(gpu.deleteCalls[2].names == Names({ 1, 6 }));
+    CHECK(gpu.deleteCalls[3].kind == GpuResourceKind::Renderbuffer);
+    CHECK(gpu.deleteCalls[3].names == Names({ 5 }));
+}
+
+TEST_CASE(FlushDeletesWithoutWaiting) {
+    FakeResourceBackend gpu;
+    GpuResourceManager manager(gpu);
+    GpuResourceHandle fenced1 = RegisterTexture(manager, 11);
+    GpuResourceHandle fenced2 = RegisterTexture(manager, 12);
+    GpuResourceHandle unfenced = RegisterTexture(manager, 13);
+    GpuResourceHandle other = RegisterTexture(manager, 14);
+    manager.Release(fenced1, GpuContextQueue::RenderThread);
+    manager.Retire(GpuContextQueue::RenderThread);
+    manager.Release(fenced2, GpuContextQueue::RenderThread);
+    manager.Retire(GpuContextQueue::RenderThread);
+    manager.Release(unfenced, GpuContextQueue::RenderThread);
+    manager.Release(other, GpuContextQueue::Game);
+    CHECK_EQ(manager.Stats().pendingDeletes, 4u);
+
+    // No fence has signaled; the context is going away, so everything it owns goes now
+    manager.Flush(GpuContextQueue::RenderThread);
+    CHECK(gpu.DeletedNames() == Names({ 11, 12, 13 }));
+    CHECK(gpu.deletedFences == std::vector<uint64_t>({ 1, 2 }));
+    CHECK(gpu.live.empty());
+    CHECK(!manager.HasPending(GpuContextQueue::RenderThread));
+    CHECK_EQ(manager.Stats().pendingDeletes, 1u);
+
+    // Later frames on that queue see nothing left over; the game queue is untouched
+    manager.Retire(GpuContextQueue::RenderThread);
+    CHECK_EQ(gpu.LastFence(), 2u);
+    CHECK(gpu.DeletedNames() == Names({ 11, 12, 13 }));
+    CHECK(manager.HasPending(GpuContextQueue::Game));
+    manager.Flush(GpuContextQueue::Game);
+    CHECK(gpu.DeletedNames() == Names({ 11, 12, 13, 14 }));
+    CHECK_EQ(manager.Stats().pendingDeletes, 0u);
+}
+
+TEST_CASE(ReleaseNowDeletesImmediately) {
+    FakeResourceBackend gpu;
+    GpuResourceManager manager(gpu);
+    GpuResourceHandle a = manager.Register(GpuResourceKind::Buffer, 11, GpuSubsystem::Backgrounds, 256);
+    manager.ReleaseNow(a);
+    CHECK(!a.IsValid());
+    REQUIRE(gpu.deleteCalls.size() == 1);
+    CHECK(gpu.deleteCalls[0].kind == GpuResourceKind::Buffer);
+    CHECK(gpu.deleteCalls[0].names == Names({ 11 }));
+    CHECK_EQ(gpu.LastFence(), 0u);
+    CHECK_EQ(manager.Stats().pendingDeletes, 0u);
+    CHECK_EQ(manager.Stats().totalBytes, 0u);
+}
+
+TEST_CASE(BytesAndObjectsPerSubsystem) {
+    FakeResourceBackend gpu;
+    GpuResourceManager manager(gpu);
+    GpuResourceHandle mirror = manager.Register(GpuResourceKind::Texture, 1, GpuSubsystem::Mirrors, 1000);
+    GpuResourceHandle mirrorFbo = manager.Register(GpuResourceKind::Framebuffer, 2, GpuSubsystem::Mirrors, 0);
+    GpuResourceHandle image = manager.Register(GpuResourceKind::Texture, 3, GpuSubsystem::Images, 500);
+    GpuResourceHandle cursor = manager.Register(GpuResourceKind::Texture, 4, GpuSubsystem::Cursors, 64);
+
+    GpuMemoryStats stats = manager.Stats();
+    CHECK_EQ(SubsystemBytes(stats, GpuSubsystem::Mirrors), 1000u);
+    CHECK_EQ(SubsystemObjects(stats, GpuSubsystem::Mirrors), 2u);
+    CHECK_EQ(SubsystemBytes(stats, GpuSubsystem::Images), 500u);
+    CHECK_EQ(SubsystemObjects(stats, GpuSubsystem::Images), 1u);
+    CHECK_EQ(SubsystemObjects(stats, GpuSubsystem::Backgrounds), 0u);
+    CHECK_EQ(stats.totalBytes, 1564u);
+
+    // Reallocation replaces the object's size, in both directions
+    manager.SetBytes(mirror, 4000);
+    CHECK_EQ(SubsystemBytes(manager.Stats(), GpuSubsystem::Mirrors), 4000u);
+    manager.SetBytes(mirror, 250);
+    manager.SetBytes(mirrorFbo, 10);
+    stats = manager.Stats();
+    CHECK_EQ(SubsystemBytes(stats, GpuSubsystem::Mirrors), 260u);
+    CHECK_EQ(SubsystemObjects(stats, GpuSubsystem::Mirrors), 2u);
+    CHECK_EQ(stats.totalBytes, 824u);
+
+    // Released objects leave the totals at once (EndSlot), while the delete is still pending
+    manager.Release(mirror);
+    stats = manager.Stats();
+    CHECK_EQ(SubsystemBytes(stats, GpuSubsystem::Mirrors), 10u);
+    CHECK_EQ(SubsystemObjects(stats, GpuSubsystem::Mirrors), 1u);
+    CHECK_EQ(stats.pendingDeletes, 1u);
+    manager.ReleaseNow(cursor);
+    manager.Release(image, GpuContextQueue::RenderThread);
+    manager.Release(mirrorFbo);
+    stats = manager.Stats();
+    CHECK_EQ(stats.totalBytes, 0u);
+    for (int i = 0; i < static_cast<int>(GpuSubsystem::Count); i++) CHECK_EQ(stats.objects[i], 0u);
+    CHECK_EQ(stats.pendingDeletes, 3u);
+
+    // A reused slot starts from its new size, not the old one
+    const GpuResourceHandle background = manager.Register(GpuResourceKind::Texture, 5, GpuSubsystem::Backgrounds, 70);
+    CHECK(background.index < 4);
+    CHECK_EQ(SubsystemBytes(manager.Stats(), GpuSubsystem::Backgrounds), 70u);
+    CHECK_EQ(manager.Stats().totalBytes, 70u);
+}
+
+TEST_CASE(TextureBytes) {
+    CHECK_EQ(GpuTextureBytes(256, 128), 131072u);
+    CHECK_EQ(GpuTextureBytes(256, 128, 1), 32768u);
+    CHECK_EQ(GpuTextureBytes(256, 256, 4, true), 262144u + 87381u);
+    CHECK_EQ(GpuTextureBytes(0, 128), 0u);
+    CHECK_EQ(GpuTextureBytes(256, -1), 0u);
+    CHECK_EQ(GpuTextureBytes(65536, 65536), 17179869184ull);
+}
+
+TEST_CASE(GLBackendDeletesAfterTheFence) {
+    RequireGLContext();
+    GpuResourceManager& manager = GpuResourceManager::Get();
+    GLuint tex = CreateTestTexture(8, 8);
+    GLuint buffer = 0;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, 64, nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GpuResourceHandle texHandle = manager.Register(GpuResourceKind::Texture, tex, GpuSubsystem::Images, GpuTextureBytes(8, 8));
+    GpuResourceHandle bufferHandle = manager.Register(GpuResourceKind::Buffer, buffer, GpuSubsystem::Images, 64);
+    CHECK_EQ(manager.Resolve(texHandle), tex);
+    CHECK_EQ(SubsystemBytes(manager.Stats(), GpuSubsystem::Images), 320u);
+
+    manager.Release(texHandle);
+    manager.Release(bufferHandle);
+    CHECK(glIsTexture(tex));
+    for (int frame = 0; frame < 1000 && manager.HasPending(GpuContextQueue::Game); frame++) {
+        manager.Retire(GpuContextQueue::Game);
+        if (manager.HasPending(GpuContextQueue::Game)) glFinish();
+    }
+    CHECK(!manager.HasPending(GpuContextQueue::Game));
+    CHECK(!glIsTexture(tex));
+    CHECK(!glIsBuffer(buffer));
+    CHECK_EQ(glGetError(), static_cast<GLenum>(GL_NO_ERROR));
+}
@@ -0,0 +1,297 @@
+// ============================================================================
+// GPU_TIMER_TEST.CPP - GpuTimerRing bookkeeping on a fake query backend
+// ============================================================================
+// The fake backend hands out query names, records the "GPU time" each timestamp was issued at and reports a
+// result as available only once the test says the GPU got that far, so slot reuse, collection order, nesting
+// and dropped scopes can be checked exactly. The last case runs the real GL_TIMESTAMP backend on the
+// headless context.
+// ============================================================================
+
+#include "gl_test_context.h"
+#include "gpu_timer.h"
+#include "test_common.h"
+
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+class FakeQueryBackend final : public GpuQueryBackend {
+  public:
+    struct Query {
+        uint64_t ns = 0;
+        uint64_t sequence = 0; // Issue order, 1-based
+        int issues = 0;
+    };
+
+    void CreateQueries(uint32_t* names, int count) override {
+        createCalls++;
+        for (int i = 0; i < count; i++) {
+            names[i] = m_nextName++;
+            queries[names[i]];
+        }
+    }
+    void IssueTimestamp(uint32_t query) override {
+        Query& q = queries.at(query);
+        q.ns = gpuNs;
+        q.sequence = ++m_issued;
+        q.issues++;
+    }
+    bool IsResultAvailable(uint32_t query) override {
+        availabilityChecks++;
+        const Query& q = queries.at(query);
+        return q.sequence != 0 && q.sequence <= completed;
+    }
+    uint64_t ResultNs(uint32_t query) override {
+        const Query& q = queries.at(query);
+        CHECK(q.sequence != 0 && q.sequence <= completed);
+        return q.ns;
+    }
+
+    // The GPU finishes everything issued so far
+    void CompleteAll() { completed = m_issued; }
+    uint64_t Issued() const { return m_issued; }
+
+    std::map<uint32_t, Query> queries;
+    uint64_t gpuNs = 0;      // Timestamp the next issued query records
+    uint64_t completed = 0;  // Queries up to this issue sequence have results
+    int createCalls = 0;
+    int availabilityChecks = 0;
+
+  private:
+    uint32_t m_nextName = 100;
+    uint64_t m_issued = 0;
+};
+
+// Begins a scope at `beginNs` and ends it at `endNs` of fake GPU time
+int TimedScope(GpuTimerRing& ring, FakeQueryBackend& gpu, const char* name, uint64_t beginNs, uint64_t endNs) {
+    gpu.gpuNs = beginNs;
+    const int slot = ring.BeginScope(name);
+    gpu.gpuNs = endNs;
+    ring.EndScope(slot);
+    return slot;
+}
+
+} // namespace
+
+TEST_CASE(CreatesTwoDistinctQueriesPerSlot) {
+    FakeQueryBackend gpu;
+    GpuTimerRing ring(gpu, 4);
+    CHECK_EQ(gpu.createCalls, 1);
+    CHECK_EQ(gpu.queries.size(), 8u);
+
+    // Every slot issues its own pair
+    for (int i = 0; i < 4; i++) TimedScope(ring, gpu, "s", i * 10, i * 10 + 5);
+    for (const auto& q : gpu.queries) CHECK_EQ(q.second.issues, 1);
+
+    FakeQueryBackend gpu1;
+    GpuTimerRing minimal(gpu1, 0);
+    CHECK_EQ(gpu1.queries.size(), 2u);
+}
+
+TEST_CASE(CollectsDurationsOldestFirst) {
+    FakeQueryBackend gpu;
+    GpuTimerRing ring(gpu, 8);
+    TimedScope(ring, gpu, "a", 1000000, 3500000);
+    TimedScope(ring, gpu, "b", 4000000, 4250000);
+    CHECK_EQ(ring.InFlight(), 2);
+
+    std::vector<GpuScopeTiming> out;
+    CHECK_EQ(ring.Collect(out), 0); // Nothing completed yet
+    CHECK(out.empty());
+
+    gpu.CompleteAll();
+    CHECK_EQ(ring.Collect(out), 2);
+    REQUIRE(out.size() == 2);
+    CHECK(std::strcmp(out[0].name, "a") == 0);
+    CHECK_NEAR(out[0].durationMs, 2.5, 1e-9);
+    CHECK(std::strcmp(out[1].name, "b") == 0);
+    CHECK_NEAR(out[1].durationMs, 0.25, 1e-9);
+    CHECK(out[0].parentName == nullptr && out[0].depth == 0);
+    CHECK_EQ(ring.InFlight(), 0);
+
+    // Appends to what is already in `out`; nothing left to collect
+    CHECK_EQ(ring.Collect(out), 0);
+    CHECK_EQ(out.size(), 2u);
+}
+
+TEST_CASE(StopsAtFirstScopeTheGpuHasNotReached) {
+    FakeQueryBackend gpu;
+    GpuTimerRing ring(gpu, 8);
+    TimedScope(ring, gpu, "first", 0, 10);
+    TimedScope(ring, gpu, "second", 20, 30);
+    TimedScope(ring, gpu, "third", 40, 50);
+
+    // Only first's end and second's begin completed: first is collectable, second is not
+    gpu.completed = 3;
+    std::vector<GpuScopeTiming> out;
+    CHECK_EQ(ring.Collect(out), 1);
+    CHECK_EQ(ring.InFlight(), 2);
+
+    // Availability is only polled up to the blocked scope, not past it
+    const int checksBefore = gpu.availabilityChecks;
+    CHECK_EQ(ring.Collect(out), 0);
+    CHECK(gpu.availabilityChecks - checksBefore <= 2);
+
+    gpu.CompleteAll();
+    CHECK_EQ(ring.Collect(out), 2);
+    REQUIRE(out.size() == 3);
+    CHECK(std::strcmp(out[1].name, "second") == 0 && std::strcmp(out[2].name, "third") == 0);
+}
+
+TEST_CASE(OpenEnclosingScopeHoldsBackCollection) {
+    FakeQueryBackend gpu;
+    GpuTimerRing ring(gpu, 8);
+    gpu.gpuNs = 0;
+    const int outer = ring.BeginScope("outer");
+    TimedScope(ring, gpu, "inner", 100, 200);
+    CHECK_EQ(ring.OpenScopes(), 1);
+
+    // The inner scope is done on the GPU, but it sits behind the still-open outer one
+    gpu.CompleteAll();
+    std::vector<GpuScopeTiming> out;
+    CHECK_EQ(ring.Collect(out), 0);
+
+    gpu.gpuNs = 1000;
+    ring.EndScope(outer);
+    CHECK_EQ(ring.OpenScopes(), 0);
+    gpu.CompleteAll();
+    CHECK_EQ(ring.Collect(out), 2);
+    REQUIRE(out.size() == 2);
+    CHECK(std::strcmp(out[0].name, "outer") == 0);
+    CHECK_NEAR(out[0].durationMs, 0.001, 1e-12);
+    CHECK(std::strcmp(out[1].name, "inner") == 0);
+    CHECK(out[1].parentName != nullptr && std::strcmp(out[1].parentName, "outer") == 0);
+    CHECK_EQ(static_cast<int>(out[1].depth), 1);
+}
+
+TEST_CASE(NestingTracksParentAndDepth) {
+    FakeQueryBackend gpu;
+    GpuTimerRing ring(gpu, 8);
+    const int a = ring.BeginScope("a");
+    const int b = ring.BeginScope("b");
+    const int c = ring.BeginScope("c");
+    ring.EndScope(c);
+    ring.EndScope(b);
+    const int d = ring.BeginScope("d"); // Sibling of b
+    ring.EndScope(d);
+    ring.EndScope(a);
+
+    gpu.CompleteAll();
+    std::vector<GpuScopeTiming> out;
+    REQUIRE(ring.Collect(out) == 4);
+    CHECK(out[0].parentName == nullptr && out[0].depth == 0);
+    CHECK(std::strcmp(out[1].parentName, "a") == 0 && out[1].depth == 1);
+    CHECK(std::strcmp(out[2].parentName, "b") == 0 && out[2].depth == 2);
+    CHECK(std::strcmp(out[3].name, "d") == 0 && std::strcmp(out[3].parentName, "a") == 0 && out[3].depth == 1);
+}
+
+TEST_CASE(ScopesEndedOutOfOrderAreTolerated) {
+    FakeQueryBackend gpu;
+    GpuTimerRing ring(gpu, 8);
+    const int a = ring.BeginScope("a");
+    const int b = ring.BeginScope("b");
+    ring.EndScope(a); // Outer first
+    CHECK_EQ(ring.OpenScopes(), 1);
+    // A new scope nests under the one still open
+    const int c = ring.BeginScope("c");
+    ring.EndScope(c);
+    ring.EndScope(b);
+    CHECK_EQ(ring.OpenScopes(), 0);
+
+    gpu.CompleteAll();
+    std::vector<GpuScopeTiming> out;
+    REQUIRE(ring.Collect(out) == 3);
+    CHECK(std::strcmp(out[2].name, "c") == 0 && std::strcmp(out[2].parentName, "b") == 0);
+}
+
+TEST_CASE(FullRingDropsScopesInsteadOfWaiting) {
+    FakeQueryBackend gpu;
+    GpuTimerRing ring(gpu, 3);
+    for (int i = 0; i < 3; i++) CHECK(TimedScope(ring, gpu, "s", 0, 1) >= 0);
+    CHECK_EQ(ring.InFlight(), 3);
+
+    const uint64_t issued = gpu.Issued();
+    const int dropped = ring.BeginScope("dropped");
+    CHECK_EQ(dropped, -1);
+    ring.EndScope(dropped); // Ignored
+    CHECK_EQ(gpu.Issued(), issued);
+    CHECK_EQ(ring.DroppedScopes(), 1u);
+    CHECK_EQ(ring.OpenScopes(), 0);
+
+    // Freed slots take scopes again
+    gpu.CompleteAll();
+    std::vector<GpuScopeTiming> out;
+    CHECK_EQ(ring.Collect(out), 3);
+    CHECK(TimedScope(ring, gpu, "again", 0, 1) >= 0);
+    CHECK_EQ(ring.DroppedScopes(), 1u);
+}
+
+TEST_CASE(SlotsWrapAroundTheRing) {
+    FakeQueryBackend gpu;
+    GpuTimerRing ring(gpu, 4);
+    std::vector<GpuScopeTiming> out;
+    std::vector<int> slots;
+    // Collect partially each round so the head walks around the ring several times
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 3; i++) slots.push_back(TimedScope(ring, gpu, "s", round * 100 + i * 10, round * 100 + i * 10 + 1 + i));
+        gpu.completed = gpu.Issued() - 2; // Last scope not done
+        ring.Collect(out);
+        CHECK_EQ(ring.InFlight(), 1);
+    }
+    gpu.CompleteAll();
+    ring.Collect(out);
+    CHECK_EQ(ring.InFlight(), 0);
+    CHECK_EQ(ring.DroppedScopes(), 0u);
+    REQUIRE(out.size() == 30);
+
+    // Slots are handed out in ring order and each round's durations come back in issue order
+    for (size_t i = 0; i < slots.size(); i++) CHECK_EQ(slots[i], static_cast<int>(i % 4));
+    for (size_t i = 0; i < out.size(); i++) CHECK_NEAR(out[i].durationMs, (1 + i % 3) * 1e-6, 1e-12);
+    for (const auto& q : gpu.queries) CHECK(q.second.issues >= 7);
+}
+
+TEST_CASE(TimestampsGoingBackwardsGiveZeroDuration) {
+    FakeQueryBackend gpu;
+    GpuTimerRing ring(gpu, 2);
+    TimedScope(ring, gpu, "skewed", 5000, 4000);
+    gpu.CompleteAll();
+    std::vector<GpuScopeTiming> out;
+    REQUIRE(ring.Collect(out) == 1);
+    CHECK_EQ(out[0].durationMs, 0.0);
+}
+
+TEST_CASE(TimestampQueriesResolveOnRealContext) {
+    RequireGLContext();
+    GpuTimerRing* ring = GpuTimerRing::ForCurrentContext();
+    REQUIRE(ring != nullptr);
+    CHECK(GpuTimerRing::ForCurrentContext() == ring);
+
+    const GLuint texture = CreateTestTexture(256, 256);
+    const GLuint fbo = CreateTestFramebuffer(texture);
+    const int slot = ring->BeginScope("clear");
+    REQUIRE(slot >= 0);
+    glClearColor(0.2f, 0.4f, 0.6f, 1.0f);
+    for (int i = 0; i < 16; i++) glClear(GL_COLOR_BUFFER_BIT);
+    ring->EndScope(slot);
+
+    // Collect never blocks: poll until the driver reports both timestamps
+    std::vector<GpuScopeTiming> out;
+    for (int i = 0; i < 1000 && out.empty(); i++) {
+        glFlush();
+        ring->Collect(out);
+        if (out.empty()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(out.size() == 1);
+    CHECK(std::strcmp(out[0].name, "clear") == 0);
+    CHECK(out[0].durationMs >= 0.0 && out[0].durationMs < 1000.0);
+    CHECK_EQ(ring->InFlight(), 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &texture);
+}
@@ -0,0 +1,170 @@
+// ============================================================================
+// GRADIENT_RAMP_TEST.CPP - Ramp-shaded gradients against the per-stop search
+// ============================================================================
+// Each case records one full-screen gradient command and runs it through SoftwareRenderBackend twice,
+// shading from the baked ramp and with SetGradientStopSearch(true), then compares the 8-bit images. Smooth
+// stop sets (2 to 32 stops, beyond the old limit of 8) must match within one channel step for every
+// animation type at several times; hard edges (coincident stops, the wrap seam) may differ only along
+// the edge, where the ramp spreads the step over one texel.
+// ============================================================================
+
+#include "gradient_ramp.h"
+#include "render_commands.h"
+#include "render_commands_sw.h"
+#include "test_common.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int WIDTH = 320;
+constexpr int HEIGHT = 180;
+
+const char* const ANIMATION_NAMES[] = { "None", "Rotate", "Slide", "Wave", "Spiral", "Fade" };
+
+// `count` stops with random colors, positions spread over [first, last] with jittered spacing
+std::vector<RenderGradientStop> RandomStops(std::mt19937& rng, int count, float first, float last) {
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<RenderGradientStop> stops(count);
+    for (int i = 0; i < count; i++) {
+        const float jitter = (count > 2 && i > 0 && i < count - 1) ? (unit(rng) - 0.5f) * 0.5f : 0.0f;
+        stops[i] = { unit(rng), unit(rng), unit(rng), 1.0f, first + (last - first) * (i + jitter) / (count - 1) };
+    }
+    return stops;
+}
+
+struct Comparison {
+    int maxDiff = 0;      // Largest channel difference
+    int differing = 0;    // Pixels more than one step apart
+};
+
+Comparison Compare(const std::vector<RenderGradientStop>& stops, float angle, float time, int animationType, bool colorFade) {
+    RenderCommandList list;
+    list.Gradient({ -1.0f, -1.0f, 1.0f, 1.0f }, stops.data(), static_cast<int>(stops.size()), angle, time, animationType, 1.0f, colorFade,
+                  RenderBlendMode::Opaque);
+    SoftwareRenderBackend backend;
+    SoftwareImage ramp, search;
+    ramp.Resize(WIDTH, HEIGHT);
+    search.Resize(WIDTH, HEIGHT);
+    backend.Execute(list, ramp);
+    backend.SetGradientStopSearch(true);
+    backend.Execute(list, search);
+
+    Comparison result;
+    for (size_t i = 0; i < ramp.pixels.size(); i++) {
+        result.maxDiff = (std::max)(result.maxDiff, std::abs(static_cast<int>(ramp.pixels[i]) - static_cast<int>(search.pixels[i])));
+    }
+    result.differing = CountDifferingPixels(ramp, search, 1);
+    return result;
+}
+
+} // namespace
+
+TEST_CASE(SmoothGradientsMatchForEveryAnimation) {
+    std::mt19937 rng(74);
+    int worst = 0;
+    for (int count : { 2, 3, 5, 8, 9, 12, 20, 32 }) {
+        for (int set = 0; set < 3; set++) {
+            // Inset stop sets leave room for the clamped ends and a wrap segment
+            const bool inset = set == 2;
+            const std::vector<RenderGradientStop> stops = RandomStops(rng, count, inset ? 0.1f : 0.0f, inset ? 0.85f : 1.0f);
+            for (int animation = 0; animation < 6; animation++) {
+                for (float time : { 0.0f, 1.3f, 7.9f }) {
+                    for (bool colorFade : { false, true }) {
+                        // Wrapped layers with stops on both ends put a hard seam at the wrap; covered below
+                        const bool wrapped = animation == 2 || animation == 4 || colorFade;
+                        if (wrapped && !inset) continue;
+                        SetTestContext(std::to_string(count) + " stops, set " + std::to_string(set) + ", " + ANIMATION_NAMES[animation] +
+                                       ", t=" + std::to_string(time) + (colorFade ? ", color fade" : ""));
+                        const Comparison c = Compare(stops, 0.7f, time, animation, colorFade);
+                        CHECK_EQ(c.differing, 0);
+                        worst = (std::max)(worst, c.maxDiff);
+                    }
+                }
+            }
+        }
+    }
+    SetTestContext("");
+    std::printf("     smooth stop sets: max channel difference %d\n", worst);
+}
+
+TEST_CASE(MoreThanEightStopsAreAllUsed) {
+    // 16 alternating stops: a ramp or search truncated to 8 stops would flatten the second half
+    std::vector<RenderGradientStop> stops;
+    for (int i = 0; i < 16; i++) {
+        const float v = (i % 2) ? 1.0f : 0.0f;
+        stops.push_back({ v, 0.5f, 1.0f - v, 1.0f, i / 15.0f });
+    }
+    for (int animation : { 0, 3 }) {
+        SetTestContext(ANIMATION_NAMES[animation]);
+        CHECK_EQ(Compare(stops, 0.0f, 0.0f, animation, false).differing, 0);
+    }
+    SetTestContext("");
+
+    RenderCommandList list;
+    list.Gradient({ -1.0f, -1.0f, 1.0f, 1.0f }, stops.data(), 16, 0.0f, 0.0f, 0, 1.0f, false, RenderBlendMode::Opaque);
+    SoftwareRenderBackend backend;
+    SoftwareImage image;
+    image.Resize(WIDTH, 1);
+    backend.Execute(list, image);
+    // The last stop (red 255 at the right edge) and the one before it (red 0) both show
+    CHECK(image.At(WIDTH - 1, 0)[0] > 240);
+    CHECK(image.At(WIDTH * 14 / 15, 0)[0] < 16);
+
+    // Recording keeps up to MAX_GRADIENT_STOPS
+    std::vector<RenderGradientStop> many(RenderCommandList::MAX_GRADIENT_STOPS + 8, RenderGradientStop{ 1.0f, 1.0f, 1.0f, 1.0f, 0.5f });
+    RenderCommandList capped;
+    capped.Gradient({ -1.0f, -1.0f, 1.0f, 1.0f }, many.data(), static_cast<int>(many.size()), 0.0f, 0.0f, 0, 1.0f, false, RenderBlendMode::Opaque);
+    CHECK_EQ(capped.Commands().front().gradient.stopCount, static_cast<uint32_t>(RenderCommandList::MAX_GRADIENT_STOPS));
+}
+
+TEST_CASE(HardEdgesDifferOnlyAlongTheEdge) {
+    // Two coincident stops: a step from blue to yellow, on a diagonal so the edge crosses pixel centers
+    const std::vector<RenderGradientStop> step = { { 0.0f, 0.0f, 1.0f, 1.0f, 0.0f },
+                                                   { 0.0f, 0.0f, 1.0f, 1.0f, 0.37f },
+                                                   { 1.0f, 1.0f, 0.0f, 1.0f, 0.37f },
+                                                   { 1.0f, 1.0f, 0.0f, 1.0f, 1.0f } };
+    // One line of pixels at most: two per row
+    const Comparison none = Compare(step, 0.3f, 0.0f, 0, false);
+    CHECK(none.differing <= 2 * HEIGHT);
+
+    // Stops on both ends of [0, 1] put a seam in the wrapped layer; slide and spiral move it, still one line
+    const std::vector<RenderGradientStop> seam = { { 1.0f, 0.0f, 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 1.0f, 1.0f } };
+    int seamPixels = 0;
+    for (float time : { 0.0f, 0.6f, 2.2f }) {
+        SetTestContext("t=" + std::to_string(time));
+        const Comparison slide = Compare(seam, 0.3f, time, 2, false);
+        CHECK(slide.differing <= 2 * HEIGHT);
+        seamPixels = (std::max)(seamPixels, slide.differing);
+        CHECK(Compare(seam, 0.3f, time, 4, false).differing <= 2 * (WIDTH + HEIGHT));
+    }
+    SetTestContext("");
+    std::printf("     hard step: %d px differ, slide seam: up to %d px differ (of %d)\n", none.differing, seamPixels, WIDTH * HEIGHT);
+}
+
+TEST_CASE(RampHashFollowsTheStops) {
+    std::vector<RenderGradientStop> stops = { { 0.1f, 0.2f, 0.3f, 1.0f, 0.0f }, { 0.9f, 0.8f, 0.7f, 1.0f, 1.0f } };
+    const GradientStopSpan span{ stops.data(), 2 };
+    const uint64_t hash = HashGradientStops(span);
+    CHECK_EQ(HashGradientStops(span), hash);
+    stops[1].position = 0.99f;
+    CHECK(HashGradientStops(span) != hash);
+    stops[1].position = 1.0f;
+    stops[0].a = 0.5f;
+    CHECK(HashGradientStops(span) != hash);
+    stops[0].a = 1.0f;
+    CHECK_EQ(HashGradientStops(span), hash);
+    CHECK(HashGradientStops(GradientStopSpan{ stops.data(), 1 }) != hash);
+
+    // Clamped layer runs edge to edge: first and last texel are the end stops
+    GradientRamp ramp;
+    BuildGradientRamp(span, ramp);
+    CHECK_EQ(ramp.texels.size(), static_cast<size_t>(GRADIENT_RAMP_LAYERS * GRADIENT_RAMP_TEXELS * 4));
+    CHECK_EQ(ramp.texels[0], 0.1f);
+    CHECK_EQ(ramp.texels[(GRADIENT_RAMP_TEXELS - 1) * 4], 0.9f);
+}
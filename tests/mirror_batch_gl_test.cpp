@@ -0,0 +1,475 @@
+// ============================================================================
+// MIRROR_BATCH_GL_TEST.CPP - Batched capture atlas vs per-mirror pass 1 on llvmpipe
+// ============================================================================
+// The batched capture pass (MT_RenderBatchedCapturePass) claims to produce, per mirror, exactly the pass 1
+// texture RenderMirrorToBackBuffer would. Both paths are rebuilt here from the shipped shaders
+// (mirror_shaders.h) with the same draw setup as mirror_thread.cpp: the per-mirror path draws each input
+// region through the passthrough or match-table shaders into the mirror's own texture; the batched path
+// shelf-packs all mirrors into one atlas, draws one instance per input region (optionally sampling the
+// shared region cache from BuildCaptureRegionPlan) and blits each slot out. The results must match
+// byte for byte.
+// ============================================================================
+
+#include "capture_regions.h"
+#include "gl_test_context.h"
+#include "mirror_match_lut.h"
+#include "mirror_shaders.h"
+#include "test_common.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int GAME_W = 640;
+constexpr int GAME_H = 360;
+constexpr int ATLAS_MIN_WIDTH = 1024; // MT_BATCH_ATLAS_MIN_WIDTH
+constexpr int LUT_LAYERS = 8;         // MT_MATCH_LUT_MAX_LAYERS
+
+enum class Mode { Raw = 0, Filter = 1, Passthrough = 2 };
+
+struct TestMirror {
+    std::string name;
+    Mode mode = Mode::Filter;
+    int captureW = 0, captureH = 0;
+    int padding = 0;                      // Dynamic border thickness
+    std::vector<CaptureRect> inputs;      // x, y in GL coordinates of the game frame; w/h ignored
+    std::vector<Color> targets;
+    float sensitivity = 0.05f;
+    Color outputColor{ 1.0f, 1.0f, 1.0f, 1.0f };
+    int lutLayer = 0;
+
+    int FboW() const { return captureW + 2 * padding; }
+    int FboH() const { return captureH + 2 * padding; }
+};
+
+const Color kRed{ 200 / 255.0f, 30 / 255.0f, 40 / 255.0f, 1 };
+const Color kGreen{ 40 / 255.0f, 180 / 255.0f, 60 / 255.0f, 1 };
+const Color kBlue{ 20 / 255.0f, 60 / 255.0f, 220 / 255.0f, 1 };
+
+// Noise with flat and slightly jittered patches of the target colors, alpha 1 like the alpha-fixed game copy
+std::vector<uint8_t> MakeGameFrame() {
+    std::vector<uint8_t> frame(static_cast<size_t>(GAME_W) * GAME_H * 4);
+    std::mt19937 rng(54);
+    std::uniform_int_distribution<int> byte(0, 255), jitter(-6, 6);
+    for (size_t i = 0; i < frame.size(); i += 4) {
+        frame[i] = static_cast<uint8_t>(byte(rng));
+        frame[i + 1] = static_cast<uint8_t>(byte(rng));
+        frame[i + 2] = static_cast<uint8_t>(byte(rng));
+        frame[i + 3] = 255;
+    }
+    const Color colors[] = { kRed, kGreen, kBlue };
+    for (int p = 0; p < 24; p++) {
+        const Color& c = colors[p % 3];
+        const int x0 = (p * 97) % (GAME_W - 40), y0 = (p * 53) % (GAME_H - 30);
+        for (int y = y0; y < y0 + 30; y++) {
+            for (int x = x0; x < x0 + 40; x++) {
+                uint8_t* px = &frame[(static_cast<size_t>(y) * GAME_W + x) * 4];
+                const int j = (x + y) % 3 == 0 ? jitter(rng) : 0;
+                px[0] = static_cast<uint8_t>(std::clamp(static_cast<int>(c.r * 255.0f + 0.5f) + j, 0, 255));
+                px[1] = static_cast<uint8_t>(std::clamp(static_cast<int>(c.g * 255.0f + 0.5f) - j, 0, 255));
+                px[2] = static_cast<uint8_t>(std::clamp(static_cast<int>(c.b * 255.0f + 0.5f) + j, 0, 255));
+            }
+        }
+    }
+    return frame;
+}
+
+// Shared GL objects of one test run
+struct Harness {
+    GLuint gameTexture = 0;
+    GLuint matchLutArray = 0;
+    GLuint passthroughProgram = 0, filterLutProgram = 0, passthroughLutProgram = 0, batchProgram = 0;
+    GLuint captureVAO = 0, captureVBO = 0;
+    GLuint batchVAO = 0, batchCornerVBO = 0, batchInstanceVBO = 0;
+
+    void Init(const std::vector<uint8_t>& frame) {
+        gameTexture = CreateTestTexture(GAME_W, GAME_H, frame.data());
+        passthroughProgram = BuildTestProgram(mt_passthrough_vert_shader, mt_passthrough_frag_shader);
+        filterLutProgram = BuildTestProgram(mt_passthrough_vert_shader, mt_filter_lut_frag_shader);
+        passthroughLutProgram = BuildTestProgram(mt_passthrough_vert_shader, mt_filter_passthrough_lut_frag_shader);
+        batchProgram = BuildTestProgram(mt_batch_vert_shader, mt_batch_frag_shader);
+
+        // Sampler units as MT_InitializeShaders assigns them
+        for (GLuint p : { passthroughProgram, filterLutProgram, passthroughLutProgram, batchProgram }) {
+            glUseProgram(p);
+            glUniform1i(glGetUniformLocation(p, "screenTexture"), 0);
+            glUniform1i(glGetUniformLocation(p, "u_matchLut"), 1);
+            glUniform1i(glGetUniformLocation(p, "u_regionCache"), 2);
+        }
+        glUseProgram(0);
+
+        glGenTextures(1, &matchLutArray);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, matchLutArray);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R32UI, MIRROR_MATCH_LUT_TEXTURE_WIDTH, MIRROR_MATCH_LUT_TEXTURE_HEIGHT, LUT_LAYERS, 0,
+                     GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+        // Fullscreen quad of the capture thread (position, texcoord)
+        static const float verts[] = { -1, -1, 0, 0, 1, -1, 1, 0, 1, 1, 1, 1, -1, -1, 0, 0, 1, 1, 1, 1, -1, 1, 0, 1 };
+        glGenVertexArrays(1, &captureVAO);
+        glGenBuffers(1, &captureVBO);
+        glBindVertexArray(captureVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, captureVBO);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+        glEnableVertexAttribArray(1);
+
+        // Instanced layout of MT_EnsureBatchResources
+        static const float corners[] = { 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1 };
+        glGenVertexArrays(1, &batchVAO);
+        glGenBuffers(1, &batchCornerVBO);
+        glGenBuffers(1, &batchInstanceVBO);
+        glBindVertexArray(batchVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, batchCornerVBO);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+        const GLsizei stride = MT_BATCH_INSTANCE_FLOATS * sizeof(float);
+        glBindBuffer(GL_ARRAY_BUFFER, batchInstanceVBO);
+        for (int i = 0; i < 4; i++) {
+            GLuint loc = 2 + i;
+            glVertexAttribPointer(loc, i == 3 ? 3 : 4, GL_FLOAT, GL_FALSE, stride, (void*)(i * 4 * sizeof(float)));
+            glEnableVertexAttribArray(loc);
+            glVertexAttribDivisor(loc, 1);
+        }
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void UploadLut(int layer, const MirrorMatchLut& lut) {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, matchLutArray);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, MIRROR_MATCH_LUT_TEXTURE_WIDTH, MIRROR_MATCH_LUT_TEXTURE_HEIGHT, 1,
+                        GL_RED_INTEGER, GL_UNSIGNED_INT, lut.words.data());
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    }
+};
+
+// One LUT layer per distinct (targets, sensitivity), like MT_GetMatchLutLayer
+void AssignLutLayers(Harness& h, std::vector<TestMirror>& mirrors) {
+    std::map<std::pair<std::vector<float>, float>, int> layers;
+    for (TestMirror& m : mirrors) {
+        if (m.mode == Mode::Raw) continue;
+        const MirrorMatchLutKey key = MakeMirrorMatchLutKey(m.targets, m.sensitivity, MirrorGammaMode::Auto);
+        auto it = layers.find({ key.targets, key.sensitivity });
+        if (it == layers.end()) {
+            REQUIRE(static_cast<int>(layers.size()) < LUT_LAYERS);
+            MirrorMatchLut lut;
+            BuildMirrorMatchLut(key, lut);
+            const int layer = static_cast<int>(layers.size());
+            h.UploadLut(layer, lut);
+            it = layers.emplace(std::make_pair(key.targets, key.sensitivity), layer).first;
+        }
+        m.lutLayer = it->second;
+    }
+}
+
+// RenderMirrorToBackBuffer, pass 1 only, for raw mirrors and mirrors with a match table
+std::vector<uint8_t> RenderPerMirror(Harness& h, const TestMirror& m) {
+    GLuint texture = CreateTestTexture(m.FboW(), m.FboH());
+    GLuint fbo = CreateTestFramebuffer(texture);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glViewport(0, 0, m.FboW(), m.FboH());
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, h.gameTexture);
+    GLuint program = h.passthroughProgram;
+    if (m.mode != Mode::Raw) {
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, h.matchLutArray);
+        glActiveTexture(GL_TEXTURE0);
+        program = m.mode == Mode::Passthrough ? h.passthroughLutProgram : h.filterLutProgram;
+    }
+    glUseProgram(program);
+    if (m.mode != Mode::Raw) glUniform1i(glGetUniformLocation(program, "u_matchLutLayer"), m.lutLayer);
+    if (m.mode == Mode::Filter) {
+        glUniform4f(glGetUniformLocation(program, "outputColor"), m.outputColor.r, m.outputColor.g, m.outputColor.b, m.outputColor.a);
+    }
+    const GLint sourceRect = glGetUniformLocation(program, "u_sourceRect");
+
+    glBindVertexArray(h.captureVAO);
+    if (m.mode == Mode::Raw) {
+        glDisable(GL_BLEND);
+    } else {
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ONE);
+    }
+    glViewport(m.padding, m.padding, m.captureW, m.captureH);
+    for (const CaptureRect& in : m.inputs) {
+        glUniform4f(sourceRect, static_cast<float>(in.x) / GAME_W, static_cast<float>(in.y) / GAME_H, static_cast<float>(m.captureW) / GAME_W,
+                    static_cast<float>(m.captureH) / GAME_H);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+    }
+    glDisable(GL_BLEND);
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    glActiveTexture(GL_TEXTURE0);
+
+    std::vector<uint8_t> pixels = ReadTestFramebuffer(fbo, m.FboW(), m.FboH());
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &texture);
+    return pixels;
+}
+
+struct BatchResult {
+    std::vector<std::vector<uint8_t>> pixels; // Per mirror, same order as the input
+    bool usedRegionCache = false;
+};
+
+// MT_RenderBatchedCapturePass for mirrors that all fit the atlas, then the slot blits
+BatchResult RenderBatched(Harness& h, const std::vector<TestMirror>& mirrors, bool allowRegionCache) {
+    struct Slot {
+        size_t index;
+        int x = 0, y = 0;
+    };
+    std::vector<Slot> slots;
+    for (size_t i = 0; i < mirrors.size(); i++) slots.push_back({ i });
+    std::sort(slots.begin(), slots.end(), [&](const Slot& a, const Slot& b) { return mirrors[a.index].FboH() > mirrors[b.index].FboH(); });
+    int atlasW = ATLAS_MIN_WIDTH;
+    for (const Slot& sl : slots) atlasW = (std::max)(atlasW, mirrors[sl.index].FboW());
+    int cursorX = 0, cursorY = 0, shelfH = 0;
+    for (Slot& sl : slots) {
+        const int w = mirrors[sl.index].FboW(), hgt = mirrors[sl.index].FboH();
+        if (cursorX + w > atlasW) {
+            cursorY += shelfH;
+            cursorX = 0;
+            shelfH = 0;
+        }
+        sl.x = cursorX;
+        sl.y = cursorY;
+        cursorX += w;
+        shelfH = (std::max)(shelfH, hgt);
+    }
+    const int atlasH = cursorY + shelfH;
+
+    std::vector<CaptureRect> sourceRects;
+    std::vector<float> instances;
+    for (const Slot& sl : slots) {
+        const TestMirror& m = mirrors[sl.index];
+        const size_t first = m.mode == Mode::Raw ? m.inputs.size() - 1 : 0;
+        for (size_t r = first; r < m.inputs.size(); r++) {
+            const CaptureRect& in = m.inputs[r];
+            const bool inside = in.x >= 0 && in.y >= 0 && in.x + m.captureW <= GAME_W && in.y + m.captureH <= GAME_H;
+            sourceRects.push_back(inside ? CaptureRect{ in.x, in.y, m.captureW, m.captureH } : CaptureRect{});
+            const float inst[MT_BATCH_INSTANCE_FLOATS] = {
+                static_cast<float>(sl.x + m.padding),
+                static_cast<float>(sl.y + m.padding),
+                static_cast<float>(m.captureW),
+                static_cast<float>(m.captureH),
+                static_cast<float>(in.x) / GAME_W,
+                static_cast<float>(in.y) / GAME_H,
+                static_cast<float>(m.captureW) / GAME_W,
+                static_cast<float>(m.captureH) / GAME_H,
+                m.outputColor.r,
+                m.outputColor.g,
+                m.outputColor.b,
+                m.outputColor.a,
+                static_cast<float>(static_cast<int>(m.mode)),
+                static_cast<float>(m.lutLayer),
+                0.0f,
+                0.0f,
+            };
+            instances.insert(instances.end(), inst, inst + MT_BATCH_INSTANCE_FLOATS);
+        }
+    }
+
+    // Region cache, as MT_FillRegionCache
+    BatchResult result;
+    CaptureRegionPlan plan;
+    BuildCaptureRegionPlan(sourceRects, GAME_W, GAME_H, ATLAS_MIN_WIDTH, plan);
+    GLuint cacheTexture = 0, cacheFbo = 0, readFbo = 0;
+    if (allowRegionCache && plan.mergedArea < plan.inputArea) {
+        cacheTexture = CreateTestTexture(plan.cacheW, plan.cacheH);
+        cacheFbo = CreateTestFramebuffer(cacheTexture);
+        readFbo = CreateTestFramebuffer(h.gameTexture);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, readFbo);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, cacheFbo);
+        for (size_t i = 0; i < plan.regions.size(); i++) {
+            const CaptureRect& src = plan.regions[i];
+            const CaptureRect& dst = plan.packed[i];
+            glBlitFramebuffer(src.x, src.y, src.Right(), src.Top(), dst.x, dst.y, dst.Right(), dst.Top(), GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        }
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        for (size_t i = 0; i < sourceRects.size(); i++) {
+            const CaptureRegionRef& ref = plan.refs[i];
+            if (ref.region < 0) continue;
+            const CaptureRect& packed = plan.packed[ref.region];
+            float* inst = &instances[i * MT_BATCH_INSTANCE_FLOATS];
+            inst[4] = static_cast<float>(packed.x + ref.offsetX) / plan.cacheW;
+            inst[5] = static_cast<float>(packed.y + ref.offsetY) / plan.cacheH;
+            inst[6] = static_cast<float>(sourceRects[i].w) / plan.cacheW;
+            inst[7] = static_cast<float>(sourceRects[i].h) / plan.cacheH;
+            inst[14] = 1.0f;
+        }
+        result.usedRegionCache = true;
+    }
+
+    GLuint atlasTexture = CreateTestTexture(atlasW, atlasH);
+    GLuint atlasFbo = CreateTestFramebuffer(atlasTexture);
+    glBindFramebuffer(GL_FRAMEBUFFER, atlasFbo);
+    glViewport(0, 0, atlasW, atlasH);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, cacheTexture);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, h.matchLutArray);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, h.gameTexture);
+
+    glUseProgram(h.batchProgram);
+    glUniform2f(glGetUniformLocation(h.batchProgram, "u_atlasSize"), static_cast<float>(atlasW), static_cast<float>(atlasH));
+    glBindVertexArray(h.batchVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, h.batchInstanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(float), instances.data(), GL_STREAM_DRAW);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(instances.size() / MT_BATCH_INSTANCE_FLOATS));
+    glDisable(GL_BLEND);
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    glActiveTexture(GL_TEXTURE0);
+
+    result.pixels.resize(mirrors.size());
+    for (const Slot& sl : slots) {
+        const TestMirror& m = mirrors[sl.index];
+        GLuint texture = CreateTestTexture(m.FboW(), m.FboH());
+        GLuint fbo = CreateTestFramebuffer(texture);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, atlasFbo);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo);
+        glBlitFramebuffer(sl.x, sl.y, sl.x + m.FboW(), sl.y + m.FboH(), 0, 0, m.FboW(), m.FboH(), GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        result.pixels[sl.index] = ReadTestFramebuffer(fbo, m.FboW(), m.FboH());
+        glDeleteFramebuffers(1, &fbo);
+        glDeleteTextures(1, &texture);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &atlasFbo);
+    glDeleteTextures(1, &atlasTexture);
+    if (cacheFbo) glDeleteFramebuffers(1, &cacheFbo);
+    if (readFbo) glDeleteFramebuffers(1, &readFbo);
+    if (cacheTexture) glDeleteTextures(1, &cacheTexture);
+    return result;
+}
+
+enum class RegionCache { Off, Required };
+
+// Requires every mirror's batched pass 1 to equal its per-mirror pass 1, and the filters to match something
+void CompareBatchWithPerMirror(std::vector<TestMirror> mirrors, RegionCache regionCache) {
+    RequireGLContext();
+    Harness h;
+    h.Init(MakeGameFrame());
+    AssignLutLayers(h, mirrors);
+
+    const BatchResult batched = RenderBatched(h, mirrors, regionCache == RegionCache::Required);
+    CHECK_EQ(batched.usedRegionCache, regionCache == RegionCache::Required);
+    int filterCoverage = 0;
+    for (size_t i = 0; i < mirrors.size(); i++) {
+        const TestMirror& m = mirrors[i];
+        SetTestContext(m.name);
+        const std::vector<uint8_t> single = RenderPerMirror(h, m);
+        REQUIRE(batched.pixels[i].size() == single.size());
+        int differing = 0, covered = 0;
+        for (size_t p = 0; p < single.size(); p += 4) {
+            if (std::equal(&single[p], &single[p] + 4, &batched.pixels[i][p])) {
+                covered += single[p + 3] != 0;
+            } else {
+                if (differing == 0) {
+                    const int x = static_cast<int>(p / 4) % m.FboW(), y = static_cast<int>(p / 4) / m.FboW();
+                    fprintf(stderr, "  first difference at (%d, %d): per-mirror %d,%d,%d,%d batched %d,%d,%d,%d\n", x, y, single[p],
+                            single[p + 1], single[p + 2], single[p + 3], batched.pixels[i][p], batched.pixels[i][p + 1],
+                            batched.pixels[i][p + 2], batched.pixels[i][p + 3]);
+                }
+                differing++;
+            }
+        }
+        CHECK_EQ(differing, 0);
+        if (m.mode == Mode::Raw) {
+            CHECK_EQ(covered, m.captureW * m.captureH);
+        } else {
+            filterCoverage += covered;
+        }
+    }
+    SetTestContext("");
+    CHECK(filterCoverage > 0);
+    CHECK_EQ(static_cast<int>(glGetError()), GL_NO_ERROR);
+}
+
+TestMirror MakeMirror(const std::string& name, Mode mode, int w, int hgt, int padding, std::vector<CaptureRect> inputs,
+                      std::vector<Color> targets = { kRed }) {
+    TestMirror m;
+    m.name = name;
+    m.mode = mode;
+    m.captureW = w;
+    m.captureH = hgt;
+    m.padding = padding;
+    m.inputs = std::move(inputs);
+    m.targets = std::move(targets);
+    m.outputColor = Color{ 0.9f, 0.4f, 0.1f, 1.0f };
+    return m;
+}
+
+// A typical set: raw and filtered mirrors of the same areas, several inputs, padding, different sizes
+std::vector<TestMirror> TypicalMirrors() {
+    return {
+        MakeMirror("raw pie", Mode::Raw, 120, 90, 0, { { 500, 20 } }),
+        MakeMirror("filter pie", Mode::Filter, 120, 90, 3, { { 500, 20 } }, { kRed, kGreen }),
+        MakeMirror("passthrough pie", Mode::Passthrough, 120, 90, 0, { { 500, 20 } }, { kGreen, kBlue }),
+        MakeMirror("filter two inputs", Mode::Filter, 64, 48, 2, { { 100, 100 }, { 300, 200 } }, { kRed, kGreen, kBlue }),
+        MakeMirror("raw two inputs", Mode::Raw, 80, 40, 0, { { 10, 10 }, { 200, 150 } }),
+        MakeMirror("passthrough overlapping inputs", Mode::Passthrough, 100, 100, 4, { { 150, 120 }, { 170, 130 } }, { kRed, kBlue }),
+        MakeMirror("filter 1x1", Mode::Filter, 1, 1, 1, { { 110, 110 } }, { kRed }),
+        MakeMirror("raw tall", Mode::Raw, 16, 300, 0, { { 620, 30 } }),
+    };
+}
+
+} // namespace
+
+TEST_CASE(BatchMatchesPerMirrorSamplingTheGameTexture) { CompareBatchWithPerMirror(TypicalMirrors(), RegionCache::Off); }
+
+TEST_CASE(BatchMatchesPerMirrorSamplingTheRegionCache) { CompareBatchWithPerMirror(TypicalMirrors(), RegionCache::Required); }
+
+TEST_CASE(BatchMatchesPerMirrorAtFrameEdges) {
+    // Inputs partly outside the frame keep sampling the game texture with edge clamping; the others use the cache
+    std::vector<TestMirror> mirrors = {
+        MakeMirror("filter past left edge", Mode::Filter, 60, 60, 2, { { -20, 50 } }, { kRed, kGreen, kBlue }),
+        MakeMirror("raw past top-right corner", Mode::Raw, 50, 50, 0, { { 610, 330 } }),
+        MakeMirror("passthrough past bottom edge", Mode::Passthrough, 70, 40, 0, { { 300, -10 }, { 300, 0 } }, { kGreen }),
+        MakeMirror("filter inside", Mode::Filter, 60, 60, 0, { { 300, 0 } }, { kGreen }),
+        MakeMirror("raw inside", Mode::Raw, 60, 60, 0, { { 310, 10 } }),
+    };
+    CompareBatchWithPerMirror(mirrors, RegionCache::Required);
+}
+
+TEST_CASE(BatchMatchesPerMirrorAcrossAtlasShelves) {
+    // Enough mirrors to wrap onto several shelves of the 1024-wide atlas
+    std::vector<TestMirror> mirrors;
+    for (int i = 0; i < 24; i++) {
+        const Mode mode = static_cast<Mode>(i % 3);
+        const int w = 90 + (i * 37) % 150, hgt = 40 + (i * 23) % 90;
+        const std::vector<Color> targets = i % 2 ? std::vector<Color>{ kRed } : std::vector<Color>{ kGreen, kBlue };
+        mirrors.push_back(MakeMirror("mirror " + std::to_string(i), mode, w, hgt, i % 4,
+                                     { { (i * 53) % (GAME_W - w), (i * 31) % (GAME_H - hgt) } }, targets));
+    }
+    CompareBatchWithPerMirror(mirrors, RegionCache::Off);
+    CompareBatchWithPerMirror(mirrors, RegionCache::Required);
+}
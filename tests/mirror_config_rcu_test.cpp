@@ -0,0 +1,251 @@
+// ============================================================================
+// MIRROR_CONFIG_RCU_TEST.CPP - Stress test of the mirror config publish path
+// ============================================================================
+// The capture thread reads the published mirror configs through RcuSnapshot::Load while the GUI copies,
+// edits and republishes them (MT_EditThreadedConfig / MT_PublishThreadedConfigs in mirror_thread.cpp).
+// These tests run that scheme on a config list shaped like ThreadedMirrorConfigList (strings, color
+// vectors, capture regions) and check that a reader never sees a half-written config, that a snapshot it
+// holds never changes, that it is not held up by a writer's edit, and that replaced lists are freed.
+// ============================================================================
+
+#include "rcu_snapshot.h"
+#include "test_common.h"
+
+#include "gui.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<int> g_liveConfigs{ 0 };
+
+// Every field is derived from `stamp`, so a config mixing two writes is detected
+struct StressConfig {
+    std::string name;
+    uint64_t stamp = 0;
+    int captureWidth = 0;
+    int captureHeight = 0;
+    std::vector<Color> targetColors;
+    std::vector<MirrorCaptureConfig> input;
+
+    StressConfig() { g_liveConfigs.fetch_add(1, std::memory_order_relaxed); }
+    StressConfig(const StressConfig& o)
+        : name(o.name), stamp(o.stamp), captureWidth(o.captureWidth), captureHeight(o.captureHeight), targetColors(o.targetColors),
+          input(o.input) {
+        g_liveConfigs.fetch_add(1, std::memory_order_relaxed);
+    }
+    StressConfig& operator=(const StressConfig&) = default;
+    ~StressConfig() { g_liveConfigs.fetch_sub(1, std::memory_order_relaxed); }
+};
+using StressConfigList = std::vector<StressConfig>;
+
+void Fill(StressConfig& c, int slot, uint64_t stamp) {
+    c.stamp = stamp;
+    c.name = "mirror" + std::to_string(slot) + "_" + std::to_string(stamp);
+    c.captureWidth = static_cast<int>(stamp % 1000) + 1;
+    c.captureHeight = c.captureWidth * 2;
+    c.targetColors.assign(stamp % 9, Color{ static_cast<float>(stamp % 251), 0.5f, 0.25f, 1.0f });
+    c.input.resize(1 + stamp % 4);
+    for (size_t i = 0; i < c.input.size(); i++) {
+        c.input[i].x = static_cast<int>(stamp % 7919) + static_cast<int>(i);
+        c.input[i].y = -c.input[i].x;
+        c.input[i].relativeTo = c.name;
+    }
+}
+
+bool IsConsistent(const StressConfig& c, int slot) {
+    const uint64_t s = c.stamp;
+    if (c.name != "mirror" + std::to_string(slot) + "_" + std::to_string(s)) return false;
+    if (c.captureWidth != static_cast<int>(s % 1000) + 1 || c.captureHeight != c.captureWidth * 2) return false;
+    if (c.targetColors.size() != s % 9) return false;
+    for (const Color& col : c.targetColors) {
+        if (col.r != static_cast<float>(s % 251) || col.g != 0.5f || col.b != 0.25f || col.a != 1.0f) return false;
+    }
+    if (c.input.size() != 1 + s % 4) return false;
+    for (size_t i = 0; i < c.input.size(); i++) {
+        if (c.input[i].x != static_cast<int>(s % 7919) + static_cast<int>(i) || c.input[i].y != -c.input[i].x) return false;
+        if (c.input[i].relativeTo != c.name) return false;
+    }
+    return true;
+}
+
+bool IsConsistent(const StressConfigList& list) {
+    for (size_t i = 0; i < list.size(); i++) {
+        if (!IsConsistent(list[i], static_cast<int>(i))) return false;
+    }
+    return true;
+}
+
+struct Published {
+    RcuSnapshot<StressConfigList> snapshot;
+    std::mutex writerMutex; // g_threadedMirrorConfigMutex
+    uint64_t nextStamp = 1; // Under writerMutex
+};
+
+// MT_EditThreadedConfig: copy, edit one config, republish. Slot 0 is re-stamped on every publish so
+// readers can check that versions only move forward.
+void EditOne(Published& p, size_t slotCount) {
+    std::lock_guard<std::mutex> lock(p.writerMutex);
+    auto next = std::make_shared<StressConfigList>(*p.snapshot.Load());
+    if (next->size() != slotCount) next->resize(slotCount);
+    const uint64_t stamp = p.nextStamp++;
+    Fill((*next)[stamp % slotCount], static_cast<int>(stamp % slotCount), stamp);
+    Fill((*next)[0], 0, stamp);
+    p.snapshot.Publish(std::move(next));
+}
+
+void PublishInitial(Published& p, size_t slotCount) {
+    std::lock_guard<std::mutex> lock(p.writerMutex);
+    auto list = std::make_shared<StressConfigList>(slotCount);
+    for (size_t i = 0; i < slotCount; i++) Fill((*list)[i], static_cast<int>(i), 0);
+    p.snapshot.Publish(std::move(list));
+}
+
+} // namespace
+
+TEST_CASE(ReaderAt1kHzNeverSeesTornConfigs) {
+    constexpr size_t SLOTS = 24;
+    Published p;
+    PublishInitial(p, SLOTS);
+
+    std::atomic<bool> stop{ false };
+    std::atomic<uint64_t> edits{ 0 };
+    std::thread writer([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            EditOne(p, SLOTS);
+            edits.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    // A second reader without the 1 kHz pacing catches more interleavings with the writer
+    std::atomic<uint64_t> spinTorn{ 0 }, spinReads{ 0 };
+    std::thread spinner([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            auto list = p.snapshot.Load();
+            if (!IsConsistent(*list)) spinTorn.fetch_add(1, std::memory_order_relaxed);
+            spinReads.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    int reads = 0, torn = 0, backwards = 0;
+    uint64_t lastStamp = 0;
+    auto next = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1500; i++) { // 1.5 s at 1 kHz
+        next += std::chrono::milliseconds(1);
+        std::this_thread::sleep_until(next);
+        auto list = p.snapshot.Load();
+        reads++;
+        if (list->size() != SLOTS || !IsConsistent(*list)) torn++;
+        if (!list->empty()) {
+            if ((*list)[0].stamp < lastStamp) backwards++;
+            lastStamp = (*list)[0].stamp;
+        }
+    }
+    stop = true;
+    writer.join();
+    spinner.join();
+
+    CHECK_EQ(torn, 0);
+    CHECK_EQ(spinTorn.load(), 0u);
+    CHECK_EQ(backwards, 0);
+    CHECK_EQ(reads, 1500);
+    CHECK(edits.load() > 1000); // The writer really was hammering
+    CHECK(spinReads.load() > 0);
+    printf("  %d paced reads, %llu unpaced reads, %llu edits\n", reads, static_cast<unsigned long long>(spinReads.load()),
+           static_cast<unsigned long long>(edits.load()));
+}
+
+TEST_CASE(HeldSnapshotNeverChanges) {
+    constexpr size_t SLOTS = 8;
+    Published p;
+    PublishInitial(p, SLOTS);
+    EditOne(p, SLOTS);
+
+    // What the capture thread does for a frame: load once, use the list for the whole frame
+    auto held = p.snapshot.Load();
+    const StressConfigList copy = *held;
+
+    std::atomic<bool> stop{ false };
+    std::thread writer([&] {
+        while (!stop.load(std::memory_order_relaxed)) EditOne(p, SLOTS);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    stop = true;
+    writer.join();
+
+    REQUIRE(held->size() == copy.size());
+    for (size_t i = 0; i < copy.size(); i++) {
+        CHECK_EQ((*held)[i].stamp, copy[i].stamp);
+        CHECK((*held)[i].name == copy[i].name);
+    }
+    CHECK(IsConsistent(*held));
+    CHECK(p.snapshot.Load() != held);
+}
+
+TEST_CASE(ReaderDoesNotWaitForWriterEdit) {
+    constexpr size_t SLOTS = 8;
+    Published p;
+    PublishInitial(p, SLOTS);
+
+    // The GUI holds the writer lock for the whole copy-edit-publish; make that edit slow
+    std::atomic<int> editing{ 0 }; // Number of the edit in progress, 0 = none
+    std::atomic<bool> done{ false };
+    std::thread writer([&] {
+        for (int e = 1; e <= 10; e++) {
+            {
+                std::lock_guard<std::mutex> lock(p.writerMutex);
+                auto next = std::make_shared<StressConfigList>(*p.snapshot.Load());
+                editing.store(e);
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                const uint64_t stamp = p.nextStamp++;
+                Fill((*next)[0], 0, stamp);
+                editing.store(0);
+                p.snapshot.Publish(std::move(next));
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        done = true;
+    });
+
+    int loadsDuringEdit = 0, torn = 0;
+    auto next = std::chrono::steady_clock::now();
+    while (!done.load()) {
+        next += std::chrono::milliseconds(1);
+        std::this_thread::sleep_until(next);
+        const int before = editing.load();
+        auto list = p.snapshot.Load();
+        const int after = editing.load();
+        if (!IsConsistent(*list)) torn++;
+        // Same edit in progress before and after: this load completed while the writer held its lock
+        if (before != 0 && before == after) loadsDuringEdit++;
+    }
+    writer.join();
+
+    CHECK_EQ(torn, 0);
+    CHECK(loadsDuringEdit > 0);
+    printf("  %d loads completed while the writer held its lock\n", loadsDuringEdit);
+}
+
+TEST_CASE(ReplacedListsAreFreedByTheLastReader) {
+    const int liveBefore = g_liveConfigs.load();
+    {
+        constexpr size_t SLOTS = 6;
+        Published p;
+        PublishInitial(p, SLOTS);
+
+        auto held = p.snapshot.Load();
+        for (int i = 0; i < 1000; i++) EditOne(p, SLOTS);
+
+        // Only the held list and the current one are alive
+        CHECK_EQ(g_liveConfigs.load() - liveBefore, static_cast<int>(2 * SLOTS));
+        held.reset();
+        CHECK_EQ(g_liveConfigs.load() - liveBefore, static_cast<int>(SLOTS));
+    }
+    CHECK_EQ(g_liveConfigs.load(), liveBefore);
+}
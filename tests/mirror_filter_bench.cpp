@@ -0,0 +1,124 @@
+// ============================================================================
+// MIRROR_FILTER_BENCH.CPP - CPU mirror filter throughput on a 1920x1080 frame
+// ============================================================================
+// Filters a synthetic 1920x1080 game frame with MirrorFilterCapture, once as a single full-frame region
+// and once as 12 mirror-sized regions (the CPU fallback's usual load), for 1 to 8 target colors and each
+// match kernel, plus the precomputed match table (mirror_match_lut.h) the fallback uses once it is built.
+// ============================================================================
+
+#include "bench_common.h"
+#include "mirror_filter.h"
+#include "mirror_match_lut.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr int FRAME_W = 1920;
+constexpr int FRAME_H = 1080;
+
+struct Scenario {
+    const char* name;
+    int captureW, captureH;
+    std::vector<MirrorFilterRegion> regions;
+};
+
+// Noise with flat patches of the target colors, like HUD elements over terrain
+std::vector<uint8_t> MakeFrame(const std::vector<Color>& targets) {
+    std::vector<uint8_t> frame(static_cast<size_t>(FRAME_W) * FRAME_H * 4);
+    std::mt19937 rng(1080);
+    std::uniform_int_distribution<int> byte(0, 255);
+    for (size_t i = 0; i < frame.size(); i += 4) {
+        frame[i] = static_cast<uint8_t>(byte(rng));
+        frame[i + 1] = static_cast<uint8_t>(byte(rng));
+        frame[i + 2] = static_cast<uint8_t>(byte(rng));
+        frame[i + 3] = 255;
+    }
+    for (size_t t = 0; t < targets.size(); t++) {
+        const int x0 = static_cast<int>(t % 4) * 480, y0 = static_cast<int>(t / 4) * 540;
+        for (int y = y0; y < y0 + 200; y++) {
+            for (int x = x0; x < x0 + 200; x++) {
+                uint8_t* p = &frame[(static_cast<size_t>(y) * FRAME_W + x) * 4];
+                p[0] = static_cast<uint8_t>(targets[t].r * 255.0f + 0.5f);
+                p[1] = static_cast<uint8_t>(targets[t].g * 255.0f + 0.5f);
+                p[2] = static_cast<uint8_t>(targets[t].b * 255.0f + 0.5f);
+            }
+        }
+    }
+    return frame;
+}
+
+const char* KernelName(MirrorFilterKernel kernel) {
+    switch (kernel) {
+    case MirrorFilterKernel::AVX2:
+        return "AVX2";
+    case MirrorFilterKernel::SSE2:
+        return "SSE2";
+    default:
+        return "Scalar";
+    }
+}
+
+} // namespace
+
+int main() {
+    std::vector<Color> allTargets;
+    std::mt19937 rng(8);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    for (int i = 0; i < 8; i++) allTargets.push_back(Color{ unit(rng), unit(rng), unit(rng), 1.0f });
+    const std::vector<uint8_t> frame = MakeFrame(allTargets);
+
+    MirrorFilterSource source;
+    source.pixels = frame.data();
+    source.width = FRAME_W;
+    source.height = FRAME_H;
+
+    std::vector<Scenario> scenarios;
+    scenarios.push_back({ "full frame", FRAME_W, FRAME_H, { { 0, 0, nullptr } } });
+    Scenario mirrors{ "12 regions 256x256", 256, 256, {} };
+    for (int i = 0; i < 12; i++) mirrors.regions.push_back({ (i % 6) * 300 + 20, (i / 6) * 500 + 40, nullptr });
+    scenarios.push_back(mirrors);
+
+    std::vector<MirrorFilterKernel> kernels;
+    const MirrorFilterKernel best = GetMirrorFilterKernel();
+    for (MirrorFilterKernel k : { MirrorFilterKernel::Scalar, MirrorFilterKernel::SSE2, MirrorFilterKernel::AVX2 }) {
+        SetMirrorFilterKernel(k);
+        if (GetMirrorFilterKernel() == k) kernels.push_back(k);
+    }
+
+    printf("%-20s %7s %-7s %12s %12s\n", "scenario", "targets", "kernel", "ms/frame", "Mpixel/s");
+    for (const Scenario& scenario : scenarios) {
+        const long long pixels = static_cast<long long>(scenario.captureW) * scenario.captureH * static_cast<long long>(scenario.regions.size());
+        MirrorFilterImage capture;
+        capture.Resize(scenario.captureW, scenario.captureH);
+
+        for (int targets = 1; targets <= 8; targets++) {
+            MirrorFilterParams params;
+            params.targetColors.assign(allTargets.begin(), allTargets.begin() + targets);
+            params.sensitivity = 0.05f;
+            params.outputColor = Color{ 1.0f, 1.0f, 1.0f, 1.0f };
+            MirrorFilterMatcher matcher = BuildMirrorFilterMatcher(params);
+
+            auto run = [&](const char* label) {
+                const double ns = BenchNsPerCall([&] {
+                    MirrorFilterCapture(params, matcher, source, scenario.regions, scenario.captureW, scenario.captureH, 0, capture);
+                    BenchKeep(capture.pixels[capture.pixels.size() / 2]);
+                });
+                printf("%-20s %7d %-7s %12.3f %12.1f\n", scenario.name, targets, label, ns / 1e6, static_cast<double>(pixels) / (ns / 1e3));
+            };
+            for (MirrorFilterKernel k : kernels) {
+                SetMirrorFilterKernel(k);
+                run(KernelName(k));
+            }
+
+            SetMirrorFilterKernel(best);
+            auto lut = std::make_shared<MirrorMatchLut>();
+            BuildMirrorMatchLut(MakeMirrorMatchLutKey(params.targetColors, params.sensitivity, params.gammaMode), *lut);
+            matcher.lut = lut;
+            run("LUT");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,389 @@
+// ============================================================================
+// MIRROR_FILTER_TEST.CPP - Match kernels and the CPU filter pipeline
+// ============================================================================
+// The scalar, SSE2 and AVX2 match kernels are documented to agree bit for bit; the CPU fallback and every
+// test that uses mirror_filter.h as its oracle depend on that. Kernels the CPU lacks are skipped (and
+// reported), since SetMirrorFilterKernel clamps to what is supported.
+// ============================================================================
+
+#include "mirror_filter.h"
+#include "test_common.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+const MirrorGammaMode GAMMA_MODES[] = { MirrorGammaMode::Auto, MirrorGammaMode::AssumeSRGB, MirrorGammaMode::AssumeLinear };
+
+const char* GammaName(MirrorGammaMode mode) {
+    switch (mode) {
+    case MirrorGammaMode::AssumeSRGB:
+        return "AssumeSRGB";
+    case MirrorGammaMode::AssumeLinear:
+        return "AssumeLinear";
+    default:
+        return "Auto";
+    }
+}
+
+const char* KernelName(MirrorFilterKernel kernel) {
+    switch (kernel) {
+    case MirrorFilterKernel::AVX2:
+        return "AVX2";
+    case MirrorFilterKernel::SSE2:
+        return "SSE2";
+    default:
+        return "Scalar";
+    }
+}
+
+// Kernels this CPU can run, scalar first
+std::vector<MirrorFilterKernel> AvailableKernels() {
+    std::vector<MirrorFilterKernel> kernels;
+    const MirrorFilterKernel saved = GetMirrorFilterKernel();
+    for (MirrorFilterKernel k : { MirrorFilterKernel::Scalar, MirrorFilterKernel::SSE2, MirrorFilterKernel::AVX2 }) {
+        SetMirrorFilterKernel(k);
+        if (GetMirrorFilterKernel() == k) kernels.push_back(k);
+    }
+    SetMirrorFilterKernel(saved);
+    return kernels;
+}
+
+MirrorFilterParams RandomParams(std::mt19937& rng, int targetCount, float sensitivity, MirrorGammaMode gammaMode) {
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    MirrorFilterParams params;
+    for (int t = 0; t < targetCount; t++) params.targetColors.push_back(Color{ unit(rng), unit(rng), unit(rng), 1.0f });
+    params.sensitivity = sensitivity;
+    params.gammaMode = gammaMode;
+    return params;
+}
+
+// Random pixels, half of them within a few steps of a target so both sides of the threshold are hit
+std::vector<uint8_t> PixelsAroundTargets(std::mt19937& rng, const MirrorFilterParams& params, int count) {
+    std::vector<uint8_t> rgba(static_cast<size_t>(count) * 4);
+    std::uniform_int_distribution<int> byte(0, 255), delta(-24, 24);
+    for (int i = 0; i < count; i++) {
+        uint8_t* p = &rgba[static_cast<size_t>(i) * 4];
+        if (i % 2 == 0 || params.targetColors.empty()) {
+            for (int c = 0; c < 4; c++) p[c] = static_cast<uint8_t>(byte(rng));
+            continue;
+        }
+        const Color& t = params.targetColors[static_cast<size_t>(byte(rng)) % params.targetColors.size()];
+        const float channels[3] = { t.r, t.g, t.b };
+        for (int c = 0; c < 3; c++) {
+            int v = static_cast<int>(channels[c] * 255.0f + 0.5f) + delta(rng);
+            p[c] = static_cast<uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+        }
+        p[3] = static_cast<uint8_t>(byte(rng));
+    }
+    return rgba;
+}
+
+std::vector<uint8_t> MatchWith(MirrorFilterKernel kernel, const MirrorFilterMatcher& matcher, const uint8_t* rgba, int count) {
+    SetMirrorFilterKernel(kernel);
+    std::vector<uint8_t> mask(static_cast<size_t>(count), 0xCD);
+    MirrorFilterMatchPixels(matcher, rgba, count, mask.data());
+    return mask;
+}
+
+// Per-pixel statistics straight from the documented rules: visible pixels, then one single-target match each
+MirrorPixelStats ReferenceStats(const MirrorFilterParams& params, const uint8_t* rgba, int width, int height, size_t rowStride) {
+    auto add = [](MirrorPixelStatsEntry& e, int x, int y) {
+        if (e.count == 0) {
+            e.minX = e.maxX = x;
+            e.minY = y;
+        }
+        e.minX = (std::min)(e.minX, x);
+        e.maxX = (std::max)(e.maxX, x);
+        e.maxY = y;
+        e.count++;
+    };
+    MirrorPixelStats stats;
+    stats.width = width;
+    stats.height = height;
+    stats.targets.assign(params.targetColors.size(), MirrorPixelStatsEntry{});
+    for (size_t t = 0; t < params.targetColors.size(); t++) {
+        MirrorFilterParams single = params;
+        single.targetColors.assign(1, params.targetColors[t]);
+        const MirrorFilterMatcher matcher = BuildMirrorFilterMatcher(single);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                const uint8_t* p = rgba + y * rowStride + static_cast<size_t>(x) * 4;
+                uint8_t match = 0;
+                MirrorFilterMatchPixels(matcher, p, 1, &match);
+                if (p[3] > 0 && match) add(stats.targets[t], x, y);
+            }
+        }
+    }
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (rgba[y * rowStride + static_cast<size_t>(x) * 4 + 3] > 0) add(stats.content, x, y);
+        }
+    }
+    return stats;
+}
+
+bool SameEntry(const MirrorPixelStatsEntry& a, const MirrorPixelStatsEntry& b) {
+    if (a.count != b.count) return false;
+    return a.count == 0 || (a.minX == b.minX && a.minY == b.minY && a.maxX == b.maxX && a.maxY == b.maxY);
+}
+
+bool SameStats(const MirrorPixelStats& a, const MirrorPixelStats& b) {
+    if (a.width != b.width || a.height != b.height || !SameEntry(a.content, b.content) || a.targets.size() != b.targets.size()) return false;
+    for (size_t t = 0; t < a.targets.size(); t++) {
+        if (!SameEntry(a.targets[t], b.targets[t])) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE(KernelsAgreeBitForBit) {
+    const std::vector<MirrorFilterKernel> kernels = AvailableKernels();
+    const MirrorFilterKernel saved = GetMirrorFilterKernel();
+    for (MirrorFilterKernel k : { MirrorFilterKernel::SSE2, MirrorFilterKernel::AVX2 }) {
+        if (std::find(kernels.begin(), kernels.end(), k) == kernels.end()) printf("  %s not supported here, skipped\n", KernelName(k));
+    }
+
+    std::mt19937 rng(51);
+    const int targetCounts[] = { 1, 2, 3, 5, 8, 12 };
+    const float sensitivities[] = { 0.001f, 0.02f, 0.08f, 0.25f, 0.9f };
+    int matched = 0, total = 0;
+    for (MirrorGammaMode gamma : GAMMA_MODES) {
+        for (int targets : targetCounts) {
+            for (float sensitivity : sensitivities) {
+                const MirrorFilterParams params = RandomParams(rng, targets, sensitivity, gamma);
+                const MirrorFilterMatcher matcher = BuildMirrorFilterMatcher(params);
+                // Odd length so every kernel also runs its scalar tail
+                const std::vector<uint8_t> rgba = PixelsAroundTargets(rng, params, 4099);
+
+                const std::vector<uint8_t> reference = MatchWith(MirrorFilterKernel::Scalar, matcher, rgba.data(), 4099);
+                for (uint8_t m : reference) {
+                    CHECK(m == 0 || m == 1);
+                    matched += m;
+                }
+                total += 4099;
+                for (MirrorFilterKernel k : kernels) {
+                    SetTestContext(std::string(GammaName(gamma)) + ", " + std::to_string(targets) + " targets, sensitivity " +
+                                   std::to_string(sensitivity) + ", " + KernelName(k));
+                    CHECK(MatchWith(k, matcher, rgba.data(), 4099) == reference);
+                }
+            }
+        }
+    }
+    SetMirrorFilterKernel(saved);
+    // The pixel mix must exercise both outcomes, or agreement proves nothing
+    CHECK(matched > total / 20);
+    CHECK(matched < total - total / 20);
+}
+
+TEST_CASE(KernelsAgreeOnEveryRgbValue) {
+    const std::vector<MirrorFilterKernel> kernels = AvailableKernels();
+    const MirrorFilterKernel saved = GetMirrorFilterKernel();
+
+    constexpr int COUNT = 1 << 24;
+    std::vector<uint8_t> rgba(static_cast<size_t>(COUNT) * 4);
+    for (int i = 0; i < COUNT; i++) {
+        rgba[static_cast<size_t>(i) * 4 + 0] = static_cast<uint8_t>(i >> 16);
+        rgba[static_cast<size_t>(i) * 4 + 1] = static_cast<uint8_t>(i >> 8);
+        rgba[static_cast<size_t>(i) * 4 + 2] = static_cast<uint8_t>(i);
+        rgba[static_cast<size_t>(i) * 4 + 3] = 255;
+    }
+
+    std::mt19937 rng(5101);
+    for (MirrorGammaMode gamma : GAMMA_MODES) {
+        const MirrorFilterParams params = RandomParams(rng, 4, 0.1f, gamma);
+        const MirrorFilterMatcher matcher = BuildMirrorFilterMatcher(params);
+        const std::vector<uint8_t> reference = MatchWith(MirrorFilterKernel::Scalar, matcher, rgba.data(), COUNT);
+        for (MirrorFilterKernel k : kernels) {
+            if (k == MirrorFilterKernel::Scalar) continue;
+            SetTestContext(std::string(GammaName(gamma)) + ", " + KernelName(k));
+            const std::vector<uint8_t> mask = MatchWith(k, matcher, rgba.data(), COUNT);
+            int mismatches = 0;
+            for (int i = 0; i < COUNT; i++) mismatches += mask[i] != reference[i];
+            CHECK_EQ(mismatches, 0);
+        }
+    }
+    SetMirrorFilterKernel(saved);
+}
+
+TEST_CASE(EveryLengthUsesTheSameTailRules) {
+    const std::vector<MirrorFilterKernel> kernels = AvailableKernels();
+    const MirrorFilterKernel saved = GetMirrorFilterKernel();
+    std::mt19937 rng(7);
+    const MirrorFilterParams params = RandomParams(rng, 3, 0.15f, MirrorGammaMode::Auto);
+    const MirrorFilterMatcher matcher = BuildMirrorFilterMatcher(params);
+    const std::vector<uint8_t> rgba = PixelsAroundTargets(rng, params, 64);
+
+    // Lengths around the 4- and 8-pixel block sizes, starting at unaligned offsets
+    for (int offset = 0; offset < 3; offset++) {
+        for (int count = 1; count <= 40; count++) {
+            const uint8_t* start = rgba.data() + offset * 4;
+            const std::vector<uint8_t> reference = MatchWith(MirrorFilterKernel::Scalar, matcher, start, count);
+            for (MirrorFilterKernel k : kernels) {
+                SetTestContext("offset " + std::to_string(offset) + ", count " + std::to_string(count) + ", " + KernelName(k));
+                CHECK(MatchWith(k, matcher, start, count) == reference);
+            }
+        }
+    }
+    SetMirrorFilterKernel(saved);
+}
+
+TEST_CASE(NoTargetsOrZeroSensitivityMatchNothing) {
+    std::mt19937 rng(3);
+    for (const MirrorFilterParams& params : { RandomParams(rng, 0, 0.5f, MirrorGammaMode::Auto), RandomParams(rng, 3, 0.0f, MirrorGammaMode::Auto),
+                                              RandomParams(rng, 3, -0.5f, MirrorGammaMode::AssumeSRGB) }) {
+        const MirrorFilterMatcher matcher = BuildMirrorFilterMatcher(params);
+        CHECK(matcher.matchNothing);
+        std::vector<uint8_t> rgba(256 * 4);
+        for (int i = 0; i < 256; i++) rgba[i * 4] = rgba[i * 4 + 1] = rgba[i * 4 + 2] = static_cast<uint8_t>(i);
+        std::vector<uint8_t> mask(256, 1);
+        MirrorFilterMatchPixels(matcher, rgba.data(), 256, mask.data());
+        CHECK(std::all_of(mask.begin(), mask.end(), [](uint8_t m) { return m == 0; }));
+    }
+}
+
+TEST_CASE(CaptureAddsOverlappingRegionsAndResolveDrawsTheBorder) {
+    // 4x1 source: two pure red pixels, then two black ones
+    const uint8_t frame[] = { 255, 0, 0, 255, 255, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255 };
+    MirrorFilterSource source;
+    source.pixels = frame;
+    source.width = 4;
+    source.height = 1;
+
+    MirrorFilterParams params;
+    params.targetColors = { Color{ 1.0f, 0.0f, 0.0f, 1.0f } };
+    params.sensitivity = 0.01f;
+    params.outputColor = Color{ 0.4f, 0.2f, 0.0f, 0.6f };
+    params.borderColor = Color{ 0.0f, 0.0f, 1.0f, 1.0f };
+    params.borderType = MirrorBorderType::Dynamic;
+    params.dynamicBorderThickness = 1;
+    const MirrorFilterMatcher matcher = BuildMirrorFilterMatcher(params);
+
+    // Two 2x1 regions: x=0 covers both red pixels, x=1 covers one red and one black. Blending is additive.
+    const int padding = 1;
+    MirrorFilterImage capture;
+    capture.Resize(2 + 2 * padding, 1 + 2 * padding);
+    MirrorFilterCapture(params, matcher, source, { { 0, 0, nullptr }, { 1, 0, nullptr } }, 2, 1, padding, capture);
+
+    auto px = [&](const MirrorFilterImage& img, int x, int y) { return &img.pixels[(static_cast<size_t>(y) * img.width + x) * 4]; };
+    const uint8_t* first = px(capture, 1, 1);
+    const uint8_t* second = px(capture, 2, 1);
+    CHECK_EQ(int(first[0]), 204); // 102 + 102
+    CHECK_EQ(int(first[1]), 102);
+    CHECK_EQ(int(first[3]), 255); // 153 + 153, saturated
+    CHECK_EQ(int(second[0]), 102);
+    CHECK_EQ(int(second[3]), 153);
+    CHECK_EQ(int(px(capture, 0, 1)[3]), 0); // Padding stays clear
+    CHECK(MirrorFilterHasContent(capture));
+
+    MirrorFilterImage finalImage;
+    MirrorFilterResolve(params, capture, 4, 3, finalImage);
+    // Content pixels get the output color, pixels within one of them the border color, the rest stays clear
+    CHECK_EQ(int(px(finalImage, 1, 1)[0]), 102);
+    CHECK_EQ(int(px(finalImage, 1, 1)[3]), 153);
+    CHECK_EQ(int(px(finalImage, 0, 1)[2]), 255);
+    CHECK_EQ(int(px(finalImage, 3, 0)[2]), 255);
+    CHECK_EQ(int(px(finalImage, 3, 1)[2]), 255);
+}
+
+TEST_CASE(StatsMatchThePerPixelReference) {
+    const std::vector<MirrorFilterKernel> kernels = AvailableKernels();
+    const MirrorFilterKernel saved = GetMirrorFilterKernel();
+    std::mt19937 rng(59);
+    const MirrorFilterParams params = RandomParams(rng, 3, 0.12f, MirrorGammaMode::Auto);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    // Widths around the 16-byte mask blocks, padded strides, and sparse rows so first/last land in blocks and tails
+    for (int width : { 1, 7, 15, 16, 17, 31, 33, 64, 95 }) {
+        for (int padding : { 0, 12 }) {
+            const int height = 9;
+            const size_t rowStride = static_cast<size_t>(width) * 4 + padding;
+            std::vector<uint8_t> image(rowStride * height, 0xEE); // Row padding is garbage with alpha set
+            for (int y = 0; y < height; y++) {
+                const std::vector<uint8_t> row = PixelsAroundTargets(rng, params, width);
+                std::copy(row.begin(), row.end(), image.begin() + y * rowStride);
+                for (int x = 0; x < width; x++) {
+                    // Mostly transparent, as mirror captures are; rows 0 and 4 entirely so
+                    if (y == 0 || y == 4 || percent(rng) < 80) image[y * rowStride + static_cast<size_t>(x) * 4 + 3] = 0;
+                }
+            }
+            const MirrorPixelStats reference = ReferenceStats(params, image.data(), width, height, rowStride);
+            for (MirrorFilterKernel k : kernels) {
+                SetTestContext("width " + std::to_string(width) + ", padding " + std::to_string(padding) + ", " + KernelName(k));
+                SetMirrorFilterKernel(k);
+                MirrorPixelStats stats;
+                MirrorFilterComputeStats(params, image.data(), width, height, padding ? static_cast<int>(rowStride) : 0, stats);
+                CHECK(SameStats(stats, reference));
+            }
+        }
+    }
+    SetMirrorFilterKernel(saved);
+}
+
+TEST_CASE(StatsReportBoundingBoxesOfKnownShapes) {
+    const std::vector<MirrorFilterKernel> kernels = AvailableKernels();
+    const MirrorFilterKernel saved = GetMirrorFilterKernel();
+    MirrorFilterParams params;
+    params.targetColors = { Color{ 1.0f, 0.0f, 0.0f, 1.0f }, Color{ 0.0f, 0.0f, 1.0f, 1.0f }, Color{ 0.0f, 1.0f, 0.0f, 1.0f } };
+    params.sensitivity = 0.01f;
+
+    // 40x20, clear except a red 5x3 block at (3..7, 2..4), a blue pixel at (39, 19) and an invisible green pixel
+    const int w = 40, h = 20;
+    std::vector<uint8_t> image(static_cast<size_t>(w) * h * 4, 0);
+    auto set = [&](int x, int y, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+        uint8_t* p = &image[(static_cast<size_t>(y) * w + x) * 4];
+        p[0] = r, p[1] = g, p[2] = b, p[3] = a;
+    };
+    for (int y = 2; y <= 4; y++) {
+        for (int x = 3; x <= 7; x++) set(x, y, 255, 0, 0, 255);
+    }
+    set(39, 19, 0, 0, 255, 1);
+    set(20, 10, 0, 255, 0, 0);
+
+    for (MirrorFilterKernel k : kernels) {
+        SetTestContext(KernelName(k));
+        SetMirrorFilterKernel(k);
+        MirrorPixelStats stats;
+        MirrorFilterComputeStats(params, image.data(), w, h, 0, stats);
+        CHECK_EQ(stats.content.count, 16);
+        CHECK_EQ(stats.content.minX, 3);
+        CHECK_EQ(stats.content.minY, 2);
+        CHECK_EQ(stats.content.maxX, 39);
+        CHECK_EQ(stats.content.maxY, 19);
+        REQUIRE(stats.targets.size() == 3u);
+        CHECK_EQ(stats.targets[0].count, 15);
+        CHECK_EQ(stats.targets[0].minX, 3);
+        CHECK_EQ(stats.targets[0].maxX, 7);
+        CHECK_EQ(stats.targets[0].minY, 2);
+        CHECK_EQ(stats.targets[0].maxY, 4);
+        CHECK_EQ(stats.targets[1].count, 1);
+        CHECK_EQ(stats.targets[1].minX, 39);
+        CHECK_EQ(stats.targets[1].minY, 19);
+        CHECK(stats.targets[2].Empty()); // Fully transparent pixels never count
+    }
+    SetMirrorFilterKernel(saved);
+}
+
+TEST_CASE(StatsOfEmptyInputsAreEmpty) {
+    MirrorFilterParams params;
+    params.targetColors = { Color{ 1.0f, 0.0f, 0.0f, 1.0f } };
+    params.sensitivity = 0.1f;
+    MirrorPixelStats stats;
+    stats.content.count = 5;
+    MirrorFilterComputeStats(params, nullptr, 16, 16, 0, stats);
+    CHECK(stats.content.Empty());
+    REQUIRE(stats.targets.size() == 1u);
+    CHECK(stats.targets[0].Empty());
+
+    const std::vector<uint8_t> clear(64 * 4, 0);
+    MirrorFilterComputeStats(params, clear.data(), 64, 1, 0, stats);
+    CHECK(stats.content.Empty());
+    CHECK(stats.targets[0].Empty());
+    MirrorFilterComputeStats(params, clear.data(), 0, 1, 0, stats);
+    CHECK(stats.content.Empty());
+}
@@ -0,0 +1,211 @@
+// ============================================================================
+// MIRROR_MATCH_LUT_TEST.CPP - Match table against the per-pixel matcher
+// ============================================================================
+// BuildMirrorMatchLut only evaluates the RGB boxes that pass a per-channel test and relies on that pruning
+// never dropping a color the full test would match. Each table here is compared with
+// MirrorFilterMatchPixels over the whole 24-bit cube, including configurations where the pruning bound is
+// tight: per-channel ties with the sensitivity, targets on the cube faces, sensitivities that cover the
+// whole cube or nothing at all.
+// ============================================================================
+
+#include "mirror_match_lut.h"
+#include "test_common.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+// Every RGB value once, R major like the table index
+const std::vector<uint8_t>& WholeCube() {
+    static std::vector<uint8_t> s_rgba;
+    if (s_rgba.empty()) {
+        s_rgba.resize(static_cast<size_t>(1) << 26);
+        for (uint32_t i = 0; i < (1u << 24); i++) {
+            s_rgba[static_cast<size_t>(i) * 4 + 0] = static_cast<uint8_t>(i >> 16);
+            s_rgba[static_cast<size_t>(i) * 4 + 1] = static_cast<uint8_t>(i >> 8);
+            s_rgba[static_cast<size_t>(i) * 4 + 2] = static_cast<uint8_t>(i);
+            s_rgba[static_cast<size_t>(i) * 4 + 3] = 255;
+        }
+    }
+    return s_rgba;
+}
+
+struct LutCase {
+    const char* name;
+    std::vector<Color> targets;
+    float sensitivity;
+    MirrorGammaMode gammaMode;
+};
+
+// Compares table and matcher on all 2^24 colors; returns the number of matching colors
+int CompareWithMatcher(const LutCase& c) {
+    SetTestContext(c.name);
+    MirrorFilterParams params;
+    params.targetColors = c.targets;
+    params.sensitivity = c.sensitivity;
+    params.gammaMode = c.gammaMode;
+    const MirrorFilterMatcher matcher = BuildMirrorFilterMatcher(params);
+
+    MirrorMatchLut lut;
+    BuildMirrorMatchLut(MakeMirrorMatchLutKey(c.targets, c.sensitivity, c.gammaMode), lut);
+
+    const std::vector<uint8_t>& cube = WholeCube();
+    std::vector<uint8_t> mask(1u << 24);
+    MirrorFilterMatchPixels(matcher, cube.data(), 1 << 24, mask.data());
+
+    int matches = 0, missing = 0, extra = 0;
+    for (uint32_t i = 0; i < (1u << 24); i++) {
+        const bool inLut = lut.Test(static_cast<uint8_t>(i >> 16), static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i));
+        matches += mask[i];
+        if (mask[i] && !inLut) missing++;
+        if (!mask[i] && inLut) extra++;
+    }
+    CHECK_EQ(missing, 0);
+    CHECK_EQ(extra, 0);
+    CHECK_EQ(lut.empty, matches == 0);
+    printf("  %-40s %9d colors, built in %7.2f ms\n", c.name, matches, lut.buildTimeMs);
+    return matches;
+}
+
+} // namespace
+
+TEST_CASE(TableMatchesMatcherOnTypicalConfigs) {
+    const Color red{ 0.87f, 0.12f, 0.10f, 1.0f }, green{ 0.20f, 0.75f, 0.31f, 1.0f }, gray{ 0.5f, 0.5f, 0.5f, 1.0f };
+    CHECK(CompareWithMatcher({ "Auto, 3 targets, 0.05", { red, green, gray }, 0.05f, MirrorGammaMode::Auto }) > 0);
+    CHECK(CompareWithMatcher({ "AssumeSRGB, 3 targets, 0.05", { red, green, gray }, 0.05f, MirrorGammaMode::AssumeSRGB }) > 0);
+    CHECK(CompareWithMatcher({ "AssumeLinear, 3 targets, 0.05", { red, green, gray }, 0.05f, MirrorGammaMode::AssumeLinear }) > 0);
+    // A target on an exact channel value with a sensitivity under one step matches that color alone
+    const float v = 128.0f / 255.0f;
+    CHECK_EQ(CompareWithMatcher({ "Auto, exact value, 0.001", { { v, v, v, 1.0f } }, 0.001f, MirrorGammaMode::Auto }), 1);
+}
+
+TEST_CASE(TableMatchesMatcherOnManyOverlappingTargets) {
+    // More targets than the old 8-color limit, several within sensitivity of each other
+    std::vector<Color> targets;
+    for (int i = 0; i < 12; i++) targets.push_back(Color{ 0.3f + 0.01f * i, 0.6f - 0.02f * i, (i % 3) / 2.0f, 1.0f });
+    CHECK(CompareWithMatcher({ "Auto, 12 overlapping targets, 0.04", targets, 0.04f, MirrorGammaMode::Auto }) > 0);
+}
+
+TEST_CASE(TableMatchesMatcherAtPruningEdges) {
+    // Targets on the cube's faces and corners: the per-channel candidate ranges are clipped at 0 and 255
+    CHECK(CompareWithMatcher({ "AssumeSRGB, black and white corners", { { 0, 0, 0, 1 }, { 1, 1, 1, 1 } }, 0.1f, MirrorGammaMode::AssumeSRGB }) > 0);
+    CHECK(CompareWithMatcher({ "Auto, pure primaries", { { 1, 0, 0, 1 }, { 0, 1, 0, 1 }, { 0, 0, 1, 1 } }, 0.08f, MirrorGammaMode::Auto }) > 0);
+
+    // Sensitivity equal to a channel step: for v = 10 the per-channel term equals sensitivity^2 exactly, which
+    // fails the strict test both in the pruning and in the full distance
+    const int boundaryMatches =
+        CompareWithMatcher({ "AssumeLinear, per-channel tie", { { 0, 0, 0, 1 } }, 10.0f / 255.0f, MirrorGammaMode::AssumeLinear });
+    CHECK(boundaryMatches > 0);
+
+    // Auto mode can admit a channel value through the sRGB term and another through the linear term; the
+    // candidate sets are unions, and the full test decides
+    CHECK(CompareWithMatcher({ "Auto, mid-gray, wide", { { 0.5f, 0.5f, 0.5f, 1 } }, 0.3f, MirrorGammaMode::Auto }) > 0);
+
+    // Sensitivity beyond the cube diagonal: every channel value is a candidate, every color matches
+    CHECK_EQ(CompareWithMatcher({ "AssumeLinear, sensitivity 2", { { 0.5f, 0.5f, 0.5f, 1 } }, 2.0f, MirrorGammaMode::AssumeLinear }),
+             1 << 24);
+}
+
+TEST_CASE(TableIsEmptyWhenNothingCanMatch) {
+    // Below half a channel step around a target halfway between two values, no value passes a channel
+    CHECK_EQ(CompareWithMatcher({ "Auto, between values, 0.0005", { { 0.5f / 255.0f + 0.5f, 0.5f, 0.5f, 1 } }, 0.0005f, MirrorGammaMode::Auto }),
+             0);
+    CHECK_EQ(CompareWithMatcher({ "Auto, sensitivity 0", { { 0.5f, 0.5f, 0.5f, 1 } }, 0.0f, MirrorGammaMode::Auto }), 0);
+    CHECK_EQ(CompareWithMatcher({ "Auto, no targets", {}, 0.5f, MirrorGammaMode::Auto }), 0);
+}
+
+TEST_CASE(KeyCoversEveryInput) {
+    const std::vector<Color> targets = { { 0.1f, 0.2f, 0.3f, 1 } };
+    const MirrorMatchLutKey base = MakeMirrorMatchLutKey(targets, 0.1f, MirrorGammaMode::Auto);
+    CHECK(base == MakeMirrorMatchLutKey(targets, 0.1f, MirrorGammaMode::Auto));
+    CHECK(!(base == MakeMirrorMatchLutKey(targets, 0.1001f, MirrorGammaMode::Auto)));
+    CHECK(!(base == MakeMirrorMatchLutKey(targets, 0.1f, MirrorGammaMode::AssumeSRGB)));
+    CHECK(!(base == MakeMirrorMatchLutKey({ { 0.1f, 0.2f, 0.31f, 1 } }, 0.1f, MirrorGammaMode::Auto)));
+    // Alpha does not take part in matching, so it does not split the cache
+    CHECK(base == MakeMirrorMatchLutKey({ { 0.1f, 0.2f, 0.3f, 0.5f } }, 0.1f, MirrorGammaMode::Auto));
+}
+
+TEST_CASE(CacheReusesAndEvictsLeastRecentlyUsed) {
+    MirrorMatchLutCache cache(2);
+    const MirrorMatchLutKey a = MakeMirrorMatchLutKey({ { 0.1f, 0.1f, 0.1f, 1 } }, 0.01f, MirrorGammaMode::Auto);
+    const MirrorMatchLutKey b = MakeMirrorMatchLutKey({ { 0.2f, 0.2f, 0.2f, 1 } }, 0.01f, MirrorGammaMode::Auto);
+    const MirrorMatchLutKey c = MakeMirrorMatchLutKey({ { 0.3f, 0.3f, 0.3f, 1 } }, 0.01f, MirrorGammaMode::Auto);
+
+    bool built = false;
+    auto first = cache.Get(a, &built);
+    CHECK(built);
+    CHECK(cache.Get(a, &built) == first);
+    CHECK(!built);
+    cache.Get(b, &built);
+    cache.Get(a, &built); // a is now the most recent
+    cache.Get(c, &built); // evicts b
+    CHECK_EQ(cache.Size(), 2u);
+    cache.Get(a, &built);
+    CHECK(!built);
+    cache.Get(b, &built);
+    CHECK(built);
+}
+
+TEST_CASE(CacheWaitsForSettledKeys) {
+    MirrorMatchLutCache cache(4, 50);
+    const MirrorMatchLutKey a = MakeMirrorMatchLutKey({ { 0.1f, 0.1f, 0.1f, 1 } }, 0.01f, MirrorGammaMode::Auto);
+    bool built = true;
+    CHECK(cache.Get(a, &built) == nullptr);
+    CHECK(!built);
+    CHECK(cache.Get(a, &built, /*skipSettle*/ true) != nullptr);
+    CHECK(built);
+}
+
+TEST_CASE(MatcherCacheRebuildsOnlyWhenMatchSettingsChange) {
+    MirrorFilterMatcherCache cache;
+    const MirrorHandle slot{ 3, 1 };
+    MirrorFilterParams params;
+    params.targetColors = { { 0.1f, 0.2f, 0.3f, 1 }, { 0.7f, 0.6f, 0.5f, 1 } };
+    params.sensitivity = 0.05f;
+
+    bool built = false;
+    const MirrorFilterMatcherCache::Entry* first = &cache.Get(slot, params, &built);
+    CHECK(built);
+    const MirrorFilterMatcher expected = BuildMirrorFilterMatcher(params);
+    CHECK(first->matcher.targetsLinear == expected.targetsLinear);
+    CHECK_EQ(first->matcher.sensitivitySq, expected.sensitivitySq);
+    CHECK(first->lutKey == MakeMirrorMatchLutKey(params.targetColors, params.sensitivity, params.gammaMode));
+
+    // Output, border and raw-output settings do not take part in matching
+    params.outputColor = { 1, 0, 0, 1 };
+    params.borderColor = { 0, 1, 0, 1 };
+    params.dynamicBorderThickness = 4;
+    params.colorPassthrough = true;
+    params.rawOutput = true;
+    params.targetColors[1].a = 0.5f;
+    CHECK(&cache.Get(slot, params, &built) == first);
+    CHECK(!built);
+
+    const std::vector<std::pair<const char*, void (*)(MirrorFilterParams&)>> changes = {
+        { "sensitivity", [](MirrorFilterParams& p) { p.sensitivity = 0.0501f; } },
+        { "gamma mode", [](MirrorFilterParams& p) { p.gammaMode = MirrorGammaMode::AssumeLinear; } },
+        { "target color", [](MirrorFilterParams& p) { p.targetColors[1].b = 0.51f; } },
+        { "added target", [](MirrorFilterParams& p) { p.targetColors.push_back({ 0.9f, 0.9f, 0.9f, 1 }); } },
+        { "removed target", [](MirrorFilterParams& p) { p.targetColors.pop_back(); } },
+    };
+    for (const auto& change : changes) {
+        SetTestContext(change.first);
+        MirrorFilterParams changed = params;
+        change.second(changed);
+        cache.Get(slot, changed, &built);
+        CHECK(built);
+        CHECK(cache.Get(slot, changed).lutKey == MakeMirrorMatchLutKey(changed.targetColors, changed.sensitivity, changed.gammaMode));
+        cache.Get(slot, params, &built); // Back to the original settings
+        CHECK(built);
+    }
+    SetTestContext("");
+
+    // Another mirror in the slot, or in another slot, starts from its own build
+    cache.Get({ 3, 2 }, params, &built);
+    CHECK(built);
+    cache.Get({ 4, 1 }, params, &built);
+    CHECK(built);
+    cache.Get({ 4, 1 }, params, &built);
+    CHECK(!built);
+}
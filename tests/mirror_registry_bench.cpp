@@ -0,0 +1,105 @@
+// ============================================================================
+// MIRROR_REGISTRY_BENCH.CPP - Per-frame mirror bookkeeping: name map vs slot map
+// ============================================================================
+// Each capture frame the mirror thread resolves every published config to its instance and then walks
+// all instances to swap the buffers of those that captured. Before mirror_registry.h both steps went
+// through an unordered_map keyed by mirror name; now configs carry a MirrorHandle and the walk is over
+// dense slots. Both variants run here on a stand-in instance of MirrorInstance's size, at 10, 50 and 200
+// mirrors with realistic names.
+// ============================================================================
+
+#include "bench_common.h"
+#include "mirror_registry.h"
+
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// Roughly MirrorInstance: a few hundred bytes of GL names, sizes, flags and cached render state
+struct FakeInstance {
+    uint32_t textures[8] = {};
+    int sizes[8] = {};
+    bool captureReady = false;
+    bool hasValidContent = false;
+    uint64_t frames = 0;
+    char cachedRenderState[256] = {};
+};
+
+struct FakeConfig {
+    std::string name;
+    MirrorHandle handle;
+};
+
+std::string MirrorName(int i) {
+    static const char* kinds[] = { "Pie Chart", "F3 Entity Counter", "Piechart Filter", "Mapless", "Compass", "Eye Measure" };
+    return kinds[i % 6] + std::string(" ") + std::to_string(i);
+}
+
+// One frame on the name-keyed map: look up each config, mark it captured, then swap every captured instance
+uint64_t FrameByName(std::unordered_map<std::string, FakeInstance>& instances, const std::vector<FakeConfig>& configs) {
+    uint64_t touched = 0;
+    for (const FakeConfig& conf : configs) {
+        auto it = instances.find(conf.name);
+        if (it == instances.end()) continue;
+        it->second.captureReady = true;
+        it->second.frames++;
+    }
+    for (auto& [name, inst] : instances) {
+        if (!inst.captureReady) continue;
+        inst.captureReady = false;
+        inst.hasValidContent = true;
+        std::swap(inst.textures[0], inst.textures[1]);
+        touched += inst.frames;
+    }
+    return touched;
+}
+
+// The same frame through handles and slot iteration
+uint64_t FrameByHandle(MirrorSlotMap<FakeInstance>& instances, const std::vector<FakeConfig>& configs) {
+    uint64_t touched = 0;
+    for (const FakeConfig& conf : configs) {
+        FakeInstance* inst = instances.Get(conf.handle);
+        if (!inst) continue;
+        inst->captureReady = true;
+        inst->frames++;
+    }
+    for (auto& [name, inst] : instances) {
+        if (!inst.captureReady) continue;
+        inst.captureReady = false;
+        inst.hasValidContent = true;
+        std::swap(inst.textures[0], inst.textures[1]);
+        touched += inst.frames;
+    }
+    return touched;
+}
+
+} // namespace
+
+int main() {
+    printf("%8s %16s %16s %8s\n", "mirrors", "by name ns/frame", "slots ns/frame", "speedup");
+    for (int count : { 10, 50, 200 }) {
+        std::unordered_map<std::string, FakeInstance> byName;
+        MirrorSlotMap<FakeInstance> slots;
+        std::vector<FakeConfig> configs;
+        for (int i = 0; i < count; i++) {
+            const std::string name = MirrorName(i);
+            byName[name] = FakeInstance{};
+            slots[name] = FakeInstance{};
+            configs.push_back({ name, slots.HandleOf(name) });
+        }
+        // Some churn first so slots are reused, as after renaming and deleting mirrors in the GUI
+        for (int i = 0; i < count; i += 7) {
+            slots.erase(configs[i].name);
+            slots[configs[i].name] = FakeInstance{};
+            configs[i].handle = slots.HandleOf(configs[i].name);
+        }
+
+        const double nameNs = BenchNsPerCall([&] { BenchKeep(FrameByName(byName, configs)); });
+        const double slotNs = BenchNsPerCall([&] { BenchKeep(FrameByHandle(slots, configs)); });
+        printf("%8d %16.0f %16.0f %7.1fx\n", count, nameNs, slotNs, nameNs / slotNs);
+    }
+    return 0;
+}
@@ -0,0 +1,186 @@
+// ============================================================================
+// MIRROR_SCHEDULER_TEST.CPP - FPS-capped mirror scheduling on a fake clock
+// ============================================================================
+// MirrorUpdateScheduler only depends on the time points passed in, so the capture thread's frame loop is
+// replayed here with synthetic frame times: IsDue() once per mirror per frame, MarkUpdated() when due.
+// ============================================================================
+
+#include "mirror_scheduler.h"
+#include "test_common.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using TimePoint = MirrorUpdateScheduler::TimePoint;
+
+// Start well away from the epoch so negative offsets are never needed
+constexpr int64_t START_NS = 1000000000000LL;
+constexpr int64_t FRAME_60HZ_NS = 1000000000LL / 60;
+
+TimePoint At(int64_t ns) { return TimePoint(std::chrono::duration_cast<TimePoint::duration>(std::chrono::nanoseconds(ns))); }
+
+MirrorHandle Slot(uint32_t index, uint32_t generation = 0) { return { index, generation }; }
+
+// Replays `frames` game frames; returns, per mirror, the frame numbers it was updated on
+std::vector<std::vector<int>> Replay(MirrorUpdateScheduler& scheduler, const std::vector<int>& fps, int frames, int64_t frameNs,
+                                     int64_t jitterNs = 0, uint32_t seed = 1) {
+    std::vector<std::vector<int>> updates(fps.size());
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int64_t> jitter(-jitterNs, jitterNs);
+    for (int f = 0; f < frames; f++) {
+        const TimePoint now = At(START_NS + f * frameNs + (jitterNs ? jitter(rng) : 0));
+        for (size_t m = 0; m < fps.size(); m++) {
+            if (!scheduler.IsDue(Slot(static_cast<uint32_t>(m)), fps[m], now)) continue;
+            scheduler.MarkUpdated(Slot(static_cast<uint32_t>(m)), now);
+            updates[m].push_back(f);
+        }
+    }
+    return updates;
+}
+
+} // namespace
+
+TEST_CASE(UncappedMirrorsAreAlwaysDue) {
+    MirrorUpdateScheduler scheduler;
+    for (int f = 0; f < 10; f++) {
+        CHECK(scheduler.IsDue(Slot(3), 0, At(START_NS + f * 1000)));
+        CHECK(scheduler.IsDue(Slot(4), -5, At(START_NS + f * 1000)));
+        scheduler.MarkUpdated(Slot(3), At(START_NS + f * 1000));
+    }
+}
+
+TEST_CASE(NewMirrorIsDueImmediately) {
+    MirrorUpdateScheduler scheduler;
+    for (uint32_t slot = 0; slot < 16; slot++) CHECK(scheduler.IsDue(Slot(slot), 1, At(START_NS)));
+}
+
+TEST_CASE(HalfRateMirrorUpdatesEveryOtherFrame) {
+    MirrorUpdateScheduler scheduler;
+    const auto updates = Replay(scheduler, { 30, 30, 30, 30 }, 600, FRAME_60HZ_NS);
+    for (size_t m = 0; m < updates.size(); m++) {
+        SetTestContext("mirror " + std::to_string(m));
+        CHECK_EQ(updates[m].front(), 0);
+        // After the immediate first update, the mirror settles onto its phase and then alternates exactly
+        for (size_t i = 2; i < updates[m].size(); i++) CHECK_EQ(updates[m][i] - updates[m][i - 1], 2);
+        CHECK(updates[m].size() >= 299u && updates[m].size() <= 301u);
+    }
+}
+
+TEST_CASE(QuantizationDoesNotStretchThePeriod) {
+    // 40 FPS on a 60 Hz game: "interval since last update" would only update every second frame (30 FPS).
+    // The fixed grid alternates gaps of one and two frames and keeps 40 updates per second.
+    MirrorUpdateScheduler scheduler;
+    const auto updates = Replay(scheduler, { 40, 45, 24 }, 60 * 10, FRAME_60HZ_NS);
+    CHECK(updates[0].size() >= 399u && updates[0].size() <= 401u);
+    CHECK(updates[1].size() >= 449u && updates[1].size() <= 451u);
+    CHECK(updates[2].size() >= 239u && updates[2].size() <= 241u);
+}
+
+TEST_CASE(FrameJitterDoesNotSkipDueTimes) {
+    // +-1 ms jitter on every frame: the slack keeps a 30 FPS mirror at 30 updates per second and never
+    // leaves it more than three frames without an update
+    MirrorUpdateScheduler scheduler;
+    std::vector<int> fps(8, 30);
+    const auto updates = Replay(scheduler, fps, 60 * 10, FRAME_60HZ_NS, 1000000, 58);
+    for (size_t m = 0; m < updates.size(); m++) {
+        SetTestContext("mirror " + std::to_string(m));
+        CHECK(updates[m].size() >= 298u && updates[m].size() <= 302u);
+        for (size_t i = 1; i < updates[m].size(); i++) CHECK(updates[m][i] - updates[m][i - 1] <= 3);
+    }
+}
+
+TEST_CASE(PhasesSpreadMirrorsWithTheSameCap) {
+    // 12 mirrors at 20 FPS on 60 Hz: each updates every third frame. Phase-less scheduling would put all 12 on
+    // the same frames; the phased grid keeps every frame close to the average of 4.
+    MirrorUpdateScheduler scheduler;
+    const int mirrors = 12, frames = 600;
+    const auto updates = Replay(scheduler, std::vector<int>(mirrors, 20), frames, FRAME_60HZ_NS);
+    std::vector<int> perFrame(frames, 0);
+    for (const auto& u : updates) {
+        for (int f : u) perFrame[f]++;
+    }
+    CHECK_EQ(perFrame[0], mirrors); // Everything is new on the first frame
+    const int maxLoad = *std::max_element(perFrame.begin() + 3, perFrame.end());
+    const int minLoad = *std::min_element(perFrame.begin() + 3, perFrame.end());
+    CHECK(maxLoad <= 6);
+    CHECK(minLoad >= 2);
+}
+
+TEST_CASE(PhaseFractionsAreDistinctAndInRange) {
+    std::vector<double> phases;
+    for (uint32_t i = 0; i < 64; i++) {
+        const double p = MirrorUpdateScheduler::PhaseFraction(i);
+        CHECK(p >= 0.0 && p < 1.0);
+        phases.push_back(p);
+    }
+    std::sort(phases.begin(), phases.end());
+    // Golden-ratio sequence: the largest gap between neighbours stays within a small factor of 1/n
+    double maxGap = 1.0 - phases.back() + phases.front();
+    for (size_t i = 1; i < phases.size(); i++) maxGap = (std::max)(maxGap, phases[i] - phases[i - 1]);
+    CHECK(maxGap < 3.0 / 64);
+}
+
+TEST_CASE(RaisedCapIsDueNowLoweredCapWaitsForTheNewGrid) {
+    MirrorUpdateScheduler scheduler;
+    const MirrorHandle h = Slot(5);
+    const int64_t ms = 1000000;
+    int64_t t = START_NS;
+    scheduler.MarkUpdated(h, At(t)); // Unknown handle: no-op
+    CHECK(scheduler.IsDue(h, 10, At(t)));
+    scheduler.MarkUpdated(h, At(t));
+    do t += ms; while (!scheduler.IsDue(h, 10, At(t)));
+    scheduler.MarkUpdated(h, At(t)); // Now on the 100 ms grid
+
+    t += 50 * ms;
+    CHECK(!scheduler.IsDue(h, 10, At(t)));
+    CHECK(scheduler.IsDue(h, 30, At(t))); // Raised: show the faster rate right away
+    scheduler.MarkUpdated(h, At(t));
+
+    // Lowered: not due now, but on the next point of the 200 ms grid after the last update
+    const int64_t lastUpdate = t;
+    CHECK(!scheduler.IsDue(h, 5, At(t)));
+    do t += ms; while (!scheduler.IsDue(h, 5, At(t)));
+    CHECK(t - lastUpdate <= 200 * ms);
+}
+
+TEST_CASE(ReusedSlotStartsFresh) {
+    MirrorUpdateScheduler scheduler;
+    CHECK(scheduler.IsDue(Slot(2, 0), 1, At(START_NS)));
+    scheduler.MarkUpdated(Slot(2, 0), At(START_NS));
+    CHECK(!scheduler.IsDue(Slot(2, 0), 1, At(START_NS + 100000000)));
+    // The slot was released and reused by another mirror: its generation changed, so it is new
+    CHECK(scheduler.IsDue(Slot(2, 1), 1, At(START_NS + 100000000)));
+    scheduler.Clear();
+    CHECK(scheduler.IsDue(Slot(2, 1), 1, At(START_NS + 200000000)));
+}
+
+TEST_CASE(StallsDoNotCauseCatchUpBursts) {
+    // After a 500 ms game stall a 30 FPS mirror updates once and then continues on its grid
+    MirrorUpdateScheduler scheduler;
+    const MirrorHandle h = Slot(1);
+    std::vector<int64_t> updateTimes;
+    auto frame = [&](int64_t t) {
+        if (scheduler.IsDue(h, 30, At(t))) {
+            scheduler.MarkUpdated(h, At(t));
+            updateTimes.push_back(t);
+        }
+    };
+    int64_t t = START_NS;
+    for (int f = 0; f < 60; f++, t += FRAME_60HZ_NS) frame(t);
+    t += 500 * 1000000;
+    const size_t before = updateTimes.size();
+    frame(t);
+    CHECK_EQ(updateTimes.size(), before + 1);
+    frame(t + FRAME_60HZ_NS);
+    CHECK_EQ(updateTimes.size(), before + 1);
+}
+
+TEST_CASE(SameInputsGiveTheSameSchedule) {
+    MirrorUpdateScheduler a, b;
+    const std::vector<int> fps = { 30, 20, 45, 0, 15, 60, 24 };
+    CHECK(Replay(a, fps, 300, FRAME_60HZ_NS, 800000, 9) == Replay(b, fps, 300, FRAME_60HZ_NS, 800000, 9));
+}
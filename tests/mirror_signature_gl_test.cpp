@@ -0,0 +1,132 @@
+// ============================================================================
+// MIRROR_SIGNATURE_GL_TEST.CPP - Signature reduction shader vs ComputeMirrorSignatureCells on llvmpipe
+// ============================================================================
+// The capture thread hashes input regions on the GPU (mt_signature_frag_shader) and the CPU fallback with
+// ComputeMirrorSignatureCells; a mirror is skipped when the hash matches the last capture's, so both must
+// produce the same cells. The regions are drawn here the way MT_ComputeRegionSignatures draws them: one
+// GRID x GRID viewport per region into an R32UI target, MT_SIGNATURE_COLUMNS regions per row.
+// ============================================================================
+
+#include "gl_test_context.h"
+#include "mirror_shaders.h"
+#include "mirror_signature.h"
+#include "test_common.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int GAME_W = 640;
+constexpr int GAME_H = 360;
+constexpr int COLUMNS = 64; // MT_SIGNATURE_COLUMNS
+
+std::vector<uint32_t> GpuCells(const std::vector<CaptureRect>& rects, GLuint gameTexture) {
+    static GLuint s_program = 0, s_vao = 0, s_vbo = 0;
+    if (!s_program) {
+        s_program = BuildTestProgram(mt_passthrough_vert_shader, mt_signature_frag_shader);
+        static const float verts[] = { -1, -1, 0, 0, 1, -1, 1, 0, 1, 1, 1, 1, -1, -1, 0, 0, 1, 1, 1, 1, -1, 1, 0, 1 };
+        glGenVertexArrays(1, &s_vao);
+        glGenBuffers(1, &s_vbo);
+        glBindVertexArray(s_vao);
+        glBindBuffer(GL_ARRAY_BUFFER, s_vbo);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+        glEnableVertexAttribArray(1);
+    }
+
+    const int count = static_cast<int>(rects.size());
+    const int texW = (std::min)(count, COLUMNS) * MIRROR_SIGNATURE_GRID;
+    const int texH = ((count + COLUMNS - 1) / COLUMNS) * MIRROR_SIGNATURE_GRID;
+    GLuint target = 0, fbo = 0;
+    glGenTextures(1, &target);
+    glBindTexture(GL_TEXTURE_2D, target);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, texW, texH, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target, 0);
+    REQUIRE(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+
+    glDisable(GL_BLEND);
+    glUseProgram(s_program);
+    glUniform1i(glGetUniformLocation(s_program, "screenTexture"), 0);
+    glUniform2i(glGetUniformLocation(s_program, "u_gameSize"), GAME_W, GAME_H);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, gameTexture);
+    glBindVertexArray(s_vao);
+    for (int i = 0; i < count; i++) {
+        const CaptureRect& r = rects[i];
+        const int cellX = (i % COLUMNS) * MIRROR_SIGNATURE_GRID, cellY = (i / COLUMNS) * MIRROR_SIGNATURE_GRID;
+        glViewport(cellX, cellY, MIRROR_SIGNATURE_GRID, MIRROR_SIGNATURE_GRID);
+        glUniform4i(glGetUniformLocation(s_program, "u_region"), r.x, r.y, r.w, r.h);
+        glUniform2i(glGetUniformLocation(s_program, "u_cellOrigin"), cellX, cellY);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+    }
+
+    std::vector<uint32_t> readback(static_cast<size_t>(texW) * texH);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, texW, texH, GL_RED_INTEGER, GL_UNSIGNED_INT, readback.data());
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &target);
+
+    std::vector<uint32_t> cells(static_cast<size_t>(count) * MIRROR_SIGNATURE_CELLS);
+    for (int i = 0; i < count; i++) {
+        const int cellX = (i % COLUMNS) * MIRROR_SIGNATURE_GRID, cellY = (i / COLUMNS) * MIRROR_SIGNATURE_GRID;
+        for (int cy = 0; cy < MIRROR_SIGNATURE_GRID; cy++) {
+            for (int cx = 0; cx < MIRROR_SIGNATURE_GRID; cx++) {
+                cells[static_cast<size_t>(i) * MIRROR_SIGNATURE_CELLS + cy * MIRROR_SIGNATURE_GRID + cx] =
+                    readback[static_cast<size_t>(cellY + cy) * texW + cellX + cx];
+            }
+        }
+    }
+    return cells;
+}
+
+void CompareWithCpu(const std::vector<CaptureRect>& rects, uint32_t seed) {
+    RequireGLContext();
+    std::vector<uint8_t> frame(static_cast<size_t>(GAME_W) * GAME_H * 4);
+    std::mt19937 rng(seed);
+    for (uint8_t& b : frame) b = static_cast<uint8_t>(rng());
+    const GLuint gameTexture = CreateTestTexture(GAME_W, GAME_H, frame.data());
+
+    const std::vector<uint32_t> gpu = GpuCells(rects, gameTexture);
+    MirrorFilterSource src;
+    src.pixels = frame.data();
+    src.width = GAME_W;
+    src.height = GAME_H;
+    for (size_t i = 0; i < rects.size(); i++) {
+        const CaptureRect& r = rects[i];
+        SetTestContext("region " + std::to_string(i) + " (" + std::to_string(r.x) + "," + std::to_string(r.y) + " " + std::to_string(r.w) + "x" +
+                       std::to_string(r.h) + ")");
+        uint32_t cpu[MIRROR_SIGNATURE_CELLS];
+        ComputeMirrorSignatureCells(src, GAME_W, GAME_H, r, cpu);
+        int mismatches = 0;
+        for (int c = 0; c < MIRROR_SIGNATURE_CELLS; c++) mismatches += cpu[c] != gpu[i * MIRROR_SIGNATURE_CELLS + c];
+        CHECK_EQ(mismatches, 0);
+    }
+    glDeleteTextures(1, &gameTexture);
+}
+
+} // namespace
+
+TEST_CASE(ShaderMatchesCpuOnTypicalRegions) {
+    CompareWithCpu({ { 0, 0, GAME_W, GAME_H }, { 100, 50, 64, 64 }, { 13, 27, 5, 3 }, { 200, 100, 129, 77 }, { 639, 359, 1, 1 }, { 300, 10, 8, 200 } }, 60);
+}
+
+TEST_CASE(ShaderMatchesCpuPastTheFrameEdges) {
+    CompareWithCpu({ { -20, 40, 64, 64 }, { 600, 330, 90, 50 }, { 320, -15, 33, 40 }, { -8, -8, 700, 380 } }, 61);
+}
+
+TEST_CASE(ShaderMatchesCpuAcrossSignatureRows) {
+    // More regions than one row of the signature texture holds
+    std::vector<CaptureRect> rects;
+    for (int i = 0; i < 150; i++) rects.push_back({ (i * 37) % 600, (i * 23) % 320, 1 + (i * 7) % 60, 1 + (i * 11) % 40 });
+    CompareWithCpu(rects, 62);
+}
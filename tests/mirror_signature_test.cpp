@@ -0,0 +1,205 @@
+// ============================================================================
+// MIRROR_SIGNATURE_TEST.CPP - Input signature cells, mixing and the signature cache
+// ============================================================================
+// Skipping a mirror is only safe if every pixel of its input regions reaches the signature, so the cell
+// layout is checked pixel by pixel: changing any one pixel must change exactly the cell that covers it.
+// ============================================================================
+
+#include "mirror_signature.h"
+#include "test_common.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Frame {
+    int w = 0, h = 0;
+    std::vector<uint8_t> rgba;
+
+    MirrorFilterSource Source() const {
+        MirrorFilterSource src;
+        src.pixels = rgba.data();
+        src.width = w;
+        src.height = h;
+        return src;
+    }
+    uint8_t* At(int x, int y) { return &rgba[(static_cast<size_t>(y) * w + x) * 4]; }
+};
+
+Frame RandomFrame(int w, int h, uint32_t seed) {
+    Frame f{ w, h, std::vector<uint8_t>(static_cast<size_t>(w) * h * 4) };
+    std::mt19937 rng(seed);
+    for (uint8_t& b : f.rgba) b = static_cast<uint8_t>(rng());
+    return f;
+}
+
+std::vector<uint32_t> Cells(const MirrorFilterSource& src, int gameW, int gameH, const CaptureRect& rect) {
+    std::vector<uint32_t> cells(MIRROR_SIGNATURE_CELLS);
+    ComputeMirrorSignatureCells(src, gameW, gameH, rect, cells.data());
+    return cells;
+}
+
+// The cell of `rect` that covers game pixel (x, y), per the documented block layout
+int CellOf(const CaptureRect& rect, int x, int y) {
+    const int blockW = (rect.w + MIRROR_SIGNATURE_GRID - 1) / MIRROR_SIGNATURE_GRID;
+    const int blockH = (rect.h + MIRROR_SIGNATURE_GRID - 1) / MIRROR_SIGNATURE_GRID;
+    return ((y - rect.y) / blockH) * MIRROR_SIGNATURE_GRID + (x - rect.x) / blockW;
+}
+
+} // namespace
+
+TEST_CASE(EveryPixelChangesExactlyItsCell) {
+    Frame frame = RandomFrame(96, 64, 60);
+    // Sizes below, at and above the grid, divisible and not
+    for (const CaptureRect rect : { CaptureRect{ 3, 5, 5, 3 }, CaptureRect{ 10, 7, 8, 8 }, CaptureRect{ 1, 2, 13, 10 }, CaptureRect{ 20, 9, 70, 33 } }) {
+        const std::vector<uint32_t> base = Cells(frame.Source(), frame.w, frame.h, rect);
+        for (int y = rect.y; y < rect.Top(); y++) {
+            for (int x = rect.x; x < rect.Right(); x++) {
+                SetTestContext("rect " + std::to_string(rect.w) + "x" + std::to_string(rect.h) + ", pixel " + std::to_string(x) + "," +
+                               std::to_string(y));
+                frame.At(x, y)[(x + y) % 4] ^= 1; // Any channel, alpha included
+                const std::vector<uint32_t> changed = Cells(frame.Source(), frame.w, frame.h, rect);
+                frame.At(x, y)[(x + y) % 4] ^= 1;
+                int differing = 0;
+                for (int c = 0; c < MIRROR_SIGNATURE_CELLS; c++) differing += changed[c] != base[c];
+                CHECK_EQ(differing, 1);
+                CHECK(changed[CellOf(rect, x, y)] != base[CellOf(rect, x, y)]);
+            }
+        }
+        // Pixels outside the region do not contribute
+        frame.At(rect.Right() % frame.w, rect.y)[0] ^= 0xFF;
+        CHECK(Cells(frame.Source(), frame.w, frame.h, rect) == base);
+        frame.At(rect.Right() % frame.w, rect.y)[0] ^= 0xFF;
+    }
+}
+
+TEST_CASE(CellsHashRowsBottomUpInFnvOrder) {
+    Frame frame = RandomFrame(16, 16, 7);
+    // 2x2 region: blockW = blockH = 1, so cells (0,0), (1,0), (0,1), (1,1) hold one pixel each and the rest only seeds
+    const CaptureRect rect{ 4, 6, 2, 2 };
+    const std::vector<uint32_t> cells = Cells(frame.Source(), frame.w, frame.h, rect);
+    auto word = [&](int x, int y) {
+        uint32_t v;
+        std::memcpy(&v, frame.At(x, y), 4);
+        return v;
+    };
+    CHECK_EQ(cells[0], MirrorSignatureHashPixel(MirrorSignatureCellSeed(0), word(4, 6)));
+    CHECK_EQ(cells[1], MirrorSignatureHashPixel(MirrorSignatureCellSeed(1), word(5, 6)));
+    CHECK_EQ(cells[MIRROR_SIGNATURE_GRID], MirrorSignatureHashPixel(MirrorSignatureCellSeed(MIRROR_SIGNATURE_GRID), word(4, 7)));
+    for (int c = 0; c < MIRROR_SIGNATURE_CELLS; c++) {
+        if (c % MIRROR_SIGNATURE_GRID >= 2 || c / MIRROR_SIGNATURE_GRID >= 2) CHECK_EQ(cells[c], MirrorSignatureCellSeed(c));
+    }
+
+    // 16x1 region: blockW = 2, cell 0 hashes (0,0) then (1,0)
+    const std::vector<uint32_t> row = Cells(frame.Source(), frame.w, frame.h, CaptureRect{ 0, 0, 16, 1 });
+    CHECK_EQ(row[0], MirrorSignatureHashPixel(MirrorSignatureHashPixel(MirrorSignatureCellSeed(0), word(0, 0)), word(1, 0)));
+    // 1x16 region: blockH = 2, cell 0 hashes the bottom row first
+    const std::vector<uint32_t> col = Cells(frame.Source(), frame.w, frame.h, CaptureRect{ 0, 0, 1, 16 });
+    CHECK_EQ(col[0], MirrorSignatureHashPixel(MirrorSignatureHashPixel(MirrorSignatureCellSeed(0), word(0, 0)), word(0, 1)));
+}
+
+TEST_CASE(SamplesOutsideTheFrameClampToItsEdges) {
+    const Frame frame = RandomFrame(32, 24, 11);
+    // A region hanging off the bottom-left corner hashes the same pixels as an explicit edge-replicated copy
+    const CaptureRect rect{ -5, -3, 16, 12 };
+    Frame padded{ 16, 12, std::vector<uint8_t>(16 * 12 * 4) };
+    for (int y = 0; y < 12; y++) {
+        for (int x = 0; x < 16; x++) {
+            const int sx = std::clamp(x - 5, 0, frame.w - 1), sy = std::clamp(y - 3, 0, frame.h - 1);
+            std::memcpy(padded.At(x, y), &frame.rgba[(static_cast<size_t>(sy) * frame.w + sx) * 4], 4);
+        }
+    }
+    CHECK(Cells(frame.Source(), frame.w, frame.h, rect) == Cells(padded.Source(), 16, 12, CaptureRect{ 0, 0, 16, 12 }));
+
+    // Past the top-right corner as well
+    const CaptureRect topRight{ 28, 20, 9, 9 };
+    Frame corner{ 9, 9, std::vector<uint8_t>(9 * 9 * 4) };
+    for (int y = 0; y < 9; y++) {
+        for (int x = 0; x < 9; x++) {
+            const int sx = std::clamp(28 + x, 0, frame.w - 1), sy = std::clamp(20 + y, 0, frame.h - 1);
+            std::memcpy(corner.At(x, y), &frame.rgba[(static_cast<size_t>(sy) * frame.w + sx) * 4], 4);
+        }
+    }
+    CHECK(Cells(frame.Source(), frame.w, frame.h, topRight) == Cells(corner.Source(), 9, 9, CaptureRect{ 0, 0, 9, 9 }));
+}
+
+TEST_CASE(WindowedAndStridedSourcesHashLikeTheFullFrame) {
+    const Frame frame = RandomFrame(64, 48, 23);
+    const CaptureRect rect{ 20, 10, 30, 25 };
+    const std::vector<uint32_t> full = Cells(frame.Source(), frame.w, frame.h, rect);
+
+    // The CPU fallback reads back only a window around the regions, with its own origin and row stride
+    const int ox = 18, oy = 8, ww = 40, wh = 30, stride = ww * 4 + 16;
+    std::vector<uint8_t> window(static_cast<size_t>(stride) * wh, 0xAB);
+    for (int y = 0; y < wh; y++) std::memcpy(&window[static_cast<size_t>(y) * stride], &frame.rgba[(static_cast<size_t>(oy + y) * frame.w + ox) * 4], ww * 4);
+    MirrorFilterSource src;
+    src.pixels = window.data();
+    src.width = ww;
+    src.height = wh;
+    src.stride = stride;
+    src.originX = ox;
+    src.originY = oy;
+    CHECK(Cells(src, frame.w, frame.h, rect) == full);
+}
+
+TEST_CASE(NullSourceHashesSeedsOnly) {
+    const std::vector<uint32_t> cells = Cells(MirrorFilterSource{}, 64, 64, CaptureRect{ 0, 0, 32, 32 });
+    for (int c = 0; c < MIRROR_SIGNATURE_CELLS; c++) CHECK_EQ(cells[c], MirrorSignatureCellSeed(c));
+}
+
+TEST_CASE(MixingIsOrderSensitive) {
+    const uint32_t a[] = { 1, 2, 3 }, b[] = { 3, 2, 1 };
+    CHECK(MirrorSignatureMixCells(MIRROR_SIGNATURE_BASIS, a, 3) != MirrorSignatureMixCells(MIRROR_SIGNATURE_BASIS, b, 3));
+    CHECK_EQ(MirrorSignatureMixCells(MIRROR_SIGNATURE_BASIS, a, 3),
+             MirrorSignatureMix(MirrorSignatureMix(MirrorSignatureMix(MIRROR_SIGNATURE_BASIS, 1), 2), 3));
+    CHECK_EQ(MirrorSignatureMixCells(42, a, 0), 42u);
+}
+
+TEST_CASE(CacheMatchesOnlyTheStoredSignatureOfTheSameSlot) {
+    MirrorSignatureCache cache;
+    const MirrorHandle h{ 3, 1 };
+    CHECK(!cache.Matches(h, 0)); // Never stored, even for a zero signature
+    cache.Store(h, 99);
+    CHECK(cache.Matches(h, 99));
+    CHECK(!cache.Matches(h, 98));
+    CHECK(!cache.Matches(MirrorHandle{ 3, 2 }, 99)); // Slot reused by another mirror
+    CHECK(!cache.Matches(MirrorHandle{ 2, 1 }, 99));
+    cache.Invalidate(h);
+    CHECK(!cache.Matches(h, 99));
+    cache.Store(h, 99);
+    cache.Store(MirrorHandle{}, 99); // Invalid handles are ignored
+    cache.Clear();
+    CHECK(!cache.Matches(h, 99));
+}
+
+TEST_CASE(CacheBacksOffAfterAMissStreakAndRecoversOnAHit) {
+    MirrorSignatureCache cache;
+    for (int f = 0; f < MirrorSignatureCache::BACKOFF_AFTER_FRAMES; f++) {
+        CHECK(cache.BeginFrame());
+        cache.EndFrame(4, 0);
+    }
+    CHECK(cache.IsBackedOff());
+
+    // Backed off: one probe every BACKOFF_INTERVAL frames; frames without a probe do not change the streak
+    int probes = 0;
+    for (int f = 0; f < MirrorSignatureCache::BACKOFF_INTERVAL * 4; f++) {
+        if (cache.BeginFrame()) {
+            probes++;
+            cache.EndFrame(4, 0);
+        } else {
+            cache.EndFrame(0, 0);
+        }
+    }
+    CHECK_EQ(probes, 4);
+    CHECK(cache.IsBackedOff());
+
+    while (!cache.BeginFrame()) cache.EndFrame(0, 0);
+    cache.EndFrame(4, 1);
+    CHECK(!cache.IsBackedOff());
+    CHECK(cache.BeginFrame());
+    CHECK(cache.BeginFrame());
+}
@@ -0,0 +1,110 @@
+// ============================================================================
+// MODE_IDS_TEST.CPP - Mode ID interning
+// ============================================================================
+// The intern table is process-global and handles are never reused, so the cases below run in order on
+// one table: round-trips first, then concurrent lookups, then filling the table to its limit.
+// ============================================================================
+
+#include "gui.h"
+#include "mode_ids.h"
+#include "test_common.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t CHUNK_SIZE = 256;      // mode_ids.cpp
+constexpr uint32_t CAPACITY = 64 * 256;   // MAX_CHUNKS * CHUNK_SIZE, handle 0 included
+
+} // namespace
+
+TEST_CASE(EmptyIdIsTheNoneHandle) {
+    CHECK_EQ(InternModeId(""), MODE_ID_NONE);
+    CHECK(ModeIdName(MODE_ID_NONE).empty());
+    CHECK(ModeIdName(123456).empty()); // Never assigned
+}
+
+TEST_CASE(HandlesRoundTripAcrossChunkBoundaries) {
+    // Enough IDs to fill the first chunk and spill well into the second and third
+    std::vector<ModeIdHandle> handles;
+    for (uint32_t i = 0; i < CHUNK_SIZE * 2 + 10; i++) handles.push_back(InternModeId("mode " + std::to_string(i)));
+    for (size_t i = 0; i < handles.size(); i++) {
+        SetTestContext("mode " + std::to_string(i));
+        CHECK(handles[i] != MODE_ID_NONE);
+        if (i > 0) CHECK_EQ(handles[i], handles[i - 1] + 1); // Assigned densely, so the IDs straddle both boundaries
+        CHECK_EQ(ModeIdName(handles[i]), "mode " + std::to_string(i));
+        CHECK_EQ(InternModeId("mode " + std::to_string(i)), handles[i]); // Same ID, same handle
+    }
+    SetTestContext("");
+    CHECK(handles.front() < CHUNK_SIZE && handles.back() >= 2 * CHUNK_SIZE);
+
+    // Exact, case-sensitive matching
+    const ModeIdHandle lower = InternModeId("thin");
+    CHECK(InternModeId("Thin") != lower);
+    CHECK(InternModeId("thin ") != lower);
+    CHECK_EQ(ModeIdName(lower), "thin");
+}
+
+TEST_CASE(CachedHandleIsUsedOnlyWhileItMatchesTheId) {
+    ModeConfig mode;
+    mode.id = "Wide";
+    mode.internId = InternModeId("Wide");
+    CHECK_EQ(GetModeIdHandle(mode), mode.internId);
+
+    mode.id = "Wide (renamed)"; // Edited since the last publish: the cached handle is stale
+    const ModeIdHandle renamed = GetModeIdHandle(mode);
+    CHECK(renamed != mode.internId);
+    CHECK_EQ(ModeIdName(renamed), "Wide (renamed)");
+
+    ModeConfig fresh; // Never published: internId is still MODE_ID_NONE
+    fresh.id = "Wide";
+    CHECK_EQ(GetModeIdHandle(fresh), InternModeId("Wide"));
+}
+
+TEST_CASE(NamesCanBeReadWhileIdsAreInterned) {
+    // Readers resolve every handle they have seen published while the writer keeps adding chunks
+    const ModeIdHandle first = InternModeId("concurrent 0");
+    std::atomic<ModeIdHandle> published{ first };
+    std::atomic<bool> done{ false };
+    std::atomic<int> mismatches{ 0 };
+    std::thread reader([&] {
+        while (!done.load(std::memory_order_acquire)) {
+            const ModeIdHandle last = published.load(std::memory_order_acquire);
+            for (ModeIdHandle h = first; h <= last; h += 37) {
+                if (ModeIdName(h) != "concurrent " + std::to_string(h - first)) mismatches++;
+            }
+        }
+    });
+    for (uint32_t i = 1; i < CHUNK_SIZE * 4; i++) published.store(InternModeId("concurrent " + std::to_string(i)), std::memory_order_release);
+    done.store(true, std::memory_order_release);
+    reader.join();
+    CHECK_EQ(mismatches.load(), 0);
+}
+
+TEST_CASE(FullTableFallsBackToTheEmptyId) {
+    TakeTestLogMessages();
+    const ModeIdHandle early = InternModeId("mode 0");
+    uint32_t assigned = 0;
+    ModeIdHandle last = MODE_ID_NONE;
+    for (uint32_t i = 0; i < CAPACITY; i++) {
+        const ModeIdHandle h = InternModeId("filler " + std::to_string(i));
+        if (h == MODE_ID_NONE) break;
+        last = h;
+        assigned++;
+    }
+    CHECK_EQ(last, CAPACITY - 1); // Every handle up to the last entry of the last chunk was handed out
+    CHECK(assigned < CAPACITY);
+
+    // New IDs now map to the empty ID with a warning; known IDs and names keep working
+    CHECK_EQ(InternModeId("one too many"), MODE_ID_NONE);
+    const std::vector<std::string> log = TakeTestLogMessages();
+    REQUIRE(!log.empty());
+    CHECK(log.back().find("'one too many'") != std::string::npos);
+    CHECK_EQ(InternModeId("mode 0"), early);
+    CHECK_EQ(ModeIdName(early), "mode 0");
+    CHECK_EQ(ModeIdName(last), "filler " + std::to_string(assigned - 1));
+    CHECK(ModeIdName(CAPACITY).empty());
+}
@@ -0,0 +1,206 @@
+// ============================================================================
+// MODE_RENDER_LIST_BENCH.CPP - Per-frame overlay collection: by-name collect vs compiled lists
+// ============================================================================
+// A mode with 50 mirrors (25 direct, 25 through a relative-position group) and 50 images. "collect" is
+// the by-name resolution the render thread used to run per pass (RT_CollectActiveElements, reproduced
+// below with its per-snapshot lookup maps already built); "cached list" is the per-frame
+// ModeRenderListCache hit that replaced it; "compile" is the one-off cost when the snapshot, mode or
+// screen size changes. Outputs are checked to agree before timing.
+// ============================================================================
+
+#include "bench_common.h"
+#include "mode_render_list.h"
+#include "render.h"
+#include "utils.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Defined by render.cpp and utils.cpp in the DLL
+MirrorSlotMap<MirrorInstance> g_mirrorInstances;
+std::shared_mutex g_mirrorInstancesMutex;
+
+bool EqualsIgnoreCase(const std::string& a, const std::string& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (tolower(static_cast<unsigned char>(a[i])) != tolower(static_cast<unsigned char>(b[i]))) return false;
+    }
+    return true;
+}
+
+const ModeConfig* GetModeFromSnapshot(const Config& config, const std::string& id) {
+    for (const auto& mode : config.modes) {
+        if (EqualsIgnoreCase(mode.id, id)) return &mode;
+    }
+    return nullptr;
+}
+
+namespace {
+
+constexpr int SCREEN_W = 2560;
+constexpr int SCREEN_H = 1440;
+
+std::shared_ptr<const Config> MakeConfig() {
+    auto config = std::make_shared<Config>();
+    for (const char* id : { "Fullscreen", "Thin", "Wide", "EyeZoom" }) {
+        ModeConfig mode;
+        mode.id = id;
+        config->modes.push_back(mode);
+    }
+    ModeConfig& thin = config->modes[1];
+
+    MirrorGroupConfig group;
+    group.name = "pie group";
+    group.output.useRelativePosition = true;
+    group.output.relativeX = 0.7f;
+    group.output.relativeY = 0.2f;
+    for (int i = 0; i < 50; i++) {
+        MirrorConfig mirror;
+        mirror.name = "mirror " + std::to_string(i);
+        mirror.output.x = i * 13;
+        mirror.output.y = i * 7;
+        mirror.output.scale = 1.0f + (i % 4) * 0.5f;
+        mirror.colors.targetColors = { Color{ 0.9f, 0.1f, 0.1f, 1.0f } };
+        config->mirrors.push_back(mirror);
+        if (i < 25) {
+            thin.mirrorIds.push_back(mirror.name);
+        } else {
+            MirrorGroupItem item;
+            item.mirrorId = mirror.name;
+            item.offsetX = (i - 25) * 30;
+            item.widthPercent = i % 2 ? 0.5f : 1.0f;
+            group.mirrors.push_back(item);
+        }
+    }
+    config->mirrorGroups.push_back(group);
+    thin.mirrorGroupIds.push_back(group.name);
+
+    for (int i = 0; i < 50; i++) {
+        ImageConfig image;
+        image.name = "image " + std::to_string(i);
+        image.path = "C:/overlays/image" + std::to_string(i) + ".png";
+        image.x = i * 20;
+        config->images.push_back(image);
+        thin.imageIds.push_back(image.name);
+    }
+    return config;
+}
+
+// RT_CollectActiveElements before the compiled lists (lookup maps built once per snapshot, as it did)
+struct LegacyCollector {
+    const Config* cachedConfig = nullptr;
+    std::unordered_map<std::string, const ModeConfig*> modeById;
+    std::unordered_map<std::string, const MirrorConfig*> mirrorByName;
+    std::unordered_map<std::string, const MirrorGroupConfig*> groupByName;
+    std::unordered_map<std::string, const ImageConfig*> imageByName;
+
+    void Collect(const Config& config, const std::string& modeId, int screenW, int screenH, std::vector<MirrorConfig>& outMirrors,
+                 std::vector<ImageConfig>& outImages) {
+        outMirrors.clear();
+        outImages.clear();
+        if (cachedConfig != &config) {
+            cachedConfig = &config;
+            for (const auto& m : config.modes) modeById[m.id] = &m;
+            for (const auto& m : config.mirrors) mirrorByName[m.name] = &m;
+            for (const auto& g : config.mirrorGroups) groupByName[g.name] = &g;
+            for (const auto& img : config.images) imageByName[img.name] = &img;
+        }
+        auto modeIt = modeById.find(modeId);
+        if (modeIt == modeById.end()) return;
+        const ModeConfig& mode = *modeIt->second;
+        outMirrors.reserve(mode.mirrorIds.size() + mode.mirrorGroupIds.size());
+        outImages.reserve(mode.imageIds.size());
+        for (const auto& name : mode.mirrorIds) {
+            auto it = mirrorByName.find(name);
+            if (it != mirrorByName.end()) outMirrors.push_back(*it->second);
+        }
+        for (const auto& groupName : mode.mirrorGroupIds) {
+            auto git = groupByName.find(groupName);
+            if (git == groupByName.end()) continue;
+            const MirrorGroupConfig& group = *git->second;
+            for (const auto& item : group.mirrors) {
+                if (!item.enabled) continue;
+                auto mit = mirrorByName.find(item.mirrorId);
+                if (mit == mirrorByName.end()) continue;
+                const MirrorConfig& mirror = *mit->second;
+                MirrorConfig grouped = mirror;
+                int groupX = group.output.x, groupY = group.output.y;
+                if (group.output.useRelativePosition) {
+                    groupX = static_cast<int>(group.output.relativeX * screenW);
+                    groupY = static_cast<int>(group.output.relativeY * screenH);
+                }
+                grouped.output.x = groupX + item.offsetX;
+                grouped.output.y = groupY + item.offsetY;
+                grouped.output.relativeTo = group.output.relativeTo;
+                grouped.output.useRelativePosition = group.output.useRelativePosition;
+                grouped.output.relativeX = group.output.relativeX;
+                grouped.output.relativeY = group.output.relativeY;
+                if (item.widthPercent != 1.0f || item.heightPercent != 1.0f) {
+                    grouped.output.separateScale = true;
+                    const float baseScaleX = mirror.output.separateScale ? mirror.output.scaleX : mirror.output.scale;
+                    const float baseScaleY = mirror.output.separateScale ? mirror.output.scaleY : mirror.output.scale;
+                    grouped.output.scaleX = baseScaleX * item.widthPercent;
+                    grouped.output.scaleY = baseScaleY * item.heightPercent;
+                }
+                outMirrors.push_back(grouped);
+            }
+        }
+        for (const auto& name : mode.imageIds) {
+            auto it = imageByName.find(name);
+            if (it != imageByName.end()) outImages.push_back(*it->second);
+        }
+    }
+};
+
+bool SameMirrors(const std::vector<MirrorConfig>& a, const std::vector<MirrorConfig>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        const MirrorRenderConfig &x = a[i].output, &y = b[i].output;
+        if (a[i].name != b[i].name || x.x != y.x || x.y != y.y || x.separateScale != y.separateScale || x.scale != y.scale ||
+            x.scaleX != y.scaleX || x.scaleY != y.scaleY || x.useRelativePosition != y.useRelativePosition || x.relativeTo != y.relativeTo)
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    const std::shared_ptr<const Config> config = MakeConfig();
+    const ModeIdHandle thin = InternModeId("Thin");
+
+    LegacyCollector legacy;
+    std::vector<MirrorConfig> mirrors;
+    std::vector<ImageConfig> images;
+    legacy.Collect(*config, "Thin", SCREEN_W, SCREEN_H, mirrors, images);
+    const auto compiled = CompileModeRenderList(config, thin, SCREEN_W, SCREEN_H, true, true);
+    if (mirrors.size() != 50 || images.size() != 50 || !SameMirrors(mirrors, compiled->mirrors) || compiled->images.size() != images.size()) {
+        fprintf(stderr, "compiled list differs from the by-name collection\n");
+        return EXIT_FAILURE;
+    }
+
+    const double collect = BenchNsPerCall([&] {
+        legacy.Collect(*config, "Thin", SCREEN_W, SCREEN_H, mirrors, images);
+        BenchKeep(mirrors.size() + images.size());
+    });
+
+    ModeRenderListCache cache;
+    const double cached = BenchNsPerCall([&] {
+        const auto list = cache.Get(config, thin, SCREEN_W, SCREEN_H, true, true);
+        BenchKeep(list->mirrors.size() + list->images.size());
+    });
+
+    const double compile = BenchNsPerCall([&] {
+        const auto list = CompileModeRenderList(config, thin, SCREEN_W, SCREEN_H, true, true);
+        BenchKeep(list->mirrors.size() + list->images.size());
+    });
+
+    printf("50 mirrors (25 grouped), 50 images\n");
+    printf("  %-30s %10.3f us\n", "collect by name, per pass", collect / 1e3);
+    printf("  %-30s %10.3f us\n", "cached list, per pass", cached / 1e3);
+    printf("  %-30s %10.3f us\n", "compile on change", compile / 1e3);
+    return 0;
+}
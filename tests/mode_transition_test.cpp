@@ -0,0 +1,238 @@
+// ============================================================================
+// MODE_TRANSITION_TEST.CPP - EvaluateModeTransition stepped on a fake clock
+// ============================================================================
+// Every timestamp is the descriptor's start time plus a chosen offset, so the start, the edges of the
+// movement and bounce phases and the end can be hit exactly. Expected geometry is computed from the closed
+// form easing and bounce functions in easing_curve.h. Bounce expectations are allowed one pixel because the
+// test's bounce phase is computed in a different float order than EvaluateModeTransition's.
+// ============================================================================
+
+#include "easing_curve.h"
+#include "mode_transition.h"
+#include "test_common.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+namespace {
+
+const TransitionClock::time_point START = TransitionClock::time_point{} + std::chrono::hours(1);
+
+TransitionClock::time_point At(double seconds) {
+    return START + std::chrono::duration_cast<TransitionClock::duration>(std::chrono::duration<double>(seconds));
+}
+
+// Fullscreen to a thin centered mode, 0.3 s move and two 150 ms bounces: 0.6 s in total
+ModeTransitionDescriptor BounceTransition() {
+    ModeTransitionDescriptor desc;
+    desc.startTime = START;
+    desc.duration = 0.3f;
+    desc.animateGame = true;
+    desc.easeInPower = 1.0f;
+    desc.easeOutPower = 3.0f;
+    desc.bounceCount = 2;
+    desc.bounceIntensity = 0.15f;
+    desc.bounceDurationMs = 150;
+    desc.fromModeId = "Fullscreen";
+    desc.fromWidth = 1920;
+    desc.fromHeight = 1080;
+    desc.toModeId = "Thin";
+    desc.toWidth = 300;
+    desc.toHeight = 800;
+    desc.toX = 810;
+    desc.toY = 140;
+    return desc;
+}
+
+int Lerp(int from, int to, float t) { return from == to ? to : static_cast<int>(from + (to - from) * t); }
+
+void CheckGeometry(const ModeTransitionFrame& f, int width, int height, int x, int y, int tolerance = 0) {
+    CHECK(std::abs(f.width - width) <= tolerance);
+    CHECK(std::abs(f.height - height) <= tolerance);
+    CHECK(std::abs(f.x - x) <= tolerance);
+    CHECK(std::abs(f.y - y) <= tolerance);
+}
+
+void CheckAtTarget(const ModeTransitionDescriptor& desc, const ModeTransitionFrame& f) {
+    CheckGeometry(f, desc.toWidth, desc.toHeight, desc.toX, desc.toY);
+}
+
+// Geometry during a bounce with the given closed-form offset
+void CheckBounce(const ModeTransitionDescriptor& d, const ModeTransitionFrame& f, float offset) {
+    CheckGeometry(f, d.toWidth - static_cast<int>((d.toWidth - d.fromWidth) * offset), d.toHeight - static_cast<int>((d.toHeight - d.fromHeight) * offset),
+                  d.toX - static_cast<int>((d.toX - d.fromX) * offset), d.toY - static_cast<int>((d.toY - d.fromY) * offset), 1);
+}
+
+} // namespace
+
+TEST_CASE(TotalDurationIncludesBounces) {
+    ModeTransitionDescriptor desc = BounceTransition();
+    CHECK_NEAR(ModeTransitionTotalDuration(desc), 0.6f, 1e-6f);
+    desc.bounceCount = 5;
+    desc.bounceDurationMs = 40;
+    CHECK_NEAR(ModeTransitionTotalDuration(desc), 0.5f, 1e-6f);
+    desc.bounceCount = 0;
+    CHECK_NEAR(ModeTransitionTotalDuration(desc), 0.3f, 1e-6f);
+    desc.bounceCount = -1;
+    CHECK_NEAR(ModeTransitionTotalDuration(desc), 0.3f, 1e-6f);
+}
+
+TEST_CASE(StartsAtTheSourceGeometry) {
+    const ModeTransitionDescriptor desc = BounceTransition();
+    const ModeTransitionFrame f = EvaluateModeTransition(desc, START);
+    CHECK(!f.complete);
+    CHECK_EQ(f.progress, 0.0f);
+    CHECK_EQ(f.moveProgress, 0.0f);
+    CheckGeometry(f, 1920, 1080, 0, 0);
+
+    // A consumer whose present time is older than the start (another thread's clock read) sees the first frame
+    const ModeTransitionFrame early = EvaluateModeTransition(desc, START - std::chrono::milliseconds(5));
+    CHECK(!early.complete);
+    CHECK_EQ(early.progress, 0.0f);
+    CheckGeometry(early, 1920, 1080, 0, 0);
+}
+
+TEST_CASE(MovementFollowsTheDualEasing) {
+    const ModeTransitionDescriptor desc = BounceTransition();
+    int previousWidth = desc.fromWidth + 1;
+    float previousMove = -1.0f;
+    for (int ms = 0; ms < 300; ms++) {
+        SetTestContext(std::to_string(ms) + " ms");
+        const ModeTransitionFrame f = EvaluateModeTransition(desc, At(ms / 1000.0));
+        CHECK(!f.complete);
+        CHECK_NEAR(f.progress, ms / 600.0f, 1e-5f);
+
+        const float eased = ApplyDualEasing(ms / 300.0f, desc.easeInPower, desc.easeOutPower);
+        CHECK_NEAR(f.moveProgress, eased, 1e-4f);
+        CheckGeometry(f, Lerp(1920, 300, f.moveProgress), Lerp(1080, 800, f.moveProgress), Lerp(0, 810, f.moveProgress),
+                      Lerp(0, 140, f.moveProgress));
+
+        // Monotonic: the viewport never steps back during the move
+        CHECK(f.moveProgress >= previousMove);
+        CHECK(f.width <= previousWidth);
+        previousMove = f.moveProgress;
+        previousWidth = f.width;
+    }
+    SetTestContext("");
+
+    // Ease-out power 3: two thirds into the move, 85% of the distance is covered
+    CHECK(EvaluateModeTransition(desc, At(0.2)).moveProgress > 0.85f);
+}
+
+TEST_CASE(MoveEndsOnTheTargetAndBouncesStartThere) {
+    const ModeTransitionDescriptor desc = BounceTransition();
+    // Last moment of the move phase
+    const ModeTransitionFrame lastMove = EvaluateModeTransition(desc, At(0.3 - 1e-5));
+    CHECK(lastMove.moveProgress > 0.9999f);
+    CheckAtTarget(desc, lastMove);
+    CHECK(!lastMove.complete);
+
+    // First moment of the bounce phase: movement done, offset still zero
+    const ModeTransitionFrame firstBounce = EvaluateModeTransition(desc, At(0.3 + 1e-5));
+    CHECK_EQ(firstBounce.moveProgress, 1.0f);
+    CHECK(!firstBounce.complete);
+    CheckAtTarget(desc, firstBounce);
+    CHECK_NEAR(firstBounce.progress, 0.5f, 1e-4f);
+}
+
+TEST_CASE(BouncesOvershootBackTowardsTheSource) {
+    const ModeTransitionDescriptor desc = BounceTransition();
+    for (int ms = 300; ms < 600; ms++) {
+        SetTestContext(std::to_string(ms) + " ms");
+        const ModeTransitionFrame f = EvaluateModeTransition(desc, At(ms / 1000.0 + 1e-6));
+        CHECK(!f.complete);
+        CHECK_EQ(f.moveProgress, 1.0f);
+        const int bounce = (ms - 300) / 150;
+        const float phase = ((ms - 300) % 150) / 150.0f;
+        CheckBounce(desc, f, CalculateBounceOffset(phase, bounce, desc.bounceCount, desc.bounceIntensity));
+        // Bounces go back towards the source: wider, taller and further left than the target
+        CHECK(f.width >= desc.toWidth);
+        CHECK(f.x <= desc.toX);
+    }
+    SetTestContext("");
+
+    // Peaks: full intensity on the first bounce, quadratic decay on the second
+    CheckBounce(desc, EvaluateModeTransition(desc, At(0.375)), 0.15f);
+    CheckBounce(desc, EvaluateModeTransition(desc, At(0.525)), 0.15f * 0.25f);
+    CHECK_EQ(EvaluateModeTransition(desc, At(0.375)).width, 300 + static_cast<int>(1620 * 0.15f));
+
+    // The boundary between bounces is back on the target
+    CheckGeometry(EvaluateModeTransition(desc, At(0.45 + 1e-5)), 300, 800, 810, 140, 1);
+}
+
+TEST_CASE(PastTheEndClampsToTheTarget) {
+    const ModeTransitionDescriptor desc = BounceTransition();
+    for (double t : { 0.6, 0.6 + 1e-6, 0.61, 5.0, 3600.0 }) {
+        SetTestContext(std::to_string(t) + " s");
+        const ModeTransitionFrame f = EvaluateModeTransition(desc, At(t));
+        CHECK(f.complete);
+        CHECK_EQ(f.progress, 1.0f);
+        CHECK_EQ(f.moveProgress, 1.0f);
+        CheckAtTarget(desc, f);
+    }
+    SetTestContext("");
+    CHECK(!EvaluateModeTransition(desc, At(0.6 - 1e-4)).complete);
+
+    // Without bounces the move end is the transition end
+    ModeTransitionDescriptor noBounce = BounceTransition();
+    noBounce.bounceCount = 0;
+    CHECK(!EvaluateModeTransition(noBounce, At(0.3 - 1e-4)).complete);
+    CHECK(EvaluateModeTransition(noBounce, At(0.3)).complete);
+    CheckAtTarget(noBounce, EvaluateModeTransition(noBounce, At(0.3)));
+
+    // Zero length completes immediately
+    noBounce.duration = 0.0f;
+    const ModeTransitionFrame instant = EvaluateModeTransition(noBounce, START);
+    CHECK(instant.complete);
+    CheckAtTarget(noBounce, instant);
+}
+
+TEST_CASE(CutTransitionJumpsToTheTarget) {
+    ModeTransitionDescriptor desc = BounceTransition();
+    desc.animateGame = false;
+    for (double t : { 0.0, 0.1, 0.35, 0.59 }) {
+        const ModeTransitionFrame f = EvaluateModeTransition(desc, At(t));
+        CHECK(!f.complete);
+        CheckAtTarget(desc, f);
+        // Overlays still lerp on the overall progress
+        CHECK_EQ(f.moveProgress, f.progress);
+        CHECK_NEAR(f.progress, static_cast<float>(t / 0.6), 1e-5f);
+    }
+    CHECK(EvaluateModeTransition(desc, At(0.6)).complete);
+}
+
+TEST_CASE(SkippedAndUnchangedAxesStayOnTheTarget) {
+    ModeTransitionDescriptor desc = BounceTransition();
+    desc.skipAnimateX = true;
+    for (double t : { 0.0, 0.1, 0.2, 0.375, 0.525 }) {
+        const ModeTransitionFrame f = EvaluateModeTransition(desc, At(t));
+        CHECK_EQ(f.width, desc.toWidth);
+        CHECK_EQ(f.x, desc.toX);
+    }
+    CHECK(EvaluateModeTransition(desc, At(0.1)).height != desc.toHeight);
+    CHECK(EvaluateModeTransition(desc, At(0.375)).height != desc.toHeight);
+
+    // Same height and y on both sides: that axis neither moves nor bounces
+    ModeTransitionDescriptor sameY = BounceTransition();
+    sameY.fromHeight = sameY.toHeight;
+    sameY.fromY = sameY.toY;
+    for (double t : { 0.0, 0.1, 0.375, 0.525 }) {
+        const ModeTransitionFrame f = EvaluateModeTransition(sameY, At(t));
+        CHECK_EQ(f.height, sameY.toHeight);
+        CHECK_EQ(f.y, sameY.toY);
+    }
+    CHECK(EvaluateModeTransition(sameY, At(0.375)).width > sameY.toWidth);
+}
+
+TEST_CASE(SameTimeGivesTheSameFrame) {
+    const ModeTransitionDescriptor desc = BounceTransition();
+    // Consumers evaluate in any order for their own timestamps; nothing carries over between calls
+    for (int ms = 600; ms >= 0; ms -= 7) {
+        const ModeTransitionFrame a = EvaluateModeTransition(desc, At(ms / 1000.0));
+        EvaluateModeTransition(desc, At(0.45));
+        const ModeTransitionFrame b = EvaluateModeTransition(desc, At(ms / 1000.0));
+        CHECK(a.width == b.width && a.height == b.height && a.x == b.x && a.y == b.y);
+        CHECK(a.progress == b.progress && a.moveProgress == b.moveProgress && a.complete == b.complete);
+    }
+}
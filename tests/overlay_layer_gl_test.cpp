@@ -0,0 +1,470 @@
+// ============================================================================
+// OVERLAY_LAYER_GL_TEST.CPP - Retained overlay layers vs direct drawing on llvmpipe
+// ============================================================================
+// With the overlay layer cache on, the render thread draws image overlays into a RetainedOverlayLayer and
+// composites the covered rectangles (RT_CompositeOverlayLayer); with it off, RT_RenderImages draws straight
+// into the frame. Both paths are rebuilt here from the shipped shaders (render_shaders.h): commands are
+// recorded the way RT_RenderImages records them (background, keyed or plain image, four-quad border) and
+// replayed with the per-command setup of RT_ExecuteRenderCommands. Opaque content must come out byte for
+// byte the same; translucent content may differ by the extra 8-bit rounding of the premultiplied layer.
+// ============================================================================
+
+#include "gl_test_context.h"
+#include "overlay_layers.h"
+#include "render_commands.h"
+#include "render_shaders.h"
+#include "test_common.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int FULL_W = 320;
+constexpr int FULL_H = 180;
+
+struct TestImage {
+    int x = 0, y = 0, w = 0, h = 0; // Window pixels, y down
+    GLuint texture = 0;
+    int texW = 0, texH = 0;
+    int cropLeft = 0, cropRight = 0, cropTop = 0, cropBottom = 0;
+    bool pixelated = false;
+    float opacity = 1.0f;
+    bool background = false;
+    float bg[4] = { 0, 0, 0, 1 }; // rgb, opacity
+    int borderWidth = 0;
+    float border[3] = { 0, 0, 0 };
+    bool colorKey = false;
+    float key[3] = { 0, 0, 0 };
+    float keySensitivity = 0.05f;
+};
+
+// Records the scene like RT_RenderImages: same blend modes, crop UVs, border quads and drawn region
+void RecordImages(const std::vector<TestImage>& images, float modeOpacity, RenderCommandList& commands, OverlayLayerRegion* drawnRegion) {
+    const RenderBlendMode blend = RenderBlendMode::AlphaPremulDest;
+    for (const TestImage& img : images) {
+        const RenderRect ndc = PixelRectToNdc(img.x, img.y, img.w, img.h, FULL_W, FULL_H);
+        const bool hasBorder = img.borderWidth > 0;
+        if (drawnRegion) {
+            const float bx = hasBorder ? img.borderWidth * 2.0f / FULL_W : 0.0f;
+            const float by = hasBorder ? img.borderWidth * 2.0f / FULL_H : 0.0f;
+            drawnRegion->Include(ndc.x1 - bx, ndc.y1 - by, ndc.x2 + bx, ndc.y2 + by);
+        }
+        if (img.background) { commands.SolidQuad(ndc, img.bg[0], img.bg[1], img.bg[2], img.bg[3] * modeOpacity, blend); }
+
+        glBindTexture(GL_TEXTURE_2D, img.texture);
+        const GLint filter = img.pixelated ? GL_NEAREST : GL_LINEAR;
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+
+        const RenderRect uv{ static_cast<float>(img.cropLeft) / img.texW, static_cast<float>(img.cropBottom) / img.texH,
+                             static_cast<float>(img.texW - img.cropRight) / img.texW, static_cast<float>(img.texH - img.cropTop) / img.texH };
+        const RenderFilter rf = img.pixelated ? RenderFilter::Nearest : RenderFilter::Linear;
+        if (img.colorKey) {
+            commands.KeyedTexturedQuad(ndc, uv, img.texture, img.opacity * modeOpacity, rf, blend, img.key[0], img.key[1], img.key[2],
+                                       img.keySensitivity);
+        } else {
+            commands.TexturedQuad(ndc, uv, img.texture, img.opacity * modeOpacity, rf, blend);
+        }
+
+        if (hasBorder) {
+            // RT_RecordGameBorder
+            const int bw = img.borderWidth;
+            const RenderBlendMode borderBlend = RenderBlendMode::Alpha;
+            const float* c = img.border;
+            commands.SolidQuad(PixelRectToNdc(img.x - bw, img.y - bw, img.w + bw * 2, bw, FULL_W, FULL_H), c[0], c[1], c[2], 1.0f, borderBlend);
+            commands.SolidQuad(PixelRectToNdc(img.x - bw, img.y + img.h, img.w + bw * 2, bw, FULL_W, FULL_H), c[0], c[1], c[2], 1.0f,
+                               borderBlend);
+            commands.SolidQuad(PixelRectToNdc(img.x - bw, img.y, bw, img.h, FULL_W, FULL_H), c[0], c[1], c[2], 1.0f, borderBlend);
+            commands.SolidQuad(PixelRectToNdc(img.x + img.w, img.y, bw, img.h, FULL_W, FULL_H), c[0], c[1], c[2], 1.0f, borderBlend);
+        }
+    }
+}
+
+// RT_CompositeOverlayLayer
+void RecordComposite(const RetainedOverlayLayer& layer, RenderCommandList& commands) {
+    const OverlayLayerRegion& region = layer.Region();
+    for (int i = 0; i < region.count; i++) {
+        const OverlayLayerRegion::Rect& r = region.rects[i];
+        commands.TexturedQuad({ r.x1, r.y1, r.x2, r.y2 },
+                              { (r.x1 + 1.0f) * 0.5f, (r.y1 + 1.0f) * 0.5f, (r.x2 + 1.0f) * 0.5f, (r.y2 + 1.0f) * 0.5f }, layer.Texture(),
+                              1.0f, RenderFilter::Nearest, RenderBlendMode::Premultiplied);
+    }
+}
+
+// The render thread's solid and image programs with the state RT_ExecuteRenderCommands sets per command
+class CommandRunner {
+  public:
+    CommandRunner() {
+        m_solid = BuildTestProgram(rt_solid_vert_shader, rt_solid_color_frag_shader);
+        m_image = BuildTestProgram(rt_passthrough_vert_shader, rt_image_render_frag_shader);
+        glUseProgram(m_image);
+        glUniform1i(glGetUniformLocation(m_image, "imageTexture"), 0);
+        glUseProgram(0);
+
+        glGenVertexArrays(1, &m_vao);
+        glGenBuffers(1, &m_vbo);
+        glBindVertexArray(m_vao);
+        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+        glBufferData(GL_ARRAY_BUFFER, 24 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+        glEnableVertexAttribArray(1);
+    }
+
+    void Execute(const RenderCommandList& list) {
+        glBindVertexArray(m_vao);
+        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+        glActiveTexture(GL_TEXTURE0);
+        for (const RenderCommand& cmd : list.Commands()) {
+            ApplyBlend(cmd.blend);
+            switch (cmd.type) {
+            case RenderCommandType::SolidQuad:
+                glUseProgram(m_solid);
+                glUniform4fv(glGetUniformLocation(m_solid, "u_color"), 1, cmd.color);
+                break;
+            case RenderCommandType::TexturedQuad:
+                glUseProgram(m_image);
+                glUniform1i(glGetUniformLocation(m_image, "u_enableColorKey"), cmd.textured.colorKeyEnabled ? 1 : 0);
+                if (cmd.textured.colorKeyEnabled) {
+                    glUniform3fv(glGetUniformLocation(m_image, "u_colorKey"), 1, cmd.textured.colorKey);
+                    glUniform1f(glGetUniformLocation(m_image, "u_sensitivity"), cmd.textured.keySensitivity);
+                }
+                glUniform1f(glGetUniformLocation(m_image, "u_opacity"), cmd.textured.opacity);
+                glBindTexture(GL_TEXTURE_2D, cmd.texture);
+                break;
+            default:
+                REQUIRE(!"command type not recorded by RT_RenderImages");
+            }
+            const RenderRect& r = cmd.rect;
+            const RenderRect& t = cmd.uv;
+            float verts[] = { r.x1, r.y1, t.x1, t.y1, r.x2, r.y1, t.x2, t.y1, r.x2, r.y2, t.x2, t.y2,
+                              r.x1, r.y1, t.x1, t.y1, r.x2, r.y2, t.x2, t.y2, r.x1, r.y2, t.x1, t.y2 };
+            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(verts), verts);
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+        }
+        glDisable(GL_BLEND);
+    }
+
+  private:
+    // RT_ApplyBlendMode
+    static void ApplyBlend(RenderBlendMode blend) {
+        switch (blend) {
+        case RenderBlendMode::Opaque:
+            glDisable(GL_BLEND);
+            return;
+        case RenderBlendMode::Alpha:
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        case RenderBlendMode::AlphaPremulDest:
+            glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        case RenderBlendMode::Premultiplied:
+            glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        }
+        glEnable(GL_BLEND);
+    }
+
+    GLuint m_solid = 0, m_image = 0, m_vao = 0, m_vbo = 0;
+};
+
+CommandRunner& Runner() {
+    static CommandRunner s_runner;
+    return s_runner;
+}
+
+std::vector<uint8_t> NoisePixels(int w, int h, uint32_t seed, bool opaque) {
+    std::vector<uint8_t> px(static_cast<size_t>(w) * h * 4);
+    std::mt19937 rng(seed);
+    for (size_t i = 0; i < px.size(); i++) px[i] = static_cast<uint8_t>(rng());
+    if (opaque) {
+        for (size_t i = 3; i < px.size(); i += 4) px[i] = 255;
+    }
+    return px;
+}
+
+// The frame the overlays are drawn over: the game copy (opaque noise) or a cleared OBS target (transparent)
+struct Target {
+    GLuint texture = 0, fbo = 0;
+
+    explicit Target(bool opaqueFrame) {
+        const std::vector<uint8_t> frame = NoisePixels(FULL_W, FULL_H, 630, true);
+        texture = CreateTestTexture(FULL_W, FULL_H, opaqueFrame ? frame.data() : nullptr);
+        fbo = CreateTestFramebuffer(texture);
+        if (!opaqueFrame) {
+            glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+            glClearColor(0, 0, 0, 0);
+            glClear(GL_COLOR_BUFFER_BIT);
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glViewport(0, 0, FULL_W, FULL_H);
+    }
+    ~Target() {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glDeleteFramebuffers(1, &fbo);
+        glDeleteTextures(1, &texture);
+    }
+    std::vector<uint8_t> Read() const { return ReadTestFramebuffer(fbo, FULL_W, FULL_H); }
+};
+
+std::vector<uint8_t> DrawDirect(const std::vector<TestImage>& images, float modeOpacity, bool opaqueFrame) {
+    Target target(opaqueFrame);
+    RenderCommandList commands;
+    RecordImages(images, modeOpacity, commands, nullptr);
+    Runner().Execute(commands);
+    return target.Read();
+}
+
+// One frame of the cached path; returns whether the layer was re-rendered
+bool DrawLayered(RetainedOverlayLayer& layer, uint64_t hash, const std::vector<TestImage>& images, float modeOpacity, bool opaqueFrame,
+                 std::vector<uint8_t>& out) {
+    Target target(opaqueFrame);
+    bool updated = false;
+    if (layer.BeginUpdate(hash, FULL_W, FULL_H)) {
+        RenderCommandList commands;
+        OverlayLayerRegion drawn;
+        RecordImages(images, modeOpacity, commands, &drawn);
+        Runner().Execute(commands);
+        layer.EndUpdate(drawn);
+        updated = true;
+
+        GLint drawFbo = 0, viewport[4] = {};
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFbo);
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        CHECK_EQ(static_cast<GLuint>(drawFbo), target.fbo);
+        CHECK(viewport[0] == 0 && viewport[1] == 0 && viewport[2] == FULL_W && viewport[3] == FULL_H);
+    }
+    REQUIRE(layer.IsValid());
+    RenderCommandList composite;
+    RecordComposite(layer, composite);
+    Runner().Execute(composite);
+    out = target.Read();
+    return updated;
+}
+
+struct PixelDiff {
+    int pixels = 0;  // Pixels with any channel differing
+    int maxChannel = 0;
+};
+
+PixelDiff Compare(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b) {
+    PixelDiff d;
+    for (size_t i = 0; i < a.size(); i += 4) {
+        int worst = 0;
+        for (int c = 0; c < 4; c++) worst = (std::max)(worst, std::abs(a[i + c] - b[i + c]));
+        d.pixels += worst > 0;
+        d.maxChannel = (std::max)(d.maxChannel, worst);
+    }
+    return d;
+}
+
+struct SceneTextures {
+    GLuint opaque = 0, translucent = 0, keyed = 0;
+
+    SceneTextures() {
+        const std::vector<uint8_t> a = NoisePixels(48, 32, 631, true);
+        opaque = CreateTestTexture(48, 32, a.data());
+        const std::vector<uint8_t> b = NoisePixels(40, 40, 632, false);
+        translucent = CreateTestTexture(40, 40, b.data());
+        // Every other column is exactly the key color
+        std::vector<uint8_t> c = NoisePixels(32, 24, 633, true);
+        for (int y = 0; y < 24; y++) {
+            for (int x = 0; x < 32; x += 2) {
+                uint8_t* px = &c[(static_cast<size_t>(y) * 32 + x) * 4];
+                px[0] = 0;
+                px[1] = 255;
+                px[2] = 0;
+            }
+        }
+        keyed = CreateTestTexture(32, 24, c.data());
+    }
+    ~SceneTextures() {
+        const GLuint all[] = { opaque, translucent, keyed };
+        glDeleteTextures(3, all);
+    }
+};
+
+// Opaque images (stretched, cropped, nearest and linear), opaque backgrounds, borders, a color key, overlap
+std::vector<TestImage> OpaqueScene(const SceneTextures& tex) {
+    std::vector<TestImage> s(4);
+    s[0].x = 10, s[0].y = 12, s[0].w = 96, s[0].h = 64, s[0].texture = tex.opaque, s[0].texW = 48, s[0].texH = 32;
+    s[0].borderWidth = 3, s[0].border[0] = 1.0f, s[0].border[1] = 0.5f;
+    s[1].x = 80, s[1].y = 50, s[1].w = 48, s[1].h = 32, s[1].texture = tex.opaque, s[1].texW = 48, s[1].texH = 32, s[1].pixelated = true;
+    s[1].cropLeft = 4, s[1].cropTop = 6;
+    s[2].x = 200, s[2].y = 100, s[2].w = 64, s[2].h = 48, s[2].texture = tex.keyed, s[2].texW = 32, s[2].texH = 24, s[2].pixelated = true;
+    s[2].colorKey = true, s[2].key[1] = 1.0f;
+    s[2].background = true, s[2].bg[0] = 0.2f, s[2].bg[1] = 0.3f, s[2].bg[2] = 0.9f, s[2].bg[3] = 1.0f;
+    // Border reaching past the right edge of the frame
+    s[3].x = 290, s[3].y = 10, s[3].w = 28, s[3].h = 20, s[3].texture = tex.opaque, s[3].texW = 48, s[3].texH = 32, s[3].borderWidth = 5;
+    s[3].border[2] = 1.0f;
+    return s;
+}
+
+// Translucent textures, partial opacities, translucent backgrounds stacked on each other
+std::vector<TestImage> TranslucentScene(const SceneTextures& tex) {
+    std::vector<TestImage> s = OpaqueScene(tex);
+    s[0].opacity = 0.6f;
+    s[0].background = true, s[0].bg[0] = 0.9f, s[0].bg[3] = 0.4f;
+    s[1].texture = tex.translucent, s[1].texW = 40, s[1].texH = 40, s[1].cropLeft = 0, s[1].cropTop = 0, s[1].opacity = 0.75f;
+    s[2].opacity = 0.5f, s[2].bg[3] = 0.3f;
+    TestImage extra;
+    extra.x = 60, extra.y = 30, extra.w = 80, extra.h = 80, extra.texture = tex.translucent, extra.texW = 40, extra.texH = 40;
+    extra.opacity = 0.35f, extra.borderWidth = 2, extra.border[1] = 1.0f;
+    s.push_back(extra);
+    return s;
+}
+
+void ExpectSameOutput(const std::vector<TestImage>& scene, float modeOpacity, bool opaqueFrame, int maxChannelDiff) {
+    const std::vector<uint8_t> direct = DrawDirect(scene, modeOpacity, opaqueFrame);
+    RetainedOverlayLayer layer;
+    std::vector<uint8_t> cached;
+    CHECK(DrawLayered(layer, 1, scene, modeOpacity, opaqueFrame, cached));
+    const PixelDiff first = Compare(direct, cached);
+    CHECK(first.maxChannel <= maxChannelDiff);
+    if (maxChannelDiff == 0) CHECK_EQ(first.pixels, 0);
+
+    // The next frame composites the retained texture without re-rendering it
+    std::vector<uint8_t> retained;
+    CHECK(!DrawLayered(layer, 1, scene, modeOpacity, opaqueFrame, retained));
+    CHECK_EQ(Compare(cached, retained).pixels, 0);
+    layer.Release();
+}
+
+} // namespace
+
+TEST_CASE(OpaqueOverlaysMatchExactlyOverGameFrame) {
+    RequireGLContext();
+    SceneTextures tex;
+    ExpectSameOutput(OpaqueScene(tex), 1.0f, true, 0);
+}
+
+TEST_CASE(OpaqueOverlaysMatchExactlyOverTransparentFrame) {
+    RequireGLContext();
+    SceneTextures tex;
+    ExpectSameOutput(OpaqueScene(tex), 1.0f, false, 0);
+}
+
+TEST_CASE(TranslucentOverlaysMatchWithinRoundingOverGameFrame) {
+    RequireGLContext();
+    SceneTextures tex;
+    ExpectSameOutput(TranslucentScene(tex), 1.0f, true, 2);
+}
+
+TEST_CASE(TranslucentOverlaysMatchWithinRoundingOverTransparentFrame) {
+    RequireGLContext();
+    SceneTextures tex;
+    ExpectSameOutput(TranslucentScene(tex), 1.0f, false, 2);
+}
+
+TEST_CASE(FadingModeOpacityMatchesWithinRounding) {
+    RequireGLContext();
+    SceneTextures tex;
+    ExpectSameOutput(OpaqueScene(tex), 0.45f, true, 2);
+}
+
+TEST_CASE(ChangedContentReRendersTheLayer) {
+    RequireGLContext();
+    SceneTextures tex;
+    RetainedOverlayLayer layer;
+    std::vector<TestImage> scene = OpaqueScene(tex);
+    std::vector<uint8_t> out;
+    CHECK(DrawLayered(layer, 10, scene, 1.0f, true, out));
+
+    // Moved image under a new hash: the composite shows the new layout, not the retained one
+    scene[1].x += 37;
+    scene[1].y -= 20;
+    CHECK(DrawLayered(layer, 11, scene, 1.0f, true, out));
+    CHECK_EQ(Compare(DrawDirect(scene, 1.0f, true), out).pixels, 0);
+
+    // Invalidate() forces a re-render under the same hash
+    layer.Invalidate();
+    CHECK(!layer.IsValid());
+    CHECK(DrawLayered(layer, 11, scene, 1.0f, true, out));
+    layer.Release();
+}
+
+TEST_CASE(BeginUpdateTracksHashAndSize) {
+    RequireGLContext();
+    Target target(true);
+    RetainedOverlayLayer layer;
+    CHECK(!layer.BeginUpdate(1, 0, FULL_H));
+    CHECK(!layer.IsValid());
+
+    auto update = [&](uint64_t hash, int w, int h) {
+        if (!layer.BeginUpdate(hash, w, h)) return false;
+        layer.EndUpdate(OverlayLayerRegion{});
+        return true;
+    };
+    CHECK(update(5, FULL_W, FULL_H));
+    CHECK(!update(5, FULL_W, FULL_H));
+    CHECK(update(6, FULL_W, FULL_H));
+    CHECK(update(6, FULL_W / 2, FULL_H));
+    CHECK(!update(6, FULL_W / 2, FULL_H));
+
+    // Resized layers restore the caller's framebuffer and viewport too
+    GLint drawFbo = 0, viewport[4] = {};
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFbo);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    CHECK_EQ(static_cast<GLuint>(drawFbo), target.fbo);
+    CHECK_EQ(viewport[2], FULL_W);
+    CHECK_EQ(viewport[3], FULL_H);
+
+    layer.Release();
+    CHECK(!layer.IsValid());
+    CHECK_EQ(layer.Texture(), 0u);
+    CHECK(update(6, FULL_W / 2, FULL_H));
+    layer.Release();
+}
+
+TEST_CASE(NoteContentSettlesOnRepeatedHash) {
+    RetainedOverlayLayer layer;
+    CHECK(!layer.NoteContent(1));
+    CHECK(layer.NoteContent(1));
+    CHECK(!layer.NoteContent(2));
+    CHECK(layer.NoteContent(2));
+    layer.Release();
+    CHECK(!layer.NoteContent(2));
+}
+
+TEST_CASE(RegionMergesOverlapsAndClipsToTheLayer) {
+    OverlayLayerRegion region;
+    region.Include(-0.5f, -0.5f, 0.0f, 0.0f);
+    region.Include(0.5f, 0.5f, 0.8f, 0.8f);
+    CHECK_EQ(region.count, 2);
+    region.Include(0.5f, 0.5f, 0.5f, 0.9f); // Empty
+    CHECK_EQ(region.count, 2);
+
+    // Bridges both rectangles: everything merges into one union
+    region.Include(-0.1f, -0.1f, 0.6f, 0.6f);
+    REQUIRE(region.count == 1);
+    CHECK_EQ(region.rects[0].x1, -0.5f);
+    CHECK_EQ(region.rects[0].y2, 0.8f);
+
+    // Past MAX_RECTS disjoint rectangles fold together but keep covering every input
+    OverlayLayerRegion many;
+    for (int i = 0; i < 12; i++) many.Include(-1.0f + i * 0.15f, 0.0f, -0.95f + i * 0.15f, 0.05f);
+    CHECK(many.count <= OverlayLayerRegion::MAX_RECTS);
+    for (int i = 0; i < 12; i++) {
+        const float cx = -0.975f + i * 0.15f;
+        bool covered = false;
+        for (int r = 0; r < many.count; r++) covered |= many.rects[r].x1 <= cx && cx <= many.rects[r].x2;
+        CHECK(covered);
+    }
+
+    RequireGLContext();
+    Target target(true);
+    RetainedOverlayLayer layer;
+    REQUIRE(layer.BeginUpdate(1, FULL_W, FULL_H));
+    OverlayLayerRegion drawn;
+    drawn.Include(0.9f, -1.2f, 1.3f, -0.8f);
+    layer.EndUpdate(drawn);
+    REQUIRE(layer.Region().count == 1);
+    const OverlayLayerRegion::Rect& r = layer.Region().rects[0];
+    CHECK(r.x1 == 0.9f && r.y1 == -1.0f && r.x2 == 1.0f && r.y2 == -0.8f);
+    layer.Release();
+}
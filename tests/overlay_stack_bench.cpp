@@ -0,0 +1,381 @@
+// ============================================================================
+// OVERLAY_STACK_BENCH.CPP - Per-pass cost of the OBS and screen passes, overlay layer cache on and off
+// ============================================================================
+// One render thread iteration in steady state: an OBS pass and an on-screen pass that draw the same overlay
+// stack (8 mirrors, 12 images with backgrounds and borders) over a 1920x1080 target.
+//
+//   cache off  (debug.disableOverlayLayerCache) both passes draw every item directly
+//   cache on   the OBS pass draws the stack into rt_sharedOverlayStack (images through their own retained
+//              layer, mirrors directly since their contents change every frame) and composites it; the
+//              screen pass composites the same texture after checking the key
+//
+// Commands are recorded and replayed the way RT_RenderImages / RT_FlushRenderCommands do, with the shipped
+// shaders. Each pass is timed on its own (glFinish before and after): CPU time is the time to issue it, GPU
+// time comes from a GL_TIME_ELAPSED query around it, and finish time runs until glFinish returns; all are
+// means over the timed iterations. Output of both modes is checked to agree first.
+//
+// On llvmpipe the "GPU" is the CPU rasterizer and cost is proportional to the pixels blended, so a fullscreen
+// composite costs more than a sparse stack drawn directly. Sampling a texture rendered earlier in the same pass
+// also waits for that rendering, which lands in the CPU column. Only the issue cost of the screen pass carries
+// over to a discrete GPU as measured.
+// ============================================================================
+
+#include "mode_render_list.h"
+#include "overlay_layers.h"
+#include "overlay_stack_key.h"
+#include "render_commands.h"
+#include "render_shaders.h"
+#include "render_thread.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr int FULL_W = 1920;
+constexpr int FULL_H = 1080;
+constexpr int MIRRORS = 8;
+constexpr int IMAGES = 12;
+constexpr int WARMUP_ITERATIONS = 20;
+constexpr int TIMED_ITERATIONS = 200;
+
+// The surfaceless context of gl_test_context.cpp, without the test harness
+bool MakeHeadlessContextCurrent() {
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (!getPlatformDisplay) return false;
+    EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr) || !eglBindAPI(EGL_OPENGL_API)) return false;
+    const EGLint attribs[] = { EGL_CONTEXT_MAJOR_VERSION, 4, EGL_CONTEXT_MINOR_VERSION, 5, EGL_CONTEXT_OPENGL_PROFILE_MASK,
+                               EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT, EGL_NONE };
+    EGLContext context = eglCreateContext(display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, attribs);
+    return context != EGL_NO_CONTEXT && eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context);
+}
+
+GLuint BuildProgram(const char* vertSrc, const char* fragSrc) {
+    GLuint program = glCreateProgram();
+    for (GLenum type : { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER }) {
+        GLuint shader = glCreateShader(type);
+        const char* src = type == GL_VERTEX_SHADER ? vertSrc : fragSrc;
+        glShaderSource(shader, 1, &src, nullptr);
+        glCompileShader(shader);
+        glAttachShader(program, shader);
+        glDeleteShader(shader);
+    }
+    glLinkProgram(program);
+    GLint ok = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    return ok ? program : 0;
+}
+
+GLuint NoiseTexture(int w, int h, uint32_t seed) {
+    std::vector<uint8_t> px(static_cast<size_t>(w) * h * 4);
+    std::mt19937 rng(seed);
+    for (size_t i = 0; i < px.size(); i++) px[i] = static_cast<uint8_t>(rng());
+    for (size_t i = 3; i < px.size(); i += 4) px[i] = 255;
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, px.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    return texture;
+}
+
+struct Target {
+    GLuint texture = 0, fbo = 0;
+};
+
+Target CreateTarget() {
+    Target t;
+    glGenTextures(1, &t.texture);
+    glBindTexture(GL_TEXTURE_2D, t.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, FULL_W, FULL_H, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glGenFramebuffers(1, &t.fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, t.fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, t.texture, 0);
+    return t;
+}
+
+struct Item {
+    int x, y, w, h;
+    GLuint texture;
+};
+
+// RT_ExecuteRenderCommands for the command types the overlay stack records
+class CommandRunner {
+  public:
+    bool Init() {
+        m_solid = BuildProgram(rt_solid_vert_shader, rt_solid_color_frag_shader);
+        m_image = BuildProgram(rt_passthrough_vert_shader, rt_image_render_frag_shader);
+        if (!m_solid || !m_image) return false;
+        glUseProgram(m_image);
+        glUniform1i(glGetUniformLocation(m_image, "imageTexture"), 0);
+        glUniform1i(glGetUniformLocation(m_image, "u_enableColorKey"), 0);
+        glGenVertexArrays(1, &m_vao);
+        glGenBuffers(1, &m_vbo);
+        glBindVertexArray(m_vao);
+        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+        glBufferData(GL_ARRAY_BUFFER, 24 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+        glEnableVertexAttribArray(1);
+        return true;
+    }
+
+    void Flush(RenderCommandList& commands) {
+        glActiveTexture(GL_TEXTURE0);
+        glEnable(GL_BLEND);
+        for (const RenderCommand& cmd : commands.Commands()) {
+            switch (cmd.blend) {
+            case RenderBlendMode::Alpha:
+                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                break;
+            case RenderBlendMode::Premultiplied:
+                glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+                break;
+            default:
+                glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+                break;
+            }
+            if (cmd.type == RenderCommandType::SolidQuad) {
+                glUseProgram(m_solid);
+                glUniform4fv(glGetUniformLocation(m_solid, "u_color"), 1, cmd.color);
+            } else {
+                glUseProgram(m_image);
+                glUniform1f(glGetUniformLocation(m_image, "u_opacity"), cmd.textured.opacity);
+                glBindTexture(GL_TEXTURE_2D, cmd.texture);
+            }
+            const RenderRect& r = cmd.rect;
+            const RenderRect& t = cmd.uv;
+            float verts[] = { r.x1, r.y1, t.x1, t.y1, r.x2, r.y1, t.x2, t.y1, r.x2, r.y2, t.x2, t.y2,
+                              r.x1, r.y1, t.x1, t.y1, r.x2, r.y2, t.x2, t.y2, r.x1, r.y2, t.x1, t.y2 };
+            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(verts), verts);
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+        }
+        glDisable(GL_BLEND);
+        commands.Clear();
+    }
+
+  private:
+    GLuint m_solid = 0, m_image = 0, m_vao = 0, m_vbo = 0;
+};
+
+class StackScene {
+  public:
+    bool Init() {
+        if (!m_runner.Init()) return false;
+        std::mt19937 rng(66);
+        for (int i = 0; i < MIRRORS; i++) {
+            const int size = 200 + static_cast<int>(rng() % 160);
+            m_mirrors.push_back({ static_cast<int>(rng() % (FULL_W - size)), static_cast<int>(rng() % (FULL_H - size)), size, size,
+                                  NoiseTexture(64, 64, 100 + i) });
+        }
+        for (int i = 0; i < IMAGES; i++) {
+            const int w = 120 + static_cast<int>(rng() % 200), h = 80 + static_cast<int>(rng() % 120);
+            m_images.push_back({ static_cast<int>(rng() % (FULL_W - w - 8)) + 4, static_cast<int>(rng() % (FULL_H - h - 8)) + 4, w, h,
+                                 NoiseTexture(w, h, 200 + i) });
+        }
+        m_obs = CreateTarget();
+        m_screen = CreateTarget();
+        glGenQueries(2, m_queries);
+        m_obsRequest.isObsPass = true;
+        for (FrameRenderRequest* r : { &m_obsRequest, &m_screenRequest }) {
+            r->fullW = r->toW = r->fromW = FULL_W;
+            r->fullH = r->toH = r->fromH = FULL_H;
+            r->gameW = r->finalW = r->animatedW = FULL_W;
+            r->gameH = r->finalH = r->animatedH = FULL_H;
+        }
+        return true;
+    }
+
+    // Mean CPU and GPU microseconds per OBS and screen pass
+    struct PassTimes {
+        double cpuUs[2] = {};
+        double gpuUs[2] = {};
+        double finishUs[2] = {}; // Issue until glFinish returns
+    };
+
+    PassTimes Run(bool layerCache) {
+        PassTimes times;
+        for (int it = 0; it < WARMUP_ITERATIONS + TIMED_ITERATIONS; it++) {
+            bool sharedReady = false;
+            uint64_t sharedKey = 0;
+            for (int pass = 0; pass < 2; pass++) {
+                const bool isObs = pass == 0;
+                glFinish(); // Passes are timed one at a time, as if the other pass's work were already done
+                const auto start = std::chrono::steady_clock::now();
+                glBeginQuery(GL_TIME_ELAPSED, m_queries[pass]);
+                glBindFramebuffer(GL_DRAW_FRAMEBUFFER, isObs ? m_obs.fbo : m_screen.fbo);
+                glViewport(0, 0, FULL_W, FULL_H);
+                glClearColor(0, 0, 0, 0);
+                glClear(GL_COLOR_BUFFER_BIT);
+                if (!layerCache) {
+                    m_imageLayer.Release();
+                    m_sharedStack.Release();
+                    DrawStack(false);
+                } else if (isObs) {
+                    const uint64_t key = HashOverlayStack(m_obsRequest, true, m_list, 0.0f);
+                    m_sharedStack.Invalidate();
+                    if (key == HashOverlayStack(m_screenRequest, false, m_list, 0.0f) && m_sharedStack.BeginUpdate(key, FULL_W, FULL_H)) {
+                        DrawStack(true);
+                        OverlayLayerRegion everything;
+                        everything.Include(-1.0f, -1.0f, 1.0f, 1.0f);
+                        m_sharedStack.EndUpdate(everything);
+                        sharedReady = m_sharedStack.IsValid();
+                        sharedKey = key;
+                    }
+                    if (sharedReady) {
+                        Composite(m_sharedStack);
+                    } else {
+                        DrawStack(true);
+                    }
+                } else if (sharedReady && HashOverlayStack(m_screenRequest, false, m_list, 0.0f) == sharedKey) {
+                    Composite(m_sharedStack);
+                } else {
+                    DrawStack(true);
+                }
+                glEndQuery(GL_TIME_ELAPSED);
+                const double cpuUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+                glFinish();
+                const double finishUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+                if (it >= WARMUP_ITERATIONS) {
+                    times.cpuUs[pass] += cpuUs;
+                    times.finishUs[pass] += finishUs;
+                }
+            }
+            for (int pass = 0; pass < 2; pass++) {
+                GLuint64 ns = 0;
+                glGetQueryObjectui64v(m_queries[pass], GL_QUERY_RESULT, &ns);
+                if (it >= WARMUP_ITERATIONS) times.gpuUs[pass] += ns / 1e3;
+            }
+        }
+        for (int pass = 0; pass < 2; pass++) {
+            times.cpuUs[pass] /= TIMED_ITERATIONS;
+            times.gpuUs[pass] /= TIMED_ITERATIONS;
+            times.finishUs[pass] /= TIMED_ITERATIONS;
+        }
+        return times;
+    }
+
+    // Pixels where the cached and direct screen passes differ by more than 8-bit rounding
+    int ScreenMismatches(const std::vector<uint8_t>& reference) const {
+        std::vector<uint8_t> px = ReadScreen();
+        int mismatches = 0;
+        for (size_t i = 0; i < px.size(); i++) mismatches += std::abs(px[i] - reference[i]) > 2;
+        return mismatches;
+    }
+
+    std::vector<uint8_t> ReadScreen() const {
+        std::vector<uint8_t> px(static_cast<size_t>(FULL_W) * FULL_H * 4);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_screen.fbo);
+        glReadPixels(0, 0, FULL_W, FULL_H, GL_RGBA, GL_UNSIGNED_BYTE, px.data());
+        return px;
+    }
+
+  private:
+    // RT_RenderMirrors, then RT_RenderImages through its retained layer when the cache is on
+    void DrawStack(bool layerCache) {
+        for (const Item& m : m_mirrors) {
+            m_commands.TexturedQuad(PixelRectToNdc(m.x, m.y, m.w, m.h, FULL_W, FULL_H), { 0, 0, 1, 1 }, m.texture, 1.0f, RenderFilter::Nearest,
+                                    RenderBlendMode::AlphaPremulDest);
+        }
+        m_runner.Flush(m_commands);
+
+        if (!layerCache) {
+            RecordImages(nullptr);
+            m_runner.Flush(m_commands);
+            return;
+        }
+        if (m_imageLayer.BeginUpdate(1, FULL_W, FULL_H)) {
+            OverlayLayerRegion drawn;
+            RecordImages(&drawn);
+            m_runner.Flush(m_commands);
+            m_imageLayer.EndUpdate(drawn);
+        }
+        Composite(m_imageLayer);
+    }
+
+    void RecordImages(OverlayLayerRegion* drawn) {
+        for (const Item& img : m_images) {
+            const RenderRect ndc = PixelRectToNdc(img.x, img.y, img.w, img.h, FULL_W, FULL_H);
+            if (drawn) drawn->Include(ndc.x1 - 4.0f / FULL_W, ndc.y1 - 4.0f / FULL_H, ndc.x2 + 4.0f / FULL_W, ndc.y2 + 4.0f / FULL_H);
+            m_commands.SolidQuad(ndc, 0.1f, 0.1f, 0.1f, 0.6f, RenderBlendMode::AlphaPremulDest);
+            m_commands.TexturedQuad(ndc, { 0, 0, 1, 1 }, img.texture, 0.9f, RenderFilter::Linear, RenderBlendMode::AlphaPremulDest);
+            const int bw = 2;
+            m_commands.SolidQuad(PixelRectToNdc(img.x - bw, img.y - bw, img.w + bw * 2, bw, FULL_W, FULL_H), 1, 1, 1, 1, RenderBlendMode::Alpha);
+            m_commands.SolidQuad(PixelRectToNdc(img.x - bw, img.y + img.h, img.w + bw * 2, bw, FULL_W, FULL_H), 1, 1, 1, 1,
+                                 RenderBlendMode::Alpha);
+            m_commands.SolidQuad(PixelRectToNdc(img.x - bw, img.y, bw, img.h, FULL_W, FULL_H), 1, 1, 1, 1, RenderBlendMode::Alpha);
+            m_commands.SolidQuad(PixelRectToNdc(img.x + img.w, img.y, bw, img.h, FULL_W, FULL_H), 1, 1, 1, 1, RenderBlendMode::Alpha);
+        }
+    }
+
+    // RT_CompositeOverlayLayer
+    void Composite(const RetainedOverlayLayer& layer) {
+        const OverlayLayerRegion& region = layer.Region();
+        for (int i = 0; i < region.count; i++) {
+            const OverlayLayerRegion::Rect& r = region.rects[i];
+            m_commands.TexturedQuad({ r.x1, r.y1, r.x2, r.y2 },
+                                    { (r.x1 + 1.0f) * 0.5f, (r.y1 + 1.0f) * 0.5f, (r.x2 + 1.0f) * 0.5f, (r.y2 + 1.0f) * 0.5f },
+                                    layer.Texture(), 1.0f, RenderFilter::Nearest, RenderBlendMode::Premultiplied);
+        }
+        m_runner.Flush(m_commands);
+    }
+
+    CommandRunner m_runner;
+    RenderCommandList m_commands;
+    std::vector<Item> m_mirrors, m_images;
+    Target m_obs, m_screen;
+    GLuint m_queries[2] = {};
+    RetainedOverlayLayer m_imageLayer, m_sharedStack;
+    ModeRenderList m_list;
+    FrameRenderRequest m_obsRequest, m_screenRequest;
+};
+
+} // namespace
+
+int main() {
+    if (!MakeHeadlessContextCurrent()) {
+        fprintf(stderr, "no headless GL context\n");
+        return 1;
+    }
+    StackScene scene;
+    if (!scene.Init()) {
+        fprintf(stderr, "overlay shaders failed to build\n");
+        return 1;
+    }
+
+    const char* modeNames[2] = { "layer cache off", "layer cache on" };
+    StackScene::PassTimes times[2];
+    std::vector<uint8_t> reference;
+    for (int mode = 0; mode < 2; mode++) {
+        times[mode] = scene.Run(mode == 1);
+        if (mode == 0) {
+            reference = scene.ReadScreen();
+            continue;
+        }
+        const int mismatches = scene.ScreenMismatches(reference);
+        if (mismatches > 0) {
+            fprintf(stderr, "%s differs from direct drawing in %d channels\n", modeNames[mode], mismatches);
+            return 1;
+        }
+    }
+
+    printf("%dx%d, %d mirrors, %d images, GPU: %s\n", FULL_W, FULL_H, MIRRORS, IMAGES, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    printf("  %-28s %10s %10s %10s\n", "", "CPU us", "GPU us", "finish us");
+    const char* passNames[2] = { "OBS pass", "screen pass" };
+    for (int pass = 0; pass < 2; pass++) {
+        for (int mode = 0; mode < 2; mode++) {
+            printf("  %-12s %-15s %10.1f %10.1f %10.1f\n", passNames[pass], modeNames[mode], times[mode].cpuUs[pass], times[mode].gpuUs[pass],
+                   times[mode].finishUs[pass]);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,221 @@
+// ============================================================================
+// OVERLAY_STACK_KEY_TEST.CPP - When the OBS and on-screen passes may share one overlay stack
+// ============================================================================
+// The render thread composites the OBS pass's overlay stack on screen only when HashOverlayStack gives both
+// passes the same key, so the key must match exactly when the two passes would draw the same stack: equal
+// placement, opacity, transition and slide-out state, and onlyOnMyScreen filtering that filters the same
+// items. Each case starts from a steady-state pair of requests (equal keys) and changes one input of one pass.
+// ============================================================================
+
+#include "mode_render_list.h"
+#include "overlay_stack_key.h"
+#include "render_thread.h"
+#include "test_common.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace {
+
+// A game viewport centered on a 1920x1080 screen, not animating
+FrameRenderRequest ScreenRequest() {
+    FrameRenderRequest r;
+    r.fullW = 1920;
+    r.fullH = 1080;
+    r.gameW = 1280;
+    r.gameH = 720;
+    r.finalX = 320;
+    r.finalY = 180;
+    r.finalW = 1280;
+    r.finalH = 720;
+    r.fromX = r.toX = r.finalX;
+    r.fromY = r.toY = r.finalY;
+    r.fromW = r.toW = r.finalW;
+    r.fromH = r.toH = r.finalH;
+    r.gameTextureId = 9;
+    r.modeHandle = 2;
+    r.fromModeHandle = 2;
+    return r;
+}
+
+// The OBS request of the same iteration: the animated viewport has reached the final one, and OBS hides
+// onlyOnMyScreen items
+FrameRenderRequest ObsRequest() {
+    FrameRenderRequest r = ScreenRequest();
+    r.isObsPass = true;
+    r.excludeOnlyOnMyScreen = true;
+    r.animatedX = r.finalX;
+    r.animatedY = r.finalY;
+    r.animatedW = r.finalW;
+    r.animatedH = r.finalH;
+    return r;
+}
+
+struct Change {
+    const char* name;
+    std::function<void(FrameRenderRequest&)> apply;
+};
+
+// Checks that the base pair shares a key, and that applying each change to the given pass breaks it
+void CheckEachChangeSplitsTheKey(const ModeRenderList& list, bool changeObsPass, const std::vector<Change>& changes) {
+    const FrameRenderRequest obs = ObsRequest();
+    const FrameRenderRequest screen = ScreenRequest();
+    REQUIRE(HashOverlayStack(obs, true, list, 0.0f) == HashOverlayStack(screen, false, list, 0.0f));
+    for (const Change& change : changes) {
+        SetTestContext(std::string(changeObsPass ? "OBS pass: " : "screen pass: ") + change.name);
+        FrameRenderRequest changed = changeObsPass ? obs : screen;
+        change.apply(changed);
+        const uint64_t obsKey = HashOverlayStack(changeObsPass ? changed : obs, true, list, 0.0f);
+        const uint64_t screenKey = HashOverlayStack(changeObsPass ? screen : changed, false, list, 0.0f);
+        CHECK(obsKey != screenKey);
+    }
+    SetTestContext("");
+}
+
+} // namespace
+
+TEST_CASE(SteadyStatePassesShareTheKey) {
+    ModeRenderList list;
+    CHECK_EQ(HashOverlayStack(ObsRequest(), true, list, 0.0f), HashOverlayStack(ScreenRequest(), false, list, 0.0f));
+
+    // Inputs the overlay stack does not read
+    FrameRenderRequest obs = ObsRequest();
+    obs.frameNumber = 41;
+    obs.bgR = 1.0f;
+    obs.borderEnabled = true;
+    obs.borderWidth = 4;
+    obs.showEyeZoom = true;
+    obs.eyeZoomFadeOpacity = 0.5f;
+    CHECK_EQ(HashOverlayStack(obs, true, list, 0.0f), HashOverlayStack(ScreenRequest(), false, list, 0.0f));
+}
+
+TEST_CASE(PlacementChangesTheKey) {
+    ModeRenderList list;
+    const std::vector<Change> changes = {
+        { "fullW", [](FrameRenderRequest& r) { r.fullW = 2560; } },
+        { "fullH", [](FrameRenderRequest& r) { r.fullH = 1440; } },
+        { "gameW", [](FrameRenderRequest& r) { r.gameW = 1920; } },
+        { "gameH", [](FrameRenderRequest& r) { r.gameH = 1080; } },
+        { "fromX", [](FrameRenderRequest& r) { r.fromX = 0; } },
+        { "fromY", [](FrameRenderRequest& r) { r.fromY = 0; } },
+        { "fromW", [](FrameRenderRequest& r) { r.fromW = 1920; } },
+        { "fromH", [](FrameRenderRequest& r) { r.fromH = 1080; } },
+        { "toX", [](FrameRenderRequest& r) { r.toX = 0; } },
+        { "toY", [](FrameRenderRequest& r) { r.toY = 0; } },
+        { "toW", [](FrameRenderRequest& r) { r.toW = 1920; } },
+        { "toH", [](FrameRenderRequest& r) { r.toH = 1080; } },
+        { "eyeZoomAnimatedViewportX", [](FrameRenderRequest& r) { r.eyeZoomAnimatedViewportX = 100; } },
+    };
+    CheckEachChangeSplitsTheKey(list, true, changes);
+    CheckEachChangeSplitsTheKey(list, false, changes);
+
+    // The OBS pass places overlays on the animated viewport, the screen pass on the final one
+    CheckEachChangeSplitsTheKey(list, true,
+                                {
+                                    { "animatedX", [](FrameRenderRequest& r) { r.animatedX += 1; } },
+                                    { "animatedY", [](FrameRenderRequest& r) { r.animatedY += 1; } },
+                                    { "animatedW", [](FrameRenderRequest& r) { r.animatedW -= 1; } },
+                                    { "animatedH", [](FrameRenderRequest& r) { r.animatedH -= 1; } },
+                                });
+    CheckEachChangeSplitsTheKey(list, false,
+                                {
+                                    { "finalX", [](FrameRenderRequest& r) { r.finalX += 1; } },
+                                    { "finalY", [](FrameRenderRequest& r) { r.finalY += 1; } },
+                                    { "finalW", [](FrameRenderRequest& r) { r.finalW -= 1; } },
+                                    { "finalH", [](FrameRenderRequest& r) { r.finalH -= 1; } },
+                                });
+
+    // ...and neither reads the other's viewport
+    FrameRenderRequest obs = ObsRequest();
+    obs.finalX = 0;
+    obs.finalW = 1920;
+    FrameRenderRequest screen = ScreenRequest();
+    screen.animatedX = 5;
+    screen.animatedW = 17;
+    CHECK_EQ(HashOverlayStack(obs, true, list, 0.0f), HashOverlayStack(screen, false, list, 0.0f));
+}
+
+TEST_CASE(OpacityChangesTheKey) {
+    ModeRenderList list;
+    const std::vector<Change> changes = {
+        { "overlayOpacity", [](FrameRenderRequest& r) { r.overlayOpacity = 0.5f; } },
+        { "overlayOpacity (last step of a fade)", [](FrameRenderRequest& r) { r.overlayOpacity = 0.999f; } },
+    };
+    CheckEachChangeSplitsTheKey(list, true, changes);
+    CheckEachChangeSplitsTheKey(list, false, changes);
+}
+
+TEST_CASE(TransitionAndSlideOutStateChangeTheKey) {
+    ModeRenderList list;
+    const std::vector<Change> changes = {
+        { "transitionProgress", [](FrameRenderRequest& r) { r.transitionProgress = 0.25f; } },
+        { "mirrorSlideProgress", [](FrameRenderRequest& r) { r.mirrorSlideProgress = 0.25f; } },
+        { "isTransitioningFromEyeZoom", [](FrameRenderRequest& r) { r.isTransitioningFromEyeZoom = true; } },
+        { "fromSlideMirrorsIn", [](FrameRenderRequest& r) { r.fromSlideMirrorsIn = true; } },
+        { "toSlideMirrorsIn", [](FrameRenderRequest& r) { r.toSlideMirrorsIn = true; } },
+        { "skipAnimation", [](FrameRenderRequest& r) { r.skipAnimation = true; } },
+        { "relativeStretching", [](FrameRenderRequest& r) { r.relativeStretching = true; } },
+        { "isRawWindowedMode", [](FrameRenderRequest& r) { r.isRawWindowedMode = true; } },
+        { "fromModeHandle", [](FrameRenderRequest& r) { r.fromModeHandle = 3; } },
+        { "gameTextureId", [](FrameRenderRequest& r) { r.gameTextureId = 10; } },
+    };
+    CheckEachChangeSplitsTheKey(list, true, changes);
+    CheckEachChangeSplitsTheKey(list, false, changes);
+}
+
+TEST_CASE(OnlyOnMyScreenFilteringCountsWhenItCouldFilterSomething) {
+    // Nothing to filter: OBS excluding onlyOnMyScreen items draws the same stack as the screen
+    ModeRenderList plain;
+    CHECK_EQ(HashOverlayStack(ObsRequest(), true, plain, 0.0f), HashOverlayStack(ScreenRequest(), false, plain, 0.0f));
+
+    // The list has onlyOnMyScreen items: the passes draw different sets
+    ModeRenderList withOoms;
+    withOoms.hasOnlyOnMyScreenItems = true;
+    CHECK(HashOverlayStack(ObsRequest(), true, withOoms, 0.0f) != HashOverlayStack(ScreenRequest(), false, withOoms, 0.0f));
+    FrameRenderRequest screenExcluding = ScreenRequest();
+    screenExcluding.excludeOnlyOnMyScreen = true;
+    CHECK_EQ(HashOverlayStack(ObsRequest(), true, withOoms, 0.0f), HashOverlayStack(screenExcluding, false, withOoms, 0.0f));
+
+    // A slide-out set (mirrors of another mode) could hold onlyOnMyScreen items the list does not show
+    const std::vector<std::pair<const char*, std::function<void(FrameRenderRequest&)>>> slideOuts = {
+        { "from EyeZoom", [](FrameRenderRequest& r) { r.isTransitioningFromEyeZoom = true; } },
+        { "from a sliding mode",
+          [](FrameRenderRequest& r) {
+              r.fromSlideMirrorsIn = true;
+              r.mirrorSlideProgress = 0.5f;
+          } },
+    };
+    for (const auto& slideOut : slideOuts) {
+        SetTestContext(slideOut.first);
+        FrameRenderRequest obs = ObsRequest();
+        FrameRenderRequest screen = ScreenRequest();
+        slideOut.second(obs);
+        slideOut.second(screen);
+        CHECK(HashOverlayStack(obs, true, plain, 0.0f) != HashOverlayStack(screen, false, plain, 0.0f));
+        screen.excludeOnlyOnMyScreen = true;
+        CHECK_EQ(HashOverlayStack(obs, true, plain, 0.0f), HashOverlayStack(screen, false, plain, 0.0f));
+    }
+    SetTestContext("");
+
+    // A finished slide has nothing left to slide out
+    FrameRenderRequest obs = ObsRequest();
+    FrameRenderRequest screen = ScreenRequest();
+    obs.fromSlideMirrorsIn = screen.fromSlideMirrorsIn = true;
+    CHECK_EQ(HashOverlayStack(obs, true, plain, 0.0f), HashOverlayStack(screen, false, plain, 0.0f));
+}
+
+TEST_CASE(ListAndTimelineChangeTheKey) {
+    ModeRenderList list, otherList;
+    const FrameRenderRequest obs = ObsRequest();
+    const FrameRenderRequest screen = ScreenRequest();
+
+    // Another list (another mode, snapshot or visibility toggle) is another stack
+    CHECK(HashOverlayStack(obs, true, list, 0.0f) != HashOverlayStack(screen, false, otherList, 0.0f));
+
+    // Static overlays look the same at any time; animated ones only at the same timeline position
+    CHECK_EQ(HashOverlayStack(obs, true, list, 1.0f), HashOverlayStack(screen, false, list, 2.0f));
+    list.hasAnimatedOverlays = true;
+    CHECK(HashOverlayStack(obs, true, list, 1.0f) != HashOverlayStack(screen, false, list, 2.0f));
+    CHECK_EQ(HashOverlayStack(obs, true, list, 1.5f), HashOverlayStack(screen, false, list, 1.5f));
+}
@@ -0,0 +1,88 @@
+// ============================================================================
+// OVERLAY_TIMELINE_BENCH.CPP - Per-frame cost of hundreds of overlay timelines
+// ============================================================================
+// Evaluates 100 to 1000 random tracks (2 to 8 keyframes, up to 12 s, mixed easings) at one frame time, as
+// the render thread does once per frame, through the compiled tracks and through EvaluateOverlayKeyframes.
+// Also times compiling the tracks, which happens when a mode's render list is rebuilt.
+// ============================================================================
+
+#include "bench_common.h"
+#include "overlay_timeline.h"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<OverlayTimelineConfig> MakeTracks(int count) {
+    std::mt19937 rng(400);
+    std::vector<OverlayTimelineConfig> tracks(count);
+    for (OverlayTimelineConfig& track : tracks) {
+        track.loop = (rng() & 1) != 0;
+        const int keyframes = 2 + static_cast<int>(rng() % 7);
+        int timeMs = 0;
+        for (int i = 0; i < keyframes; i++) {
+            OverlayKeyframeConfig k;
+            k.timeMs = timeMs;
+            k.x = static_cast<int>(rng() % 401) - 200;
+            k.y = static_cast<int>(rng() % 401) - 200;
+            k.scale = 0.5f + static_cast<float>(rng() % 101) / 100.0f;
+            k.opacity = static_cast<float>(rng() % 101) / 100.0f;
+            k.easing = static_cast<EasingType>(rng() % 4);
+            track.keyframes.push_back(k);
+            timeMs += 100 + static_cast<int>(rng() % 1500);
+        }
+    }
+    return tracks;
+}
+
+uint64_t Bits(float f) {
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+} // namespace
+
+int main() {
+    printf("%6s %16s %16s %9s %16s\n", "tracks", "compiled us/fr", "keyframes us/fr", "speedup", "compile us");
+    for (int count : { 100, 400, 1000 }) {
+        const std::vector<OverlayTimelineConfig> tracks = MakeTracks(count);
+        std::vector<CompiledOverlayTimeline> compiled(tracks.size());
+
+        const double compileNs = BenchNsPerCall(
+            [&] {
+                for (size_t i = 0; i < tracks.size(); i++) CompileOverlayTimeline(tracks[i], compiled[i]);
+                BenchKeep(static_cast<uint64_t>(compiled.back().DurationSeconds()));
+            },
+            3);
+
+        // Advance one 144 Hz frame per call so reads move through the tracks like they do on screen
+        float seconds = 0.0f;
+        const double compiledNs = BenchNsPerCall([&] {
+            seconds += 1.0f / 144.0f;
+            float sum = 0.0f;
+            float v[TIMELINE_CHANNEL_COUNT];
+            for (const CompiledOverlayTimeline& track : compiled) {
+                track.Evaluate(seconds, v);
+                sum += v[TIMELINE_X] + v[TIMELINE_OPACITY];
+            }
+            BenchKeep(Bits(sum));
+        });
+        seconds = 0.0f;
+        const double referenceNs = BenchNsPerCall([&] {
+            seconds += 1.0f / 144.0f;
+            float sum = 0.0f;
+            float v[TIMELINE_CHANNEL_COUNT];
+            for (const OverlayTimelineConfig& track : tracks) {
+                EvaluateOverlayKeyframes(track, seconds, v);
+                sum += v[TIMELINE_X] + v[TIMELINE_OPACITY];
+            }
+            BenchKeep(Bits(sum));
+        });
+        printf("%6d %16.2f %16.2f %8.1fx %16.1f\n", count, compiledNs / 1e3, referenceNs / 1e3, referenceNs / compiledNs, compileNs / 1e3);
+    }
+    return 0;
+}
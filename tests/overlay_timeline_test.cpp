@@ -0,0 +1,306 @@
+// ============================================================================
+// OVERLAY_TIMELINE_TEST.CPP - Compiled overlay timelines against EvaluateOverlayKeyframes
+// ============================================================================
+// Compiled tracks are compared with the reference evaluator on a 50 us grid: random tracks for the error
+// bound documented in overlay_timeline.h, a reversal at a keyframe for the worst case, and the edge cases
+// (no keyframes, a single keyframe, unsorted keyframes, hold, loop wrap, the row cap).
+// ============================================================================
+
+#include "overlay_timeline.h"
+#include "test_common.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace {
+
+OverlayKeyframeConfig Key(int timeMs, int x, int y, EasingType easing = EasingType::Linear) {
+    OverlayKeyframeConfig k;
+    k.timeMs = timeMs;
+    k.x = x;
+    k.y = y;
+    k.easing = easing;
+    return k;
+}
+
+// Largest |compiled - reference| over [from, to] seconds for the given channels, every `step` seconds
+float MaxError(const OverlayTimelineConfig& config, const CompiledOverlayTimeline& compiled, float from, float to,
+               std::initializer_list<int> channels = { TIMELINE_X, TIMELINE_Y }, double step = 50e-6) {
+    float worst = 0.0f;
+    for (double s = from; s <= to; s += step) {
+        float a[TIMELINE_CHANNEL_COUNT], b[TIMELINE_CHANNEL_COUNT];
+        compiled.Evaluate(static_cast<float>(s), a);
+        EvaluateOverlayKeyframes(config, static_cast<float>(s), b);
+        for (int c : channels) worst = (std::max)(worst, std::fabs(a[c] - b[c]));
+    }
+    return worst;
+}
+
+// Fastest x or y motion of a track: distance over time, times the easing's peak slope
+float PeakSpeed(const OverlayTimelineConfig& config) {
+    float peak = 0.0f;
+    for (size_t i = 0; i + 1 < config.keyframes.size(); i++) {
+        const OverlayKeyframeConfig& a = config.keyframes[i];
+        const OverlayKeyframeConfig& b = config.keyframes[i + 1];
+        const float distance = static_cast<float>((std::max)(std::abs(b.x - a.x), std::abs(b.y - a.y)));
+        const float slope = a.easing == EasingType::Linear ? 1.0f : 3.0f; // Cubic easings peak at 3x the mean
+        peak = (std::max)(peak, distance / ((b.timeMs - a.timeMs) / 1000.0f) * slope);
+    }
+    return peak;
+}
+
+// Random sorted track up to about 12 s, scaled so that its peak speed is just under `speed` px/s
+OverlayTimelineConfig RandomTrack(std::mt19937& rng, float speed) {
+    OverlayTimelineConfig config;
+    config.loop = (rng() & 1) != 0;
+    const int count = 2 + static_cast<int>(rng() % 6);
+    int timeMs = 0;
+    for (int i = 0; i < count; i++) {
+        OverlayKeyframeConfig k = Key(timeMs, static_cast<int>(rng() % 2001) - 1000, static_cast<int>(rng() % 2001) - 1000,
+                                      static_cast<EasingType>(rng() % 4));
+        k.opacity = static_cast<float>(rng() % 101) / 100.0f;
+        k.scale = 0.5f + static_cast<float>(rng() % 101) / 100.0f;
+        config.keyframes.push_back(k);
+        timeMs += 50 + static_cast<int>(rng() % 2000);
+    }
+    // Scale positions; positions are whole pixels, so back off until rounding no longer overshoots
+    const OverlayTimelineConfig unscaled = config;
+    for (float factor = speed / PeakSpeed(unscaled);; factor *= 0.995f) {
+        for (size_t i = 0; i < config.keyframes.size(); i++) {
+            config.keyframes[i].x = static_cast<int>(std::lround(unscaled.keyframes[i].x * factor));
+            config.keyframes[i].y = static_cast<int>(std::lround(unscaled.keyframes[i].y * factor));
+        }
+        if (PeakSpeed(config) <= speed) return config;
+    }
+}
+
+void CheckIdentity(const float* v) {
+    for (int c = 0; c < TIMELINE_CHANNEL_COUNT; c++) {
+        CHECK_EQ(v[c], (c == TIMELINE_SCALE || c == TIMELINE_OPACITY) ? 1.0f : 0.0f);
+    }
+}
+
+} // namespace
+
+TEST_CASE(NoKeyframesIsIdentity) {
+    OverlayTimelineConfig config;
+    CompiledOverlayTimeline compiled;
+    CompileOverlayTimeline(config, compiled);
+    CHECK(!compiled.IsAnimated());
+    float v[TIMELINE_CHANNEL_COUNT];
+    for (float s : { -1.0f, 0.0f, 2.5f }) {
+        compiled.Evaluate(s, v);
+        CheckIdentity(v);
+        EvaluateOverlayKeyframes(config, s, v);
+        CheckIdentity(v);
+    }
+    OverlayPlacement placement;
+    placement.x = 7;
+    placement.cropTop = 3;
+    ApplyOverlayTimeline(compiled, 1.0f, placement);
+    CHECK_EQ(placement.x, 7);
+    CHECK_EQ(placement.cropTop, 3);
+}
+
+TEST_CASE(SingleKeyframeIsAConstantPose) {
+    for (int timeMs : { 0, 500 }) {
+        SetTestContext("keyframe at " + std::to_string(timeMs) + " ms");
+        OverlayTimelineConfig config;
+        OverlayKeyframeConfig k = Key(timeMs, 40, -25);
+        k.scale = 2.0f;
+        k.opacity = 0.25f;
+        k.cropLeft = 6;
+        config.keyframes.push_back(k);
+        CompiledOverlayTimeline compiled;
+        CompileOverlayTimeline(config, compiled);
+        CHECK(compiled.IsAnimated());
+        for (float s : { -0.1f, 0.0f, 0.3f, 0.5f, 0.75f, 10.0f }) {
+            float a[TIMELINE_CHANNEL_COUNT], b[TIMELINE_CHANNEL_COUNT];
+            compiled.Evaluate(s, a);
+            EvaluateOverlayKeyframes(config, s, b);
+            CHECK_EQ(a[TIMELINE_X], 40.0f);
+            CHECK_EQ(a[TIMELINE_Y], -25.0f);
+            CHECK_EQ(a[TIMELINE_SCALE], 2.0f);
+            CHECK_EQ(a[TIMELINE_OPACITY], 0.25f);
+            CHECK_EQ(a[TIMELINE_CROP_LEFT], 6.0f);
+            for (int c = 0; c < TIMELINE_CHANNEL_COUNT; c++) CHECK_EQ(a[c], b[c]);
+        }
+    }
+}
+
+TEST_CASE(UnsortedKeyframesCompileLikeSortedOnes) {
+    OverlayTimelineConfig sorted;
+    sorted.keyframes = { Key(0, 0, 0, EasingType::EaseOut), Key(200, 100, 50, EasingType::EaseInOut), Key(450, -80, 0), Key(900, 10, 10) };
+    OverlayTimelineConfig shuffled = sorted;
+    std::swap(shuffled.keyframes[0], shuffled.keyframes[3]);
+    std::swap(shuffled.keyframes[1], shuffled.keyframes[2]);
+    CompiledOverlayTimeline a, b;
+    CompileOverlayTimeline(sorted, a);
+    CompileOverlayTimeline(shuffled, b);
+    CHECK_EQ(a.DurationSeconds(), b.DurationSeconds());
+    for (int ms = -10; ms <= 2000; ms++) {
+        float va[TIMELINE_CHANNEL_COUNT], vb[TIMELINE_CHANNEL_COUNT], ref[TIMELINE_CHANNEL_COUNT];
+        a.Evaluate(ms / 1000.0f, va);
+        b.Evaluate(ms / 1000.0f, vb);
+        EvaluateOverlayKeyframes(shuffled, ms / 1000.0f, ref);
+        for (int c = 0; c < TIMELINE_CHANNEL_COUNT; c++) CHECK_EQ(va[c], vb[c]);
+        CHECK(std::fabs(va[TIMELINE_X] - ref[TIMELINE_X]) < 1.0f);
+    }
+
+    // Negative times count as 0; equal times keep their config order
+    OverlayTimelineConfig negative;
+    negative.keyframes = { Key(300, 30, 0), Key(-50, 10, 0), Key(0, 20, 0) };
+    CompiledOverlayTimeline n;
+    CompileOverlayTimeline(negative, n);
+    float v[TIMELINE_CHANNEL_COUNT];
+    n.Evaluate(0.0f, v);
+    CHECK_EQ(v[TIMELINE_X], 20.0f); // The later of the two time-0 keyframes wins at t = 0
+    CHECK_NEAR(n.DurationSeconds(), 0.3f, 1e-6f);
+}
+
+TEST_CASE(HoldKeepsTheLastKeyframe) {
+    OverlayTimelineConfig config;
+    config.loop = false;
+    config.keyframes = { Key(100, 0, 0, EasingType::EaseIn), Key(400, 300, -120) };
+    config.keyframes[1].opacity = 0.0f;
+    CompiledOverlayTimeline compiled;
+    CompileOverlayTimeline(config, compiled);
+    CHECK_NEAR(compiled.DurationSeconds(), 0.4f, 1e-6f);
+
+    // Before the first keyframe: hold it
+    for (float s : { -5.0f, 0.0f, 0.05f, 0.1f }) {
+        float v[TIMELINE_CHANNEL_COUNT];
+        compiled.Evaluate(s, v);
+        CHECK_NEAR(v[TIMELINE_X], 0.0f, 1e-3f);
+        CHECK_NEAR(v[TIMELINE_OPACITY], 1.0f, 1e-6f);
+    }
+    // At and after the last: exactly the last keyframe, forever
+    for (float s : { 0.4f, 0.41f, 1.0f, 3600.0f }) {
+        float v[TIMELINE_CHANNEL_COUNT];
+        compiled.Evaluate(s, v);
+        CHECK_EQ(v[TIMELINE_X], 300.0f);
+        CHECK_EQ(v[TIMELINE_Y], -120.0f);
+        CHECK_EQ(v[TIMELINE_OPACITY], 0.0f);
+    }
+    CHECK(MaxError(config, compiled, -0.1f, 1.0f) < 1.0f);
+}
+
+TEST_CASE(LoopWrapsToTheFirstKeyframe) {
+    OverlayTimelineConfig config;
+    config.loop = true;
+    config.keyframes = { Key(0, 0, 0, EasingType::EaseInOut), Key(250, 120, 60, EasingType::Linear), Key(500, 0, 0) };
+    config.keyframes[1].scale = 1.5f;
+    CompiledOverlayTimeline compiled;
+    CompileOverlayTimeline(config, compiled);
+    CHECK_NEAR(compiled.DurationSeconds(), 0.5f, 1e-6f);
+
+    // Every later cycle repeats the first
+    for (int ms = 0; ms < 500; ms += 3) {
+        float first[TIMELINE_CHANNEL_COUNT];
+        compiled.Evaluate(ms / 1000.0f, first);
+        for (int cycle : { 1, 2, 7 }) {
+            float later[TIMELINE_CHANNEL_COUNT];
+            compiled.Evaluate(cycle * 0.5f + ms / 1000.0f, later);
+            CHECK_NEAR(later[TIMELINE_X], first[TIMELINE_X], 0.05f);
+            CHECK_NEAR(later[TIMELINE_SCALE], first[TIMELINE_SCALE], 1e-3f);
+        }
+    }
+    // The wrap itself starts over from the first keyframe
+    float v[TIMELINE_CHANNEL_COUNT];
+    compiled.Evaluate(0.5f, v);
+    CHECK_NEAR(v[TIMELINE_X], 0.0f, 1e-3f);
+    compiled.Evaluate(1.0f + 1e-4f, v);
+    CHECK(v[TIMELINE_X] < 1.0f);
+    CHECK(MaxError(config, compiled, 0.0f, 2.0f) < 1.0f);
+}
+
+TEST_CASE(CompiledTracksStayWithinAPixel) {
+    // overlay_timeline.h: under a pixel up to about 450 px/s, also when the motion reverses at a keyframe
+    std::mt19937 rng(73);
+    float worst = 0.0f;
+    for (int i = 0; i < 200; i++) {
+        SetTestContext("track " + std::to_string(i));
+        const OverlayTimelineConfig config = RandomTrack(rng, 450.0f);
+        CompiledOverlayTimeline compiled;
+        CompileOverlayTimeline(config, compiled);
+        const float duration = compiled.DurationSeconds();
+        const float error = MaxError(config, compiled, 0.0f, duration * 1.25f, { TIMELINE_X, TIMELINE_Y }, 100e-6);
+        CHECK(error < 1.0f);
+        worst = (std::max)(worst, error);
+    }
+    SetTestContext("");
+    std::printf("     worst position error at 450 px/s: %.2f px\n", worst);
+}
+
+TEST_CASE(CornerCutAtAKeyframeIsBoundedBySpeedChange) {
+    // 1000 px/s that stops, or reverses, between two rows: the worst case for the linear rows
+    for (int stopMs = 400; stopMs < 405; stopMs++) {
+        SetTestContext("stop at " + std::to_string(stopMs) + " ms");
+        OverlayTimelineConfig stop;
+        stop.loop = false;
+        stop.keyframes = { Key(0, 0, 0), Key(stopMs, stopMs, 0), Key(stopMs + 400, stopMs, 0) };
+        OverlayTimelineConfig reverse = stop;
+        reverse.keyframes[2].x = stopMs - 400;
+        CompiledOverlayTimeline compiledStop, compiledReverse;
+        CompileOverlayTimeline(stop, compiledStop);
+        CompileOverlayTimeline(reverse, compiledReverse);
+
+        // A quarter row (1/960 s) times the change of speed
+        CHECK(MaxError(stop, compiledStop, 0.0f, 1.0f) <= 1000.0f / 960.0f + 0.01f);
+        CHECK(MaxError(reverse, compiledReverse, 0.0f, 1.0f) <= 2000.0f / 960.0f + 0.01f);
+    }
+}
+
+TEST_CASE(LongTimelinesAreSampledMoreCoarsely) {
+    // 60 s with 4096 rows: about 68 rows per second
+    OverlayTimelineConfig config;
+    config.loop = false;
+    config.keyframes = { Key(0, 0, 0, EasingType::EaseInOut), Key(30000, 3000, 0, EasingType::EaseInOut), Key(60000, 0, 0) };
+    CompiledOverlayTimeline compiled;
+    CompileOverlayTimeline(config, compiled);
+    CHECK_NEAR(compiled.DurationSeconds(), 60.0f, 1e-4f);
+    // Slow and smooth, so still well under a pixel
+    CHECK(MaxError(config, compiled, 0.0f, 60.0f) < 0.1f);
+    float v[TIMELINE_CHANNEL_COUNT];
+    compiled.Evaluate(61.0f, v);
+    CHECK_EQ(v[TIMELINE_X], 0.0f);
+}
+
+TEST_CASE(ApplyRoundsOffsetsAndClampsMultipliers) {
+    OverlayTimelineConfig config;
+    OverlayKeyframeConfig k = Key(0, 3, -4);
+    k.scale = -2.0f;
+    k.opacity = 1.8f;
+    k.cropTop = -50;
+    k.cropRight = 7;
+    config.keyframes.push_back(k);
+    CompiledOverlayTimeline compiled;
+    CompileOverlayTimeline(config, compiled);
+
+    OverlayPlacement placement;
+    placement.x = 100;
+    placement.y = 100;
+    placement.scale = 2.0f;
+    placement.opacity = 0.5f;
+    placement.cropTop = 20;
+    placement.cropRight = 1;
+    ApplyOverlayTimeline(compiled, 0.0f, placement);
+    CHECK_EQ(placement.x, 103);
+    CHECK_EQ(placement.y, 96);
+    CHECK_EQ(placement.scale, 0.0f);     // Negative scale clamps to 0
+    CHECK_EQ(placement.opacity, 0.5f);   // Opacity multiplier clamps to 1
+    CHECK_EQ(placement.cropTop, 0);      // Crop never goes below 0
+    CHECK_EQ(placement.cropRight, 8);
+
+    // Offsets round to the nearest pixel
+    OverlayTimelineConfig moving;
+    moving.keyframes = { Key(0, 0, 0), Key(1000, 10, -10) };
+    CompileOverlayTimeline(moving, compiled);
+    OverlayPlacement p;
+    ApplyOverlayTimeline(compiled, 0.46f, p);
+    CHECK_EQ(p.x, 5);
+    CHECK_EQ(p.y, -5);
+}
@@ -0,0 +1,388 @@
+// ============================================================================
+// PROGRAM_CACHE_TEST.CPP - Program binary cache keys, file format and fallback to compilation
+// ============================================================================
+// The key and file format cases need no GL. The GL cases build programs the way RT_CreateShaderProgram does
+// (LoadCachedProgram, else compile, PrepareProgramForCache, link, StoreCachedProgram) on the headless
+// context, with g_toolscreenPath pointing at a fresh temporary directory, and check that every file the
+// cache cannot use (another driver's, truncated, corrupt, rejected by the driver) is deleted and replaced
+// by a compiled program. The last case times the render thread's shader set cold and warm.
+// ============================================================================
+
+#include "gl_test_context.h"
+#include "program_cache.h"
+#include "render_shaders.h"
+#include "test_common.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+std::wstring g_toolscreenPath;
+
+namespace {
+
+const char* const kVert = "#version 330 core\nlayout(location = 0) in vec2 aPos;\nvoid main() { gl_Position = vec4(aPos, 0.0, 1.0); }\n";
+const char* const kFrag = "#version 330 core\nout vec4 FragColor;\nuniform vec4 u_color;\nvoid main() { FragColor = u_color; }\n";
+
+ProgramBinaryBlob SampleBlob() {
+    ProgramBinaryBlob blob;
+    blob.format = 0x8D64;
+    for (int i = 0; i < 300; i++) blob.data.push_back(static_cast<uint8_t>(i * 31 + 7));
+    return blob;
+}
+
+bool Parses(const std::vector<uint8_t>& bytes, const ProgramCacheKey& key) {
+    ProgramBinaryBlob out;
+    return ParseProgramBinary(bytes.data(), bytes.size(), key, out);
+}
+
+// === GL side ===
+
+// Points the cache at an empty directory for the rest of the process, removed again at exit
+struct CacheRoot {
+    std::filesystem::path path;
+    ~CacheRoot() {
+        std::error_code ec;
+        if (!path.empty()) std::filesystem::remove_all(path, ec);
+    }
+};
+
+std::filesystem::path UseFreshCacheRoot() {
+    static CacheRoot s_root;
+    if (s_root.path.empty()) {
+        s_root.path = std::filesystem::temp_directory_path() / ("toolscreen_program_cache_test_" + std::to_string(getpid()));
+        std::filesystem::remove_all(s_root.path);
+        std::filesystem::create_directories(s_root.path);
+        g_toolscreenPath = (s_root.path / "toolscreen").wstring();
+    }
+    return s_root.path;
+}
+
+// Where CachePath puts a key's file (Win32 separators included, see wgl_shim.cpp)
+std::filesystem::path CacheFile(const ProgramCacheKey& key) {
+    const std::string name = key.FileName();
+    return std::filesystem::path(g_toolscreenPath + L"\\shader_cache\\" + std::wstring(name.begin(), name.end()));
+}
+
+void RequireBinaryCache() {
+    RequireGLContext();
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats <= 0) SkipTestCase("driver reports no program binary formats");
+    UseFreshCacheRoot();
+}
+
+GLuint Compile(GLenum type, const char* src) {
+    GLuint s = glCreateShader(type);
+    glShaderSource(s, 1, &src, nullptr);
+    glCompileShader(s);
+    GLint ok = GL_FALSE;
+    glGetShaderiv(s, GL_COMPILE_STATUS, &ok);
+    REQUIRE(ok);
+    return s;
+}
+
+struct BuildResult {
+    GLuint program = 0;
+    bool fromCache = false;
+};
+
+// RT_CreateShaderProgram
+BuildResult BuildProgram(const char* vert, const char* frag) {
+    const char* sources[] = { vert, frag };
+    const ProgramCacheKey key = MakeProgramCacheKeyForCurrentContext(sources, 2);
+    if (GLuint cached = LoadCachedProgram(key)) return { cached, true };
+
+    GLuint v = Compile(GL_VERTEX_SHADER, vert);
+    GLuint f = Compile(GL_FRAGMENT_SHADER, frag);
+    GLuint p = glCreateProgram();
+    glAttachShader(p, v);
+    glAttachShader(p, f);
+    PrepareProgramForCache(p);
+    glLinkProgram(p);
+    GLint ok = GL_FALSE;
+    glGetProgramiv(p, GL_LINK_STATUS, &ok);
+    REQUIRE(ok);
+    StoreCachedProgram(key, p);
+    glDeleteShader(v);
+    glDeleteShader(f);
+    return { p, false };
+}
+
+ProgramCacheKey CurrentKey(const char* vert, const char* frag) {
+    const char* sources[] = { vert, frag };
+    return MakeProgramCacheKeyForCurrentContext(sources, 2);
+}
+
+std::vector<uint8_t> ReadFile(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void WriteFile(const std::filesystem::path& path, const std::vector<uint8_t>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+// The program draws u_color - proves a restored binary is a working program, not just a linked one
+void CheckProgramDraws(GLuint program) {
+    const GLuint texture = CreateTestTexture(4, 4);
+    const GLuint fbo = CreateTestFramebuffer(texture);
+    GLuint vao = 0, vbo = 0;
+    const float verts[] = { -1, -1, 3, -1, -1, 3 };
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glViewport(0, 0, 4, 4);
+    glUseProgram(program);
+    glUniform4f(glGetUniformLocation(program, "u_color"), 1.0f, 0.5f, 0.0f, 1.0f);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    const std::vector<uint8_t> px = ReadTestFramebuffer(fbo, 4, 4);
+    CHECK(px[0] == 255 && px[1] >= 127 && px[1] <= 128 && px[2] == 0 && px[3] == 255);
+    glUseProgram(0);
+    glDeleteBuffers(1, &vbo);
+    glDeleteVertexArrays(1, &vao);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &texture);
+}
+
+// Replaces the cached file, checks the next build compiles from source and rewrites a usable entry
+void ExpectFallbackFor(const std::vector<uint8_t>& badFile) {
+    const ProgramCacheKey key = CurrentKey(kVert, kFrag);
+    WriteFile(CacheFile(key), badFile);
+    TakeTestLogMessages();
+
+    const BuildResult compiled = BuildProgram(kVert, kFrag);
+    CHECK(!compiled.fromCache);
+    CheckProgramDraws(compiled.program);
+    glDeleteProgram(compiled.program);
+
+    // The bad file was replaced by a fresh binary
+    ProgramBinaryBlob blob;
+    const std::vector<uint8_t> rewritten = ReadFile(CacheFile(key));
+    CHECK(ParseProgramBinary(rewritten.data(), rewritten.size(), key, blob));
+    const BuildResult restored = BuildProgram(kVert, kFrag);
+    CHECK(restored.fromCache);
+    glDeleteProgram(restored.program);
+}
+
+} // namespace
+
+TEST_CASE(KeyDependsOnEverySourceAndTheDriver) {
+    const char* ab_c[] = { "ab", "c" };
+    const char* a_bc[] = { "a", "bc" };
+    const char* abc[] = { "abc" };
+    const ProgramCacheKey k1 = MakeProgramCacheKey(ab_c, 2, "Mesa\nllvmpipe\n4.5\n4.50\n");
+    CHECK(k1.sourceHash == MakeProgramCacheKey(ab_c, 2, "Mesa\nllvmpipe\n4.5\n4.50\n").sourceHash);
+    CHECK(k1.sourceHash != MakeProgramCacheKey(a_bc, 2, "Mesa\nllvmpipe\n4.5\n4.50\n").sourceHash);
+    CHECK(k1.sourceHash != MakeProgramCacheKey(abc, 1, "Mesa\nllvmpipe\n4.5\n4.50\n").sourceHash);
+    const char* reordered[] = { "c", "ab" };
+    CHECK(k1.sourceHash != MakeProgramCacheKey(reordered, 2, "Mesa\nllvmpipe\n4.5\n4.50\n").sourceHash);
+
+    // Vendor, renderer or version changes: same sources, different driver hash and file
+    const char* drivers[] = { "NVIDIA Corporation\nllvmpipe\n4.5\n4.50\n", "Mesa\nradeonsi\n4.5\n4.50\n", "Mesa\nllvmpipe\n4.6\n4.50\n",
+                              "Mesa\nllvmpipe\n4.5\n4.60\n" };
+    for (const char* driver : drivers) {
+        const ProgramCacheKey k2 = MakeProgramCacheKey(ab_c, 2, driver);
+        CHECK_EQ(k2.sourceHash, k1.sourceHash);
+        CHECK(k2.driverHash != k1.driverHash);
+        CHECK(k2.FileName() != k1.FileName());
+    }
+
+    // A missing source hashes like an empty one
+    const char* withNull[] = { "ab", nullptr };
+    const char* withEmpty[] = { "ab", "" };
+    CHECK_EQ(MakeProgramCacheKey(withNull, 2, "d").sourceHash, MakeProgramCacheKey(withEmpty, 2, "d").sourceHash);
+}
+
+TEST_CASE(FileNameIsThirtyTwoHexDigits) {
+    ProgramCacheKey key;
+    key.sourceHash = 0x0123456789abcdefull;
+    key.driverHash = 0xfedcba9876543210ull;
+    CHECK_EQ(key.FileName(), std::string("0123456789abcdeffedcba9876543210.bin"));
+    key.sourceHash = 1;
+    key.driverHash = 0;
+    CHECK_EQ(key.FileName(), std::string("00000000000000010000000000000000.bin"));
+}
+
+TEST_CASE(SerializedBinaryRoundTrips) {
+    const char* sources[] = { kVert, kFrag };
+    const ProgramCacheKey key = MakeProgramCacheKey(sources, 2, "driver");
+    const ProgramBinaryBlob blob = SampleBlob();
+    const std::vector<uint8_t> bytes = SerializeProgramBinary(key, blob);
+    CHECK_EQ(bytes.size(), 40u + blob.data.size());
+
+    // Little-endian header fields at fixed offsets
+    CHECK(bytes[0] == 'T' && bytes[1] == 'S' && bytes[2] == 'P' && bytes[3] == 'B');
+    CHECK_EQ(bytes[4], static_cast<uint8_t>(PROGRAM_CACHE_FORMAT_VERSION));
+
+    ProgramBinaryBlob out;
+    REQUIRE(ParseProgramBinary(bytes.data(), bytes.size(), key, out));
+    CHECK_EQ(out.format, blob.format);
+    CHECK(out.data == blob.data);
+}
+
+TEST_CASE(ParseRejectsOtherKeysAndVersions) {
+    const char* sources[] = { kVert, kFrag };
+    const ProgramCacheKey key = MakeProgramCacheKey(sources, 2, "Mesa\nllvmpipe\n");
+    const std::vector<uint8_t> bytes = SerializeProgramBinary(key, SampleBlob());
+
+    // Written by another driver (a copied cache directory) or for other sources
+    CHECK(!Parses(bytes, MakeProgramCacheKey(sources, 2, "NVIDIA Corporation\nGeForce\n")));
+    CHECK(!Parses(bytes, MakeProgramCacheKey(sources, 1, "Mesa\nllvmpipe\n")));
+
+    std::vector<uint8_t> version = bytes;
+    version[4] = static_cast<uint8_t>(PROGRAM_CACHE_FORMAT_VERSION + 1);
+    CHECK(!Parses(version, key));
+    std::vector<uint8_t> magic = bytes;
+    magic[0] ^= 0x20;
+    CHECK(!Parses(magic, key));
+}
+
+TEST_CASE(ParseRejectsTruncatedAndCorruptFiles) {
+    const char* sources[] = { kVert };
+    const ProgramCacheKey key = MakeProgramCacheKey(sources, 1, "driver");
+    const std::vector<uint8_t> bytes = SerializeProgramBinary(key, SampleBlob());
+
+    // Every truncation, including inside the header
+    int accepted = 0;
+    for (size_t len = 0; len < bytes.size(); len++) accepted += Parses(std::vector<uint8_t>(bytes.begin(), bytes.begin() + len), key);
+    CHECK_EQ(accepted, 0);
+    ProgramBinaryBlob out;
+    CHECK(!ParseProgramBinary(nullptr, 0, key, out));
+
+    // Trailing garbage
+    std::vector<uint8_t> longer = bytes;
+    longer.push_back(0);
+    CHECK(!Parses(longer, key));
+
+    // Any flipped payload bit fails the checksum
+    int flippedAccepted = 0;
+    for (size_t i = 40; i < bytes.size(); i += 7) {
+        std::vector<uint8_t> corrupt = bytes;
+        corrupt[i] ^= static_cast<uint8_t>(1u << (i % 8));
+        flippedAccepted += Parses(corrupt, key);
+    }
+    CHECK_EQ(flippedAccepted, 0);
+
+    // Corrupt length field: larger, smaller, absurd and zero
+    for (uint32_t length : { 301u, 299u, 0x7fffffffu }) {
+        std::vector<uint8_t> corrupt = bytes;
+        for (int b = 0; b < 4; b++) corrupt[28 + b] = static_cast<uint8_t>(length >> (b * 8));
+        CHECK(!Parses(corrupt, key));
+    }
+    ProgramBinaryBlob empty;
+    const std::vector<uint8_t> emptyBytes = SerializeProgramBinary(key, empty);
+    CHECK(!Parses(emptyBytes, key));
+}
+
+TEST_CASE(SecondBuildLoadsTheStoredBinary) {
+    RequireBinaryCache();
+    const ProgramCacheKey key = CurrentKey(kVert, kFrag);
+    std::filesystem::remove(CacheFile(key));
+
+    const BuildResult first = BuildProgram(kVert, kFrag);
+    CHECK(!first.fromCache);
+    CHECK(std::filesystem::exists(CacheFile(key)));
+    glDeleteProgram(first.program);
+
+    const BuildResult second = BuildProgram(kVert, kFrag);
+    CHECK(second.fromCache);
+    CheckProgramDraws(second.program);
+    glDeleteProgram(second.program);
+
+    // No temp files are left behind
+    int stray = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(UseFreshCacheRoot())) {
+        stray += entry.path().extension() == ".tmp";
+    }
+    CHECK_EQ(stray, 0);
+}
+
+TEST_CASE(OtherDriversFileAtThisPathFallsBackToCompilation) {
+    RequireBinaryCache();
+    const char* sources[] = { kVert, kFrag };
+    const ProgramCacheKey key = CurrentKey(kVert, kFrag);
+    const ProgramCacheKey otherDriver = MakeProgramCacheKey(sources, 2, "Other Vendor\nOther GPU\n4.6\n4.60\n");
+    CHECK_EQ(otherDriver.sourceHash, key.sourceHash);
+    CHECK(otherDriver.FileName() != key.FileName());
+    ExpectFallbackFor(SerializeProgramBinary(otherDriver, SampleBlob()));
+}
+
+TEST_CASE(TruncatedFileFallsBackToCompilation) {
+    RequireBinaryCache();
+    const ProgramCacheKey key = CurrentKey(kVert, kFrag);
+    BuildResult warm = BuildProgram(kVert, kFrag);
+    glDeleteProgram(warm.program);
+    std::vector<uint8_t> bytes = ReadFile(CacheFile(key));
+    REQUIRE(bytes.size() > 40);
+    ExpectFallbackFor(std::vector<uint8_t>(bytes.begin(), bytes.begin() + bytes.size() / 2));
+    ExpectFallbackFor(std::vector<uint8_t>(bytes.begin(), bytes.begin() + 20));
+    ExpectFallbackFor({});
+}
+
+TEST_CASE(CorruptFileFallsBackToCompilation) {
+    RequireBinaryCache();
+    const ProgramCacheKey key = CurrentKey(kVert, kFrag);
+    BuildResult warm = BuildProgram(kVert, kFrag);
+    glDeleteProgram(warm.program);
+    std::vector<uint8_t> bytes = ReadFile(CacheFile(key));
+    REQUIRE(bytes.size() > 64);
+    bytes[bytes.size() / 2] ^= 0x5A;
+    ExpectFallbackFor(bytes);
+}
+
+TEST_CASE(BinaryTheDriverRejectsFallsBackToCompilation) {
+    RequireBinaryCache();
+    // Valid file for this key and driver, but the payload is not a binary the driver accepts
+    const ProgramCacheKey key = CurrentKey(kVert, kFrag);
+    ExpectFallbackFor(SerializeProgramBinary(key, SampleBlob()));
+    bool logged = false;
+    for (const std::string& line : TakeTestLogMessages()) logged |= line.find("driver rejected") != std::string::npos;
+    CHECK(logged);
+}
+
+TEST_CASE(RenderThreadShadersColdAndWarm) {
+    RequireBinaryCache();
+    const char* const programs[][2] = { { rt_passthrough_vert_shader, rt_background_frag_shader },
+                                        { rt_solid_vert_shader, rt_solid_color_frag_shader },
+                                        { rt_passthrough_vert_shader, rt_image_render_frag_shader },
+                                        { rt_passthrough_vert_shader, rt_static_border_frag_shader },
+                                        { rt_passthrough_vert_shader, rt_gradient_frag_shader },
+                                        { rt_passthrough_vert_shader, rt_text_frag_shader } };
+    for (const auto& p : programs) std::filesystem::remove(CacheFile(CurrentKey(p[0], p[1])));
+
+    // RT_InitializeShaders: one report around the whole set
+    auto initialize = [&](const char* prefix) {
+        TakeTestLogMessages();
+        std::vector<GLuint> built;
+        int fromCache = 0;
+        {
+            ScopedProgramCacheReport report(prefix);
+            for (const auto& p : programs) {
+                const BuildResult r = BuildProgram(p[0], p[1]);
+                built.push_back(r.program);
+                fromCache += r.fromCache;
+            }
+            glFinish();
+        }
+        for (GLuint program : built) glDeleteProgram(program);
+        const std::vector<std::string> log = TakeTestLogMessages();
+        REQUIRE(!log.empty());
+        std::printf("     %s\n", log.back().c_str());
+        return fromCache;
+    };
+
+    CHECK_EQ(initialize("Render Thread (cold)"), 0);
+    CHECK_EQ(initialize("Render Thread (warm)"), 6);
+}
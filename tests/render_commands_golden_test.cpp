@@ -0,0 +1,323 @@
+// ============================================================================
+// RENDER_COMMANDS_GOLDEN_TEST.CPP - Overlay layout and compositing vs reference images
+// ============================================================================
+// Frames are recorded into RenderCommandLists the way the render thread records them (overlay placement and
+// timelines, backgrounds, SDF and four-quad borders, color keys, the gradient background, the EyeZoom strip,
+// a retained layer composited over the frame) and rasterized with SoftwareRenderBackend. The results are
+// compared with the reference images in tests/golden/ (PAM, top row first), so a change to layout or blend
+// semantics shows up as a pixel difference.
+//
+// After an intended change, regenerate the references and review them like any other diff:
+//   TOOLSCREEN_UPDATE_GOLDEN=1 build-tests/render_commands_golden_test
+// A failing comparison writes the actual image next to the test executable's working directory.
+// ============================================================================
+
+#include "eyezoom_layout.h"
+#include "overlay_timeline.h"
+#include "render_commands.h"
+#include "render_commands_sw.h"
+#include "test_common.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef TOOLSCREEN_GOLDEN_DIR
+#error "TOOLSCREEN_GOLDEN_DIR must point at tests/golden"
+#endif
+
+namespace {
+
+// Per-channel slack for float differences between compilers and FMA contraction
+constexpr int GOLDEN_TOLERANCE = 1;
+
+enum : uint32_t { TEX_GAME = 1, TEX_PHOTO, TEX_ICON, TEX_FONT, TEX_LAYER };
+
+bool WritePam(const std::string& path, const SoftwareImage& img) {
+    std::ofstream f(path, std::ios::binary);
+    if (!f) return false;
+    f << "P7\nWIDTH " << img.width << "\nHEIGHT " << img.height << "\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n";
+    for (int y = img.height - 1; y >= 0; y--) f.write(reinterpret_cast<const char*>(img.At(0, y)), static_cast<std::streamsize>(img.width) * 4);
+    return static_cast<bool>(f);
+}
+
+bool ReadPam(const std::string& path, SoftwareImage& img) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return false;
+    std::string line, key;
+    int w = 0, h = 0, depth = 0, maxval = 0;
+    if (!std::getline(f, line) || line != "P7") return false;
+    while (std::getline(f, line) && line != "ENDHDR") {
+        std::istringstream fields(line);
+        fields >> key;
+        if (key == "WIDTH") fields >> w;
+        else if (key == "HEIGHT") fields >> h;
+        else if (key == "DEPTH") fields >> depth;
+        else if (key == "MAXVAL") fields >> maxval;
+    }
+    if (w <= 0 || h <= 0 || depth != 4 || maxval != 255) return false;
+    img.Resize(w, h);
+    for (int y = h - 1; y >= 0; y--) f.read(reinterpret_cast<char*>(img.At(0, y)), static_cast<std::streamsize>(w) * 4);
+    return static_cast<bool>(f);
+}
+
+void CheckGolden(const std::string& name, const SoftwareImage& actual) {
+    const std::string path = std::string(TOOLSCREEN_GOLDEN_DIR) + "/" + name + ".pam";
+    const char* update = std::getenv("TOOLSCREEN_UPDATE_GOLDEN");
+    if (update && *update && *update != '0') {
+        REQUIRE(WritePam(path, actual));
+        std::printf("     wrote %s\n", path.c_str());
+        return;
+    }
+
+    SetTestContext(path);
+    SoftwareImage expected;
+    const bool loaded = ReadPam(path, expected);
+    CHECK(loaded);
+    const int differing = loaded ? CountDifferingPixels(expected, actual, GOLDEN_TOLERANCE) : actual.width * actual.height;
+    CHECK_EQ(differing, 0);
+    if (differing != 0 && WritePam(name + ".actual.pam", actual)) std::printf("     actual image: %s.actual.pam\n", name.c_str());
+}
+
+// Deterministic texture content: a bottom-up RGBA8 pattern from a per-texel function
+template <typename Fn> std::vector<uint8_t> MakePixels(int w, int h, Fn fn) {
+    std::vector<uint8_t> px(static_cast<size_t>(w) * h * 4);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) fn(x, y, &px[(static_cast<size_t>(y) * w + x) * 4]);
+    }
+    return px;
+}
+
+void SetTextures(SoftwareRenderBackend& backend) {
+    // Game frame: a checkerboard with a horizon, so the EyeZoom column shows structure
+    backend.SetTexture(TEX_GAME, 96, 80, MakePixels(96, 80, [](int x, int y, uint8_t* p) {
+                           const bool check = ((x / 8) + (y / 8)) % 2 == 0;
+                           p[0] = static_cast<uint8_t>(y < 40 ? 70 : (check ? 200 : 120));
+                           p[1] = static_cast<uint8_t>(y < 40 ? 120 + x : (check ? 180 : 90));
+                           p[2] = static_cast<uint8_t>(y < 40 ? 60 : 200 - 2 * y);
+                           p[3] = 255;
+                       }).data());
+    // Image overlay with an alpha ramp across
+    backend.SetTexture(TEX_PHOTO, 32, 20, MakePixels(32, 20, [](int x, int y, uint8_t* p) {
+                           p[0] = static_cast<uint8_t>(x * 8);
+                           p[1] = static_cast<uint8_t>(y * 12);
+                           p[2] = static_cast<uint8_t>(255 - x * 6);
+                           p[3] = static_cast<uint8_t>(128 + x * 4);
+                       }).data());
+    // Keyed icon: pure green surround around a diamond
+    backend.SetTexture(TEX_ICON, 16, 16, MakePixels(16, 16, [](int x, int y, uint8_t* p) {
+                           const bool inside = std::abs(x - 8) + std::abs(y - 8) < 7;
+                           p[0] = static_cast<uint8_t>(inside ? 240 : 0);
+                           p[1] = static_cast<uint8_t>(inside ? 200 - y * 8 : 255);
+                           p[2] = static_cast<uint8_t>(inside ? 40 : 0);
+                           p[3] = 255;
+                       }).data());
+    // Font atlas: ten 4x6 digit cells, each a different 3x5 bitmap, coverage in alpha
+    backend.SetTexture(TEX_FONT, 40, 6, MakePixels(40, 6, [](int x, int y, uint8_t* p) {
+                           static const uint16_t kDigits[10] = { 0x7B6F, 0x2492, 0x73E7, 0x73CF, 0x5BC9, 0x79CF, 0x79EF, 0x7249, 0x7BEF, 0x7BCF };
+                           const int cx = x % 4, row = 5 - y; // Atlas rows are bottom-up, bitmaps top-down with a blank last row
+                           const bool on = cx < 3 && row < 5 && ((kDigits[x / 4] >> (14 - row * 3 - cx)) & 1);
+                           p[0] = p[1] = p[2] = 255;
+                           p[3] = static_cast<uint8_t>(on ? 255 : 0);
+                       }).data());
+}
+
+// Fixed-pitch digits from the atlas above: 0.6 * size wide, one size tall
+class TestFont : public EyeZoomFont {
+  public:
+    void MeasureText(float size, const char* text, float& width, float& height) const override {
+        width = 0.6f * size * static_cast<float>(std::string(text).size());
+        height = size;
+    }
+    void AppendGlyphs(float size, const char* text, std::vector<Glyph>& out) const override {
+        float x = 0.0f;
+        for (const char* c = text; *c; c++) {
+            const int d = *c - '0';
+            out.push_back({ x, 0.0f, x + 0.6f * size, size, d / 10.0f, 1.0f, (d + 0.75f) / 10.0f, 0.0f });
+            x += 0.6f * size;
+        }
+    }
+};
+
+struct TestOverlay {
+    OverlayPlacement placement;
+    OverlayTimelineConfig timeline;
+    uint32_t texture = 0;
+    int texW = 0, texH = 0;
+    RenderFilter filter = RenderFilter::Linear;
+    bool background = false;
+    float bg[4] = {};
+    int borderShape = -1; // -1 = four-quad game border, otherwise an SDF border of that shape
+    float borderThickness = 0.0f;
+    float borderRadius = 0.0f;
+    float borderColor[4] = {};
+    bool colorKey = false;
+    float key[3] = {};
+};
+
+struct PixelRect {
+    int x, y, w, h; // Window pixels, y down
+};
+
+// RT_RecordGameBorder: four opaque quads around a window pixel rectangle
+void RecordGameBorder(int x, int y, int w, int h, int b, const float* c, int fullW, int fullH, RenderCommandList& out) {
+    out.SolidQuad(PixelRectToNdc(x - b, y - b, w + 2 * b, b, fullW, fullH), c[0], c[1], c[2], 1.0f, RenderBlendMode::Alpha);
+    out.SolidQuad(PixelRectToNdc(x - b, y + h, w + 2 * b, b, fullW, fullH), c[0], c[1], c[2], 1.0f, RenderBlendMode::Alpha);
+    out.SolidQuad(PixelRectToNdc(x - b, y, b, h, fullW, fullH), c[0], c[1], c[2], 1.0f, RenderBlendMode::Alpha);
+    out.SolidQuad(PixelRectToNdc(x + w, y, b, h, fullW, fullH), c[0], c[1], c[2], 1.0f, RenderBlendMode::Alpha);
+}
+
+// Placement -> NDC like RT_RenderImages for a screen-relative overlay at its top-left offset. Returns the
+// window pixel rectangle drawn, border included.
+PixelRect RecordOverlay(const TestOverlay& ov, float seconds, int fullW, int fullH, RenderCommandList& out) {
+    OverlayPlacement pl = ov.placement;
+    CompiledOverlayTimeline timeline;
+    CompileOverlayTimeline(ov.timeline, timeline);
+    ApplyOverlayTimeline(timeline, seconds, pl);
+
+    const int cropW = ov.texW - pl.cropLeft - pl.cropRight, cropH = ov.texH - pl.cropTop - pl.cropBottom;
+    const int w = static_cast<int>(cropW * pl.scale), h = static_cast<int>(cropH * pl.scale);
+    const RenderRect ndc = PixelRectToNdc(pl.x, pl.y, w, h, fullW, fullH);
+    const RenderRect uv{ static_cast<float>(pl.cropLeft) / ov.texW, static_cast<float>(pl.cropBottom) / ov.texH,
+                         static_cast<float>(ov.texW - pl.cropRight) / ov.texW, static_cast<float>(ov.texH - pl.cropTop) / ov.texH };
+    const RenderBlendMode blend = RenderBlendMode::AlphaPremulDest;
+
+    if (ov.background) out.SolidQuad(ndc, ov.bg[0], ov.bg[1], ov.bg[2], ov.bg[3], blend);
+    if (ov.colorKey) {
+        out.KeyedTexturedQuad(ndc, uv, ov.texture, pl.opacity, ov.filter, blend, ov.key[0], ov.key[1], ov.key[2], 0.05f);
+    } else {
+        out.TexturedQuad(ndc, uv, ov.texture, pl.opacity, ov.filter, blend);
+    }
+
+    const float* c = ov.borderColor;
+    const int t = static_cast<int>(ov.borderThickness);
+    if (ov.borderShape >= 0) {
+        // Static border: the quad grows by the thickness on each side
+        out.Border(PixelRectToNdc(pl.x - t, pl.y - t, w + 2 * t, h + 2 * t, fullW, fullH), ov.borderShape, ov.borderThickness, ov.borderRadius,
+                   static_cast<float>(w), static_cast<float>(h), static_cast<float>(w + 2 * t), static_cast<float>(h + 2 * t), c[0], c[1], c[2],
+                   c[3], RenderBlendMode::Alpha);
+    } else if (t > 0) {
+        RecordGameBorder(pl.x, pl.y, w, h, t, c, fullW, fullH, out);
+    }
+    return { pl.x - t, pl.y - t, w + 2 * t, h + 2 * t };
+}
+
+std::vector<TestOverlay> Overlays() {
+    std::vector<TestOverlay> list(3);
+
+    // Sliding and fading along an eased timeline, cropped, with a game border
+    TestOverlay& slide = list[0];
+    slide.placement.x = 150, slide.placement.y = 6, slide.placement.cropLeft = 2, slide.placement.cropTop = 1;
+    slide.texture = TEX_PHOTO, slide.texW = 32, slide.texH = 20;
+    slide.timeline.keyframes = { { 0, 0, 0, 1.0f, 1.0f, 0, 0, 0, 0, EasingType::EaseInOut }, { 1000, -24, 10, 1.0f, 0.4f } };
+    slide.timeline.loop = false;
+    slide.background = true, slide.bg[0] = 0.1f, slide.bg[1] = 0.1f, slide.bg[2] = 0.3f, slide.bg[3] = 0.7f;
+    slide.borderThickness = 2.0f, slide.borderColor[0] = 1.0f, slide.borderColor[1] = 0.8f;
+
+    // Upscaled pixel art behind a color key, rounded SDF border
+    TestOverlay& icon = list[1];
+    icon.placement.x = 156, icon.placement.y = 60, icon.placement.scale = 2.0f;
+    icon.texture = TEX_ICON, icon.texW = 16, icon.texH = 16, icon.filter = RenderFilter::Nearest;
+    icon.colorKey = true, icon.key[1] = 1.0f;
+    icon.borderShape = 0, icon.borderThickness = 3.0f, icon.borderRadius = 6.0f;
+    icon.borderColor[0] = 0.9f, icon.borderColor[2] = 0.9f, icon.borderColor[3] = 0.8f;
+
+    // Half-transparent overlay across the game viewport edge, elliptical border
+    TestOverlay& ghost = list[2];
+    ghost.placement.x = 120, ghost.placement.y = 70, ghost.placement.opacity = 0.5f;
+    ghost.texture = TEX_PHOTO, ghost.texW = 32, ghost.texH = 20;
+    ghost.borderShape = 1, ghost.borderThickness = 2.0f, ghost.borderColor[1] = 1.0f, ghost.borderColor[3] = 1.0f;
+    return list;
+}
+
+} // namespace
+
+TEST_CASE(OverlayLayoutMatchesGolden) {
+    constexpr int FULL_W = 192, FULL_H = 108;
+    constexpr int GAME_X = 48, GAME_Y = 14, GAME_W = 96, GAME_H = 80;
+    SoftwareRenderBackend backend;
+    SetTextures(backend);
+    RenderCommandList list;
+
+    // OBS gradient background, then the game viewport with its border
+    const RenderGradientStop stops[] = { { 0.1f, 0.1f, 0.2f, 1.0f, 0.0f }, { 0.5f, 0.2f, 0.4f, 1.0f, 0.6f }, { 0.9f, 0.6f, 0.2f, 1.0f, 1.0f } };
+    list.Gradient({ -1.0f, -1.0f, 1.0f, 1.0f }, stops, 3, 0.6f, 0.0f, 0, 0.0f, false, RenderBlendMode::Opaque);
+    list.TexturedQuad(PixelRectToNdc(GAME_X, GAME_Y, GAME_W, GAME_H, FULL_W, FULL_H), { 0, 0, 1, 1 }, TEX_GAME, 1.0f, RenderFilter::Nearest,
+                      RenderBlendMode::Opaque);
+    const float white[3] = { 1.0f, 1.0f, 1.0f };
+    RecordGameBorder(GAME_X, GAME_Y, GAME_W, GAME_H, 1, white, FULL_W, FULL_H, list);
+
+    // EyeZoom strip left of the viewport: the magnified center column, then boxes, line and labels
+    EyeZoomLayoutParams params;
+    params.cloneWidth = 8, params.overlayWidth = 3, params.windowWidth = GAME_W, params.horizontalMargin = 3, params.verticalMargin = 10;
+    params.textFontSize = 10;
+    const EyeZoomPlacement pl = ComputeEyeZoomPlacement(params, FULL_W, FULL_H, -1, false);
+    REQUIRE(pl.visible);
+    CHECK_EQ(pl.width, GAME_X - 6);
+    const float halfClone = 0.5f * params.cloneWidth / GAME_W;
+    list.TexturedQuad(PixelRectToNdc(pl.x, pl.y, pl.width, pl.height, FULL_W, FULL_H), { 0.5f - halfClone, 0.3f, 0.5f + halfClone, 0.7f },
+                      TEX_GAME, 1.0f, RenderFilter::Nearest, RenderBlendMode::Opaque);
+    TestFont font;
+    EyeZoomOverlay overlay;
+    LayoutEyeZoomOverlay(params, pl.width, pl.height, pl.labels, &font, overlay);
+    CHECK_EQ(static_cast<int>(overlay.labels.size()), 6);
+    const EyeZoomColors colors{ { 1.0f, 0.6f, 0.0f, 0.6f }, { 0.0f, 0.5f, 1.0f, 0.6f }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f, 1.0f } };
+    RecordEyeZoomOverlay(overlay, colors, pl.x, pl.y, FULL_W, FULL_H, TEX_FONT, RenderBlendMode::Alpha, list);
+
+    // Image overlays halfway through their timelines
+    for (const TestOverlay& ov : Overlays()) RecordOverlay(ov, 0.5f, FULL_W, FULL_H, list);
+
+    SoftwareImage image;
+    image.Resize(FULL_W, FULL_H);
+    image.Clear(0, 0, 0, 255);
+    backend.Execute(list, image);
+    CheckGolden("overlay_layout", image);
+}
+
+TEST_CASE(RetainedLayerCompositeMatchesGolden) {
+    constexpr int FULL_W = 128, FULL_H = 72;
+    SoftwareRenderBackend backend;
+    SetTextures(backend);
+
+    // Overlays apart from each other, into a transparent layer (premultiplied) like RetainedOverlayLayer's update
+    std::vector<TestOverlay> overlays = Overlays();
+    const int positions[][2] = { { 6, 6 }, { 84, 8 }, { 24, 44 } };
+    for (size_t i = 0; i < overlays.size(); i++) {
+        overlays[i].placement.x = positions[i][0], overlays[i].placement.y = positions[i][1];
+        // Borders blend with plain Alpha, which only keeps a layer premultiplied for opaque colors (as RT_RenderImages draws them)
+        overlays[i].borderColor[3] = 1.0f;
+    }
+    RenderCommandList layerList;
+    std::vector<PixelRect> drawn;
+    for (const TestOverlay& ov : overlays) drawn.push_back(RecordOverlay(ov, 0.25f, FULL_W, FULL_H, layerList));
+    SoftwareImage layer;
+    layer.Resize(FULL_W, FULL_H);
+    backend.Execute(layerList, layer);
+    backend.SetTexture(TEX_LAYER, FULL_W, FULL_H, layer.pixels.data());
+
+    // Game frame, then the layer's covered rectangles like RT_CompositeOverlayLayer
+    RenderCommandList frameList;
+    frameList.TexturedQuad({ -1, -1, 1, 1 }, { 0, 0, 1, 1 }, TEX_GAME, 1.0f, RenderFilter::Linear, RenderBlendMode::Opaque);
+    RenderCommandList composite = frameList;
+    for (const PixelRect& px : drawn) {
+        const RenderRect r = PixelRectToNdc(px.x, px.y, px.w, px.h, FULL_W, FULL_H);
+        composite.TexturedQuad(r, { (r.x1 + 1) * 0.5f, (r.y1 + 1) * 0.5f, (r.x2 + 1) * 0.5f, (r.y2 + 1) * 0.5f }, TEX_LAYER, 1.0f,
+                               RenderFilter::Nearest, RenderBlendMode::Premultiplied);
+    }
+    SoftwareImage image;
+    image.Resize(FULL_W, FULL_H);
+    backend.Execute(composite, image);
+
+    // The composite is the direct drawing up to the layer's extra rounding
+    RenderCommandList direct = frameList;
+    for (const TestOverlay& ov : overlays) RecordOverlay(ov, 0.25f, FULL_W, FULL_H, direct);
+    SoftwareImage directImage;
+    directImage.Resize(FULL_W, FULL_H);
+    backend.Execute(direct, directImage);
+    CHECK_EQ(CountDifferingPixels(directImage, image, 2), 0);
+
+    CheckGolden("layer_composite", image);
+}
@@ -0,0 +1,92 @@
+// ============================================================================
+// SEQLOCK_MAILBOX_BENCH.CPP - Frame request hand-over: seqlock mailbox vs a mutex-guarded slot
+// ============================================================================
+// Submit cost on the game thread and submit+consume round trips for a 280-byte trivially copyable
+// request (the size of FrameRenderRequest), single-threaded and with a consumer thread polling
+// concurrently. The mutex slot is the straightforward alternative: copy under a lock, flag as pending.
+// ============================================================================
+
+#include "bench_common.h"
+#include "seqlock_mailbox.h"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+struct Request {
+    uint64_t frameNumber;
+    uint8_t bytes[272];
+};
+static_assert(sizeof(Request) == 280, "FrameRenderRequest-sized payload");
+
+class MutexSlot {
+  public:
+    bool Publish(const Request& value) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const bool overwritten = m_pending;
+        m_value = value;
+        m_pending = true;
+        return overwritten;
+    }
+    bool TryConsume(Request& out) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_pending) return false;
+        out = m_value;
+        m_pending = false;
+        return true;
+    }
+
+  private:
+    std::mutex m_mutex;
+    Request m_value{};
+    bool m_pending = false;
+};
+
+template <typename Mailbox> void Run(const char* name) {
+    Mailbox mailbox;
+    Request request{};
+    Request out{};
+
+    const double submit = BenchNsPerCall([&] {
+        request.frameNumber++;
+        BenchKeep(mailbox.Publish(request));
+    });
+    const double roundTrip = BenchNsPerCall([&] {
+        request.frameNumber++;
+        mailbox.Publish(request);
+        mailbox.TryConsume(out);
+        BenchKeep(out.frameNumber);
+    });
+
+    // Submits while another thread consumes as fast as it can
+    std::atomic<bool> stop{ false };
+    uint64_t consumed = 0;
+    std::thread consumer([&] {
+        Request local{};
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (mailbox.TryConsume(local)) consumed++;
+        }
+    });
+    const double contended = BenchNsPerCall([&] {
+        request.frameNumber++;
+        BenchKeep(mailbox.Publish(request));
+    });
+    stop.store(true);
+    consumer.join();
+
+    printf("%-14s %14.1f %18.1f %22.1f\n", name, submit, roundTrip, contended);
+}
+
+} // namespace
+
+int main() {
+    printf("%-14s %14s %18s %22s\n", "mailbox", "submit ns", "submit+consume ns", "submit, consumer ns");
+    for (int i = 0; i < 2; i++) {
+        Run<SeqlockMailbox<Request>>("seqlock");
+        Run<MutexSlot>("mutex slot");
+    }
+    return 0;
+}
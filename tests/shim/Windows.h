@@ -0,0 +1,4 @@
+#pragma once
+
+// Case-sensitive file systems: gui.h and config_defaults.h include <Windows.h>
+#include "windows.h"
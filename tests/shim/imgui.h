@@ -0,0 +1,7 @@
+#pragma once
+
+// ============================================================================
+// IMGUI.H (test shim) - The ImGui declarations gui.h needs on Linux
+// ============================================================================
+
+enum ImGuiKey : int { ImGuiKey_None = 0 };
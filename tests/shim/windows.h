@@ -0,0 +1,45 @@
+#pragma once
+
+// ============================================================================
+// WINDOWS.H (test shim) - The Win32 declarations the tested headers need on Linux
+// ============================================================================
+// Only types and constants that appear in declarations (gui.h, config_defaults.h, utils.h, render.h), plus
+// the few Win32/WGL calls made by the GL modules built into toolscreen_gl_core (defined in wgl_shim.cpp).
+// ============================================================================
+
+#include <cstddef>
+#include <cstdint>
+
+typedef uint32_t DWORD;
+typedef int BOOL;
+typedef unsigned int UINT;
+typedef uintptr_t WPARAM;
+typedef intptr_t LPARAM;
+typedef void* HWND;
+typedef void* HDC;
+typedef void* HGLRC;
+typedef void* HCURSOR;
+typedef void* HANDLE;
+typedef void* LPVOID;
+typedef long LONG;
+
+struct RECT {
+    LONG left, top, right, bottom;
+};
+
+struct EXCEPTION_POINTERS;
+
+#define WINAPI
+
+// Current WGL context (the EGL context in the GL tests)
+HGLRC wglGetCurrentContext();
+
+#define MOVEFILE_REPLACE_EXISTING 0x1
+
+BOOL CreateDirectoryW(const wchar_t* path, void* securityAttributes);
+BOOL DeleteFileW(const wchar_t* path);
+BOOL MoveFileExW(const wchar_t* from, const wchar_t* to, DWORD flags);
+DWORD GetCurrentThreadId();
+
+#define VK_CONTROL 0x11
+#define VK_LCONTROL 0xA2
@@ -0,0 +1,517 @@
+// ============================================================================
+// STREAMING_UPLOAD_TEST.CPP - StreamingUploadRing allocation and retirement on a fake backend
+// ============================================================================
+// The fake backend keeps the storage in client memory and hands out fences that signal only when the test
+// says so. The cases walk the ring's free-space logic through its edge cases (wrapping to offset 0 with the
+// skipped end held by the wrapping allocation, the head sitting exactly at the capacity, a ring that is
+// exactly full with head == tail) and check retirement order and out-of-order Release. The last case
+// streams a texture through the real GL_ARB_buffer_storage backend on the headless context.
+// ============================================================================
+
+#include "gl_test_context.h"
+#include "streaming_upload.h"
+#include "test_common.h"
+
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t A = StreamingUploadRing::ALIGNMENT;
+
+struct FakeUploadState {
+    std::vector<uint8_t> storage;
+    bool destroyed = false;
+    uint64_t nextFence = 1;
+    std::set<uint64_t> live;   // Inserted and not deleted
+    uint64_t signaledUpTo = 0; // Fences with handles up to this have signaled
+    std::set<uint64_t> signaledEarly; // Reported signaled ahead of the ones before them
+    int deleted = 0;
+};
+
+class FakeUploadBackend final : public StreamingUploadBackend {
+  public:
+    explicit FakeUploadBackend(FakeUploadState& state) : m_state(state) {}
+
+    uint8_t* CreateStorage(size_t bytes) override {
+        m_state.storage.assign(bytes, 0);
+        return m_state.storage.data();
+    }
+    void DestroyStorage() override { m_state.destroyed = true; }
+    uint32_t StorageBuffer() const override { return 7; }
+
+    uint64_t InsertFence() override {
+        const uint64_t fence = m_state.nextFence++;
+        m_state.live.insert(fence);
+        return fence;
+    }
+    bool IsFenceSignaled(uint64_t fence) override {
+        CHECK(m_state.live.count(fence) == 1);
+        return fence <= m_state.signaledUpTo || m_state.signaledEarly.count(fence) != 0;
+    }
+    void DeleteFence(uint64_t fence) override {
+        CHECK(m_state.live.erase(fence) == 1);
+        m_state.deleted++;
+    }
+
+  private:
+    FakeUploadState& m_state;
+};
+
+std::shared_ptr<StreamingUploadRing> MakeRing(FakeUploadState& state, size_t capacity) {
+    return StreamingUploadRing::Create(std::make_unique<FakeUploadBackend>(state), capacity);
+}
+
+// Reserve + Commit + Submit: the render thread has issued the copy
+void SubmitNew(StreamingUploadRing& ring, size_t bytes, size_t expectedOffset) {
+    StreamingUpload up;
+    REQUIRE(ring.Reserve(bytes, up));
+    CHECK_EQ(up.offset, expectedOffset);
+    ring.Commit(up);
+    ring.Submit(up);
+}
+
+// Submits everything up to now under one fence and lets the GPU finish it
+void FenceAndRetireAll(StreamingUploadRing& ring, FakeUploadState& state) {
+    ring.FenceSubmitted();
+    state.signaledUpTo = state.nextFence - 1;
+    ring.Retire();
+}
+
+} // namespace
+
+TEST_CASE(CreateRoundsCapacityDownToAlignment) {
+    FakeUploadState state;
+    auto ring = MakeRing(state, 10 * A + 17);
+    REQUIRE(ring);
+    CHECK_EQ(ring->Capacity(), 10 * A);
+    CHECK_EQ(state.storage.size(), 10 * A);
+    CHECK(!MakeRing(state, A - 1));
+    CHECK(!StreamingUploadRing::Create(nullptr, 4 * A));
+}
+
+TEST_CASE(ReservationsAreAlignedAndBackToBack) {
+    FakeUploadState state;
+    auto ring = MakeRing(state, 8 * A);
+    StreamingUpload a, b;
+    REQUIRE(ring->Reserve(100, a));
+    REQUIRE(ring->Reserve(A + 1, b));
+    CHECK_EQ(a.offset, 0u);
+    CHECK_EQ(a.size, 100u);
+    CHECK(a.data == state.storage.data());
+    CHECK_EQ(b.offset, A);
+    CHECK(b.data == state.storage.data() + A);
+    CHECK_EQ(ring->BytesInUse(), 3 * A);
+
+    StreamingUpload bad;
+    CHECK(!ring->Reserve(0, bad));
+    CHECK(!ring->Reserve(8 * A + 1, bad));
+    CHECK(!bad.IsValid());
+
+    const StreamingUploadStats stats = ring->TakeStats();
+    CHECK_EQ(stats.reserved, 2u);
+    CHECK_EQ(stats.failed, 2u);
+    CHECK_EQ(stats.reservedBytes, 100u + A + 1);
+    CHECK_EQ(ring->TakeStats().reserved, 0u);
+    StreamingUploadRing::Release(a);
+    StreamingUploadRing::Release(b);
+    CHECK_EQ(ring->BytesInUse(), 0u);
+}
+
+TEST_CASE(WrapSkipsTheEndAndHoldsItUntilRetired) {
+    FakeUploadState state;
+    auto ring = MakeRing(state, 8 * A);
+    SubmitNew(*ring, 3 * A, 0);
+    ring->FenceSubmitted(); // Fence 1
+    SubmitNew(*ring, 3 * A, 3 * A);
+    ring->FenceSubmitted(); // Fence 2
+    StreamingUpload z;
+    REQUIRE(ring->Reserve(A, z)); // [6A, 7A)
+    state.signaledUpTo = 1;
+    ring->Retire(); // Tail 3A, head 7A
+    CHECK_EQ(ring->BytesInUse(), 4 * A);
+
+    // 2A does not fit in [7A, 8A): it goes to offset 0 and also holds the skipped [7A, 8A)
+    StreamingUpload wrapped;
+    REQUIRE(ring->Reserve(2 * A, wrapped));
+    CHECK_EQ(wrapped.offset, 0u);
+    CHECK_EQ(ring->BytesInUse(), 7 * A);
+
+    // Free space is now [2A, 3A) only
+    StreamingUpload fits, tooBig;
+    CHECK(!ring->Reserve(2 * A, tooBig));
+    REQUIRE(ring->Reserve(A, fits));
+    CHECK_EQ(fits.offset, 2 * A);
+    CHECK_EQ(ring->BytesInUse(), 8 * A);
+    CHECK(!ring->Reserve(1, tooBig));
+
+    // Fence 2 frees [3A, 6A), up to `z`
+    state.signaledUpTo = 2;
+    ring->Retire();
+    CHECK_EQ(ring->BytesInUse(), 5 * A);
+    CHECK(!ring->Reserve(4 * A, tooBig));
+
+    // With `z` gone the wrapped allocation is the oldest, and the skipped end stays held through it
+    StreamingUploadRing::Release(z);
+    CHECK_EQ(ring->BytesInUse(), 4 * A); // [7A, 8A) + [0, 3A)
+    StreamingUpload middle;
+    REQUIRE(ring->Reserve(4 * A, middle));
+    CHECK_EQ(middle.offset, 3 * A);
+    CHECK(!ring->Reserve(1, tooBig));
+
+    // Releasing the wrapped allocation frees its padding too: [7A, 8A) and [0, 2A) are free
+    StreamingUploadRing::Release(wrapped);
+    CHECK_EQ(ring->BytesInUse(), 5 * A);
+    StreamingUpload front;
+    REQUIRE(ring->Reserve(2 * A, front)); // Does not fit at 7A; wraps again
+    CHECK_EQ(front.offset, 0u);
+    CHECK(!ring->Reserve(1, tooBig));
+    StreamingUploadRing::Release(fits);
+    StreamingUploadRing::Release(middle);
+    StreamingUploadRing::Release(front);
+    CHECK_EQ(ring->BytesInUse(), 0u);
+}
+
+TEST_CASE(HeadAtCapacityWrapsOnNextReserve) {
+    FakeUploadState state;
+    auto ring = MakeRing(state, 4 * A);
+    SubmitNew(*ring, 2 * A, 0);
+    StreamingUpload last;
+    REQUIRE(ring->Reserve(2 * A, last)); // Ends exactly at the capacity
+    CHECK_EQ(last.offset, 2 * A);
+    CHECK_EQ(ring->BytesInUse(), 4 * A);
+
+    StreamingUpload up;
+    CHECK(!ring->Reserve(1, up)); // Exactly full: nothing at [4A, 4A) and [0, tail) is held
+
+    // Once [0, 2A) retires, the next allocation starts at 0 with nothing to skip
+    FenceAndRetireAll(*ring, state);
+    CHECK_EQ(ring->BytesInUse(), 2 * A);
+    REQUIRE(ring->Reserve(A, up));
+    CHECK_EQ(up.offset, 0u);
+    CHECK_EQ(ring->BytesInUse(), 3 * A);
+
+    // With the old tail gone, an allocation that wrapped from the capacity owns only its own space
+    StreamingUploadRing::Release(last);
+    CHECK_EQ(ring->BytesInUse(), A);
+    StreamingUpload more;
+    REQUIRE(ring->Reserve(3 * A, more));
+    CHECK_EQ(more.offset, A);
+    CHECK_EQ(ring->BytesInUse(), 4 * A);
+    StreamingUploadRing::Release(up);
+    StreamingUploadRing::Release(more);
+}
+
+TEST_CASE(WholeRingAllocationWrappedFromCapacity) {
+    FakeUploadState state;
+    auto ring = MakeRing(state, 4 * A);
+    SubmitNew(*ring, 4 * A, 0); // Head at the capacity
+    FenceAndRetireAll(*ring, state);
+    CHECK_EQ(ring->BytesInUse(), 0u);
+
+    // Empty ring: the head resets instead of wrapping with padding
+    StreamingUpload all;
+    REQUIRE(ring->Reserve(4 * A, all));
+    CHECK_EQ(all.offset, 0u);
+    CHECK_EQ(ring->BytesInUse(), 4 * A);
+    StreamingUpload up;
+    CHECK(!ring->Reserve(1, up));
+    StreamingUploadRing::Release(all);
+    CHECK_EQ(ring->BytesInUse(), 0u);
+}
+
+TEST_CASE(ExactlyFullWhenHeadMeetsTail) {
+    FakeUploadState state;
+    auto ring = MakeRing(state, 6 * A);
+    SubmitNew(*ring, 2 * A, 0);
+    ring->FenceSubmitted(); // Fence 1
+    SubmitNew(*ring, 2 * A, 2 * A);
+    ring->FenceSubmitted(); // Fence 2
+    StreamingUpload z;
+    REQUIRE(ring->Reserve(2 * A, z)); // [4A, 6A): head at the capacity
+    state.signaledUpTo = 1;
+    ring->Retire(); // Tail 2A
+
+    // Wraps to 0 and fills [0, 2A): head == tail == 2A
+    StreamingUpload wrapped;
+    REQUIRE(ring->Reserve(2 * A, wrapped));
+    CHECK_EQ(wrapped.offset, 0u);
+    CHECK_EQ(ring->BytesInUse(), 6 * A);
+    ring->TakeStats();
+    StreamingUpload up;
+    CHECK(!ring->Reserve(1, up));
+    CHECK_EQ(ring->TakeStats().failed, 1u);
+
+    state.signaledUpTo = 2;
+    ring->Retire();
+    CHECK_EQ(ring->BytesInUse(), 4 * A);
+    REQUIRE(ring->Reserve(2 * A, up));
+    CHECK_EQ(up.offset, 2 * A);
+
+    // The wrapped allocation began at the capacity, so with `z` gone [4A, 6A) is free again
+    StreamingUploadRing::Release(z);
+    CHECK_EQ(ring->BytesInUse(), 4 * A);
+    StreamingUpload more;
+    REQUIRE(ring->Reserve(2 * A, more));
+    CHECK_EQ(more.offset, 4 * A);
+    CHECK(!ring->Reserve(1, up));
+    StreamingUploadRing::Release(wrapped);
+    StreamingUploadRing::Release(up);
+    StreamingUploadRing::Release(more);
+}
+
+TEST_CASE(OutOfOrderReleaseFreesSpaceInAllocationOrder) {
+    FakeUploadState state;
+    auto ring = MakeRing(state, 4 * A);
+    StreamingUpload u[4];
+    for (int i = 0; i < 4; i++) REQUIRE(ring->Reserve(A, u[i]));
+
+    // Releasing later allocations first frees nothing: space is reclaimed from the oldest
+    StreamingUploadRing::Release(u[2]);
+    StreamingUploadRing::Release(u[1]);
+    CHECK(!u[1].IsValid() && !u[2].IsValid());
+    CHECK_EQ(ring->BytesInUse(), 4 * A);
+    StreamingUpload up;
+    CHECK(!ring->Reserve(1, up));
+
+    // The oldest goes: it and the two already released behind it are reclaimed together
+    StreamingUploadRing::Release(u[0]);
+    CHECK_EQ(ring->BytesInUse(), A);
+    REQUIRE(ring->Reserve(3 * A, up));
+    CHECK_EQ(up.offset, 0u);
+
+    // Committed uploads can be released too; a second release of the same upload is harmless
+    ring->Commit(u[3]);
+    CHECK(u[3].data == nullptr);
+    StreamingUpload copy = u[3];
+    StreamingUploadRing::Release(u[3]);
+    StreamingUploadRing::Release(copy);
+    CHECK_EQ(ring->BytesInUse(), 3 * A);
+    StreamingUploadRing::Release(up);
+    CHECK_EQ(ring->BytesInUse(), 0u);
+}
+
+TEST_CASE(ReleaseAfterSubmitHasNoEffect) {
+    FakeUploadState state;
+    auto ring = MakeRing(state, 4 * A);
+    StreamingUpload up;
+    REQUIRE(ring->Reserve(A, up));
+    ring->Commit(up);
+    StreamingUpload copy = up;
+    ring->Submit(up);
+    CHECK(!up.IsValid());
+
+    // The copy command may still be reading the space: it stays held until the fence signals
+    StreamingUploadRing::Release(copy);
+    CHECK(!copy.IsValid());
+    CHECK_EQ(ring->BytesInUse(), A);
+    ring->Retire();
+    CHECK_EQ(ring->BytesInUse(), A);
+    FenceAndRetireAll(*ring, state);
+    CHECK_EQ(ring->BytesInUse(), 0u);
+}
+
+TEST_CASE(FencesRetireInOrderAndOnlyWhatTheyCover) {
+    FakeUploadState state;
+    auto ring = MakeRing(state, 8 * A);
+    SubmitNew(*ring, A, 0);
+    ring->FenceSubmitted(); // Fence 1 covers [0, A)
+    ring->FenceSubmitted(); // Nothing new submitted: no fence
+    CHECK_EQ(state.live.size(), 1u);
+    SubmitNew(*ring, A, A);
+    SubmitNew(*ring, A, 2 * A);
+    ring->FenceSubmitted(); // Fence 2 covers [A, 3A)
+    SubmitNew(*ring, A, 3 * A); // Not fenced yet
+    CHECK_EQ(state.live.size(), 2u);
+
+    ring->Retire();
+    CHECK_EQ(ring->BytesInUse(), 4 * A);
+
+    state.signaledUpTo = 1;
+    ring->Retire();
+    CHECK_EQ(ring->BytesInUse(), 3 * A);
+    CHECK_EQ(state.deleted, 1);
+
+    // Fence 2 signaled: frees what it covers, not the unfenced upload after it
+    state.signaledUpTo = 5;
+    ring->Retire();
+    CHECK_EQ(ring->BytesInUse(), A);
+    CHECK_EQ(state.deleted, 2);
+    CHECK(state.live.empty());
+
+    FenceAndRetireAll(*ring, state);
+    CHECK_EQ(ring->BytesInUse(), 0u);
+}
+
+TEST_CASE(UnsignaledFenceHoldsBackLaterOnes) {
+    FakeUploadState state;
+    auto ring = MakeRing(state, 8 * A);
+    SubmitNew(*ring, A, 0);
+    ring->FenceSubmitted(); // Fence 1
+    SubmitNew(*ring, A, A);
+    ring->FenceSubmitted(); // Fence 2
+
+    // Fence 2 reported signaled ahead of fence 1: Retire checks them in order and stops at fence 1
+    state.signaledEarly.insert(2);
+    state.signaledUpTo = 0;
+    ring->Retire();
+    CHECK_EQ(ring->BytesInUse(), 2 * A);
+    CHECK_EQ(state.deleted, 0);
+    state.signaledUpTo = 1;
+    ring->Retire();
+    CHECK_EQ(ring->BytesInUse(), 0u);
+    CHECK_EQ(state.deleted, 2);
+}
+
+TEST_CASE(SubmitWithoutCommitAndForeignUploadsAreHandled) {
+    FakeUploadState stateA, stateB;
+    auto ringA = MakeRing(stateA, 4 * A);
+    auto ringB = MakeRing(stateB, 4 * A);
+    StreamingUpload up;
+    REQUIRE(ringA->Reserve(A, up));
+
+    // Another ring ignores it (and still resets it on Submit)
+    StreamingUpload foreign = up;
+    ringB->Commit(foreign);
+    CHECK(foreign.data != nullptr);
+    ringB->Submit(foreign);
+    CHECK(!foreign.IsValid());
+    CHECK_EQ(ringA->BytesInUse(), A);
+
+    // Submitting straight from Writing is allowed (the render thread wrote the pixels itself)
+    ringA->Submit(up);
+    FenceAndRetireAll(*ringA, stateA);
+    CHECK_EQ(ringA->BytesInUse(), 0u);
+}
+
+TEST_CASE(CloseWaitsForWritersAndFreesEverything) {
+    FakeUploadState state;
+    auto ring = MakeRing(state, 8 * A);
+    SubmitNew(*ring, A, 0);
+    ring->FenceSubmitted();
+    StreamingUpload writing;
+    REQUIRE(ring->Reserve(A, writing));
+
+    std::atomic<bool> closed{ false };
+    std::thread closer([&] {
+        ring->Close();
+        closed = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    CHECK(!closed);
+    std::memset(writing.data, 0xAB, A); // Still mapped while Close waits
+    ring->Commit(writing);
+    closer.join();
+    CHECK(closed);
+
+    CHECK(state.destroyed);
+    CHECK(state.live.empty());
+    CHECK_EQ(ring->BytesInUse(), 0u);
+    StreamingUpload up;
+    CHECK(!ring->Reserve(A, up));
+    ring->FenceSubmitted();
+    CHECK_EQ(state.nextFence, 2u);
+    ring->Close(); // Twice is harmless
+}
+
+TEST_CASE(RandomTrafficKeepsAllocationsDisjoint) {
+    FakeUploadState state;
+    constexpr size_t CAPACITY = 64 * A;
+    auto ring = MakeRing(state, CAPACITY);
+    std::mt19937 rng(68);
+    struct Live {
+        StreamingUpload up;
+        size_t offset, size;
+    };
+    std::vector<Live> pending; // Reserved, not submitted
+    std::vector<std::pair<size_t, size_t>> submitted;
+    std::vector<uint64_t> fenceOfSubmitted;
+
+    for (int step = 0; step < 20000; step++) {
+        const int op = static_cast<int>(rng() % 10);
+        if (op < 4) {
+            Live l;
+            const size_t bytes = 1 + rng() % (12 * A);
+            if (ring->Reserve(bytes, l.up)) {
+                l.offset = l.up.offset;
+                l.size = ((bytes + A - 1) / A) * A;
+                CHECK(l.offset + l.size <= CAPACITY);
+                CHECK(l.offset % A == 0);
+                for (const Live& o : pending) CHECK(l.offset + l.size <= o.offset || o.offset + o.size <= l.offset);
+                for (const auto& s : submitted) CHECK(l.offset + l.size <= s.first || s.first + s.second <= l.offset);
+                pending.push_back(std::move(l));
+            }
+        } else if (op < 6 && !pending.empty()) {
+            const size_t i = rng() % pending.size();
+            submitted.push_back({ pending[i].offset, pending[i].size });
+            fenceOfSubmitted.push_back(state.nextFence); // Next fence covers it
+            ring->Commit(pending[i].up);
+            ring->Submit(pending[i].up);
+            pending.erase(pending.begin() + i);
+        } else if (op < 7 && !pending.empty()) {
+            const size_t i = rng() % pending.size();
+            StreamingUploadRing::Release(pending[i].up);
+            pending.erase(pending.begin() + i);
+        } else if (op < 8) {
+            ring->FenceSubmitted();
+        } else {
+            state.signaledUpTo = state.nextFence > 1 ? state.nextFence - 1 - rng() % 2 : 0;
+            ring->Retire();
+            // Whatever is covered by a signaled fence may be reused from now on
+            for (size_t i = submitted.size(); i-- > 0;) {
+                if (fenceOfSubmitted[i] <= state.signaledUpTo && fenceOfSubmitted[i] < state.nextFence) {
+                    submitted.erase(submitted.begin() + i);
+                    fenceOfSubmitted.erase(fenceOfSubmitted.begin() + i);
+                }
+            }
+        }
+        CHECK(ring->BytesInUse() <= CAPACITY);
+    }
+    for (Live& l : pending) StreamingUploadRing::Release(l.up);
+    ring->FenceSubmitted();
+    state.signaledUpTo = state.nextFence;
+    ring->Retire();
+    CHECK_EQ(ring->BytesInUse(), 0u);
+}
+
+TEST_CASE(StreamsTextureThroughMappedBufferOnRealContext) {
+    RequireGLContext();
+    auto ring = StreamingUploadRing::CreateForCurrentContext(64 * A);
+    REQUIRE(ring);
+
+    constexpr int W = 33, H = 17; // Row pitch not a multiple of the alignment
+    const GLuint texture = CreateTestTexture(W, H);
+    const GLuint fbo = CreateTestFramebuffer(texture);
+    for (int frame = 0; frame < 12; frame++) {
+        StreamingUpload up;
+        REQUIRE(ring->Reserve(static_cast<size_t>(W) * H * 4, up));
+        for (int i = 0; i < W * H * 4; i++) up.data[i] = static_cast<uint8_t>(i * 7 + frame);
+        ring->Commit(up);
+
+        // UploadTexturePixels
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, ring->StorageBuffer());
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, W, H, GL_RGBA, GL_UNSIGNED_BYTE, reinterpret_cast<const void*>(up.offset));
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        ring->Submit(up);
+        ring->FenceSubmitted();
+        ring->Retire();
+
+        const std::vector<uint8_t> pixels = ReadTestFramebuffer(fbo, W, H);
+        int wrong = 0;
+        for (int i = 0; i < W * H * 4; i++) wrong += pixels[i] != static_cast<uint8_t>(i * 7 + frame);
+        CHECK_EQ(wrong, 0);
+    }
+    glFinish();
+    ring->Retire();
+    CHECK_EQ(ring->BytesInUse(), 0u);
+    ring->Close();
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &texture);
+}
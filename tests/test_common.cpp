@@ -0,0 +1,87 @@
+// ============================================================================
+// TEST_COMMON.CPP - Test registry and main() for the headless test executables
+// ============================================================================
+
+#include "test_common.h"
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <vector>
+
+namespace {
+
+struct RegisteredTest {
+    const char* name;
+    TestFunction fn;
+};
+
+std::vector<RegisteredTest>& Registry() {
+    static std::vector<RegisteredTest> s_tests;
+    return s_tests;
+}
+
+// Failures are capped per test case so a broken loop does not flood the log
+constexpr int MAX_REPORTED_FAILURES = 20;
+
+// Thrown by SkipTestCase
+struct TestCaseSkipped {
+    std::string reason;
+};
+
+int g_caseFailures = 0;
+std::string g_context;
+
+} // namespace
+
+bool RegisterTestCase(const char* name, TestFunction fn) {
+    Registry().push_back({ name, fn });
+    return true;
+}
+
+void ReportTestFailure(const char* file, int line, const std::string& message) {
+    if (++g_caseFailures > MAX_REPORTED_FAILURES) return;
+    if (g_context.empty()) {
+        fprintf(stderr, "  %s:%d: %s\n", file, line, message.c_str());
+    } else {
+        fprintf(stderr, "  %s:%d: %s [%s]\n", file, line, message.c_str(), g_context.c_str());
+    }
+}
+
+void SetTestContext(const std::string& context) { g_context = context; }
+
+void SkipTestCase(const std::string& reason) { throw TestCaseSkipped{ reason }; }
+
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    int run = 0, failed = 0, skipped = 0;
+    for (const RegisteredTest& test : Registry()) {
+        if (filter && !strstr(test.name, filter)) continue;
+        g_caseFailures = 0;
+        g_context.clear();
+        try {
+            test.fn();
+        } catch (const TestCaseAborted&) {
+        } catch (const TestCaseSkipped& skip) {
+            run++;
+            skipped++;
+            printf("skip %s (%s)\n", test.name, skip.reason.c_str());
+            fflush(stdout);
+            continue;
+        } catch (const std::exception& e) {
+            ReportTestFailure(__FILE__, __LINE__, std::string("unexpected exception: ") + e.what());
+        }
+        run++;
+        if (g_caseFailures > 0) {
+            failed++;
+            if (g_caseFailures > MAX_REPORTED_FAILURES) fprintf(stderr, "  ... %d more failures\n", g_caseFailures - MAX_REPORTED_FAILURES);
+            printf("FAIL %s\n", test.name);
+        } else {
+            printf("ok   %s\n", test.name);
+        }
+        fflush(stdout);
+    }
+    printf("%d/%d test cases passed, %d skipped\n", run - failed - skipped, run, skipped);
+    if (failed > 0 || run == 0) return 1;
+    return skipped == run ? TEST_SKIPPED_EXIT_CODE : 0;
+}
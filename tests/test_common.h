@@ -0,0 +1,75 @@
+#pragma once
+
+// ============================================================================
+// TEST_COMMON.H - Minimal test harness for the headless test executables
+// ============================================================================
+// Each test executable is a list of TEST_CASEs linked with test_common.cpp, which provides main().
+// CHECK* macros record a failure and keep going; REQUIRE* macros end the current test case.
+// SkipTestCase() ends a test case that cannot run here; an executable whose cases were all skipped exits
+// with TEST_SKIPPED_EXIT_CODE, which CTest reports as skipped.
+// Run an executable with a substring argument to run only the matching test cases.
+// ============================================================================
+
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using TestFunction = void (*)();
+
+bool RegisterTestCase(const char* name, TestFunction fn);
+void ReportTestFailure(const char* file, int line, const std::string& message);
+
+// Thrown by REQUIRE* to leave the current test case
+struct TestCaseAborted {};
+
+constexpr int TEST_SKIPPED_EXIT_CODE = 77;
+
+// Ends the current test case as skipped (e.g. no GL context available)
+[[noreturn]] void SkipTestCase(const std::string& reason);
+
+#define TEST_CASE(name)                                                                                                  \
+    static void name();                                                                                                  \
+    static const bool name##_registered = RegisterTestCase(#name, name);                                                 \
+    static void name()
+
+#define CHECK(cond)                                                                                                      \
+    do {                                                                                                                 \
+        if (!(cond)) ReportTestFailure(__FILE__, __LINE__, "CHECK(" #cond ")");                                          \
+    } while (0)
+
+#define REQUIRE(cond)                                                                                                    \
+    do {                                                                                                                 \
+        if (!(cond)) {                                                                                                   \
+            ReportTestFailure(__FILE__, __LINE__, "REQUIRE(" #cond ")");                                                 \
+            throw TestCaseAborted{};                                                                                     \
+        }                                                                                                                \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                                                                   \
+    do {                                                                                                                 \
+        const auto& checkA_ = (a);                                                                                       \
+        const auto& checkB_ = (b);                                                                                       \
+        if (!(checkA_ == checkB_)) {                                                                                     \
+            std::ostringstream checkMsg_;                                                                                \
+            checkMsg_ << "CHECK_EQ(" #a ", " #b "): " << checkA_ << " != " << checkB_;                                   \
+            ReportTestFailure(__FILE__, __LINE__, checkMsg_.str());                                                      \
+        }                                                                                                                \
+    } while (0)
+
+#define CHECK_NEAR(a, b, tolerance)                                                                                      \
+    do {                                                                                                                 \
+        const double checkA_ = static_cast<double>(a);                                                                   \
+        const double checkB_ = static_cast<double>(b);                                                                   \
+        if (!(std::fabs(checkA_ - checkB_) <= static_cast<double>(tolerance))) {                                         \
+            std::ostringstream checkMsg_;                                                                                \
+            checkMsg_ << "CHECK_NEAR(" #a ", " #b ", " #tolerance "): " << checkA_ << " vs " << checkB_;                 \
+            ReportTestFailure(__FILE__, __LINE__, checkMsg_.str());                                                      \
+        }                                                                                                                \
+    } while (0)
+
+// Messages the code under test passed to Log/LogCategory since the last call (test_log.cpp)
+std::vector<std::string> TakeTestLogMessages();
+
+// Context printed with the next failures of the current test case (e.g. the random seed or loop index)
+void SetTestContext(const std::string& context);
@@ -0,0 +1,35 @@
+// ============================================================================
+// TEST_LOG.CPP - Logger stand-in for the headless test executables
+// ============================================================================
+// The DLL's Log/LogCategory (utils.cpp) write to the log file through Win32. Tests link this instead and
+// can inspect what the code under test logged.
+// ============================================================================
+
+#include "test_common.h"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::mutex g_logMutex;
+std::vector<std::string> g_logMessages; // Guarded by g_logMutex
+
+} // namespace
+
+void Log(const std::string& message) {
+    std::lock_guard<std::mutex> lock(g_logMutex);
+    g_logMessages.push_back(message);
+}
+
+void Log(const std::wstring& message) { Log(std::string(message.begin(), message.end())); }
+
+void LogCategory(const char* category, const std::string& message) { Log(std::string("[") + category + "] " + message); }
+
+std::vector<std::string> TakeTestLogMessages() {
+    std::lock_guard<std::mutex> lock(g_logMutex);
+    std::vector<std::string> messages;
+    messages.swap(g_logMessages);
+    return messages;
+}
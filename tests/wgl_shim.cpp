@@ -0,0 +1,35 @@
+// ============================================================================
+// WGL_SHIM.CPP - WGL and Win32 calls of the GL modules, mapped to EGL and std::filesystem
+// ============================================================================
+// File paths are used exactly as given: the backslashes the modules join paths with become part of the
+// file name on Linux, which keeps every call on one path consistent with the streams that open it.
+// ============================================================================
+
+#include <EGL/egl.h>
+#include <windows.h>
+
+#include <filesystem>
+#include <sys/syscall.h>
+#include <system_error>
+#include <unistd.h>
+
+HGLRC wglGetCurrentContext() { return eglGetCurrentContext(); }
+
+BOOL CreateDirectoryW(const wchar_t* path, void*) {
+    std::error_code ec;
+    return std::filesystem::create_directory(path, ec) ? 1 : 0;
+}
+
+BOOL DeleteFileW(const wchar_t* path) {
+    std::error_code ec;
+    return std::filesystem::remove(path, ec) ? 1 : 0;
+}
+
+BOOL MoveFileExW(const wchar_t* from, const wchar_t* to, DWORD) {
+    // rename() replaces an existing target, as MOVEFILE_REPLACE_EXISTING asks
+    std::error_code ec;
+    std::filesystem::rename(from, to, ec);
+    return ec ? 0 : 1;
+}
+
+DWORD GetCurrentThreadId() { return static_cast<DWORD>(syscall(SYS_gettid)); }